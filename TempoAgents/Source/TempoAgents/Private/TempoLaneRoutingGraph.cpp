@@ -0,0 +1,312 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoLaneRoutingGraph.h"
+
+#include "TempoConversion.h"
+
+#include "ZoneGraphTypes.h"
+
+#include "Algo/Reverse.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	// Lanes without a speed limit, or with a slower one, are costed at this speed (cm/s).
+	constexpr float MinRoutingSpeed = 100.0f;
+
+	struct FCostedLane
+	{
+		double Cost = 0.0;
+		int32 Lane = INDEX_NONE;
+	};
+
+	// Orders TArray's heap (a min-heap) by cost.
+	struct FCheaperLane
+	{
+		bool operator()(const FCostedLane& A, const FCostedLane& B) const
+		{
+			return A.Cost < B.Cost;
+		}
+	};
+}
+
+FTempoLaneRoutingGraph::FTempoLaneRoutingGraph(const FZoneGraphStorage& Storage, TConstArrayView<float> LaneSpeedLimits, int32 InNumLandmarks)
+{
+	const int32 NumStorageLanes = Storage.Lanes.Num();
+	LaneTags.SetNum(NumStorageLanes);
+	LaneLengths.SetNum(NumStorageLanes);
+	for (TArray<float>& Costs : LaneCosts)
+	{
+		Costs.SetNum(NumStorageLanes);
+	}
+
+	TArray<int32> NumPredecessors;
+	NumPredecessors.SetNumZeroed(NumStorageLanes);
+	SuccessorsBegin.Reserve(NumStorageLanes + 1);
+	for (int32 LaneIndex = 0; LaneIndex < NumStorageLanes; ++LaneIndex)
+	{
+		const FZoneLaneData& Lane = Storage.Lanes[LaneIndex];
+		const float Length = Lane.PointsEnd > Lane.PointsBegin ? Storage.LanePointProgressions[Lane.PointsEnd - 1] : 0.0f;
+		const float Speed = FMath::Max(LaneSpeedLimits.IsValidIndex(LaneIndex) ? LaneSpeedLimits[LaneIndex] : 0.0f, MinRoutingSpeed);
+		LaneTags[LaneIndex] = Lane.Tags;
+		LaneLengths[LaneIndex] = QuantityConverter<CM2M>::Convert(Length);
+		LaneCosts[static_cast<int32>(ETempoLaneRouteCost::Distance)][LaneIndex] = LaneLengths[LaneIndex];
+		LaneCosts[static_cast<int32>(ETempoLaneRouteCost::TravelTime)][LaneIndex] = Length / Speed;
+
+		SuccessorsBegin.Add(Successors.Num());
+		for (int32 LinkIndex = Lane.LinksBegin; LinkIndex < Lane.LinksEnd; ++LinkIndex)
+		{
+			const FZoneLaneLinkData& Link = Storage.LaneLinks[LinkIndex];
+			if (Link.Type == EZoneLaneLinkType::Outgoing && Storage.Lanes.IsValidIndex(Link.DestLaneIndex))
+			{
+				Successors.Add(Link.DestLaneIndex);
+				++NumPredecessors[Link.DestLaneIndex];
+			}
+		}
+	}
+	SuccessorsBegin.Add(Successors.Num());
+
+	// The same links, reversed.
+	PredecessorsBegin.SetNum(NumStorageLanes + 1);
+	PredecessorsBegin[0] = 0;
+	for (int32 LaneIndex = 0; LaneIndex < NumStorageLanes; ++LaneIndex)
+	{
+		PredecessorsBegin[LaneIndex + 1] = PredecessorsBegin[LaneIndex] + NumPredecessors[LaneIndex];
+	}
+	TArray<int32> NextPredecessor(PredecessorsBegin.GetData(), NumStorageLanes);
+	Predecessors.SetNum(Successors.Num());
+	for (int32 LaneIndex = 0; LaneIndex < NumStorageLanes; ++LaneIndex)
+	{
+		for (int32 LinkIndex = SuccessorsBegin[LaneIndex]; LinkIndex < SuccessorsBegin[LaneIndex + 1]; ++LinkIndex)
+		{
+			Predecessors[NextPredecessor[Successors[LinkIndex]]++] = LaneIndex;
+		}
+	}
+
+	const int32 NumLandmarksToPlace = FMath::Clamp(InNumLandmarks, 0, NumStorageLanes);
+	if (NumLandmarksToPlace == 0)
+	{
+		return;
+	}
+	for (int32 CostIndex = 0; CostIndex < NumCosts; ++CostIndex)
+	{
+		FromLandmarkCosts[CostIndex].SetNumUninitialized(NumLandmarksToPlace * NumStorageLanes);
+		ToLandmarkCosts[CostIndex].SetNumUninitialized(NumLandmarksToPlace * NumStorageLanes);
+	}
+
+	// Place the landmarks farthest-first: each is the lane farthest from those placed so far (preferring lanes none of
+	// them reach, so every part of a disconnected graph gets one), starting from the lane farthest from lane 0. Good
+	// bounds come from landmarks "behind" the start or "beyond" the target, which spreading them to the edges provides.
+	constexpr int32 DistanceIndex = static_cast<int32>(ETempoLaneRouteCost::Distance);
+	TArray<float> NearestLandmarkCosts;
+	NearestLandmarkCosts.SetNumUninitialized(NumStorageLanes);
+	ComputeCosts(0, ETempoLaneRouteCost::Distance, /*bReverse=*/false, NearestLandmarkCosts);
+	TBitArray<> IsLandmark(false, NumStorageLanes);
+	for (int32 LandmarkIndex = 0; LandmarkIndex < NumLandmarksToPlace; ++LandmarkIndex)
+	{
+		int32 Landmark = INDEX_NONE;
+		for (int32 LaneIndex = 0; LaneIndex < NumStorageLanes; ++LaneIndex)
+		{
+			if (!IsLandmark[LaneIndex] && (Landmark == INDEX_NONE || NearestLandmarkCosts[LaneIndex] > NearestLandmarkCosts[Landmark]))
+			{
+				Landmark = LaneIndex;
+			}
+		}
+		IsLandmark[Landmark] = true;
+		Landmarks.Add(Landmark);
+
+		const TArrayView<float> Costs(FromLandmarkCosts[DistanceIndex].GetData() + LandmarkIndex * NumStorageLanes, NumStorageLanes);
+		ComputeCosts(Landmark, ETempoLaneRouteCost::Distance, /*bReverse=*/false, Costs);
+		for (int32 LaneIndex = 0; LaneIndex < NumStorageLanes; ++LaneIndex)
+		{
+			NearestLandmarkCosts[LaneIndex] = LandmarkIndex == 0 ? Costs[LaneIndex] : FMath::Min(NearestLandmarkCosts[LaneIndex], Costs[LaneIndex]);
+		}
+	}
+
+	// The rest of the tables are independent searches: to each landmark by distance, and from and to it by time.
+	ParallelFor(NumLandmarksToPlace * 3, [this, NumStorageLanes](int32 TableIndex)
+	{
+		const int32 LandmarkIndex = TableIndex / 3;
+		const bool bReverse = TableIndex % 3 != 1;
+		const ETempoLaneRouteCost Cost = TableIndex % 3 == 0 ? ETempoLaneRouteCost::Distance : ETempoLaneRouteCost::TravelTime;
+		TArray<float>& Table = bReverse ? ToLandmarkCosts[static_cast<int32>(Cost)] : FromLandmarkCosts[static_cast<int32>(Cost)];
+		ComputeCosts(Landmarks[LandmarkIndex], Cost, bReverse, TArrayView<float>(Table.GetData() + LandmarkIndex * NumStorageLanes, NumStorageLanes));
+	});
+}
+
+void FTempoLaneRoutingGraph::ComputeCosts(int32 Source, ETempoLaneRouteCost Cost, bool bReverse, TArrayView<float> OutCosts) const
+{
+	const TArray<float>& Costs = LaneCosts[static_cast<int32>(Cost)];
+	const TArray<int32>& LinksBegin = bReverse ? PredecessorsBegin : SuccessorsBegin;
+	const TArray<int32>& Links = bReverse ? Predecessors : Successors;
+
+	for (float& LaneCost : OutCosts)
+	{
+		LaneCost = UnreachableCost;
+	}
+	OutCosts[Source] = 0.0f;
+
+	TArray<FCostedLane> Open;
+	Open.HeapPush(FCostedLane{ 0.0, Source }, FCheaperLane());
+	while (Open.Num() > 0)
+	{
+		FCostedLane Current;
+		Open.HeapPop(Current, FCheaperLane(), EAllowShrinking::No);
+		if (Current.Cost > OutCosts[Current.Lane])
+		{
+			// We already found a cheaper route to this lane.
+			continue;
+		}
+		for (int32 LinkIndex = LinksBegin[Current.Lane]; LinkIndex < LinksBegin[Current.Lane + 1]; ++LinkIndex)
+		{
+			const int32 Next = Links[LinkIndex];
+			// Forward, we enter Next. In reverse, Next is a predecessor that enters Current.
+			const float NextCost = static_cast<float>(Current.Cost) + Costs[bReverse ? Current.Lane : Next];
+			if (NextCost < OutCosts[Next])
+			{
+				OutCosts[Next] = NextCost;
+				Open.HeapPush(FCostedLane{ NextCost, Next }, FCheaperLane());
+			}
+		}
+	}
+}
+
+double FTempoLaneRoutingGraph::LandmarkHeuristic(int32 Lane, int32 CostIndex, TConstArrayView<float> TargetFromLandmarkCosts, TConstArrayView<float> TargetToLandmarkCosts) const
+{
+	// By the triangle inequality, for every landmark L: cost(L, Target) <= cost(L, Lane) + cost(Lane, Target), and
+	// cost(Lane, L) <= cost(Lane, Target) + cost(Target, L).
+	double Bound = 0.0;
+	for (int32 LandmarkIndex = 0; LandmarkIndex < Landmarks.Num(); ++LandmarkIndex)
+	{
+		const int32 TableIndex = LandmarkIndex * NumLanes() + Lane;
+		const float FromLandmark = FromLandmarkCosts[CostIndex][TableIndex];
+		if (FromLandmark != UnreachableCost && TargetFromLandmarkCosts[LandmarkIndex] != UnreachableCost)
+		{
+			Bound = FMath::Max(Bound, static_cast<double>(TargetFromLandmarkCosts[LandmarkIndex]) - FromLandmark);
+		}
+		const float ToLandmark = ToLandmarkCosts[CostIndex][TableIndex];
+		if (ToLandmark != UnreachableCost && TargetToLandmarkCosts[LandmarkIndex] != UnreachableCost)
+		{
+			Bound = FMath::Max(Bound, static_cast<double>(ToLandmark) - TargetToLandmarkCosts[LandmarkIndex]);
+		}
+	}
+	return Bound;
+}
+
+bool FTempoLaneRoutingGraph::FindRoute(int32 FromLane, int32 ToLane, const FTempoLaneRouteOptions& Options, FTempoLaneRoute& OutRoute, FString& OutError) const
+{
+	OutRoute = FTempoLaneRoute();
+	for (const int32 Lane : { FromLane, ToLane })
+	{
+		if (!LaneTags.IsValidIndex(Lane))
+		{
+			OutError = FString::Printf(TEXT("No lane with ID %d"), Lane);
+			return false;
+		}
+		if (!Options.TagFilter.Pass(LaneTags[Lane]))
+		{
+			OutError = FString::Printf(TEXT("Lane %d is excluded by the tag filter"), Lane);
+			return false;
+		}
+	}
+
+	const int32 CostIndex = static_cast<int32>(Options.Cost);
+	auto LaneCost = [this, CostIndex, &Options](int32 Lane)
+	{
+		double Cost = LaneCosts[CostIndex][Lane];
+		for (const TPair<FZoneGraphTag, float>& TagCostMultiplier : Options.TagCostMultipliers)
+		{
+			if (LaneTags[Lane].Contains(TagCostMultiplier.Key))
+			{
+				Cost *= FMath::Max(TagCostMultiplier.Value, 1.0f);
+			}
+		}
+		return Cost;
+	};
+
+	TArray<float, TInlineAllocator<DefaultNumLandmarks>> TargetFromLandmarkCosts;
+	TArray<float, TInlineAllocator<DefaultNumLandmarks>> TargetToLandmarkCosts;
+	for (int32 LandmarkIndex = 0; LandmarkIndex < Landmarks.Num(); ++LandmarkIndex)
+	{
+		const int32 FromTableIndex = LandmarkIndex * NumLanes() + FromLane;
+		const int32 ToTableIndex = LandmarkIndex * NumLanes() + ToLane;
+		TargetFromLandmarkCosts.Add(FromLandmarkCosts[CostIndex][ToTableIndex]);
+		TargetToLandmarkCosts.Add(ToLandmarkCosts[CostIndex][ToTableIndex]);
+
+		// A landmark that reaches FromLane but not ToLane, or that ToLane reaches but FromLane doesn't, proves there is
+		// no route, without searching everything FromLane reaches to find out.
+		if ((FromLandmarkCosts[CostIndex][FromTableIndex] != UnreachableCost && TargetFromLandmarkCosts.Last() == UnreachableCost) ||
+			(TargetToLandmarkCosts.Last() != UnreachableCost && ToLandmarkCosts[CostIndex][FromTableIndex] == UnreachableCost))
+		{
+			OutError = FString::Printf(TEXT("No route from lane %d to lane %d"), FromLane, ToLane);
+			return false;
+		}
+	}
+
+	struct FSearchedLane
+	{
+		double Cost = 0.0;
+		int32 Parent = INDEX_NONE;
+		bool bClosed = false;
+	};
+	TMap<int32, FSearchedLane> Searched;
+	TArray<FCostedLane> Open;
+
+	const double FromCost = LaneCost(FromLane);
+	Searched.Add(FromLane, FSearchedLane{ FromCost, INDEX_NONE, false });
+	Open.HeapPush(FCostedLane{ FromCost + LandmarkHeuristic(FromLane, CostIndex, TargetFromLandmarkCosts, TargetToLandmarkCosts), FromLane }, FCheaperLane());
+	while (Open.Num() > 0)
+	{
+		FCostedLane Current;
+		Open.HeapPop(Current, FCheaperLane(), EAllowShrinking::No);
+		FSearchedLane& CurrentSearched = Searched.FindChecked(Current.Lane);
+		if (CurrentSearched.bClosed)
+		{
+			// A stale entry for a lane we since reached more cheaply.
+			continue;
+		}
+		CurrentSearched.bClosed = true;
+		++OutRoute.NumExpanded;
+
+		if (Current.Lane == ToLane)
+		{
+			OutRoute.Cost = CurrentSearched.Cost;
+			for (int32 Lane = ToLane; Lane != INDEX_NONE; Lane = Searched.FindChecked(Lane).Parent)
+			{
+				OutRoute.Lanes.Add(Lane);
+				OutRoute.Length += LaneLengths[Lane];
+			}
+			Algo::Reverse(OutRoute.Lanes);
+			return true;
+		}
+
+		// Adding to Searched below may move CurrentSearched.
+		const double CurrentCost = CurrentSearched.Cost;
+		for (int32 LinkIndex = SuccessorsBegin[Current.Lane]; LinkIndex < SuccessorsBegin[Current.Lane + 1]; ++LinkIndex)
+		{
+			const int32 Next = Successors[LinkIndex];
+			if (!Options.TagFilter.Pass(LaneTags[Next]))
+			{
+				continue;
+			}
+			const double NextCost = CurrentCost + LaneCost(Next);
+			if (FSearchedLane* NextSearched = Searched.Find(Next))
+			{
+				if (NextSearched->bClosed || NextCost >= NextSearched->Cost)
+				{
+					continue;
+				}
+				NextSearched->Cost = NextCost;
+				NextSearched->Parent = Current.Lane;
+			}
+			else
+			{
+				Searched.Add(Next, FSearchedLane{ NextCost, Current.Lane, false });
+			}
+			Open.HeapPush(FCostedLane{ NextCost + LandmarkHeuristic(Next, CostIndex, TargetFromLandmarkCosts, TargetToLandmarkCosts), Next }, FCheaperLane());
+		}
+	}
+
+	OutError = FString::Printf(TEXT("No route from lane %d to lane %d"), FromLane, ToLane);
+	return false;
+}
@@ -13,13 +13,17 @@
 #endif
 
 #include "TempoAgents.h"
+#include "TempoLaneRoutingGraph.h"
 
 #include "TempoConversion.h"
 
+#include "MassTrafficSettings.h"
 #include "MassTrafficSubsystem.h"
 #include "ZoneGraphData.h"
+#include "ZoneGraphDelegates.h"
 #include "ZoneGraphSubsystem.h"
 
+#include "Async/ParallelFor.h"
 #include "EngineUtils.h"
 
 using MapQueryService = TempoAgents::MapQueryService;
@@ -28,13 +32,25 @@ using LaneDataRequest = TempoAgents::LaneDataRequest;
 using LaneDataResponse = TempoAgents::LaneDataResponse;
 using LaneAccessibilityRequest = TempoAgents::LaneAccessibilityRequest;
 using LaneAccessibilityResponse = TempoAgents::LaneAccessibilityResponse;
+using RouteLanesRequest = TempoAgents::RouteLanesRequest;
+using RouteLanesResponse = TempoAgents::RouteLanesResponse;
+
+namespace
+{
+	// Fewer route queries than this are answered on the game thread, where the cost of dispatching to workers would
+	// outweigh the searches.
+	constexpr int32 MinQueriesPerParallelRoute = 4;
+
+	constexpr float CmPerSecondPerMPH = 44.704f;
+}
 
 void UTempoMapQueryServiceSubsystem::RegisterServices(FTempoServer& Server)
 {
 	Server.RegisterService<MapQueryService>(
 		SimpleRequestHandler(&MapQueryAsyncService::RequestGetLanes, &UTempoMapQueryServiceSubsystem::GetLaneData),
 		SimpleRequestHandler(&MapQueryAsyncService::RequestGetLaneAccessibility, &UTempoMapQueryServiceSubsystem::GetLaneAccessibility),
-		StreamingRequestHandler(&MapQueryAsyncService::RequestStreamLaneAccessibility, &UTempoMapQueryServiceSubsystem::StreamLaneAccessibility)
+		StreamingRequestHandler(&MapQueryAsyncService::RequestStreamLaneAccessibility, &UTempoMapQueryServiceSubsystem::StreamLaneAccessibility),
+		SimpleRequestHandler(&MapQueryAsyncService::RequestRouteLanes, &UTempoMapQueryServiceSubsystem::RouteLanes)
 		);
 }
 
@@ -43,15 +59,87 @@ void UTempoMapQueryServiceSubsystem::Initialize(FSubsystemCollectionBase& Collec
 	Super::Initialize(Collection);
 
 	FTempoServer::Get().ActivateService<MapQueryService>(this);
+
+	// Build routing graphs for the zone graphs already registered, and for any registered later.
+	if (const UZoneGraphSubsystem* ZoneGraphSubsystem = Collection.InitializeDependency<UZoneGraphSubsystem>())
+	{
+		for (const FRegisteredZoneGraphData& Registered : ZoneGraphSubsystem->GetRegisteredZoneGraphData())
+		{
+			if (Registered.bInUse && Registered.ZoneGraphData != nullptr)
+			{
+				OnZoneGraphDataAdded(Registered.ZoneGraphData);
+			}
+		}
+	}
+	OnZoneGraphDataAddedHandle = UE::ZoneGraphDelegates::OnPostZoneGraphDataAdded.AddUObject(this, &UTempoMapQueryServiceSubsystem::OnZoneGraphDataAdded);
+	OnZoneGraphDataRemovedHandle = UE::ZoneGraphDelegates::OnPreZoneGraphDataRemoved.AddUObject(this, &UTempoMapQueryServiceSubsystem::OnZoneGraphDataRemoved);
 }
 
 void UTempoMapQueryServiceSubsystem::Deinitialize()
 {
+	UE::ZoneGraphDelegates::OnPostZoneGraphDataAdded.Remove(OnZoneGraphDataAddedHandle);
+	UE::ZoneGraphDelegates::OnPreZoneGraphDataRemoved.Remove(OnZoneGraphDataRemovedHandle);
+	LaneRoutingGraphs.Empty();
+
 	Super::Deinitialize();
 
 	FTempoServer::Get().DeactivateService<MapQueryService>();
 }
 
+void UTempoMapQueryServiceSubsystem::OnZoneGraphDataAdded(const AZoneGraphData* ZoneGraphData)
+{
+	// Only consider graphs from our world.
+	if (ZoneGraphData == nullptr || ZoneGraphData->GetWorld() != GetWorld())
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const FZoneGraphStorage& Storage = ZoneGraphData->GetStorage();
+
+	// The speed limits MassTraffic gives the lanes: the first of its settings' limits whose filter the lane passes.
+	const UMassTrafficSettings* MassTrafficSettings = GetDefault<UMassTrafficSettings>();
+	TArray<float> LaneSpeedLimits;
+	LaneSpeedLimits.SetNumZeroed(Storage.Lanes.Num());
+	for (int32 LaneIdx = 0; LaneIdx < Storage.Lanes.Num(); ++LaneIdx)
+	{
+		for (const FMassTrafficLaneSpeedLimit& LaneSpeedLimit : MassTrafficSettings->SpeedLimits)
+		{
+			if (LaneSpeedLimit.LaneFilter.Pass(Storage.Lanes[LaneIdx].Tags))
+			{
+				LaneSpeedLimits[LaneIdx] = LaneSpeedLimit.SpeedLimitMPH * CmPerSecondPerMPH;
+				break;
+			}
+		}
+	}
+
+	const TSharedPtr<const FTempoLaneRoutingGraph> LaneRoutingGraph = MakeShared<FTempoLaneRoutingGraph>(Storage, LaneSpeedLimits);
+	LaneRoutingGraphs.Add(Storage.DataHandle.Index, LaneRoutingGraph);
+	UE_LOG(LogTempoAgents, Display, TEXT("Built lane routing graph of %d lanes with %d landmarks in %.3f s"),
+		LaneRoutingGraph->NumLanes(), LaneRoutingGraph->NumLandmarks(), FPlatformTime::Seconds() - StartTime);
+}
+
+void UTempoMapQueryServiceSubsystem::OnZoneGraphDataRemoved(const AZoneGraphData* ZoneGraphData)
+{
+	if (ZoneGraphData == nullptr || ZoneGraphData->GetWorld() != GetWorld())
+	{
+		return;
+	}
+
+	LaneRoutingGraphs.Remove(ZoneGraphData->GetStorage().DataHandle.Index);
+}
+
+TMap<FString, FZoneGraphTag> GetTagsByName(const UZoneGraphSubsystem* ZoneGraphSubsystem)
+{
+	// Map from tag names (all lowercase) to tags.
+	TMap<FString, FZoneGraphTag> AllTags;
+	for (const auto& TagInfo : ZoneGraphSubsystem->GetTagInfos())
+	{
+		AllTags.Add(TagInfo.Name.ToString().ToLower(), TagInfo.Tag);
+	}
+	return AllTags;
+}
+
 TempoAgents::LaneRelationship LaneRelationshipFromLinkType(const EZoneLaneLinkType& LinkType)
 {
 	switch (LinkType)
@@ -80,12 +168,7 @@ void UTempoMapQueryServiceSubsystem::GetLaneData(const LaneDataRequest& Request,
 {
 	const UZoneGraphSubsystem* ZoneGraphSubsystem = GetWorld()->GetSubsystem<UZoneGraphSubsystem>();
 
-	// Map from tag names (all lowercase) to tags.
-	TMap<FString, FZoneGraphTag> AllTags;
-	for (const auto& TagInfo : ZoneGraphSubsystem->GetTagInfos())
-	{
-		AllTags.Add(TagInfo.Name.ToString().ToLower(), TagInfo.Tag);
-	}
+	const TMap<FString, FZoneGraphTag> AllTags = GetTagsByName(ZoneGraphSubsystem);
 
 	auto BuildTagMask = [&AllTags] (const google::protobuf_tempo::RepeatedPtrField<std::string>& RequestedTags)
 	{
@@ -200,6 +283,108 @@ void UTempoMapQueryServiceSubsystem::StreamLaneAccessibility(const TempoAgents::
 	}
 }
 
+void UTempoMapQueryServiceSubsystem::RouteLanes(const RouteLanesRequest& Request, const TResponseDelegate<RouteLanesResponse>& ResponseContinuation) const
+{
+	// Lane IDs are indices into a zone graph's lanes. Route on the first registered one.
+	TSharedPtr<const FTempoLaneRoutingGraph> LaneRoutingGraph;
+	int32 LaneRoutingGraphIndex = MAX_int32;
+	for (const auto& Elem : LaneRoutingGraphs)
+	{
+		if (Elem.Key < LaneRoutingGraphIndex)
+		{
+			LaneRoutingGraphIndex = Elem.Key;
+			LaneRoutingGraph = Elem.Value;
+		}
+	}
+	if (!LaneRoutingGraph.IsValid())
+	{
+		ResponseContinuation.ExecuteIfBound(RouteLanesResponse(), grpc::Status(grpc::StatusCode::FAILED_PRECONDITION, "No lane graph to route on"));
+		return;
+	}
+
+	const UZoneGraphSubsystem* ZoneGraphSubsystem = GetWorld()->GetSubsystem<UZoneGraphSubsystem>();
+	const TMap<FString, FZoneGraphTag> AllTags = GetTagsByName(ZoneGraphSubsystem);
+
+	// Unlike GetLanes, a misspelled tag fails the request: silently routing through lanes it was meant to exclude (or
+	// without the cost it was meant to add) would be worse than no route.
+	FString UnknownTagName;
+	auto FindTag = [&AllTags, &UnknownTagName] (const std::string& RequestedTag) -> const FZoneGraphTag*
+	{
+		const FString RequestedName(UTF8_TO_TCHAR(RequestedTag.c_str()));
+		const FZoneGraphTag* Tag = AllTags.Find(RequestedName.ToLower());
+		if (!Tag)
+		{
+			UnknownTagName = RequestedName;
+		}
+		return Tag;
+	};
+	auto BuildTagMask = [&FindTag] (const google::protobuf_tempo::RepeatedPtrField<std::string>& RequestedTags)
+	{
+		FZoneGraphTagMask Mask;
+		for (const std::string& RequestedTag : RequestedTags)
+		{
+			if (const FZoneGraphTag* Tag = FindTag(RequestedTag))
+			{
+				Mask.Add(*Tag);
+			}
+		}
+		return Mask;
+	};
+
+	FTempoLaneRouteOptions Options;
+	Options.Cost = Request.cost() == TempoAgents::RC_TRAVEL_TIME ? ETempoLaneRouteCost::TravelTime : ETempoLaneRouteCost::Distance;
+	Options.TagFilter = FZoneGraphTagFilter{ BuildTagMask(Request.tag_filter().any_tags()), BuildTagMask(Request.tag_filter().all_tags()), BuildTagMask(Request.tag_filter().none_tags()) };
+	for (const TempoAgents::TagCost& TagCost : Request.tag_costs())
+	{
+		if (TagCost.multiplier() < 1.0)
+		{
+			ResponseContinuation.ExecuteIfBound(RouteLanesResponse(), grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "Tag cost multipliers must be at least 1"));
+			return;
+		}
+		if (const FZoneGraphTag* Tag = FindTag(TagCost.tag()))
+		{
+			Options.TagCostMultipliers.Emplace(*Tag, TagCost.multiplier());
+		}
+	}
+	if (!UnknownTagName.IsEmpty())
+	{
+		ResponseContinuation.ExecuteIfBound(RouteLanesResponse(), grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, TCHAR_TO_UTF8(*FString::Printf(TEXT("Could not find tag for name %s"), *UnknownTagName))));
+		return;
+	}
+
+	// The searches only read the graph, so they can run side by side.
+	const int32 NumQueries = Request.queries_size();
+	TArray<FTempoLaneRoute> Routes;
+	Routes.SetNum(NumQueries);
+	TArray<FString> Errors;
+	Errors.SetNum(NumQueries);
+	ParallelFor(NumQueries, [&Request, &LaneRoutingGraph, &Options, &Routes, &Errors](int32 QueryIdx)
+	{
+		const TempoAgents::RouteQuery& Query = Request.queries(QueryIdx);
+		LaneRoutingGraph->FindRoute(Query.from_id(), Query.to_id(), Options, Routes[QueryIdx], Errors[QueryIdx]);
+	}, NumQueries < MinQueriesPerParallelRoute ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	RouteLanesResponse Response;
+	for (int32 QueryIdx = 0; QueryIdx < NumQueries; ++QueryIdx)
+	{
+		auto* route = Response.add_routes();
+		if (!Errors[QueryIdx].IsEmpty())
+		{
+			route->set_error(TCHAR_TO_UTF8(*Errors[QueryIdx]));
+			continue;
+		}
+		const FTempoLaneRoute& Route = Routes[QueryIdx];
+		route->mutable_lane_ids()->Reserve(Route.Lanes.Num());
+		for (const int32 LaneIdx : Route.Lanes)
+		{
+			route->add_lane_ids(LaneIdx);
+		}
+		route->set_cost(Route.Cost);
+		route->set_length_m(Route.Length);
+	}
+	ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
+}
+
 TempoAgents::LaneAccessibility UTempoMapQueryServiceSubsystem::GetLaneAccessibility(const int32 LaneId) const
 {
 	const UMassTrafficSubsystem* MassTrafficSubsystem = GetWorld()->GetSubsystem<UMassTrafficSubsystem>();
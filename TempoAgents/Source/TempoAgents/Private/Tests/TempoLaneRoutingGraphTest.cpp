@@ -0,0 +1,230 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoLaneRoutingGraph.h"
+
+#include "ZoneGraphTypes.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+// Tests for FTempoLaneRoutingGraph: routes found with landmarks are as cheap as those found without (plain Dijkstra),
+// for every cost and with tag filters and multipliers, while expanding fewer lanes; and a benchmark of both on a
+// larger graph (reported as test info). The graphs are procedural lane grids, so no world is needed. Runs headlessly
+// via:
+//   Scripts/Test.sh Tempo.Agents.LaneRouting
+//   Automation RunTests Tempo.Agents.LaneRouting   (from the editor console)
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoLaneRoutingTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	const FZoneGraphTag SlowTag(1);
+	const FZoneGraphTag ClosedTag(2);
+
+	// A Size x Size grid of lanes, each linked to its neighbors to the east and north, and on alternating rows and
+	// columns to the west and south, with random lengths, speed limits, and tags. One extra lane has no links at all.
+	struct FLaneGrid
+	{
+		FZoneGraphStorage Storage;
+		TArray<float> SpeedLimits;
+
+		FLaneGrid(int32 Size, int32 Seed)
+		{
+			const FRandomStream Random(Seed);
+			const int32 NumLanes = Size * Size + 1;
+			for (int32 LaneIndex = 0; LaneIndex < NumLanes; ++LaneIndex)
+			{
+				const int32 X = LaneIndex % Size;
+				const int32 Y = LaneIndex / Size;
+				FZoneLaneData& Lane = Storage.Lanes.AddDefaulted_GetRef();
+				Lane.PointsBegin = Storage.LanePoints.Num();
+				Storage.LanePoints.Add(FVector(X * 1000.0, Y * 1000.0, 0.0));
+				Storage.LanePoints.Add(FVector(X * 1000.0 + 1.0, Y * 1000.0, 0.0));
+				Storage.LanePointProgressions.Add(0.0f);
+				Storage.LanePointProgressions.Add(Random.FRandRange(500.0f, 3000.0f));
+				Lane.PointsEnd = Storage.LanePoints.Num();
+				if (Random.FRand() < 0.2f)
+				{
+					Lane.Tags.Add(SlowTag);
+				}
+				if (Random.FRand() < 0.05f)
+				{
+					Lane.Tags.Add(ClosedTag);
+				}
+				SpeedLimits.Add(Random.FRandRange(500.0f, 3000.0f));
+
+				Lane.LinksBegin = Storage.LaneLinks.Num();
+				if (LaneIndex < Size * Size)
+				{
+					auto AddLink = [this, Size](int32 DestX, int32 DestY)
+					{
+						if (DestX >= 0 && DestX < Size && DestY >= 0 && DestY < Size)
+						{
+							FZoneLaneLinkData& Link = Storage.LaneLinks.AddDefaulted_GetRef();
+							Link.DestLaneIndex = DestY * Size + DestX;
+							Link.Type = EZoneLaneLinkType::Outgoing;
+						}
+					};
+					AddLink(X + 1, Y);
+					AddLink(X, Y + 1);
+					if (Y % 2 == 0)
+					{
+						AddLink(X - 1, Y);
+					}
+					if (X % 2 == 0)
+					{
+						AddLink(X, Y - 1);
+					}
+				}
+				Lane.LinksEnd = Storage.LaneLinks.Num();
+			}
+		}
+
+		bool IsLinked(int32 FromLane, int32 ToLane) const
+		{
+			const FZoneLaneData& Lane = Storage.Lanes[FromLane];
+			for (int32 LinkIndex = Lane.LinksBegin; LinkIndex < Lane.LinksEnd; ++LinkIndex)
+			{
+				if (Storage.LaneLinks[LinkIndex].DestLaneIndex == ToLane)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoLaneRoutingRoutesTest,
+	"Tempo.Agents.LaneRouting.Routes", TempoLaneRoutingTestFlags)
+bool FTempoLaneRoutingRoutesTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 GridSize = 30;
+	const FLaneGrid Grid(GridSize, 12345);
+	const FTempoLaneRoutingGraph WithLandmarks(Grid.Storage, Grid.SpeedLimits);
+	const FTempoLaneRoutingGraph WithoutLandmarks(Grid.Storage, Grid.SpeedLimits, /*InNumLandmarks=*/0);
+	TestEqual(TEXT("Every lane is in the graph"), WithLandmarks.NumLanes(), GridSize * GridSize + 1);
+	TestEqual(TEXT("The default number of landmarks is placed"), WithLandmarks.NumLandmarks(), FTempoLaneRoutingGraph::DefaultNumLandmarks);
+
+	FTempoLaneRouteOptions DistanceOptions;
+	FTempoLaneRouteOptions TravelTimeOptions;
+	TravelTimeOptions.Cost = ETempoLaneRouteCost::TravelTime;
+	FTempoLaneRouteOptions TaggedOptions;
+	TaggedOptions.TagFilter.NotTags.Add(ClosedTag);
+	TaggedOptions.TagCostMultipliers.Emplace(SlowTag, 3.0f);
+
+	const FRandomStream Random(54321);
+	for (const FTempoLaneRouteOptions* Options : { &DistanceOptions, &TravelTimeOptions, &TaggedOptions })
+	{
+		int32 NumRoutes = 0;
+		int32 NumMismatches = 0;
+		int32 NumExpandedWithLandmarks = 0;
+		int32 NumExpandedWithoutLandmarks = 0;
+		for (int32 QueryIndex = 0; QueryIndex < 300; ++QueryIndex)
+		{
+			const int32 FromLane = Random.RandHelper(GridSize * GridSize);
+			const int32 ToLane = Random.RandHelper(GridSize * GridSize);
+			FTempoLaneRoute Route;
+			FTempoLaneRoute ExpectedRoute;
+			FString Error;
+			const bool bFound = WithLandmarks.FindRoute(FromLane, ToLane, *Options, Route, Error);
+			const bool bExpectedFound = WithoutLandmarks.FindRoute(FromLane, ToLane, *Options, ExpectedRoute, Error);
+			NumExpandedWithLandmarks += Route.NumExpanded;
+			NumExpandedWithoutLandmarks += ExpectedRoute.NumExpanded;
+			if (bFound != bExpectedFound || (bFound && !FMath::IsNearlyEqual(Route.Cost, ExpectedRoute.Cost, ExpectedRoute.Cost * 1e-4)))
+			{
+				if (NumMismatches++ == 0)
+				{
+					AddError(FString::Printf(TEXT("Route from %d to %d: with landmarks %s (cost %f), without %s (cost %f)"), FromLane, ToLane,
+						bFound ? TEXT("found") : TEXT("not found"), Route.Cost, bExpectedFound ? TEXT("found") : TEXT("not found"), ExpectedRoute.Cost));
+				}
+				continue;
+			}
+			if (!bFound)
+			{
+				continue;
+			}
+			++NumRoutes;
+
+			// The route must follow the links, and cost what its lanes do.
+			bool bValid = Route.Lanes.Num() > 0 && Route.Lanes[0] == FromLane && Route.Lanes.Last() == ToLane;
+			double Cost = 0.0;
+			for (int32 RouteIndex = 0; RouteIndex < Route.Lanes.Num(); ++RouteIndex)
+			{
+				const int32 Lane = Route.Lanes[RouteIndex];
+				const FZoneLaneData& LaneData = Grid.Storage.Lanes[Lane];
+				const float Length = Grid.Storage.LanePointProgressions[LaneData.PointsEnd - 1];
+				double LaneCost = Options->Cost == ETempoLaneRouteCost::Distance ? Length / 100.0 : Length / Grid.SpeedLimits[Lane];
+				if (LaneData.Tags.Contains(SlowTag) && Options == &TaggedOptions)
+				{
+					LaneCost *= 3.0;
+				}
+				Cost += LaneCost;
+				bValid &= Options->TagFilter.Pass(LaneData.Tags);
+				bValid &= RouteIndex == 0 || Grid.IsLinked(Route.Lanes[RouteIndex - 1], Lane);
+			}
+			if (!(bValid && FMath::IsNearlyEqual(Cost, Route.Cost, Cost * 1e-4)) && NumMismatches++ == 0)
+			{
+				AddError(FString::Printf(TEXT("Route from %d to %d (cost %f) doesn't follow the lanes (cost %f)"), FromLane, ToLane, Route.Cost, Cost));
+			}
+		}
+		TestEqual(TEXT("Landmarks find routes as cheap as a search without them"), NumMismatches, 0);
+		TestTrue(TEXT("Most lanes are reachable from most others"), NumRoutes > 200);
+		TestTrue(TEXT("Landmarks save expanding lanes"), NumExpandedWithLandmarks < NumExpandedWithoutLandmarks);
+	}
+
+	FTempoLaneRoute Route;
+	FString Error;
+	TestFalse(TEXT("There is no route to a lane without links"), WithLandmarks.FindRoute(0, GridSize * GridSize, DistanceOptions, Route, Error));
+	TestEqual(TEXT("A lane without links has no route to it"), Error, FString::Printf(TEXT("No route from lane 0 to lane %d"), GridSize * GridSize));
+	TestFalse(TEXT("There is no route from a lane that doesn't exist"), WithLandmarks.FindRoute(-1, 0, DistanceOptions, Route, Error));
+	TestTrue(TEXT("The route from a lane to itself is that lane"), WithLandmarks.FindRoute(7, 7, DistanceOptions, Route, Error) && Route.Lanes == TArray<int32>({ 7 }));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoLaneRoutingBenchmarkTest,
+	"Tempo.Agents.LaneRouting.Benchmark", TempoLaneRoutingTestFlags)
+bool FTempoLaneRoutingBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 GridSize = 150;
+	constexpr int32 NumQueries = 1000;
+	const FLaneGrid Grid(GridSize, 12345);
+
+	double StartTime = FPlatformTime::Seconds();
+	const FTempoLaneRoutingGraph WithLandmarks(Grid.Storage, Grid.SpeedLimits);
+	const double BuildTime = FPlatformTime::Seconds() - StartTime;
+	const FTempoLaneRoutingGraph WithoutLandmarks(Grid.Storage, Grid.SpeedLimits, /*InNumLandmarks=*/0);
+
+	const FRandomStream Random(54321);
+	TArray<TPair<int32, int32>> Queries;
+	for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+	{
+		Queries.Emplace(Random.RandHelper(GridSize * GridSize), Random.RandHelper(GridSize * GridSize));
+	}
+
+	const FTempoLaneRouteOptions Options;
+	for (const FTempoLaneRoutingGraph* Graph : { &WithoutLandmarks, &WithLandmarks })
+	{
+		int32 NumExpanded = 0;
+		FTempoLaneRoute Route;
+		FString Error;
+		StartTime = FPlatformTime::Seconds();
+		for (const TPair<int32, int32>& Query : Queries)
+		{
+			Graph->FindRoute(Query.Key, Query.Value, Options, Route, Error);
+			NumExpanded += Route.NumExpanded;
+		}
+		const double QueryTime = (FPlatformTime::Seconds() - StartTime) / NumQueries;
+		AddInfo(FString::Printf(TEXT("%d lanes, %d landmarks: %.3f ms and %d lanes expanded per route"),
+			Graph->NumLanes(), Graph->NumLandmarks(), QueryTime * 1000.0, NumExpanded / NumQueries));
+	}
+	AddInfo(FString::Printf(TEXT("Built landmarks in %.3f s"), BuildTime));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,94 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ZoneGraphTypes.h"
+
+struct FZoneGraphStorage;
+
+enum class ETempoLaneRouteCost : uint8
+{
+	// Length of the lanes, in meters.
+	Distance,
+	// Time to drive the lanes at their speed limits, in seconds.
+	TravelTime,
+};
+
+struct FTempoLaneRouteOptions
+{
+	ETempoLaneRouteCost Cost = ETempoLaneRouteCost::Distance;
+
+	// Only lanes that pass this filter are routed through, including the first and last.
+	FZoneGraphTagFilter TagFilter;
+
+	// The cost of lanes with each tag is multiplied by its multiplier, which must be at least 1 (so the landmarks'
+	// bounds, computed without any, still hold).
+	TArray<TPair<FZoneGraphTag, float>> TagCostMultipliers;
+};
+
+struct FTempoLaneRoute
+{
+	// Indices of the lanes to drive, from the first to the last.
+	TArray<int32> Lanes;
+	// In the units of the route's cost, counting every lane in full, including the first and last.
+	double Cost = 0.0;
+	// In meters.
+	double Length = 0.0;
+	// Lanes taken from the search's open set, a measure of how well the landmarks guided it.
+	int32 NumExpanded = 0;
+};
+
+// A compact copy of a zone graph's lanes and the outgoing links between them, for finding routes through it. Routes
+// are found with A*, guided by landmark (ALT) heuristics: the cost of the cheapest route from and to each of a few
+// landmark lanes, spread across the graph, is computed for every lane up front, and by the triangle inequality the
+// differences bound the cost of the cheapest route between any two lanes from below. Landmarks are kept for both
+// costs, without tag multipliers or filters, which can only make routes more expensive. Immutable once built, so
+// routes can be found on any thread.
+class TEMPOAGENTS_API FTempoLaneRoutingGraph
+{
+public:
+	static constexpr int32 DefaultNumLandmarks = 8;
+
+	// LaneSpeedLimits (cm/s) are indexed by lane. Lanes without one (or slower than a walk) are costed at walking pace.
+	FTempoLaneRoutingGraph(const FZoneGraphStorage& Storage, TConstArrayView<float> LaneSpeedLimits, int32 InNumLandmarks = DefaultNumLandmarks);
+
+	int32 NumLanes() const { return LaneCosts[0].Num(); }
+
+	int32 NumLandmarks() const { return Landmarks.Num(); }
+
+	// Finds the cheapest route from FromLane to ToLane. Returns false, with the reason in OutError, if there is none.
+	bool FindRoute(int32 FromLane, int32 ToLane, const FTempoLaneRouteOptions& Options, FTempoLaneRoute& OutRoute, FString& OutError) const;
+
+private:
+	static constexpr int32 NumCosts = 2;
+
+	static constexpr float UnreachableCost = TNumericLimits<float>::Max();
+
+	// Lanes' outgoing links (successors) and incoming links (predecessors), in compressed rows: the links of lane I are
+	// [Begin[I], Begin[I + 1]).
+	TArray<int32> SuccessorsBegin;
+	TArray<int32> Successors;
+	TArray<int32> PredecessorsBegin;
+	TArray<int32> Predecessors;
+
+	TArray<FZoneGraphTagMask> LaneTags;
+	// In meters.
+	TArray<float> LaneLengths;
+	// Of driving each lane, per ETempoLaneRouteCost.
+	TArray<float> LaneCosts[NumCosts];
+
+	TArray<int32> Landmarks;
+	// Per ETempoLaneRouteCost, the cost of the cheapest route from and to each landmark, for each lane, landmark-major
+	// (Landmark * NumLanes() + Lane). UnreachableCost if there is none.
+	TArray<float> FromLandmarkCosts[NumCosts];
+	TArray<float> ToLandmarkCosts[NumCosts];
+
+	// The cost of the cheapest route from (or, if bReverse, to) Source to every lane. As everywhere here, a lane's cost
+	// is counted when entering it, so Source's own isn't.
+	void ComputeCosts(int32 Source, ETempoLaneRouteCost Cost, bool bReverse, TArrayView<float> OutCosts) const;
+
+	// A lower bound on the cost of the cheapest route from Lane to the target, given the target's costs from and to each
+	// landmark.
+	double LandmarkHeuristic(int32 Lane, int32 CostIndex, TConstArrayView<float> TargetFromLandmarkCosts, TConstArrayView<float> TargetToLandmarkCosts) const;
+};
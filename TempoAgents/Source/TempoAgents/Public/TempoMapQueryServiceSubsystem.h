@@ -11,6 +11,9 @@
 
 #include "TempoAgents/MapQueries.pb.h"
 
+class AZoneGraphData;
+class FTempoLaneRoutingGraph;
+
 #include "TempoMapQueryServiceSubsystem.generated.h"
 
 UCLASS()
@@ -37,7 +40,21 @@ public:
 
 	TempoAgents::LaneAccessibility GetLaneAccessibility(const int32 LaneId) const;
 
+	// Finds the cheapest route for each query, in parallel, on the lane routing graph built when the zone graph
+	// registered.
+	void RouteLanes(const TempoAgents::RouteLanesRequest& Request, const TResponseDelegate<TempoAgents::RouteLanesResponse>& ResponseContinuation) const;
+
 protected:
+	void OnZoneGraphDataAdded(const AZoneGraphData* ZoneGraphData);
+
+	void OnZoneGraphDataRemoved(const AZoneGraphData* ZoneGraphData);
+
+	// Lane routing graphs (with their landmarks) of each registered zone graph, by data handle index.
+	TMap<int32, TSharedPtr<const FTempoLaneRoutingGraph>> LaneRoutingGraphs;
+
+	FDelegateHandle OnZoneGraphDataAddedHandle;
+	FDelegateHandle OnZoneGraphDataRemovedHandle;
+
 	struct FLaneAccessibilityInfo
 	{
 		FLaneAccessibilityInfo() = default;
@@ -215,6 +215,33 @@ def generate_tempo_api(tempo_sim_dir, project_pkg_dir, project_import_name):
         "        yield response\n" \
         "\n\n" \
 
+    # Bidirectional streaming RPCs take the requests to send as an iterable (or, for the async version, an async
+    # iterable) of request messages, rather than the fields of one request.
+    bidi_streaming_rpc_template = \
+        "import " \
+        "{% for import in imports %}" \
+        "{{ import }}{% if not loop.last %}, {% endif %}" \
+        "{% endfor %}" \
+        "\n" \
+        "async def _{{ name }}(requests) -> {{ response.full_name }}:\n" \
+        "    stub = await tempo_context().get_stub({{ service.module_name }}_grpc.{{ service.object_name }}Stub)\n" \
+        "    async for response in stub.{{ rpc.name }}(requests):\n" \
+        "        yield response\n" \
+        "\n\n" \
+        "def {{ name }}(requests) -> {{ response.full_name }}:\n" \
+        "    async_gen = _{{ name }}(requests)\n" \
+        "    while True:\n" \
+        "        try:\n" \
+        "            yield run_async(async_gen.__anext__())\n" \
+        "        except StopAsyncIteration:\n" \
+        "            break\n" \
+        "\n\n" \
+        "@awaitable({{ name }})\n" \
+        "async def {{ name }}(requests) -> {{ response.full_name }}:\n" \
+        "    async for response in _{{ name }}(requests):\n" \
+        "        yield response\n" \
+        "\n\n" \
+
     # Template for a Batch class that wraps a oneof-of-Set*PropertyRequest into
     # a fluent builder, so users don't have to construct SetPropertyOp messages
     # themselves. One method per oneof variant; execute() / execute_async() send
@@ -278,9 +305,11 @@ def generate_tempo_api(tempo_sim_dir, project_pkg_dir, project_import_name):
                 tempo_request_descriptor = all_messages[rpc_descriptor.request_type]
                 tempo_response_descriptor = all_messages[rpc_descriptor.response_type]
                 templates = []
-                if rpc_descriptor.client_streaming:
+                if rpc_descriptor.client_streaming and not rpc_descriptor.server_streaming:
                     raise Exception("Client streaming RPCs are not yet supported")
-                if rpc_descriptor.server_streaming:
+                if rpc_descriptor.client_streaming:
+                    templates.append(j2_environment.from_string(bidi_streaming_rpc_template))
+                elif rpc_descriptor.server_streaming:
                     templates.append(j2_environment.from_string(streaming_rpc_template))
                 else:
                     templates.append(j2_environment.from_string(simple_rpc_template))
@@ -191,17 +191,15 @@ void FTempoServer::Deinitialize()
 	// Flush (and discard) all pending events (until we get the shutdown event).
 	int32* Tag;
 	bool bOk;
+	// The request managers are kept until the queue is empty, since a pending event's tag points into its manager
+	// (and a bidirectional stream's manager can have two).
 	while (CompletionQueue->Next(reinterpret_cast<void**>(&Tag), &bOk))
 	{
-		if (!bOk)
-		{
-			// gRPC gives us one event per tag with bOk=false to clean up.
-			RequestManagers.Remove(*Tag);
-		}
 	}
 
 	Services.Empty();
 	RequestManagers.Empty();
+	ReleasedRequestManagers.Empty();
 }
 
 void FTempoServer::Reinitialize()
@@ -307,15 +305,34 @@ void FTempoServer::TickInternal()
 			}
 		}
 	}
+
+	EventsHandledDelegate.Broadcast();
 }
 
 void FTempoServer::HandleEventForTag(int32 Tag, bool bOk)
 {
+	if (FRequestManager::IsReadTag(Tag))
+	{
+		// A read completed on a bidirectional stream.
+		const int32 ManagerTag = FRequestManager::ConvertReadTag(Tag);
+		if (TSharedPtr<FRequestManager>* RequestManager = RequestManagers.Find(ManagerTag))
+		{
+			if (ReleasedRequestManagers.Remove(ManagerTag) > 0)
+			{
+				// The rpc already finished, and this was the event it was waiting on.
+				RequestManagers.Remove(ManagerTag);
+				return;
+			}
+			(*RequestManager)->HandleReadEvent(bOk);
+		}
+		return;
+	}
+
 	if (TSharedPtr<FRequestManager>* RequestManager = RequestManagers.Find(Tag))
 	{
 		if (!bOk)
 		{
-			RequestManagers.Remove(Tag);
+			ReleaseRequestManager(Tag);
 			return;
 		}
 
@@ -347,13 +364,25 @@ void FTempoServer::HandleEventForTag(int32 Tag, bool bOk)
 			}
 		case FRequestManager::FINISHING: // The rpc has finished.
 			{
-				RequestManagers.Remove(Tag);
+				ReleaseRequestManager(Tag);
 				break;
 			}
 		}
 	}
 }
 
+void FTempoServer::ReleaseRequestManager(int32 Tag)
+{
+	const TSharedPtr<FRequestManager>* RequestManager = RequestManagers.Find(Tag);
+	if (RequestManager && (*RequestManager)->HasPendingRead())
+	{
+		// Its read's event is still to come, and points into it.
+		ReleasedRequestManagers.Add(Tag);
+		return;
+	}
+	RequestManagers.Remove(Tag);
+}
+
 TStatId FTempoServer::GetStatId() const
 {
 	RETURN_QUICK_DECLARE_CYCLE_STAT(FTempoServer, STATGROUP_Tickables);
@@ -190,6 +190,16 @@ void ATempoWorldSettings::SyncFixedPointTime()
 	FixedStepsCount = static_cast<uint64>(std::nextafterf(SimTime, TNumericLimits<float>::Max()) * Settings->GetSimulatedStepsPerSecond());
 }
 
+void ATempoWorldSettings::SetSimTime(double SimTime)
+{
+	UWorld* World = GetWorld();
+	check(World);
+
+	World->TimeSeconds = SimTime;
+	World->UnpausedTimeSeconds = SimTime;
+	SyncFixedPointTime();
+}
+
 bool ATempoWorldSettings::Step(int32 NumSteps, TFunction<void(ETempoStepResult)> OnComplete)
 {
 	if (OnComplete && PendingStepCompletion)
@@ -0,0 +1,29 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "TempoPoolableActorInterface.generated.h"
+
+UINTERFACE()
+class TEMPOCORE_API UTempoPoolableActorInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+// Implemented by actors that need more than the actor pool's generic reset to be reused. On release the pool
+// hides the actor, disables its collision and ticking, and deactivates its components. On reuse it moves the
+// actor to its new spawn transform and restores those from the class defaults.
+class TEMPOCORE_API ITempoPoolableActorInterface
+{
+	GENERATED_BODY()
+
+public:
+	// Called when the actor is returned to the pool instead of being destroyed.
+	virtual void OnReleasedToPool() {}
+
+	// Called when the actor is taken from the pool instead of a new one being spawned, after the generic
+	// reset. Should put back whatever else a fresh spawn would have.
+	virtual void ResetForReuse() {}
+};
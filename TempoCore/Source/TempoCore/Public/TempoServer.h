@@ -7,14 +7,25 @@
 #include "CoreMinimal.h"
 #include "TempoServiceProvider.h"
 
-template <class ResponseType>
-using TResponseDelegate = TDelegate<void(const ResponseType&, grpc::Status)>;
-
 namespace grpc
 {
 	static const Status Status_OK;
 }
 
+// The status a handler responds with. Converts from a grpc::Status, so handlers pass one as it is, unless they are
+// ending a server stream: then they set bLastResponse with an OK status, and the response is written as the stream's
+// last before it finishes with OK.
+struct FTempoResponseStatus : grpc::Status
+{
+	FTempoResponseStatus(const grpc::Status& Status, bool bInLastResponse = false)
+		: grpc::Status(Status), bLastResponse(bInLastResponse) {}
+
+	bool bLastResponse = false;
+};
+
+template <class ResponseType>
+using TResponseDelegate = TDelegate<void(const ResponseType&, FTempoResponseStatus)>;
+
 template <class AsyncServiceType, class RequestType, class ResponseType, template <class> class ResponderType, class UserObjectType, bool Const>
 struct TRequestHandler
 {
@@ -120,6 +131,96 @@ StreamingRequestHandler(void(ServiceType::*AcceptFunc)(grpc::ServerContext*, Req
 	return TStreamingRequestHandler<ServiceType, RequestType, ResponseType, UserObjectType, true>(AcceptFunc, HandleFunc);
 }
 
+/**
+ * Handler for bidirectional streaming rpcs. The client's requests are read after the call is accepted (so, unlike
+ * the other handlers, the accept function does not take a request), and the user handler is called once per request,
+ * always with the same response delegate. Responses may be sent through that delegate at any time (not only from the
+ * handler), until the client finishes writing and the stream is finished OK, or a non-OK response finishes it early.
+ * The delegate is unbound once the rpc is done.
+ */
+template <class AsyncServiceType, class RequestType, class ResponseType, class UserObjectType, bool Const>
+struct TBidiStreamingRequestHandler
+{
+	typedef AsyncServiceType HandlerServiceType;
+	typedef RequestType HandlerRequestType;
+	typedef ResponseType HandlerResponseType;
+	typedef grpc::ServerAsyncReaderWriter<ResponseType, RequestType> HandlerResponderType;
+	typedef UserObjectType HandlerUserObjectType;
+
+	typedef typename TMemFunPtrType<false, AsyncServiceType, void(grpc::ServerContext*, HandlerResponderType*, grpc::CompletionQueue*, grpc::ServerCompletionQueue*, void*)>::Type AcceptFuncType;
+	typedef typename TMemFunPtrType<Const, UserObjectType, void(const RequestType&, const TResponseDelegate<ResponseType>&)>::Type HandleFuncType;
+
+	TBidiStreamingRequestHandler(AcceptFuncType AcceptFuncIn, HandleFuncType HandleFuncIn)
+		: AcceptFunc(AcceptFuncIn), HandleFunc(HandleFuncIn)
+	{
+		static_assert(std::is_base_of_v<grpc::Service, AsyncServiceType>);
+	}
+
+	void Init(AsyncServiceType* Service)
+	{
+		AcceptDelegate.BindRaw(Service, AcceptFunc);
+	}
+
+	void AcceptRequests(grpc::ServerContext* Context, RequestType* Request, HandlerResponderType* Responder, grpc::ServerCompletionQueue* CompletionQueue, void* Tag)
+	{
+		check(AcceptDelegate.IsBound());
+		AcceptDelegate.Execute(Context, Responder, CompletionQueue, CompletionQueue, Tag);
+	}
+
+	void HandleRequest(const RequestType& Request, const TResponseDelegate<ResponseType>& ResponseDelegate)
+	{
+		if (!HandleDelegate.ExecuteIfBound(Request, ResponseDelegate))
+		{
+			ResponseDelegate.ExecuteIfBound(ResponseType(), grpc::Status(grpc::UNAVAILABLE, "Service is not active"));
+		}
+	}
+
+	void Activate(UserObjectType* UserObject)
+	{
+		if (!ensureAlwaysMsgf(!UserObject->HasAnyFlags(RF_ClassDefaultObject), TEXT("Activate called on CDO! Do not call ActivateService from RegisterServices.")))
+		{
+			return;
+		}
+		ensureAlwaysMsgf(!HandleDelegate.IsBound() || HandleDelegate.IsBoundToObject(UserObject), TEXT("Handle delegate was already bound to another object."));
+		HandleDelegate.BindUObject(UserObject, HandleFunc);
+		ActiveObject = UserObject;
+	}
+
+	void Deactivate()
+	{
+		HandleDelegate.Unbind();
+		ActiveObject.Reset();
+	}
+
+	const FWeakObjectPtr& GetActiveObject() const
+	{
+		return ActiveObject;
+	}
+
+private:
+	AcceptFuncType AcceptFunc;
+	HandleFuncType HandleFunc;
+	TDelegate<void(const RequestType&, const TResponseDelegate<ResponseType>&)> HandleDelegate;
+	TDelegate<void(grpc::ServerContext*, HandlerResponderType*, grpc::CompletionQueue*, grpc::ServerCompletionQueue*, void*)> AcceptDelegate;
+	FWeakObjectPtr ActiveObject;
+};
+
+template <class ServiceType, class RequestType, class ResponseType, class UserObjectType>
+TBidiStreamingRequestHandler<ServiceType, RequestType, ResponseType, UserObjectType, false>
+BidiStreamingRequestHandler(void(ServiceType::*AcceptFunc)(grpc::ServerContext*, grpc::ServerAsyncReaderWriter<ResponseType, RequestType>*, grpc::CompletionQueue*, grpc::ServerCompletionQueue*, void*),
+	void(UserObjectType::*HandleFunc)(const RequestType&, const TResponseDelegate<ResponseType>&))
+{
+	return TBidiStreamingRequestHandler<ServiceType, RequestType, ResponseType, UserObjectType, false>(AcceptFunc, HandleFunc);
+}
+
+template <class ServiceType, class RequestType, class ResponseType, class UserObjectType>
+TBidiStreamingRequestHandler<ServiceType, RequestType, ResponseType, UserObjectType, true>
+BidiStreamingRequestHandler(void(ServiceType::*AcceptFunc)(grpc::ServerContext*, grpc::ServerAsyncReaderWriter<ResponseType, RequestType>*, grpc::CompletionQueue*, grpc::ServerCompletionQueue*, void*),
+	void(UserObjectType::*HandleFunc)(const RequestType&, const TResponseDelegate<ResponseType>&) const)
+{
+	return TBidiStreamingRequestHandler<ServiceType, RequestType, ResponseType, UserObjectType, true>(AcceptFunc, HandleFunc);
+}
+
 /**
  * A request manager manages the lifecycle of one gRPC request.
  * This interface allows ownership by the FTempoServer without visibility into the concrete handler types.
@@ -137,6 +238,14 @@ struct FRequestManager : TSharedFromThis<FRequestManager>
 	virtual void Activate(UObject* Object) = 0;
 	virtual void Deactivate() = 0;
 	virtual const FWeakObjectPtr& GetActiveObject() const = 0;
+
+	// Bidirectional streams have a read and a write in flight at once, so they read under a second tag: the negative
+	// counterpart of their own (each converts to the other).
+	static int32 ConvertReadTag(int32 Tag) { return -Tag - 1; }
+	static bool IsReadTag(int32 Tag) { return Tag < 0; }
+	virtual void HandleReadEvent(bool bOk) {}
+	// A manager with a read in flight can't be destroyed until the read's event arrives, since it holds the tag.
+	virtual bool HasPendingRead() const { return false; }
 };
 
 template <class HandlerType>
@@ -253,7 +362,7 @@ public:
 			// First invocation for this request. Bind the delegate and run the user handler.
 			// The delegate writes immediately if no write is in flight; otherwise it enqueues
 			// for the next write-completion event to drain.
-			Base::ResponseDelegate = TResponseDelegate<ResponseType>::CreateSPLambda(static_cast<FRequestManager*>(this), [this](const ResponseType& Response, grpc::Status Result)
+			Base::ResponseDelegate = TResponseDelegate<ResponseType>::CreateSPLambda(static_cast<FRequestManager*>(this), [this](const ResponseType& Response, FTempoResponseStatus Result)
 			{
 				if (Base::State == FRequestManager::EState::HANDLING)
 				{
@@ -261,7 +370,7 @@ public:
 				}
 				else
 				{
-					ResponseQueue.Enqueue(TPair<ResponseType, grpc::Status>(Response, Result));
+					ResponseQueue.Enqueue(TPair<ResponseType, FTempoResponseStatus>(Response, Result));
 				}
 			});
 			Base::State = FRequestManager::EState::HANDLING;
@@ -271,7 +380,7 @@ public:
 
 		// A write just completed. If more responses are queued, write the next one.
 		// Otherwise ask the user handler for more.
-		TPair<ResponseType, grpc::Status> ResponseItem;
+		TPair<ResponseType, FTempoResponseStatus> ResponseItem;
 		if (ResponseQueue.Dequeue(ResponseItem))
 		{
 			Respond(ResponseItem.Key, ResponseItem.Value);
@@ -288,7 +397,7 @@ public:
 		return new TRequestManager(NewTag, Base::ServiceName, Base::Service, Base::Handler);
 	}
 
-	void Respond(const ResponseType& Response, grpc::Status Result)
+	void Respond(const ResponseType& Response, const FTempoResponseStatus& Result)
 	{
 		if (!Result.ok())
 		{
@@ -297,11 +406,143 @@ public:
 			Base::Responder.Finish(Result, &(Base::Tag));
 			return;
 		}
+		if (Result.bLastResponse)
+		{
+			// Write the last response and finish with OK, in one event.
+			Base::State = FRequestManager::EState::FINISHING;
+			Base::Responder.WriteAndFinish(Response, grpc::WriteOptions(), grpc::Status_OK, &(Base::Tag));
+			return;
+		}
+		Base::State = FRequestManager::EState::RESPONDING;
+		Base::Responder.Write(Response, &(Base::Tag));
+	}
+
+	TQueue<TPair<ResponseType, FTempoResponseStatus>> ResponseQueue;
+};
+
+template <class ServiceType, class RequestType, class ResponseType, class UserObjectType, bool Const>
+class TRequestManager<TBidiStreamingRequestHandler<ServiceType, RequestType, ResponseType, UserObjectType, Const>> :
+	public TRequestManagerBase<TBidiStreamingRequestHandler<ServiceType, RequestType, ResponseType, UserObjectType, Const>>
+{
+	using TRequestManagerBase<TBidiStreamingRequestHandler<ServiceType, RequestType, ResponseType, UserObjectType, Const>>::TRequestManagerBase;
+	using Base = TRequestManagerBase<TBidiStreamingRequestHandler<ServiceType, RequestType, ResponseType, UserObjectType, Const>>;
+
+public:
+	virtual bool HasUnflushedWork() const override
+	{
+		// As for server streaming. A pending read is not unflushed work: the client may not write again for a while.
+		return Base::State == FRequestManager::EState::RESPONDING
+			|| Base::State == FRequestManager::EState::FINISHING
+			|| !ResponseQueue.IsEmpty();
+	}
+
+	virtual bool HasPendingRead() const override
+	{
+		return bReadPending;
+	}
+
+	virtual void HandleAndRespond() override
+	{
+		check(Base::State == FRequestManager::EState::REQUESTED || Base::State == FRequestManager::EState::RESPONDING);
+
+		if (!Base::ResponseDelegate.IsBound())
+		{
+			// The call was just accepted. Bind the delegate and start reading requests. The user handler runs as each
+			// one arrives. As for server streaming, the delegate writes immediately if no write is in flight and
+			// otherwise enqueues for the next write-completion event to drain.
+			Base::ResponseDelegate = TResponseDelegate<ResponseType>::CreateSPLambda(static_cast<FRequestManager*>(this), [this](const ResponseType& Response, grpc::Status Result)
+			{
+				if (Base::State == FRequestManager::EState::HANDLING)
+				{
+					Respond(Response, Result);
+				}
+				else
+				{
+					ResponseQueue.Enqueue(TPair<ResponseType, grpc::Status>(Response, Result));
+				}
+			});
+			Base::State = FRequestManager::EState::HANDLING;
+			Read();
+			return;
+		}
+
+		// A write just completed. If more responses are queued, write the next one. Otherwise wait for the user to
+		// respond again, unless the client is done writing, in which case we're done too.
+		TPair<ResponseType, grpc::Status> ResponseItem;
+		if (ResponseQueue.Dequeue(ResponseItem))
+		{
+			Respond(ResponseItem.Key, ResponseItem.Value);
+		}
+		else if (bReadsDone)
+		{
+			Finish(grpc::Status_OK);
+		}
+		else
+		{
+			Base::State = FRequestManager::EState::HANDLING;
+		}
+	}
+
+	virtual void HandleReadEvent(bool bOk) override
+	{
+		bReadPending = false;
+		if (Base::State == FRequestManager::EState::FINISHING)
+		{
+			// The rpc was finished early, failing the read.
+			return;
+		}
+
+		if (!bOk)
+		{
+			// The client is done writing. Finish once every queued response has been written.
+			bReadsDone = true;
+			if (Base::State == FRequestManager::EState::HANDLING)
+			{
+				Finish(grpc::Status_OK);
+			}
+			return;
+		}
+
+		Base::Handler->HandleRequest(Base::Request, Base::ResponseDelegate);
+		if (Base::State != FRequestManager::EState::FINISHING)
+		{
+			Read();
+		}
+	}
+
+	virtual FRequestManager* Duplicate(int32 NewTag) const override
+	{
+		return new TRequestManager(NewTag, Base::ServiceName, Base::Service, Base::Handler);
+	}
+
+	void Respond(const ResponseType& Response, grpc::Status Result)
+	{
+		if (!Result.ok())
+		{
+			// Consider non-OK result to mean the stream should end, even though the client may still be writing.
+			Finish(Result);
+			return;
+		}
 		Base::State = FRequestManager::EState::RESPONDING;
 		Base::Responder.Write(Response, &(Base::Tag));
 	}
 
+	void Finish(grpc::Status Result)
+	{
+		Base::State = FRequestManager::EState::FINISHING;
+		Base::Responder.Finish(Result, &(Base::Tag));
+	}
+
+	void Read()
+	{
+		bReadPending = true;
+		Base::Responder.Read(&(Base::Request), &ReadTag);
+	}
+
 	TQueue<TPair<ResponseType, grpc::Status>> ResponseQueue;
+	int32 ReadTag = FRequestManager::ConvertReadTag(Base::Tag);
+	bool bReadPending = false;
+	bool bReadsDone = false;
 };
 
 /**
@@ -349,6 +590,10 @@ public:
 		DeactivateService(ServiceName);
 	}
 
+	// Broadcast each tick once the pending events have been handled. In game, that's just before the world's Actors
+	// tick, which makes it the place to apply whatever the requests handled this tick have accumulated.
+	FSimpleMulticastDelegate& OnEventsHandled() { return EventsHandledDelegate; }
+
 protected:
 	void Initialize();
 	void Deinitialize();
@@ -413,10 +658,16 @@ protected:
 
 	void HandleEventForTag(int32 Tag, bool bOk);
 
+	void ReleaseRequestManager(int32 Tag);
+
 	bool bIsInitialized = false;
 
 	int32 TagAllocator = 0;
 	TMap<int32, TSharedPtr<FRequestManager>> RequestManagers;
+	// Finished request managers that are waiting on a pending read before they can be released.
+	TSet<int32> ReleasedRequestManagers;
+
+	FSimpleMulticastDelegate EventsHandledDelegate;
 	TMap<FName, TUniquePtr<grpc::Service>> Services;
 
 	TUniquePtr<grpc::Server> Server;
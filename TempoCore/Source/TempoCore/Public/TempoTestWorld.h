@@ -0,0 +1,37 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+// A transient game world with its own world context for automation tests, destroyed with the fixture.
+struct FTempoTestWorld
+{
+	UWorld* World = nullptr;
+
+	FTempoTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, /*bInformEngineOfWorld=*/false);
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+	}
+
+	~FTempoTestWorld()
+	{
+		if (World)
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(/*bInformEngineOfWorld=*/false);
+		}
+	}
+
+	FTempoTestWorld(const FTempoTestWorld&) = delete;
+	FTempoTestWorld& operator=(const FTempoTestWorld&) = delete;
+};
+
+#endif // WITH_DEV_AUTOMATION_TESTS
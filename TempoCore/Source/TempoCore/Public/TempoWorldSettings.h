@@ -32,6 +32,9 @@ public:
 
 	virtual void SetPauserPlayerState(APlayerState* PlayerState) override;
 
+	// Jumps the world's sim time to SimTime (e.g. when restoring a snapshot), keeping fixed step time in step.
+	void SetSimTime(double SimTime);
+
 	float GetDefaultAutoExposureBias();
 
 protected:
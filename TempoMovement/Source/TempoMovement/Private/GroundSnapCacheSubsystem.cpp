@@ -0,0 +1,161 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "GroundSnapCacheSubsystem.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Engine/HitResult.h"
+#include "Engine/World.h"
+
+DECLARE_STATS_GROUP(TEXT("TempoGroundSnap"), STATGROUP_TempoGroundSnap, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Snaps"), STAT_TempoGroundSnapSnaps, STATGROUP_TempoGroundSnap);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Skipped Snaps"), STAT_TempoGroundSnapSkippedSnaps, STATGROUP_TempoGroundSnap);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Traces"), STAT_TempoGroundSnapTraces, STATGROUP_TempoGroundSnap);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cache Hits"), STAT_TempoGroundSnapCacheHits, STATGROUP_TempoGroundSnap);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cached Cells"), STAT_TempoGroundSnapCachedCells, STATGROUP_TempoGroundSnap);
+
+namespace
+{
+	// Surfaces steeper than this (about 84 degrees) aren't cached: evaluating their plane away from the hit would
+	// move the ground a long way.
+	constexpr double MinCachedNormalZ = 0.1;
+
+	// How far (in cm) the ground at a cell's far corner may be from the plane through the hit for the hit to be cached.
+	constexpr double MaxCachedPlaneError = 0.01;
+
+	int32 CellCoordinate(double Coordinate, float CellSize)
+	{
+		return FMath::FloorToInt32(Coordinate / CellSize);
+	}
+
+	int64 CellKey(int32 CellX, int32 CellY)
+	{
+		return (static_cast<int64>(CellX) << 32) | static_cast<uint32>(CellY);
+	}
+}
+
+void UGroundSnapCacheSubsystem::SetCellSize(float InCellSize)
+{
+	if (ensureMsgf(InCellSize > 0.0f, TEXT("Ground snap cache cell size must be positive")))
+	{
+		CellSize = InCellSize;
+		ClearCache();
+	}
+}
+
+void UGroundSnapCacheSubsystem::ClearCache()
+{
+	Cells.Reset();
+	UncachedCells.Reset();
+	SET_DWORD_STAT(STAT_TempoGroundSnapCachedCells, 0);
+}
+
+bool UGroundSnapCacheSubsystem::FindGround(const FVector2D& Location, double MinZ, double MaxZ, FVector& OutGround)
+{
+	const FGroundPlane* Plane = Cells.Find(CellKey(CellCoordinate(Location.X, CellSize), CellCoordinate(Location.Y, CellSize)));
+	if (!Plane)
+	{
+		return false;
+	}
+
+	const double Z = Plane->HeightAt(Location);
+	if (Z < MinZ || Z > MaxZ)
+	{
+		return false;
+	}
+
+	OutGround = FVector(Location, Z);
+	++Stats.NumCacheHits;
+	INC_DWORD_STAT(STAT_TempoGroundSnapCacheHits);
+	return true;
+}
+
+void UGroundSnapCacheSubsystem::AddGround(const FHitResult& Hit, const FCollisionQueryParams& Params)
+{
+	const UPrimitiveComponent* Component = Hit.GetComponent();
+	if (!Component || Component->Mobility != EComponentMobility::Static || Hit.ImpactNormal.Z < MinCachedNormalZ)
+	{
+		return;
+	}
+
+	const int32 CellX = CellCoordinate(Hit.Location.X, CellSize);
+	const int32 CellY = CellCoordinate(Hit.Location.Y, CellSize);
+	const int64 Key = CellKey(CellX, CellY);
+	if (UncachedCells.Contains(Key))
+	{
+		return;
+	}
+
+	// The hit's plane only stands for the cell if the component that was hit covers all of it...
+	const FVector2D CellMin = FVector2D(CellX, CellY) * CellSize;
+	const FVector2D CellMax = CellMin + FVector2D(CellSize, CellSize);
+	const FBox ComponentBox = Component->Bounds.GetBox();
+	if (ComponentBox.Min.X > CellMin.X || ComponentBox.Min.Y > CellMin.Y || ComponentBox.Max.X < CellMax.X || ComponentBox.Max.Y < CellMax.Y)
+	{
+		return;
+	}
+
+	// ...and is still on that plane at the cell's corner farthest from the hit.
+	const FGroundPlane Plane{ Hit.Location, Hit.ImpactNormal };
+	const FVector2D FarCorner(Hit.Location.X - CellMin.X < CellSize / 2.0 ? CellMax.X : CellMin.X,
+		Hit.Location.Y - CellMin.Y < CellSize / 2.0 ? CellMax.Y : CellMin.Y);
+	FHitResult CornerHit;
+	GetWorld()->LineTraceSingleByChannel(CornerHit, FVector(FarCorner, Hit.TraceStart.Z), FVector(FarCorner, Hit.TraceEnd.Z), ECC_WorldStatic, Params);
+	CountTrace();
+	if (!CornerHit.bBlockingHit || CornerHit.GetComponent() != Component || FMath::Abs(CornerHit.Location.Z - Plane.HeightAt(FarCorner)) > MaxCachedPlaneError)
+	{
+		UncachedCells.Add(Key);
+		return;
+	}
+
+	Cells.Add(Key, Plane);
+	SET_DWORD_STAT(STAT_TempoGroundSnapCachedCells, Cells.Num());
+}
+
+void UGroundSnapCacheSubsystem::InvalidateRegion(const FBox2D& Region)
+{
+	const int32 MinX = CellCoordinate(Region.Min.X, CellSize);
+	const int32 MaxX = CellCoordinate(Region.Max.X, CellSize);
+	const int32 MinY = CellCoordinate(Region.Min.Y, CellSize);
+	const int32 MaxY = CellCoordinate(Region.Max.Y, CellSize);
+	auto IsInRegion = [MinX, MaxX, MinY, MaxY](int64 Key)
+	{
+		const int32 CellX = static_cast<int32>(Key >> 32);
+		const int32 CellY = static_cast<int32>(static_cast<uint32>(Key));
+		return CellX >= MinX && CellX <= MaxX && CellY >= MinY && CellY <= MaxY;
+	};
+	for (auto CellIt = Cells.CreateIterator(); CellIt; ++CellIt)
+	{
+		if (IsInRegion(CellIt.Key()))
+		{
+			CellIt.RemoveCurrent();
+		}
+	}
+	for (auto CellIt = UncachedCells.CreateIterator(); CellIt; ++CellIt)
+	{
+		if (IsInRegion(*CellIt))
+		{
+			CellIt.RemoveCurrent();
+		}
+	}
+	SET_DWORD_STAT(STAT_TempoGroundSnapCachedCells, Cells.Num());
+}
+
+void UGroundSnapCacheSubsystem::CountSnap(bool bSkipped)
+{
+	if (bSkipped)
+	{
+		++Stats.NumSkippedSnaps;
+		INC_DWORD_STAT(STAT_TempoGroundSnapSkippedSnaps);
+	}
+	else
+	{
+		++Stats.NumSnaps;
+		INC_DWORD_STAT(STAT_TempoGroundSnapSnaps);
+	}
+}
+
+void UGroundSnapCacheSubsystem::CountTrace()
+{
+	++Stats.NumTraces;
+	INC_DWORD_STAT(STAT_TempoGroundSnapTraces);
+}
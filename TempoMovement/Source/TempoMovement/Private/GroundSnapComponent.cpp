@@ -2,6 +2,7 @@
 
 #include "GroundSnapComponent.h"
 
+#include "GroundSnapCacheSubsystem.h"
 #include "TempoMovement.h"
 
 #include "TempoConversion.h"
@@ -29,26 +30,61 @@ void UGroundSnapComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 	check(GetWorld());
 	check(GetOwner());
 
+	UGroundSnapCacheSubsystem* GroundCache = GetWorld()->GetSubsystem<UGroundSnapCacheSubsystem>();
+	const FVector OwnerLocation = GetOwner()->GetActorLocation();
+	const FRotator OwnerRotation = GetOwner()->GetActorRotation();
+
+	// Until the owner has moved or turned enough to change the ground below its corners, reuse what we found.
+	if (LastSnap.IsSet() && FVector2D::Distance(FVector2D(OwnerLocation), LastSnap->Location) < ResnapDistance &&
+		FMath::Abs(FRotator::NormalizeAxis(OwnerRotation.Yaw - LastSnap->Yaw)) < ResnapAngle)
+	{
+		if (GroundCache)
+		{
+			GroundCache->CountSnap(/*bSkipped=*/true);
+		}
+		SnapOwner(LastSnap->Normal, LastSnap->Height);
+		return;
+	}
+	LastSnap.Reset();
+
+	if (GroundCache)
+	{
+		GroundCache->CountSnap(/*bSkipped=*/false);
+	}
+
 	const FVector2D Extents = bOverrideOwnerExtents ? ExtentsOverride : FVector2D(UTempoCoreUtils::GetActorLocalBounds(GetOwner(), bIncludeHiddenComponentsInExtents).GetExtent());
 
-	TArray<FHitResult> GroundHits;
-	TArray<FVector2D> Offsets = { FVector2D(1, 1), FVector2D(1, -1), FVector2D(-1, -1), FVector2D(-1, 1) };
+	TArray<FVector, TInlineAllocator<4>> GroundHits;
+	const FVector2D Offsets[] = { FVector2D(1, 1), FVector2D(1, -1), FVector2D(-1, -1), FVector2D(-1, 1) };
 	for (const FVector2D& Offset : Offsets)
 	{
-		const FRotator OwnerRotation = GetOwner()->GetActorRotation();
 		const FVector RotatedScaledOffset = OwnerRotation.RotateVector(FVector(Offset * Extents, 0.0));
-		const FVector OwnerLocation = GetOwner()->GetActorLocation();
-		FHitResult GroundHit;
 		const FVector Start = OwnerLocation + SearchDistance * FVector::UpVector + RotatedScaledOffset;
 		const FVector End = OwnerLocation - SearchDistance * FVector::UpVector + RotatedScaledOffset;
+		FVector GroundHitLocation;
+		if (bUseGroundCache && GroundCache && GroundCache->FindGround(FVector2D(Start), End.Z, Start.Z, GroundHitLocation))
+		{
+			GroundHits.Add(GroundHitLocation);
+			continue;
+		}
+
+		FHitResult GroundHit;
 		FCollisionQueryParams Params(TEXT("GroundSnap"), false, GetOwner());
 		GetWorld()->LineTraceSingleByChannel(GroundHit, Start, End, ECC_WorldStatic, Params);
+		if (GroundCache)
+		{
+			GroundCache->CountTrace();
+		}
 		if (!GroundHit.bBlockingHit)
 		{
 			UE_LOG(LogTempoMovement, Warning, TEXT("Could not find ground below %s."), *GetName());
 			return;
 		}
-		GroundHits.Add(GroundHit);
+		if (bUseGroundCache && GroundCache)
+		{
+			GroundCache->AddGround(GroundHit, Params);
+		}
+		GroundHits.Add(GroundHit.Location);
 	}
 
 	ensure(GroundHits.Num() == 4);
@@ -60,9 +96,9 @@ void UGroundSnapComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 	{
 		int32 J = I == 3 ? 0 : I + 1; // (I + 1) % 4
 		int32 K = I == 0 ? 3 : I - 1; // (I - 1) % 4
-		const FVector& GroundHitI = GroundHits[I].Location;
-		const FVector& GroundHitJ = GroundHits[J].Location;
-		const FVector& GroundHitK = GroundHits[K].Location;
+		const FVector& GroundHitI = GroundHits[I];
+		const FVector& GroundHitJ = GroundHits[J];
+		const FVector& GroundHitK = GroundHits[K];
 		const FVector IJ = GroundHitJ - GroundHitI;
 		const FVector IK = GroundHitK - GroundHitI;
 		AllNormals.Add(FVector::CrossProduct(IK, IJ).GetSafeNormal());
@@ -86,7 +122,9 @@ void UGroundSnapComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 		Heights.Add(AllHeights[I]);
 	}
 
-	FRotator NewRotation = GetOwner()->GetActorRotation();
+	FGroundSnap& Snap = LastSnap.Emplace();
+	Snap.Location = FVector2D(OwnerLocation);
+
 	FVector NormalAvgNumerator = FVector::ZeroVector;
 	const float NormalAvgDenominator = Normals.Num();
 	for (const FVector& Normal : Normals)
@@ -95,11 +133,9 @@ void UGroundSnapComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 	}
 	if (NormalAvgDenominator > 0.0)
 	{
-		const FVector NewNormal = NormalAvgNumerator / NormalAvgDenominator;
-		NewRotation = RotationFromNormal(NewNormal, GetOwner()->GetActorRotation());
+		Snap.Normal = NormalAvgNumerator / NormalAvgDenominator;
 	}
 
-	FVector NewLocation = GetOwner()->GetActorLocation();
 	float HeightAvgNumerator = 0.0;
 	const float HeightAvgDenominator = Heights.Num();
 	for (const float Height : Heights)
@@ -108,8 +144,44 @@ void UGroundSnapComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 	}
 	if (HeightAvgDenominator > 0.0)
 	{
-		NewLocation.Z = HeightAvgNumerator / HeightAvgDenominator;
+		Snap.Height = HeightAvgNumerator / HeightAvgDenominator;
+	}
+
+	SnapOwner(Snap.Normal, Snap.Height);
+	Snap.Yaw = GetOwner()->GetActorRotation().Yaw;
+}
+
+void UGroundSnapComponent::SnapOwner(const TOptional<FVector>& Normal, const TOptional<double>& Height) const
+{
+	FRotator NewRotation = GetOwner()->GetActorRotation();
+	if (Normal.IsSet())
+	{
+		NewRotation = RotationFromNormal(Normal.GetValue(), GetOwner()->GetActorRotation());
+	}
+
+	FVector NewLocation = GetOwner()->GetActorLocation();
+	if (Height.IsSet())
+	{
+		NewLocation.Z = Height.GetValue();
+	}
+
+	// Most ticks of an owner standing still land exactly where it already is, and moving it isn't free.
+	const FTransform NewTransform(NewRotation, NewLocation, GetOwner()->GetActorScale());
+	if (!NewTransform.Equals(GetOwner()->GetActorTransform(), 0.0))
+	{
+		GetOwner()->SetActorTransform(NewTransform);
 	}
+}
 
-	GetOwner()->SetActorTransform(FTransform(NewRotation, NewLocation, GetOwner()->GetActorScale()));
+void UGroundSnapComponent::SetExtentsOverride(const FVector2D& InExtentsOverride)
+{
+	bOverrideOwnerExtents = true;
+	ExtentsOverride = InExtentsOverride;
+	LastSnap.Reset();
+}
+
+void UGroundSnapComponent::SetResnapThresholds(float InResnapDistance, float InResnapAngle)
+{
+	ResnapDistance = FMath::Max(InResnapDistance, 0.0f);
+	ResnapAngle = FMath::Max(InResnapAngle, 0.0f);
 }
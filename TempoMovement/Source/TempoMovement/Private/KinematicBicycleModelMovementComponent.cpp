@@ -6,12 +6,17 @@
 
 FTempoTwist UKinematicBicycleModelMovementComponent::SimulateMotion(float DeltaTime, float Steering, float NewLinearVelocity)
 {
-	const float HeadingAngleRad = QuantityConverter<Deg2Rad>::Convert(GetOwner()->GetActorRotation().Yaw);
+	return SimulateBicycleMotion(GetOwner()->GetActorRotation().Yaw, Steering, NewLinearVelocity, Wheelbase, AxleRatio);
+}
+
+FTempoTwist UKinematicBicycleModelMovementComponent::SimulateBicycleMotion(double HeadingYawDeg, float Steering, float NewLinearVelocity, float InWheelbase, float InAxleRatio)
+{
+	const float HeadingAngleRad = QuantityConverter<Deg2Rad>::Convert(HeadingYawDeg);
 	const float SteeringRad = QuantityConverter<Deg2Rad>::Convert(Steering);
-	const float RearAxleDistance = AxleRatio * Wheelbase;
-	const float Beta = FMath::Atan2(RearAxleDistance * FMath::Tan(SteeringRad), Wheelbase);
+	const float RearAxleDistance = InAxleRatio * InWheelbase;
+	const float Beta = FMath::Atan2(RearAxleDistance * FMath::Tan(SteeringRad), InWheelbase);
 	const FVector LinearVelocityVec = NewLinearVelocity * FVector(FMath::Cos(HeadingAngleRad + Beta), FMath::Sin(HeadingAngleRad + Beta), 0.0);
-	const float YawRateDegS = QuantityConverter<Rad2Deg>::Convert(NewLinearVelocity * FMath::Sin(SteeringRad) / Wheelbase);
+	const float YawRateDegS = QuantityConverter<Rad2Deg>::Convert(NewLinearVelocity * FMath::Sin(SteeringRad) / InWheelbase);
 	return FTempoTwist(LinearVelocityVec, FVector(0.0, 0.0, YawRateDegS));
 }
 
@@ -6,9 +6,14 @@
 
 FTempoTwist UKinematicUnicycleModelMovementComponent::SimulateMotion(float DeltaTime, float Steering, float NewLinearVelocity)
 {
-	const float HeadingAngleRad = QuantityConverter<Deg2Rad>::Convert(GetOwner()->GetActorRotation().Yaw);
+	return SimulateUnicycleMotion(GetOwner()->GetActorRotation().Yaw, Steering, NewLinearVelocity, SteeringToAngularVelocityFactor);
+}
+
+FTempoTwist UKinematicUnicycleModelMovementComponent::SimulateUnicycleMotion(double HeadingYawDeg, float Steering, float NewLinearVelocity, float AngularVelocityFactor)
+{
+	const float HeadingAngleRad = QuantityConverter<Deg2Rad>::Convert(HeadingYawDeg);
 	const FVector LinearVelocityVec = NewLinearVelocity * FVector(FMath::Cos(HeadingAngleRad), FMath::Sin(HeadingAngleRad), 0.0);
-	const float YawRateDegS = SteeringToAngularVelocityFactor * Steering;
+	const float YawRateDegS = AngularVelocityFactor * Steering;
 	return FTempoTwist(LinearVelocityVec, FVector(0.0, 0.0, YawRateDegS));
 }
 
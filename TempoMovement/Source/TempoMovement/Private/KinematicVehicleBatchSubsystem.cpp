@@ -0,0 +1,185 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "KinematicVehicleBatchSubsystem.h"
+
+#include "KinematicBicycleModelMovementComponent.h"
+#include "KinematicUnicycleModelMovementComponent.h"
+
+#include "Async/ParallelFor.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+namespace
+{
+	// Fewer vehicles than this are stepped on the game thread, where the cost of dispatching to workers would
+	// outweigh the math.
+	constexpr int32 MinVehiclesPerParallelStep = 64;
+}
+
+void FKinematicVehicleBatchTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem)
+	{
+		Subsystem->StepVehicles(DeltaTime);
+	}
+}
+
+FString FKinematicVehicleBatchTickFunction::DiagnosticMessage()
+{
+	return TEXT("UKinematicVehicleBatchSubsystem::StepVehicles");
+}
+
+bool UKinematicVehicleBatchSubsystem::RegisterVehicle(UKinematicVehicleMovementComponent* Vehicle)
+{
+	if (!Vehicle)
+	{
+		return false;
+	}
+
+	// Only the built-in models are batched. Blueprint subclasses can't override SimulateMotion (it isn't a UFUNCTION),
+	// so they are batched as their native class is. A native subclass might, so it keeps ticking itself.
+	const UClass* NativeClass = Vehicle->GetClass();
+	while (NativeClass && !NativeClass->HasAnyClassFlags(CLASS_Native))
+	{
+		NativeClass = NativeClass->GetSuperClass();
+	}
+	EKinematicVehicleModel Model;
+	if (NativeClass == UKinematicBicycleModelMovementComponent::StaticClass())
+	{
+		Model = EKinematicVehicleModel::Bicycle;
+	}
+	else if (NativeClass == UKinematicUnicycleModelMovementComponent::StaticClass())
+	{
+		Model = EKinematicVehicleModel::Unicycle;
+	}
+	else
+	{
+		return false;
+	}
+
+	if (!Vehicles.Contains(Vehicle))
+	{
+		Vehicles.Add(Vehicle);
+		Models.Add(Model);
+	}
+	return true;
+}
+
+bool UKinematicVehicleBatchSubsystem::UnregisterVehicle(UKinematicVehicleMovementComponent* Vehicle)
+{
+	const int32 VehicleIndex = Vehicles.IndexOfByKey(Vehicle);
+	if (VehicleIndex == INDEX_NONE)
+	{
+		return false;
+	}
+	Vehicles.RemoveAt(VehicleIndex);
+	Models.RemoveAt(VehicleIndex);
+	return true;
+}
+
+void UKinematicVehicleBatchSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	StepTickFunction.Subsystem = this;
+	StepTickFunction.bCanEverTick = true;
+	StepTickFunction.TickGroup = TG_PrePhysics;
+	StepTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UKinematicVehicleBatchSubsystem::Deinitialize()
+{
+	if (StepTickFunction.IsTickFunctionRegistered())
+	{
+		StepTickFunction.UnRegisterTickFunction();
+	}
+
+	Super::Deinitialize();
+}
+
+void UKinematicVehicleBatchSubsystem::StepVehicles(float DeltaTime)
+{
+	// Forget vehicles that were destroyed without unregistering.
+	for (int32 VehicleIndex = Vehicles.Num() - 1; VehicleIndex >= 0; --VehicleIndex)
+	{
+		if (!Vehicles[VehicleIndex].IsValid() || !Vehicles[VehicleIndex]->GetOwner())
+		{
+			Vehicles.RemoveAt(VehicleIndex);
+			Models.RemoveAt(VehicleIndex);
+		}
+	}
+
+	const int32 NumVehicles = Vehicles.Num();
+	if (NumVehicles == 0)
+	{
+		return;
+	}
+
+	// Gather, on the game thread: consuming input and reading the owner's pose touch the vehicles' Actors.
+	DeltaTimes.SetNumUninitialized(NumVehicles);
+	Headings.SetNumUninitialized(NumVehicles);
+	LinearVelocities.SetNumUninitialized(NumVehicles);
+	ControlInputs.SetNumUninitialized(NumVehicles);
+	Limits.SetNumUninitialized(NumVehicles);
+	ModelParameters.SetNumUninitialized(NumVehicles);
+	for (int32 VehicleIndex = 0; VehicleIndex < NumVehicles; ++VehicleIndex)
+	{
+		UKinematicVehicleMovementComponent* Vehicle = Vehicles[VehicleIndex].Get();
+		const AActor* Owner = Vehicle->GetOwner();
+		// Inactive vehicles wouldn't tick; a zero step leaves them where they are.
+		DeltaTimes[VehicleIndex] = Vehicle->IsActive() ? DeltaTime * Owner->CustomTimeDilation : 0.0f;
+		Headings[VehicleIndex] = Owner->GetActorRotation().Yaw;
+		LinearVelocities[VehicleIndex] = Vehicle->LinearVelocity;
+		ControlInputs[VehicleIndex] = Vehicle->IsActive() ? Vehicle->ConsumeControlInput() : FVector::ZeroVector;
+		Limits[VehicleIndex] = Vehicle->GetLimits();
+		switch (Models[VehicleIndex])
+		{
+		case EKinematicVehicleModel::Bicycle:
+		{
+			const UKinematicBicycleModelMovementComponent* Bicycle = static_cast<const UKinematicBicycleModelMovementComponent*>(Vehicle);
+			ModelParameters[VehicleIndex] = FVector2f(Bicycle->Wheelbase, Bicycle->AxleRatio);
+			break;
+		}
+		case EKinematicVehicleModel::Unicycle:
+		{
+			const UKinematicUnicycleModelMovementComponent* Unicycle = static_cast<const UKinematicUnicycleModelMovementComponent*>(Vehicle);
+			ModelParameters[VehicleIndex] = FVector2f(Unicycle->SteeringToAngularVelocityFactor, 0.0f);
+			break;
+		}
+		}
+	}
+
+	// Integrate, in parallel: only the packed arrays are read and written.
+	NewLinearVelocities.SetNumUninitialized(NumVehicles);
+	Motions.SetNumUninitialized(NumVehicles);
+	ParallelFor(NumVehicles, [this](int32 VehicleIndex)
+	{
+		const float VehicleDeltaTime = DeltaTimes[VehicleIndex];
+		float SteeringAngle = 0.0f;
+		UKinematicVehicleMovementComponent::StepSpeedAndSteering(VehicleDeltaTime, ControlInputs[VehicleIndex], LinearVelocities[VehicleIndex],
+			Limits[VehicleIndex], NewLinearVelocities[VehicleIndex], SteeringAngle);
+
+		const FVector2f& Parameters = ModelParameters[VehicleIndex];
+		switch (Models[VehicleIndex])
+		{
+		case EKinematicVehicleModel::Bicycle:
+			Motions[VehicleIndex] = UKinematicBicycleModelMovementComponent::SimulateBicycleMotion(Headings[VehicleIndex], SteeringAngle,
+				NewLinearVelocities[VehicleIndex], Parameters.X, Parameters.Y);
+			break;
+		case EKinematicVehicleModel::Unicycle:
+			Motions[VehicleIndex] = UKinematicUnicycleModelMovementComponent::SimulateUnicycleMotion(Headings[VehicleIndex], SteeringAngle,
+				NewLinearVelocities[VehicleIndex], Parameters.X);
+			break;
+		}
+	}, NumVehicles < MinVehiclesPerParallelStep ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	// Write back, on the game thread: moving Actors (and sweeping them) isn't thread-safe.
+	for (int32 VehicleIndex = 0; VehicleIndex < NumVehicles; ++VehicleIndex)
+	{
+		if (DeltaTimes[VehicleIndex] > 0.0f)
+		{
+			Vehicles[VehicleIndex]->ApplyMotion(DeltaTimes[VehicleIndex], NewLinearVelocities[VehicleIndex], Motions[VehicleIndex]);
+		}
+	}
+}
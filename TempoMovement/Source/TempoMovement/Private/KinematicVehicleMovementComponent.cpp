@@ -2,15 +2,98 @@
 
 #include "KinematicVehicleMovementComponent.h"
 
+#include "KinematicVehicleBatchSubsystem.h"
+
+#include "Engine/World.h"
+
 FVector UKinematicVehicleMovementComponent::GetActorFeetLocation() const
 {
 	return GetActorLocation();
 }
 
+void UKinematicVehicleMovementComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UpdateBatchRegistration();
+}
+
+void UKinematicVehicleMovementComponent::SetUseBatchIntegration(bool bInUseBatchIntegration)
+{
+	bUseBatchIntegration = bInUseBatchIntegration;
+	if (HasBegunPlay())
+	{
+		UpdateBatchRegistration();
+	}
+}
+
+#if WITH_EDITOR
+void UKinematicVehicleMovementComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UKinematicVehicleMovementComponent, bUseBatchIntegration) && HasBegunPlay())
+	{
+		UpdateBatchRegistration();
+	}
+}
+#endif
+
+void UKinematicVehicleMovementComponent::UpdateBatchRegistration()
+{
+	UKinematicVehicleBatchSubsystem* BatchSubsystem = GetWorld()->GetSubsystem<UKinematicVehicleBatchSubsystem>();
+	if (!BatchSubsystem)
+	{
+		return;
+	}
+
+	if (bUseBatchIntegration && BatchSubsystem->RegisterVehicle(this))
+	{
+		SetComponentTickEnabled(false);
+	}
+	else if (BatchSubsystem->UnregisterVehicle(this))
+	{
+		SetComponentTickEnabled(true);
+	}
+}
+
+void UKinematicVehicleMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UKinematicVehicleBatchSubsystem* BatchSubsystem = GetWorld()->GetSubsystem<UKinematicVehicleBatchSubsystem>())
+	{
+		BatchSubsystem->UnregisterVehicle(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void UKinematicVehicleMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	const FVector ControlInput = ConsumeControlInput();
+	float NewLinearVelocity = 0.0f;
+	float SteeringAngle = 0.0f;
+	StepSpeedAndSteering(DeltaTime, ControlInput, LinearVelocity, GetLimits(), NewLinearVelocity, SteeringAngle);
+
+	const FTempoTwist Motion = SimulateMotion(DeltaTime, SteeringAngle, NewLinearVelocity);
+	ApplyMotion(DeltaTime, NewLinearVelocity, Motion);
+}
+
+FKinematicVehicleLimits UKinematicVehicleMovementComponent::GetLimits() const
+{
+	FKinematicVehicleLimits Limits;
+	Limits.bReverseEnabled = bReverseEnabled;
+	Limits.MaxAcceleration = MaxAcceleration;
+	Limits.MaxDeceleration = MaxDeceleration;
+	Limits.MaxSpeed = MaxSpeed;
+	Limits.MaxSteering = MaxSteering;
+	Limits.NoInputNormalizedDeceleration = NoInputNormalizedDeceleration;
+	return Limits;
+}
+
+FVector UKinematicVehicleMovementComponent::ConsumeControlInput()
+{
 	const FVector Input = ConsumeInputVector();
 	FVector ControlInput;
 	if (const APlayerController* PlayerController = Cast<APlayerController>(GetController()))
@@ -21,37 +104,43 @@ void UKinematicVehicleMovementComponent::TickComponent(float DeltaTime, ELevelTi
 	{
 		ControlInput = GetOwner()->GetActorRotation().GetInverse().RotateVector(Input);
 	}
+	return ControlInput;
+}
 
+void UKinematicVehicleMovementComponent::StepSpeedAndSteering(float DeltaTime, const FVector& ControlInput, float CurrentLinearVelocity, const FKinematicVehicleLimits& Limits,
+	float& OutNewLinearVelocity, float& OutSteeringAngle)
+{
 	const float NormalizedAcceleration = FMath::IsNearlyZero(ControlInput.X) ?
-		-FMath::Sign(LinearVelocity) * NoInputNormalizedDeceleration :
+		-FMath::Sign(CurrentLinearVelocity) * Limits.NoInputNormalizedDeceleration :
 		ControlInput.X;
 	const float SteeringInput = ControlInput.Y;
 
 	// |speed| is increasing when acceleration and velocity have the same sign (or the vehicle
 	// is stopped). Otherwise we're decelerating.
-	const bool bSpeedIncreasing = FMath::IsNearlyZero(LinearVelocity) ||
-		FMath::Sign(NormalizedAcceleration) == FMath::Sign(LinearVelocity);
-	const float AccelLimit = bSpeedIncreasing ? MaxAcceleration : MaxDeceleration;
+	const bool bSpeedIncreasing = FMath::IsNearlyZero(CurrentLinearVelocity) ||
+		FMath::Sign(NormalizedAcceleration) == FMath::Sign(CurrentLinearVelocity);
+	const float AccelLimit = bSpeedIncreasing ? Limits.MaxAcceleration : Limits.MaxDeceleration;
 	const float Acceleration = FMath::Clamp(NormalizedAcceleration * AccelLimit, -AccelLimit, AccelLimit);
 
-	const float SteeringAngle = FMath::Clamp(SteeringInput * MaxSteering, -MaxSteering, MaxSteering);
+	OutSteeringAngle = FMath::Clamp(SteeringInput * Limits.MaxSteering, -Limits.MaxSteering, Limits.MaxSteering);
 
 	float DeltaVelocity = DeltaTime * Acceleration;
-	if (LinearVelocity > 0.0 && DeltaVelocity < 0.0)
+	if (CurrentLinearVelocity > 0.0 && DeltaVelocity < 0.0)
 	{
 		// If slowing down, don't start reversing.
-		DeltaVelocity = FMath::Max(-LinearVelocity, DeltaVelocity);
+		DeltaVelocity = FMath::Max(-CurrentLinearVelocity, DeltaVelocity);
 	}
-	float NewLinearVelocity = LinearVelocity + DeltaVelocity;
-	if (!bReverseEnabled)
+	float NewLinearVelocity = CurrentLinearVelocity + DeltaVelocity;
+	if (!Limits.bReverseEnabled)
 	{
 		NewLinearVelocity = FMath::Max(NewLinearVelocity, 0.0);
 	}
 
-	NewLinearVelocity = FMath::Clamp(NewLinearVelocity, -MaxSpeed, MaxSpeed);
-
-	const FTempoTwist Motion = SimulateMotion(DeltaTime, SteeringAngle, NewLinearVelocity);
+	OutNewLinearVelocity = FMath::Clamp(NewLinearVelocity, -Limits.MaxSpeed, Limits.MaxSpeed);
+}
 
+void UKinematicVehicleMovementComponent::ApplyMotion(float DeltaTime, float NewLinearVelocity, const FTempoTwist& Motion)
+{
 	FHitResult MoveHitResult;
 	GetOwner()->AddActorWorldOffset(DeltaTime * Motion.Linear, true, &MoveHitResult);
 	LinearVelocity = NewLinearVelocity;
@@ -0,0 +1,129 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "NavigationDirtyRegionTracker.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+
+namespace
+{
+	// Bounds that moved less than this (in cm) are not considered changed.
+	constexpr double BoundsTolerance = 1.0;
+}
+
+void FNavigationDirtyRegionTracker::Reset(const UWorld* World)
+{
+	ActorBounds.Reset();
+	for (TActorIterator<AActor> ActorIt(World); ActorIt; ++ActorIt)
+	{
+		const FBox Bounds = GetNavigationRelevantBounds(*ActorIt);
+		if (Bounds.IsValid)
+		{
+			ActorBounds.Add(*ActorIt, Bounds);
+		}
+	}
+}
+
+TArray<FBox> FNavigationDirtyRegionTracker::CollectDirtyRegions(const UWorld* World)
+{
+	TArray<FBox> DirtyRegions;
+	TMap<TWeakObjectPtr<const AActor>, FBox> CurrentBounds;
+	CurrentBounds.Reserve(ActorBounds.Num());
+
+	for (TActorIterator<AActor> ActorIt(World); ActorIt; ++ActorIt)
+	{
+		const AActor* Actor = *ActorIt;
+		if (!IsValid(Actor))
+		{
+			continue;
+		}
+		const FBox Bounds = GetNavigationRelevantBounds(Actor);
+		if (!Bounds.IsValid)
+		{
+			continue;
+		}
+		CurrentBounds.Add(Actor, Bounds);
+
+		const FBox* PreviousBounds = ActorBounds.Find(Actor);
+		if (!PreviousBounds)
+		{
+			DirtyRegions.Add(Bounds);
+		}
+		else if (!PreviousBounds->Equals(Bounds, BoundsTolerance))
+		{
+			DirtyRegions.Add(*PreviousBounds);
+			DirtyRegions.Add(Bounds);
+		}
+	}
+
+	for (const TPair<TWeakObjectPtr<const AActor>, FBox>& Previous : ActorBounds)
+	{
+		if (!CurrentBounds.Contains(Previous.Key))
+		{
+			DirtyRegions.Add(Previous.Value);
+		}
+	}
+
+	ActorBounds = MoveTemp(CurrentBounds);
+	return DirtyRegions;
+}
+
+void FNavigationDirtyRegionTracker::MarkRegionsRebuilt(const UWorld* World, const TArray<FBox>& RebuiltRegions)
+{
+	auto IsRebuilt = [&RebuiltRegions](const FBox& Bounds)
+	{
+		return RebuiltRegions.ContainsByPredicate([&Bounds](const FBox& Region) { return Region.IsInsideOrOn(Bounds); });
+	};
+
+	TSet<TWeakObjectPtr<const AActor>> CurrentActors;
+	for (TActorIterator<AActor> ActorIt(World); ActorIt; ++ActorIt)
+	{
+		const AActor* Actor = *ActorIt;
+		if (!IsValid(Actor))
+		{
+			continue;
+		}
+		const FBox Bounds = GetNavigationRelevantBounds(Actor);
+		if (!Bounds.IsValid)
+		{
+			continue;
+		}
+		CurrentActors.Add(Actor);
+
+		FBox* PreviousBounds = ActorBounds.Find(Actor);
+		if (!PreviousBounds)
+		{
+			if (IsRebuilt(Bounds))
+			{
+				ActorBounds.Add(Actor, Bounds);
+			}
+		}
+		else if (!PreviousBounds->Equals(Bounds, BoundsTolerance) && IsRebuilt(*PreviousBounds) && IsRebuilt(Bounds))
+		{
+			*PreviousBounds = Bounds;
+		}
+	}
+
+	for (auto ActorIt = ActorBounds.CreateIterator(); ActorIt; ++ActorIt)
+	{
+		if (!CurrentActors.Contains(ActorIt.Key()) && IsRebuilt(ActorIt.Value()))
+		{
+			ActorIt.RemoveCurrent();
+		}
+	}
+}
+
+FBox FNavigationDirtyRegionTracker::GetNavigationRelevantBounds(const AActor* Actor)
+{
+	FBox Bounds(ForceInit);
+	Actor->ForEachComponent<UPrimitiveComponent>(/*bIncludeFromChildActors=*/false, [&Bounds](const UPrimitiveComponent* Component)
+	{
+		if (Component->IsRegistered() && Component->CanEverAffectNavigation() && Component->IsNavigationRelevant())
+		{
+			Bounds += Component->Bounds.GetBox();
+		}
+	});
+	return Bounds;
+}
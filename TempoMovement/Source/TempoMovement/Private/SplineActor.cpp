@@ -11,3 +11,56 @@ ASplineActor::ASplineActor()
 	Spline = CreateDefaultSubobject<USplineComponent>(TEXT("Spline"));
 	RootComponent = Spline;
 }
+
+ESplineGeometryUpdate ASplineActor::SetSplinePoints(TConstArrayView<FVector> Locations, TConstArrayView<FVector> Tangents)
+{
+	check(Locations.Num() == Tangents.Num());
+
+	const int32 NumPoints = Locations.Num();
+	if (NumPoints != Spline->GetNumberOfSplinePoints())
+	{
+		// Set every tangent after adding every point, and update the spline once at the end.
+		Spline->ClearSplinePoints(false);
+		for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+		{
+			Spline->AddSplinePoint(Locations[PointIndex], ESplineCoordinateSpace::World, false);
+		}
+		for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+		{
+			Spline->SetTangentAtSplinePoint(PointIndex, Tangents[PointIndex], ESplineCoordinateSpace::World, false);
+		}
+		Spline->UpdateSpline();
+		return ESplineGeometryUpdate::Rebuilt;
+	}
+
+	bool bChanged = false;
+	for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+	{
+		// Points come back through the actor's transform, so compare them with a little slack.
+		if (!Spline->GetLocationAtSplinePoint(PointIndex, ESplineCoordinateSpace::World).Equals(Locations[PointIndex], UE_KINDA_SMALL_NUMBER))
+		{
+			Spline->SetLocationAtSplinePoint(PointIndex, Locations[PointIndex], ESplineCoordinateSpace::World, false);
+			bChanged = true;
+		}
+		// Points with automatic tangents would have them recomputed by UpdateSpline, so give them the requested ones.
+		if (Spline->GetSplinePointType(PointIndex) != ESplinePointType::CurveCustomTangent
+			|| !Spline->GetArriveTangentAtSplinePoint(PointIndex, ESplineCoordinateSpace::World).Equals(Tangents[PointIndex], UE_KINDA_SMALL_NUMBER)
+			|| !Spline->GetLeaveTangentAtSplinePoint(PointIndex, ESplineCoordinateSpace::World).Equals(Tangents[PointIndex], UE_KINDA_SMALL_NUMBER))
+		{
+			Spline->SetTangentAtSplinePoint(PointIndex, Tangents[PointIndex], ESplineCoordinateSpace::World, false);
+			bChanged = true;
+		}
+	}
+	if (!bChanged)
+	{
+		return ESplineGeometryUpdate::Unchanged;
+	}
+
+	Spline->UpdateSpline();
+	return ESplineGeometryUpdate::UpdatedInPlace;
+}
+
+uint32 ASplineActor::GetGeometryVersion() const
+{
+	return Spline->SplineCurves.Version;
+}
@@ -2,6 +2,8 @@
 
 #include "TempoCrowdAIController.h"
 
+#include "TempoCrowdGridSubsystem.h"
+
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "Navigation/CrowdFollowingComponent.h"
@@ -37,4 +39,20 @@ void ATempoCrowdAIController::OnPossess(APawn* InPawn)
 
 		RunBehaviorTree(BehaviorTreeAsset);
 	}
+
+	// Possessed pawns are crowd agents, for others to find as neighbors.
+	if (UTempoCrowdGridSubsystem* CrowdGrid = GetWorld()->GetSubsystem<UTempoCrowdGridSubsystem>())
+	{
+		CrowdGrid->RegisterAgent(InPawn);
+	}
+}
+
+void ATempoCrowdAIController::OnUnPossess()
+{
+	if (UTempoCrowdGridSubsystem* CrowdGrid = GetWorld()->GetSubsystem<UTempoCrowdGridSubsystem>())
+	{
+		CrowdGrid->UnregisterAgent(GetPawn());
+	}
+
+	Super::OnUnPossess();
 }
@@ -0,0 +1,217 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoCrowdGridSubsystem.h"
+
+#include "Algo/Sort.h"
+#include "Async/ParallelFor.h"
+#include "GameFramework/Actor.h"
+
+DECLARE_STATS_GROUP(TEXT("TempoCrowd"), STATGROUP_TempoCrowd, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Agents"), STAT_TempoCrowdAgents, STATGROUP_TempoCrowd);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Occupied Cells"), STAT_TempoCrowdOccupiedCells, STATGROUP_TempoCrowd);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Max Agents Per Cell"), STAT_TempoCrowdMaxAgentsPerCell, STATGROUP_TempoCrowd);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Neighbor Queries"), STAT_TempoCrowdNeighborQueries, STATGROUP_TempoCrowd);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Neighbor Candidates Tested"), STAT_TempoCrowdCandidatesTested, STATGROUP_TempoCrowd);
+
+namespace
+{
+	// Fewer agents than this have their cells computed on the game thread.
+	constexpr int32 MinAgentsPerParallelBuild = 256;
+
+	int32 CellCoordinate(double Coordinate, float CellSize)
+	{
+		return FMath::FloorToInt32(Coordinate / CellSize);
+	}
+
+	int64 CellKey(int32 CellX, int32 CellY)
+	{
+		return (static_cast<int64>(CellX) << 32) | static_cast<uint32>(CellY);
+	}
+}
+
+void UTempoCrowdGridSubsystem::RegisterAgent(AActor* Agent)
+{
+	if (Agent && NumRegistrations.FindOrAdd(TWeakObjectPtr<AActor>(Agent))++ == 0)
+	{
+		Agents.Add(Agent);
+	}
+}
+
+void UTempoCrowdGridSubsystem::UnregisterAgent(AActor* Agent)
+{
+	int32* AgentRegistrations = NumRegistrations.Find(TWeakObjectPtr<AActor>(Agent));
+	if (AgentRegistrations && --(*AgentRegistrations) == 0)
+	{
+		NumRegistrations.Remove(TWeakObjectPtr<AActor>(Agent));
+		Agents.RemoveSingleSwap(Agent);
+	}
+}
+
+void UTempoCrowdGridSubsystem::SetCellSize(float InCellSize)
+{
+	if (ensureMsgf(InCellSize > 0.0f, TEXT("Crowd grid cell size must be positive")))
+	{
+		CellSize = InCellSize;
+	}
+}
+
+void UTempoCrowdGridSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Agents have moved since the last build, but nothing may need their neighbors this frame.
+	bGridStale = true;
+}
+
+TStatId UTempoCrowdGridSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTempoCrowdGridSubsystem, STATGROUP_Tickables);
+}
+
+void UTempoCrowdGridSubsystem::BuildGrid()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TempoCrowdBuildGrid);
+
+	// Forget agents that were destroyed without unregistering.
+	Agents.RemoveAllSwap([this](const TWeakObjectPtr<AActor>& Agent)
+	{
+		if (Agent.IsValid())
+		{
+			return false;
+		}
+		NumRegistrations.Remove(Agent);
+		return true;
+	});
+	bGridStale = false;
+
+	const int32 NumAgents = Agents.Num();
+	GridAgents = Agents;
+	GridCellSize = CellSize;
+	Locations.SetNumUninitialized(NumAgents);
+	for (int32 AgentIndex = 0; AgentIndex < NumAgents; ++AgentIndex)
+	{
+		Locations[AgentIndex] = Agents[AgentIndex]->GetActorLocation();
+	}
+
+	CellKeys.SetNumUninitialized(NumAgents);
+	ParallelFor(NumAgents, [this](int32 AgentIndex)
+	{
+		const FVector& Location = Locations[AgentIndex];
+		CellKeys[AgentIndex] = CellKey(CellCoordinate(Location.X, GridCellSize), CellCoordinate(Location.Y, GridCellSize));
+	}, NumAgents < MinAgentsPerParallelBuild ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	SortedAgents.SetNumUninitialized(NumAgents);
+	for (int32 AgentIndex = 0; AgentIndex < NumAgents; ++AgentIndex)
+	{
+		SortedAgents[AgentIndex] = AgentIndex;
+	}
+	Algo::SortBy(SortedAgents, [this](int32 AgentIndex) { return CellKeys[AgentIndex]; });
+
+	Cells.Reset();
+	Stats = FTempoCrowdGridStats();
+	Stats.NumAgents = NumAgents;
+	for (int32 Start = 0; Start < NumAgents;)
+	{
+		const int64 Key = CellKeys[SortedAgents[Start]];
+		int32 End = Start + 1;
+		while (End < NumAgents && CellKeys[SortedAgents[End]] == Key)
+		{
+			++End;
+		}
+		Cells.Add(Key, TPair<int32, int32>(Start, End - Start));
+		Stats.MaxAgentsPerCell = FMath::Max(Stats.MaxAgentsPerCell, End - Start);
+		Start = End;
+	}
+	Stats.NumOccupiedCells = Cells.Num();
+
+	SET_DWORD_STAT(STAT_TempoCrowdAgents, Stats.NumAgents);
+	SET_DWORD_STAT(STAT_TempoCrowdOccupiedCells, Stats.NumOccupiedCells);
+	SET_DWORD_STAT(STAT_TempoCrowdMaxAgentsPerCell, Stats.MaxAgentsPerCell);
+}
+
+int32 UTempoCrowdGridSubsystem::FindNeighbors(const FVector& Location, float Radius, int32 MaxNeighbors, TArray<FTempoCrowdNeighbor>& OutNeighbors, const AActor* IgnoredAgent)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TempoCrowdFindNeighbors);
+
+	if (bGridStale)
+	{
+		BuildGrid();
+	}
+
+	OutNeighbors.Reset();
+	if (MaxNeighbors <= 0 || Radius < 0.0f || Cells.IsEmpty())
+	{
+		return 0;
+	}
+
+	++Stats.NumQueries;
+	INC_DWORD_STAT(STAT_TempoCrowdNeighborQueries);
+
+	// The nearest agents so far, as a heap with the farthest on top, so it is the one to replace.
+	const auto FarthestFirst = [](const FTempoCrowdNeighbor& A, const FTempoCrowdNeighbor& B) { return A.DistanceSquared > B.DistanceSquared; };
+	const double RadiusSquared = FMath::Square(static_cast<double>(Radius));
+	int32 NumCandidatesTested = 0;
+	const auto TestCell = [&](const TPair<int32, int32>& Cell)
+	{
+		for (int32 SortedIndex = Cell.Key; SortedIndex < Cell.Key + Cell.Value; ++SortedIndex)
+		{
+			const int32 AgentIndex = SortedAgents[SortedIndex];
+			if (IgnoredAgent && GridAgents[AgentIndex] == IgnoredAgent)
+			{
+				continue;
+			}
+			++NumCandidatesTested;
+			const double DistanceSquared = FVector::DistSquared(Location, Locations[AgentIndex]);
+			if (DistanceSquared > RadiusSquared)
+			{
+				continue;
+			}
+			if (OutNeighbors.Num() == MaxNeighbors)
+			{
+				if (DistanceSquared >= OutNeighbors.HeapTop().DistanceSquared)
+				{
+					continue;
+				}
+				OutNeighbors.HeapPopDiscard(FarthestFirst, EAllowShrinking::No);
+			}
+			OutNeighbors.HeapPush(FTempoCrowdNeighbor{ GridAgents[AgentIndex], Locations[AgentIndex], DistanceSquared }, FarthestFirst);
+		}
+	};
+
+	const int32 MinX = CellCoordinate(Location.X - Radius, GridCellSize);
+	const int32 MaxX = CellCoordinate(Location.X + Radius, GridCellSize);
+	const int32 MinY = CellCoordinate(Location.Y - Radius, GridCellSize);
+	const int32 MaxY = CellCoordinate(Location.Y + Radius, GridCellSize);
+	if (static_cast<int64>(MaxX - MinX + 1) * (MaxY - MinY + 1) <= Cells.Num())
+	{
+		for (int32 CellX = MinX; CellX <= MaxX; ++CellX)
+		{
+			for (int32 CellY = MinY; CellY <= MaxY; ++CellY)
+			{
+				if (const TPair<int32, int32>* Cell = Cells.Find(CellKey(CellX, CellY)))
+				{
+					TestCell(*Cell);
+				}
+			}
+		}
+	}
+	else
+	{
+		// The radius spans more cells than are occupied, so visit the occupied ones instead.
+		for (const TPair<int64, TPair<int32, int32>>& Cell : Cells)
+		{
+			const int32 CellX = static_cast<int32>(Cell.Key >> 32);
+			const int32 CellY = static_cast<int32>(static_cast<uint32>(Cell.Key));
+			if (CellX >= MinX && CellX <= MaxX && CellY >= MinY && CellY <= MaxY)
+			{
+				TestCell(Cell.Value);
+			}
+		}
+	}
+
+	Stats.NumCandidatesTested += NumCandidatesTested;
+	INC_DWORD_STAT_BY(STAT_TempoCrowdCandidatesTested, NumCandidatesTested);
+
+	OutNeighbors.Sort([](const FTempoCrowdNeighbor& A, const FTempoCrowdNeighbor& B) { return A.DistanceSquared < B.DistanceSquared; });
+	return OutNeighbors.Num();
+}
@@ -10,10 +10,21 @@ void UTempoCrowdObstacleAvoidanceComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+	if (const AActor* Owner = GetOwner())
+	{
+		Capsule = Owner->FindComponentByClass<UCapsuleComponent>();
+		Movement = Owner->FindComponentByClass<UPawnMovementComponent>();
+	}
+
 	if (UCrowdManager* CrowdManager = UCrowdManager::GetCurrent(GetWorld()))
 	{
 		CrowdManager->RegisterAgent(this);
 	}
+
+	if (UTempoCrowdGridSubsystem* CrowdGrid = GetWorld()->GetSubsystem<UTempoCrowdGridSubsystem>())
+	{
+		CrowdGrid->RegisterAgent(GetOwner());
+	}
 }
 
 void UTempoCrowdObstacleAvoidanceComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -24,6 +35,23 @@ void UTempoCrowdObstacleAvoidanceComponent::EndPlay(const EEndPlayReason::Type E
 	{
 		CrowdManager->UnregisterAgent(this);
 	}
+
+	if (UTempoCrowdGridSubsystem* CrowdGrid = GetWorld()->GetSubsystem<UTempoCrowdGridSubsystem>())
+	{
+		CrowdGrid->UnregisterAgent(GetOwner());
+	}
+}
+
+int32 UTempoCrowdObstacleAvoidanceComponent::GetNeighbors(TArray<FTempoCrowdNeighbor>& OutNeighbors) const
+{
+	UTempoCrowdGridSubsystem* CrowdGrid = GetWorld()->GetSubsystem<UTempoCrowdGridSubsystem>();
+	const AActor* Owner = GetOwner();
+	if (!CrowdGrid || !Owner)
+	{
+		OutNeighbors.Reset();
+		return 0;
+	}
+	return CrowdGrid->FindNeighbors(Owner->GetActorLocation(), NeighborRadius, MaxNeighbors, OutNeighbors, Owner);
 }
 
 void UTempoCrowdObstacleAvoidanceComponent::GetCrowdAgentCollisions(float& CylinderRadius, float& CylinderHalfHeight) const
@@ -35,7 +63,7 @@ void UTempoCrowdObstacleAvoidanceComponent::GetCrowdAgentCollisions(float& Cylin
 		CylinderHalfHeight = 100.0f;
 		return;
 	}
-	if (const UCapsuleComponent* CapsuleComp = Owner->FindComponentByClass<UCapsuleComponent>())
+	if (const UCapsuleComponent* CapsuleComp = Capsule.Get())
 	{
 		CylinderRadius = CapsuleComp->GetScaledCapsuleRadius();
 		CylinderHalfHeight = CapsuleComp->GetScaledCapsuleHalfHeight();
@@ -67,12 +95,9 @@ FVector UTempoCrowdObstacleAvoidanceComponent::GetCrowdAgentVelocity() const
 
 float UTempoCrowdObstacleAvoidanceComponent::GetCrowdAgentMaxSpeed() const
 {
-	if (const AActor* Owner = GetOwner())
+	if (const UPawnMovementComponent* MovementComp = Movement.Get())
 	{
-		if (const UPawnMovementComponent* Movement = Owner->FindComponentByClass<UPawnMovementComponent>())
-		{
-			return Movement->GetMaxSpeed();
-		}
+		return MovementComp->GetMaxSpeed();
 	}
 	return 0.0f;
 }
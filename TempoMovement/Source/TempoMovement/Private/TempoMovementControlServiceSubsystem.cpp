@@ -14,11 +14,12 @@
 #include "TempoCore/Empty.pb.h"
 #include "TempoCore/Geometry.pb.h"
 
+#include "AI/NavDataGenerator.h"
 #include "AIController.h"
-#include "Components/SplineComponent.h"
 #include "Curves/CurveFloat.h"
 #include "GameFramework/Pawn.h"
 #include "Kismet/GameplayStatics.h"
+#include "NavigationData.h"
 #include "NavigationSystem.h"
 
 using MovementControlService = TempoMovement::MovementControlService;
@@ -26,11 +27,20 @@ using MovementControlAsyncService = TempoMovement::MovementControlService::Async
 using NormalizedDrivingCommand = TempoMovement::NormalizedDrivingCommand;
 using VelocityCommand = TempoMovement::VelocityCommand;
 using AccelerationCommand = TempoMovement::AccelerationCommand;
+using PawnCommand = TempoMovement::PawnCommand;
+using CommandFrame = TempoMovement::CommandFrame;
+using CommandAck = TempoMovement::CommandAck;
 using CommandablePawnsResponse = TempoMovement::CommandablePawnsResponse;
 using PawnMoveToLocationRequest = TempoMovement::PawnMoveToLocationRequest;
 using PawnMoveToLocationResponse = TempoMovement::PawnMoveToLocationResponse;
 using NavigablePawnsResponse = TempoMovement::NavigablePawnsResponse;
+using PawnsMoveToLocationsRequest = TempoMovement::PawnsMoveToLocationsRequest;
+using PawnMoveCompletion = TempoMovement::PawnMoveCompletion;
+using RebuildNavigationRequest = TempoMovement::RebuildNavigationRequest;
+using RebuildNavigationResponse = TempoMovement::RebuildNavigationResponse;
 using SetSplinePointsRequest = TempoMovement::SetSplinePointsRequest;
+using SetSplinePointsBatchRequest = TempoMovement::SetSplinePointsBatchRequest;
+using SetSplinePointsBatchResponse = TempoMovement::SetSplinePointsBatchResponse;
 using ConfigureTrajectoryFollowingRequest = TempoMovement::ConfigureTrajectoryFollowingRequest;
 using TempoEmpty = TempoCore::Empty;
 
@@ -58,11 +68,8 @@ namespace
 			QuantityConverter<Rad2Deg>::Convert(AngularSI));
 	}
 
-	ATempoMovementController* FindMovementController(const UWorld* World, const FString& RequestedName, grpc::Status& OutStatus)
+	ATempoMovementController* FindMovementController(const TArray<AActor*>& MovementControllers, const FString& RequestedName, grpc::Status& OutStatus)
 	{
-		TArray<AActor*> MovementControllers;
-		UGameplayStatics::GetAllActorsOfClass(World, ATempoMovementController::StaticClass(), MovementControllers);
-
 		if (RequestedName.IsEmpty())
 		{
 			if (MovementControllers.IsEmpty())
@@ -91,6 +98,47 @@ namespace
 		return nullptr;
 	}
 
+	ATempoMovementController* FindMovementController(const UWorld* World, const FString& RequestedName, grpc::Status& OutStatus)
+	{
+		TArray<AActor*> MovementControllers;
+		UGameplayStatics::GetAllActorsOfClass(World, ATempoMovementController::StaticClass(), MovementControllers);
+		return FindMovementController(MovementControllers, RequestedName, OutStatus);
+	}
+
+	bool ApplyStreamedCommand(ATempoMovementController* Controller, const FStreamedCommand& Command, grpc::Status& OutStatus)
+	{
+		if (const FNormalizedDrivingInput* DrivingInput = Command.TryGet<FNormalizedDrivingInput>())
+		{
+			if (!Controller->HandleDrivingInput(*DrivingInput))
+			{
+				OutStatus = grpc::Status(grpc::StatusCode::UNIMPLEMENTED, "Movement controller does not support driving input");
+				return false;
+			}
+		}
+		else if (const FTempoTwist* Twist = Command.TryGet<FTempoTwist>())
+		{
+			if (!Controller->HandleVelocityCommand(*Twist))
+			{
+				OutStatus = grpc::Status(grpc::StatusCode::UNIMPLEMENTED, "Movement controller does not support velocity commands");
+				return false;
+			}
+		}
+		else if (!Controller->HandleAccelerationCommand(Command.Get<FTempoAccel>()))
+		{
+			OutStatus = grpc::Status(grpc::StatusCode::UNIMPLEMENTED, "Movement controller does not support acceleration commands");
+			return false;
+		}
+		return true;
+	}
+
+	void AddCommandError(CommandAck& Ack, uint64 FrameSequence, const FString& Pawn, const FString& Error)
+	{
+		TempoMovement::CommandError* CommandError = Ack.add_errors();
+		CommandError->set_frame_sequence(FrameSequence);
+		CommandError->set_pawn(TCHAR_TO_UTF8(*Pawn));
+		CommandError->set_error(TCHAR_TO_UTF8(*Error));
+	}
+
 	ASplineActor* FindSplineActor(const UWorld* World, const FString& RequestedName)
 	{
 		TArray<AActor*> SplineActors;
@@ -105,6 +153,24 @@ namespace
 		return nullptr;
 	}
 
+	// Locations and tangents arrive in SI/right-handed and are converted to Unreal-native cm/left-handed. Tangents are
+	// direction vectors, so the same QuantityConverter (which negates Y) applies.
+	void UnpackSplineVectors(const google::protobuf::RepeatedField<double>& Packed, TArray<FVector>& OutVectors)
+	{
+		OutVectors.Reset(Packed.size() / 3);
+		for (int32 Index = 0; Index + 2 < Packed.size(); Index += 3)
+		{
+			OutVectors.Add(QuantityConverter<M2CM, R2L>::Convert(FVector(Packed[Index], Packed[Index + 1], Packed[Index + 2])));
+		}
+	}
+
+	void AddSplineGeometryError(SetSplinePointsBatchResponse& Response, const FString& Spline, const FString& Error)
+	{
+		TempoMovement::SplineGeometryError* GeometryError = Response.add_errors();
+		GeometryError->set_spline(TCHAR_TO_UTF8(*Spline));
+		GeometryError->set_error(TCHAR_TO_UTF8(*Error));
+	}
+
 	APawn* FindPawn(const UWorld* World, const FString& RequestedName)
 	{
 		TArray<AActor*> Pawns;
@@ -133,6 +199,63 @@ namespace
 		}
 		return Curve;
 	}
+
+	// Lifted from AAIController::MoveToLocation, because that buries the FAIRequestID but we need it.
+	FAIMoveRequest MakeMoveRequest(const AAIController* AIController, const FVector& Destination)
+	{
+		FAIMoveRequest MoveRequest(Destination);
+		MoveRequest.SetUsePathfinding(true);
+		MoveRequest.SetAllowPartialPath(true);
+		MoveRequest.SetProjectGoalLocation(false);
+		MoveRequest.SetNavigationFilter(AIController->GetDefaultNavigationFilterClass());
+		MoveRequest.SetAcceptanceRadius(-1);
+		MoveRequest.SetReachTestIncludesAgentRadius(false);
+		MoveRequest.SetCanStrafe(true);
+		return MoveRequest;
+	}
+
+	TempoMovement::MoveToResult ToMoveToResult(EPathFollowingResult::Type Result)
+	{
+		switch (Result)
+		{
+			case EPathFollowingResult::Type::Success:
+			{
+				return TempoMovement::MTR_SUCCESS;
+			}
+			case EPathFollowingResult::Type::Blocked:
+			{
+				return TempoMovement::MTR_BLOCKED;
+			}
+			case EPathFollowingResult::Type::OffPath:
+			{
+				return TempoMovement::MTR_OFF_PATH;
+			}
+			case EPathFollowingResult::Type::Aborted:
+			{
+				return TempoMovement::MTR_ABORTED;
+			}
+			case EPathFollowingResult::Type::Invalid:
+			{
+				return TempoMovement::MTR_INVALID;
+			}
+			default:
+			{
+				return TempoMovement::MTR_UNKNOWN;
+			}
+		}
+	}
+
+	void SendPawnMoveCompletion(FPawnMoveBatch& Batch, const FBatchedPawnMove& Move, TempoMovement::MoveToResult Result, const FString& Error = FString())
+	{
+		PawnMoveCompletion Completion;
+		Completion.set_move_index(Move.MoveIndex);
+		Completion.set_pawn(TCHAR_TO_UTF8(*Move.Pawn));
+		Completion.set_result(Result);
+		Completion.set_error(TCHAR_TO_UTF8(*Error));
+		// The last completion finishes the stream.
+		--Batch.NumUnfinishedMoves;
+		Batch.ResponseContinuation.ExecuteIfBound(Completion, FTempoResponseStatus(grpc::Status_OK, /*bLastResponse=*/Batch.NumUnfinishedMoves == 0));
+	}
 }
 
 void UTempoMovementControlServiceSubsystem::RegisterServices(FTempoServer& Server)
@@ -142,10 +265,14 @@ void UTempoMovementControlServiceSubsystem::RegisterServices(FTempoServer& Serve
 		SimpleRequestHandler(&MovementControlAsyncService::RequestCommandVehicle, &UTempoMovementControlServiceSubsystem::CommandVehicle),
 		SimpleRequestHandler(&MovementControlAsyncService::RequestCommandVelocity, &UTempoMovementControlServiceSubsystem::CommandVelocity),
 		SimpleRequestHandler(&MovementControlAsyncService::RequestCommandAcceleration, &UTempoMovementControlServiceSubsystem::CommandAcceleration),
+		BidiStreamingRequestHandler(&MovementControlAsyncService::RequestStreamCommands, &UTempoMovementControlServiceSubsystem::StreamCommands),
 		SimpleRequestHandler(&MovementControlAsyncService::RequestGetNavigablePawns, &UTempoMovementControlServiceSubsystem::GetNavigablePawns),
 		SimpleRequestHandler(&MovementControlAsyncService::RequestPawnMoveToLocation, &UTempoMovementControlServiceSubsystem::PawnMoveToLocation),
+		StreamingRequestHandler(&MovementControlAsyncService::RequestPawnsMoveToLocations, &UTempoMovementControlServiceSubsystem::PawnsMoveToLocations),
 		SimpleRequestHandler(&MovementControlAsyncService::RequestRebuildNavigation, &UTempoMovementControlServiceSubsystem::RebuildNavigation),
 		SimpleRequestHandler(&MovementControlAsyncService::RequestSetSplinePoints, &UTempoMovementControlServiceSubsystem::SetSplinePoints),
+		SimpleRequestHandler(&MovementControlAsyncService::RequestSetSplinePointsBatch, &UTempoMovementControlServiceSubsystem::SetSplinePointsBatch),
+		BidiStreamingRequestHandler(&MovementControlAsyncService::RequestStreamSplinePoints, &UTempoMovementControlServiceSubsystem::SetSplinePointsBatch),
 		SimpleRequestHandler(&MovementControlAsyncService::RequestConfigureTrajectoryFollowing, &UTempoMovementControlServiceSubsystem::ConfigureTrajectoryFollowing)
 		);
 }
@@ -155,15 +282,61 @@ void UTempoMovementControlServiceSubsystem::Initialize(FSubsystemCollectionBase&
 	Super::Initialize(Collection);
 
 	FTempoServer::Get().ActivateService<MovementControlService>(this);
+
+	EventsHandledHandle = FTempoServer::Get().OnEventsHandled().AddUObject(this, &UTempoMovementControlServiceSubsystem::ApplyStreamedCommands);
 }
 
 void UTempoMovementControlServiceSubsystem::Deinitialize()
 {
 	Super::Deinitialize();
 
+	FTempoServer::Get().OnEventsHandled().Remove(EventsHandledHandle);
+
 	FTempoServer::Get().DeactivateService<MovementControlService>();
 }
 
+void UTempoMovementControlServiceSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// The navmesh was built (or loaded) with the level, so the level as it is now is the first baseline.
+	NavigationDirtyRegions.Reset(&InWorld);
+}
+
+void UTempoMovementControlServiceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UpdatePawnMoveBatches();
+
+	if (PendingNavigationBuilds.IsEmpty())
+	{
+		return;
+	}
+
+	const UNavigationSystemV1* NavigationSystem = UNavigationSystemV1::GetCurrent(GetWorld());
+	if (NavigationSystem && NavigationSystem->IsNavigationBuildInProgress())
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	for (const FPendingNavigationBuild& PendingBuild : PendingNavigationBuilds)
+	{
+		RebuildNavigationResponse Response;
+		Response.set_num_dirty_regions(PendingBuild.NumDirtyRegions);
+		Response.set_num_tiles(PendingBuild.NumTiles);
+		Response.set_build_time_s(Now - PendingBuild.StartTime);
+		PendingBuild.ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
+	}
+	PendingNavigationBuilds.Empty();
+}
+
+TStatId UTempoMovementControlServiceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTempoMovementControlServiceSubsystem, STATGROUP_Tickables);
+}
+
 void UTempoMovementControlServiceSubsystem::GetCommandablePawns(const TempoCore::Empty& Request, const TResponseDelegate<TempoMovement::CommandablePawnsResponse>& ResponseContinuation) const
 {
 	TArray<AActor*> MovementControllers;
@@ -236,6 +409,130 @@ void UTempoMovementControlServiceSubsystem::CommandAcceleration(const Accelerati
 	ResponseContinuation.ExecuteIfBound(TempoEmpty(), grpc::Status_OK);
 }
 
+void UTempoMovementControlServiceSubsystem::StreamCommands(const CommandFrame& Request, const TResponseDelegate<CommandAck>& ResponseContinuation)
+{
+	FCommandStream& Stream = CommandStreams.FindOrAdd(ResponseContinuation.GetHandle());
+	Stream.ResponseContinuation = ResponseContinuation;
+	++Stream.NumPendingFrames;
+	Stream.LatestFrameSequence = Request.sequence();
+	Stream.LatestClientTime = Request.client_time();
+
+	for (const PawnCommand& Command : Request.commands())
+	{
+		switch (Command.command_case())
+		{
+			case PawnCommand::kDriving:
+			{
+				const NormalizedDrivingCommand& Driving = Command.driving();
+				Stream.PendingCommands.Add(UTF8_TO_TCHAR(Driving.vehicle().c_str()), FPendingStreamedCommand{ Request.sequence(),
+					FStreamedCommand(TInPlaceType<FNormalizedDrivingInput>(), FNormalizedDrivingInput(Driving.acceleration(), Driving.steering())) });
+				break;
+			}
+			case PawnCommand::kVelocity:
+			{
+				Stream.PendingCommands.Add(UTF8_TO_TCHAR(Command.velocity().pawn().c_str()), FPendingStreamedCommand{ Request.sequence(),
+					FStreamedCommand(TInPlaceType<FTempoTwist>(), FromProto(Command.velocity().twist())) });
+				break;
+			}
+			case PawnCommand::kAcceleration:
+			{
+				Stream.PendingCommands.Add(UTF8_TO_TCHAR(Command.acceleration().pawn().c_str()), FPendingStreamedCommand{ Request.sequence(),
+					FStreamedCommand(TInPlaceType<FTempoAccel>(), FromProto(Command.acceleration().accel())) });
+				break;
+			}
+			default:
+			{
+				Stream.PendingErrors.Add(FStreamedCommandError{ Request.sequence(), FString(), TEXT("Command must be set") });
+				break;
+			}
+		}
+	}
+}
+
+void UTempoMovementControlServiceSubsystem::ApplyStreamedCommands()
+{
+	bool bAnyPendingFrames = false;
+	for (auto StreamIt = CommandStreams.CreateIterator(); StreamIt; ++StreamIt)
+	{
+		// The delegate is unbound once its stream is done.
+		if (!StreamIt.Value().ResponseContinuation.IsBound())
+		{
+			StreamIt.RemoveCurrent();
+			continue;
+		}
+		bAnyPendingFrames |= StreamIt.Value().NumPendingFrames > 0;
+	}
+	if (!bAnyPendingFrames)
+	{
+		return;
+	}
+
+	// One search for the controllers, for every stream's commands.
+	TArray<AActor*> MovementControllers;
+	UGameplayStatics::GetAllActorsOfClass(GetWorld(), ATempoMovementController::StaticClass(), MovementControllers);
+	TMap<FString, ATempoMovementController*> ControllersByName;
+	for (AActor* MovementController : MovementControllers)
+	{
+		ATempoMovementController* Controller = Cast<ATempoMovementController>(MovementController);
+		// Like FindMovementController, the first controller with a name wins.
+		ControllersByName.FindOrAdd(Controller->GetPawnName(), Controller);
+	}
+
+	for (TPair<FDelegateHandle, FCommandStream>& StreamEntry : CommandStreams)
+	{
+		FCommandStream& Stream = StreamEntry.Value;
+		if (Stream.NumPendingFrames == 0)
+		{
+			continue;
+		}
+
+		CommandAck Ack;
+		Ack.set_tick_sequence(GFrameCounter);
+		Ack.set_sim_time(GetWorld()->GetTimeSeconds());
+		Ack.set_frame_sequence(Stream.LatestFrameSequence);
+		Ack.set_client_time(Stream.LatestClientTime);
+		Ack.set_num_frames(Stream.NumPendingFrames);
+
+		int32 NumApplied = 0;
+		for (const TPair<FString, FPendingStreamedCommand>& PendingCommand : Stream.PendingCommands)
+		{
+			grpc::Status Status;
+			ATempoMovementController* Controller = nullptr;
+			if (PendingCommand.Key.IsEmpty())
+			{
+				Controller = FindMovementController(MovementControllers, PendingCommand.Key, Status);
+			}
+			else if (ATempoMovementController** NamedController = ControllersByName.Find(PendingCommand.Key))
+			{
+				Controller = *NamedController;
+			}
+			else
+			{
+				Status = grpc::Status(grpc::StatusCode::NOT_FOUND, "Did not find a pawn with the specified name");
+			}
+
+			if (Controller && ApplyStreamedCommand(Controller, PendingCommand.Value.Command, Status))
+			{
+				++NumApplied;
+			}
+			else
+			{
+				AddCommandError(Ack, PendingCommand.Value.FrameSequence, PendingCommand.Key, UTF8_TO_TCHAR(Status.error_message().c_str()));
+			}
+		}
+		for (const FStreamedCommandError& Error : Stream.PendingErrors)
+		{
+			AddCommandError(Ack, Error.FrameSequence, Error.Pawn, Error.Error);
+		}
+		Ack.set_num_applied(NumApplied);
+
+		Stream.PendingCommands.Reset();
+		Stream.PendingErrors.Reset();
+		Stream.NumPendingFrames = 0;
+		Stream.ResponseContinuation.ExecuteIfBound(Ack, grpc::Status_OK);
+	}
+}
+
 void UTempoMovementControlServiceSubsystem::GetNavigablePawns(const TempoEmpty& Request, const TResponseDelegate<NavigablePawnsResponse>& ResponseContinuation) const
 {
 	TArray<AActor*> AIControllers;
@@ -283,21 +580,11 @@ void UTempoMovementControlServiceSubsystem::PawnMoveToLocation(const PawnMoveToL
 					AIController->StopMovement();
 				}
 
-				// Lifted from AAIController::MoveToLocation, because that buries the FAIRequestID but we need it.
-				FAIMoveRequest MoveRequest(Destination);
-				MoveRequest.SetUsePathfinding(true);
-				MoveRequest.SetAllowPartialPath(true);
-				MoveRequest.SetProjectGoalLocation(false);
-				MoveRequest.SetNavigationFilter(AIController->GetDefaultNavigationFilterClass());
-				MoveRequest.SetAcceptanceRadius(-1);
-				MoveRequest.SetReachTestIncludesAgentRadius(false);
-				MoveRequest.SetCanStrafe(true);
-
-				switch (const FPathFollowingRequestResult MoveRequestResult = AIController->MoveTo(MoveRequest))
+				switch (const FPathFollowingRequestResult MoveRequestResult = AIController->MoveTo(MakeMoveRequest(AIController, Destination)))
 				{
 					case EPathFollowingRequestResult::Type::RequestSuccessful:
 					{
-						AIController->ReceiveMoveCompleted.AddDynamic(this, &UTempoMovementControlServiceSubsystem::OnPawnMoveCompleted);
+						BindMoveCompleted(AIController);
 						PendingPawnMoves.Add(MoveRequestResult.MoveId, {AIController, ResponseContinuation});
 						break;
 					}
@@ -323,84 +610,329 @@ void UTempoMovementControlServiceSubsystem::PawnMoveToLocation(const PawnMoveToL
 
 void UTempoMovementControlServiceSubsystem::OnPawnMoveCompleted(FAIRequestID RequestID, EPathFollowingResult::Type Result)
 {
-	if (const FPendingPawnMoveInfo* PendingPawnMoveInfo = PendingPawnMoves.Find(RequestID))
+	TPair<FDelegateHandle, FBatchedPawnMove> BatchedMove;
+	if (PendingBatchedPawnMoves.RemoveAndCopyValue(RequestID, BatchedMove))
+	{
+		UnbindMoveCompleted(BatchedMove.Value.Controller);
+		if (FPawnMoveBatch* Batch = PawnMoveBatches.Find(BatchedMove.Key))
+		{
+			SendPawnMoveCompletion(*Batch, BatchedMove.Value, ToMoveToResult(Result));
+		}
+		return;
+	}
+
+	FPendingPawnMoveInfo PendingPawnMoveInfo;
+	if (PendingPawnMoves.RemoveAndCopyValue(RequestID, PendingPawnMoveInfo))
 	{
+		UnbindMoveCompleted(PendingPawnMoveInfo.Controller);
 		PawnMoveToLocationResponse Response;
-		switch (Result)
+		Response.set_result(ToMoveToResult(Result));
+		PendingPawnMoveInfo.ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
+		return;
+	}
+
+	UE_LOG(LogTempoMovement, Error, TEXT("Received move completed event for pawn without a pending move"));
+}
+
+void UTempoMovementControlServiceSubsystem::PawnsMoveToLocations(const PawnsMoveToLocationsRequest& Request, const TResponseDelegate<PawnMoveCompletion>& ResponseContinuation)
+{
+	// After the first message, a stream only asks for the next completion.
+	if (FPawnMoveBatch* Batch = PawnMoveBatches.Find(ResponseContinuation.GetHandle()))
+	{
+		Batch->ResponseContinuation = ResponseContinuation;
+		return;
+	}
+
+	if (Request.moves_size() == 0)
+	{
+		ResponseContinuation.ExecuteIfBound(PawnMoveCompletion(), grpc::Status(grpc::FAILED_PRECONDITION, "At least one move must be specified"));
+		return;
+	}
+
+	// One lookup for the whole batch, rather than one per pawn.
+	TMap<FString, AAIController*> ControllersByPawn;
+	TArray<AActor*> AIControllers;
+	UGameplayStatics::GetAllActorsOfClass(this, AAIController::StaticClass(), AIControllers);
+	for (AActor* Controller : AIControllers)
+	{
+		if (const APawn* Pawn = Cast<AController>(Controller)->GetPawn())
 		{
-			case EPathFollowingResult::Type::Success:
-			{
-				Response.set_result(TempoMovement::MTR_SUCCESS);
-				break;
-			}
-			case EPathFollowingResult::Type::Blocked:
-			{
-				Response.set_result(TempoMovement::MTR_BLOCKED);
-				break;
-			}
-			case EPathFollowingResult::Type::OffPath:
-			{
-				Response.set_result(TempoMovement::MTR_OFF_PATH);
-				break;
-			}
-			case EPathFollowingResult::Type::Aborted:
-			{
-				Response.set_result(TempoMovement::MTR_ABORTED);
-				break;
-			}
-			case EPathFollowingResult::Type::Invalid:
-			{
-				Response.set_result(TempoMovement::MTR_INVALID);
-				break;
-			}
-			default:
-			{
-				Response.set_result(TempoMovement::MTR_UNKNOWN);
-				break;
-			}
+			ControllersByPawn.Add(UTempoCoreUtils::GetActorIdentifier(Pawn), Cast<AAIController>(Controller));
+		}
+	}
+
+	FPawnMoveBatch& Batch = PawnMoveBatches.Add(ResponseContinuation.GetHandle());
+	Batch.ResponseContinuation = ResponseContinuation;
+	Batch.MaxPathQueriesPerFrame = Request.max_path_queries_per_frame() > 0 ? Request.max_path_queries_per_frame() : MaxPathQueriesPerFrame;
+	Batch.NumUnfinishedMoves = Request.moves_size();
+
+	for (int32 MoveIndex = 0; MoveIndex < Request.moves_size(); ++MoveIndex)
+	{
+		const PawnMoveToLocationRequest& MoveRequest = Request.moves(MoveIndex);
+		FBatchedPawnMove Move;
+		Move.Pawn = UTF8_TO_TCHAR(MoveRequest.pawn().c_str());
+		Move.MoveIndex = MoveIndex;
+
+		AAIController* const* AIController = ControllersByPawn.Find(Move.Pawn);
+		if (!AIController)
+		{
+			SendPawnMoveCompletion(Batch, Move, TempoMovement::MTR_INVALID, TEXT("Failed to find pawn with specified name"));
+			continue;
 		}
-		if (PendingPawnMoveInfo->Controller.IsValid())
+
+		Move.Controller = *AIController;
+		Move.Destination = QuantityConverter<M2CM, R2L>::Convert(FVector(MoveRequest.location().x(), MoveRequest.location().y(), MoveRequest.location().z()));
+		if (MoveRequest.relative())
 		{
-			PendingPawnMoveInfo->Controller->ReceiveMoveCompleted.RemoveDynamic(this, &UTempoMovementControlServiceSubsystem::OnPawnMoveCompleted);
+			Move.Destination = (*AIController)->GetPawn()->GetActorTransform().TransformPosition(Move.Destination);
 		}
-		PendingPawnMoveInfo->ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
-		PendingPawnMoves.Remove(RequestID);
+		Batch.QueuedMoves.Add(MoveTemp(Move));
+	}
+
+	// Path queries start from the next Tick, so the batches never exceed their per-frame budget.
+}
+
+void UTempoMovementControlServiceSubsystem::DispatchPathQueries(FDelegateHandle BatchHandle, FPawnMoveBatch& Batch, int32& PathQueryBudget)
+{
+	UNavigationSystemV1* NavigationSystem = UNavigationSystemV1::GetCurrent(GetWorld());
+
+	const int32 NumMoves = FMath::Min3(Batch.MaxPathQueriesPerFrame, PathQueryBudget, Batch.QueuedMoves.Num() - Batch.NextQueuedMove);
+	PathQueryBudget -= NumMoves;
+	const int32 EndMove = Batch.NextQueuedMove + NumMoves;
+	for (; Batch.NextQueuedMove < EndMove; ++Batch.NextQueuedMove)
+	{
+		const FBatchedPawnMove& Move = Batch.QueuedMoves[Batch.NextQueuedMove];
+		AAIController* AIController = Move.Controller.Get();
+		if (!AIController || !AIController->GetPawn())
+		{
+			SendPawnMoveCompletion(Batch, Move, TempoMovement::MTR_ABORTED, TEXT("Pawn was destroyed before it could move"));
+			continue;
+		}
+
+		FPathFindingQuery Query;
+		if (!NavigationSystem || !AIController->BuildPathfindingQuery(MakeMoveRequest(AIController, Move.Destination), Query))
+		{
+			SendPawnMoveCompletion(Batch, Move, TempoMovement::MTR_INVALID, TEXT("No navigation data found for pawn"));
+			continue;
+		}
+
+		const uint32 QueryID = NavigationSystem->FindPathAsync(AIController->GetNavAgentPropertiesRef(), Query,
+			FNavPathQueryDelegate::CreateUObject(this, &UTempoMovementControlServiceSubsystem::OnBatchedPathFound, BatchHandle, Move));
+		if (QueryID == INVALID_NAVQUERYID)
+		{
+			SendPawnMoveCompletion(Batch, Move, TempoMovement::MTR_INVALID, TEXT("Failed to start path query"));
+		}
+	}
+
+	if (Batch.NextQueuedMove == Batch.QueuedMoves.Num() && !Batch.QueuedMoves.IsEmpty())
+	{
+		Batch.QueuedMoves.Empty();
+		Batch.NextQueuedMove = 0;
+	}
+}
+
+void UTempoMovementControlServiceSubsystem::OnBatchedPathFound(uint32 QueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path, FDelegateHandle BatchHandle, FBatchedPawnMove Move)
+{
+	FPawnMoveBatch* Batch = PawnMoveBatches.Find(BatchHandle);
+	if (!Batch)
+	{
 		return;
 	}
 
-	UE_LOG(LogTempoMovement, Error, TEXT("Received move completed event for pawn without a pending move"));
+	AAIController* AIController = Move.Controller.Get();
+	if (!AIController || !AIController->GetPawn())
+	{
+		SendPawnMoveCompletion(*Batch, Move, TempoMovement::MTR_ABORTED, TEXT("Pawn was destroyed before it could move"));
+		return;
+	}
+
+	if (Result != ENavigationQueryResult::Success || !Path.IsValid())
+	{
+		SendPawnMoveCompletion(*Batch, Move, TempoMovement::MTR_INVALID, TEXT("No path found to the requested location"));
+		return;
+	}
+
+	// Abort any ongoing move.
+	if (AIController->GetMoveStatus() != EPathFollowingStatus::Idle)
+	{
+		AIController->StopMovement();
+	}
+
+	// As AAIController::FindPathForMoveRequest does for the paths it finds.
+	Path->EnableRecalculationOnInvalidation(true);
+
+	// Bind first, in case the move finishes right away.
+	BindMoveCompleted(AIController);
+	const FAIRequestID MoveID = AIController->RequestMove(MakeMoveRequest(AIController, Move.Destination), Path);
+	if (!MoveID.IsValid())
+	{
+		UnbindMoveCompleted(AIController);
+		SendPawnMoveCompletion(*Batch, Move, TempoMovement::MTR_INVALID, TEXT("Move request failed for unknown reason"));
+		return;
+	}
+	PendingBatchedPawnMoves.Add(MoveID, {BatchHandle, MoveTemp(Move)});
 }
 
-void UTempoMovementControlServiceSubsystem::RebuildNavigation(const TempoEmpty& Request, const TResponseDelegate<TempoEmpty>& ResponseContinuation) const
+void UTempoMovementControlServiceSubsystem::UpdatePawnMoveBatches()
 {
-	auto CanRebuildNavigation = [](const UNavigationSystemV1* NavigationSystem)
+	// Moves whose pawns were destroyed mid-move may never hear back from path following.
+	for (auto MoveIt = PendingBatchedPawnMoves.CreateIterator(); MoveIt; ++MoveIt)
 	{
-		for (const ANavigationData* NavData : NavigationSystem->NavDataSet)
+		const FBatchedPawnMove& Move = MoveIt->Value.Value;
+		if (Move.Controller.IsValid() && Move.Controller->GetPawn())
 		{
-			if (NavData && NavData->GetRuntimeGenerationMode() == ERuntimeGenerationType::Dynamic)
-			{
-				return true;
-			}
+			continue;
 		}
+		UnbindMoveCompleted(Move.Controller);
+		if (FPawnMoveBatch* Batch = PawnMoveBatches.Find(MoveIt->Value.Key))
+		{
+			SendPawnMoveCompletion(*Batch, Move, TempoMovement::MTR_ABORTED, TEXT("Pawn was destroyed while moving"));
+		}
+		MoveIt.RemoveCurrent();
+	}
+
+	// Every batch draws on one per-frame budget of path queries. The batches take turns going first, so none starves.
+	TArray<FDelegateHandle> BatchHandles;
+	PawnMoveBatches.GenerateKeyArray(BatchHandles);
+	int32 PathQueryBudget = MaxPathQueriesPerFrame;
+	for (int32 BatchOffset = 0; BatchOffset < BatchHandles.Num() && PathQueryBudget > 0; ++BatchOffset)
+	{
+		const FDelegateHandle BatchHandle = BatchHandles[(FirstPathQueryBatch + BatchOffset) % BatchHandles.Num()];
+		DispatchPathQueries(BatchHandle, PawnMoveBatches[BatchHandle], PathQueryBudget);
+	}
+	++FirstPathQueryBatch;
+
+	// A batch's last completion finished its stream, so nothing will ask for it again.
+	for (auto BatchIt = PawnMoveBatches.CreateIterator(); BatchIt; ++BatchIt)
+	{
+		if (BatchIt->Value.NumUnfinishedMoves == 0)
+		{
+			BatchIt.RemoveCurrent();
+		}
+	}
+}
+
+void UTempoMovementControlServiceSubsystem::BindMoveCompleted(AAIController* Controller)
+{
+	if (MoveCompletedBindings.FindOrAdd(TWeakObjectPtr<AAIController>(Controller))++ == 0)
+	{
+		Controller->ReceiveMoveCompleted.AddUniqueDynamic(this, &UTempoMovementControlServiceSubsystem::OnPawnMoveCompleted);
+	}
+}
+
+void UTempoMovementControlServiceSubsystem::UnbindMoveCompleted(const TWeakObjectPtr<AAIController>& Controller)
+{
+	// Other moves may still be waiting to hear from the same controller.
+	int32* NumBindings = MoveCompletedBindings.Find(Controller);
+	if (!NumBindings || --(*NumBindings) > 0)
+	{
+		return;
+	}
+	MoveCompletedBindings.Remove(Controller);
+	if (AAIController* AIController = Controller.Get())
+	{
+		AIController->ReceiveMoveCompleted.RemoveDynamic(this, &UTempoMovementControlServiceSubsystem::OnPawnMoveCompleted);
+	}
+}
 
-		return false;
-	};
+void UTempoMovementControlServiceSubsystem::RebuildNavigation(const RebuildNavigationRequest& Request, const TResponseDelegate<RebuildNavigationResponse>& ResponseContinuation)
+{
+	const double StartTime = FPlatformTime::Seconds();
 
 	UNavigationSystemV1* NavigationSystem = UNavigationSystemV1::GetCurrent(GetWorld());
 	if (!NavigationSystem)
 	{
-		ResponseContinuation.ExecuteIfBound(TempoEmpty(), grpc::Status(grpc::FAILED_PRECONDITION, "Navigation system not found"));
+		ResponseContinuation.ExecuteIfBound(RebuildNavigationResponse(), grpc::Status(grpc::FAILED_PRECONDITION, "Navigation system not found"));
 		return;
 	}
 
-	if (!CanRebuildNavigation(NavigationSystem))
+	TArray<ANavigationData*> DynamicNavData;
+	for (ANavigationData* NavData : NavigationSystem->NavDataSet)
 	{
-		ResponseContinuation.ExecuteIfBound(TempoEmpty(), grpc::Status(grpc::FAILED_PRECONDITION, "Rebuilding navigation in game is only supported with dynamic generation mode"));
+		if (NavData && NavData->GetRuntimeGenerationMode() == ERuntimeGenerationType::Dynamic)
+		{
+			DynamicNavData.Add(NavData);
+		}
+	}
+
+	if (DynamicNavData.IsEmpty())
+	{
+		ResponseContinuation.ExecuteIfBound(RebuildNavigationResponse(), grpc::Status(grpc::FAILED_PRECONDITION, "Rebuilding navigation in game is only supported with dynamic generation mode"));
 		return;
 	}
 
-	NavigationSystem->Build();
-	ResponseContinuation.ExecuteIfBound(TempoEmpty(), grpc::Status_OK);
+	// A full rebuild makes the world as it is now the baseline for the next one.
+	if (!Request.incremental())
+	{
+		NavigationDirtyRegions.Reset(GetWorld());
+		NavigationSystem->Build();
+
+		RebuildNavigationResponse Response;
+		Response.set_build_time_s(FPlatformTime::Seconds() - StartTime);
+		ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
+		return;
+	}
+
+	TArray<FNavigationDirtyArea> DirtyAreas;
+	if (Request.dirty_regions_size() > 0)
+	{
+		TArray<FBox> Regions;
+		for (const TempoCore::Box& Region : Request.dirty_regions())
+		{
+			// Converting to left-handed flips Y, so min and max must be re-sorted.
+			FBox Bounds(ForceInit);
+			Bounds += QuantityConverter<M2CM, R2L>::Convert(FVector(Region.min().x(), Region.min().y(), Region.min().z()));
+			Bounds += QuantityConverter<M2CM, R2L>::Convert(FVector(Region.max().x(), Region.max().y(), Region.max().z()));
+			Regions.Add(Bounds);
+			DirtyAreas.Add(FNavigationDirtyArea(Bounds, ENavigationDirtyFlag::All));
+		}
+		// Changes outside the client's regions weren't rebuilt, so they stay dirty for the next rebuild.
+		NavigationDirtyRegions.MarkRegionsRebuilt(GetWorld(), Regions);
+	}
+	else
+	{
+		for (const FBox& Bounds : NavigationDirtyRegions.CollectDirtyRegions(GetWorld()))
+		{
+			DirtyAreas.Add(FNavigationDirtyArea(Bounds, ENavigationDirtyFlag::All));
+		}
+	}
+
+	if (DirtyAreas.IsEmpty())
+	{
+		RebuildNavigationResponse Response;
+		Response.set_build_time_s(FPlatformTime::Seconds() - StartTime);
+		ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
+		return;
+	}
+
+	// Mark the tiles dirty directly on the navmeshes, rather than through the navigation system's dirty area
+	// queue, so they are counted (and, if waiting, built) now instead of on the navigation system's next tick.
+	int32 NumTiles = 0;
+	for (ANavigationData* NavData : DynamicNavData)
+	{
+		NavData->RebuildDirtyAreas(DirtyAreas);
+		if (const FNavDataGenerator* Generator = NavData->GetGenerator())
+		{
+			NumTiles += Generator->GetNumRemaningBuildTasks();
+		}
+	}
+
+	if (!Request.wait())
+	{
+		PendingNavigationBuilds.Add({StartTime, DirtyAreas.Num(), NumTiles, ResponseContinuation});
+		return;
+	}
+
+	for (ANavigationData* NavData : DynamicNavData)
+	{
+		NavData->EnsureBuildCompletion();
+	}
+
+	RebuildNavigationResponse Response;
+	Response.set_num_dirty_regions(DirtyAreas.Num());
+	Response.set_num_tiles(NumTiles);
+	Response.set_build_time_s(FPlatformTime::Seconds() - StartTime);
+	ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
 }
 
 void UTempoMovementControlServiceSubsystem::SetSplinePoints(const SetSplinePointsRequest& Request, const TResponseDelegate<TempoEmpty>& ResponseContinuation) const
@@ -418,26 +950,77 @@ void UTempoMovementControlServiceSubsystem::SetSplinePoints(const SetSplinePoint
 		return;
 	}
 
-	// Rebuild the real spline geometry. Locations and tangents arrive in SI/right-handed and
-	// are converted to Unreal-native cm/left-handed. Tangents are direction vectors, so the
-	// same QuantityConverter (which negates Y) applies. Update the spline once at the end.
-	USplineComponent* Spline = SplineActor->GetSpline();
-	Spline->ClearSplinePoints(false);
-	for (int32 PointIndex = 0; PointIndex < Request.points_size(); ++PointIndex)
+	// Locations and tangents arrive in SI/right-handed and are converted to Unreal-native
+	// cm/left-handed. Tangents are direction vectors, so the same QuantityConverter (which
+	// negates Y) applies.
+	TArray<FVector> Locations;
+	TArray<FVector> Tangents;
+	Locations.Reserve(Request.points_size());
+	Tangents.Reserve(Request.points_size());
+	for (const TempoMovement::SplinePoint& Point : Request.points())
 	{
-		const TempoMovement::SplinePoint& Point = Request.points(PointIndex);
-		const FVector Location = QuantityConverter<M2CM, R2L>::Convert(FVector(Point.location().x(), Point.location().y(), Point.location().z()));
-		Spline->AddSplinePoint(Location, ESplineCoordinateSpace::World, false);
+		Locations.Add(QuantityConverter<M2CM, R2L>::Convert(FVector(Point.location().x(), Point.location().y(), Point.location().z())));
+		Tangents.Add(QuantityConverter<M2CM, R2L>::Convert(FVector(Point.tangent().x(), Point.tangent().y(), Point.tangent().z())));
 	}
-	for (int32 PointIndex = 0; PointIndex < Request.points_size(); ++PointIndex)
+	SplineActor->SetSplinePoints(Locations, Tangents);
+
+	ResponseContinuation.ExecuteIfBound(TempoEmpty(), grpc::Status_OK);
+}
+
+void UTempoMovementControlServiceSubsystem::SetSplinePointsBatch(const SetSplinePointsBatchRequest& Request, const TResponseDelegate<SetSplinePointsBatchResponse>& ResponseContinuation) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TempoSetSplinePointsBatch);
+
+	// One search for the splines, for the whole batch. Like FindSplineActor, the first spline with a name wins.
+	TArray<AActor*> SplineActors;
+	UGameplayStatics::GetAllActorsOfClass(GetWorld(), ASplineActor::StaticClass(), SplineActors);
+	TMap<FString, ASplineActor*> SplinesByName;
+	SplinesByName.Reserve(SplineActors.Num());
+	for (AActor* SplineActor : SplineActors)
 	{
-		const TempoMovement::SplinePoint& Point = Request.points(PointIndex);
-		const FVector Tangent = QuantityConverter<M2CM, R2L>::Convert(FVector(Point.tangent().x(), Point.tangent().y(), Point.tangent().z()));
-		Spline->SetTangentAtSplinePoint(PointIndex, Tangent, ESplineCoordinateSpace::World, false);
+		SplinesByName.FindOrAdd(UTempoCoreUtils::GetActorIdentifier(SplineActor), Cast<ASplineActor>(SplineActor));
 	}
-	Spline->UpdateSpline();
 
-	ResponseContinuation.ExecuteIfBound(TempoEmpty(), grpc::Status_OK);
+	SetSplinePointsBatchResponse Response;
+	TArray<FVector> Locations;
+	TArray<FVector> Tangents;
+	for (const TempoMovement::SplineGeometry& Geometry : Request.splines())
+	{
+		const FString SplineName(UTF8_TO_TCHAR(Geometry.spline().c_str()));
+		ASplineActor* const* SplineActor = SplinesByName.Find(SplineName);
+		if (!SplineActor)
+		{
+			AddSplineGeometryError(Response, SplineName, TEXT("Did not find a spline with the specified name"));
+			continue;
+		}
+		if (Geometry.locations_size() % 3 != 0 || Geometry.tangents_size() != Geometry.locations_size())
+		{
+			AddSplineGeometryError(Response, SplineName, TEXT("Locations and tangents require x, y, and z for each point"));
+			continue;
+		}
+		if (Geometry.locations_size() < 6)
+		{
+			AddSplineGeometryError(Response, SplineName, TEXT("A spline requires at least two points"));
+			continue;
+		}
+
+		UnpackSplineVectors(Geometry.locations(), Locations);
+		UnpackSplineVectors(Geometry.tangents(), Tangents);
+		switch ((*SplineActor)->SetSplinePoints(Locations, Tangents))
+		{
+		case ESplineGeometryUpdate::Unchanged:
+			Response.set_num_unchanged(Response.num_unchanged() + 1);
+			break;
+		case ESplineGeometryUpdate::UpdatedInPlace:
+			Response.set_num_updated_in_place(Response.num_updated_in_place() + 1);
+			break;
+		case ESplineGeometryUpdate::Rebuilt:
+			Response.set_num_rebuilt(Response.num_rebuilt() + 1);
+			break;
+		}
+	}
+
+	ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
 }
 
 void UTempoMovementControlServiceSubsystem::ConfigureTrajectoryFollowing(const ConfigureTrajectoryFollowingRequest& Request, const TResponseDelegate<TempoEmpty>& ResponseContinuation) const
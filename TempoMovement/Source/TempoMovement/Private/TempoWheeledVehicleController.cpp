@@ -3,6 +3,7 @@
 #include "TempoWheeledVehicleController.h"
 
 #include "KinematicVehicleMovementComponent.h"
+#include "WheeledVehicleControlBatchSubsystem.h"
 
 #include "ChaosVehicleMovementComponent.h"
 #include "Kismet/GameplayStatics.h"
@@ -11,6 +12,40 @@ void ATempoWheeledVehicleController::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	// The batch runs TickControl for batched controllers. Everything else the actor's tick does still happens here.
+	if (!bControlBatched)
+	{
+		TickControl(DeltaTime);
+	}
+}
+
+void ATempoWheeledVehicleController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+
+	if (bUseBatchControl)
+	{
+		if (UWheeledVehicleControlBatchSubsystem* BatchSubsystem = GetWorld()->GetSubsystem<UWheeledVehicleControlBatchSubsystem>())
+		{
+			BatchSubsystem->RegisterController(this);
+			bControlBatched = true;
+		}
+	}
+}
+
+void ATempoWheeledVehicleController::OnUnPossess()
+{
+	if (UWheeledVehicleControlBatchSubsystem* BatchSubsystem = GetWorld()->GetSubsystem<UWheeledVehicleControlBatchSubsystem>())
+	{
+		BatchSubsystem->UnregisterController(this);
+	}
+	bControlBatched = false;
+
+	Super::OnUnPossess();
+}
+
+void ATempoWheeledVehicleController::TickControl(float DeltaTime)
+{
 	APawn* ControlledPawn = GetPawn();
 	if (!ControlledPawn)
 	{
@@ -108,7 +143,7 @@ void ATempoWheeledVehicleController::TickDriving(APawn* ControlledPawn)
 	}
 }
 
-void ATempoWheeledVehicleController::TickClosedLoop(float DeltaTime, APawn* ControlledPawn)
+void ATempoWheeledVehicleController::UpdateVelocityTarget(float DeltaTime)
 {
 	// Watchdog: if we haven't heard a new command in too long, clamp setpoints to zero.
 	const double Now = UGameplayStatics::GetTimeSeconds(this);
@@ -124,6 +159,11 @@ void ATempoWheeledVehicleController::TickClosedLoop(float DeltaTime, APawn* Cont
 		VelocityTarget.Linear += DeltaTime * AccelTarget.Linear;
 		VelocityTarget.Angular += DeltaTime * AccelTarget.Angular;
 	}
+}
+
+void ATempoWheeledVehicleController::TickClosedLoop(float DeltaTime, APawn* ControlledPawn)
+{
+	UpdateVelocityTarget(DeltaTime);
 
 	// Only linear.x and angular.z are actuable for a wheeled vehicle. Other axes are ignored.
 	const float TargetLinVelCmS = VelocityTarget.Linear.X;
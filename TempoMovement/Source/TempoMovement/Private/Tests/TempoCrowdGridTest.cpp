@@ -0,0 +1,181 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoCrowdGridSubsystem.h"
+#include "TempoTestWorld.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+// Tests for UTempoCrowdGridSubsystem against a brute-force neighbor search, its lazy rebuilds and registration
+// counts, and a benchmark for a plaza of 2,000 agents. Run with
+//   Automation RunTests Tempo.Movement.CrowdGrid
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoCrowdGridTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	// A 50 m square plaza.
+	constexpr double PlazaSize = 5000.0;
+
+	// A test world with agents scattered over the plaza.
+	struct FCrowdGridTestFixture : FTempoTestWorld
+	{
+		UTempoCrowdGridSubsystem* CrowdGrid = nullptr;
+		TArray<AActor*> Agents;
+
+		explicit FCrowdGridTestFixture(int32 NumAgents)
+		{
+			CrowdGrid = World->GetSubsystem<UTempoCrowdGridSubsystem>();
+
+			FRandomStream Random(46);
+			for (int32 AgentIndex = 0; AgentIndex < NumAgents; ++AgentIndex)
+			{
+				const FVector Location(Random.FRandRange(0.0, PlazaSize), Random.FRandRange(0.0, PlazaSize), Random.FRandRange(0.0, 50.0));
+				AStaticMeshActor* Agent = World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator);
+				Agent->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+				Agents.Add(Agent);
+				if (CrowdGrid)
+				{
+					CrowdGrid->RegisterAgent(Agent);
+				}
+			}
+		}
+
+		// The distances (squared) to the nearest MaxNeighbors agents within Radius, by checking every agent.
+		TArray<double> BruteForceNeighbors(const FVector& Location, float Radius, int32 MaxNeighbors, const AActor* IgnoredAgent) const
+		{
+			TArray<double> DistancesSquared;
+			for (const AActor* Agent : Agents)
+			{
+				const double DistanceSquared = FVector::DistSquared(Location, Agent->GetActorLocation());
+				if (Agent != IgnoredAgent && DistanceSquared <= FMath::Square(static_cast<double>(Radius)))
+				{
+					DistancesSquared.Add(DistanceSquared);
+				}
+			}
+			DistancesSquared.Sort();
+			DistancesSquared.SetNum(FMath::Min(DistancesSquared.Num(), MaxNeighbors));
+			return DistancesSquared;
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoCrowdGridNeighborsTest,
+	"Tempo.Movement.CrowdGrid.Neighbors", TempoCrowdGridTestFlags)
+bool FTempoCrowdGridNeighborsTest::RunTest(const FString& Parameters)
+{
+	const FCrowdGridTestFixture Fixture(500);
+	if (!TestNotNull(TEXT("Game worlds have a crowd grid"), Fixture.CrowdGrid))
+	{
+		return false;
+	}
+	Fixture.CrowdGrid->SetCellSize(300.0f);
+	Fixture.CrowdGrid->BuildGrid();
+
+	const FTempoCrowdGridStats& Stats = Fixture.CrowdGrid->GetStats();
+	TestEqual(TEXT("Every agent is in the grid"), Stats.NumAgents, 500);
+	TestTrue(TEXT("The agents are spread over many cells"), Stats.NumOccupiedCells > 100 && Stats.MaxAgentsPerCell < 500);
+
+	TArray<FTempoCrowdNeighbor> Neighbors;
+	int32 NumMismatches = 0;
+	for (const float Radius : { 100.0f, 450.0f, 10000.0f })
+	{
+		for (const int32 MaxNeighbors : { 1, 8, 1000 })
+		{
+			for (int32 AgentIndex = 0; AgentIndex < Fixture.Agents.Num(); AgentIndex += 7)
+			{
+				const AActor* Agent = Fixture.Agents[AgentIndex];
+				Fixture.CrowdGrid->FindNeighbors(Agent->GetActorLocation(), Radius, MaxNeighbors, Neighbors, Agent);
+				const TArray<double> Expected = Fixture.BruteForceNeighbors(Agent->GetActorLocation(), Radius, MaxNeighbors, Agent);
+
+				bool bMatches = Neighbors.Num() == Expected.Num();
+				for (int32 NeighborIndex = 0; bMatches && NeighborIndex < Neighbors.Num(); ++NeighborIndex)
+				{
+					bMatches = Neighbors[NeighborIndex].DistanceSquared == Expected[NeighborIndex]
+						&& Neighbors[NeighborIndex].Agent.Get() != Agent;
+				}
+				NumMismatches += bMatches ? 0 : 1;
+			}
+		}
+	}
+	TestEqual(TEXT("The grid finds the same nearest neighbors as a brute-force search"), NumMismatches, 0);
+	TestTrue(TEXT("Queries are counted"), Stats.NumQueries > 0 && Stats.NumCandidatesTested > 0);
+
+	// Moved and destroyed agents are picked up by the next frame's first query, and not before.
+	AActor* Moved = Fixture.Agents[0];
+	Moved->SetActorLocation(FVector(-10000.0, -10000.0, 0.0));
+	Fixture.Agents[1]->Destroy();
+	Fixture.CrowdGrid->Tick(0.0f);
+	TestEqual(TEXT("Frames without queries don't rebuild the grid"), Fixture.CrowdGrid->GetStats().NumAgents, 500);
+	Fixture.CrowdGrid->FindNeighbors(FVector(-10000.0, -10000.0, 0.0), 100.0f, 8, Neighbors);
+	if (TestEqual(TEXT("Moved agents are found where they are now"), Neighbors.Num(), 1))
+	{
+		TestTrue(TEXT("Moved agents are found where they are now"), Neighbors[0].Agent.Get() == Moved);
+	}
+	TestEqual(TEXT("Destroyed agents are forgotten"), Fixture.CrowdGrid->GetStats().NumAgents, 499);
+
+	// An agent registered twice (by its controller and its avoidance component, say) stays until both unregister it.
+	AActor* Shared = Fixture.Agents[2];
+	Fixture.CrowdGrid->RegisterAgent(Shared);
+	TestEqual(TEXT("Registering an agent again doesn't add it twice"), Fixture.CrowdGrid->NumAgents(), 499);
+	Fixture.CrowdGrid->UnregisterAgent(Shared);
+	TestEqual(TEXT("Agents stay while any registration remains"), Fixture.CrowdGrid->NumAgents(), 499);
+	Fixture.CrowdGrid->UnregisterAgent(Shared);
+	TestEqual(TEXT("Agents leave once every registration is gone"), Fixture.CrowdGrid->NumAgents(), 498);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoCrowdGridBenchmarkTest,
+	"Tempo.Movement.CrowdGrid.Benchmark", TempoCrowdGridTestFlags)
+bool FTempoCrowdGridBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumAgents = 2000;
+	constexpr float Radius = 500.0f;
+	constexpr int32 MaxNeighbors = 8;
+
+	const FCrowdGridTestFixture Fixture(NumAgents);
+	if (!TestNotNull(TEXT("Game worlds have a crowd grid"), Fixture.CrowdGrid))
+	{
+		return false;
+	}
+	Fixture.CrowdGrid->SetCellSize(Radius);
+
+	// One frame's worth: build, then every agent finds its neighbors.
+	double StartTime = FPlatformTime::Seconds();
+	Fixture.CrowdGrid->BuildGrid();
+	const double BuildTime = FPlatformTime::Seconds() - StartTime;
+
+	TArray<FTempoCrowdNeighbor> Neighbors;
+	int32 NumFound = 0;
+	StartTime = FPlatformTime::Seconds();
+	for (const AActor* Agent : Fixture.Agents)
+	{
+		NumFound += Fixture.CrowdGrid->FindNeighbors(Agent->GetActorLocation(), Radius, MaxNeighbors, Neighbors, Agent);
+	}
+	const double QueryTime = FPlatformTime::Seconds() - StartTime;
+
+	int32 NumFoundBruteForce = 0;
+	StartTime = FPlatformTime::Seconds();
+	for (const AActor* Agent : Fixture.Agents)
+	{
+		NumFoundBruteForce += Fixture.BruteForceNeighbors(Agent->GetActorLocation(), Radius, MaxNeighbors, Agent).Num();
+	}
+	const double BruteForceTime = FPlatformTime::Seconds() - StartTime;
+
+	TestEqual(TEXT("The grid finds as many neighbors as a brute-force search"), NumFound, NumFoundBruteForce);
+
+	const FTempoCrowdGridStats& Stats = Fixture.CrowdGrid->GetStats();
+	AddInfo(FString::Printf(TEXT("%d agents: build %.3f ms, %d queries %.3f ms (%.1f candidates each), brute force %.3f ms; %d occupied cells, at most %d agents per cell"),
+		NumAgents, BuildTime * 1000.0, Stats.NumQueries, QueryTime * 1000.0, static_cast<double>(Stats.NumCandidatesTested) / FMath::Max(Stats.NumQueries, 1),
+		BruteForceTime * 1000.0, Stats.NumOccupiedCells, Stats.MaxAgentsPerCell));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
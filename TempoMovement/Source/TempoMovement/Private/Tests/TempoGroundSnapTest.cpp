@@ -0,0 +1,170 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "GroundSnapCacheSubsystem.h"
+#include "GroundSnapComponent.h"
+
+#include "TempoTestWorld.h"
+
+#include "Components/BoxComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+// Tests for UGroundSnapComponent's motion-aware resnapping and UGroundSnapCacheSubsystem: 1,000 agents over a
+// procedural heightfield must end up where tracing every tick puts them, and the cost of each is reported. Run with
+//   Automation RunTests Tempo.Movement.GroundSnap
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoGroundSnapTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	// The heightfield: a square of static 1 m columns, their tops following gentle hills.
+	constexpr int32 NumColumnsPerSide = 40;
+	constexpr double ColumnSize = 100.0;
+	// Shifts the columns off the cache's 50 cm cells, so their edges run through the middle of cells.
+	constexpr double ColumnOffset = 25.0;
+
+	double ColumnHeight(int32 ColumnX, int32 ColumnY)
+	{
+		return 200.0 * FMath::Sin(ColumnX * 0.3) * FMath::Cos(ColumnY * 0.2);
+	}
+
+	// A test world with the heightfield.
+	struct FGroundSnapTestFixture : FTempoTestWorld
+	{
+		UGroundSnapCacheSubsystem* GroundCache = nullptr;
+
+		FGroundSnapTestFixture()
+		{
+			GroundCache = World->GetSubsystem<UGroundSnapCacheSubsystem>();
+
+			for (int32 ColumnX = 0; ColumnX < NumColumnsPerSide; ++ColumnX)
+			{
+				for (int32 ColumnY = 0; ColumnY < NumColumnsPerSide; ++ColumnY)
+				{
+					AActor* Column = World->SpawnActor<AActor>();
+					UBoxComponent* Box = NewObject<UBoxComponent>(Column);
+					Box->SetBoxExtent(FVector(ColumnSize / 2.0, ColumnSize / 2.0, 500.0));
+					Box->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+					Box->SetMobility(EComponentMobility::Static);
+					Box->SetRelativeLocation(FVector((ColumnX + 0.5) * ColumnSize + ColumnOffset, (ColumnY + 0.5) * ColumnSize + ColumnOffset, ColumnHeight(ColumnX, ColumnY) - 500.0));
+					Column->SetRootComponent(Box);
+					Box->RegisterComponent();
+				}
+			}
+		}
+
+		// An agent at Location (above the heightfield) with a 1 m square ground snap component.
+		UGroundSnapComponent* SpawnAgent(const FVector2D& Location, float ResnapDistance, float ResnapAngle, bool bUseGroundCache) const
+		{
+			AActor* Agent = World->SpawnActor<AActor>();
+			USceneComponent* Root = NewObject<USceneComponent>(Agent);
+			Agent->SetRootComponent(Root);
+			Root->RegisterComponent();
+			Agent->SetActorLocation(FVector(Location, 500.0));
+			UGroundSnapComponent* GroundSnap = NewObject<UGroundSnapComponent>(Agent);
+			GroundSnap->SetExtentsOverride(FVector2D(50.0, 50.0));
+			GroundSnap->SetResnapThresholds(ResnapDistance, ResnapAngle);
+			GroundSnap->SetUseGroundCache(bUseGroundCache);
+			GroundSnap->RegisterComponent();
+			return GroundSnap;
+		}
+	};
+
+	struct FGroundSnapRun
+	{
+		TArray<UGroundSnapComponent*> Agents;
+		double Time = 0.0;
+		FGroundSnapStats Stats;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoGroundSnapTest,
+	"Tempo.Movement.GroundSnap.Agents", TempoGroundSnapTestFlags)
+bool FTempoGroundSnapTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumAgents = 1000;
+	constexpr int32 NumSteps = 30;
+	constexpr float DeltaTime = 1.0f / 30.0f;
+
+	const FGroundSnapTestFixture Fixture;
+	if (!TestNotNull(TEXT("Game worlds have a ground snap cache subsystem"), Fixture.GroundCache))
+	{
+		return false;
+	}
+
+	// The same agents three times over: tracing every tick, tracing once they have moved, and tracing once they have
+	// moved where the cache has no ground yet. Agents don't collide, so the three don't see each other.
+	constexpr int32 NumRuns = 3;
+	FGroundSnapRun Runs[NumRuns];
+	const FRandomStream Random(12345);
+	const double FieldSize = NumColumnsPerSide * ColumnSize;
+	for (int32 AgentIndex = 0; AgentIndex < NumAgents; ++AgentIndex)
+	{
+		const FVector2D Location(Random.FRandRange(200.0, FieldSize / 2.0), Random.FRandRange(200.0, FieldSize - 200.0));
+		Runs[0].Agents.Add(Fixture.SpawnAgent(Location, 0.0f, 0.0f, false));
+		Runs[1].Agents.Add(Fixture.SpawnAgent(Location, 1.0f, 0.5f, false));
+		Runs[2].Agents.Add(Fixture.SpawnAgent(Location, 1.0f, 0.5f, true));
+	}
+
+	for (FGroundSnapRun& Run : Runs)
+	{
+		Fixture.GroundCache->ResetStats();
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Step = 0; Step < NumSteps; ++Step)
+		{
+			for (int32 AgentIndex = 0; AgentIndex < NumAgents; ++AgentIndex)
+			{
+				UGroundSnapComponent* GroundSnap = Run.Agents[AgentIndex];
+				// Odd agents walk (about 1 m/s) and turn. Even agents stand still.
+				if (AgentIndex % 2 == 1)
+				{
+					AActor* Agent = GroundSnap->GetOwner();
+					Agent->SetActorLocationAndRotation(Agent->GetActorLocation() + FVector(3.0, 1.0, 0.0), Agent->GetActorRotation() + FRotator(0.0, 1.0, 0.0));
+				}
+				GroundSnap->TickComponent(DeltaTime, LEVELTICK_All, nullptr);
+			}
+		}
+		Run.Time = (FPlatformTime::Seconds() - StartTime) / NumSteps;
+		Run.Stats = Fixture.GroundCache->GetStats();
+	}
+
+	for (int32 RunIndex = 1; RunIndex < NumRuns; ++RunIndex)
+	{
+		int32 NumMismatches = 0;
+		for (int32 AgentIndex = 0; AgentIndex < NumAgents; ++AgentIndex)
+		{
+			const FTransform& Expected = Runs[0].Agents[AgentIndex]->GetOwner()->GetActorTransform();
+			const FTransform& Actual = Runs[RunIndex].Agents[AgentIndex]->GetOwner()->GetActorTransform();
+			if (!Actual.Equals(Expected, 0.01) && NumMismatches++ == 0)
+			{
+				AddError(FString::Printf(TEXT("Agent %d of run %d is at %s, tracing every tick puts it at %s"), AgentIndex, RunIndex,
+					*Actual.ToString(), *Expected.ToString()));
+			}
+		}
+		TestEqual(FString::Printf(TEXT("Run %d puts every agent where tracing every tick does"), RunIndex), NumMismatches, 0);
+	}
+
+	TestEqual(TEXT("Tracing every tick never skips"), Runs[0].Stats.NumSkippedSnaps, 0);
+	TestEqual(TEXT("Stationary agents only trace on their first tick"), Runs[1].Stats.NumSkippedSnaps, NumAgents / 2 * (NumSteps - 1));
+	TestEqual(TEXT("Skipped agents don't trace"), Runs[1].Stats.NumTraces, Runs[1].Stats.NumSnaps * 4);
+	TestTrue(TEXT("The cache stands in for traces"), Runs[2].Stats.NumCacheHits > 0 && Runs[2].Stats.NumTraces < Runs[1].Stats.NumTraces);
+
+	const TCHAR* RunNames[NumRuns] = { TEXT("every tick"), TEXT("motion-aware"), TEXT("motion-aware with cache") };
+	for (int32 RunIndex = 0; RunIndex < NumRuns; ++RunIndex)
+	{
+		const FGroundSnapStats& Stats = Runs[RunIndex].Stats;
+		AddInfo(FString::Printf(TEXT("%d agents, %s: %.3f ms per frame, %d snaps, %d skipped, %d traces, %d cache hits"), NumAgents,
+			RunNames[RunIndex], Runs[RunIndex].Time * 1000.0, Stats.NumSnaps, Stats.NumSkippedSnaps, Stats.NumTraces, Stats.NumCacheHits));
+	}
+	AddInfo(FString::Printf(TEXT("%d cached ground cells"), Fixture.GroundCache->NumCachedCells()));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
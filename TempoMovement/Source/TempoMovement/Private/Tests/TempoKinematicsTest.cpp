@@ -2,6 +2,7 @@
 
 #include "KinematicBicycleModelMovementComponent.h"
 #include "KinematicUnicycleModelMovementComponent.h"
+#include "KinematicVehicleBatchSubsystem.h"
 
 #include "TempoCoreTypes.h"
 
@@ -9,6 +10,7 @@
 #include "Engine/Engine.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
 #include "Misc/AutomationTest.h"
 
 // Unit tests for the kinematic motion models in TempoMovement (bicycle and unicycle).
@@ -20,6 +22,9 @@
 //   * SimulateMotion (the forward model) reads GetOwner()->GetActorRotation(), so those tests build a
 //     throwaway world, spawn an actor at a known heading, and create the component via NewObject with
 //     the actor as outer (so GetOwner() resolves). See FKinematicTestFixture below.
+//   * UKinematicVehicleBatchSubsystem must step vehicles exactly as their own ticks would, so that test
+//     drives pairs of identical pawns (one ticked directly, one batched) with the same inputs and
+//     compares them bit for bit.
 //
 // Both run headlessly under -nullrhi via:
 //   Scripts/Test.sh Tempo.Movement
@@ -72,6 +77,21 @@ namespace
 			return NewObject<ComponentType>(Actor);
 		}
 
+		// A pawn with a registered vehicle component, so that movement input reaches the component and it
+		// moves the pawn.
+		template <typename ComponentType>
+		ComponentType* MakePawnVehicle(const FVector& Location, const FRotator& Rotation) const
+		{
+			APawn* Pawn = World->SpawnActor<APawn>();
+			USceneComponent* Root = NewObject<USceneComponent>(Pawn);
+			Pawn->SetRootComponent(Root);
+			Root->RegisterComponent();
+			Pawn->SetActorLocationAndRotation(Location, Rotation);
+			ComponentType* Vehicle = NewObject<ComponentType>(Pawn);
+			Vehicle->RegisterComponent();
+			return Vehicle;
+		}
+
 		~FKinematicTestFixture()
 		{
 			if (World)
@@ -318,4 +338,84 @@ bool FTempoKinematicsBicycleRoundTripTest::RunTest(const FString& Parameters)
 	return true;
 }
 
+//
+// Batch integration: UKinematicVehicleBatchSubsystem matches the per-component tick bit for bit.
+//
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoKinematicsBatchTest,
+	"Tempo.Movement.Kinematics.Batch", TempoKinematicsTestFlags)
+bool FTempoKinematicsBatchTest::RunTest(const FString& Parameters)
+{
+	const FKinematicTestFixture Fixture(0.0);
+	UKinematicVehicleBatchSubsystem* Batch = Fixture.World->GetSubsystem<UKinematicVehicleBatchSubsystem>();
+	if (!TestNotNull(TEXT("Game worlds have a kinematic vehicle batch subsystem"), Batch))
+	{
+		return false;
+	}
+
+	// Pairs of identical vehicles, alternating bicycles and unicycles at assorted headings: one of each pair ticks
+	// itself, the other is batched. Enough of them that the batch steps in parallel.
+	constexpr int32 NumPairs = 100;
+	TArray<UKinematicVehicleMovementComponent*> Ticked;
+	TArray<UKinematicVehicleMovementComponent*> Batched;
+	for (int32 PairIndex = 0; PairIndex < NumPairs; ++PairIndex)
+	{
+		const FVector Location(1000.0 * PairIndex, 0.0, 0.0);
+		const FRotator Rotation(0.0, 37.0 * PairIndex, 0.0);
+		for (TArray<UKinematicVehicleMovementComponent*>* Vehicles : { &Ticked, &Batched })
+		{
+			Vehicles->Add(PairIndex % 2 == 0 ?
+				static_cast<UKinematicVehicleMovementComponent*>(Fixture.MakePawnVehicle<UKinematicBicycleModelMovementComponent>(Location, Rotation)) :
+				static_cast<UKinematicVehicleMovementComponent*>(Fixture.MakePawnVehicle<UKinematicUnicycleModelMovementComponent>(Location, Rotation)));
+		}
+		TestTrue(TEXT("The built-in models can be batched"), Batch->RegisterVehicle(Batched.Last()));
+	}
+	TestEqual(TEXT("Every batched vehicle is registered"), Batch->NumVehicles(), NumPairs);
+
+	// Accelerate, brake, and steer both ways, in the vehicles' frames, with the same input for both of a pair.
+	constexpr float DeltaTime = 1.0f / 30.0f;
+	for (int32 Step = 0; Step < 150; ++Step)
+	{
+		for (int32 PairIndex = 0; PairIndex < NumPairs; ++PairIndex)
+		{
+			const FVector BodyInput(FMath::Sin(0.05 * Step + PairIndex), FMath::Cos(0.07 * Step * (PairIndex + 1)), 0.0);
+			for (const UKinematicVehicleMovementComponent* Vehicle : { Ticked[PairIndex], Batched[PairIndex] })
+			{
+				APawn* Pawn = CastChecked<APawn>(Vehicle->GetOwner());
+				Pawn->AddMovementInput(Pawn->GetActorRotation().RotateVector(BodyInput));
+			}
+			Ticked[PairIndex]->TickComponent(DeltaTime, LEVELTICK_All, nullptr);
+		}
+		Batch->StepVehicles(DeltaTime);
+	}
+
+	int32 NumMismatches = 0;
+	double MaxDistanceTravelled = 0.0;
+	for (int32 PairIndex = 0; PairIndex < NumPairs; ++PairIndex)
+	{
+		const AActor* TickedOwner = Ticked[PairIndex]->GetOwner();
+		const AActor* BatchedOwner = Batched[PairIndex]->GetOwner();
+		const bool bIdentical = TickedOwner->GetActorLocation() == BatchedOwner->GetActorLocation() &&
+			TickedOwner->GetActorRotation() == BatchedOwner->GetActorRotation() &&
+			Ticked[PairIndex]->GetLinearVelocity() == Batched[PairIndex]->GetLinearVelocity() &&
+			Ticked[PairIndex]->GetAngularVelocity() == Batched[PairIndex]->GetAngularVelocity() &&
+			Ticked[PairIndex]->Velocity == Batched[PairIndex]->Velocity;
+		if (!bIdentical && NumMismatches++ == 0)
+		{
+			AddError(FString::Printf(TEXT("Vehicle %d differs: ticked at %s %s, batched at %s %s"), PairIndex,
+				*TickedOwner->GetActorLocation().ToString(), *TickedOwner->GetActorRotation().ToString(),
+				*BatchedOwner->GetActorLocation().ToString(), *BatchedOwner->GetActorRotation().ToString()));
+		}
+		MaxDistanceTravelled = FMath::Max(MaxDistanceTravelled, FVector::Distance(TickedOwner->GetActorLocation(), FVector(1000.0 * PairIndex, 0.0, 0.0)));
+	}
+	TestEqual(TEXT("Batched vehicles move exactly as ticked ones do"), NumMismatches, 0);
+	TestTrue(TEXT("The vehicles actually moved"), MaxDistanceTravelled > 100.0);
+
+	TestTrue(TEXT("Registered vehicles can be unregistered"), Batch->UnregisterVehicle(Batched[0]));
+	TestEqual(TEXT("Unregistered vehicles leave the batch"), Batch->NumVehicles(), NumPairs - 1);
+	TestFalse(TEXT("Vehicles are only unregistered once"), Batch->UnregisterVehicle(Batched[0]));
+
+	return true;
+}
+
 #endif // WITH_DEV_AUTOMATION_TESTS
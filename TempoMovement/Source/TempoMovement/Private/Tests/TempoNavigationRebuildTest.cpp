@@ -0,0 +1,127 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "NavigationDirtyRegionTracker.h"
+#include "TempoMovementControlServiceSubsystem.h"
+#include "TempoTestWorld.h"
+
+#include "TempoMovement/MovementControlService.grpc.pb.h"
+
+#include "Components/BoxComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+
+// Tests for RebuildNavigation's dirty-region tracking and its handling of worlds without a dynamic navmesh.
+// Building tiles needs a level with a navmesh, so that is not covered here. Run with
+//   Automation RunTests Tempo.Movement.NavigationRebuild
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoNavigationRebuildTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	struct FNavigationRebuildTestFixture : FTempoTestWorld
+	{
+		// A 1 m cube that affects navigation (or doesn't) at Location.
+		AActor* SpawnObstacle(const FVector& Location, bool bAffectsNavigation = true) const
+		{
+			AActor* Actor = World->SpawnActor<AActor>();
+			UBoxComponent* Box = NewObject<UBoxComponent>(Actor);
+			Box->SetBoxExtent(FVector(50.0));
+			Box->SetCanEverAffectNavigation(bAffectsNavigation);
+			Box->bDynamicObstacle = true;
+			Actor->SetRootComponent(Box);
+			Box->RegisterComponent();
+			Actor->SetActorLocation(Location);
+			return Actor;
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoNavigationRebuildDirtyRegionsTest,
+	"Tempo.Movement.NavigationRebuild.DirtyRegions", TempoNavigationRebuildTestFlags)
+bool FTempoNavigationRebuildDirtyRegionsTest::RunTest(const FString& Parameters)
+{
+	const FNavigationRebuildTestFixture Fixture;
+	AActor* Moved = Fixture.SpawnObstacle(FVector(0.0, 0.0, 0.0));
+	AActor* Destroyed = Fixture.SpawnObstacle(FVector(0.0, 1000.0, 0.0));
+	AActor* Ignored = Fixture.SpawnObstacle(FVector(0.0, 2000.0, 0.0), /*bAffectsNavigation=*/false);
+
+	FNavigationDirtyRegionTracker Tracker;
+	Tracker.Reset(Fixture.World);
+	TestEqual(TEXT("Only Actors that affect navigation are tracked"), Tracker.NumTrackedActors(), 2);
+	TestEqual(TEXT("Nothing is dirty right after a reset"), Tracker.CollectDirtyRegions(Fixture.World).Num(), 0);
+
+	Moved->SetActorLocation(FVector(500.0, 0.0, 0.0));
+	const TArray<FBox> MovedRegions = Tracker.CollectDirtyRegions(Fixture.World);
+	if (TestEqual(TEXT("A moved Actor dirties where it was and where it is"), MovedRegions.Num(), 2))
+	{
+		TestTrue(TEXT("Where it was"), MovedRegions[0].GetCenter().Equals(FVector(0.0, 0.0, 0.0)));
+		TestTrue(TEXT("Where it is"), MovedRegions[1].GetCenter().Equals(FVector(500.0, 0.0, 0.0)));
+	}
+	TestEqual(TEXT("Collecting makes the current state the baseline"), Tracker.CollectDirtyRegions(Fixture.World).Num(), 0);
+
+	Moved->SetActorLocation(FVector(500.5, 0.0, 0.0));
+	TestEqual(TEXT("Tiny moves are ignored"), Tracker.CollectDirtyRegions(Fixture.World).Num(), 0);
+
+	Ignored->SetActorLocation(FVector(500.0, 2000.0, 0.0));
+	TestEqual(TEXT("Actors that don't affect navigation never dirty it"), Tracker.CollectDirtyRegions(Fixture.World).Num(), 0);
+
+	Fixture.SpawnObstacle(FVector(0.0, 3000.0, 0.0));
+	Destroyed->Destroy();
+	const TArray<FBox> ChurnRegions = Tracker.CollectDirtyRegions(Fixture.World);
+	if (TestEqual(TEXT("A spawned and a destroyed Actor each dirty one region"), ChurnRegions.Num(), 2))
+	{
+		TestTrue(TEXT("The spawned Actor's bounds are dirty"), ChurnRegions.ContainsByPredicate([](const FBox& Region) { return Region.GetCenter().Equals(FVector(0.0, 3000.0, 0.0)); }));
+		TestTrue(TEXT("The destroyed Actor's last bounds are dirty"), ChurnRegions.ContainsByPredicate([](const FBox& Region) { return Region.GetCenter().Equals(FVector(0.0, 1000.0, 0.0)); }));
+	}
+	TestEqual(TEXT("Destroyed Actors stop being tracked"), Tracker.NumTrackedActors(), 2);
+
+	// Rebuilding some regions only clears the changes within them.
+	AActor* Outside = Fixture.SpawnObstacle(FVector(0.0, 5000.0, 0.0));
+	Moved->SetActorLocation(FVector(1000.0, 0.0, 0.0));
+	Tracker.MarkRegionsRebuilt(Fixture.World, { FBox(FVector(0.0, -100.0, -100.0), FVector(1100.0, 100.0, 100.0)) });
+	const TArray<FBox> RemainingRegions = Tracker.CollectDirtyRegions(Fixture.World);
+	if (TestEqual(TEXT("Changes outside the rebuilt regions stay dirty"), RemainingRegions.Num(), 1))
+	{
+		TestTrue(TEXT("The Actor spawned outside them is dirty"), RemainingRegions[0].GetCenter().Equals(Outside->GetActorLocation()));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoNavigationRebuildPreconditionTest,
+	"Tempo.Movement.NavigationRebuild.Precondition", TempoNavigationRebuildTestFlags)
+bool FTempoNavigationRebuildPreconditionTest::RunTest(const FString& Parameters)
+{
+	const FNavigationRebuildTestFixture Fixture;
+	UTempoMovementControlServiceSubsystem* MovementControl = Fixture.World->GetSubsystem<UTempoMovementControlServiceSubsystem>();
+	if (!TestNotNull(TEXT("Game worlds have a movement control service"), MovementControl))
+	{
+		return false;
+	}
+
+	// A full rebuild, and incremental ones with and without waiting.
+	for (const TPair<bool, bool> Mode : { TPair<bool, bool>(false, false), TPair<bool, bool>(true, false), TPair<bool, bool>(true, true) })
+	{
+		TempoMovement::RebuildNavigationRequest Request;
+		Request.set_incremental(Mode.Key);
+		Request.set_wait(Mode.Value);
+		bool bResponded = false;
+		grpc::StatusCode Code = grpc::OK;
+		MovementControl->RebuildNavigation(Request, TResponseDelegate<TempoMovement::RebuildNavigationResponse>::CreateLambda(
+			[&bResponded, &Code](const TempoMovement::RebuildNavigationResponse&, grpc::Status Status)
+			{
+				bResponded = true;
+				Code = Status.error_code();
+			}));
+		TestTrue(TEXT("Worlds without a dynamic navmesh respond right away"), bResponded);
+		TestEqual(TEXT("Worlds without a dynamic navmesh can't be rebuilt"), static_cast<int32>(Code), static_cast<int32>(grpc::FAILED_PRECONDITION));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
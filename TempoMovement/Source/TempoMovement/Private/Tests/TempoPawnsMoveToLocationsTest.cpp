@@ -0,0 +1,172 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoMovementControlServiceSubsystem.h"
+
+#include "TempoMovement/MovementControlService.grpc.pb.h"
+
+#include "TempoCoreUtils.h"
+#include "TempoTestWorld.h"
+
+#include "AIController.h"
+#include "Engine/World.h"
+#include "GameFramework/DefaultPawn.h"
+#include "Misc/AutomationTest.h"
+
+// Tests for PawnsMoveToLocations: one completion per move on one stream, the last finishing it, and the path
+// query budgets. The test world has no navmesh, so every path query fails. Run with
+//   Automation RunTests Tempo.Movement.PawnsMoveToLocations
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoPawnsMoveToLocationsTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	struct FPawnsMoveToLocationsTestFixture : FTempoTestWorld
+	{
+		UTempoMovementControlServiceSubsystem* MovementControl = nullptr;
+
+		FPawnsMoveToLocationsTestFixture()
+		{
+			MovementControl = World->GetSubsystem<UTempoMovementControlServiceSubsystem>();
+		}
+
+		// Returns the new pawn's name.
+		FString SpawnAIPawn() const
+		{
+			ADefaultPawn* Pawn = World->SpawnActor<ADefaultPawn>();
+			Pawn->AIControllerClass = AAIController::StaticClass();
+			Pawn->SpawnDefaultController();
+			return UTempoCoreUtils::GetActorIdentifier(Pawn);
+		}
+	};
+
+	struct FCompletionStream
+	{
+		TArray<TempoMovement::PawnMoveCompletion> Received;
+		TArray<grpc::StatusCode> Statuses;
+		// The index of the response that finished the stream, if one did.
+		int32 LastResponseIndex = INDEX_NONE;
+		TResponseDelegate<TempoMovement::PawnMoveCompletion> Continuation;
+
+		FCompletionStream()
+		{
+			Continuation = TResponseDelegate<TempoMovement::PawnMoveCompletion>::CreateLambda([this](const TempoMovement::PawnMoveCompletion& Response, FTempoResponseStatus Status)
+			{
+				if (Status.bLastResponse && LastResponseIndex == INDEX_NONE)
+				{
+					LastResponseIndex = Received.Num();
+				}
+				Received.Add(Response);
+				Statuses.Add(Status.error_code());
+			});
+		}
+
+		FCompletionStream(const FCompletionStream&) = delete;
+		FCompletionStream& operator=(const FCompletionStream&) = delete;
+	};
+
+	TempoMovement::PawnsMoveToLocationsRequest MakeRequest(const FPawnsMoveToLocationsTestFixture& Fixture, int32 NumMoves)
+	{
+		TempoMovement::PawnsMoveToLocationsRequest Request;
+		for (int32 MoveIndex = 0; MoveIndex < NumMoves; ++MoveIndex)
+		{
+			TempoMovement::PawnMoveToLocationRequest* Move = Request.add_moves();
+			Move->set_pawn(TCHAR_TO_UTF8(*Fixture.SpawnAIPawn()));
+			Move->mutable_location()->set_x(10.0);
+			Move->set_relative(true);
+		}
+		return Request;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoPawnsMoveToLocationsBudgetTest,
+	"Tempo.Movement.PawnsMoveToLocations.Budget", TempoPawnsMoveToLocationsTestFlags)
+bool FTempoPawnsMoveToLocationsBudgetTest::RunTest(const FString& Parameters)
+{
+	const FPawnsMoveToLocationsTestFixture Fixture;
+	if (!TestNotNull(TEXT("Game worlds have a movement control service"), Fixture.MovementControl))
+	{
+		return false;
+	}
+
+	// Five pawns, plus one that doesn't exist, two path queries per frame.
+	TempoMovement::PawnsMoveToLocationsRequest Request;
+	Request.set_max_path_queries_per_frame(2);
+	for (int32 MoveIndex = 0; MoveIndex < 6; ++MoveIndex)
+	{
+		TempoMovement::PawnMoveToLocationRequest* Move = Request.add_moves();
+		Move->set_pawn(MoveIndex == 2 ? "NoSuchPawn" : TCHAR_TO_UTF8(*Fixture.SpawnAIPawn()));
+		Move->mutable_location()->set_x(10.0);
+		Move->set_relative(true);
+	}
+
+	FCompletionStream Stream;
+	Fixture.MovementControl->PawnsMoveToLocations(Request, Stream.Continuation);
+	if (!TestEqual(TEXT("Missing pawns complete right away"), Stream.Received.Num(), 1))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Completions name their move"), Stream.Received[0].move_index(), 2);
+	TestEqual(TEXT("Missing pawns can't move"), static_cast<int32>(Stream.Received[0].result()), static_cast<int32>(TempoMovement::MTR_INVALID));
+	TestFalse(TEXT("Moves that can't start say why"), Stream.Received[0].error().empty());
+
+	Fixture.MovementControl->Tick(0.0f);
+	TestEqual(TEXT("Each frame starts at most the budgeted number of path queries"), Stream.Received.Num(), 3);
+	Fixture.MovementControl->Tick(0.0f);
+	TestEqual(TEXT("The next frame starts the next ones"), Stream.Received.Num(), 5);
+	Fixture.MovementControl->Tick(0.0f);
+	TestEqual(TEXT("Every move completes once"), Stream.Received.Num(), 6);
+
+	TSet<int32> MoveIndices;
+	for (const TempoMovement::PawnMoveCompletion& Completion : Stream.Received)
+	{
+		MoveIndices.Add(Completion.move_index());
+	}
+	TestEqual(TEXT("Every move index is reported"), MoveIndices.Num(), 6);
+	TestFalse(TEXT("The stream isn't finished with an error"), Stream.Statuses.ContainsByPredicate([](grpc::StatusCode Code) { return Code != grpc::OK; }));
+	TestEqual(TEXT("The last completion finishes the stream"), Stream.LastResponseIndex, 5);
+
+	FCompletionStream EmptyStream;
+	Fixture.MovementControl->PawnsMoveToLocations(TempoMovement::PawnsMoveToLocationsRequest(), EmptyStream.Continuation);
+	if (TestEqual(TEXT("Empty requests are answered"), EmptyStream.Statuses.Num(), 1))
+	{
+		TestEqual(TEXT("Empty requests are rejected"), static_cast<int32>(EmptyStream.Statuses[0]), static_cast<int32>(grpc::FAILED_PRECONDITION));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoPawnsMoveToLocationsSharedBudgetTest,
+	"Tempo.Movement.PawnsMoveToLocations.SharedBudget", TempoPawnsMoveToLocationsTestFlags)
+bool FTempoPawnsMoveToLocationsSharedBudgetTest::RunTest(const FString& Parameters)
+{
+	const FPawnsMoveToLocationsTestFixture Fixture;
+	if (!TestNotNull(TEXT("Game worlds have a movement control service"), Fixture.MovementControl))
+	{
+		return false;
+	}
+
+	// Two streams, each with more moves than half the shared budget.
+	constexpr int32 MaxPathQueriesPerFrame = UTempoMovementControlServiceSubsystem::MaxPathQueriesPerFrame;
+	const int32 NumMovesPerStream = MaxPathQueriesPerFrame * 3 / 4;
+	FCompletionStream Streams[2];
+	for (FCompletionStream& Stream : Streams)
+	{
+		Fixture.MovementControl->PawnsMoveToLocations(MakeRequest(Fixture, NumMovesPerStream), Stream.Continuation);
+	}
+
+	Fixture.MovementControl->Tick(0.0f);
+	TestEqual(TEXT("Every stream shares one per-frame budget"), Streams[0].Received.Num() + Streams[1].Received.Num(), MaxPathQueriesPerFrame);
+	Fixture.MovementControl->Tick(0.0f);
+	TestEqual(TEXT("The next frame starts the rest"), Streams[0].Received.Num() + Streams[1].Received.Num(), NumMovesPerStream * 2);
+	for (const FCompletionStream& Stream : Streams)
+	{
+		TestEqual(TEXT("Each stream is finished by its last completion"), Stream.LastResponseIndex, NumMovesPerStream - 1);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,195 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "SplineActor.h"
+#include "TempoMovementControlServiceSubsystem.h"
+#include "TrajectoryFollowingController.h"
+
+#include "TempoMovement/MovementControlService.grpc.pb.h"
+
+#include "TempoCoreUtils.h"
+#include "TempoTestWorld.h"
+#include "TempoCore/Empty.pb.h"
+
+#include "Components/SplineComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/DefaultPawn.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+// Tests for SetSplinePointsBatch: in-place updates, unchanged splines left alone, per-entry errors, and a
+// benchmark of republishing 200 paths one at a time against one batch. Run with
+//   Automation RunTests Tempo.Movement.SplinePointsBatch
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoSplinePointsBatchTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	// A test world with NumSplines splines.
+	struct FSplinePointsBatchTestFixture : FTempoTestWorld
+	{
+		UTempoMovementControlServiceSubsystem* MovementControl = nullptr;
+		TArray<ASplineActor*> Splines;
+
+		explicit FSplinePointsBatchTestFixture(int32 NumSplines)
+		{
+			MovementControl = World->GetSubsystem<UTempoMovementControlServiceSubsystem>();
+			for (int32 SplineIndex = 0; SplineIndex < NumSplines; ++SplineIndex)
+			{
+				Splines.Add(World->SpawnActor<ASplineActor>());
+			}
+		}
+
+		TempoMovement::SetSplinePointsBatchResponse SetSplinePointsBatch(const TempoMovement::SetSplinePointsBatchRequest& Request) const
+		{
+			TempoMovement::SetSplinePointsBatchResponse Received;
+			MovementControl->SetSplinePointsBatch(Request, TResponseDelegate<TempoMovement::SetSplinePointsBatchResponse>::CreateLambda(
+				[&Received](const TempoMovement::SetSplinePointsBatchResponse& Response, grpc::Status Status)
+				{
+					Received = Response;
+				}));
+			return Received;
+		}
+	};
+
+	// A straight path of NumPoints points, Spacing meters apart along X, with tangents along X.
+	void AddPath(TempoMovement::SetSplinePointsBatchRequest& Request, const ASplineActor* Spline, int32 NumPoints, double Spacing)
+	{
+		TempoMovement::SplineGeometry* Geometry = Request.add_splines();
+		Geometry->set_spline(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(Spline)));
+		for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+		{
+			Geometry->add_locations(PointIndex * Spacing);
+			Geometry->add_locations(0.0);
+			Geometry->add_locations(0.0);
+			Geometry->add_tangents(1.0);
+			Geometry->add_tangents(0.0);
+			Geometry->add_tangents(0.0);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoSplinePointsBatchTest,
+	"Tempo.Movement.SplinePointsBatch.InPlace", TempoSplinePointsBatchTestFlags)
+bool FTempoSplinePointsBatchTest::RunTest(const FString& Parameters)
+{
+	const FSplinePointsBatchTestFixture Fixture(3);
+	if (!TestNotNull(TEXT("Game worlds have a movement control service"), Fixture.MovementControl))
+	{
+		return false;
+	}
+	ASplineActor* First = Fixture.Splines[0];
+	ASplineActor* Second = Fixture.Splines[1];
+	ASplineActor* Third = Fixture.Splines[2];
+
+	TempoMovement::SetSplinePointsBatchRequest Request;
+	AddPath(Request, First, 5, 1.0);
+	AddPath(Request, Second, 5, 1.0);
+	AddPath(Request, Third, 5, 1.0);
+	TempoMovement::SetSplinePointsBatchResponse Response = Fixture.SetSplinePointsBatch(Request);
+	TestEqual(TEXT("New point counts rebuild the splines"), Response.num_rebuilt(), 3);
+	TestEqual(TEXT("Points are converted to centimeters"), First->GetSpline()->GetLocationAtSplinePoint(4, ESplineCoordinateSpace::World), FVector(400.0, 0.0, 0.0));
+
+	// A pawn following the second spline.
+	ATrajectoryFollowingController* Follower = Fixture.World->SpawnActor<ATrajectoryFollowingController>();
+	FTrajectoryFollowingConfig Config;
+	Config.Speed = 100.0;
+	Follower->FollowTrajectory(Second, Fixture.World->SpawnActor<ADefaultPawn>(), Config);
+
+	// The same paths again, except the second's points are spread 2 m apart, the third has too few points, and a
+	// spline that doesn't exist is added.
+	const uint32 FirstVersion = First->GetGeometryVersion();
+	const uint32 SecondVersion = Second->GetGeometryVersion();
+	Request.Clear();
+	AddPath(Request, First, 5, 1.0);
+	AddPath(Request, Second, 5, 2.0);
+	AddPath(Request, Third, 1, 1.0);
+	Request.add_splines()->set_spline("NoSuchSpline");
+	Response = Fixture.SetSplinePointsBatch(Request);
+	TestEqual(TEXT("Unchanged splines are left alone"), Response.num_unchanged(), 1);
+	TestEqual(TEXT("Splines with as many points are updated in place"), Response.num_updated_in_place(), 1);
+	TestEqual(TEXT("Nothing is rebuilt"), Response.num_rebuilt(), 0);
+	TestEqual(TEXT("Bad entries are reported"), Response.errors_size(), 2);
+	TestEqual(TEXT("Unchanged splines keep their geometry version"), First->GetGeometryVersion(), FirstVersion);
+	TestNotEqual(TEXT("Changed splines get a new geometry version"), Second->GetGeometryVersion(), SecondVersion);
+	TestEqual(TEXT("Points are moved in place"), Second->GetSpline()->GetLocationAtSplinePoint(2, ESplineCoordinateSpace::World), FVector(400.0, 0.0, 0.0));
+	TestEqual(TEXT("Rejected entries leave their spline alone"), Third->GetSpline()->GetNumberOfSplinePoints(), 5);
+
+	// The follower measures distance along the stretched spline from its next tick.
+	Follower->Tick(0.0f);
+	TestTrue(TEXT("Followers pick up changed splines"), Follower->GetTransformAtTime(1.0f).GetLocation().Equals(FVector(100.0, 0.0, 0.0), 0.5));
+
+	// So do they when the spline component is edited directly, as the editor does, rather than through SetSplinePoints.
+	const uint32 SetVersion = Second->GetGeometryVersion();
+	USplineComponent* SecondSpline = Second->GetSpline();
+	for (int32 PointIndex = 0; PointIndex < SecondSpline->GetNumberOfSplinePoints(); ++PointIndex)
+	{
+		SecondSpline->SetLocationAtSplinePoint(PointIndex, FVector(PointIndex * 300.0, 0.0, 0.0), ESplineCoordinateSpace::World, false);
+	}
+	SecondSpline->UpdateSpline();
+	TestNotEqual(TEXT("Updating the spline component gives it a new geometry version"), Second->GetGeometryVersion(), SetVersion);
+	Follower->Tick(0.0f);
+	TestTrue(TEXT("Followers pick up directly edited splines"), Follower->GetTransformAtTime(1.0f).GetLocation().Equals(FVector(100.0, 0.0, 0.0), 0.5));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoSplinePointsBatchBenchmarkTest,
+	"Tempo.Movement.SplinePointsBatch.Benchmark", TempoSplinePointsBatchTestFlags)
+bool FTempoSplinePointsBatchBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumSplines = 200;
+	constexpr int32 NumPoints = 20;
+
+	const FSplinePointsBatchTestFixture Fixture(NumSplines);
+	if (!TestNotNull(TEXT("Game worlds have a movement control service"), Fixture.MovementControl))
+	{
+		return false;
+	}
+
+	// One republish of every path, one SetSplinePoints per spline.
+	TArray<TempoMovement::SetSplinePointsRequest> Requests;
+	for (const ASplineActor* Spline : Fixture.Splines)
+	{
+		TempoMovement::SetSplinePointsRequest& Request = Requests.AddDefaulted_GetRef();
+		Request.set_spline(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(Spline)));
+		for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+		{
+			TempoMovement::SplinePoint* Point = Request.add_points();
+			Point->mutable_location()->set_x(PointIndex);
+			Point->mutable_tangent()->set_x(1.0);
+		}
+	}
+	const TResponseDelegate<TempoCore::Empty> IgnoreResponse = TResponseDelegate<TempoCore::Empty>::CreateLambda([](const TempoCore::Empty&, grpc::Status) {});
+	double StartTime = FPlatformTime::Seconds();
+	for (const TempoMovement::SetSplinePointsRequest& Request : Requests)
+	{
+		Fixture.MovementControl->SetSplinePoints(Request, IgnoreResponse);
+	}
+	const double SingleTime = FPlatformTime::Seconds() - StartTime;
+
+	// The same paths with their points spread 2 m apart, as one batch.
+	TempoMovement::SetSplinePointsBatchRequest Batch;
+	for (const ASplineActor* Spline : Fixture.Splines)
+	{
+		AddPath(Batch, Spline, NumPoints, 2.0);
+	}
+	StartTime = FPlatformTime::Seconds();
+	const TempoMovement::SetSplinePointsBatchResponse Moved = Fixture.SetSplinePointsBatch(Batch);
+	const double MovedTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	const TempoMovement::SetSplinePointsBatchResponse Unchanged = Fixture.SetSplinePointsBatch(Batch);
+	const double UnchangedTime = FPlatformTime::Seconds() - StartTime;
+
+	TestEqual(TEXT("Every spline is updated in place"), Moved.num_updated_in_place(), NumSplines);
+	TestEqual(TEXT("Every spline is then unchanged"), Unchanged.num_unchanged(), NumSplines);
+	AddInfo(FString::Printf(TEXT("%d splines of %d points: one request each %.3f ms, batch (moved) %.3f ms, batch (unchanged) %.3f ms"),
+		NumSplines, NumPoints, SingleTime * 1000.0, MovedTime * 1000.0, UnchangedTime * 1000.0));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,138 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoMovementControlServiceSubsystem.h"
+#include "TempoWheeledVehicleController.h"
+
+#include "TempoMovement/MovementControlService.grpc.pb.h"
+
+#include "TempoCoreUtils.h"
+#include "TempoTestWorld.h"
+
+#include "Engine/World.h"
+#include "GameFramework/DefaultPawn.h"
+#include "Misc/AutomationTest.h"
+
+// Tests for StreamCommands: frames are held until ApplyStreamedCommands, the latest command per pawn wins, and
+// each application is acknowledged once per stream with the commands' errors. Run with
+//   Automation RunTests Tempo.Movement.StreamCommands
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoStreamCommandsTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	struct FStreamCommandsTestFixture : FTempoTestWorld
+	{
+		UTempoMovementControlServiceSubsystem* MovementControl = nullptr;
+
+		FStreamCommandsTestFixture()
+		{
+			MovementControl = World->GetSubsystem<UTempoMovementControlServiceSubsystem>();
+		}
+
+		// A pawn with a commandable controller. Returns the new pawn's name.
+		FString SpawnCommandablePawn() const
+		{
+			ADefaultPawn* Pawn = World->SpawnActor<ADefaultPawn>();
+			Pawn->AIControllerClass = ATempoWheeledVehicleController::StaticClass();
+			Pawn->SpawnDefaultController();
+			return UTempoCoreUtils::GetActorIdentifier(Pawn);
+		}
+	};
+
+	struct FAckStream
+	{
+		TArray<TempoMovement::CommandAck> Received;
+		TArray<grpc::StatusCode> Statuses;
+		TResponseDelegate<TempoMovement::CommandAck> Continuation;
+
+		FAckStream()
+		{
+			Continuation = TResponseDelegate<TempoMovement::CommandAck>::CreateLambda([this](const TempoMovement::CommandAck& Response, grpc::Status Status)
+			{
+				Received.Add(Response);
+				Statuses.Add(Status.error_code());
+			});
+		}
+
+		FAckStream(const FAckStream&) = delete;
+		FAckStream& operator=(const FAckStream&) = delete;
+	};
+
+	void AddVelocityCommand(TempoMovement::CommandFrame& Frame, const FString& Pawn, double Speed)
+	{
+		TempoMovement::VelocityCommand* Command = Frame.add_commands()->mutable_velocity();
+		Command->set_pawn(TCHAR_TO_UTF8(*Pawn));
+		Command->mutable_twist()->mutable_linear()->set_x(Speed);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoStreamCommandsTest,
+	"Tempo.Movement.StreamCommands.LatestPerPawn", TempoStreamCommandsTestFlags)
+bool FTempoStreamCommandsTest::RunTest(const FString& Parameters)
+{
+	const FStreamCommandsTestFixture Fixture;
+	if (!TestNotNull(TEXT("Game worlds have a movement control service"), Fixture.MovementControl))
+	{
+		return false;
+	}
+
+	const FString FirstPawn = Fixture.SpawnCommandablePawn();
+	const FString SecondPawn = Fixture.SpawnCommandablePawn();
+
+	// Two frames in one tick: the second replaces the first's command for FirstPawn, and adds a driving command
+	// for a pawn that doesn't exist and a command with nothing set.
+	TempoMovement::CommandFrame FirstFrame;
+	FirstFrame.set_sequence(7);
+	FirstFrame.set_client_time(1.0);
+	AddVelocityCommand(FirstFrame, FirstPawn, 1.0);
+	AddVelocityCommand(FirstFrame, SecondPawn, 2.0);
+
+	TempoMovement::CommandFrame SecondFrame;
+	SecondFrame.set_sequence(8);
+	SecondFrame.set_client_time(1.01);
+	AddVelocityCommand(SecondFrame, FirstPawn, 3.0);
+	TempoMovement::NormalizedDrivingCommand* Driving = SecondFrame.add_commands()->mutable_driving();
+	Driving->set_vehicle("NoSuchPawn");
+	Driving->set_acceleration(0.5f);
+	SecondFrame.add_commands();
+
+	FAckStream Stream;
+	Fixture.MovementControl->StreamCommands(FirstFrame, Stream.Continuation);
+	Fixture.MovementControl->StreamCommands(SecondFrame, Stream.Continuation);
+	TestEqual(TEXT("Frames are held until they're applied"), Stream.Received.Num(), 0);
+
+	const uint64 Tick = GFrameCounter;
+	Fixture.MovementControl->ApplyStreamedCommands();
+	if (!TestEqual(TEXT("Each application is acknowledged once"), Stream.Received.Num(), 1))
+	{
+		return false;
+	}
+	const TempoMovement::CommandAck& Ack = Stream.Received[0];
+	TestEqual(TEXT("Acks carry the tick they were applied in"), Ack.tick_sequence(), Tick);
+	TestEqual(TEXT("Acks carry the latest frame's sequence"), Ack.frame_sequence(), static_cast<uint64>(8));
+	TestEqual(TEXT("Acks echo the latest frame's client time"), Ack.client_time(), 1.01);
+	TestEqual(TEXT("Acks count the frames since the last tick"), Ack.num_frames(), 2);
+	TestEqual(TEXT("Only the latest command per pawn is applied"), Ack.num_applied(), 2);
+	if (TestEqual(TEXT("Commands that can't be applied are reported"), Ack.errors_size(), 2))
+	{
+		TSet<FString> ErrorPawns;
+		for (const TempoMovement::CommandError& Error : Ack.errors())
+		{
+			TestEqual(TEXT("Errors name the frame they came in"), Error.frame_sequence(), static_cast<uint64>(8));
+			TestFalse(TEXT("Errors say why"), Error.error().empty());
+			ErrorPawns.Add(UTF8_TO_TCHAR(Error.pawn().c_str()));
+		}
+		TestTrue(TEXT("Unknown pawns are reported"), ErrorPawns.Contains(TEXT("NoSuchPawn")));
+	}
+	TestFalse(TEXT("The stream isn't finished with an error"), Stream.Statuses.ContainsByPredicate([](grpc::StatusCode Code) { return Code != grpc::OK; }));
+
+	Fixture.MovementControl->ApplyStreamedCommands();
+	TestEqual(TEXT("Ticks without frames aren't acknowledged"), Stream.Received.Num(), 1);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
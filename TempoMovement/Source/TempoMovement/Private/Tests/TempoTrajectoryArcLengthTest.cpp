@@ -0,0 +1,251 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "SplineActor.h"
+#include "TrajectoryArcLengthTable.h"
+#include "TrajectoryFollowingController.h"
+
+#include "TempoTestWorld.h"
+
+#include "Algo/BinarySearch.h"
+#include "Components/SplineComponent.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+// Tests for the adaptive arc-length tables behind trajectory following: accuracy, incremental rebuilds, and a
+// benchmark of rebuild and sample cost against trajectory length. Run with
+//   Automation RunTests Tempo.Movement.TrajectoryArcLength
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoTrajectoryArcLengthTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	constexpr double ArcLengthTol = 0.1; // cm, the controller's default ArcLengthTolerance.
+
+	struct FTrajectoryArcLengthTestFixture : FTempoTestWorld
+	{
+		// A zigzag of NumPoints auto-tangent points, 10 m apart along X and alternating 10 m in Y: every point is a
+		// sharp turn.
+		ASplineActor* SpawnZigzagSpline(int32 NumPoints) const
+		{
+			ASplineActor* SplineActor = World->SpawnActor<ASplineActor>();
+			USplineComponent* Spline = SplineActor->GetSpline();
+			Spline->ClearSplinePoints(false);
+			for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+			{
+				Spline->AddSplinePoint(FVector(1000.0 * PointIndex, 1000.0 * (PointIndex % 2), 0.0), ESplineCoordinateSpace::World, false);
+			}
+			Spline->UpdateSpline();
+			return SplineActor;
+		}
+	};
+
+	// Cumulative distance at each of NumSteps + 1 evenly spaced input keys, from a polyline through the spline.
+	TArray<double> DenseSplineDistances(const USplineComponent* Spline, int32 NumSteps)
+	{
+		const double MaxKey = Spline->GetNumberOfSplinePoints() - 1;
+		TArray<double> Distances = { 0.0 };
+		FVector Previous = Spline->GetLocationAtSplineInputKey(0.0f, ESplineCoordinateSpace::Local);
+		for (int32 Step = 1; Step <= NumSteps; ++Step)
+		{
+			const FVector Location = Spline->GetLocationAtSplineInputKey(MaxKey * Step / NumSteps, ESplineCoordinateSpace::Local);
+			Distances.Add(Distances.Last() + FVector::Distance(Previous, Location));
+			Previous = Location;
+		}
+		return Distances;
+	}
+
+	// The location at Distance along the spline, by interpolating the input key in DenseSplineDistances.
+	FVector DenseLocationAtDistance(const USplineComponent* Spline, const TArray<double>& Distances, double Distance)
+	{
+		const int32 NumSteps = Distances.Num() - 1;
+		const double MaxKey = Spline->GetNumberOfSplinePoints() - 1;
+		const int32 Step = FMath::Clamp(Algo::UpperBound(Distances, Distance) - 1, 0, NumSteps - 1);
+		const double Alpha = (Distance - Distances[Step]) / (Distances[Step + 1] - Distances[Step]);
+		return Spline->GetLocationAtSplineInputKey(MaxKey * (Step + Alpha) / NumSteps, ESplineCoordinateSpace::World);
+	}
+
+	FTrajectoryFollowingConfig MakeSpeedVsTimeConfig(int32 NumKeys)
+	{
+		FTrajectoryFollowingConfig Config;
+		Config.SpeedMode = ETrajectorySpeedMode::SpeedVsTime;
+		FRichCurve* Curve = Config.TimeToSpeed.GetRichCurve();
+		for (int32 KeyIndex = 0; KeyIndex < NumKeys; ++KeyIndex)
+		{
+			Curve->SetKeyInterpMode(Curve->AddKey(KeyIndex, 500.0f + 300.0f * FMath::Sin(static_cast<float>(KeyIndex))), RCIM_Cubic);
+		}
+		return Config;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoTrajectoryArcLengthTableTest,
+	"Tempo.Movement.TrajectoryArcLength.Table", TempoTrajectoryArcLengthTestFlags)
+bool FTempoTrajectoryArcLengthTableTest::RunTest(const FString& Parameters)
+{
+	// A smooth rate with a known integral: distance(t) = 500 t - 300 cos(t) + 300.
+	TArray<double> Breaks;
+	for (int32 Break = 0; Break <= 100; ++Break)
+	{
+		Breaks.Add(Break);
+	}
+	const auto SmoothRate = [](int32, double T) { return 500.0 + 300.0 * FMath::Sin(T); };
+	const auto SmoothDistance = [](double T) { return 500.0 * T - 300.0 * FMath::Cos(T) + 300.0; };
+
+	FTrajectoryArcLengthTable Table;
+	Table.Build(SmoothRate, Breaks, ArcLengthTol);
+	double MaxError = 0.0;
+	double MaxInversionError = 0.0;
+	for (int32 Sample = 0; Sample <= 10000; ++Sample)
+	{
+		const double T = 100.0 * Sample / 10000;
+		MaxError = FMath::Max(MaxError, FMath::Abs(Table.Evaluate(T) - SmoothDistance(T)));
+		MaxInversionError = FMath::Max(MaxInversionError, FMath::Abs(Table.Evaluate(Table.Invert(SmoothDistance(T))) - SmoothDistance(T)));
+	}
+	TestTrue(*FString::Printf(TEXT("Lookups are within the tolerance (max error %.4f cm)"), MaxError), MaxError <= ArcLengthTol);
+	TestTrue(*FString::Printf(TEXT("Inverse lookups are consistent (max error %.4f cm)"), MaxInversionError), MaxInversionError <= 1e-3);
+	TestEqual(TEXT("Lookups clamp below the range"), Table.Evaluate(-1.0), 0.0);
+	TestEqual(TEXT("Lookups clamp above the range"), Table.Evaluate(101.0), Table.GetTotalDistance());
+
+	// A rate that jumps at each break, like constant curve keys: exact, with no refinement wasted on the jumps.
+	const TArray<double> Steps = { 100.0, 300.0, 0.0, 200.0 };
+	const TArray<double> StepBreaks = { 0.0, 1.0, 2.0, 3.0, 4.0 };
+	Table.Build([&Steps](int32 Segment, double) { return Steps[Segment]; }, StepBreaks, ArcLengthTol);
+	TestEqual(TEXT("Piecewise constant rates integrate exactly"), Table.GetTotalDistance(), 600.0, 1e-9);
+	TestEqual(TEXT("Distance holds where the rate is 0"), Table.Evaluate(2.5), 400.0, 1e-9);
+	TestEqual(TEXT("Inverse lookups across a jump"), Table.Invert(450.0), 3.25, 1e-9);
+	TestTrue(TEXT("Jumps at breaks need no refinement"), Table.NumKnots() <= 3 * StepBreaks.Num());
+
+	// Incremental rebuild: change the rate from segment 80 on, and compare against a full rebuild.
+	const auto TailRate = [](int32 Segment, double T) { return Segment < 80 ? 500.0 + 300.0 * FMath::Sin(T) : 200.0 + 50.0 * FMath::Cos(3.0 * T); };
+	Table.Build(SmoothRate, Breaks, ArcLengthTol);
+	const int32 TailEvaluations = Table.Build(TailRate, Breaks, ArcLengthTol, /*FirstChangedSegment=*/80);
+	FTrajectoryArcLengthTable FullTable;
+	const int32 FullEvaluations = FullTable.Build(TailRate, Breaks, ArcLengthTol);
+	TestTrue(*FString::Printf(TEXT("Tail rebuilds only integrate the tail (%d vs. %d evaluations)"), TailEvaluations, FullEvaluations), TailEvaluations * 3 < FullEvaluations);
+	TestEqual(TEXT("Tail rebuilds have the same knots as full ones"), Table.NumKnots(), FullTable.NumKnots());
+	for (int32 Sample = 0; Sample <= 1000; ++Sample)
+	{
+		const double T = 100.0 * Sample / 1000;
+		if (!FMath::IsNearlyEqual(Table.Evaluate(T), FullTable.Evaluate(T), 1e-6))
+		{
+			AddError(FString::Printf(TEXT("Tail rebuild differs from a full rebuild at t=%.2f: %.6f vs. %.6f"), T, Table.Evaluate(T), FullTable.Evaluate(T)));
+			break;
+		}
+	}
+
+	const int32 ToleranceEvaluations = Table.Build(TailRate, Breaks, 0.5 * ArcLengthTol, /*FirstChangedSegment=*/80);
+	TestTrue(TEXT("A new tolerance rebuilds everything"), ToleranceEvaluations >= FullEvaluations);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoTrajectoryArcLengthControllerTest,
+	"Tempo.Movement.TrajectoryArcLength.Controller", TempoTrajectoryArcLengthTestFlags)
+bool FTempoTrajectoryArcLengthControllerTest::RunTest(const FString& Parameters)
+{
+	const FTrajectoryArcLengthTestFixture Fixture;
+	ASplineActor* SplineActor = Fixture.SpawnZigzagSpline(8);
+	const USplineComponent* Spline = SplineActor->GetSpline();
+	ATrajectoryFollowingController* Controller = Fixture.World->SpawnActor<ATrajectoryFollowingController>();
+
+	// Constant speed along a sharply curved spline lands where a dense polyline says it should.
+	FTrajectoryFollowingConfig Config;
+	Config.Speed = 1000.0;
+	Controller->FollowTrajectory(SplineActor, nullptr, Config);
+	const TArray<double> Dense = DenseSplineDistances(Spline, 200000);
+	TestEqual(TEXT("The duration covers the spline's arc length"), Controller->GetDuration(), static_cast<float>(Dense.Last() / Config.Speed), 1e-3f);
+
+	double MaxError = 0.0;
+	double MaxReparamError = 0.0;
+	for (int32 Sample = 0; Sample <= 1000; ++Sample)
+	{
+		const float Time = Controller->GetDuration() * Sample / 1000;
+		const FVector Expected = DenseLocationAtDistance(Spline, Dense, Config.Speed * Time);
+		MaxError = FMath::Max(MaxError, FVector::Distance(Controller->GetTransformAtTime(Time).GetLocation(), Expected));
+		MaxReparamError = FMath::Max(MaxReparamError, FVector::Distance(Spline->GetLocationAtDistanceAlongSpline(Config.Speed * Time, ESplineCoordinateSpace::World), Expected));
+	}
+	AddInfo(FString::Printf(TEXT("Max location error: %.4f cm (the spline's own reparameterization table: %.4f cm)"), MaxError, MaxReparamError));
+	TestTrue(TEXT("Samples are within the tolerance of the true arc length"), MaxError <= 2.0 * ArcLengthTol);
+
+	// SpeedVsTime integrates the speed curve: 100 cm/s for 2 s (a constant key), then 300 cm/s.
+	FTrajectoryFollowingConfig SpeedConfig;
+	SpeedConfig.SpeedMode = ETrajectorySpeedMode::SpeedVsTime;
+	FRichCurve* SpeedCurve = SpeedConfig.TimeToSpeed.GetRichCurve();
+	SpeedCurve->SetKeyInterpMode(SpeedCurve->AddKey(0.0f, 100.0f), RCIM_Constant);
+	SpeedCurve->AddKey(2.0f, 300.0f);
+	SpeedCurve->AddKey(10.0f, 300.0f);
+	Controller->FollowTrajectory(SplineActor, nullptr, SpeedConfig);
+	TestTrue(TEXT("SpeedVsTime at 1 s"), Controller->GetTransformAtTime(1.0f).GetLocation().Equals(DenseLocationAtDistance(Spline, Dense, 100.0), 2.0 * ArcLengthTol));
+	TestTrue(TEXT("SpeedVsTime at 5 s"), Controller->GetTransformAtTime(5.0f).GetLocation().Equals(DenseLocationAtDistance(Spline, Dense, 1100.0), 2.0 * ArcLengthTol));
+
+	// Re-sending the config with a changed tail keeps the start of the trajectory. The speed now ramps linearly
+	// from 300 to 500 cm/s after 2 s.
+	SpeedCurve->UpdateOrAddKey(10.0f, 500.0f);
+	const FVector BeforeChange = Controller->GetTransformAtTime(1.0f).GetLocation();
+	Controller->FollowTrajectory(SplineActor, nullptr, SpeedConfig);
+	TestTrue(TEXT("A changed tail keeps the start"), Controller->GetTransformAtTime(1.0f).GetLocation().Equals(BeforeChange, 1e-6));
+	TestTrue(TEXT("A changed tail changes the end"), Controller->GetTransformAtTime(10.0f).GetLocation().Equals(DenseLocationAtDistance(Spline, Dense, 200.0 + 8.0 * 400.0), 2.0 * ArcLengthTol));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoTrajectoryArcLengthBenchmarkTest,
+	"Tempo.Movement.TrajectoryArcLength.Benchmark", TempoTrajectoryArcLengthTestFlags)
+bool FTempoTrajectoryArcLengthBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumSamples = 10000;
+
+	for (const int32 Length : { 10, 100, 1000 })
+	{
+		const FTrajectoryArcLengthTestFixture Fixture;
+		ASplineActor* SplineActor = Fixture.SpawnZigzagSpline(Length + 1);
+		const USplineComponent* Spline = SplineActor->GetSpline();
+		ATrajectoryFollowingController* Controller = Fixture.World->SpawnActor<ATrajectoryFollowingController>();
+		FTrajectoryFollowingConfig Config = MakeSpeedVsTimeConfig(Length + 1);
+
+		double StartTime = FPlatformTime::Seconds();
+		Controller->FollowTrajectory(SplineActor, nullptr, Config);
+		const double FullRebuildTime = FPlatformTime::Seconds() - StartTime;
+
+		// Re-sending the trajectory with only its last key changed, as a 10 Hz ConfigureTrajectoryFollowing does.
+		FRichCurve* Curve = Config.TimeToSpeed.GetRichCurve();
+		Curve->UpdateOrAddKey(Length, 100.0f);
+		StartTime = FPlatformTime::Seconds();
+		Controller->FollowTrajectory(SplineActor, nullptr, Config);
+		const double TailRebuildTime = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		Controller->FollowTrajectory(SplineActor, nullptr, Config);
+		const double UnchangedRebuildTime = FPlatformTime::Seconds() - StartTime;
+
+		const float Duration = Controller->GetDuration();
+		FVector Checksum = FVector::ZeroVector;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+		{
+			Checksum += Controller->GetTransformAtTime(Duration * Sample / NumSamples).GetLocation();
+		}
+		const double SampleTime = FPlatformTime::Seconds() - StartTime;
+
+		// The previous per-sample path: a lookup in the spline's own reparameterization table.
+		const double SplineLength = Spline->GetSplineLength();
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+		{
+			Checksum += Spline->GetTransformAtDistanceAlongSpline(SplineLength * Sample / NumSamples, ESplineCoordinateSpace::World).GetLocation();
+		}
+		const double ReparamSampleTime = FPlatformTime::Seconds() - StartTime;
+
+		TestFalse(TEXT("Samples are finite"), Checksum.ContainsNaN());
+		AddInfo(FString::Printf(TEXT("%4d segments: full rebuild %.3f ms, tail rebuild %.3f ms, unchanged %.3f ms, sample %.3f us (reparam table %.3f us)"),
+			Length, 1e3 * FullRebuildTime, 1e3 * TailRebuildTime, 1e3 * UnchangedRebuildTime,
+			1e6 * SampleTime / NumSamples, 1e6 * ReparamSampleTime / NumSamples));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
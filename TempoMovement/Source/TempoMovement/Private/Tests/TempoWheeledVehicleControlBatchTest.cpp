@@ -0,0 +1,183 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoWheeledVehicleController.h"
+#include "TempoWheeledVehiclePawn.h"
+#include "TempoTestWorld.h"
+#include "WheeledVehicleControlBatchSubsystem.h"
+
+#include "ChaosVehicleMovementComponent.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+// Tests for UWheeledVehicleControlBatchSubsystem: batched controllers send the inputs their own ticks would,
+// and a benchmark of one batched pass against ticking each of 300 controllers. Run with
+//   Automation RunTests Tempo.Movement.WheeledVehicleControlBatch
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoWheeledVehicleControlBatchTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	struct FWheeledVehicleControlBatchTestFixture : FTempoTestWorld
+	{
+		UWheeledVehicleControlBatchSubsystem* Batch = nullptr;
+
+		FWheeledVehicleControlBatchTestFixture()
+		{
+			Batch = World->GetSubsystem<UWheeledVehicleControlBatchSubsystem>();
+		}
+
+		// A Chaos vehicle possessed by a wheeled vehicle controller.
+		ATempoWheeledVehicleController* SpawnVehicle(const FVector& Location) const
+		{
+			ATempoWheeledVehiclePawn* Pawn = World->SpawnActor<ATempoWheeledVehiclePawn>(Location, FRotator::ZeroRotator);
+			Pawn->AIControllerClass = ATempoWheeledVehicleController::StaticClass();
+			Pawn->SpawnDefaultController();
+			return Cast<ATempoWheeledVehicleController>(Pawn->GetController());
+		}
+	};
+
+	UChaosVehicleMovementComponent* GetChaosMovement(const ATempoWheeledVehicleController* Controller)
+	{
+		return Cast<UChaosVehicleMovementComponent>(Controller->GetPawn()->GetMovementComponent());
+	}
+
+	// The same command for both controllers of a pair: a mix of forward, reverse, and turning velocity commands,
+	// acceleration commands, and open-loop driving.
+	void CommandPair(int32 PairIndex, ATempoWheeledVehicleController* Ticked, ATempoWheeledVehicleController* Batched)
+	{
+		for (ATempoWheeledVehicleController* Controller : { Ticked, Batched })
+		{
+			switch (PairIndex % 4)
+			{
+			case 0:
+				Controller->HandleVelocityCommand(FTempoTwist(FVector(100.0 * PairIndex, 0.0, 0.0), FVector(0.0, 0.0, 2.0 * PairIndex)));
+				break;
+			case 1:
+				Controller->HandleVelocityCommand(FTempoTwist(FVector(-50.0 * PairIndex, 0.0, 0.0), FVector(0.0, 0.0, -3.0 * PairIndex)));
+				break;
+			case 2:
+				Controller->HandleAccelerationCommand(FTempoAccel(FVector(20.0 * PairIndex, 0.0, 0.0), FVector(0.0, 0.0, 1.0)));
+				break;
+			default:
+				Controller->HandleDrivingInput(FNormalizedDrivingInput(0.5f, -0.25f));
+				break;
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoWheeledVehicleControlBatchTest,
+	"Tempo.Movement.WheeledVehicleControlBatch.Inputs", TempoWheeledVehicleControlBatchTestFlags)
+bool FTempoWheeledVehicleControlBatchTest::RunTest(const FString& Parameters)
+{
+	const FWheeledVehicleControlBatchTestFixture Fixture;
+	if (!TestNotNull(TEXT("Game worlds have a wheeled vehicle control batch subsystem"), Fixture.Batch))
+	{
+		return false;
+	}
+
+	// Pairs of identical vehicles with the same commands: one controller ticks itself, the other is batched. Enough
+	// of them that the batch computes in parallel.
+	constexpr int32 NumPairs = 100;
+	TArray<ATempoWheeledVehicleController*> Ticked;
+	TArray<ATempoWheeledVehicleController*> Batched;
+	for (int32 PairIndex = 0; PairIndex < NumPairs; ++PairIndex)
+	{
+		Ticked.Add(Fixture.SpawnVehicle(FVector(1000.0 * PairIndex, 0.0, 0.0)));
+		Batched.Add(Fixture.SpawnVehicle(FVector(1000.0 * PairIndex, 1000.0, 0.0)));
+		Fixture.Batch->RegisterController(Batched.Last());
+		CommandPair(PairIndex, Ticked.Last(), Batched.Last());
+	}
+	TestEqual(TEXT("Every batched controller is registered"), Fixture.Batch->NumControllers(), NumPairs);
+
+	// Enough steps for the integral terms to build up.
+	constexpr float DeltaTime = 1.0f / 30.0f;
+	for (int32 Step = 0; Step < 60; ++Step)
+	{
+		for (ATempoWheeledVehicleController* Controller : Ticked)
+		{
+			Controller->Tick(DeltaTime);
+		}
+		Fixture.Batch->UpdateControllers(DeltaTime);
+	}
+
+	int32 NumMismatches = 0;
+	for (int32 PairIndex = 0; PairIndex < NumPairs; ++PairIndex)
+	{
+		UChaosVehicleMovementComponent* TickedMovement = GetChaosMovement(Ticked[PairIndex]);
+		UChaosVehicleMovementComponent* BatchedMovement = GetChaosMovement(Batched[PairIndex]);
+		const bool bIdentical = TickedMovement->GetThrottleInput() == BatchedMovement->GetThrottleInput() &&
+			TickedMovement->GetBrakeInput() == BatchedMovement->GetBrakeInput() &&
+			TickedMovement->GetSteeringInput() == BatchedMovement->GetSteeringInput();
+		if (!bIdentical && NumMismatches++ == 0)
+		{
+			AddError(FString::Printf(TEXT("Vehicle %d differs: ticked throttle %f brake %f steering %f, batched throttle %f brake %f steering %f"), PairIndex,
+				TickedMovement->GetThrottleInput(), TickedMovement->GetBrakeInput(), TickedMovement->GetSteeringInput(),
+				BatchedMovement->GetThrottleInput(), BatchedMovement->GetBrakeInput(), BatchedMovement->GetSteeringInput()));
+		}
+	}
+	TestEqual(TEXT("Batched controllers send the inputs ticked ones do"), NumMismatches, 0);
+	TestEqual(TEXT("Closed-loop controllers are computed in the batch"), Fixture.Batch->GetStats().NumBatched, NumPairs * 3 / 4);
+
+	Fixture.Batch->UnregisterController(Batched[0]);
+	TestEqual(TEXT("Unregistered controllers leave the batch"), Fixture.Batch->NumControllers(), NumPairs - 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoWheeledVehicleControlBatchBenchmarkTest,
+	"Tempo.Movement.WheeledVehicleControlBatch.Benchmark", TempoWheeledVehicleControlBatchTestFlags)
+bool FTempoWheeledVehicleControlBatchBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumVehicles = 300;
+	constexpr int32 NumSteps = 100;
+	constexpr float DeltaTime = 1.0f / 30.0f;
+
+	const FWheeledVehicleControlBatchTestFixture Fixture;
+	if (!TestNotNull(TEXT("Game worlds have a wheeled vehicle control batch subsystem"), Fixture.Batch))
+	{
+		return false;
+	}
+
+	TArray<ATempoWheeledVehicleController*> Controllers;
+	for (int32 VehicleIndex = 0; VehicleIndex < NumVehicles; ++VehicleIndex)
+	{
+		ATempoWheeledVehicleController* Controller = Fixture.SpawnVehicle(FVector(1000.0 * VehicleIndex, 0.0, 0.0));
+		Controller->HandleVelocityCommand(FTempoTwist(FVector(1000.0, 0.0, 0.0), FVector(0.0, 0.0, 5.0)));
+		Controllers.Add(Controller);
+	}
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		for (ATempoWheeledVehicleController* Controller : Controllers)
+		{
+			Controller->Tick(DeltaTime);
+		}
+	}
+	const double TickedTime = (FPlatformTime::Seconds() - StartTime) / NumSteps;
+
+	for (ATempoWheeledVehicleController* Controller : Controllers)
+	{
+		Fixture.Batch->RegisterController(Controller);
+	}
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		Fixture.Batch->UpdateControllers(DeltaTime);
+	}
+	const double BatchedTime = (FPlatformTime::Seconds() - StartTime) / NumSteps;
+
+	const FWheeledVehicleControlStats& Stats = Fixture.Batch->GetStats();
+	TestEqual(TEXT("Every controller is computed in the batch"), Stats.NumBatched, NumVehicles);
+	AddInfo(FString::Printf(TEXT("%d vehicles, per frame: ticked %.3f ms, batched %.3f ms (last pass %.3f ms)"),
+		NumVehicles, TickedTime * 1000.0, BatchedTime * 1000.0, Stats.UpdateTime * 1000.0));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,200 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TrajectoryArcLengthTable.h"
+
+#include "Algo/BinarySearch.h"
+
+namespace
+{
+	// Every segment is halved at least this many times, so a coincidentally exact first Simpson estimate can't
+	// stand in for a whole segment, and at most this many times, to bound the cost of discontinuous rates.
+	constexpr int32 MinRefinementDepth = 1;
+	constexpr int32 MaxRefinementDepth = 18;
+
+	// Newton steps when inverting the cubic across one interval. The initial linear guess is already close, since
+	// intervals are refined until the cubic is.
+	constexpr int32 NumInversionSteps = 3;
+
+	// The cubic Hermite interpolant of distance across an interval of width H, at S in [0, 1], from the distances
+	// and rates (derivatives) at its ends.
+	double Hermite(double S, double H, double D0, double D1, double R0, double R1)
+	{
+		const double S2 = S * S;
+		const double S3 = S2 * S;
+		return (2.0 * S3 - 3.0 * S2 + 1.0) * D0 + (S3 - 2.0 * S2 + S) * H * R0 + (-2.0 * S3 + 3.0 * S2) * D1 + (S3 - S2) * H * R1;
+	}
+
+	// Derivative of Hermite with respect to S.
+	double HermiteDerivative(double S, double H, double D0, double D1, double R0, double R1)
+	{
+		const double S2 = S * S;
+		return (6.0 * S2 - 6.0 * S) * (D0 - D1) + (3.0 * S2 - 4.0 * S + 1.0) * H * R0 + (3.0 * S2 - 2.0 * S) * H * R1;
+	}
+}
+
+int32 FTrajectoryArcLengthTable::Build(FRateFunction Rate, TArrayView<const double> Breaks, double Tolerance, int32 FirstChangedSegment)
+{
+	if (Breaks.Num() < 2 || Tolerance <= 0.0)
+	{
+		Reset();
+		return 0;
+	}
+
+	int32 NumEvaluations = 0;
+
+	// Keep the knots up to the first changed segment, if they were built the same way. Every break is a knot.
+	int32 FirstSegment = 0;
+	if (FirstChangedSegment > 0 && !IsEmpty() && Tolerance == BuildTolerance && Parameters[0] == Breaks[0])
+	{
+		FirstSegment = FMath::Min(FirstChangedSegment, Breaks.Num() - 1);
+		const int32 NumKept = Algo::UpperBound(Parameters, Breaks[FirstSegment]);
+		if (NumKept > 0 && Parameters[NumKept - 1] == Breaks[FirstSegment])
+		{
+			Parameters.SetNum(NumKept);
+			Distances.SetNum(NumKept);
+			ArrivingRates.SetNum(NumKept);
+			DepartingRates.SetNum(NumKept);
+		}
+		else
+		{
+			FirstSegment = 0;
+		}
+	}
+
+	if (FirstSegment == 0)
+	{
+		Reset();
+		// Nothing arrives at the first knot; its departing rate is set with its segment's below.
+		AddKnot(Breaks[0], 0.0, 0.0);
+	}
+	BuildTolerance = Tolerance;
+
+	// The integral's error is budgeted across the whole range, the interpolant's per interval.
+	const double Range = Breaks.Last() - Breaks[0];
+	const double IntegralTolerancePerUnit = Range > 0.0 ? Tolerance / Range : Tolerance;
+
+	for (int32 Segment = FirstSegment; Segment < Breaks.Num() - 1; ++Segment)
+	{
+		const double A = Breaks[Segment];
+		const double B = Breaks[Segment + 1];
+		if (B <= A)
+		{
+			continue;
+		}
+		const double M = 0.5 * (A + B);
+		const double RateA = Rate(Segment, A);
+		const double RateM = Rate(Segment, M);
+		const double RateB = Rate(Segment, B);
+		NumEvaluations += 3;
+		DepartingRates.Last() = RateA;
+		const double Whole = (B - A) / 6.0 * (RateA + 4.0 * RateM + RateB);
+		Refine(Rate, Segment, A, RateA, M, RateM, B, RateB, Whole, Tolerance, IntegralTolerancePerUnit, 0, NumEvaluations);
+	}
+
+	return NumEvaluations;
+}
+
+void FTrajectoryArcLengthTable::Refine(FRateFunction Rate, int32 Segment, double A, double RateA, double M, double RateM, double B, double RateB,
+	double Whole, double Tolerance, double IntegralTolerancePerUnit, int32 Depth, int32& NumEvaluations)
+{
+	const double LeftM = 0.5 * (A + M);
+	const double RightM = 0.5 * (M + B);
+	const double RateLeftM = Rate(Segment, LeftM);
+	const double RateRightM = Rate(Segment, RightM);
+	NumEvaluations += 2;
+	const double Left = (M - A) / 6.0 * (RateA + 4.0 * RateLeftM + RateM);
+	const double Right = (B - M) / 6.0 * (RateM + 4.0 * RateRightM + RateB);
+
+	// Richardson's estimate of the halves' integration error, and how far the cubic across [A, B] misses the
+	// distance to the midpoint.
+	const double H = B - A;
+	const double IntegralError = FMath::Abs(Left + Right - Whole) / 15.0;
+	const double InterpolationError = FMath::Abs(0.5 * (Left + Right) + H / 8.0 * (RateA - RateB) - Left);
+
+	if (Depth >= MaxRefinementDepth ||
+		(Depth >= MinRefinementDepth && IntegralError <= IntegralTolerancePerUnit * H && InterpolationError <= Tolerance))
+	{
+		AddKnot(B, Distances.Last() + Left + Right, RateB);
+		return;
+	}
+
+	Refine(Rate, Segment, A, RateA, LeftM, RateLeftM, M, RateM, Left, Tolerance, IntegralTolerancePerUnit, Depth + 1, NumEvaluations);
+	Refine(Rate, Segment, M, RateM, RightM, RateRightM, B, RateB, Right, Tolerance, IntegralTolerancePerUnit, Depth + 1, NumEvaluations);
+}
+
+void FTrajectoryArcLengthTable::AddKnot(double Parameter, double Distance, double Rate)
+{
+	Parameters.Add(Parameter);
+	Distances.Add(Distance);
+	ArrivingRates.Add(Rate);
+	DepartingRates.Add(Rate);
+}
+
+void FTrajectoryArcLengthTable::Reset()
+{
+	BuildTolerance = 0.0;
+	Parameters.Reset();
+	Distances.Reset();
+	ArrivingRates.Reset();
+	DepartingRates.Reset();
+}
+
+double FTrajectoryArcLengthTable::Evaluate(double Parameter) const
+{
+	if (IsEmpty())
+	{
+		return 0.0;
+	}
+	if (Parameter <= Parameters[0])
+	{
+		return Distances[0];
+	}
+	if (Parameter >= Parameters.Last())
+	{
+		return Distances.Last();
+	}
+
+	const int32 Index = Algo::UpperBound(Parameters, Parameter) - 1;
+	const double H = Parameters[Index + 1] - Parameters[Index];
+	const double S = (Parameter - Parameters[Index]) / H;
+	return Hermite(S, H, Distances[Index], Distances[Index + 1], DepartingRates[Index], ArrivingRates[Index + 1]);
+}
+
+double FTrajectoryArcLengthTable::Invert(double Distance) const
+{
+	if (IsEmpty())
+	{
+		return 0.0;
+	}
+	if (Distance <= Distances[0])
+	{
+		return Parameters[0];
+	}
+	if (Distance >= Distances.Last())
+	{
+		return Parameters.Last();
+	}
+
+	const int32 Index = Algo::UpperBound(Distances, Distance) - 1;
+	const double H = Parameters[Index + 1] - Parameters[Index];
+	const double D0 = Distances[Index];
+	const double D1 = Distances[Index + 1];
+	if (D1 <= D0)
+	{
+		return Parameters[Index];
+	}
+
+	const double R0 = DepartingRates[Index];
+	const double R1 = ArrivingRates[Index + 1];
+	double S = (Distance - D0) / (D1 - D0);
+	for (int32 Step = 0; Step < NumInversionSteps; ++Step)
+	{
+		const double Slope = HermiteDerivative(S, H, D0, D1, R0, R1);
+		if (Slope <= UE_SMALL_NUMBER)
+		{
+			break;
+		}
+		S = FMath::Clamp(S - (Hermite(S, H, D0, D1, R0, R1) - Distance) / Slope, 0.0, 1.0);
+	}
+	return Parameters[Index] + S * H;
+}
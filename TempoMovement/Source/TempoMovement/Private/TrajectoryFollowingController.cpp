@@ -39,6 +39,7 @@ void ATrajectoryFollowingController::FollowTrajectory(ASplineActor* InSpline, AP
 	Config = InConfig;
 	ElapsedSeconds = 0.0;
 	RebuildSpeedDistanceCache();
+	RefreshSplineDistanceTable();
 	VehicleVelocityController.Reset();
 	if (InPawn)
 	{
@@ -59,7 +60,14 @@ float ATrajectoryFollowingController::GetDuration() const
 		return CurveMaxTime(Config.TimeToSpeed);
 	case ETrajectorySpeedMode::ConstantSpeed:
 	default:
-		return (!SplineComponent || Config.Speed <= 0.0) ? 0.0f : SplineComponent->GetSplineLength() / Config.Speed;
+	{
+		if (!SplineComponent || Config.Speed <= 0.0)
+		{
+			return 0.0f;
+		}
+		const double Length = SplineDistanceTable.IsEmpty() ? SplineComponent->GetSplineLength() : SplineDistanceTable.GetTotalDistance();
+		return Length / Config.Speed;
+	}
 	}
 }
 
@@ -86,6 +94,11 @@ FTransform ATrajectoryFollowingController::SampleAtTime(float Time) const
 	}
 
 	const double Distance = DistanceAtTime(Time);
+	if (!SplineDistanceTable.IsEmpty())
+	{
+		const float InputKey = SplineDistanceTable.Invert(Distance);
+		return SplineComponent->GetTransformAtSplineInputKey(InputKey, ESplineCoordinateSpace::World);
+	}
 	return SplineComponent->GetTransformAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
 }
 
@@ -99,7 +112,7 @@ double ATrajectoryFollowingController::DistanceAtTime(float Time) const
 		return Curve ? Curve->Eval(Time) : 0.0;
 	}
 	case ETrajectorySpeedMode::SpeedVsTime:
-		return SpeedDistanceCache.GetNumKeys() > 0 ? SpeedDistanceCache.Eval(Time) : 0.0;
+		return TimeDistanceTable.Evaluate(Time);
 	case ETrajectorySpeedMode::ConstantSpeed:
 	default:
 		return Config.Speed * Time;
@@ -108,39 +121,132 @@ double ATrajectoryFollowingController::DistanceAtTime(float Time) const
 
 void ATrajectoryFollowingController::RebuildSpeedDistanceCache()
 {
-	SpeedDistanceCache.Reset();
-
 	const FRichCurve* SpeedCurve = Config.TimeToSpeed.GetRichCurveConst();
-	if (!SpeedCurve || SpeedCurve->GetNumKeys() == 0)
+	float MinTime = 0.0f;
+	float MaxTime = 0.0f;
+	if (SpeedCurve && SpeedCurve->GetNumKeys() > 0)
 	{
+		SpeedCurve->GetTimeRange(MinTime, MaxTime);
+		MinTime = FMath::Max(MinTime, 0.0f);
+	}
+	if (MaxTime <= MinTime)
+	{
+		TimeDistanceTable.Reset();
+		TimeDistanceTableKeys.Reset();
 		return;
 	}
 
-	float MinTime = 0.0f;
-	float MaxTime = 0.0f;
-	SpeedCurve->GetTimeRange(MinTime, MaxTime);
-	MinTime = FMath::Max(MinTime, 0.0f);
+	const TArray<FRichCurveKey>& Keys = SpeedCurve->GetConstRefOfKeys();
+	if (Keys == TimeDistanceTableKeys && TimeDistanceTable.GetTolerance() == ArcLengthTolerance)
+	{
+		return;
+	}
 
-	SpeedDistanceCache.AddKey(MinTime, 0.0f);
-	if (MaxTime <= MinTime)
+	// One segment per pair of keys within [MinTime, MaxTime], and the key each segment starts from.
+	int32 StartKey = 0;
+	while (StartKey + 1 < Keys.Num() && Keys[StartKey + 1].Time <= MinTime)
+	{
+		++StartKey;
+	}
+	TArray<double> Breaks = { MinTime };
+	TArray<int32> SegmentKeys = { StartKey };
+	for (int32 KeyIndex = StartKey + 1; KeyIndex < Keys.Num(); ++KeyIndex)
+	{
+		Breaks.Add(Keys[KeyIndex].Time);
+		SegmentKeys.Add(KeyIndex);
+	}
+
+	// A changed key changes the segments on either side of it (its tangents are part of the key), so everything up
+	// to the start of the segment that ends at it can be kept.
+	int32 FirstChangedKey = 0;
+	while (FirstChangedKey < FMath::Min(Keys.Num(), TimeDistanceTableKeys.Num()) && Keys[FirstChangedKey] == TimeDistanceTableKeys[FirstChangedKey])
+	{
+		++FirstChangedKey;
+	}
+	int32 FirstChangedSegment = 0;
+	while (FirstChangedSegment < SegmentKeys.Num() && SegmentKeys[FirstChangedSegment] < FirstChangedKey - 1)
+	{
+		++FirstChangedSegment;
+	}
+
+	const auto SpeedAtTime = [SpeedCurve, &Keys, &SegmentKeys](int32 Segment, double Time) -> double
+	{
+		// A constant key holds its value up to the next key, where Eval would already return the next key's value.
+		const FRichCurveKey& Key = Keys[SegmentKeys[Segment]];
+		return Key.InterpMode == RCIM_Constant ? Key.Value : SpeedCurve->Eval(static_cast<float>(Time));
+	};
+	TimeDistanceTable.Build(SpeedAtTime, Breaks, ArcLengthTolerance, FirstChangedSegment);
+	TimeDistanceTableKeys = Keys;
+}
+
+void ATrajectoryFollowingController::RefreshSplineDistanceTable()
+{
+	SplineDistanceTableVersion = Spline ? Spline->GetGeometryVersion() : 0;
+
+	const USplineComponent* SplineComponent = Spline ? Spline->GetSpline() : nullptr;
+	const int32 NumPoints = SplineComponent ? SplineComponent->GetNumberOfSplinePoints() : 0;
+	const bool bClosedLoop = SplineComponent && SplineComponent->IsClosedLoop();
+	const int32 NumSegments = bClosedLoop ? NumPoints : NumPoints - 1;
+	if (NumSegments < 1)
 	{
+		SplineDistanceTable.Reset();
+		SplineDistanceTablePoints.Reset();
 		return;
 	}
 
-	// Trapezoidal integration of speed -> cumulative distance, sampled finely so any curve
-	// interpolation mode is captured well enough for runtime lookup.
-	constexpr int32 NumSamples = 256;
-	const float DeltaTime = (MaxTime - MinTime) / NumSamples;
-	double CumulativeDistance = 0.0;
-	float PrevSpeed = SpeedCurve->Eval(MinTime);
-	for (int32 SampleIndex = 1; SampleIndex <= NumSamples; ++SampleIndex)
-	{
-		const float SampleTime = MinTime + SampleIndex * DeltaTime;
-		const float SampleSpeed = SpeedCurve->Eval(SampleTime);
-		CumulativeDistance += 0.5 * (PrevSpeed + SampleSpeed) * DeltaTime;
-		SpeedDistanceCache.AddKey(SampleTime, static_cast<float>(CumulativeDistance));
-		PrevSpeed = SampleSpeed;
+	// Distance along the spline is measured in its local space, as GetTransformAtDistanceAlongSpline does.
+	TArray<FTrajectorySplinePoint> Points;
+	Points.Reserve(NumPoints);
+	for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+	{
+		FTrajectorySplinePoint& Point = Points.AddDefaulted_GetRef();
+		Point.Location = SplineComponent->GetLocationAtSplinePoint(PointIndex, ESplineCoordinateSpace::Local);
+		Point.ArriveTangent = SplineComponent->GetArriveTangentAtSplinePoint(PointIndex, ESplineCoordinateSpace::Local);
+		Point.LeaveTangent = SplineComponent->GetLeaveTangentAtSplinePoint(PointIndex, ESplineCoordinateSpace::Local);
+		Point.Type = static_cast<uint8>(SplineComponent->GetSplinePointType(PointIndex));
 	}
+
+	if (Points == SplineDistanceTablePoints && bClosedLoop == bSplineDistanceTableClosedLoop && SplineDistanceTable.GetTolerance() == ArcLengthTolerance)
+	{
+		return;
+	}
+
+	// A changed point changes the segments on either side of it.
+	int32 FirstChangedPoint = 0;
+	if (bClosedLoop == bSplineDistanceTableClosedLoop)
+	{
+		while (FirstChangedPoint < FMath::Min(NumPoints, SplineDistanceTablePoints.Num()) && Points[FirstChangedPoint] == SplineDistanceTablePoints[FirstChangedPoint])
+		{
+			++FirstChangedPoint;
+		}
+	}
+
+	TArray<double> Breaks;
+	Breaks.Reserve(NumSegments + 1);
+	for (int32 PointIndex = 0; PointIndex <= NumSegments; ++PointIndex)
+	{
+		Breaks.Add(PointIndex);
+	}
+
+	// The length of the spline's derivative with respect to its input key, evaluated the way FInterpCurve does
+	// between the segment's two points (whose input keys are one apart).
+	const auto SplineSpeed = [&Points, NumPoints](int32 Segment, double InputKey) -> double
+	{
+		const FTrajectorySplinePoint& Start = Points[Segment];
+		const FTrajectorySplinePoint& End = Points[(Segment + 1) % NumPoints];
+		switch (Start.Type)
+		{
+		case ESplinePointType::Linear:
+			return FVector::Distance(Start.Location, End.Location);
+		case ESplinePointType::Constant:
+			return 0.0;
+		default:
+			return FMath::CubicInterpDerivative(Start.Location, Start.LeaveTangent, End.Location, End.ArriveTangent, InputKey - Segment).Size();
+		}
+	};
+	SplineDistanceTable.Build(SplineSpeed, Breaks, ArcLengthTolerance, FMath::Max(FirstChangedPoint - 1, 0));
+	SplineDistanceTablePoints = MoveTemp(Points);
+	bSplineDistanceTableClosedLoop = bClosedLoop;
 }
 
 void ATrajectoryFollowingController::Tick(float DeltaSeconds)
@@ -153,6 +259,13 @@ void ATrajectoryFollowingController::Tick(float DeltaSeconds)
 		return;
 	}
 
+	// The spline's points can be changed at any time (e.g. by SetSplinePoints, or by editing the spline component
+	// directly), and each USplineComponent::UpdateSpline bumps its geometry version.
+	if (Spline->GetGeometryVersion() != SplineDistanceTableVersion || SplineDistanceTable.GetTolerance() != ArcLengthTolerance)
+	{
+		RefreshSplineDistanceTable();
+	}
+
 	ElapsedSeconds += DeltaSeconds;
 
 	// Apply end-of-trajectory behavior once the duration is reached.
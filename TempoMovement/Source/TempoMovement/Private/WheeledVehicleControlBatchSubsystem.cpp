@@ -0,0 +1,156 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "WheeledVehicleControlBatchSubsystem.h"
+
+#include "TempoWheeledVehicleController.h"
+
+#include "Async/ParallelFor.h"
+#include "ChaosVehicleMovementComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PawnMovementComponent.h"
+
+DECLARE_STATS_GROUP(TEXT("TempoVehicleControl"), STATGROUP_TempoVehicleControl, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Update Controllers"), STAT_TempoVehicleControlUpdate, STATGROUP_TempoVehicleControl);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Controllers"), STAT_TempoVehicleControlControllers, STATGROUP_TempoVehicleControl);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Batched Controllers"), STAT_TempoVehicleControlBatched, STATGROUP_TempoVehicleControl);
+
+namespace
+{
+	// Fewer batched controllers than this are updated on the game thread, where the cost of dispatching to workers
+	// would outweigh the math.
+	constexpr int32 MinControllersPerParallelUpdate = 64;
+}
+
+void FWheeledVehicleControlTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem)
+	{
+		Subsystem->UpdateControllers(DeltaTime);
+	}
+}
+
+FString FWheeledVehicleControlTickFunction::DiagnosticMessage()
+{
+	return TEXT("UWheeledVehicleControlBatchSubsystem::UpdateControllers");
+}
+
+void UWheeledVehicleControlBatchSubsystem::RegisterController(ATempoWheeledVehicleController* Controller)
+{
+	if (!Controller || Controllers.Contains(Controller))
+	{
+		return;
+	}
+
+	// The movement component consumes the inputs in its own tick, so it must come after the pass.
+	UActorComponent* MovementComponent = Controller->GetPawn() ? Controller->GetPawn()->GetMovementComponent() : nullptr;
+	if (MovementComponent)
+	{
+		MovementComponent->PrimaryComponentTick.AddPrerequisite(this, ControlTickFunction);
+	}
+	Controllers.Add(Controller);
+	MovementComponents.Add(MovementComponent);
+}
+
+void UWheeledVehicleControlBatchSubsystem::UnregisterController(ATempoWheeledVehicleController* Controller)
+{
+	const int32 ControllerIndex = Controllers.IndexOfByKey(Controller);
+	if (ControllerIndex != INDEX_NONE)
+	{
+		if (UActorComponent* MovementComponent = MovementComponents[ControllerIndex].Get())
+		{
+			MovementComponent->PrimaryComponentTick.RemovePrerequisite(this, ControlTickFunction);
+		}
+		Controllers.RemoveAtSwap(ControllerIndex);
+		MovementComponents.RemoveAtSwap(ControllerIndex);
+	}
+}
+
+void UWheeledVehicleControlBatchSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	ControlTickFunction.Subsystem = this;
+	ControlTickFunction.bCanEverTick = true;
+	ControlTickFunction.TickGroup = TG_PrePhysics;
+	ControlTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UWheeledVehicleControlBatchSubsystem::Deinitialize()
+{
+	if (ControlTickFunction.IsTickFunctionRegistered())
+	{
+		ControlTickFunction.UnRegisterTickFunction();
+	}
+
+	Super::Deinitialize();
+}
+
+void UWheeledVehicleControlBatchSubsystem::UpdateControllers(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TempoVehicleControlUpdate);
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Forget controllers that were destroyed without unregistering.
+	for (int32 ControllerIndex = Controllers.Num() - 1; ControllerIndex >= 0; --ControllerIndex)
+	{
+		if (!Controllers[ControllerIndex].IsValid())
+		{
+			Controllers.RemoveAtSwap(ControllerIndex);
+			MovementComponents.RemoveAtSwap(ControllerIndex);
+		}
+	}
+
+	// Gather, on the game thread: reading the setpoints (and the watchdog's clock) and the vehicles' state touches
+	// the controllers and their pawns.
+	BatchedControllers.Reset();
+	ChaosMovements.Reset();
+	States.Reset();
+	Targets.Reset();
+	DeltaTimes.Reset();
+	for (const TWeakObjectPtr<ATempoWheeledVehicleController>& WeakController : Controllers)
+	{
+		ATempoWheeledVehicleController* Controller = WeakController.Get();
+		const float ControllerDeltaTime = DeltaTime * Controller->CustomTimeDilation;
+		const APawn* ControlledPawn = Controller->GetPawn();
+		UChaosVehicleMovementComponent* ChaosMovement = ControlledPawn ? Cast<UChaosVehicleMovementComponent>(ControlledPawn->GetMovementComponent()) : nullptr;
+		if (!ChaosMovement || !Controller->IsClosedLoop())
+		{
+			// Open-loop driving and kinematic vehicles go through their pawns' movement input, so they are updated
+			// here just as their own ticks would update them.
+			Controller->TickControl(ControllerDeltaTime);
+			continue;
+		}
+
+		Controller->UpdateVelocityTarget(ControllerDeltaTime);
+		BatchedControllers.Add(Controller);
+		ChaosMovements.Add(ChaosMovement);
+		States.Add(FWheeledVehicleVelocityController::GetChaosControlState(ChaosMovement));
+		// Only linear.x and angular.z are actuable for a wheeled vehicle. Other axes are ignored.
+		Targets.Add(FVector2f(Controller->VelocityTarget.Linear.X, Controller->VelocityTarget.Angular.Z));
+		DeltaTimes.Add(ControllerDeltaTime);
+	}
+
+	// Compute, in parallel: each controller's velocity controller only reads the packed state and updates its own
+	// integral.
+	const int32 NumBatched = BatchedControllers.Num();
+	Inputs.SetNum(NumBatched);
+	ParallelFor(NumBatched, [this](int32 BatchedIndex)
+	{
+		const FVector2f& Target = Targets[BatchedIndex];
+		Inputs[BatchedIndex] = BatchedControllers[BatchedIndex]->VelocityController.ComputeChaosBodyVelocityInputs(States[BatchedIndex], Target.X, Target.Y, DeltaTimes[BatchedIndex]);
+	}, NumBatched < MinControllersPerParallelUpdate ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	// Dispatch, on the game thread: setting a vehicle's inputs isn't thread-safe.
+	for (int32 BatchedIndex = 0; BatchedIndex < NumBatched; ++BatchedIndex)
+	{
+		FWheeledVehicleVelocityController::ApplyChaosInputs(ChaosMovements[BatchedIndex], Inputs[BatchedIndex]);
+	}
+
+	Stats.NumControllers = Controllers.Num();
+	Stats.NumBatched = NumBatched;
+	Stats.UpdateTime = FPlatformTime::Seconds() - StartTime;
+	SET_DWORD_STAT(STAT_TempoVehicleControlControllers, Stats.NumControllers);
+	SET_DWORD_STAT(STAT_TempoVehicleControlBatched, Stats.NumBatched);
+}
@@ -30,20 +30,7 @@ bool FWheeledVehicleVelocityController::TrackBodyVelocity(APawn* Pawn, float Tar
 
 	if (UChaosVehicleMovementComponent* ChaosMovement = Cast<UChaosVehicleMovementComponent>(MovementComponent))
 	{
-		const float CurrentLinVelCmS = ChaosMovement->GetForwardSpeed();
-		const float NormAccel = ComputeNormalizedAcceleration(TargetLinVelCmS, CurrentLinVelCmS, DeltaTime);
-
-		float CurrentYawRateDegS = 0.0f;
-		if (const ITempoAngularVelocityInterface* AngVel = Cast<ITempoAngularVelocityInterface>(ChaosMovement))
-		{
-			CurrentYawRateDegS = AngVel->GetAngularVelocity().Z;
-		}
-		// Positive Chaos steering input = right turn = +yaw (Unreal left-handed). Same sign as the LH yaw error.
-		const float YawErrorDegS = TargetYawRateDegS - CurrentYawRateDegS;
-		const float NormSteer = FMath::Clamp(YawRateKp * YawErrorDegS, -1.0f, 1.0f);
-
-		ChaosMovement->SetSteeringInput(NormSteer);
-		ApplyChaosAccelInput(ChaosMovement, NormAccel);
+		ApplyChaosInputs(ChaosMovement, ComputeChaosBodyVelocityInputs(GetChaosControlState(ChaosMovement), TargetLinVelCmS, TargetYawRateDegS, DeltaTime));
 		return true;
 	}
 
@@ -89,38 +76,85 @@ float FWheeledVehicleVelocityController::ComputeNormalizedAcceleration(float Tar
 }
 
 void FWheeledVehicleVelocityController::ApplyChaosAccelInput(UChaosVehicleMovementComponent* Movement, float NormAccel) const
+{
+	FChaosVehicleControlInputs Inputs;
+	ComputeChaosAccelInputs(GetChaosControlState(Movement), NormAccel, Inputs);
+
+	if (Inputs.TargetGear.IsSet())
+	{
+		Movement->SetTargetGear(Inputs.TargetGear.GetValue(), false);
+	}
+	Movement->SetThrottleInput(Inputs.Throttle);
+	Movement->SetBrakeInput(Inputs.Brake);
+}
+
+FChaosVehicleControlState FWheeledVehicleVelocityController::GetChaosControlState(const UChaosVehicleMovementComponent* Movement)
+{
+	FChaosVehicleControlState State;
+	State.ForwardSpeed = Movement->GetForwardSpeed();
+	if (const ITempoAngularVelocityInterface* AngVel = Cast<ITempoAngularVelocityInterface>(Movement))
+	{
+		State.YawRate = AngVel->GetAngularVelocity().Z;
+	}
+	State.CurrentGear = Movement->GetCurrentGear();
+	if (const UTempoChaosWheeledVehicleMovementComponent* TempoMovement = Cast<UTempoChaosWheeledVehicleMovementComponent>(Movement))
+	{
+		State.bReverseEnabled = TempoMovement->GetReverseEnabled();
+	}
+	return State;
+}
+
+FChaosVehicleControlInputs FWheeledVehicleVelocityController::ComputeChaosBodyVelocityInputs(const FChaosVehicleControlState& State, float TargetLinVelCmS, float TargetYawRateDegS, float DeltaTime)
+{
+	FChaosVehicleControlInputs Inputs;
+
+	// Positive Chaos steering input = right turn = +yaw (Unreal left-handed). Same sign as the LH yaw error.
+	const float YawErrorDegS = TargetYawRateDegS - State.YawRate;
+	Inputs.Steering = FMath::Clamp(YawRateKp * YawErrorDegS, -1.0f, 1.0f);
+
+	ComputeChaosAccelInputs(State, ComputeNormalizedAcceleration(TargetLinVelCmS, State.ForwardSpeed, DeltaTime), Inputs);
+	return Inputs;
+}
+
+void FWheeledVehicleVelocityController::ApplyChaosInputs(UChaosVehicleMovementComponent* Movement, const FChaosVehicleControlInputs& Inputs)
+{
+	Movement->SetSteeringInput(Inputs.Steering);
+	if (Inputs.TargetGear.IsSet())
+	{
+		Movement->SetTargetGear(Inputs.TargetGear.GetValue(), false);
+	}
+	Movement->SetThrottleInput(Inputs.Throttle);
+	Movement->SetBrakeInput(Inputs.Brake);
+}
+
+void FWheeledVehicleVelocityController::ComputeChaosAccelInputs(const FChaosVehicleControlState& State, float NormAccel, FChaosVehicleControlInputs& InOutInputs)
 {
 	if (NormAccel > 0.0f)
 	{
-		if (Movement->GetForwardSpeed() > -NearlyStoppedSpeedCmS && Movement->GetCurrentGear() > -1)
+		if (State.ForwardSpeed > -NearlyStoppedSpeedCmS && State.CurrentGear > -1)
 		{
-			Movement->SetThrottleInput(NormAccel);
-			Movement->SetBrakeInput(0.0f);
+			InOutInputs.Throttle = NormAccel;
+			InOutInputs.Brake = 0.0f;
 		}
 		else
 		{
-			Movement->SetTargetGear(1, false);
-			Movement->SetThrottleInput(0.0f);
-			Movement->SetBrakeInput(NormAccel);
+			InOutInputs.TargetGear = 1;
+			InOutInputs.Throttle = 0.0f;
+			InOutInputs.Brake = NormAccel;
 		}
 	}
 	else
 	{
-		bool bReverseEnabled = true;
-		if (const UTempoChaosWheeledVehicleMovementComponent* TempoMovement = Cast<UTempoChaosWheeledVehicleMovementComponent>(Movement))
-		{
-			bReverseEnabled = TempoMovement->GetReverseEnabled();
-		}
-		if (Movement->GetForwardSpeed() > 0.0f || !bReverseEnabled)
+		if (State.ForwardSpeed > 0.0f || !State.bReverseEnabled)
 		{
-			Movement->SetBrakeInput(-NormAccel);
-			Movement->SetThrottleInput(0.0f);
+			InOutInputs.Brake = -NormAccel;
+			InOutInputs.Throttle = 0.0f;
 		}
 		else
 		{
-			Movement->SetTargetGear(-1, false);
-			Movement->SetThrottleInput(-NormAccel);
-			Movement->SetBrakeInput(0.0f);
+			InOutInputs.TargetGear = -1;
+			InOutInputs.Throttle = -NormAccel;
+			InOutInputs.Brake = 0.0f;
 		}
 	}
 }
@@ -0,0 +1,83 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#pragma once
+
+#include "TempoSubsystems.h"
+
+#include "CoreMinimal.h"
+
+#include "GroundSnapCacheSubsystem.generated.h"
+
+struct FCollisionQueryParams;
+
+struct FGroundSnapStats
+{
+	// Since the last ResetStats.
+	int32 NumSnaps = 0;
+	int32 NumSkippedSnaps = 0;
+	int32 NumTraces = 0;
+	int32 NumCacheHits = 0;
+};
+
+// The ground found below UGroundSnapComponents, shared between them: the plane of the static surface in each cell of a
+// uniform grid over the horizontal plane, where one plane of one component covers the whole cell. A component that
+// opts in (bUseGroundCache) looks for the ground below each of its corners here first, and only traces for it when
+// the corner's cell has none, so agents crowding over the same ground trace it once between them. A hit is only cached
+// once the cell is known to be on that plane: within the bounds of the component that was hit, with a second trace at
+// the cell's far corner finding the same component on the same plane. Cells across edges, steps, or curved ground
+// fail that and are always traced. Only for ground that doesn't move: call InvalidateRegion (or ClearCache) when it
+// does. Also counts how often the components snap, skip, trace, and hit the cache, for GetStats and
+// "stat TempoGroundSnap".
+UCLASS()
+class TEMPOMOVEMENT_API UGroundSnapCacheSubsystem : public UTempoGameWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Clears the cache.
+	void SetCellSize(float InCellSize);
+
+	float GetCellSize() const { return CellSize; }
+
+	// Finds the cached ground below Location, if its cell has any between MinZ and MaxZ.
+	bool FindGround(const FVector2D& Location, double MinZ, double MaxZ, FVector& OutGround);
+
+	// Caches Hit as the ground in its cell, if it is on a static, not too steep surface that covers the cell. Traces
+	// once (with Params) to check that it does.
+	void AddGround(const FHitResult& Hit, const FCollisionQueryParams& Params);
+
+	void InvalidateRegion(const FBox2D& Region);
+
+	void ClearCache();
+
+	int32 NumCachedCells() const { return Cells.Num(); }
+
+	void CountSnap(bool bSkipped);
+
+	void CountTrace();
+
+	const FGroundSnapStats& GetStats() const { return Stats; }
+
+	void ResetStats() { Stats = FGroundSnapStats(); }
+
+private:
+	struct FGroundPlane
+	{
+		FVector Point = FVector::ZeroVector;
+		FVector Normal = FVector::UpVector;
+
+		double HeightAt(const FVector2D& Location) const
+		{
+			return Point.Z - (Normal.X * (Location.X - Point.X) + Normal.Y * (Location.Y - Point.Y)) / Normal.Z;
+		}
+	};
+
+	TMap<int64, FGroundPlane> Cells;
+
+	// Cells whose ground failed the check in AddGround, so it isn't traced again.
+	TSet<int64> UncachedCells;
+
+	float CellSize = 50.0f;
+
+	FGroundSnapStats Stats;
+};
@@ -17,6 +17,15 @@ public:
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
 							   FActorComponentTickFunction* ThisTickFunction) override;
 
+	void SetExtentsOverride(const FVector2D& InExtentsOverride);
+
+	void SetResnapThresholds(float InResnapDistance, float InResnapAngle);
+
+	void SetUseGroundCache(bool bInUseGroundCache) { bUseGroundCache = bInUseGroundCache; }
+
+	// Trace for the ground again on the next tick, even if the owner hasn't moved (e.g. because the ground has).
+	void InvalidateSnap() { LastSnap.Reset(); }
+
 protected:
 	// If true, we will use the ExtentsOverride below rather than the owner's extents.
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
@@ -42,4 +51,34 @@ protected:
 	// If true, we will include hidden components in our extents calculation.
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta=(EditCondition="!bOverrideOwnerExtents"))
 	bool bIncludeHiddenComponentsInExtents = false;
+
+	// We will only measure the owner's extents and trace for the ground again once the owner has moved this far (cm)
+	// horizontally since we last did. Until then, we reuse the ground we found then. 0 traces every tick.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta=(ClampMin=0.0))
+	float ResnapDistance = 1.0;
+
+	// Likewise, once the owner has turned this far (degrees) since we last traced.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta=(ClampMin=0.0))
+	float ResnapAngle = 0.5;
+
+	// If true, we will share the ground we find with every other component that sets this, through the world's
+	// UGroundSnapCacheSubsystem, and use the ground they found rather than tracing where we can. Only for ground
+	// that doesn't move.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	bool bUseGroundCache = false;
+
+private:
+	// Where the owner was, horizontally, and which way it faced when we last traced for the ground, and the average
+	// normal and height we found then (unset if every normal was too steep).
+	struct FGroundSnap
+	{
+		FVector2D Location = FVector2D::ZeroVector;
+		double Yaw = 0.0;
+		TOptional<FVector> Normal;
+		TOptional<double> Height;
+	};
+	TOptional<FGroundSnap> LastSnap;
+
+	// Put the owner on the ground with the given normal and height, keeping its horizontal location.
+	void SnapOwner(const TOptional<FVector>& Normal, const TOptional<double>& Height) const;
 };
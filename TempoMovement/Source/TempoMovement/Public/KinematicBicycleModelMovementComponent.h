@@ -17,7 +17,12 @@ public:
 
 	virtual float ComputeNormalizedSteeringForYawRate(float TargetYawRateDegS, float CurrentLinearVelocityCmS) const override;
 
+	// The bicycle model behind SimulateMotion, for a vehicle heading HeadingYawDeg.
+	static FTempoTwist SimulateBicycleMotion(double HeadingYawDeg, float Steering, float NewLinearVelocity, float InWheelbase, float InAxleRatio);
+
 protected:
+	friend class UKinematicVehicleBatchSubsystem;
+
 	// The distance between the front and rear axles.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	float Wheelbase = 100.0; // CM
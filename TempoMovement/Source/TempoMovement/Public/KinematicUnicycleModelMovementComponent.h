@@ -17,7 +17,12 @@ public:
 
 	virtual float ComputeNormalizedSteeringForYawRate(float TargetYawRateDegS, float CurrentLinearVelocityCmS) const override;
 
+	// The unicycle model behind SimulateMotion, for a vehicle heading HeadingYawDeg.
+	static FTempoTwist SimulateUnicycleMotion(double HeadingYawDeg, float Steering, float NewLinearVelocity, float AngularVelocityFactor);
+
 protected:
+	friend class UKinematicVehicleBatchSubsystem;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	float SteeringToAngularVelocityFactor = 1.0;
 };
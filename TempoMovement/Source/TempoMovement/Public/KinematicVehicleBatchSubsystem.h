@@ -0,0 +1,90 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#pragma once
+
+#include "KinematicVehicleMovementComponent.h"
+#include "TempoSubsystems.h"
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+
+#include "KinematicVehicleBatchSubsystem.generated.h"
+
+class UKinematicVehicleBatchSubsystem;
+
+// The motion models a UKinematicVehicleBatchSubsystem can step.
+enum class EKinematicVehicleModel : uint8
+{
+	Bicycle,
+	Unicycle,
+};
+
+// Runs UKinematicVehicleBatchSubsystem's pass in TG_PrePhysics, where the vehicles' own ticks would have.
+USTRUCT()
+struct FKinematicVehicleBatchTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UKinematicVehicleBatchSubsystem* Subsystem = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FKinematicVehicleBatchTickFunction> : public TStructOpsTypeTraitsBase2<FKinematicVehicleBatchTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+// Steps every kinematic vehicle that opts in (bUseBatchIntegration) in one pass per frame, rather than in each
+// vehicle's own component tick. Each frame the vehicles' inputs and state are gathered into packed arrays, the
+// motion models run over them in parallel, and the results are written back to the vehicles in one loop. The
+// models run through the same functions as the per-component tick, so the motion is bit-identical.
+UCLASS()
+class TEMPOMOVEMENT_API UKinematicVehicleBatchSubsystem : public UTempoGameWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Returns false if Vehicle's motion model can't be batched, in which case it should keep ticking itself.
+	bool RegisterVehicle(UKinematicVehicleMovementComponent* Vehicle);
+
+	// Returns false if Vehicle wasn't registered.
+	bool UnregisterVehicle(UKinematicVehicleMovementComponent* Vehicle);
+
+	int32 NumVehicles() const { return Vehicles.Num(); }
+
+	// Steps every registered vehicle by DeltaTime (dilated by its owner's CustomTimeDilation, as its own tick would
+	// be). Called by the pass's tick function.
+	void StepVehicles(float DeltaTime);
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Deinitialize() override;
+
+private:
+	FKinematicVehicleBatchTickFunction StepTickFunction;
+
+	// The registered vehicles and their motion models, in the same order, which is the order they register in (and
+	// so the order their motion is applied in, as it would be by their own ticks).
+	TArray<TWeakObjectPtr<UKinematicVehicleMovementComponent>> Vehicles;
+	TArray<EKinematicVehicleModel> Models;
+
+	// Packed per-vehicle state, gathered each step in the order above. Kept between steps to reuse the allocations.
+	TArray<float> DeltaTimes;
+	TArray<double> Headings;
+	TArray<float> LinearVelocities;
+	TArray<FVector> ControlInputs;
+	TArray<FKinematicVehicleLimits> Limits;
+	// Wheelbase and axle ratio (Bicycle), or steering to angular velocity factor (Unicycle).
+	TArray<FVector2f> ModelParameters;
+
+	// Packed results of each step.
+	TArray<float> NewLinearVelocities;
+	TArray<FTempoTwist> Motions;
+};
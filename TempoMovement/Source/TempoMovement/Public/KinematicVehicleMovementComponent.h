@@ -9,12 +9,32 @@
 #include "GameFramework/PawnMovementComponent.h"
 #include "KinematicVehicleMovementComponent.generated.h"
 
+// A kinematic vehicle's speed and steering limits, packed so that many vehicles can be stepped at once (see
+// UKinematicVehicleBatchSubsystem).
+struct FKinematicVehicleLimits
+{
+	bool bReverseEnabled = false;
+	float MaxAcceleration = 0.0f;
+	float MaxDeceleration = 0.0f;
+	float MaxSpeed = 0.0f;
+	float MaxSteering = 0.0f;
+	float NoInputNormalizedDeceleration = 0.0f;
+};
+
 UCLASS(Abstract, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class TEMPOMOVEMENT_API UKinematicVehicleMovementComponent : public UPawnMovementComponent, public ITempoAngularVelocityInterface
 {
 	GENERATED_BODY()
 
 public:
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 	virtual FVector GetAngularVelocity() const override { return FVector(0.0, 0.0, AngularVelocity); }
@@ -23,6 +43,9 @@ public:
 
 	bool GetReverseEnabled() const { return bReverseEnabled; }
 
+	// Moves the vehicle into or out of the batch right away if it has begun play (see bUseBatchIntegration).
+	void SetUseBatchIntegration(bool bInUseBatchIntegration);
+
 	// Signed forward speed in cm/s (Unreal native).
 	float GetLinearVelocity() const { return LinearVelocity; }
 
@@ -33,7 +56,27 @@ public:
 	// |v| near zero).
 	virtual float ComputeNormalizedSteeringForYawRate(float TargetYawRateDegS, float CurrentLinearVelocityCmS) const PURE_VIRTUAL(UKinematicVehicleMovementComponent::ComputeNormalizedSteeringForYawRate, return 0.0f;);
 
+	FKinematicVehicleLimits GetLimits() const;
+
+	// Longitudinal and steering model: the new signed speed (cm/s) and the steering angle (deg) after DeltaTime,
+	// given the control input in the vehicle's frame (X is normalized acceleration, Y normalized steering). Shared by
+	// the per-component tick and UKinematicVehicleBatchSubsystem, so both give bit-identical results.
+	static void StepSpeedAndSteering(float DeltaTime, const FVector& ControlInput, float CurrentLinearVelocity, const FKinematicVehicleLimits& Limits,
+		float& OutNewLinearVelocity, float& OutSteeringAngle);
+
 protected:
+	friend class UKinematicVehicleBatchSubsystem;
+
+	// Consumes this frame's movement input and returns it in the vehicle's frame (or the player's control frame).
+	FVector ConsumeControlInput();
+
+	// Registers with the world's UKinematicVehicleBatchSubsystem if bUseBatchIntegration is set and the model can be
+	// batched, and stops ticking. Otherwise unregisters, and ticks again if it was batched.
+	void UpdateBatchRegistration();
+
+	// Moves and turns the owner by Motion over DeltaTime, and records the new velocities.
+	void ApplyMotion(float DeltaTime, float NewLinearVelocity, const FTempoTwist& Motion);
+
 	// Forward motion model. Returns the resulting world-frame motion as a Twist: Linear is the
 	// world-frame velocity (cm/s), Angular.Z is the yaw rate (deg/s, left-handed).
 	virtual FTempoTwist SimulateMotion(float DeltaTime, float Steering, float NewLinearVelocity) PURE_VIRTUAL(UKinematicVehicleMovementComponent::SimulateMotion, return FTempoTwist(););
@@ -57,6 +100,13 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(UIMin=0.0, UIMax=1.0, ClampMin=0.0, ClampMax=1.0))
 	float NoInputNormalizedDeceleration = 0.0;
 
+	// If true, this vehicle is stepped together with every other one that opts in, in one batched pass per frame by
+	// the world's UKinematicVehicleBatchSubsystem, instead of in its own tick. The motion is bit-identical; only the
+	// cost differs. Native subclasses of the bicycle and unicycle models keep ticking themselves, since they may
+	// override SimulateMotion; Blueprint subclasses are batched. Set it with SetUseBatchIntegration once play has begun.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bUseBatchIntegration = false;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
 	float LinearVelocity = 0.0; // CM/S
 
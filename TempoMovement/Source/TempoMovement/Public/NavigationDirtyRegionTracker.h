@@ -0,0 +1,31 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Remembers the navigation-relevant bounds of every Actor in a world, so that a navmesh rebuild can be limited
+// to the regions that changed since the last one.
+class TEMPOMOVEMENT_API FNavigationDirtyRegionTracker
+{
+public:
+	// Records the current bounds of every navigation-relevant Actor in World as the baseline.
+	void Reset(const UWorld* World);
+
+	// Returns the regions that changed since the baseline: the old and new bounds of Actors that moved or changed
+	// shape, the bounds of Actors that were spawned, and the last known bounds of Actors that were destroyed or
+	// stopped affecting navigation. The current state becomes the new baseline.
+	TArray<FBox> CollectDirtyRegions(const UWorld* World);
+
+	// Makes the current state the baseline only for the changes that lie entirely within RebuiltRegions, since those
+	// were rebuilt. Changes that reach outside them stay dirty for the next CollectDirtyRegions.
+	void MarkRegionsRebuilt(const UWorld* World, const TArray<FBox>& RebuiltRegions);
+
+	// The union of the bounds of Actor's components that affect navigation. Invalid if none do.
+	static FBox GetNavigationRelevantBounds(const AActor* Actor);
+
+	int32 NumTrackedActors() const { return ActorBounds.Num(); }
+
+private:
+	TMap<TWeakObjectPtr<const AActor>, FBox> ActorBounds;
+};
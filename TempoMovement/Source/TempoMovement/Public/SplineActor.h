@@ -9,6 +9,17 @@
 
 class USplineComponent;
 
+// How ASplineActor::SetSplinePoints changed the spline.
+enum class ESplineGeometryUpdate : uint8
+{
+	// The spline already had these points.
+	Unchanged,
+	// The spline had as many points, which were moved in place.
+	UpdatedInPlace,
+	// The number of points changed, so the spline was rebuilt.
+	Rebuilt
+};
+
 // A bare actor whose root is a USplineComponent, the way AStaticMeshActor is a bare actor whose root
 // is a UStaticMeshComponent (Unreal ships no equivalent for splines). It is pure geometry, editable
 // in the level with the spline gizmo and configurable over the SetSplinePoints RPC. It carries no
@@ -25,6 +36,16 @@ public:
 
 	USplineComponent* GetSpline() const { return Spline; }
 
+	// Sets the spline's points from world-space locations and tangents (each tangent sets both the arrive and leave
+	// tangent). Moves the existing points in place when the number of points is unchanged, and leaves the spline
+	// (and its geometry version) alone when the points are too.
+	ESplineGeometryUpdate SetSplinePoints(TConstArrayView<FVector> Locations, TConstArrayView<FVector> Tangents);
+
+	// The spline component's curve version, which each USplineComponent::UpdateSpline increments (as SetSplinePoints
+	// does when it changes the spline, and the editor does after each edit), so followers only re-examine the spline
+	// when it has changed.
+	uint32 GetGeometryVersion() const;
+
 protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spline")
 	USplineComponent* Spline = nullptr;
@@ -28,6 +28,8 @@ public:
 protected:
 	virtual void OnPossess(APawn* InPawn) override;
 
+	virtual void OnUnPossess() override;
+
 	virtual void BeginPlay() override;
 
 private:
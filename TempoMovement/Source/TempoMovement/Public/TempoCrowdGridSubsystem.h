@@ -0,0 +1,87 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#pragma once
+
+#include "TempoSubsystems.h"
+
+#include "CoreMinimal.h"
+
+#include "TempoCrowdGridSubsystem.generated.h"
+
+// A crowd agent found by UTempoCrowdGridSubsystem::FindNeighbors.
+struct FTempoCrowdNeighbor
+{
+	TWeakObjectPtr<AActor> Agent;
+	// Where the agent was when the grid was last built.
+	FVector Location = FVector::ZeroVector;
+	double DistanceSquared = 0.0;
+};
+
+struct FTempoCrowdGridStats
+{
+	// As of the last build.
+	int32 NumAgents = 0;
+	int32 NumOccupiedCells = 0;
+	int32 MaxAgentsPerCell = 0;
+	// Since the last build.
+	int32 NumQueries = 0;
+	int32 NumCandidatesTested = 0;
+};
+
+// A uniform hash grid over the crowd's agents (pedestrians and other Actors to avoid), so finding an agent's
+// neighbors costs a few cell lookups rather than a search over the whole crowd. The grid is rebuilt at most once per
+// frame, by the frame's first query, so it costs nothing in frames without queries. The grid is over the horizontal
+// plane; queries still measure distance in 3D. Agents' locations are gathered on the game thread, and their cells
+// computed in parallel. The stats are also published to "stat TempoCrowd".
+UCLASS()
+class TEMPOMOVEMENT_API UTempoCrowdGridSubsystem : public UTempoTickableGameWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Registrations are counted, so an agent registered by several owners (its controller and its avoidance
+	// component, say) stays in the grid until each has unregistered it.
+	void RegisterAgent(AActor* Agent);
+
+	void UnregisterAgent(AActor* Agent);
+
+	int32 NumAgents() const { return Agents.Num(); }
+
+	// Takes effect at the next build. Works best at about the typical query radius.
+	void SetCellSize(float InCellSize);
+
+	float GetCellSize() const { return CellSize; }
+
+	// Rebuilds the grid from the registered agents' current locations. Called by the frame's first FindNeighbors.
+	void BuildGrid();
+
+	// Finds the agents within Radius of Location as of the last build, at most MaxNeighbors of them (the nearest), in
+	// order of distance. Returns how many it found. Rebuilds the grid first if it hasn't been built this frame. Call
+	// from the game thread.
+	int32 FindNeighbors(const FVector& Location, float Radius, int32 MaxNeighbors, TArray<FTempoCrowdNeighbor>& OutNeighbors, const AActor* IgnoredAgent = nullptr);
+
+	const FTempoCrowdGridStats& GetStats() const { return Stats; }
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+private:
+	TArray<TWeakObjectPtr<AActor>> Agents;
+	TMap<TWeakObjectPtr<AActor>, int32> NumRegistrations;
+
+	float CellSize = 500.0f;
+
+	// The grid as of the last build: the agents then, their locations and cells, their indices sorted by cell, and
+	// each occupied cell's first index into SortedAgents and number of agents.
+	TArray<TWeakObjectPtr<AActor>> GridAgents;
+	TArray<FVector> Locations;
+	TArray<int64> CellKeys;
+	TArray<int32> SortedAgents;
+	TMap<int64, TPair<int32, int32>> Cells;
+	float GridCellSize = 0.0f;
+	// Whether the grid was built before this frame (or never), and must be rebuilt before it is queried.
+	bool bGridStale = true;
+
+	FTempoCrowdGridStats Stats;
+};
@@ -2,12 +2,19 @@
 
 #pragma once
 
+#include "TempoCrowdGridSubsystem.h"
+
 #include "Components/ActorComponent.h"
 #include "CoreMinimal.h"
 #include "Navigation/CrowdAgentInterface.h"
 
 #include "TempoCrowdObstacleAvoidanceComponent.generated.h"
 
+class UCapsuleComponent;
+class UPawnMovementComponent;
+
+// Registers its owner with the crowd manager (for the crowd to avoid) and with the crowd grid (so the owner's nearest
+// crowd agents can be found with GetNeighbors).
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class TEMPOMOVEMENT_API UTempoCrowdObstacleAvoidanceComponent : public UActorComponent, public ICrowdAgentInterface
 {
@@ -25,4 +32,20 @@ public:
 	virtual int32 GetCrowdAgentAvoidanceGroup() const override { return 1; }
 	virtual int32 GetCrowdAgentGroupsToAvoid() const override { return MAX_int32; }
 	virtual int32 GetCrowdAgentGroupsToIgnore() const override { return 0; }
+
+	// The crowd agents within NeighborRadius of the owner, at most MaxNeighbors of them (the nearest), in order of
+	// distance, as of the crowd grid's last build. Returns how many there are.
+	int32 GetNeighbors(TArray<FTempoCrowdNeighbor>& OutNeighbors) const;
+
+protected:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tempo", meta=(ClampMin=0.0, UIMin=0.0))
+	float NeighborRadius = 500.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tempo", meta=(ClampMin=1, UIMin=1))
+	int32 MaxNeighbors = 8;
+
+private:
+	// Found once in BeginPlay, rather than in each of the crowd manager's calls for them.
+	TWeakObjectPtr<const UCapsuleComponent> Capsule;
+	TWeakObjectPtr<const UPawnMovementComponent> Movement;
 };
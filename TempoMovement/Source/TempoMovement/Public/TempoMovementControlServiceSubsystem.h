@@ -2,11 +2,15 @@
 
 #pragma once
 
+#include "NavigationDirtyRegionTracker.h"
+#include "TempoCoreTypes.h"
+#include "TempoMovementTypes.h"
 #include "TempoServiceProvider.h"
 #include "TempoServer.h"
 #include "TempoSubsystems.h"
 
 #include "CoreMinimal.h"
+#include "Misc/TVariant.h"
 #include "Navigation/PathFollowingComponent.h"
 
 #include "TempoMovementControlServiceSubsystem.generated.h"
@@ -22,10 +26,18 @@ namespace TempoMovement
 	class NormalizedDrivingCommand;
 	class VelocityCommand;
 	class AccelerationCommand;
+	class CommandFrame;
+	class CommandAck;
 	class NavigablePawnsResponse;
 	class PawnMoveToLocationRequest;
 	class PawnMoveToLocationResponse;
+	class PawnsMoveToLocationsRequest;
+	class PawnMoveCompletion;
+	class RebuildNavigationRequest;
+	class RebuildNavigationResponse;
 	class SetSplinePointsRequest;
+	class SetSplinePointsBatchRequest;
+	class SetSplinePointsBatchResponse;
 	class ConfigureTrajectoryFollowingRequest;
 }
 
@@ -40,8 +52,65 @@ struct FPendingPawnMoveInfo
 	TResponseDelegate<TempoMovement::PawnMoveToLocationResponse> ResponseContinuation;
 };
 
+// One move of a PawnsMoveToLocations request, from its path query until the pawn's move completes.
+struct FBatchedPawnMove
+{
+	TWeakObjectPtr<class AAIController> Controller;
+	FString Pawn;
+	FVector Destination = FVector::ZeroVector;
+	int32 MoveIndex = 0;
+};
+
+struct FPawnMoveBatch
+{
+	TResponseDelegate<TempoMovement::PawnMoveCompletion> ResponseContinuation;
+	// Moves still waiting to start their path query, in request order, from NextQueuedMove on.
+	TArray<FBatchedPawnMove> QueuedMoves;
+	int32 NextQueuedMove = 0;
+	int32 MaxPathQueriesPerFrame = 0;
+	// Moves without a completion yet.
+	int32 NumUnfinishedMoves = 0;
+};
+
+// A command received on a StreamCommands stream, converted to Unreal-native units.
+using FStreamedCommand = TVariant<FNormalizedDrivingInput, FTempoTwist, FTempoAccel>;
+
+struct FPendingStreamedCommand
+{
+	uint64 FrameSequence = 0;
+	FStreamedCommand Command;
+};
+
+struct FStreamedCommandError
+{
+	uint64 FrameSequence = 0;
+	FString Pawn;
+	FString Error;
+};
+
+// One StreamCommands stream, and what it has sent since its commands were last applied.
+struct FCommandStream
+{
+	TResponseDelegate<TempoMovement::CommandAck> ResponseContinuation;
+	// The latest command for each pawn, by pawn name.
+	TMap<FString, FPendingStreamedCommand> PendingCommands;
+	// Commands that could not even be read.
+	TArray<FStreamedCommandError> PendingErrors;
+	int32 NumPendingFrames = 0;
+	uint64 LatestFrameSequence = 0;
+	double LatestClientTime = 0.0;
+};
+
+struct FPendingNavigationBuild
+{
+	double StartTime = 0.0;
+	int32 NumDirtyRegions = 0;
+	int32 NumTiles = 0;
+	TResponseDelegate<TempoMovement::RebuildNavigationResponse> ResponseContinuation;
+};
+
 UCLASS()
-class TEMPOMOVEMENT_API UTempoMovementControlServiceSubsystem : public UTempoGameWorldSubsystem, public ITempoServiceProvider
+class TEMPOMOVEMENT_API UTempoMovementControlServiceSubsystem : public UTempoTickableGameWorldSubsystem, public ITempoServiceProvider
 {
 	GENERATED_BODY()
 
@@ -52,6 +121,12 @@ public:
 
 	virtual void Deinitialize() override;
 
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
 	void GetCommandablePawns(const TempoCore::Empty& Request, const TResponseDelegate<TempoMovement::CommandablePawnsResponse>& ResponseContinuation) const;
 
 	void CommandVehicle(const TempoMovement::NormalizedDrivingCommand& Request, const TResponseDelegate<TempoCore::Empty>& ResponseContinuation) const;
@@ -60,19 +135,74 @@ public:
 
 	void CommandAcceleration(const TempoMovement::AccelerationCommand& Request, const TResponseDelegate<TempoCore::Empty>& ResponseContinuation) const;
 
+	// Holds each frame's commands, the latest per pawn, until ApplyStreamedCommands.
+	void StreamCommands(const TempoMovement::CommandFrame& Request, const TResponseDelegate<TempoMovement::CommandAck>& ResponseContinuation);
+
+	// Applies the commands held since the last call, and acknowledges them on their streams. Called each time the
+	// server has handled its events, so commands received in a frame are applied before that frame's Actors tick.
+	void ApplyStreamedCommands();
+
 	void GetNavigablePawns(const TempoCore::Empty& Request, const TResponseDelegate<TempoMovement::NavigablePawnsResponse>& ResponseContinuation) const;
 
 	void PawnMoveToLocation(const TempoMovement::PawnMoveToLocationRequest& Request, const TResponseDelegate<TempoMovement::PawnMoveToLocationResponse>& ResponseContinuation);
 
-	void RebuildNavigation(const TempoCore::Empty& Request, const TResponseDelegate<TempoCore::Empty>& ResponseContinuation) const;
+	// The most path queries PawnsMoveToLocations starts per frame, across every request.
+	static constexpr int32 MaxPathQueriesPerFrame = 32;
+
+	// Moves many pawns at once. Path queries run asynchronously, at most max_path_queries_per_frame of a request's and
+	// MaxPathQueriesPerFrame of every request's starting each frame, and each move's result is streamed back when it
+	// completes. The last result finishes the stream.
+	void PawnsMoveToLocations(const TempoMovement::PawnsMoveToLocationsRequest& Request, const TResponseDelegate<TempoMovement::PawnMoveCompletion>& ResponseContinuation);
+
+	// Rebuilds the whole navmesh and responds. Incremental requests instead rebuild the tiles touched by the requested
+	// regions, or by the Actors that changed since the last rebuild, and respond when the tiles are done, either right
+	// away (wait) or from a later Tick.
+	void RebuildNavigation(const TempoMovement::RebuildNavigationRequest& Request, const TResponseDelegate<TempoMovement::RebuildNavigationResponse>& ResponseContinuation);
 
 	void SetSplinePoints(const TempoMovement::SetSplinePointsRequest& Request, const TResponseDelegate<TempoCore::Empty>& ResponseContinuation) const;
 
+	// Sets many splines' points, looking the splines up once for the whole batch. Handles both SetSplinePointsBatch
+	// and each batch sent on a StreamSplinePoints stream.
+	void SetSplinePointsBatch(const TempoMovement::SetSplinePointsBatchRequest& Request, const TResponseDelegate<TempoMovement::SetSplinePointsBatchResponse>& ResponseContinuation) const;
+
 	void ConfigureTrajectoryFollowing(const TempoMovement::ConfigureTrajectoryFollowingRequest& Request, const TResponseDelegate<TempoCore::Empty>& ResponseContinuation) const;
 
 protected:
 	TMap<FAIRequestID, FPendingPawnMoveInfo> PendingPawnMoves;
 
+	// Keyed by the stream's response delegate.
+	TMap<FDelegateHandle, FPawnMoveBatch> PawnMoveBatches;
+
+	// Batched moves whose pawns are moving, and the streams they belong to.
+	TMap<FAIRequestID, TPair<FDelegateHandle, FBatchedPawnMove>> PendingBatchedPawnMoves;
+
+	// Starts the batch's next path queries, as many as it and the frame's remaining PathQueryBudget allow.
+	void DispatchPathQueries(FDelegateHandle BatchHandle, FPawnMoveBatch& Batch, int32& PathQueryBudget);
+
+	void OnBatchedPathFound(uint32 QueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path, FDelegateHandle BatchHandle, FBatchedPawnMove Move);
+
+	void UpdatePawnMoveBatches();
+
+	// Which batch starts its path queries first next frame.
+	int32 FirstPathQueryBatch = 0;
+
+	// How many pending moves (single or batched) are waiting on each controller's move completed event, which is
+	// bound while any are.
+	TMap<TWeakObjectPtr<class AAIController>, int32> MoveCompletedBindings;
+
+	void BindMoveCompleted(class AAIController* Controller);
+
+	void UnbindMoveCompleted(const TWeakObjectPtr<class AAIController>& Controller);
+
+	TArray<FPendingNavigationBuild> PendingNavigationBuilds;
+
+	// Keyed by the stream's response delegate.
+	TMap<FDelegateHandle, FCommandStream> CommandStreams;
+
+	FDelegateHandle EventsHandledHandle;
+
+	FNavigationDirtyRegionTracker NavigationDirtyRegions;
+
 	UFUNCTION()
 	void OnPawnMoveCompleted(FAIRequestID RequestID, EPathFollowingResult::Type Result);
 };
@@ -30,9 +30,21 @@ public:
 	virtual bool HandleAccelerationCommand(const FTempoAccel& Accel) override;
 
 protected:
+	friend class UWheeledVehicleControlBatchSubsystem;
+
+	virtual void OnPossess(APawn* InPawn) override;
+
+	virtual void OnUnPossess() override;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	bool bPersistSteering = true;
 
+	// If true, this controller is updated together with every other one that opts in, in one batched pass per frame
+	// by the world's UWheeledVehicleControlBatchSubsystem, instead of in its own tick (which still runs, but skips
+	// TickControl while it is possessing a pawn). The vehicle's inputs are bit-identical; only the cost differs.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bUseBatchControl = false;
+
 	// Watchdog timeout for closed-loop commands. After this many seconds without a fresh
 	// velocity or acceleration command, the tracked setpoint is reset to zero (the vehicle
 	// decelerates to a stop). Set to 0 to disable (latch forever).
@@ -55,6 +67,9 @@ private:
 
 	EControlMode ControlMode = EControlMode::None;
 
+	// Whether the batch subsystem runs TickControl, from OnPossess to OnUnPossess.
+	bool bControlBatched = false;
+
 	// Direct setpoint when in Velocity mode. In Acceleration mode this is the integrated
 	// target updated each tick by AccelTarget.
 	FTempoTwist VelocityTarget;
@@ -72,6 +87,14 @@ private:
 	};
 	TOptional<FLastDrivingInput> LastDrivingInput;
 
+	// Everything Tick does after the base class's.
+	void TickControl(float DeltaTime);
+
+	bool IsClosedLoop() const { return ControlMode == EControlMode::Velocity || ControlMode == EControlMode::Acceleration; }
+
+	// Apply the watchdog and, in Acceleration mode, integrate AccelTarget into VelocityTarget.
+	void UpdateVelocityTarget(float DeltaTime);
+
 	void TickDriving(APawn* ControlledPawn);
 	void TickClosedLoop(float DeltaTime, APawn* ControlledPawn);
 };
@@ -0,0 +1,60 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// A lookup table from a parameter (trajectory time, or spline input key) to the distance travelled by then, built
+// by integrating a rate (speed, or the length of the spline's tangent) with adaptive Simpson quadrature. Each
+// interval between knots is halved until both its integral and the cubic Hermite interpolant across it are within
+// the tolerance, so smooth stretches get few knots and sharp ones many. Lookups are a binary search plus a cubic.
+//
+// The rate must be smooth between consecutive breaks (curve keys, or spline points) but may jump at one, so it is
+// evaluated per segment: Rate(Segment, Parameter) for Parameter in [Breaks[Segment], Breaks[Segment + 1]].
+class TEMPOMOVEMENT_API FTrajectoryArcLengthTable
+{
+public:
+	using FRateFunction = TFunctionRef<double(int32 Segment, double Parameter)>;
+
+	// Rebuilds the table over [Breaks[0], Breaks.Last()] to within Tolerance (in units of distance). If the table
+	// was last built from the same first break and tolerance, the knots up to Breaks[FirstChangedSegment] are kept
+	// and only the later segments are integrated again, so a caller whose rate only changed in the tail (for
+	// example, when a trajectory is re-sent with new later keys) pays only for the tail. Returns the number of
+	// rate evaluations.
+	int32 Build(FRateFunction Rate, TArrayView<const double> Breaks, double Tolerance, int32 FirstChangedSegment = 0);
+
+	void Reset();
+
+	// Distance at Parameter, which is clamped to the table's range. 0 if the table is empty.
+	double Evaluate(double Parameter) const;
+
+	// The parameter at which the distance reaches Distance, which is clamped to the table's range. Only meaningful
+	// for non-negative rates (where distance never decreases). 0 if the table is empty.
+	double Invert(double Distance) const;
+
+	bool IsEmpty() const { return Parameters.IsEmpty(); }
+
+	int32 NumKnots() const { return Parameters.Num(); }
+
+	double GetTotalDistance() const { return Distances.IsEmpty() ? 0.0 : Distances.Last(); }
+
+	// The tolerance the table was last built with. 0 if it is empty.
+	double GetTolerance() const { return BuildTolerance; }
+
+private:
+	// Integrates [A, B] (of which M is the midpoint and Whole the Simpson estimate) and appends its knots.
+	void Refine(FRateFunction Rate, int32 Segment, double A, double RateA, double M, double RateM, double B, double RateB,
+		double Whole, double Tolerance, double IntegralTolerancePerUnit, int32 Depth, int32& NumEvaluations);
+
+	void AddKnot(double Parameter, double Distance, double Rate);
+
+	// Tolerance the current knots were built with.
+	double BuildTolerance = 0.0;
+
+	// Knots, sorted by parameter. A knot at a break has the rate arriving from the segment before it and the rate
+	// departing into the segment after it; elsewhere the two are equal.
+	TArray<double> Parameters;
+	TArray<double> Distances;
+	TArray<double> ArrivingRates;
+	TArray<double> DepartingRates;
+};
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "TrajectoryArcLengthTable.h"
 #include "WheeledVehicleVelocityController.h"
 
 #include "Curves/CurveFloat.h"
@@ -110,6 +111,21 @@ struct FTrajectoryFollowingConfig
 	ETrajectoryEndBehavior EndBehavior = ETrajectoryEndBehavior::Clamp;
 };
 
+// One spline point, as far as the shape of the spline between points is concerned (local space).
+struct FTrajectorySplinePoint
+{
+	FVector Location = FVector::ZeroVector;
+	FVector ArriveTangent = FVector::ZeroVector;
+	FVector LeaveTangent = FVector::ZeroVector;
+	// ESplinePointType::Type
+	uint8 Type = 0;
+
+	bool operator==(const FTrajectorySplinePoint& Other) const
+	{
+		return Location == Other.Location && ArriveTangent == Other.ArriveTangent && LeaveTangent == Other.LeaveTangent && Type == Other.Type;
+	}
+};
+
 // Drives a possessed pawn along an ASplineActor. Each tick it samples the spline at the time since
 // following began (mapping time onto the spline via the config's speed model) and either teleports
 // the pawn to the target pose, or steers toward it (letting the pawn and its movement component
@@ -166,23 +182,41 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
 	bool bEnableDebugDraw = false;
 
+	// Largest error (cm) allowed in the lookup tables that map time to distance (SpeedVsTime) and distance to the
+	// spline's input key. The tables refine adaptively until they are within it.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Trajectory", meta = (ClampMin = 0.001))
+	double ArcLengthTolerance = 0.1;
+
 	// Sample the trajectory at a time already normalized to [0, GetDuration()].
 	FTransform SampleAtTime(float Time) const;
 
 	// Distance along the spline (cm) at the given time, for the arc-length speed modes.
 	double DistanceAtTime(float Time) const;
 
-	// Integrate Config.TimeToSpeed into the cumulative SpeedDistanceCache (used by SpeedVsTime).
-	// Rebuilt whenever FollowTrajectory adopts a new config.
+	// Integrate Config.TimeToSpeed into TimeDistanceTable (used by SpeedVsTime). Rebuilt whenever FollowTrajectory
+	// adopts a new config; only the keys from the first changed one on are integrated again.
 	void RebuildSpeedDistanceCache();
 
+	// Rebuild SplineDistanceTable if the spline's points changed since it was built, from the first changed point
+	// on. Called from FollowTrajectory, and from Tick when the spline's geometry version has changed.
+	void RefreshSplineDistanceTable();
+
 private:
 	// Time (seconds) elapsed along the trajectory, accumulated from the per-tick sim delta rather
 	// than absolute world time, so it holds steady whenever the simulation is paused or stepped.
 	// Reset to 0 when FollowTrajectory (re)starts following.
 	double ElapsedSeconds = 0.0;
 
-	// Cumulative distance (cm) vs. time, integrated from Config.TimeToSpeed for the SpeedVsTime mode.
-	// Runtime state, rebuilt in FollowTrajectory; not serialized.
-	FRichCurve SpeedDistanceCache;
+	// Cumulative distance (cm) vs. time, integrated from Config.TimeToSpeed for the SpeedVsTime mode, and the keys
+	// it was integrated from. Runtime state, rebuilt in FollowTrajectory; not serialized.
+	FTrajectoryArcLengthTable TimeDistanceTable;
+	TArray<FRichCurveKey> TimeDistanceTableKeys;
+
+	// Cumulative distance (cm) vs. spline input key, inverted to sample the arc-length speed modes, and the (local
+	// space) spline points it was integrated from. Runtime state, refreshed in Tick; not serialized.
+	FTrajectoryArcLengthTable SplineDistanceTable;
+	TArray<FTrajectorySplinePoint> SplineDistanceTablePoints;
+	bool bSplineDistanceTableClosedLoop = false;
+	// The spline's geometry version when its points were last compared against SplineDistanceTablePoints.
+	uint32 SplineDistanceTableVersion = 0;
 };
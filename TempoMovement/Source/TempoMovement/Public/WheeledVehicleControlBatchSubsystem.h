@@ -0,0 +1,98 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#pragma once
+
+#include "TempoSubsystems.h"
+#include "WheeledVehicleVelocityController.h"
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+
+#include "WheeledVehicleControlBatchSubsystem.generated.h"
+
+class ATempoWheeledVehicleController;
+class UWheeledVehicleControlBatchSubsystem;
+
+// Runs UWheeledVehicleControlBatchSubsystem's pass in TG_PrePhysics, where the controllers' own ticks would have.
+USTRUCT()
+struct FWheeledVehicleControlTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UWheeledVehicleControlBatchSubsystem* Subsystem = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FWheeledVehicleControlTickFunction> : public TStructOpsTypeTraitsBase2<FWheeledVehicleControlTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+struct FWheeledVehicleControlStats
+{
+	// As of the last pass.
+	int32 NumControllers = 0;
+	// Controllers whose inputs were computed in parallel (closed-loop control of a Chaos vehicle). The rest ran their
+	// usual per-controller update during the pass.
+	int32 NumBatched = 0;
+	// Wall-clock time of the last pass, in seconds.
+	double UpdateTime = 0.0;
+};
+
+// Updates every ATempoWheeledVehicleController that opts in (bUseBatchControl) in one pass per frame, rather than in
+// each controller's own tick. Each frame the controllers' setpoints and their Chaos vehicles' state are gathered into
+// packed arrays, the velocity controllers' PI and normalization math runs over them in parallel, and the resulting
+// throttle, brake, gear, and steering are sent to the vehicles in one loop. The math runs through the same functions
+// as the per-controller tick, so the inputs are bit-identical. The cost of each pass is published to
+// "stat TempoVehicleControl".
+UCLASS()
+class TEMPOMOVEMENT_API UWheeledVehicleControlBatchSubsystem : public UTempoGameWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Also makes Controller's pawn's movement component tick after the pass, as it would have after the controller.
+	void RegisterController(ATempoWheeledVehicleController* Controller);
+
+	void UnregisterController(ATempoWheeledVehicleController* Controller);
+
+	int32 NumControllers() const { return Controllers.Num(); }
+
+	// Updates every registered controller by DeltaTime (dilated by its CustomTimeDilation, as its own tick would be).
+	// Called by the pass's tick function.
+	void UpdateControllers(float DeltaTime);
+
+	const FWheeledVehicleControlStats& GetStats() const { return Stats; }
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Deinitialize() override;
+
+private:
+	FWheeledVehicleControlTickFunction ControlTickFunction;
+
+	// The registered controllers, and the movement components made to tick after the pass, in the same order.
+	TArray<TWeakObjectPtr<ATempoWheeledVehicleController>> Controllers;
+	TArray<TWeakObjectPtr<UActorComponent>> MovementComponents;
+
+	// Packed per-vehicle state of the batched controllers, gathered each pass. Kept between passes to reuse the
+	// allocations.
+	TArray<ATempoWheeledVehicleController*> BatchedControllers;
+	TArray<UChaosVehicleMovementComponent*> ChaosMovements;
+	TArray<FChaosVehicleControlState> States;
+	// Forward speed (cm/s) and yaw rate (deg/s) setpoints.
+	TArray<FVector2f> Targets;
+	TArray<float> DeltaTimes;
+
+	// Packed results of each pass.
+	TArray<FChaosVehicleControlInputs> Inputs;
+
+	FWheeledVehicleControlStats Stats;
+};
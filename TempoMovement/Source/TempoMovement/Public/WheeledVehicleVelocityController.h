@@ -11,6 +11,26 @@
 class APawn;
 class UChaosVehicleMovementComponent;
 
+// A Chaos vehicle's state, as far as FWheeledVehicleVelocityController needs it. Gathered separately from computing
+// the vehicle's inputs, so that many vehicles' inputs can be computed at once (see UWheeledVehicleControlBatchSubsystem).
+struct FChaosVehicleControlState
+{
+	float ForwardSpeed = 0.0f; // CM/S
+	float YawRate = 0.0f; // Deg/S
+	int32 CurrentGear = 0;
+	bool bReverseEnabled = true;
+};
+
+// The native inputs FWheeledVehicleVelocityController sends a Chaos vehicle.
+struct FChaosVehicleControlInputs
+{
+	float Steering = 0.0f;
+	float Throttle = 0.0f;
+	float Brake = 0.0f;
+	// The gear to shift to, if any.
+	TOptional<int32> TargetGear;
+};
+
 // Closed-loop velocity tracker for wheeled ground vehicles (Chaos or kinematic). Given a possessed
 // pawn and a desired body-frame velocity (forward speed + yaw rate), it converts the error into the
 // vehicle's native inputs: throttle/brake/gear and steering for a Chaos vehicle, or a normalized
@@ -41,6 +61,15 @@ struct TEMPOMOVEMENT_API FWheeledVehicleVelocityController
 	// Apply normalized throttle/brake/gear logic to a Chaos vehicle for a normalized acceleration in [-1, 1].
 	void ApplyChaosAccelInput(UChaosVehicleMovementComponent* Movement, float NormAccel) const;
 
+	// The three steps of TrackBodyVelocity for a Chaos vehicle, for callers that control many vehicles at once:
+	// gather each vehicle's state, compute its inputs (which touches only this struct, so different vehicles' can be
+	// computed in parallel), then apply them.
+	static FChaosVehicleControlState GetChaosControlState(const UChaosVehicleMovementComponent* Movement);
+
+	FChaosVehicleControlInputs ComputeChaosBodyVelocityInputs(const FChaosVehicleControlState& State, float TargetLinVelCmS, float TargetYawRateDegS, float DeltaTime);
+
+	static void ApplyChaosInputs(UChaosVehicleMovementComponent* Movement, const FChaosVehicleControlInputs& Inputs);
+
 	// P gain for linear velocity tracking: normalized accel per cm/s of error.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Velocity Control")
 	float LinearVelocityKp = 0.005f;
@@ -62,6 +91,9 @@ private:
 	// Compute normalized acceleration in [-1, 1] from a target linear velocity (cm/s).
 	float ComputeNormalizedAcceleration(float TargetLinVelCmS, float CurrentLinVelCmS, float DeltaTime);
 
+	// Set the throttle, brake, and gear for a normalized acceleration in [-1, 1].
+	static void ComputeChaosAccelInputs(const FChaosVehicleControlState& State, float NormAccel, FChaosVehicleControlInputs& InOutInputs);
+
 	// Integral state for linear velocity PI loop.
 	UPROPERTY(Transient)
 	float LinearVelocityIntegralError = 0.0;
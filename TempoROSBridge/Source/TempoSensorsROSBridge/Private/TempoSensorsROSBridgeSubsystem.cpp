@@ -10,8 +10,11 @@
 
 #include "TempoSensorInterface.h"
 #include "TempoCamera.h"
+#include "TempoLidar.h"
 #include "TempoROSSettings.h"
 
+#include "Components/SceneComponent.h"
+
 TOptional<FString> MeasurementTypeTopicStr(EMeasurementType MeasurementType)
 {
 	switch (MeasurementType)
@@ -54,233 +57,422 @@ FString CameraInfoTopicFromBaseTopic(const FString& BaseTopic)
 	return FString::Printf(TEXT("%s/camera_info"), *BaseTopic);
 }
 
-FString SensorNameFromTopic(const FString& Topic)
+void UTempoSensorsROSBridgeSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 {
-	TArray<FString> SplitTopic;
-	Topic.ParseIntoArray(SplitTopic, TEXT("/"));
-	return SplitTopic.Last();
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (InWorld.WorldType != EWorldType::Game && InWorld.WorldType != EWorldType::PIE)
+	{
+		return;
+	}
+
+	ROSNode = UTempoROSNode::Create("TempoSensors", this);
+	BindServiceToROS<FTempoGetAvailableSensors, UTempoSensorServiceSubsystem>(ROSNode, "GetAvailableSensors", this, &UTempoSensorsROSBridgeSubsystem::GetAvailableSensors);
+
+	// Sensors activated before the node existed were not bridged by OnSensorActivated; pick them up now.
+	ForEachActiveSensor([this](ITempoSensorInterface* Sensor)
+	{
+		AddSensor(Sensor);
+	});
 }
 
-FString OwnerNameFromTopic(const FString& Topic)
+void UTempoSensorsROSBridgeSubsystem::OnSensorActivated(ITempoSensorInterface* Sensor)
 {
-	TArray<FString> SplitTopic;
-	Topic.ParseIntoArray(SplitTopic, TEXT("/"));
-	return SplitTopic[SplitTopic.Num() - 2];
+	Super::OnSensorActivated(Sensor);
+
+	if (IsValid(ROSNode))
+	{
+		AddSensor(Sensor);
+	}
 }
 
-FString MeasurementTypeFromTopic(const FString& Topic)
+void UTempoSensorsROSBridgeSubsystem::OnSensorDeactivated(ITempoSensorInterface* Sensor)
 {
-	TArray<FString> SplitTopic;
-	Topic.ParseIntoArray(SplitTopic, TEXT("/"));
-	return SplitTopic[SplitTopic.Num() - 3];
+	Super::OnSensorDeactivated(Sensor);
+
+	if (IsValid(ROSNode))
+	{
+		RemoveSensor(Cast<UActorComponent>(Sensor));
+	}
 }
 
-void UTempoSensorsROSBridgeSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+void UTempoSensorsROSBridgeSubsystem::OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
 {
-	Super::OnWorldBeginPlay(InWorld);
+	// Sends last frame's measurements and waits for them, so every response to a request on a sensor is in.
+	Super::OnWorldTickStart(World, TickType, DeltaSeconds);
 
-	if (InWorld.WorldType != EWorldType::Game && InWorld.WorldType != EWorldType::PIE)
+	if (World != GetWorld() || !IsValid(ROSNode))
 	{
 		return;
 	}
 
-	ROSNode = UTempoROSNode::Create("TempoSensors", this);
-	BindServiceToROS<FTempoGetAvailableSensors, UTempoSensorServiceSubsystem>(ROSNode, "GetAvailableSensors", this, &UTempoSensorsROSBridgeSubsystem::GetAvailableSensors);
+	TSharedPtr<FTempoSensorTopicStream> Stream;
+	while (RespondedStreams.Dequeue(Stream))
+	{
+		Stream->bArmed = false;
+		Stream->bResponded = false;
+		ArmStream(Stream);
+	}
 
-	InWorld.GetTimerManager().SetTimer(UpdatePublishersTimerHandle, this, &UTempoSensorsROSBridgeSubsystem::UpdatePublishers, UpdatePublishersPeriod, true, 0.0);
+	for (int32 StreamIdx = IdleStreams.Num() - 1; StreamIdx >= 0; --StreamIdx)
+	{
+		// ArmStream puts streams it doesn't arm back on IdleStreams.
+		const TSharedPtr<FTempoSensorTopicStream> IdleStream = IdleStreams[StreamIdx];
+		if (IdleStream->bClosed || HasSubscriptions(IdleStream->Topic))
+		{
+			IdleStreams.RemoveAtSwap(StreamIdx);
+			ArmStream(IdleStream);
+		}
+	}
 }
 
-template <class...>
-struct False : std::bool_constant<false> { };
+void UTempoSensorsROSBridgeSubsystem::AddSensor(ITempoSensorInterface* Sensor)
+{
+	UActorComponent* SensorComponent = Cast<UActorComponent>(Sensor);
+	if (!SensorComponent || BridgedSensors.Contains(SensorComponent))
+	{
+		return;
+	}
 
-template <typename MeasurementType>
-void UTempoSensorsROSBridgeSubsystem::RequestMeasurement(const FString& Topic, const TResponseDelegate<MeasurementType>& ResponseContinuation)
+	const FString OwnerName = Sensor->GetOwnerName();
+	const FString SensorName = Sensor->GetSensorName();
+	const UTempoCamera* Camera = Cast<UTempoCamera>(SensorComponent);
+
+	// Responses publish from worker threads, so don't change the node's publishers underneath them.
+	FScopeLock Lock(&PublishMutex);
+
+	FTempoBridgedSensor& BridgedSensor = BridgedSensors.Add(SensorComponent);
+	BridgedSensor.SensorFrame = FString::Printf(TEXT("%s/%s"), *OwnerName, *SensorName);
+
+	for (const EMeasurementType MeasurementType : Sensor->GetMeasurementTypes())
+	{
+		const TOptional<FString> MaybeTopic = TopicFromSensorInfo(MeasurementType, OwnerName, SensorName);
+		if (!MaybeTopic.IsSet())
+		{
+			continue;
+		}
+
+		const FString& Topic = MaybeTopic.GetValue();
+		switch (MeasurementType)
+		{
+			case COLOR_IMAGE:
+				{
+					ROSNode->AddPublisher<TempoSensors::ColorImage>(Topic, FROSQOSProfile(1).Reliable());
+					break;
+				}
+			case DEPTH_IMAGE:
+				{
+					ROSNode->AddPublisher<TempoSensors::DepthImage>(Topic, FROSQOSProfile(1).Reliable());
+					break;
+				}
+			case LABEL_IMAGE:
+				{
+					ROSNode->AddPublisher<TempoSensors::LabelImage>(Topic, FROSQOSProfile(1).Reliable());
+					break;
+				}
+			case LIDAR_SCAN:
+				{
+					ROSNode->AddPublisher<FTempoLidarSweep>(Topic, FROSQOSProfile(1).Reliable());
+					break;
+				}
+			default:
+				{
+					continue;
+				}
+		}
+
+		TSharedPtr<FTempoSensorTopicStream> Stream = MakeShared<FTempoSensorTopicStream>();
+		Stream->Topic = Topic;
+		Stream->MeasurementType = MeasurementType;
+		Stream->Sensor = SensorComponent;
+		Stream->OwnerName = TCHAR_TO_UTF8(*OwnerName);
+		Stream->SensorName = TCHAR_TO_UTF8(*SensorName);
+		if (Camera)
+		{
+			Stream->CameraInfoTopic = CameraInfoTopicFromBaseTopic(Topic);
+			ROSNode->AddPublisher<FTempoCameraInfo>(Stream->CameraInfoTopic, FROSQOSProfile(1).Reliable());
+		}
+		IdleStreams.Add(Stream);
+		BridgedSensor.Streams.Add(MoveTemp(Stream));
+	}
+
+	if (USceneComponent* SensorSceneComponent = Cast<USceneComponent>(SensorComponent))
+	{
+		PublishSensorTransform(SensorSceneComponent, BridgedSensor);
+		SensorSceneComponent->TransformUpdated.AddUObject(this, &UTempoSensorsROSBridgeSubsystem::OnSensorTransformUpdated);
+	}
+}
+
+void UTempoSensorsROSBridgeSubsystem::RemoveSensor(UActorComponent* SensorComponent)
 {
-	static_assert(False<MeasurementType>{}, "RequestMeasurement called with unsupported image type");
+	FTempoBridgedSensor BridgedSensor;
+	if (SensorComponent && BridgedSensors.RemoveAndCopyValue(SensorComponent, BridgedSensor))
+	{
+		if (USceneComponent* SensorSceneComponent = Cast<USceneComponent>(SensorComponent))
+		{
+			SensorSceneComponent->TransformUpdated.RemoveAll(this);
+		}
+		CloseStreams(BridgedSensor);
+	}
 }
 
-template <>
-void UTempoSensorsROSBridgeSubsystem::RequestMeasurement<TempoSensors::ColorImage>(const FString& Topic, const TResponseDelegate<TempoSensors::ColorImage>& ResponseContinuation)
+void UTempoSensorsROSBridgeSubsystem::CloseStreams(const FTempoBridgedSensor& BridgedSensor)
 {
-	TempoSensors::ColorImageRequest ImageRequest;
-	const FString SensorName = SensorNameFromTopic(Topic);
-	const FString OwnerName = OwnerNameFromTopic(Topic);
-	ImageRequest.set_sensor(TCHAR_TO_UTF8(*SensorName));
-	ImageRequest.set_owner(TCHAR_TO_UTF8(*OwnerName));
-	StreamColorImages(
-		ImageRequest,
-		TResponseDelegate<TempoSensors::ColorImage>::CreateUObject(
-			this, &UTempoSensorsROSBridgeSubsystem::OnMeasurementReceived, Topic));
+	FScopeLock Lock(&PublishMutex);
+	for (const TSharedPtr<FTempoSensorTopicStream>& Stream : BridgedSensor.Streams)
+	{
+		// A response still in flight holds its own reference to the stream and will see this.
+		Stream->bClosed = true;
+		ROSNode->RemovePublisher(Stream->Topic);
+		if (!Stream->CameraInfoTopic.IsEmpty())
+		{
+			ROSNode->RemovePublisher(Stream->CameraInfoTopic);
+		}
+	}
 }
 
-template <>
-void UTempoSensorsROSBridgeSubsystem::RequestMeasurement<TempoSensors::DepthImage>(const FString& Topic, const TResponseDelegate<TempoSensors::DepthImage>& ResponseContinuation)
+void UTempoSensorsROSBridgeSubsystem::RemoveStaleSensors()
 {
-	TempoSensors::DepthImageRequest ImageRequest;
-	const FString SensorName = SensorNameFromTopic(Topic);
-	const FString OwnerName = OwnerNameFromTopic(Topic);
-	ImageRequest.set_sensor(TCHAR_TO_UTF8(*SensorName));
-	ImageRequest.set_owner(TCHAR_TO_UTF8(*OwnerName));
-	StreamDepthImages(
-		ImageRequest,
-		TResponseDelegate<TempoSensors::DepthImage>::CreateUObject(
-			this, &UTempoSensorsROSBridgeSubsystem::OnMeasurementReceived, Topic));
+	for (auto It = BridgedSensors.CreateIterator(); It; ++It)
+	{
+		if (!IsValid(It.Key().ResolveObjectPtr()))
+		{
+			CloseStreams(It.Value());
+			It.RemoveCurrent();
+		}
+	}
 }
 
-template <>
-void UTempoSensorsROSBridgeSubsystem::RequestMeasurement<TempoSensors::LabelImage>(const FString& Topic, const TResponseDelegate<TempoSensors::LabelImage>& ResponseContinuation)
+void UTempoSensorsROSBridgeSubsystem::OnSensorTransformUpdated(USceneComponent* SensorComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
 {
-	TempoSensors::LabelImageRequest ImageRequest;
-	const FString SensorName = SensorNameFromTopic(Topic);
-	const FString OwnerName = OwnerNameFromTopic(Topic);
-	ImageRequest.set_sensor(TCHAR_TO_UTF8(*SensorName));
-	ImageRequest.set_owner(TCHAR_TO_UTF8(*OwnerName));
-	StreamLabelImages(
-		ImageRequest,
-		TResponseDelegate<TempoSensors::LabelImage>::CreateUObject(
-			this, &UTempoSensorsROSBridgeSubsystem::OnMeasurementReceived, Topic));
+	if (FTempoBridgedSensor* BridgedSensor = BridgedSensors.Find(SensorComponent))
+	{
+		PublishSensorTransform(SensorComponent, *BridgedSensor);
+	}
 }
 
-void UTempoSensorsROSBridgeSubsystem::UpdatePublishers()
+void UTempoSensorsROSBridgeSubsystem::PublishSensorTransform(const USceneComponent* SensorComponent, FTempoBridgedSensor& BridgedSensor)
 {
-	const TempoCore::Empty Request;
-	TSet<FString> PossiblyStaleTopics = ROSNode->GetPublishedTopics();
-	ForEachActiveSensor([this, &PossiblyStaleTopics](const ITempoSensorInterface* Sensor)
+	// The transform is published relative to the owner, so moving the owner doesn't change it.
+	const FTransform SensorTransform = SensorComponent->GetComponentTransform().GetRelativeTransform(SensorComponent->GetOwner()->GetActorTransform());
+	if (BridgedSensor.PublishedTransform.IsSet() && BridgedSensor.PublishedTransform->Equals(SensorTransform))
+	{
+		return;
+	}
+
+	const ITempoSensorInterface* Sensor = Cast<ITempoSensorInterface>(SensorComponent);
+	ROSNode->PublishStaticTransform(SensorTransform,
+		BridgedSensor.SensorFrame,
+		Sensor->GetOwnerName(),
+		GetWorld()->GetTimeSeconds());
+	// Also publish the transform of the "optical" frame, which has its Z-axis pointed out of the camera.
+	ROSNode->PublishStaticTransform(FTransform(FRotator(0.0, 90.0, -90.0), FVector::ZeroVector),
+		FString::Printf(TEXT("%s/optical"), *BridgedSensor.SensorFrame),
+		BridgedSensor.SensorFrame,
+		GetWorld()->GetTimeSeconds());
+	BridgedSensor.PublishedTransform = SensorTransform;
+}
+
+void UTempoSensorsROSBridgeSubsystem::UpdateCameraIntrinsics(FTempoSensorTopicStream& Stream) const
+{
+	const UTempoCamera* Camera = Cast<UTempoCamera>(Stream.Sensor.Get());
+	if (!Camera)
+	{
+		return;
+	}
+
+	const FTempoCameraIntrinsics Intrinsics = Camera->GetIntrinsics();
+	FScopeLock Lock(&Stream.CameraInfoMutex);
+	const TOptional<FTempoCameraIntrinsics>& Current = Stream.CameraIntrinsics;
+	if (!Current.IsSet() || Current->Fx != Intrinsics.Fx || Current->Fy != Intrinsics.Fy || Current->Cx != Intrinsics.Cx
+		|| Current->Cy != Intrinsics.Cy || Current->Width != Intrinsics.Width || Current->Height != Intrinsics.Height)
 	{
-		const FString OwnerName = Sensor->GetOwnerName();
-		const FString SensorName = Sensor->GetSensorName();
-		const float Rate = Sensor->GetRate();
-		for (const EMeasurementType MeasurementType : Sensor->GetMeasurementTypes())
+		Stream.CameraIntrinsics.Reset();
+		Stream.CameraIntrinsics.Emplace(Intrinsics);
+	}
+}
+
+bool UTempoSensorsROSBridgeSubsystem::HasSubscriptions(const FString& Topic) const
+{
+	const TUniquePtr<FTempoROSPublisher>* Publisher = ROSNode->GetPublishers().Find(Topic);
+	return Publisher && (*Publisher)->HasSubscriptions();
+}
+
+void UTempoSensorsROSBridgeSubsystem::PublishCameraInfo(FTempoSensorTopicStream& Stream, double CaptureTime) const
+{
+	if (Stream.CameraInfoTopic.IsEmpty())
+	{
+		return;
+	}
+
+	TOptional<FTempoCameraIntrinsics> Intrinsics;
+	{
+		FScopeLock Lock(&Stream.CameraInfoMutex);
+		if (Stream.CameraIntrinsics.IsSet())
 		{
-			const TOptional<FString> MaybeTopic = TopicFromSensorInfo(MeasurementType, OwnerName, SensorName);
-			if (!MaybeTopic.IsSet())
-			{
-				continue;
-			}
+			Intrinsics.Emplace(Stream.CameraIntrinsics.GetValue());
+		}
+	}
 
-			const FString& Topic = MaybeTopic.GetValue();
-			bool bAlreadyHasTopic = PossiblyStaleTopics.Contains(Topic);
-			PossiblyStaleTopics.Remove(Topic);
+	if (Intrinsics.IsSet())
+	{
+		ROSNode->Publish(Stream.CameraInfoTopic, FTempoCameraInfo(Intrinsics.GetValue(),
+			GetDefault<UTempoROSSettings>()->GetFixedFrameName(), CaptureTime));
+	}
+}
 
-			if (!bAlreadyHasTopic)
-			{
-				if (const UTempoCamera* Camera = Cast<UTempoCamera>(Sensor))
-				{
-					const FString CameraInfoTopic = CameraInfoTopicFromBaseTopic(Topic);
-					ROSNode->AddPublisher<FTempoCameraInfo>(CameraInfoTopic, FROSQOSProfile(1).Reliable());
-				}
+template <class...>
+struct False : std::bool_constant<false> { };
 
-				switch (MeasurementType)
-				{
-					case COLOR_IMAGE:
-						{
-							ROSNode->AddPublisher<TempoSensors::ColorImage>(Topic, FROSQOSProfile(1).Reliable());
-							break;
-						}
-					case DEPTH_IMAGE:
-						{
-							ROSNode->AddPublisher<TempoSensors::DepthImage>(Topic, FROSQOSProfile(1).Reliable());
-							break;
-						}
-					case LABEL_IMAGE:
-						{
-							ROSNode->AddPublisher<TempoSensors::LabelImage>(Topic, FROSQOSProfile(1).Reliable());
-							break;
-						}
-					default:
-						{
-							break;
-						}
-				}
-			}
+template <typename MeasurementType>
+bool UTempoSensorsROSBridgeSubsystem::RequestMeasurement(const TSharedPtr<FTempoSensorTopicStream>& Stream)
+{
+	static_assert(False<MeasurementType>{}, "RequestMeasurement called with unsupported measurement type");
+	return false;
+}
 
-			if (const UTempoCamera* Camera = Cast<UTempoCamera>(Sensor))
-			{
-				const FString CameraInfoTopic = CameraInfoTopicFromBaseTopic(Topic);
-				PossiblyStaleTopics.Remove(CameraInfoTopic);
+template <typename RequestType, typename MeasurementType, typename SensorType>
+bool RequestStreamMeasurement(const FTempoSensorTopicStream& Stream, RequestType& Request, const TResponseDelegate<MeasurementType>& ResponseContinuation)
+{
+	SensorType* Sensor = Cast<SensorType>(Stream.Sensor.Get());
+	if (!Sensor)
+	{
+		return false;
+	}
+	Request.set_owner(Stream.OwnerName);
+	Request.set_sensor(Stream.SensorName);
+	Sensor->RequestMeasurement(Request, ResponseContinuation);
+	return true;
+}
 
-				FTempoCameraInfo CameraInfoMessage(Camera->GetIntrinsics(),
-					GetDefault<UTempoROSSettings>()->GetFixedFrameName(),
-					GetWorld()->GetTimeSeconds());
+template <>
+bool UTempoSensorsROSBridgeSubsystem::RequestMeasurement<TempoSensors::ColorImage>(const TSharedPtr<FTempoSensorTopicStream>& Stream)
+{
+	TempoSensors::ColorImageRequest Request;
+	return RequestStreamMeasurement<TempoSensors::ColorImageRequest, TempoSensors::ColorImage, UTempoCamera>(*Stream, Request,
+		TResponseDelegate<TempoSensors::ColorImage>::CreateUObject(this, &UTempoSensorsROSBridgeSubsystem::OnMeasurementReceived, Stream));
+}
 
-				ROSNode->Publish(CameraInfoTopicFromBaseTopic(Topic), CameraInfoMessage);
-			}
+template <>
+bool UTempoSensorsROSBridgeSubsystem::RequestMeasurement<TempoSensors::DepthImage>(const TSharedPtr<FTempoSensorTopicStream>& Stream)
+{
+	TempoSensors::DepthImageRequest Request;
+	return RequestStreamMeasurement<TempoSensors::DepthImageRequest, TempoSensors::DepthImage, UTempoCamera>(*Stream, Request,
+		TResponseDelegate<TempoSensors::DepthImage>::CreateUObject(this, &UTempoSensorsROSBridgeSubsystem::OnMeasurementReceived, Stream));
+}
 
-			if (const USceneComponent* SensorSceneComponent = Cast<USceneComponent>(Sensor))
-			{
-				const FString SensorFrame = FString::Printf(TEXT("%s/%s"), *Sensor->GetOwnerName(), *Sensor->GetSensorName());
-				ROSNode->PublishStaticTransform(SensorSceneComponent->GetComponentTransform().GetRelativeTransform(SensorSceneComponent->GetOwner()->GetActorTransform()),
-			SensorFrame,
-			Sensor->GetOwnerName(),
-			GetWorld()->GetTimeSeconds());
-				// Also publish the transform of the "optical" frame, which has its Z-axis pointed out of the camera.
-				ROSNode->PublishStaticTransform(FTransform(FRotator(0.0, 90.0, -90.0), FVector::ZeroVector),
-			FString::Printf(TEXT("%s/optical"), *SensorFrame),
-			SensorFrame,
-			GetWorld()->GetTimeSeconds());
-			}
-		}
-	});
+template <>
+bool UTempoSensorsROSBridgeSubsystem::RequestMeasurement<TempoSensors::LabelImage>(const TSharedPtr<FTempoSensorTopicStream>& Stream)
+{
+	TempoSensors::LabelImageRequest Request;
+	return RequestStreamMeasurement<TempoSensors::LabelImageRequest, TempoSensors::LabelImage, UTempoCamera>(*Stream, Request,
+		TResponseDelegate<TempoSensors::LabelImage>::CreateUObject(this, &UTempoSensorsROSBridgeSubsystem::OnMeasurementReceived, Stream));
+}
+
+template <>
+bool UTempoSensorsROSBridgeSubsystem::RequestMeasurement<TempoSensors::LidarScanSegment>(const TSharedPtr<FTempoSensorTopicStream>& Stream)
+{
+	TempoSensors::LidarScanRequest Request;
+	// Have the sensor compute Cartesian points (and rings) in its own frame, which is the frame_id
+	// the PointCloud2 is stamped with, so the converter only has to repack them.
+	Request.set_point_frame(TempoSensors::LPF_SENSOR);
+	Request.set_include_ring_column(true);
+	return RequestStreamMeasurement<TempoSensors::LidarScanRequest, TempoSensors::LidarScanSegment, UTempoLidar>(*Stream, Request,
+		TResponseDelegate<TempoSensors::LidarScanSegment>::CreateUObject(this, &UTempoSensorsROSBridgeSubsystem::OnMeasurementReceived, Stream));
+}
 
-	for (const FString& StaleTopic : PossiblyStaleTopics)
+void UTempoSensorsROSBridgeSubsystem::OnStreamResponded(const TSharedPtr<FTempoSensorTopicStream>& Stream)
+{
+	if (!Stream->bResponded.exchange(true))
 	{
-		ROSNode->RemovePublisher(StaleTopic);
+		RespondedStreams.Enqueue(Stream);
 	}
+}
 
-	const TMap<FString, TUniquePtr<FTempoROSPublisher>>& Publishers = ROSNode->GetPublishers();
-	for (const auto& Elem : Publishers)
+template <typename MeasurementType>
+void UTempoSensorsROSBridgeSubsystem::OnMeasurementReceived(const MeasurementType& Measurement, FTempoResponseStatus Status, TSharedPtr<FTempoSensorTopicStream> Stream)
+{
 	{
-		const FString& Topic = Elem.Key;
-		const TUniquePtr<FTempoROSPublisher>& Publisher = Elem.Value;
-		if (Publisher->HasSubscriptions() && !TopicsWithPendingRequests.Contains(Topic))
+		FScopeLock Lock(&PublishMutex);
+		if (Status.ok() && !Stream->bClosed)
 		{
-			const FString MeasurementType = MeasurementTypeFromTopic(Topic);
-			if (MeasurementType == TEXT("color"))
-			{
-				RequestMeasurement<TempoSensors::ColorImage>(
-					Topic,
-					TResponseDelegate<TempoSensors::ColorImage>::CreateUObject(
-						this, &UTempoSensorsROSBridgeSubsystem::OnMeasurementReceived, Topic));
-			}
-			else if (MeasurementType == TEXT("depth"))
-			{
-				RequestMeasurement<TempoSensors::DepthImage>(
-					Topic,
-					TResponseDelegate<TempoSensors::DepthImage>::CreateUObject(
-						this, &UTempoSensorsROSBridgeSubsystem::OnMeasurementReceived, Topic));
-			}
-			else if (MeasurementType == TEXT("label"))
-			{
-				RequestMeasurement<TempoSensors::LabelImage>(
-					Topic,
-					TResponseDelegate<TempoSensors::LabelImage>::CreateUObject(
-						this, &UTempoSensorsROSBridgeSubsystem::OnMeasurementReceived, Topic));
-			}
+			ROSNode->Publish(Stream->Topic, Measurement);
+			PublishCameraInfo(*Stream, Measurement.header().capture_time_s());
+		}
+	}
 
-			TopicsWithPendingRequests.Add(Topic);
+	OnStreamResponded(Stream);
+}
+
+// Lidar responses arrive as several segments per request (one per active tile), so publish once a full sweep has
+// been assembled.
+template <>
+void UTempoSensorsROSBridgeSubsystem::OnMeasurementReceived<TempoSensors::LidarScanSegment>(const TempoSensors::LidarScanSegment& Segment, FTempoResponseStatus Status, TSharedPtr<FTempoSensorTopicStream> Stream)
+{
+	if (Status.ok())
+	{
+		// Segments of one sweep may arrive on different worker threads at once.
+		FScopeLock Lock(&PublishMutex);
+		FTempoLidarSweep Sweep;
+		if (Stream->LidarSweepAggregator.AddSegment(Segment, Sweep) && !Stream->bClosed)
+		{
+			ROSNode->Publish(Stream->Topic, Sweep);
 		}
 	}
+
+	OnStreamResponded(Stream);
 }
 
-template <typename MeasurementType>
-void UTempoSensorsROSBridgeSubsystem::OnMeasurementReceived(const MeasurementType& Image, grpc::Status Status, FString Topic)
+void UTempoSensorsROSBridgeSubsystem::ArmStream(const TSharedPtr<FTempoSensorTopicStream>& Stream)
 {
-	FScopeLock Lock(&MeasurementReceivedMutex);
+	check(!Stream->bArmed);
 
-	if (Status.ok())
+	if (Stream->bClosed)
 	{
-		ROSNode->Publish(Topic, Image);
+		return;
 	}
 
-	TopicsWithPendingRequests.Remove(Topic);
+	if (!Stream->Sensor.IsValid())
+	{
+		// Missed its deactivation.
+		RemoveStaleSensors();
+		return;
+	}
 
-	const TMap<FString, TUniquePtr<FTempoROSPublisher>>& Publishers = ROSNode->GetPublishers();
-	if (const TUniquePtr<FTempoROSPublisher>* Publisher = Publishers.Find(Topic); (*Publisher)->HasSubscriptions())
+	if (!HasSubscriptions(Stream->Topic))
 	{
-		RequestMeasurement<MeasurementType>(
-			Topic,
-			TResponseDelegate<MeasurementType>::CreateUObject(
-				this, &UTempoSensorsROSBridgeSubsystem::OnMeasurementReceived, Topic));
-		TopicsWithPendingRequests.Add(Topic);
+		IdleStreams.Add(Stream);
+		return;
+	}
+
+	switch (Stream->MeasurementType)
+	{
+		case COLOR_IMAGE:
+			{
+				UpdateCameraIntrinsics(*Stream);
+				Stream->bArmed = RequestMeasurement<TempoSensors::ColorImage>(Stream);
+				break;
+			}
+		case DEPTH_IMAGE:
+			{
+				UpdateCameraIntrinsics(*Stream);
+				Stream->bArmed = RequestMeasurement<TempoSensors::DepthImage>(Stream);
+				break;
+			}
+		case LABEL_IMAGE:
+			{
+				UpdateCameraIntrinsics(*Stream);
+				Stream->bArmed = RequestMeasurement<TempoSensors::LabelImage>(Stream);
+				break;
+			}
+		case LIDAR_SCAN:
+			{
+				Stream->bArmed = RequestMeasurement<TempoSensors::LidarScanSegment>(Stream);
+				break;
+			}
+		default:
+			{
+				break;
+			}
 	}
 }
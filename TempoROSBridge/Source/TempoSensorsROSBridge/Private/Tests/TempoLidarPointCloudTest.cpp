@@ -0,0 +1,172 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoSensorsROSConverters.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+// Unit and throughput tests for the lidar sweep -> sensor_msgs/PointCloud2 path in
+// TempoSensorsROSConverters.h. They build synthetic LidarScanSegments (as the lidar's decode emits
+// them with point_frame = LPF_SENSOR and include_ring_column set) and exercise the aggregator and
+// converter directly — no ROS node, no running ROS graph, no world, no RHI. Run via:
+//   Scripts/Test.sh Tempo.ROSBridge.Sensors
+//   Automation RunTests Tempo.ROSBridge.Sensors.LidarPointCloud   (from the editor console)
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoLidarPointCloudTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	// Builds one segment of a sweep with NumPoints valid points. Point i of segment s is
+	// (s, i, -i) meters with intensity i / NumPoints, and ring i % 128.
+	TempoSensors::LidarScanSegment MakeSegment(uint64 SequenceId, int32 SegmentIdx, int32 ScanCount, int32 NumPoints, bool bWithColor)
+	{
+		TempoSensors::LidarScanSegment Segment;
+		Segment.mutable_header()->set_sequence_id(SequenceId);
+		Segment.mutable_header()->set_capture_time_s(12.5);
+		Segment.mutable_header()->set_owner("Owner");
+		Segment.mutable_header()->set_sensor("Lidar");
+		Segment.set_scan_count(ScanCount);
+
+		const int32 StrideFloats = bWithColor ? 5 : 4;
+		std::string* Points = Segment.mutable_points();
+		Points->resize(static_cast<size_t>(NumPoints) * StrideFloats * sizeof(float));
+		float* PointsData = reinterpret_cast<float*>(Points->data());
+		std::string* RingColumns = Segment.mutable_ring_columns();
+		RingColumns->resize(static_cast<size_t>(NumPoints) * 2 * sizeof(uint16));
+		uint16* RingColumnsData = reinterpret_cast<uint16*>(RingColumns->data());
+		for (int32 I = 0; I < NumPoints; ++I)
+		{
+			float* Point = PointsData + I * StrideFloats;
+			Point[0] = static_cast<float>(SegmentIdx);
+			Point[1] = static_cast<float>(I);
+			Point[2] = -static_cast<float>(I);
+			Point[3] = static_cast<float>(I) / NumPoints;
+			if (bWithColor)
+			{
+				const uint32 RGB = 0x00102030u;
+				FMemory::Memcpy(&Point[4], &RGB, sizeof(uint32));
+			}
+			RingColumnsData[I * 2] = static_cast<uint16>(I % 128);
+			RingColumnsData[I * 2 + 1] = static_cast<uint16>(I / 128);
+		}
+		if (bWithColor)
+		{
+			Segment.mutable_colors()->assign(3, '\0');
+		}
+		Segment.set_num_points(NumPoints);
+		Segment.set_point_stride_bytes(StrideFloats * sizeof(float));
+		Segment.set_point_frame(TempoSensors::LPF_SENSOR);
+		return Segment;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoLidarSweepAggregatorTest,
+	"Tempo.ROSBridge.Sensors.LidarPointCloud.Aggregator", TempoLidarPointCloudTestFlags)
+bool FTempoLidarSweepAggregatorTest::RunTest(const FString& Parameters)
+{
+	FTempoLidarSweepAggregator Aggregator;
+	FTempoLidarSweep Sweep;
+
+	// A partial sweep is discarded when a newer sequence starts.
+	TestFalse(TEXT("First segment of 3 is incomplete"), Aggregator.AddSegment(MakeSegment(1, 0, 3, 4, false), Sweep));
+	TestFalse(TEXT("Segment of a new sweep restarts assembly"), Aggregator.AddSegment(MakeSegment(2, 0, 3, 4, false), Sweep));
+	TestFalse(TEXT("Second segment of 3 is incomplete"), Aggregator.AddSegment(MakeSegment(2, 1, 3, 4, false), Sweep));
+	TestTrue(TEXT("Third segment of 3 completes the sweep"), Aggregator.AddSegment(MakeSegment(2, 2, 3, 4, false), Sweep));
+	TestEqual(TEXT("Completed sweep has all 3 segments"), Sweep.Segments.Num(), 3);
+
+	// Single-segment sweeps complete immediately.
+	TestTrue(TEXT("Single-segment sweep completes"), Aggregator.AddSegment(MakeSegment(3, 0, 1, 4, false), Sweep));
+	TestEqual(TEXT("Single-segment sweep has 1 segment"), Sweep.Segments.Num(), 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoLidarPointCloudConverterTest,
+	"Tempo.ROSBridge.Sensors.LidarPointCloud.Converter", TempoLidarPointCloudTestFlags)
+bool FTempoLidarPointCloudConverterTest::RunTest(const FString& Parameters)
+{
+	for (const bool bWithColor : { false, true })
+	{
+		FTempoLidarSweep Sweep;
+		Sweep.Segments.Add(MakeSegment(7, 0, 2, 300, bWithColor));
+		Sweep.Segments.Add(MakeSegment(7, 1, 2, 200, bWithColor));
+
+		const sensor_msgs::msg::PointCloud2 Cloud = TImplicitToROSConverter<FTempoLidarSweep>::Convert(Sweep);
+
+		const uint32 ExpectedStep = bWithColor ? 24 : 20;
+		TestEqual(TEXT("width is the total point count"), Cloud.width, 500u);
+		TestEqual(TEXT("height is 1 (unordered)"), Cloud.height, 1u);
+		TestEqual(TEXT("point_step"), Cloud.point_step, ExpectedStep);
+		TestEqual(TEXT("data size"), Cloud.data.size(), static_cast<size_t>(500 * ExpectedStep));
+		TestEqual(TEXT("field count"), static_cast<int32>(Cloud.fields.size()), bWithColor ? 6 : 5);
+		TestTrue(TEXT("is_dense"), static_cast<bool>(Cloud.is_dense));
+		TestEqual(TEXT("frame_id"), FString(UTF8_TO_TCHAR(Cloud.header.frame_id.c_str())), FString(TEXT("Owner/Lidar")));
+		TestEqual(TEXT("stamp.sec"), Cloud.header.stamp.sec, 12);
+
+		// Spot-check point 305 overall, i.e. point 5 of the second segment.
+		const uint8* Point = Cloud.data.data() + 305 * ExpectedStep;
+		float XYZI[4];
+		FMemory::Memcpy(XYZI, Point, sizeof(XYZI));
+		TestEqual(TEXT("x"), XYZI[0], 1.0f);
+		TestEqual(TEXT("y"), XYZI[1], 5.0f);
+		TestEqual(TEXT("z"), XYZI[2], -5.0f);
+		TestEqual(TEXT("intensity"), XYZI[3], 5.0f / 200.0f);
+		uint16 Ring;
+		FMemory::Memcpy(&Ring, Point + ExpectedStep - 4, sizeof(uint16));
+		TestEqual(TEXT("ring"), Ring, static_cast<uint16>(5));
+		if (bWithColor)
+		{
+			uint32 RGB;
+			FMemory::Memcpy(&RGB, Point + 16, sizeof(uint32));
+			TestEqual(TEXT("rgb"), RGB, 0x00102030u);
+		}
+	}
+
+	// An empty sweep converts to an empty cloud.
+	const sensor_msgs::msg::PointCloud2 Empty = TImplicitToROSConverter<FTempoLidarSweep>::Convert(FTempoLidarSweep());
+	TestEqual(TEXT("empty sweep has no points"), Empty.data.size(), static_cast<size_t>(0));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoLidarPointCloudThroughputTest,
+	"Tempo.ROSBridge.Sensors.LidarPointCloud.Throughput", TempoLidarPointCloudTestFlags)
+bool FTempoLidarPointCloudThroughputTest::RunTest(const FString& Parameters)
+{
+	// A 360 degree, 2048 x 128 lidar split across three tiles, with every return valid (the worst case).
+	constexpr int32 NumSegments = 3;
+	constexpr int32 PointsPerSegment = 2048 * 128 / NumSegments;
+	constexpr int32 NumIterations = 20;
+
+	FTempoLidarSweep Sweep;
+	for (int32 SegmentIdx = 0; SegmentIdx < NumSegments; ++SegmentIdx)
+	{
+		Sweep.Segments.Add(MakeSegment(1, SegmentIdx, NumSegments, PointsPerSegment, false));
+	}
+
+	// Warm up once so the first allocation isn't counted.
+	size_t Checksum = TImplicitToROSConverter<FTempoLidarSweep>::Convert(Sweep).data.size();
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		const sensor_msgs::msg::PointCloud2 Cloud = TImplicitToROSConverter<FTempoLidarSweep>::Convert(Sweep);
+		Checksum += Cloud.data.size();
+	}
+	const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+	const double SweepsPerSecond = NumIterations / FMath::Max(ElapsedSeconds, 1e-9);
+	const double PointsPerSecond = SweepsPerSecond * NumSegments * PointsPerSegment;
+	AddInfo(FString::Printf(TEXT("Converted %d sweeps of %d points in %.3f ms (%.1f sweeps/s, %.1f Mpoints/s)"),
+		NumIterations, NumSegments * PointsPerSegment, ElapsedSeconds * 1000.0, SweepsPerSecond, PointsPerSecond / 1e6));
+
+	TestEqual(TEXT("every conversion produced the full cloud"), Checksum,
+		static_cast<size_t>(NumIterations + 1) * NumSegments * PointsPerSegment * 20);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -4,8 +4,48 @@
 
 #include "CoreMinimal.h"
 #include "TempoSensorServiceSubsystem.h"
+#include "TempoSensorsROSBridgeTypes.h"
+#include "Containers/Queue.h"
+#include "UObject/ObjectKey.h"
 #include "TempoSensorsROSBridgeSubsystem.generated.h"
 
+// One sensor measurement type published on one ROS topic. While the topic has subscribers the stream keeps
+// exactly one measurement request on its sensor: the first response to each request (OK or not) queues the stream,
+// and it is re-armed once, on the game thread, right after the sensors have responded for the frame.
+struct FTempoSensorTopicStream
+{
+	FString Topic;
+	EMeasurementType MeasurementType = COLOR_IMAGE;
+	TWeakObjectPtr<UActorComponent> Sensor;
+	std::string OwnerName;
+	std::string SensorName;
+
+	// Whether a request is on the sensor. Only touched on the game thread.
+	bool bArmed = false;
+	// Set by the first response to the request on the sensor, so one that arrives in parts (lidar segments) still
+	// re-arms the stream once. Cleared on the game thread when the stream is re-armed.
+	std::atomic<bool> bResponded = false;
+	// Set when the sensor goes away. A response that arrives afterwards is dropped.
+	std::atomic<bool> bClosed = false;
+
+	// Only touched under the subsystem's PublishMutex.
+	FTempoLidarSweepAggregator LidarSweepAggregator;
+
+	// Cameras publish camera_info alongside every image, stamped to match it. Written on the game
+	// thread when the stream is armed and read by the response handler.
+	FString CameraInfoTopic;
+	FCriticalSection CameraInfoMutex;
+	TOptional<FTempoCameraIntrinsics> CameraIntrinsics;
+};
+
+// The streams and last published transform of one bridged sensor.
+struct FTempoBridgedSensor
+{
+	TArray<TSharedPtr<FTempoSensorTopicStream>> Streams;
+	FString SensorFrame;
+	TOptional<FTransform> PublishedTransform;
+};
+
 UCLASS()
 class TEMPOSENSORSROSBRIDGE_API UTempoSensorsROSBridgeSubsystem : public UTempoSensorServiceSubsystem
 {
@@ -13,22 +53,56 @@ class TEMPOSENSORSROSBRIDGE_API UTempoSensorsROSBridgeSubsystem : public UTempoS
 public:
 	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
 
+	virtual void OnSensorActivated(ITempoSensorInterface* Sensor) override;
+
+	virtual void OnSensorDeactivated(ITempoSensorInterface* Sensor) override;
+
+	// Re-arms the streams whose sensors responded this frame, and starts those whose topics gained subscribers.
+	virtual void OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds) override;
+
 protected:
-	void UpdatePublishers();
+	void AddSensor(ITempoSensorInterface* Sensor);
+
+	void RemoveSensor(UActorComponent* SensorComponent);
+
+	void CloseStreams(const FTempoBridgedSensor& BridgedSensor);
+
+	// Drops sensors that went away without being deactivated (e.g. garbage collected without unregistering).
+	void RemoveStaleSensors();
+
+	void OnSensorTransformUpdated(USceneComponent* SensorComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	void PublishSensorTransform(const USceneComponent* SensorComponent, FTempoBridgedSensor& BridgedSensor);
+
+	void UpdateCameraIntrinsics(FTempoSensorTopicStream& Stream) const;
 
 	template <typename MeasurementType>
-	void OnMeasurementReceived(const MeasurementType& Image, grpc::Status Status, FString Topic);
+	void OnMeasurementReceived(const MeasurementType& Measurement, FTempoResponseStatus Status, TSharedPtr<FTempoSensorTopicStream> Stream);
+
+	// Called from the (worker thread) response handlers for every response.
+	void OnStreamResponded(const TSharedPtr<FTempoSensorTopicStream>& Stream);
 
 	template <typename MeasurementType>
-	void RequestMeasurement(const FString& Topic, const TResponseDelegate<MeasurementType>& ResponseContinuation);
+	bool RequestMeasurement(const TSharedPtr<FTempoSensorTopicStream>& Stream);
+
+	// Puts the stream's next request on its sensor, if its topic still has subscribers.
+	void ArmStream(const TSharedPtr<FTempoSensorTopicStream>& Stream);
+
+	bool HasSubscriptions(const FString& Topic) const;
+
+	void PublishCameraInfo(FTempoSensorTopicStream& Stream, double CaptureTime) const;
 
-	FTimerHandle UpdatePublishersTimerHandle;
+	TMap<TObjectKey<UActorComponent>, FTempoBridgedSensor> BridgedSensors;
 
-	float UpdatePublishersPeriod = 1.0;
+	// Streams whose sensors have responded since they were last armed.
+	TQueue<TSharedPtr<FTempoSensorTopicStream>, EQueueMode::Mpsc> RespondedStreams;
 
-	FCriticalSection MeasurementReceivedMutex;
+	// Streams without a request on their sensor, waiting for their topics to gain subscribers. The node has no
+	// subscription events, so these are checked at the start of every frame.
+	TArray<TSharedPtr<FTempoSensorTopicStream>> IdleStreams;
 
-	TSet<FString> TopicsWithPendingRequests;
+	// Serializes publishing from response handlers with each other and with publishers being added and removed.
+	FCriticalSection PublishMutex;
 
 	UPROPERTY()
 	class UTempoROSNode* ROSNode;
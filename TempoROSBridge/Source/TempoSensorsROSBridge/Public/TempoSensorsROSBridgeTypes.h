@@ -4,6 +4,8 @@
 
 #include "TempoCamera.h"
 
+#include "TempoSensors/Lidar.pb.h"
+
 struct FTempoCameraInfo
 {
 	FTempoCameraInfo(const FTempoCameraIntrinsics& IntrinsicsIn, const FString& FrameIdIn, float TimestampIn)
@@ -13,3 +15,40 @@ struct FTempoCameraInfo
 	FString FrameId;
 	float Timestamp;
 };
+
+// One complete lidar sweep: all the LidarScanSegments (one per active tile) that share a sequence_id.
+struct FTempoLidarSweep
+{
+	TArray<TempoSensors::LidarScanSegment> Segments;
+};
+
+// Assembles streamed LidarScanSegments into complete sweeps. A segment with a different sequence_id
+// than the sweep in progress discards the partial sweep (for example, one left behind by a dropped segment).
+struct FTempoLidarSweepAggregator
+{
+	// Returns true, and moves the completed sweep into SweepOut, if Segment completes its sweep.
+	bool AddSegment(const TempoSensors::LidarScanSegment& Segment, FTempoLidarSweep& SweepOut)
+	{
+		const uint64 SegmentSequenceId = Segment.header().sequence_id();
+		if (!SequenceId.IsSet() || SequenceId.GetValue() != SegmentSequenceId)
+		{
+			PendingSweep.Segments.Reset();
+			SequenceId = SegmentSequenceId;
+		}
+
+		PendingSweep.Segments.Add(Segment);
+		if (PendingSweep.Segments.Num() < Segment.scan_count())
+		{
+			return false;
+		}
+
+		SweepOut = MoveTemp(PendingSweep);
+		PendingSweep.Segments.Reset();
+		SequenceId.Reset();
+		return true;
+	}
+
+private:
+	TOptional<uint64> SequenceId;
+	FTempoLidarSweep PendingSweep;
+};
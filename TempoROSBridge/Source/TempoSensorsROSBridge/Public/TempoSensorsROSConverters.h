@@ -9,14 +9,18 @@
 #include "tempo_sensors_ros_bridge/srv/get_available_sensors.hpp"
 #include "sensor_msgs/msg/image.hpp"
 #include "sensor_msgs/msg/camera_info.hpp"
+#include "sensor_msgs/msg/point_cloud2.hpp"
+#include "sensor_msgs/msg/point_field.hpp"
 
 #include "TempoSensors/Sensors.grpc.pb.h"
 #include "TempoSensors/Camera.pb.h"
+#include "TempoSensors/Lidar.pb.h"
 
 DEFINE_TEMPOROS_MESSAGE_TYPE_TRAITS(TempoSensors::ColorImage)
 DEFINE_TEMPOROS_MESSAGE_TYPE_TRAITS(TempoSensors::DepthImage)
 DEFINE_TEMPOROS_MESSAGE_TYPE_TRAITS(TempoSensors::LabelImage)
 DEFINE_TEMPOROS_MESSAGE_TYPE_TRAITS(FTempoCameraInfo)
+DEFINE_TEMPOROS_MESSAGE_TYPE_TRAITS(FTempoLidarSweep)
 
 template <>
 struct TFromROSConverter<tempo_sensors_ros_bridge::srv::GetAvailableSensors::Request, TempoCore::Empty>
@@ -59,6 +63,11 @@ struct TToROSConverter<tempo_sensors_ros_bridge::srv::GetAvailableSensors::Respo
 						ROSAvailableSensor.measurement_types.push_back("label_image");
 						break;
 					}
+					case TempoSensors::MT_LIDAR_SCAN:
+					{
+						ROSAvailableSensor.measurement_types.push_back("lidar_scan");
+						break;
+					}
 					default:
 					{
 						checkf(false, TEXT("Unhandled measurement type"));
@@ -188,3 +197,100 @@ struct TImplicitToROSConverter<FTempoCameraInfo>: TToROSConverter<sensor_msgs::m
 		return ToValue;
 	}
 };
+
+// Builds an unordered sensor_msgs/PointCloud2 from a full sweep of LidarScanSegments that carry packed
+// Cartesian `points` (and, optionally, `ring_columns`). Invalid returns were already dropped on the
+// server, so the cloud is dense. The output layout is
+//   x, y, z, intensity (float32) [, rgb (float32, packed 0x00RRGGBB)], ring (uint16), 2 bytes padding
+// which is the x/y/z/intensity/ring layout common to lidar drivers, plus PCL's packed rgb when the
+// lidar is rendering color. The server's per-point float lanes already match the head of that layout,
+// so each point is one memcpy plus the ring.
+template <>
+struct TImplicitToROSConverter<FTempoLidarSweep>: TToROSConverter<sensor_msgs::msg::PointCloud2, FTempoLidarSweep>
+{
+	static ToType Convert(const FromType& TempoValue)
+	{
+		ToType ToValue;
+		if (TempoValue.Segments.IsEmpty())
+		{
+			return ToValue;
+		}
+
+		const TempoSensors::LidarScanSegment& FirstSegment = TempoValue.Segments[0];
+		const bool bWithColor = !FirstSegment.colors().empty();
+		const uint32 FloatLanesBytes = bWithColor ? 20 : 16;
+		const uint32 RingOffset = FloatLanesBytes;
+		const uint32 PointStep = RingOffset + 4;
+
+		auto AddField = [&ToValue](const char* Name, uint32 Offset, uint8 DataType)
+		{
+			sensor_msgs::msg::PointField Field;
+			Field.name = Name;
+			Field.offset = Offset;
+			Field.datatype = DataType;
+			Field.count = 1;
+			ToValue.fields.push_back(Field);
+		};
+		AddField("x", 0, sensor_msgs::msg::PointField::FLOAT32);
+		AddField("y", 4, sensor_msgs::msg::PointField::FLOAT32);
+		AddField("z", 8, sensor_msgs::msg::PointField::FLOAT32);
+		AddField("intensity", 12, sensor_msgs::msg::PointField::FLOAT32);
+		if (bWithColor)
+		{
+			AddField("rgb", 16, sensor_msgs::msg::PointField::FLOAT32);
+		}
+		AddField("ring", RingOffset, sensor_msgs::msg::PointField::UINT16);
+
+		size_t NumPoints = 0;
+		for (const TempoSensors::LidarScanSegment& Segment : TempoValue.Segments)
+		{
+			NumPoints += Segment.num_points();
+		}
+
+		ToValue.data.resize(NumPoints * PointStep);
+		uint8* Out = ToValue.data.data();
+		for (const TempoSensors::LidarScanSegment& Segment : TempoValue.Segments)
+		{
+			const int32 SrcStride = Segment.point_stride_bytes();
+			const int32 SegmentPoints = Segment.num_points();
+			if (SegmentPoints <= 0 || SrcStride < static_cast<int32>(FloatLanesBytes)
+				|| Segment.points().size() < static_cast<size_t>(SegmentPoints) * SrcStride)
+			{
+				// Malformed or color-mismatched segment (e.g. the sensor toggled color mid-sweep). Leave its points zeroed.
+				FMemory::Memzero(Out, static_cast<size_t>(FMath::Max(SegmentPoints, 0)) * PointStep);
+				Out += static_cast<size_t>(FMath::Max(SegmentPoints, 0)) * PointStep;
+				continue;
+			}
+
+			const uint8* Points = reinterpret_cast<const uint8*>(Segment.points().data());
+			const bool bHasRings = Segment.ring_columns().size() >= static_cast<size_t>(SegmentPoints) * 4;
+			const uint8* RingColumns = bHasRings ? reinterpret_cast<const uint8*>(Segment.ring_columns().data()) : nullptr;
+			for (int32 PointIdx = 0; PointIdx < SegmentPoints; ++PointIdx)
+			{
+				FMemory::Memcpy(Out, Points + static_cast<size_t>(PointIdx) * SrcStride, FloatLanesBytes);
+				if (RingColumns)
+				{
+					// (ring, column) uint16 pairs; ring is the first of the two.
+					FMemory::Memcpy(Out + RingOffset, RingColumns + static_cast<size_t>(PointIdx) * 4, sizeof(uint16));
+				}
+				else
+				{
+					FMemory::Memzero(Out + RingOffset, sizeof(uint16));
+				}
+				FMemory::Memzero(Out + RingOffset + sizeof(uint16), 2);
+				Out += PointStep;
+			}
+		}
+
+		ToValue.header.frame_id = FirstSegment.header().owner() + "/" + FirstSegment.header().sensor();
+		ToValue.header.stamp.sec = static_cast<int>(FirstSegment.header().capture_time_s());
+		ToValue.header.stamp.nanosec = 1e9 * (FirstSegment.header().capture_time_s() - static_cast<int>(FirstSegment.header().capture_time_s()));
+		ToValue.height = 1;
+		ToValue.width = static_cast<uint32>(NumPoints);
+		ToValue.is_bigendian = false;
+		ToValue.point_step = PointStep;
+		ToValue.row_step = static_cast<uint32>(NumPoints * PointStep);
+		ToValue.is_dense = true;
+		return ToValue;
+	}
+};
@@ -951,6 +951,18 @@ void UTempoCamera::RenderCapture()
 	// frame. The call is idempotent and persistent, so the first camera each frame covers the rest.
 	EnsureRayTracingReadbackBuffersExpanded(Scene);
 
+	if (!TextureReadQueue.TryReserve(GetName()))
+	{
+		return;
+	}
+
+	// Only null if the pool failed to create a staging texture, which it logs and counts.
+	TSharedPtr<FTempoStagingTextureLease, ESPMode::ThreadSafe> StagingLease = AcquireNextStagingTexture();
+	if (!StagingLease.IsValid())
+	{
+		return;
+	}
+
 	int32 NumActiveTiles = 0;
 	for (const FTempoCameraTile& Tile : Tiles)
 	{
@@ -1264,7 +1276,7 @@ void UTempoCamera::RenderCapture()
 			GetComponentTransform(), MoveTemp(InstanceToSemanticMap));
 	}
 
-	NewRead->StagingTexture = AcquireNextStagingTexture();
+	NewRead->AssignStagingTexture(MoveTemp(StagingLease));
 
 	SequenceId++;
 
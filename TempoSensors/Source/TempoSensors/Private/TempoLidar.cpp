@@ -508,7 +508,8 @@ namespace
 	// is constexpr-guarded: the no-color path emits identical proto bytes as before this change.
 	template <typename PixelType>
 	void DecodeLidarRead(const TLidarTextureReadBase<PixelType>& Read, float TransmissionTime,
-		TempoSensors::LidarScanSegment& ScanSegmentOut)
+		const FLidarPointCloudOptions& PointCloudOptions, TempoSensors::LidarScanSegment& ScanSegmentOut,
+		FLidarPointClouds& PointCloudsOut)
 	{
 		// EffectiveHorizontalFOV is the padded FOV the renderer actually produced (covers
 		// nominal beam FOV + AzimuthOffsetDeg). HorizontalFOV is the unpadded beam FOV and is only
@@ -564,11 +565,47 @@ namespace
 				: TempoSensors::ColorEncoding::CE_RGB8);
 		}
 
+		// Cartesian point clouds (only when some client asked for them). Each requested frame gets a
+		// buffer sized for every return; each column writes its valid points compacted to the front of
+		// its own V-length stripe and records how many it wrote, and the stripes are then slid together
+		// below. That keeps the per-return work inside the parallel loop with no shared counters.
+		constexpr int32 NumFrames = TempoSensors::LidarPointFrame_ARRAYSIZE;
+		const int32 PointStrideFloats = ColorsData ? 5 : 4;
+		float* PointsData[NumFrames] = {};
+		FTransform TileToFrame[NumFrames];
+		uint16* RingColumnsData = nullptr;
+		TArray<int32> ColumnPointCounts;
+		if (!PointCloudOptions.IsEmpty())
+		{
+			// The tile frame is the sensor frame yawed by RelativeYaw. CaptureTransform is the tile's world transform.
+			TileToFrame[TempoSensors::LPF_SENSOR] = FTransform(FRotator(0.0, Read.RelativeYaw, 0.0));
+			TileToFrame[TempoSensors::LPF_WORLD] = Read.CaptureTransform;
+			TileToFrame[TempoSensors::LPF_OWNER] = Read.CaptureTransform.GetRelativeTransform(Read.OwnerTransform);
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				if (PointCloudOptions.HasFrame(static_cast<TempoSensors::LidarPointFrame>(Frame)))
+				{
+					PointCloudsOut.Points[Frame].resize(static_cast<size_t>(NumReturns) * PointStrideFloats * sizeof(float));
+					PointsData[Frame] = reinterpret_cast<float*>(PointCloudsOut.Points[Frame].data());
+				}
+			}
+			if (PointCloudOptions.bRingColumn)
+			{
+				PointCloudsOut.RingColumns.resize(static_cast<size_t>(NumReturns) * 2 * sizeof(uint16));
+				RingColumnsData = reinterpret_cast<uint16*>(PointCloudsOut.RingColumns.data());
+			}
+			ColumnPointCounts.SetNumZeroed(Read.HorizontalBeams);
+		}
+		int32* const ColumnPointCountsData = ColumnPointCounts.GetData();
+
 		// H-outer, V-inner layout: each ParallelFor iteration owns a contiguous V-length stripe
 		// of every output array, so threads never share cache lines.
 		ParallelFor(Read.HorizontalBeams, [&Read, &ImagePlaneSize, &SizeXYOffset,
-			DistancesData, IntensitiesData, LabelsData, AzimuthsData, ElevationsData, ReflectivitiesData, ColorsData, ColorEncoding](int32 HorizontalBeam)
+			DistancesData, IntensitiesData, LabelsData, AzimuthsData, ElevationsData, ReflectivitiesData, ColorsData, ColorEncoding,
+			&PointCloudOptions, &PointsData, &TileToFrame, PointStrideFloats, RingColumnsData, ColumnPointCountsData](int32 HorizontalBeam)
 		{
+			int32 ColumnPoints = 0;
+
 			auto ImagePlaneLocationToPixelCoordinate = [&Read, &ImagePlaneSize, &SizeXYOffset](const FVector2D& ImagePlaneLocation)
 			{
 				return (FVector2D::UnitVector / 2.0 + ImagePlaneLocation / ImagePlaneSize) * (Read.SizeXYFOV - FVector2D::UnitVector) + SizeXYOffset;
@@ -606,10 +643,12 @@ namespace
 				const double AngleOfIncidence = FMath::RadiansToDegrees(FMath::Acos(CosAngleOfIncidence));
 				double Intensity;
 				double Distance;
+				bool bValidReturn = true;
 				if (AngleOfIncidence > Read.MaxAngleOfIncidence)
 				{
 					Distance = 0.0;
 					Intensity = 0.0;
+					bValidReturn = false;
 				}
 				else
 				{
@@ -623,6 +662,7 @@ namespace
 					{
 						Distance = 0.0;
 						Intensity = 0.0;
+						bValidReturn = false;
 					}
 					Distance = FMath::Max(Read.MinDistance, Distance);
 				}
@@ -656,9 +696,88 @@ namespace
 						ColorOut[2] = static_cast<char>(Pixel.B());
 					}
 				}
+
+				if (bValidReturn && !PointCloudOptions.IsEmpty())
+				{
+					// Point in the tile's (Unreal, left-handed, cm) frame along the calibrated ray.
+					const FVector TilePoint = SphericalToCartesian(AzimuthDeg, ElevationDeg, Distance);
+					const int32 PointIdx = HorizontalBeam * Read.VerticalBeams + ColumnPoints;
+					for (int32 Frame = 0; Frame < TempoSensors::LidarPointFrame_ARRAYSIZE; ++Frame)
+					{
+						float* const FramePoints = PointsData[Frame];
+						if (!FramePoints)
+						{
+							continue;
+						}
+						const FVector FramePoint = QuantityConverter<CM2M, L2R>::Convert(TileToFrame[Frame].TransformPosition(TilePoint));
+						float* const PointOut = FramePoints + PointIdx * PointStrideFloats;
+						PointOut[0] = static_cast<float>(FramePoint.X);
+						PointOut[1] = static_cast<float>(FramePoint.Y);
+						PointOut[2] = static_cast<float>(FramePoint.Z);
+						PointOut[3] = static_cast<float>(Intensity);
+						if constexpr (std::is_same_v<PixelType, FLidarPixelWithColor>)
+						{
+							const uint32 RGB = (static_cast<uint32>(Pixel.R()) << 16) | (static_cast<uint32>(Pixel.G()) << 8) | Pixel.B();
+							FMemory::Memcpy(&PointOut[4], &RGB, sizeof(uint32));
+						}
+					}
+					if (RingColumnsData)
+					{
+						RingColumnsData[PointIdx * 2] = static_cast<uint16>(VerticalBeam);
+						RingColumnsData[PointIdx * 2 + 1] = static_cast<uint16>(HorizontalBeam);
+					}
+					++ColumnPoints;
+				}
+			}
+
+			if (ColumnPointCountsData)
+			{
+				ColumnPointCountsData[HorizontalBeam] = ColumnPoints;
 			}
 		});
 
+		if (!PointCloudOptions.IsEmpty())
+		{
+			// Slide each column's compacted stripe down against the previous one. Destinations never
+			// pass their sources, so an in-order memmove is safe in place.
+			int32 NumPoints = 0;
+			for (int32 HorizontalBeam = 0; HorizontalBeam < Read.HorizontalBeams; ++HorizontalBeam)
+			{
+				const int32 ColumnPoints = ColumnPointCounts[HorizontalBeam];
+				const int32 SrcIdx = HorizontalBeam * Read.VerticalBeams;
+				if (SrcIdx != NumPoints && ColumnPoints > 0)
+				{
+					for (float* FramePoints : PointsData)
+					{
+						if (FramePoints)
+						{
+							FMemory::Memmove(FramePoints + NumPoints * PointStrideFloats, FramePoints + SrcIdx * PointStrideFloats,
+								ColumnPoints * PointStrideFloats * sizeof(float));
+						}
+					}
+					if (RingColumnsData)
+					{
+						FMemory::Memmove(RingColumnsData + NumPoints * 2, RingColumnsData + SrcIdx * 2, ColumnPoints * 2 * sizeof(uint16));
+					}
+				}
+				NumPoints += ColumnPoints;
+			}
+
+			for (std::string& FramePoints : PointCloudsOut.Points)
+			{
+				if (!FramePoints.empty())
+				{
+					FramePoints.resize(static_cast<size_t>(NumPoints) * PointStrideFloats * sizeof(float));
+				}
+			}
+			if (RingColumnsData)
+			{
+				PointCloudsOut.RingColumns.resize(static_cast<size_t>(NumPoints) * 2 * sizeof(uint16));
+			}
+			PointCloudsOut.NumPoints = NumPoints;
+			PointCloudsOut.StrideBytes = PointStrideFloats * sizeof(float);
+		}
+
 		Read.ExtractMeasurementHeader(TransmissionTime, ScanSegmentOut.mutable_header());
 
 		ScanSegmentOut.set_scan_count(Read.NumCaptureComponents);
@@ -692,14 +811,31 @@ namespace
 	}
 }
 
-void TTextureRead<FLidarPixel>::Decode(float TransmissionTime, TempoSensors::LidarScanSegment& ScanSegmentOut) const
+void TTextureRead<FLidarPixel>::Decode(float TransmissionTime, const FLidarPointCloudOptions& PointCloudOptions,
+	TempoSensors::LidarScanSegment& ScanSegmentOut, FLidarPointClouds& PointCloudsOut) const
+{
+	DecodeLidarRead(*this, TransmissionTime, PointCloudOptions, ScanSegmentOut, PointCloudsOut);
+}
+
+void TTextureRead<FLidarPixelWithColor>::Decode(float TransmissionTime, const FLidarPointCloudOptions& PointCloudOptions,
+	TempoSensors::LidarScanSegment& ScanSegmentOut, FLidarPointClouds& PointCloudsOut) const
 {
-	DecodeLidarRead(*this, TransmissionTime, ScanSegmentOut);
+	DecodeLidarRead(*this, TransmissionTime, PointCloudOptions, ScanSegmentOut, PointCloudsOut);
 }
 
-void TTextureRead<FLidarPixelWithColor>::Decode(float TransmissionTime, TempoSensors::LidarScanSegment& ScanSegmentOut) const
+FLidarPointCloudOptions UTempoLidar::GetPointCloudOptions() const
 {
-	DecodeLidarRead(*this, TransmissionTime, ScanSegmentOut);
+	FLidarPointCloudOptions Options;
+	for (const FLidarScanRequest& Req : PendingRequests)
+	{
+		const TempoSensors::LidarPointFrame Frame = Req.Request.point_frame();
+		if (Frame != TempoSensors::LPF_NONE && TempoSensors::LidarPointFrame_IsValid(Frame))
+		{
+			Options.FrameMask |= static_cast<uint8>(1u << Frame);
+			Options.bRingColumn |= Req.Request.include_ring_column();
+		}
+	}
+	return Options;
 }
 
 TFuture<void> UTempoLidar::DecodeAndRespond(TArray<TUniquePtr<FTextureRead>> TextureReads, bool bWithColor)
@@ -710,6 +846,7 @@ TFuture<void> UTempoLidar::DecodeAndRespond(TArray<TUniquePtr<FTextureRead>> Tex
 		this,
 		TextureReads = MoveTemp(TextureReads),
 		Requests = PendingRequests,
+		PointCloudOptions = GetPointCloudOptions(),
 		TransmissionTimeCpy = TransmissionTime,
 		bWithColor
 		]
@@ -717,29 +854,65 @@ TFuture<void> UTempoLidar::DecodeAndRespond(TArray<TUniquePtr<FTextureRead>> Tex
 		TRACE_CPUPROFILER_EVENT_SCOPE(TempoLidarDecodeAndRespond);
 
 		TArray<TempoSensors::LidarScanSegment> Segments;
+		TArray<FLidarPointClouds> PointClouds;
 		Segments.SetNum(TextureReads.Num());
+		PointClouds.SetNum(TextureReads.Num());
 		if (!Requests.IsEmpty())
 		{
-			ParallelFor(TextureReads.Num(), [&TextureReads, &Segments, TransmissionTimeCpy, bWithColor](int Index)
+			ParallelFor(TextureReads.Num(), [&TextureReads, &Segments, &PointClouds, &PointCloudOptions, TransmissionTimeCpy, bWithColor](int Index)
 			{
 				TRACE_CPUPROFILER_EVENT_SCOPE(TempoLidarDecode);
 				if (bWithColor)
 				{
-					static_cast<TTextureRead<FLidarPixelWithColor>*>(TextureReads[Index].Get())->Decode(TransmissionTimeCpy, Segments[Index]);
+					static_cast<TTextureRead<FLidarPixelWithColor>*>(TextureReads[Index].Get())->Decode(TransmissionTimeCpy, PointCloudOptions, Segments[Index], PointClouds[Index]);
 				}
 				else
 				{
-					static_cast<TTextureRead<FLidarPixel>*>(TextureReads[Index].Get())->Decode(TransmissionTimeCpy, Segments[Index]);
+					static_cast<TTextureRead<FLidarPixel>*>(TextureReads[Index].Get())->Decode(TransmissionTimeCpy, PointCloudOptions, Segments[Index], PointClouds[Index]);
 				}
 			});
 		}
 
 		TRACE_CPUPROFILER_EVENT_SCOPE(TempoLidarRespond);
-		for (const TempoSensors::LidarScanSegment& Segment : Segments)
+
+		// Requests that asked for points get a copy of the segment with the points for their frame
+		// attached. Build each (frame, ring/column) variant at most once per segment, lazily.
+		auto GetVariantKey = [](const FLidarScanRequest& Request)
+		{
+			return Request.Request.point_frame() == TempoSensors::LPF_NONE || !TempoSensors::LidarPointFrame_IsValid(Request.Request.point_frame())
+				? INDEX_NONE
+				: Request.Request.point_frame() * 2 + (Request.Request.include_ring_column() ? 1 : 0);
+		};
+
+		for (int32 SegmentIdx = 0; SegmentIdx < Segments.Num(); ++SegmentIdx)
 		{
+			const TempoSensors::LidarScanSegment& Segment = Segments[SegmentIdx];
+			TMap<int32, TempoSensors::LidarScanSegment> Variants;
 			for (const auto& Request : Requests)
 			{
-				Request.ResponseContinuation.ExecuteIfBound(Segment, grpc::Status_OK);
+				const int32 VariantKey = GetVariantKey(Request);
+				if (VariantKey == INDEX_NONE)
+				{
+					Request.ResponseContinuation.ExecuteIfBound(Segment, grpc::Status_OK);
+					continue;
+				}
+
+				TempoSensors::LidarScanSegment* Variant = Variants.Find(VariantKey);
+				if (!Variant)
+				{
+					const FLidarPointClouds& SegmentPointClouds = PointClouds[SegmentIdx];
+					const TempoSensors::LidarPointFrame Frame = Request.Request.point_frame();
+					Variant = &Variants.Add(VariantKey, Segment);
+					Variant->set_points(SegmentPointClouds.Points[Frame]);
+					Variant->set_num_points(SegmentPointClouds.NumPoints);
+					Variant->set_point_stride_bytes(SegmentPointClouds.StrideBytes);
+					Variant->set_point_frame(Frame);
+					if (Request.Request.include_ring_column())
+					{
+						Variant->set_ring_columns(SegmentPointClouds.RingColumns);
+					}
+				}
+				Request.ResponseContinuation.ExecuteIfBound(*Variant, grpc::Status_OK);
 			}
 		}
 	});
@@ -902,10 +1075,23 @@ void UTempoLidar::RenderCapture()
 	// rendering or the engine-default ring of 4 overruns once several sensors capture per frame.
 	EnsureRayTracingReadbackBuffersExpanded(Scene);
 
+	if (!TextureReadQueue.TryReserve(GetName()))
+	{
+		return;
+	}
+
+	// Only null if the pool failed to create a staging texture, which it logs and counts.
+	TSharedPtr<FTempoStagingTextureLease, ESPMode::ThreadSafe> StagingLease = AcquireNextStagingTexture();
+	if (!StagingLease.IsValid())
+	{
+		return;
+	}
+
 	// Per-tile view origin (shared across tiles) — the lidar's world location.
 	const FTransform LidarWorld = GetComponentToWorld();
 	const FVector ViewLocation = LidarWorld.GetTranslation();
 	const FQuat LidarWorldRotation = LidarWorld.GetRotation();
+	const FTransform OwnerTransform = GetOwner() ? GetOwner()->GetActorTransform() : FTransform::Identity;
 
 	// Axis swap for UE view rotation convention: view x = world z, view y = world x, view z = world y.
 	const FMatrix ViewAxisSwap(
@@ -991,7 +1177,7 @@ void UTempoLidar::RenderCapture()
 		{
 			Out.Emplace(new TTextureRead<P>(
 				Tile.SizeXY, SequenceId, CaptureTime, GetOwnerName(), GetSensorName(),
-				GetComponentTransform(), TileWorldTransform, Tile.FOVAngle, Tile.EffectiveFOVAngle,
+				GetComponentTransform(), TileWorldTransform, OwnerTransform, Tile.FOVAngle, Tile.EffectiveFOVAngle,
 				GetEffectiveVerticalFOV(), Tile.HorizontalBeams, GetEffectiveVerticalBeams(), Tile.SizeXYFOV,
 				IntensitySaturationDistance, MaxAngleOfIncidence,
 				NumActiveTiles, Tile.YawOffset, Tile.MinDepth, Tile.MaxDepth,
@@ -1027,7 +1213,7 @@ void UTempoLidar::RenderCapture()
 			GetComponentTransform(), MoveTemp(Slices));
 	}
 
-	NewRead->StagingTexture = AcquireNextStagingTexture();
+	NewRead->AssignStagingTexture(MoveTemp(StagingLease));
 
 	SequenceId++;
 
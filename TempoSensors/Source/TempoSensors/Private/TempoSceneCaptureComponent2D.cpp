@@ -74,6 +74,16 @@ void UTempoSceneCaptureComponent2D::OnRegister()
 #endif
 }
 
+void UTempoSceneCaptureComponent2D::OnUnregister()
+{
+	if (StagingTexturePool.IsValid())
+	{
+		StagingTexturePool->ReleaseReservation(this);
+	}
+
+	Super::OnUnregister();
+}
+
 void UTempoSceneCaptureComponent2D::Activate(bool bReset)
 {
 	Super::Activate(bReset);
@@ -187,8 +197,6 @@ void UTempoSceneCaptureComponent2D::UpdateSceneCaptureContents(FSceneInterface*
 void UTempoSceneCaptureComponent2D::UpdateSceneCaptureContents(FSceneInterface* Scene, ISceneRenderBuilder& SceneRenderBuilder)
 #endif
 {
-	TextureInitFence.Wait();
-
 	EnsureRayTracingReadbackBuffersExpanded(Scene);
 
 	if (!TextureTarget)
@@ -208,10 +216,11 @@ void UTempoSceneCaptureComponent2D::UpdateSceneCaptureContents(FSceneInterface*
 		return;
 	}
 
+	TSharedPtr<FTempoStagingTextureLease, ESPMode::ThreadSafe> StagingLease;
 	if (ShouldManageOwnReadback())
 	{
-		if (!ensureMsgf(StagingTextures.Num() > 0 && StagingTextures[0].IsValid() && StagingTextures[0]->IsValid(), TEXT("StagingTextures were not valid. Skipping capture.")) ||
-			!ensureMsgf(StagingTextures[0]->GetFormat() == TextureTarget->GetFormat(), TEXT("RenderTarget and StagingTextures did not have same format. Skipping Capture.")))
+		if (!ensureMsgf(StagingTexturePool.IsValid(), TEXT("StagingTextures were not allocated. Skipping capture.")) ||
+			!ensureMsgf(StagingPixelFormat == TextureTarget->GetFormat(), TEXT("RenderTarget and StagingTextures did not have same format. Skipping Capture.")))
 		{
 			return;
 		}
@@ -222,6 +231,18 @@ void UTempoSceneCaptureComponent2D::UpdateSceneCaptureContents(FSceneInterface*
 			UE_LOG(LogTempoSensors, Warning, TEXT("Fell behind while reading frames from sensor %s. Evicting oldest frame."), *GetName());
 			TextureReadQueue.EvictOldest();
 		}
+
+		if (!TextureReadQueue.TryReserve(GetName()))
+		{
+			return;
+		}
+
+		// Only null if the pool failed to create a staging texture, which it logs and counts.
+		StagingLease = AcquireNextStagingTexture();
+		if (!StagingLease.IsValid())
+		{
+			return;
+		}
 	}
 
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 6
@@ -238,7 +259,7 @@ void UTempoSceneCaptureComponent2D::UpdateSceneCaptureContents(FSceneInterface*
 	SequenceId++;
 
 	TSharedPtr<FTextureRead> NewRead(MakeTextureRead());
-	NewRead->StagingTexture = AcquireNextStagingTexture();
+	NewRead->AssignStagingTexture(MoveTemp(StagingLease));
 
 	ENQUEUE_RENDER_COMMAND(SetTempoSceneCaptureRenderFence)(
 	[NewRead](FRHICommandList& RHICmdList)
@@ -255,26 +276,6 @@ bool UTempoSceneCaptureComponent2D::IsAnyReadAwaitingRender() const
 	return TextureReadQueue.IsAnyAwaitingRender();
 }
 
-void UTempoSceneCaptureComponent2D::ReadNextIfAvailable()
-{
-	if (!TextureReadQueue.IsAnyAwaitingRender())
-	{
-		return;
-	}
-
-	const FRenderTarget* RenderTarget = TextureTarget->GetRenderTargetResource();
-	if (!ensureMsgf(RenderTarget, TEXT("RenderTarget was not initialized. Skipping texture read.")))
-	{
-		TextureReadQueue.SkipNext();
-		return;
-	}
-
-	const bool bShouldBlock = GetDefault<UTempoCoreSettings>()->GetTimeMode() == ETimeMode::FixedStep
-		&& !GetDefault<UTempoSensorsSettings>()->GetPipelinedRendering();
-
-	TextureReadQueue.ReadAllAvailable(RenderTarget, bShouldBlock);
-}
-
 void UTempoSceneCaptureComponent2D::BlockUntilNextReadComplete() const
 {
 	TextureReadQueue.BlockUntilNextReadComplete();
@@ -411,74 +412,15 @@ void UTempoSceneCaptureComponent2D::InitRenderTarget()
 
 void UTempoSceneCaptureComponent2D::AllocateStagingTextures(int32 SizeX, int32 SizeY, EPixelFormat PixelFormat)
 {
-	// Wait for any previous staging texture init render command to complete before modifying
-	// StagingTextures, since the render command accesses the array via raw pointer.
-	TextureInitFence.Wait();
+	StagingTexturePool = UTempoStagingTexturePoolSubsystem::GetPool(this);
+	StagingPixelFormat = PixelFormat;
+	StagingExtent = FIntPoint(SizeX, SizeY);
 
-	// Determine how many staging textures to create. We need at least as many as the max
-	// texture queue size to ensure each in-flight read gets its own staging texture.
+	// Enough for each read this sensor may have in flight. Sensors with the same format and extent share
+	// these, and the pool grows beyond them only as far as concurrent reads actually require.
 	const int32 MaxQueueSize = GetMaxTextureQueueSize();
 	const int32 NumStagingTextures = FMath::Max(2, MaxQueueSize > 0 ? MaxQueueSize + 1 : 2);
-
-	{
-		FScopeLock StagingTexturesLock(&StagingTexturesMutex);
-		if (NumStagingTextures != StagingTextures.Num())
-		{
-			StagingTextures.SetNum(NumStagingTextures);
-			NextStagingIndex = 0;
-		}
-	}
-
-	struct FInitStagingContext {
-		FString NameBase;
-		int32 SizeX;
-		int32 SizeY;
-		EPixelFormat PixelFormat;
-		int32 NumTextures;
-		TArray<FTextureRHIRef>* StagingTextures;
-		FCriticalSection* StagingTexturesMutex;
-	};
-
-	FInitStagingContext Context = {
-		GetName(),
-		SizeX,
-		SizeY,
-		PixelFormat,
-		NumStagingTextures,
-		&StagingTextures,
-		&StagingTexturesMutex
-	};
-
-	ENQUEUE_RENDER_COMMAND(InitTempoSceneCaptureStagingTextures)(
-		[Context](FRHICommandListImmediate& RHICmdList)
-		{
-			constexpr ETextureCreateFlags TexCreateFlags = ETextureCreateFlags::Shared | ETextureCreateFlags::CPUReadback;
-
-			for (int32 I = 0; I < Context.NumTextures; ++I)
-			{
-				// FRHITextureCreateDesc::DebugName is a non-owning const TCHAR*, so the
-				// backing string must outlive the CreateTexture call below. Keep it in a
-				// named local rather than a temporary that dies at the end of this statement.
-				const FString DebugName = FString::Printf(TEXT("%s StagingTexture %d"), *Context.NameBase, I);
-				const FRHITextureCreateDesc Desc =
-					FRHITextureCreateDesc::Create2D(*DebugName)
-					.SetExtent(Context.SizeX, Context.SizeY)
-					.SetFormat(Context.PixelFormat)
-					.SetFlags(TexCreateFlags);
-
-				{
-					FScopeLock StagingTexturesLock(Context.StagingTexturesMutex);
-#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 8
-					// RHICreateTexture with an implied immediate command list was deprecated in 5.8.
-					(*Context.StagingTextures)[I] = RHICmdList.CreateTexture(Desc);
-#else
-					(*Context.StagingTextures)[I] = RHICreateTexture(Desc);
-#endif
-				}
-			}
-		});
-
-	TextureInitFence.BeginFence();
+	StagingTexturePool->Reserve(this, StagingPixelFormat, StagingExtent, NumStagingTextures, GetName());
 }
 
 float GetTimerPeriod(float RateHz)
@@ -529,20 +471,14 @@ void UTempoSceneCaptureComponent2D::MaybeCapture()
 	}
 }
 
-FTextureRHIRef UTempoSceneCaptureComponent2D::AcquireNextStagingTexture()
+TSharedPtr<FTempoStagingTextureLease, ESPMode::ThreadSafe> UTempoSceneCaptureComponent2D::AcquireNextStagingTexture()
 {
-	// AllocateStagingTextures recreates the staging textures on the render thread asynchronously and
-	// only BeginFence()s. Block here until that completes so we never hand out a slot still holding a
-	// previous-generation texture. Otherwise a capture built against the new ImageSize/PixelType (e.g.
-	// after a SizeXY resize or the lidar's 8B->16B color-mode format change) could be paired with a
-	// stale, smaller staging texture, and FTextureRead::Read's staging-surface memcpy would over-read
-	// and crash in _platform_memmove. UpdateSceneCaptureContents already waits before its own readback;
-	// the tiled RenderCapture paths reach staging acquisition only through here, so this one wait covers
-	// every caller. Must run on the game thread (all callers do).
+	// Leases are keyed by exact format and extent, so a capture built against a new ImageSize/PixelType
+	// (e.g. after a SizeXY resize or the lidar's 8B->16B color-mode format change) can never be paired
+	// with a stale, smaller staging texture, which would make FTextureRead::Read's staging-surface memcpy
+	// over-read and crash in _platform_memmove. Null if none is ready yet, in which case the caller skips
+	// the capture. Must run on the game thread (all callers do).
 	check(IsInGameThread());
-	TextureInitFence.Wait();
-	check(StagingTextures.Num() > 0);
-	const FTextureRHIRef& Texture = StagingTextures[NextStagingIndex];
-	NextStagingIndex = (NextStagingIndex + 1) % StagingTextures.Num();
-	return Texture;
+	check(StagingTexturePool.IsValid());
+	return StagingTexturePool->Lease(StagingPixelFormat, StagingExtent, GetName());
 }
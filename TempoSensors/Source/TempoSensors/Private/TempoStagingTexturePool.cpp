@@ -0,0 +1,361 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoStagingTexturePool.h"
+
+#include "TempoSensors.h"
+#include "TempoSensorsSettings.h"
+
+#include "RenderingThread.h"
+#include "RHICommandList.h"
+
+FTempoStagingTextureLease::~FTempoStagingTextureLease()
+{
+	if (const TSharedPtr<FTempoStagingTexturePool, ESPMode::ThreadSafe> PinnedPool = Pool.Pin())
+	{
+		PinnedPool->Return(FTempoStagingTexturePool::FPoolKey(PixelFormat, Extent), Texture);
+	}
+}
+
+uint64 FTempoStagingTexturePool::GetTextureBytes(EPixelFormat PixelFormat, const FIntPoint& Extent)
+{
+	const FPixelFormatInfo& FormatInfo = GPixelFormats[PixelFormat];
+	const uint64 NumBlocksX = FMath::DivideAndRoundUp(Extent.X, FMath::Max(FormatInfo.BlockSizeX, 1));
+	const uint64 NumBlocksY = FMath::DivideAndRoundUp(Extent.Y, FMath::Max(FormatInfo.BlockSizeY, 1));
+	return NumBlocksX * NumBlocksY * FormatInfo.BlockBytes;
+}
+
+FTextureRHIRef FTempoStagingTexturePool::CreateTexture(FRHICommandListImmediate& RHICmdList, EPixelFormat PixelFormat, const FIntPoint& Extent, const FString& DebugName)
+{
+	constexpr ETextureCreateFlags TexCreateFlags = ETextureCreateFlags::Shared | ETextureCreateFlags::CPUReadback;
+
+	// FRHITextureCreateDesc::DebugName is a non-owning const TCHAR*, so DebugName must outlive the
+	// CreateTexture call below.
+	const FRHITextureCreateDesc Desc =
+		FRHITextureCreateDesc::Create2D(*DebugName)
+		.SetExtent(Extent.X, Extent.Y)
+		.SetFormat(PixelFormat)
+		.SetFlags(TexCreateFlags);
+
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 8
+	// RHICreateTexture with an implied immediate command list was deprecated in 5.8.
+	return RHICmdList.CreateTexture(Desc);
+#else
+	return RHICreateTexture(Desc);
+#endif
+}
+
+void FTempoStagingTexturePool::Reserve(const UObject* Owner, EPixelFormat PixelFormat, const FIntPoint& Extent, int32 NumTextures, const FString& DebugName)
+{
+	check(IsInGameThread());
+
+	const FPoolKey Key(PixelFormat, Extent);
+	Reservations.Add(FObjectKey(Owner), { Key, NumTextures });
+
+	int32 NumReserved = 0;
+	for (const TPair<FObjectKey, FReservation>& Reservation : Reservations)
+	{
+		if (Reservation.Value.Key == Key)
+		{
+			NumReserved += Reservation.Value.NumTextures;
+		}
+	}
+
+	int32 NumToCreate;
+	{
+		FScopeLock Lock(&Mutex);
+		FKeyedTextures& Keyed = Textures.FindOrAdd(Key);
+		NumToCreate = NumReserved - Keyed.Idle.Num() - Keyed.Ready.Num() - Keyed.NumPending - Keyed.NumLeased;
+		if (NumToCreate <= 0)
+		{
+			return;
+		}
+		Keyed.NumPending += NumToCreate;
+	}
+
+	CreateTextures(Key, NumToCreate, /*bForLease=*/false, DebugName);
+}
+
+void FTempoStagingTexturePool::ReleaseReservation(const UObject* Owner)
+{
+	check(IsInGameThread());
+
+	Reservations.Remove(FObjectKey(Owner));
+}
+
+void FTempoStagingTexturePool::CreateTextures(const FPoolKey& Key, int32 NumToCreate, bool bForLease, const FString& DebugName)
+{
+	ENQUEUE_RENDER_COMMAND(CreateTempoStagingTextures)(
+		[WeakPool = AsWeak(), Key, NumToCreate, bForLease, DebugName](FRHICommandListImmediate& RHICmdList)
+		{
+			TArray<FTextureRHIRef> Created;
+			Created.Reserve(NumToCreate);
+			for (int32 I = 0; I < NumToCreate; ++I)
+			{
+				Created.Add(CreateTexture(RHICmdList, Key.Key, Key.Value, FString::Printf(TEXT("%s StagingTexture %d"), *DebugName, I)));
+			}
+			if (const TSharedPtr<FTempoStagingTexturePool, ESPMode::ThreadSafe> Pool = WeakPool.Pin())
+			{
+				Pool->AddCreated(Key, MoveTemp(Created), bForLease);
+			}
+		});
+}
+
+void FTempoStagingTexturePool::AddCreated(const FPoolKey& Key, TArray<FTextureRHIRef>&& Created, bool bForLease)
+{
+	const uint64 TextureBytes = GetTextureBytes(Key.Key, Key.Value);
+	const double Now = FPlatformTime::Seconds();
+
+	FScopeLock Lock(&Mutex);
+	FKeyedTextures& Keyed = Textures.FindOrAdd(Key);
+	Keyed.NumPending -= Created.Num();
+	for (FTextureRHIRef& Texture : Created)
+	{
+		if (bForLease)
+		{
+			if (Texture.IsValid())
+			{
+				Keyed.Ready.Add(MoveTemp(Texture));
+			}
+			else
+			{
+				// Creation failed. Nothing to pool, but it was counted when its lease missed.
+				Stats.PooledBytes -= TextureBytes;
+				Stats.NumTextures--;
+			}
+			continue;
+		}
+
+		if (!Texture.IsValid())
+		{
+			continue;
+		}
+		Keyed.Idle.Add({ MoveTemp(Texture), Now });
+		Stats.PooledBytes += TextureBytes;
+		Stats.IdleBytes += TextureBytes;
+		Stats.NumTextures++;
+	}
+	Stats.PeakPooledBytes = FMath::Max(Stats.PeakPooledBytes, Stats.PooledBytes);
+
+	EvictLocked(0, Now);
+}
+
+FTextureRHIRef FTempoStagingTexturePool::TakeLocked(const FPoolKey& Key)
+{
+	FKeyedTextures* Keyed = Textures.Find(Key);
+	if (!Keyed)
+	{
+		return FTextureRHIRef();
+	}
+
+	FTextureRHIRef Texture;
+	if (Keyed->Ready.Num() > 0)
+	{
+		Texture = Keyed->Ready.Pop(EAllowShrinking::No);
+	}
+	else if (Keyed->Idle.Num() > 0)
+	{
+		Texture = Keyed->Idle.Pop(EAllowShrinking::No).Texture;
+		Stats.IdleBytes -= GetTextureBytes(Key.Key, Key.Value);
+	}
+	if (Texture.IsValid())
+	{
+		Keyed->NumLeased++;
+		Stats.NumLeased++;
+	}
+	return Texture;
+}
+
+TSharedPtr<FTempoStagingTextureLease, ESPMode::ThreadSafe> FTempoStagingTexturePool::Lease(EPixelFormat PixelFormat, const FIntPoint& Extent, const FString& DebugName)
+{
+	check(IsInGameThread());
+
+	const FPoolKey Key(PixelFormat, Extent);
+	const uint64 TextureBytes = GetTextureBytes(PixelFormat, Extent);
+
+	{
+		FScopeLock Lock(&Mutex);
+		if (const FTextureRHIRef Texture = TakeLocked(Key))
+		{
+			Stats.NumHits++;
+			return MakeShared<FTempoStagingTextureLease, ESPMode::ThreadSafe>(AsShared(), Texture, PixelFormat, Extent);
+		}
+		Stats.NumMisses++;
+	}
+
+	// Nothing is ready, so wait for a texture rather than skip the read: first for any already on their way
+	// (from a Reserve), then, if budget eviction took those, for one created for this lease alone.
+	bool bCreatedForLease = false;
+	while (true)
+	{
+		bool bCreateForLease = false;
+		{
+			FScopeLock Lock(&Mutex);
+			if (Textures.FindOrAdd(Key).NumPending == 0)
+			{
+				if (bCreatedForLease)
+				{
+					// The texture created for this lease failed.
+					break;
+				}
+				bCreateForLease = true;
+
+				EvictLocked(TextureBytes, FPlatformTime::Seconds());
+				if (Stats.PooledBytes + TextureBytes > BudgetBytes)
+				{
+					Stats.NumOverBudgetAllocations++;
+				}
+				// Count the texture now so returns racing with its creation evict against the right total.
+				Stats.PooledBytes += TextureBytes;
+				Stats.PeakPooledBytes = FMath::Max(Stats.PeakPooledBytes, Stats.PooledBytes);
+				Stats.NumTextures++;
+				// EvictLocked may have forgotten an empty key.
+				Textures.FindOrAdd(Key).NumPending++;
+			}
+		}
+
+		if (bCreateForLease)
+		{
+			CreateTextures(Key, 1, /*bForLease=*/true, DebugName);
+			bCreatedForLease = true;
+		}
+
+		FRenderCommandFence CreatedFence;
+		CreatedFence.BeginFence();
+		CreatedFence.Wait();
+
+		FScopeLock Lock(&Mutex);
+		if (const FTextureRHIRef Texture = TakeLocked(Key))
+		{
+			return MakeShared<FTempoStagingTextureLease, ESPMode::ThreadSafe>(AsShared(), Texture, PixelFormat, Extent);
+		}
+	}
+
+	FScopeLock Lock(&Mutex);
+	Stats.NumRefusals++;
+	UE_LOG(LogTempoSensors, Error, TEXT("Failed to create a %dx%d %s staging texture for %s. Refusing its lease."),
+		Extent.X, Extent.Y, GPixelFormats[PixelFormat].Name, *DebugName);
+	return nullptr;
+}
+
+void FTempoStagingTexturePool::Return(const FPoolKey& Key, const FTextureRHIRef& Texture)
+{
+	const uint64 TextureBytes = GetTextureBytes(Key.Key, Key.Value);
+	const double Now = FPlatformTime::Seconds();
+
+	FScopeLock Lock(&Mutex);
+	Stats.NumLeased--;
+	FKeyedTextures& Keyed = Textures.FindOrAdd(Key);
+	Keyed.NumLeased--;
+	Keyed.Idle.Add({ Texture, Now });
+	Stats.IdleBytes += TextureBytes;
+
+	EvictLocked(0, Now);
+}
+
+void FTempoStagingTexturePool::Trim()
+{
+	FScopeLock Lock(&Mutex);
+	EvictLocked(0, FPlatformTime::Seconds());
+}
+
+void FTempoStagingTexturePool::SetBudget(uint64 BudgetBytesIn, double IdleTimeoutIn)
+{
+	FScopeLock Lock(&Mutex);
+	BudgetBytes = BudgetBytesIn;
+	IdleTimeout = IdleTimeoutIn;
+}
+
+FTempoStagingTexturePoolStats FTempoStagingTexturePool::GetStats() const
+{
+	FScopeLock Lock(&Mutex);
+	FTempoStagingTexturePoolStats Result = Stats;
+	Result.BudgetBytes = BudgetBytes;
+	return Result;
+}
+
+void FTempoStagingTexturePool::EvictLocked(uint64 ExtraBytes, double Now)
+{
+	// Forget keys with nothing idle, ready, pending or leased (e.g. a sensor's old extent after it reconfigured).
+	for (auto It = Textures.CreateIterator(); It; ++It)
+	{
+		const FKeyedTextures& Keyed = It.Value();
+		if (Keyed.Idle.IsEmpty() && Keyed.Ready.IsEmpty() && Keyed.NumPending == 0 && Keyed.NumLeased == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	while (true)
+	{
+		// Each idle list is ordered oldest first, so the least recently used texture heads one of them.
+		const FPoolKey* OldestKey = nullptr;
+		TArray<FIdleTexture>* OldestIdle = nullptr;
+		for (TPair<FPoolKey, FKeyedTextures>& Pair : Textures)
+		{
+			TArray<FIdleTexture>& Idle = Pair.Value.Idle;
+			if (Idle.Num() > 0 && (!OldestIdle || Idle[0].LastUsedTime < (*OldestIdle)[0].LastUsedTime))
+			{
+				OldestKey = &Pair.Key;
+				OldestIdle = &Idle;
+			}
+		}
+
+		if (!OldestIdle)
+		{
+			return;
+		}
+
+		const bool bOverBudget = Stats.PooledBytes + ExtraBytes > BudgetBytes;
+		const bool bExpired = Now - (*OldestIdle)[0].LastUsedTime > IdleTimeout;
+		if (!bOverBudget && !bExpired)
+		{
+			return;
+		}
+
+		const uint64 TextureBytes = GetTextureBytes(OldestKey->Key, OldestKey->Value);
+		OldestIdle->RemoveAt(0, EAllowShrinking::No);
+		Stats.PooledBytes -= TextureBytes;
+		Stats.IdleBytes -= TextureBytes;
+		Stats.NumTextures--;
+		Stats.NumEvictions++;
+	}
+}
+
+TSharedRef<FTempoStagingTexturePool, ESPMode::ThreadSafe> UTempoStagingTexturePoolSubsystem::MakePool()
+{
+	const UTempoSensorsSettings* Settings = GetDefault<UTempoSensorsSettings>();
+	return MakeShared<FTempoStagingTexturePool, ESPMode::ThreadSafe>(
+		Settings->GetStagingTexturePoolBudgetBytes(), Settings->GetStagingTextureIdleTimeout());
+}
+
+void UTempoStagingTexturePoolSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Pool = MakePool();
+}
+
+void UTempoStagingTexturePoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	InWorld.GetTimerManager().SetTimer(TrimTimerHandle, FTimerDelegate::CreateWeakLambda(this, [this]()
+	{
+		// Pick up settings edited while playing.
+		const UTempoSensorsSettings* Settings = GetDefault<UTempoSensorsSettings>();
+		Pool->SetBudget(Settings->GetStagingTexturePoolBudgetBytes(), Settings->GetStagingTextureIdleTimeout());
+		Pool->Trim();
+	}), TrimPeriod, true);
+}
+
+TSharedRef<FTempoStagingTexturePool, ESPMode::ThreadSafe> UTempoStagingTexturePoolSubsystem::GetPool(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr)
+	{
+		if (const UTempoStagingTexturePoolSubsystem* Subsystem = World->GetSubsystem<UTempoStagingTexturePoolSubsystem>())
+		{
+			return Subsystem->Pool.ToSharedRef();
+		}
+	}
+	return MakePool();
+}
@@ -3,6 +3,7 @@
 #include "TempoTiledSceneCaptureComponent.h"
 
 #include "TempoSensors.h"
+#include "TempoSensorServiceSubsystem.h"
 #include "TempoSensorsSettings.h"
 
 #include "TempoCoreSettings.h"
@@ -116,6 +117,11 @@ void UTempoTiledSceneCaptureComponent::Activate(bool bReset)
 	if (UTempoCoreUtils::IsGameWorld(this))
 	{
 		RestartCaptureTimer();
+
+		if (UTempoSensorServiceSubsystem* SensorServiceSubsystem = GetWorld()->GetSubsystem<UTempoSensorServiceSubsystem>())
+		{
+			SensorServiceSubsystem->OnSensorActivated(this);
+		}
 	}
 }
 
@@ -128,6 +134,10 @@ void UTempoTiledSceneCaptureComponent::Deactivate()
 		if (UWorld* World = GetWorld())
 		{
 			World->GetTimerManager().ClearTimer(TimerHandle);
+			if (UTempoSensorServiceSubsystem* SensorServiceSubsystem = World->GetSubsystem<UTempoSensorServiceSubsystem>())
+			{
+				SensorServiceSubsystem->OnSensorDeactivated(this);
+			}
 		}
 		TextureReadQueue.Empty();
 	}
@@ -139,6 +149,15 @@ void UTempoTiledSceneCaptureComponent::OnUnregister()
 	// (matches USceneCaptureComponent::OnUnregister, which destroys the inherited ViewStates here).
 	DeactivateAllTiles();
 
+	// Unregistering doesn't necessarily deactivate us, so tell the sensor service we're going away.
+	if (const UWorld* World = GetWorld(); World && UTempoCoreUtils::IsGameWorld(this))
+	{
+		if (UTempoSensorServiceSubsystem* SensorServiceSubsystem = World->GetSubsystem<UTempoSensorServiceSubsystem>())
+		{
+			SensorServiceSubsystem->OnSensorDeactivated(this);
+		}
+	}
+
 	Super::OnUnregister();
 }
 
@@ -0,0 +1,138 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoStagingTexturePool.h"
+
+#include "Misc/AutomationTest.h"
+#include "RenderingThread.h"
+
+// Bookkeeping tests for FTempoStagingTexturePool: reservations, leases that wait for a texture, reuse,
+// budget eviction, idle eviction and stats. The pool creates real (small) staging textures on the render thread, so these need an RHI, though the
+// null RHI is enough. Run via Scripts/Test.sh, or from the editor console with
+//   Automation RunTests Tempo.Sensors.StagingTexturePool
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoStagingTexturePoolTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	const FIntPoint SmallExtent(64, 32);
+	const FIntPoint LargeExtent(128, 64);
+	constexpr EPixelFormat TestFormat = PF_B8G8R8A8;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoStagingTexturePoolReuseTest,
+	"Tempo.Sensors.StagingTexturePool.Reuse", TempoStagingTexturePoolTestFlags)
+bool FTempoStagingTexturePoolReuseTest::RunTest(const FString& Parameters)
+{
+	const uint64 SmallBytes = FTempoStagingTexturePool::GetTextureBytes(TestFormat, SmallExtent);
+	TestEqual(TEXT("Texture size is extent times pixel size"), SmallBytes, static_cast<uint64>(64 * 32 * 4));
+
+	const TSharedRef<FTempoStagingTexturePool, ESPMode::ThreadSafe> Pool =
+		MakeShared<FTempoStagingTexturePool, ESPMode::ThreadSafe>(SmallBytes * 8, 1000.0);
+
+	// Reservations of the same kind by different owners add up, and an owner's new reservation replaces its old one.
+	UObject* FirstOwner = NewObject<UObject>();
+	UObject* SecondOwner = NewObject<UObject>();
+	Pool->Reserve(FirstOwner, TestFormat, SmallExtent, 1, TEXT("Test"));
+	Pool->Reserve(FirstOwner, TestFormat, SmallExtent, 1, TEXT("Test"));
+	Pool->Reserve(SecondOwner, TestFormat, SmallExtent, 1, TEXT("Test"));
+	FlushRenderingCommands();
+	TestEqual(TEXT("Reservations add up per owner"), Pool->GetStats().NumTextures, 2);
+	Pool->ReleaseReservation(FirstOwner);
+	Pool->ReleaseReservation(SecondOwner);
+	{
+		TSharedPtr<FTempoStagingTextureLease, ESPMode::ThreadSafe> First = Pool->Lease(TestFormat, SmallExtent, TEXT("Test"));
+		TSharedPtr<FTempoStagingTextureLease, ESPMode::ThreadSafe> Second = Pool->Lease(TestFormat, SmallExtent, TEXT("Test"));
+		TestTrue(TEXT("Leased textures are valid"), First->GetTexture().IsValid() && Second->GetTexture().IsValid());
+		TestNotEqual(TEXT("Concurrent leases get distinct textures"), First->GetTexture().GetReference(), Second->GetTexture().GetReference());
+		TestEqual(TEXT("Extent matches the lease"), First->GetTexture()->GetSizeXY(), SmallExtent);
+
+		const FTempoStagingTexturePoolStats Stats = Pool->GetStats();
+		TestEqual(TEXT("Reserved textures serve the first leases"), Stats.NumHits, static_cast<uint64>(2));
+		TestEqual(TEXT("No misses yet"), Stats.NumMisses, static_cast<uint64>(0));
+		TestEqual(TEXT("Both are leased"), Stats.NumLeased, 2);
+		TestEqual(TEXT("Nothing idle"), Stats.IdleBytes, static_cast<uint64>(0));
+	}
+
+	// Returned textures are reused, most recently returned first.
+	FRHITexture* Reused;
+	{
+		TSharedPtr<FTempoStagingTextureLease, ESPMode::ThreadSafe> Lease = Pool->Lease(TestFormat, SmallExtent, TEXT("Test"));
+		Reused = Lease->GetTexture().GetReference();
+	}
+	{
+		TSharedPtr<FTempoStagingTextureLease, ESPMode::ThreadSafe> Lease = Pool->Lease(TestFormat, SmallExtent, TEXT("Test"));
+		TestEqual(TEXT("The warmest texture is reused"), Lease->GetTexture().GetReference(), Reused);
+	}
+
+	// A different extent misses: the lease waits for a texture of its own to be created, which the next reuses.
+	{
+		TSharedPtr<FTempoStagingTextureLease, ESPMode::ThreadSafe> Lease = Pool->Lease(TestFormat, LargeExtent, TEXT("Test"));
+		TestTrue(TEXT("A lease with nothing ready waits for a texture"), Lease.IsValid());
+		TestEqual(TEXT("Extent matches the lease"), Lease->GetTexture()->GetSizeXY(), LargeExtent);
+	}
+	TestTrue(TEXT("The created texture is reused"), Pool->Lease(TestFormat, LargeExtent, TEXT("Test")).IsValid());
+
+	const FTempoStagingTexturePoolStats Stats = Pool->GetStats();
+	TestEqual(TEXT("Five hits"), Stats.NumHits, static_cast<uint64>(5));
+	TestEqual(TEXT("One miss"), Stats.NumMisses, static_cast<uint64>(1));
+	TestEqual(TEXT("No refusals"), Stats.NumRefusals, static_cast<uint64>(0));
+	TestEqual(TEXT("Three textures pooled"), Stats.NumTextures, 3);
+	TestEqual(TEXT("Nothing leased"), Stats.NumLeased, 0);
+	TestEqual(TEXT("All pooled bytes are idle"), Stats.IdleBytes, Stats.PooledBytes);
+	TestEqual(TEXT("Pooled bytes add up"), Stats.PooledBytes,
+		2 * SmallBytes + FTempoStagingTexturePool::GetTextureBytes(TestFormat, LargeExtent));
+	TestEqual(TEXT("Hit rate"), Stats.GetHitRate(), 5.0 / 6.0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoStagingTexturePoolEvictionTest,
+	"Tempo.Sensors.StagingTexturePool.Eviction", TempoStagingTexturePoolTestFlags)
+bool FTempoStagingTexturePoolEvictionTest::RunTest(const FString& Parameters)
+{
+	const uint64 SmallBytes = FTempoStagingTexturePool::GetTextureBytes(TestFormat, SmallExtent);
+	const TSharedRef<FTempoStagingTexturePool, ESPMode::ThreadSafe> Pool =
+		MakeShared<FTempoStagingTexturePool, ESPMode::ThreadSafe>(SmallBytes * 2, 1000.0);
+
+	// Leasing past the budget is allowed and counted; nothing is idle to evict.
+	{
+		TArray<TSharedPtr<FTempoStagingTextureLease, ESPMode::ThreadSafe>> Leases;
+		for (int32 I = 0; I < 4; ++I)
+		{
+			Leases.Add(Pool->Lease(TestFormat, SmallExtent, TEXT("Test")));
+		}
+		const FTempoStagingTexturePoolStats Stats = Pool->GetStats();
+		TestEqual(TEXT("All four are pooled"), Stats.PooledBytes, 4 * SmallBytes);
+		TestEqual(TEXT("Two allocations exceeded the budget"), Stats.NumOverBudgetAllocations, static_cast<uint64>(2));
+	}
+
+	// Returning them trims the pool back to its budget.
+	FTempoStagingTexturePoolStats Stats = Pool->GetStats();
+	TestEqual(TEXT("Returns evict down to the budget"), Stats.PooledBytes, 2 * SmallBytes);
+	TestEqual(TEXT("Two evictions"), Stats.NumEvictions, static_cast<uint64>(2));
+	TestEqual(TEXT("Peak reflects the overshoot"), Stats.PeakPooledBytes, 4 * SmallBytes);
+
+	// Lowering the idle timeout releases everything idle on the next trim.
+	Pool->SetBudget(SmallBytes * 2, 0.0);
+	FPlatformProcess::Sleep(0.01f);
+	Pool->Trim();
+	Stats = Pool->GetStats();
+	TestEqual(TEXT("Idle textures expire"), Stats.PooledBytes, static_cast<uint64>(0));
+	TestEqual(TEXT("No textures remain"), Stats.NumTextures, 0);
+
+	// A lease still outstanding when the pool goes away simply releases its texture.
+	TSharedPtr<FTempoStagingTextureLease, ESPMode::ThreadSafe> Orphan;
+	{
+		const TSharedRef<FTempoStagingTexturePool, ESPMode::ThreadSafe> ShortLivedPool =
+			MakeShared<FTempoStagingTexturePool, ESPMode::ThreadSafe>(SmallBytes, 1000.0);
+		Orphan = ShortLivedPool->Lease(TestFormat, SmallExtent, TEXT("Test"));
+	}
+	Orphan.Reset();
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,207 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoBoundedSPSCRing.h"
+#include "TempoSceneCaptureComponent2D.h"
+
+#include "Async/Async.h"
+#include "Misc/AutomationTest.h"
+
+// Multithreaded stress tests for TBoundedSPSCRing and FTextureReadQueue. The texture reads here are
+// fakes whose Read() just completes, so no RHI, world or render thread is needed: two task threads
+// stand in for the game and render threads. Run via Scripts/Test.sh, or from the editor console with
+//   Automation RunTests Tempo.Sensors.TextureReadQueue
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoTextureReadQueueTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	struct FFakeTextureRead : FTextureRead
+	{
+		explicit FFakeTextureRead(int32 SequenceIdIn)
+			: FTextureRead(FIntPoint(1, 1), SequenceIdIn, 0.0, TEXT("Owner"), TEXT("Sensor"), FTransform::Identity) {}
+
+		virtual FName GetType() const override { return TEXT("Fake"); }
+
+		virtual void Read(const FRenderTarget* RenderTarget) override
+		{
+			State = State::EReadComplete;
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoBoundedSPSCRingBasicsTest,
+	"Tempo.Sensors.TextureReadQueue.RingBasics", TempoTextureReadQueueTestFlags)
+bool FTempoBoundedSPSCRingBasicsTest::RunTest(const FString& Parameters)
+{
+	TBoundedSPSCRing<int32> Ring(5);
+	TestEqual(TEXT("Capacity rounds up to a power of two"), Ring.GetCapacity(), 8u);
+
+	for (int32 I = 0; I < 8; ++I)
+	{
+		TestTrue(*FString::Printf(TEXT("Push %d succeeds"), I), Ring.Push(CopyTemp(I)));
+	}
+	TestFalse(TEXT("Push to a full ring fails"), Ring.Push(8));
+	TestEqual(TEXT("Full ring holds Capacity items"), Ring.Num(), 8u);
+
+	// Wrap around a few times to exercise the index masking.
+	int32 Expected = 0;
+	int32 Next = 8;
+	for (int32 Round = 0; Round < 20; ++Round)
+	{
+		int32 Value = -1;
+		TestTrue(TEXT("Pop from a non-empty ring succeeds"), Ring.Pop(Value));
+		TestEqual(TEXT("Items pop in FIFO order"), Value, Expected++);
+		TestTrue(TEXT("Push after a pop succeeds"), Ring.Push(CopyTemp(Next)));
+		++Next;
+	}
+
+	int32 Value;
+	while (Ring.Pop(Value))
+	{
+		TestEqual(TEXT("Remaining items pop in FIFO order"), Value, Expected++);
+	}
+	TestTrue(TEXT("Drained ring is empty"), Ring.IsEmpty());
+	TestFalse(TEXT("Pop from an empty ring fails"), Ring.Pop(Value));
+
+	// Popping releases the slot's reference.
+	TBoundedSPSCRing<TSharedPtr<int32>> PtrRing(2);
+	TSharedPtr<int32> Shared = MakeShared<int32>(7);
+	PtrRing.Push(CopyTemp(Shared));
+	TSharedPtr<int32> Popped;
+	PtrRing.Pop(Popped);
+	Popped.Reset();
+	TestEqual(TEXT("Popped slot does not retain its item"), Shared.GetSharedReferenceCount(), 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoBoundedSPSCRingStressTest,
+	"Tempo.Sensors.TextureReadQueue.RingStress", TempoTextureReadQueueTestFlags)
+bool FTempoBoundedSPSCRingStressTest::RunTest(const FString& Parameters)
+{
+	constexpr int64 NumItems = 2000000;
+	TBoundedSPSCRing<int64> Ring(64);
+
+	TFuture<int64> Producer = Async(EAsyncExecution::Thread, [&Ring]()
+	{
+		int64 NumFullRetries = 0;
+		for (int64 Item = 0; Item < NumItems; ++Item)
+		{
+			while (!Ring.Push(CopyTemp(Item)))
+			{
+				++NumFullRetries;
+				FPlatformProcess::Yield();
+			}
+		}
+		return NumFullRetries;
+	});
+
+	TFuture<int64> Consumer = Async(EAsyncExecution::Thread, [&Ring]()
+	{
+		// Returns the number of items that arrived out of order (expected zero).
+		int64 NumOutOfOrder = 0;
+		int64 Expected = 0;
+		while (Expected < NumItems)
+		{
+			int64 Item;
+			if (!Ring.Pop(Item))
+			{
+				FPlatformProcess::Yield();
+				continue;
+			}
+			NumOutOfOrder += Item != Expected;
+			Expected = Item + 1;
+		}
+		return NumOutOfOrder;
+	});
+
+	const int64 NumFullRetries = Producer.Get();
+	TestEqual(TEXT("Every item is received exactly once, in order"), Consumer.Get(), static_cast<int64>(0));
+	TestTrue(TEXT("Ring is empty afterwards"), Ring.IsEmpty());
+	AddInfo(FString::Printf(TEXT("Producer found the ring full %lld times"), NumFullRetries));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoTextureReadQueueStressTest,
+	"Tempo.Sensors.TextureReadQueue.QueueStress", TempoTextureReadQueueTestFlags)
+bool FTempoTextureReadQueueStressTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumReads = 200000;
+	constexpr int32 MaxQueueSize = 4;
+
+	FTextureReadQueue Queue(8);
+	std::atomic<bool> bGameThreadDone = false;
+
+	// The "render thread": performs reads as they arrive.
+	TFuture<void> RenderThread = Async(EAsyncExecution::Thread, [&Queue, &bGameThreadDone]()
+	{
+		while (!bGameThreadDone)
+		{
+			Queue.ReadAllAwaitingBlocking(nullptr);
+		}
+	});
+
+	// The "game thread": enqueues captures it has room for, evicts the oldest when it falls behind (as
+	// capture does with GetMaxTextureQueueSize), dequeues completed reads, and occasionally empties the
+	// queue (as a reconfigure or Deactivate does).
+	TFuture<TPair<int32, int32>> GameThread = Async(EAsyncExecution::Thread, [&Queue, &bGameThreadDone]()
+	{
+		int32 NumOutOfOrder = 0;
+		int32 LastSequenceId = -1;
+		for (int32 SequenceId = 0; SequenceId < NumReads; ++SequenceId)
+		{
+			while (Queue.Num() >= MaxQueueSize)
+			{
+				Queue.EvictOldest();
+			}
+			if (Queue.TryReserve(TEXT("Sensor")))
+			{
+				Queue.Enqueue(MakeShared<FFakeTextureRead>(SequenceId));
+			}
+
+			while (const TSharedPtr<FTextureRead> Read = Queue.DequeueIfReadComplete())
+			{
+				NumOutOfOrder += Read->SequenceId <= LastSequenceId;
+				LastSequenceId = Read->SequenceId;
+			}
+
+			if (SequenceId % 10007 == 0)
+			{
+				Queue.Empty();
+			}
+		}
+		bGameThreadDone = true;
+		return TPair<int32, int32>(NumOutOfOrder, LastSequenceId);
+	});
+
+	const TPair<int32, int32> GameThreadResult = GameThread.Get();
+	RenderThread.Wait();
+
+	// Both stand-ins have stopped, so finish the remaining reads from here.
+	Queue.ReadAllAwaitingBlocking(nullptr);
+	int32 NumRemaining = 0;
+	while (Queue.DequeueIfReadComplete())
+	{
+		++NumRemaining;
+	}
+
+	const FTextureReadQueueStats Stats = Queue.GetStats();
+	TestEqual(TEXT("Reads are dequeued in sequence order"), GameThreadResult.Key, 0);
+	TestTrue(TEXT("Some reads made it through"), GameThreadResult.Value >= 0);
+	TestEqual(TEXT("Queue is empty afterwards"), Stats.Num, 0);
+	TestEqual(TEXT("Every enqueued read was either dequeued or dropped"),
+		Stats.NumEnqueued, Stats.NumDequeued + Stats.NumDropped);
+	TestEqual(TEXT("Every capture was either enqueued or rejected"),
+		Stats.NumEnqueued + Stats.NumDroppedFull, static_cast<uint64>(NumReads));
+	TestTrue(TEXT("Queue never exceeded the caller's limit"), Stats.HighWaterMark <= MaxQueueSize);
+	AddInfo(FString::Printf(TEXT("Enqueued %llu, dequeued %llu (%d after stopping), dropped %llu, rejected %llu"),
+		Stats.NumEnqueued, Stats.NumDequeued, NumRemaining, Stats.NumDropped, Stats.NumDroppedFull));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
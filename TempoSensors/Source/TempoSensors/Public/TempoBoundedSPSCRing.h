@@ -0,0 +1,72 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+// A bounded, wait-free, single-producer/single-consumer FIFO. Push may be called from one thread and
+// Pop from one (possibly different) thread concurrently, with no locks. Capacity is rounded up to a
+// power of two. Items are moved in and out, so T must be default-constructible and move-assignable.
+template <typename T>
+class TBoundedSPSCRing
+{
+public:
+	explicit TBoundedSPSCRing(uint32 CapacityIn)
+		: Capacity(FMath::RoundUpToPowerOfTwo(FMath::Max(CapacityIn, 1u))), Mask(Capacity - 1)
+	{
+		Slots.SetNum(Capacity);
+	}
+
+	TBoundedSPSCRing(const TBoundedSPSCRing&) = delete;
+	TBoundedSPSCRing& operator=(const TBoundedSPSCRing&) = delete;
+
+	// Producer only. Returns false, leaving Item untouched, if the ring is full.
+	bool Push(T&& Item)
+	{
+		const uint32 CurrentTail = Tail.load(std::memory_order_relaxed);
+		if (CurrentTail - Head.load(std::memory_order_acquire) >= Capacity)
+		{
+			return false;
+		}
+		Slots[CurrentTail & Mask] = MoveTemp(Item);
+		Tail.store(CurrentTail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer only. Returns false if the ring is empty.
+	bool Pop(T& ItemOut)
+	{
+		const uint32 CurrentHead = Head.load(std::memory_order_relaxed);
+		if (CurrentHead == Tail.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+		ItemOut = MoveTemp(Slots[CurrentHead & Mask]);
+		// Leave a default-constructed item behind so the slot doesn't keep the popped value alive.
+		Slots[CurrentHead & Mask] = T();
+		Head.store(CurrentHead + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Exact when called from the producer or consumer while the other is idle; a snapshot otherwise.
+	uint32 Num() const
+	{
+		return Tail.load(std::memory_order_acquire) - Head.load(std::memory_order_acquire);
+	}
+
+	bool IsEmpty() const { return Num() == 0; }
+
+	uint32 GetCapacity() const { return Capacity; }
+
+private:
+	const uint32 Capacity;
+	const uint32 Mask;
+	TArray<T> Slots;
+
+	// Free-running indices (wrapping is harmless since Capacity is a power of two). Kept on separate
+	// cache lines so the producer and consumer don't false-share.
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> Head = 0;
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> Tail = 0;
+};
@@ -105,6 +105,31 @@ struct FLidarScanRequest
 	TResponseDelegate<TempoSensors::LidarScanSegment> ResponseContinuation;
 };
 
+// The union of Cartesian point-cloud outputs requested by all clients of one lidar frame. Computed
+// once per frame on the game thread and handed to every slice's Decode.
+struct FLidarPointCloudOptions
+{
+	// One bit per TempoSensors::LidarPointFrame (bit N set = frame N requested). LPF_NONE's bit is never set.
+	uint8 FrameMask = 0;
+	bool bRingColumn = false;
+
+	bool HasFrame(TempoSensors::LidarPointFrame Frame) const { return (FrameMask & (1u << Frame)) != 0; }
+	bool IsEmpty() const { return FrameMask == 0; }
+};
+
+// Cartesian point clouds produced by one slice's Decode. Points for every requested frame share the
+// same set of valid returns (and so the same NumPoints and RingColumns); only the frame differs.
+struct FLidarPointClouds
+{
+	// Packed little-endian float32 points, indexed by TempoSensors::LidarPointFrame. Empty for frames
+	// that weren't requested. See LidarScanSegment.points for the lane layout.
+	std::string Points[TempoSensors::LidarPointFrame_ARRAYSIZE];
+	// Packed little-endian uint16 (ring, column) pairs, one per point. Empty unless requested.
+	std::string RingColumns;
+	int32 NumPoints = 0;
+	int32 StrideBytes = 0;
+};
+
 // Intrinsic calibration for a single beam channel, matching vendor calibration file conventions.
 USTRUCT(BlueprintType)
 struct FLidarBeamCalibration
@@ -248,6 +273,9 @@ protected:
 
 	TFuture<void> DecodeAndRespond(TArray<TUniquePtr<FTextureRead>> TextureReads, bool bWithColor);
 
+	// Gathers the Cartesian point-cloud outputs requested by PendingRequests.
+	FLidarPointCloudOptions GetPointCloudOptions() const;
+
 	// Initialize the shared packed render target and ring of staging textures. Also assigns each
 	// active tile its SliceDestOffsetX and the packed dimensions. Format depends on bColorEnabled.
 	void InitSharedRenderTarget();
@@ -380,14 +408,14 @@ template <typename PixelType>
 struct TLidarTextureReadBase : TTextureReadBase<PixelType>
 {
 	TLidarTextureReadBase(const FIntPoint& ImageSizeIn, int32 SequenceIdIn, double CaptureTimeIn, const FString& OwnerNameIn,
-		const FString& SensorNameIn, const FTransform& SensorTransformIn, const FTransform& CaptureTransformIn,
+		const FString& SensorNameIn, const FTransform& SensorTransformIn, const FTransform& CaptureTransformIn, const FTransform& OwnerTransformIn,
 		double HorizontalFOVIn, double EffectiveHorizontalFOVIn, double VerticalFOVIn,
 		int32 HorizontalBeamsIn, int32 VerticalBeamsIn, const FVector2D& SizeXYFOVIn,
 		double IntensitySaturationDistanceIn, double MaxAngleOfIncidenceIn,
 		int32 NumCaptureComponentsIn, double RelativeYawIn, float MinDepthIn, float MaxDepthIn, double MinDistanceIn, double MaxDistanceIn,
 		TArray<FLidarBeamCalibration> BeamCalibrationIn)
 		: TTextureReadBase<PixelType>(ImageSizeIn, SequenceIdIn, CaptureTimeIn, OwnerNameIn, SensorNameIn, SensorTransformIn),
-			CaptureTransform(CaptureTransformIn), HorizontalFOV(HorizontalFOVIn), EffectiveHorizontalFOV(EffectiveHorizontalFOVIn),
+			CaptureTransform(CaptureTransformIn), OwnerTransform(OwnerTransformIn), HorizontalFOV(HorizontalFOVIn), EffectiveHorizontalFOV(EffectiveHorizontalFOVIn),
 			VerticalFOV(VerticalFOVIn), HorizontalBeams(HorizontalBeamsIn),
 			VerticalBeams(VerticalBeamsIn), SizeXYFOV(SizeXYFOVIn), IntensitySaturationDistance(IntensitySaturationDistanceIn),
 			MaxAngleOfIncidence(MaxAngleOfIncidenceIn), NumCaptureComponents(NumCaptureComponentsIn), RelativeYaw(RelativeYawIn),
@@ -397,6 +425,8 @@ struct TLidarTextureReadBase : TTextureReadBase<PixelType>
 	}
 
 	const FTransform CaptureTransform;
+	// World transform of the owning actor at capture time. Used for LPF_OWNER point clouds.
+	const FTransform OwnerTransform;
 	// Horizontal FOV in degrees, covering the nominal beam azimuths. Used for the per-beam
 	// nominal-azimuth formula and the reported azimuth range.
 	double HorizontalFOV;
@@ -426,7 +456,8 @@ struct TTextureRead<FLidarPixel> : TLidarTextureReadBase<FLidarPixel>
 
 	virtual FName GetType() const override { return TEXT("Lidar"); }
 
-	void Decode(float TransmissionTime, TempoSensors::LidarScanSegment& ScanSegmentOut) const;
+	void Decode(float TransmissionTime, const FLidarPointCloudOptions& PointCloudOptions,
+		TempoSensors::LidarScanSegment& ScanSegmentOut, FLidarPointClouds& PointCloudsOut) const;
 };
 
 template <>
@@ -436,7 +467,8 @@ struct TTextureRead<FLidarPixelWithColor> : TLidarTextureReadBase<FLidarPixelWit
 
 	virtual FName GetType() const override { return TEXT("LidarColor"); }
 
-	void Decode(float TransmissionTime, TempoSensors::LidarScanSegment& ScanSegmentOut) const;
+	void Decode(float TransmissionTime, const FLidarPointCloudOptions& PointCloudOptions,
+		TempoSensors::LidarScanSegment& ScanSegmentOut, FLidarPointClouds& PointCloudsOut) const;
 };
 
 // A texture read that holds the horizontally-packed pixels of all active lidar slices.
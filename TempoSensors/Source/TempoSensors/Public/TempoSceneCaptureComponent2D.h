@@ -9,6 +9,9 @@
 #include "Engine/TextureRenderTarget2D.h"
 #include "Engine/Texture2D.h"
 #include "TempoLensModels.h"
+#include "TempoBoundedSPSCRing.h"
+#include "TempoStagingTexturePool.h"
+#include "Containers/Deque.h"
 
 #include "TempoSceneCaptureComponent2D.generated.h"
 
@@ -23,7 +26,9 @@ struct FTextureRead
 	{
 		EAwaitingRender = 0,
 		EReading = 1,
-		EReadComplete = 2
+		EReadComplete = 2,
+		// Abandoned before it was read (evicted, skipped, or its queue emptied). Never read.
+		EDropped = 3
 	};
 
 	FTextureRead(const FIntPoint& ImageSizeIn, int32 SequenceIdIn, double CaptureTimeIn, const FString& OwnerNameIn,
@@ -40,12 +45,27 @@ struct FTextureRead
 	// The GPU fence indicating our render has completed. Set during UpdateSceneCaptureContents.
 	FGPUFenceRHIRef RenderFence;
 
-	// The staging texture assigned to this read for GPU->CPU copy.
+	// The staging texture assigned to this read for GPU->CPU copy, and its lease from the world's pool.
 	FTextureRHIRef StagingTexture;
+	TSharedPtr<FTempoStagingTextureLease, ESPMode::ThreadSafe> StagingLease;
+
+	void AssignStagingTexture(TSharedPtr<FTempoStagingTextureLease, ESPMode::ThreadSafe>&& Lease)
+	{
+		StagingTexture = Lease.IsValid() ? Lease->GetTexture() : FTextureRHIRef();
+		StagingLease = MoveTemp(Lease);
+	}
+
+	// Returns the staging texture to the pool once its contents have been copied out. A read that is
+	// dropped instead returns it when destroyed.
+	void ReleaseStagingTexture()
+	{
+		StagingTexture.SafeRelease();
+		StagingLease.Reset();
+	}
 
 	void BlockUntilReadComplete() const
 	{
-		while (State != State::EReadComplete)
+		while (State != State::EReadComplete && State != State::EDropped)
 		{
 			FPlatformProcess::Sleep(1e-4f);
 		}
@@ -81,9 +101,9 @@ struct TTextureReadBase : FTextureRead
 		State = State::EReading;
 
 		// Backstop against a staging texture whose per-pixel size or extent doesn't match this read.
-		// AcquireNextStagingTexture waits on the init fence to prevent the known producer of such a
-		// mismatch (an async staging recreate after a resize/format change), but if any path still
-		// pairs a read with an under-sized staging texture, copying ImageSize worth of PixelType out
+		// Staging textures are leased by exact format and extent, which prevents the known producer of
+		// such a mismatch (a resize/format change), but if any path still pairs a read with an
+		// under-sized staging texture, copying ImageSize worth of PixelType out
 		// of it would over-read the mapped surface and crash in _platform_memmove. Skip instead: zero
 		// the image and mark the read complete so consumers get a (blank) frame rather than corruption.
 		const int32 StagingPixelBytes = GPixelFormats[StagingTexture->GetFormat()].BlockBytes;
@@ -94,6 +114,7 @@ struct TTextureReadBase : FTextureRead
 				TEXT("Skipping texture read: staging texture (%dx%d, %dB/px) does not match read (%dx%d, %dB/px). Dropping frame."),
 				StagingExtent.X, StagingExtent.Y, StagingPixelBytes, ImageSize.X, ImageSize.Y, static_cast<int32>(sizeof(PixelType)));
 			FMemory::Memzero(Image.GetData(), Image.Num() * sizeof(PixelType));
+			ReleaseStagingTexture();
 			State = State::EReadComplete;
 			return;
 		}
@@ -135,6 +156,7 @@ struct TTextureReadBase : FTextureRead
 			}
 		}
 		RHICmdList.UnmapStagingSurface(StagingTexture);
+		ReleaseStagingTexture();
 
 		State = State::EReadComplete;
 	}
@@ -148,54 +170,150 @@ struct TTextureRead : TTextureReadBase<PixelType>
 	using TTextureReadBase<PixelType>::TTextureReadBase;
 };
 
-// An FRWScopeLock that only allows write locks on the game thread, thereby eliminating the concern
-// that upgrading to a write lock requires releasing the read lock.
-class FRWScopeLock_OnlyGTWrite : FRWScopeLock
+// Counters describing an FTextureReadQueue's traffic since it was created.
+struct FTextureReadQueueStats
 {
-public:
-	UE_NODISCARD_CTOR explicit FRWScopeLock_OnlyGTWrite(FRWLock& InLockObject,FRWScopeLockType InLockType)
-		: FRWScopeLock(InLockObject, InLockType)
-	{
-		if (InLockType != SLT_ReadOnly)
-		{
-			check(IsInGameThread());
-		}
-	}
-
-	void ReleaseReadOnlyLockAndAcquireWriteLock()
-	{
-		check(IsInGameThread());
-		ReleaseReadOnlyLockAndAcquireWriteLock_USE_WITH_CAUTION();
-	}
+	int32 Capacity = 0;
+	int32 Num = 0;
+	// The most reads that have been in the queue at once.
+	int32 HighWaterMark = 0;
+	uint64 NumEnqueued = 0;
+	uint64 NumDequeued = 0;
+	// Captures TryReserve turned away because the queue was at capacity.
+	uint64 NumDroppedFull = 0;
+	// Reads abandoned before they were dequeued, by EvictOldest or Empty.
+	uint64 NumDropped = 0;
 };
 
+// The in-flight texture reads of one sensor, oldest first.
+//
+// The game thread is the only thread that enqueues, dequeues, evicts or empties reads, so its FIFO is
+// unsynchronized. The render thread only needs to see reads in order to perform them, so Enqueue also
+// hands each read to it through a bounded, lock-free SPSC ring, which the render-thread methods drain
+// into a list of their own. The two sides share only the reads themselves (by TSharedPtr, so either
+// may let go first) and each read's atomic State: the render thread moves a read from EAwaitingRender
+// to EReading to EReadComplete, and either side may abandon a read it no longer wants by moving it
+// from EAwaitingRender to EDropped.
 struct FTextureReadQueue
 {
+	static constexpr int32 DefaultCapacity = 32;
+
+	explicit FTextureReadQueue(int32 CapacityIn = DefaultCapacity)
+		: ToRenderThread(CapacityIn), Capacity(ToRenderThread.GetCapacity()) {}
+
+	// ---- Game thread ----
+
 	int32 Num() const
 	{
-		FRWScopeLock_OnlyGTWrite ReadLock(Lock, SLT_ReadOnly);
-		return PendingTextureReads.Num();
+		PurgeDroppedReads();
+		return GameThreadReads.Num();
+	}
+
+	// Checks that Enqueue has room for one more read, before a capture spends a staging texture and
+	// render fence on it. Only Enqueue takes room (the render thread only frees it), so a reservation
+	// holds until the next Enqueue. Returns false, logging and counting the capture in NumDroppedFull,
+	// if the queue is at capacity, or the render thread has yet to take reads the game thread already
+	// evicted; the caller must then skip the capture.
+	bool TryReserve(const FString& SensorName)
+	{
+		PurgeDroppedReads();
+		if (GameThreadReads.Num() >= Capacity || ToRenderThread.Num() >= ToRenderThread.GetCapacity())
+		{
+			UE_LOG(LogTempoSensors, Warning, TEXT("Texture read queue of sensor %s is full (capacity %d). Skipping capture."), *SensorName, Capacity);
+			++Stats.NumDroppedFull;
+			return false;
+		}
+		return true;
 	}
 
 	// Shared ownership: the queue and any in-flight render-thread closures referencing the read
 	// each hold a reference, so Empty()/Deactivate() can run on the game thread without UAF'ing a
-	// closure that still needs to write the read's RenderFence.
+	// closure that still needs to write the read's RenderFence. Must follow a successful TryReserve.
 	void Enqueue(TSharedPtr<FTextureRead> TextureRead)
 	{
-		FRWScopeLock_OnlyGTWrite WriteLock(Lock, SLT_Write);
-		PendingTextureReads.Emplace(MoveTemp(TextureRead));
+		PurgeDroppedReads();
+		if (!ensureMsgf(GameThreadReads.Num() < Capacity && ToRenderThread.Push(CopyTemp(TextureRead)),
+			TEXT("Texture read %d was enqueued without a reservation and the queue is full. Dropping it."), TextureRead->SequenceId))
+		{
+			++Stats.NumDroppedFull;
+			return;
+		}
+		GameThreadReads.PushLast(MoveTemp(TextureRead));
+		++Stats.NumEnqueued;
+		Stats.HighWaterMark = FMath::Max(Stats.HighWaterMark, static_cast<int32>(GameThreadReads.Num()));
 	}
 
 	void Empty()
 	{
-		FRWScopeLock_OnlyGTWrite WriteLock(Lock, SLT_Write);
-		PendingTextureReads.Empty();
+		for (const TSharedPtr<FTextureRead>& TextureRead : GameThreadReads)
+		{
+			DropIfAwaitingRender(*TextureRead);
+		}
+		Stats.NumDropped += GameThreadReads.Num();
+		GameThreadReads.Empty();
+	}
+
+	void EvictOldest()
+	{
+		PurgeDroppedReads();
+		if (!GameThreadReads.IsEmpty())
+		{
+			DropIfAwaitingRender(*GameThreadReads.First());
+			GameThreadReads.PopFirst();
+			++Stats.NumDropped;
+		}
+	}
+
+	void BlockUntilNextReadComplete() const
+	{
+		PurgeDroppedReads();
+		if (!GameThreadReads.IsEmpty())
+		{
+			GameThreadReads.First()->BlockUntilReadComplete();
+		}
 	}
 
+	TSharedPtr<FTextureRead> DequeueIfReadComplete()
+	{
+		if (!NextReadComplete())
+		{
+			return nullptr;
+		}
+		TSharedPtr<FTextureRead> TextureRead = MoveTemp(GameThreadReads.First());
+		GameThreadReads.PopFirst();
+		++Stats.NumDequeued;
+		return TextureRead;
+	}
+
+	TOptional<int32> SequenceIdOfNextCompleteRead() const
+	{
+		if (NextReadComplete())
+		{
+			return GameThreadReads.First()->SequenceId;
+		}
+		return TOptional<int32>();
+	}
+
+	bool NextReadComplete() const
+	{
+		PurgeDroppedReads();
+		return !GameThreadReads.IsEmpty() && GameThreadReads.First()->State == FTextureRead::State::EReadComplete;
+	}
+
+	FTextureReadQueueStats GetStats() const
+	{
+		FTextureReadQueueStats Current = Stats;
+		Current.Capacity = Capacity;
+		Current.Num = Num();
+		return Current;
+	}
+
+	// ---- Render thread ----
+
 	bool IsAnyAwaitingRender() const
 	{
-		FRWScopeLock_OnlyGTWrite ReadLock(Lock, SLT_ReadOnly);
-		for (const TSharedPtr<FTextureRead>& TextureRead : PendingTextureReads)
+		DrainToRenderThread();
+		for (const TSharedPtr<FTextureRead>& TextureRead : RenderThreadReads)
 		{
 			if (TextureRead->State == FTextureRead::State::EAwaitingRender)
 			{
@@ -209,9 +327,9 @@ struct FTextureReadQueue
 	// If bBlock is true, spin-waits on each fence. Returns true if any reads were initiated.
 	bool ReadAllAvailable(const FRenderTarget* RenderTarget, bool bBlock)
 	{
-		FRWScopeLock_OnlyGTWrite ReadLock(Lock, SLT_ReadOnly);
+		DrainToRenderThread();
 		bool bAnyRead = false;
-		for (const TSharedPtr<FTextureRead>& TextureRead : PendingTextureReads)
+		for (const TSharedPtr<FTextureRead>& TextureRead : RenderThreadReads)
 		{
 			if (TextureRead->State != FTextureRead::State::EAwaitingRender || !TextureRead->RenderFence.IsValid())
 			{
@@ -229,9 +347,13 @@ struct FTextureReadQueue
 				continue;
 			}
 			TextureRead->RenderFence.SafeRelease();
-			TextureRead->Read(RenderTarget);
-			bAnyRead = true;
+			if (BeginRead(*TextureRead))
+			{
+				TextureRead->Read(RenderTarget);
+				bAnyRead = true;
+			}
 		}
+		RemoveFinishedRenderThreadReads();
 		return bAnyRead;
 	}
 
@@ -243,77 +365,72 @@ struct FTextureReadQueue
 	// path. Must run on the render thread.
 	void ReadAllAwaitingBlocking(const FRenderTarget* RenderTarget)
 	{
-		FRWScopeLock_OnlyGTWrite ReadLock(Lock, SLT_ReadOnly);
-		for (const TSharedPtr<FTextureRead>& TextureRead : PendingTextureReads)
+		DrainToRenderThread();
+		for (const TSharedPtr<FTextureRead>& TextureRead : RenderThreadReads)
 		{
-			if (TextureRead->State != FTextureRead::State::EAwaitingRender)
+			if (BeginRead(*TextureRead))
 			{
-				continue;
+				TextureRead->RenderFence.SafeRelease();
+				TextureRead->Read(RenderTarget);
 			}
-			TextureRead->RenderFence.SafeRelease();
-			TextureRead->Read(RenderTarget);
 		}
+		RemoveFinishedRenderThreadReads();
 	}
 
-	void SkipNext()
+private:
+	static bool DropIfAwaitingRender(FTextureRead& TextureRead)
 	{
-		FRWScopeLock_OnlyGTWrite WriteLock(Lock, SLT_Write);
-		if (!PendingTextureReads.IsEmpty())
-		{
-			PendingTextureReads.RemoveAt(0);
-		}
+		FTextureRead::State Expected = FTextureRead::State::EAwaitingRender;
+		return TextureRead.State.CompareExchange(Expected, FTextureRead::State::EDropped);
 	}
 
-	void EvictOldest()
+	// Claims an awaiting read for reading, so a concurrent drop from the game thread can't race it.
+	static bool BeginRead(FTextureRead& TextureRead)
 	{
-		FRWScopeLock_OnlyGTWrite WriteLock(Lock, SLT_Write);
-		if (!PendingTextureReads.IsEmpty())
-		{
-			PendingTextureReads.RemoveAt(0);
-		}
+		FTextureRead::State Expected = FTextureRead::State::EAwaitingRender;
+		return TextureRead.State.CompareExchange(Expected, FTextureRead::State::EReading);
 	}
 
-	void BlockUntilNextReadComplete() const
+	// Game thread. Discards reads at the front that the render thread abandoned.
+	void PurgeDroppedReads() const
 	{
-		FRWScopeLock_OnlyGTWrite ReadLock(Lock, SLT_ReadOnly);
-		if (!PendingTextureReads.IsEmpty())
+		while (!GameThreadReads.IsEmpty() && GameThreadReads.First()->State == FTextureRead::State::EDropped)
 		{
-			PendingTextureReads[0]->BlockUntilReadComplete();
+			GameThreadReads.PopFirst();
+			++Stats.NumDropped;
 		}
 	}
 
-	TSharedPtr<FTextureRead> DequeueIfReadComplete()
+	// Render thread.
+	void DrainToRenderThread() const
 	{
-		FRWScopeLock_OnlyGTWrite ReadLock(Lock, SLT_ReadOnly);
-		if (!PendingTextureReads.IsEmpty() && PendingTextureReads[0]->State == FTextureRead::State::EReadComplete)
+		TSharedPtr<FTextureRead> TextureRead;
+		while (ToRenderThread.Pop(TextureRead))
 		{
-			ReadLock.ReleaseReadOnlyLockAndAcquireWriteLock();
-			TSharedPtr<FTextureRead> TextureRead = MoveTemp(PendingTextureReads[0]);
-			PendingTextureReads.RemoveAt(0);
-			return TextureRead;
+			RenderThreadReads.Add(MoveTemp(TextureRead));
 		}
-		return nullptr;
 	}
 
-	TOptional<int32> SequenceIdOfNextCompleteRead() const
+	// Render thread. The game thread keeps its own reference to reads it has yet to dequeue.
+	void RemoveFinishedRenderThreadReads() const
 	{
-		FRWScopeLock_OnlyGTWrite ReadLock(Lock, SLT_ReadOnly);
-		if (!PendingTextureReads.IsEmpty() && PendingTextureReads[0]->State == FTextureRead::State::EReadComplete)
+		RenderThreadReads.RemoveAll([](const TSharedPtr<FTextureRead>& TextureRead)
 		{
-			return PendingTextureReads[0]->SequenceId;
-		}
-		return TOptional<int32>();
+			return TextureRead->State == FTextureRead::State::EReadComplete || TextureRead->State == FTextureRead::State::EDropped;
+		});
 	}
 
-	bool NextReadComplete() const
-	{
-		FRWScopeLock_OnlyGTWrite ReadLock(Lock, SLT_ReadOnly);
-		return !PendingTextureReads.IsEmpty() && PendingTextureReads[0]->State == FTextureRead::State::EReadComplete;
-	}
+	// Game thread only. Mutable so const accessors can discard abandoned reads.
+	mutable TDeque<TSharedPtr<FTextureRead>> GameThreadReads;
+	mutable FTextureReadQueueStats Stats;
 
-private:
-	TArray<TSharedPtr<FTextureRead>> PendingTextureReads;
-	mutable FRWLock Lock;
+	// Game thread -> render thread hand-off of newly enqueued reads.
+	mutable TBoundedSPSCRing<TSharedPtr<FTextureRead>> ToRenderThread;
+
+	// Render thread only.
+	mutable TArray<TSharedPtr<FTextureRead>> RenderThreadReads;
+
+	const int32 Capacity;
 };
 
 UCLASS(Abstract)
@@ -326,6 +443,8 @@ public:
 
 	virtual void OnRegister() override;
 
+	virtual void OnUnregister() override;
+
 	virtual void Activate(bool bReset) override;
 	virtual void Deactivate() override;
 
@@ -365,7 +484,6 @@ protected:
 	virtual bool ShouldManageOwnTimer() const { return true; }
 
 	bool IsAnyReadAwaitingRender() const;
-	void ReadNextIfAvailable();
 	void BlockUntilNextReadComplete() const;
 	TSharedPtr<FTextureRead> DequeueIfReadComplete();
 	TOptional<int32> SequenceIDOfNextCompleteRead() const;
@@ -423,23 +541,27 @@ protected:
 	// Gets the number of pending texture reads
 	int32 NumPendingTextureReads() const { return TextureReadQueue.Num(); }
 
-	// Returns the next staging texture from the ring buffer and advances the index.
-	FTextureRHIRef AcquireNextStagingTexture();
+public:
+	// Capacity, occupancy and drop counters of this sensor's texture read queue. Game thread only.
+	virtual FTextureReadQueueStats GetTextureReadQueueStats() const { return TextureReadQueue.GetStats(); }
 
 protected:
-	// (Re)allocates the staging-texture ring sized to the given dimensions and format. Waits for any
-	// previous init render command to complete before reallocating. Derived classes whose readback
-	// target is not the inherited TextureTarget call this from their own RT init path.
-	void AllocateStagingTextures(int32 SizeX, int32 SizeY, EPixelFormat PixelFormat);
 
-	// Ring buffer of staging textures for GPU->CPU readback. Each in-flight FTextureRead
-	// gets its own staging texture, preventing tearing when multiple frames are in flight.
-	TArray<FTextureRHIRef> StagingTextures;
-	FCriticalSection StagingTexturesMutex;
-	int32 NextStagingIndex = 0;
+	// Leases a staging texture of the current readback format and extent from the world's pool, or null
+	// if none is ready yet. Each in-flight FTextureRead holds its own, preventing tearing when multiple
+	// frames are in flight.
+	TSharedPtr<FTempoStagingTextureLease, ESPMode::ThreadSafe> AcquireNextStagingTexture();
+
+protected:
+	// Sets the readback format and extent and reserves enough textures of that kind in the world's
+	// staging texture pool for this sensor's texture queue, on top of other sensors' reservations. Derived classes whose readback target is
+	// not the inherited TextureTarget call this from their own RT init path.
+	void AllocateStagingTextures(int32 SizeX, int32 SizeY, EPixelFormat PixelFormat);
 
-	// A fence to indicate that our staging textures have been initialized. Should only be accessed from the Game thread.
-	FRenderCommandFence TextureInitFence;
+	// The pool staging textures are leased from, and the format and extent of those leases.
+	TSharedPtr<FTempoStagingTexturePool, ESPMode::ThreadSafe> StagingTexturePool;
+	EPixelFormat StagingPixelFormat = PF_Unknown;
+	FIntPoint StagingExtent = FIntPoint::ZeroValue;
 
 private:
 	// Starts or restarts the timer that calls MaybeCapture
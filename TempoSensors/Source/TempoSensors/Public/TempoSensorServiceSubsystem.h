@@ -50,6 +50,13 @@ public:
 
 	void ForEachActiveSensor(const TFunction<void(class ITempoSensorInterface*)>& Callback) const;
 
+	// Called by sensors on the game thread when they are activated in this subsystem's world, and when
+	// they are deactivated or unregistered, so derived subsystems can react to sensors coming and going
+	// without polling ForEachActiveSensor. These follow activation rather than registration, since only active sensors
+	// can be measured; unregistering reports an active sensor deactivated. A sensor may be reported deactivated more than once.
+	virtual void OnSensorActivated(class ITempoSensorInterface* Sensor) {}
+	virtual void OnSensorDeactivated(class ITempoSensorInterface* Sensor) {}
+
 	void GetAvailableSensors(const TempoCore::Empty& Request, const TResponseDelegate<TempoSensors::AvailableSensorsResponse>& ResponseContinuation) const;
 
 	void StreamColorImages(const TempoSensors::ColorImageRequest& Request, const TResponseDelegate<TempoSensors::ColorImage>& ResponseContinuation) const;
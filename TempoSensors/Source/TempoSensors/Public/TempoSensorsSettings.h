@@ -49,6 +49,8 @@ public:
 	FName GetOverridingLabelRowName() const { return OverridingLabelRowName; }
 	int32 GetMaxRenderBufferSize() const { return MaxRenderBufferSize; }
 	bool GetPipelinedRendering() const { return bPipelinedRendering; }
+	uint64 GetStagingTexturePoolBudgetBytes() const { return static_cast<uint64>(FMath::Max(StagingTexturePoolBudgetMB, 0)) << 20; }
+	float GetStagingTextureIdleTimeout() const { return StagingTextureIdleTimeout; }
 	FTempoSensorsLabelSettingsChanged TempoSensorsLabelSettingsChangedEvent;
 
 	// Lidar
@@ -146,6 +148,15 @@ private:
 	UPROPERTY(EditAnywhere, Config, Category="Advanced")
 	int32 MaxRenderBufferSize = 4;
 
+	// The memory, in MB, that the staging textures shared by all cameras and lidars in a world may occupy
+	// before idle ones are released. Exceeded only when more reads are in flight than fit in it.
+	UPROPERTY(EditAnywhere, Config, Category="Advanced", meta=(ClampMin=0))
+	int32 StagingTexturePoolBudgetMB = 1024;
+
+	// How long, in seconds, an unused staging texture stays pooled before it is released.
+	UPROPERTY(EditAnywhere, Config, Category="Advanced", meta=(ClampMin=0.0))
+	float StagingTextureIdleTimeout = 10.0;
+
 	// This special row can be overriden by a value passed through the subsurface color.
 	UPROPERTY(EditAnywhere, Config, Category="Camera")
 	FName OverridableLabelRowName = NAME_None;
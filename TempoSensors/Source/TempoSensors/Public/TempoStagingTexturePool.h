@@ -0,0 +1,183 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RHIResources.h"
+#include "TempoSubsystems.h"
+#include "UObject/ObjectKey.h"
+
+#include "TempoStagingTexturePool.generated.h"
+
+class FTempoStagingTexturePool;
+
+// Counters describing a staging texture pool since it was created.
+struct FTempoStagingTexturePoolStats
+{
+	// Bytes held by the pool, whether leased or idle.
+	uint64 PooledBytes = 0;
+	uint64 IdleBytes = 0;
+	uint64 PeakPooledBytes = 0;
+	uint64 BudgetBytes = 0;
+	int32 NumTextures = 0;
+	int32 NumLeased = 0;
+	// Leases served by a texture that was ready vs. ones that had to wait for one to be created.
+	uint64 NumHits = 0;
+	uint64 NumMisses = 0;
+	// Leases refused because their texture could not be created.
+	uint64 NumRefusals = 0;
+	// Idle textures released to stay within budget or because they went unused.
+	uint64 NumEvictions = 0;
+	// Textures created even though the pool was over budget with nothing idle to evict.
+	uint64 NumOverBudgetAllocations = 0;
+
+	double GetHitRate() const
+	{
+		const uint64 NumLeases = NumHits + NumMisses;
+		return NumLeases > 0 ? static_cast<double>(NumHits) / NumLeases : 0.0;
+	}
+};
+
+// One staging texture checked out of a pool. The texture goes back to the pool when the lease is
+// destroyed, from whichever thread that happens on.
+struct TEMPOSENSORS_API FTempoStagingTextureLease
+{
+	FTempoStagingTextureLease(const TSharedRef<FTempoStagingTexturePool, ESPMode::ThreadSafe>& PoolIn, const FTextureRHIRef& TextureIn,
+		EPixelFormat PixelFormatIn, const FIntPoint& ExtentIn)
+		: Pool(PoolIn), Texture(TextureIn), PixelFormat(PixelFormatIn), Extent(ExtentIn) {}
+
+	~FTempoStagingTextureLease();
+
+	FTempoStagingTextureLease(const FTempoStagingTextureLease&) = delete;
+	FTempoStagingTextureLease& operator=(const FTempoStagingTextureLease&) = delete;
+
+	const FTextureRHIRef& GetTexture() const { return Texture; }
+
+private:
+	TWeakPtr<FTempoStagingTexturePool, ESPMode::ThreadSafe> Pool;
+	FTextureRHIRef Texture;
+	EPixelFormat PixelFormat;
+	FIntPoint Extent;
+};
+
+// CPU-readback staging textures shared by every scene capture sensor in a world, keyed by pixel format
+// and extent. Sensors lease one per texture read and return it once the read has been mapped, so the
+// number of textures tracks the reads actually in flight rather than each sensor's worst case. Idle
+// textures are released least-recently-used first whenever the pool exceeds its budget, and once they
+// have gone unused for the idle timeout. Reservations keep enough textures ready that a lease rarely
+// waits on the render thread; one that finds nothing ready waits for a texture to be created, so no
+// sensor has to skip a read. That texture is allocated even when the pool is over budget with nothing
+// idle to evict, and counted, since waiting for another sensor's read to finish could stall the render
+// thread that has to perform it.
+class TEMPOSENSORS_API FTempoStagingTexturePool : public TSharedFromThis<FTempoStagingTexturePool, ESPMode::ThreadSafe>
+{
+public:
+	FTempoStagingTexturePool(uint64 BudgetBytesIn, double IdleTimeoutIn)
+		: BudgetBytes(BudgetBytesIn), IdleTimeout(IdleTimeoutIn) {}
+
+	// Reserves NumTextures of the given format and extent for Owner, replacing Owner's previous
+	// reservation. Reservations of the same format and extent add up, and textures are created on the
+	// render thread until the pool holds (idle, leased or pending) as many as all of them together.
+	// Does not block. Game thread only.
+	void Reserve(const UObject* Owner, EPixelFormat PixelFormat, const FIntPoint& Extent, int32 NumTextures, const FString& DebugName);
+
+	// Drops Owner's reservation. Textures already created stay pooled until evicted. Game thread only.
+	void ReleaseReservation(const UObject* Owner);
+
+	// Leases a texture of the given format and extent. If none is ready, waits for the render thread to
+	// create one. Returns null, logging and counting the refusal, only if that creation fails. Game thread only.
+	TSharedPtr<FTempoStagingTextureLease, ESPMode::ThreadSafe> Lease(EPixelFormat PixelFormat, const FIntPoint& Extent, const FString& DebugName);
+
+	// Releases idle textures that have gone unused for longer than the idle timeout, or that keep the
+	// pool over budget. Any thread.
+	void Trim();
+
+	void SetBudget(uint64 BudgetBytesIn, double IdleTimeoutIn);
+
+	FTempoStagingTexturePoolStats GetStats() const;
+
+	static uint64 GetTextureBytes(EPixelFormat PixelFormat, const FIntPoint& Extent);
+
+private:
+	friend struct FTempoStagingTextureLease;
+
+	struct FIdleTexture
+	{
+		FTextureRHIRef Texture;
+		double LastUsedTime = 0.0;
+	};
+
+	struct FKeyedTextures
+	{
+		// Most recently returned last, so leases reuse the warmest texture.
+		TArray<FIdleTexture> Idle;
+		// Created for leases that found nothing ready. Not evictable until leased, so the waiting lease is sure to get one.
+		TArray<FTextureRHIRef> Ready;
+		int32 NumPending = 0;
+		int32 NumLeased = 0;
+	};
+
+	using FPoolKey = TPair<EPixelFormat, FIntPoint>;
+
+	struct FReservation
+	{
+		FPoolKey Key;
+		int32 NumTextures = 0;
+	};
+
+	// Called by a lease's destructor.
+	void Return(const FPoolKey& Key, const FTextureRHIRef& Texture);
+
+	// Must hold Mutex. Takes a ready or idle texture for Key and counts it leased, or returns null.
+	FTextureRHIRef TakeLocked(const FPoolKey& Key);
+
+	// Enqueues creating NumToCreate textures on the render thread, which AddCreated adds to the pool.
+	// The caller must already have counted them pending.
+	void CreateTextures(const FPoolKey& Key, int32 NumToCreate, bool bForLease, const FString& DebugName);
+
+	// Adds textures created on the render thread to the idle list for Key or, if they were created for a
+	// waiting lease (which already counted their bytes), to its ready list.
+	void AddCreated(const FPoolKey& Key, TArray<FTextureRHIRef>&& Created, bool bForLease);
+
+	// Must hold Mutex. Releases idle textures, oldest first, until the pool fits within budget (after
+	// adding ExtraBytes) and no idle texture is older than the idle timeout.
+	void EvictLocked(uint64 ExtraBytes, double Now);
+
+	static FTextureRHIRef CreateTexture(FRHICommandListImmediate& RHICmdList, EPixelFormat PixelFormat, const FIntPoint& Extent, const FString& DebugName);
+
+	mutable FCriticalSection Mutex;
+	TMap<FPoolKey, FKeyedTextures> Textures;
+	uint64 BudgetBytes;
+	double IdleTimeout;
+	FTempoStagingTexturePoolStats Stats;
+
+	// Game thread only.
+	TMap<FObjectKey, FReservation> Reservations;
+};
+
+// Owns the staging texture pool shared by the scene capture sensors in a game world.
+UCLASS()
+class TEMPOSENSORS_API UTempoStagingTexturePoolSubsystem : public UTempoGameWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// The pool for WorldContextObject's world, or a new private pool if that world has none (for example
+	// sensors in an editor world).
+	static TSharedRef<FTempoStagingTexturePool, ESPMode::ThreadSafe> GetPool(const UObject* WorldContextObject);
+
+	FTempoStagingTexturePoolStats GetStats() const { return Pool->GetStats(); }
+
+private:
+	static TSharedRef<FTempoStagingTexturePool, ESPMode::ThreadSafe> MakePool();
+
+	TSharedPtr<FTempoStagingTexturePool, ESPMode::ThreadSafe> Pool;
+
+	FTimerHandle TrimTimerHandle;
+
+	float TrimPeriod = 1.0;
+};
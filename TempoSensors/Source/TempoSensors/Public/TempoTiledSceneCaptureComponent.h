@@ -34,6 +34,8 @@ public:
 	virtual bool ShouldManageOwnReadback() const override { return false; }
 	virtual bool ShouldManageOwnTimer() const override { return false; }
 
+	virtual FTextureReadQueueStats GetTextureReadQueueStats() const override { return TextureReadQueue.GetStats(); }
+
 	// Begin ITempoSensorInterface
 	virtual FString GetOwnerName() const override;
 	virtual FString GetSensorName() const override;
@@ -0,0 +1,234 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoActorNameIndex.h"
+
+#include "TempoCoreUtils.h"
+
+#include "EngineUtils.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "Misc/CoreDelegates.h"
+
+bool UTempoActorNameIndex::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const EWorldType::Type WorldType = Outer->GetWorld()->WorldType;
+	const bool bIsValidWorld = (WorldType == EWorldType::Editor || WorldType == EWorldType::PIE || WorldType == EWorldType::Game);
+
+	return bIsValidWorld && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UTempoActorNameIndex::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	UWorld* World = GetWorld();
+	ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UTempoActorNameIndex::OnActorSpawned));
+	ActorDestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &UTempoActorNameIndex::OnActorDestroyed));
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UTempoActorNameIndex::OnLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UTempoActorNameIndex::OnLevelRemoved);
+#if WITH_EDITOR
+	ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddUObject(this, &UTempoActorNameIndex::OnActorLabelChanged);
+#endif
+}
+
+void UTempoActorNameIndex::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		// (sic) UWorld's spelling.
+		World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+#if WITH_EDITOR
+	FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+#endif
+
+	ActorsByName.Empty();
+	ActorKeys.Empty();
+	bIndexBuilt = false;
+
+	Super::Deinitialize();
+}
+
+bool UTempoActorNameIndex::IdentifierMatches(const AActor* Actor, const FString& Name)
+{
+	return UTempoCoreUtils::GetActorIdentifier(Actor).Equals(Name, ESearchCase::IgnoreCase);
+}
+
+bool UTempoActorNameIndex::FNameMatches(const AActor* Actor, const FString& Name)
+{
+	return Actor->GetName().Equals(Name, ESearchCase::IgnoreCase);
+}
+
+AActor* UTempoActorNameIndex::FindActor(const FString& Name)
+{
+	if (!bIndexBuilt)
+	{
+		BuildIndex();
+	}
+
+	// An actor's identifier takes precedence over another actor's FName, so check every candidate's identifier before
+	// any FName. Either way, re-check the name in case the actor was renamed without an event we could see.
+	// FNAME_Find never adds to the name table, and FName comparison ignores case.
+	const FName Key(*Name, FNAME_Find);
+	if (!Key.IsNone())
+	{
+		if (const TArray<TWeakObjectPtr<AActor>, TInlineAllocator<1>>* Actors = ActorsByName.Find(Key))
+		{
+			for (bool (*Matches)(const AActor*, const FString&) : { &IdentifierMatches, &FNameMatches })
+			{
+				for (const TWeakObjectPtr<AActor>& WeakActor : *Actors)
+				{
+					AActor* Actor = WeakActor.Get();
+					if (IsValid(Actor) && Matches(Actor, Name))
+					{
+						return Actor;
+					}
+				}
+			}
+		}
+	}
+
+	// Not indexed under this name. Rare enough (and usually a client error) that one scan is fine. It also repairs the
+	// index: any actor it finds unindexed, or filed under names it no longer has, is re-indexed.
+	AActor* IdentifierMatch = nullptr;
+	AActor* FNameMatch = nullptr;
+	for (TActorIterator<AActor> ActorIt(GetWorld()); ActorIt; ++ActorIt)
+	{
+		AActor* Actor = *ActorIt;
+		const FString Identifier = UTempoCoreUtils::GetActorIdentifier(Actor);
+		const TArray<FName, TInlineAllocator<2>>* Keys = ActorKeys.Find(Actor);
+		if (!Keys || !Keys->Contains(Actor->GetFName()) || !Keys->Contains(FName(*Identifier, FNAME_Find)))
+		{
+			AddActor(Actor);
+		}
+
+		if (!IdentifierMatch && Identifier.Equals(Name, ESearchCase::IgnoreCase))
+		{
+			IdentifierMatch = Actor;
+		}
+		else if (!FNameMatch && FNameMatches(Actor, Name))
+		{
+			FNameMatch = Actor;
+		}
+	}
+
+	return IdentifierMatch ? IdentifierMatch : FNameMatch;
+}
+
+void UTempoActorNameIndex::BuildIndex()
+{
+	ActorsByName.Reset();
+	ActorKeys.Reset();
+	for (TActorIterator<AActor> ActorIt(GetWorld()); ActorIt; ++ActorIt)
+	{
+		AddActor(*ActorIt);
+	}
+	bIndexBuilt = true;
+}
+
+void UTempoActorNameIndex::AddActor(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	RemoveActor(Actor);
+
+	TArray<FName, TInlineAllocator<2>>& Keys = ActorKeys.Add(Actor);
+	Keys.Add(Actor->GetFName());
+	Keys.AddUnique(FName(*UTempoCoreUtils::GetActorIdentifier(Actor)));
+	for (const FName& Key : Keys)
+	{
+		ActorsByName.FindOrAdd(Key).Add(Actor);
+	}
+}
+
+void UTempoActorNameIndex::RemoveActor(const AActor* Actor)
+{
+	TArray<FName, TInlineAllocator<2>> Keys;
+	if (!ActorKeys.RemoveAndCopyValue(Actor, Keys))
+	{
+		return;
+	}
+
+	for (const FName& Key : Keys)
+	{
+		if (TArray<TWeakObjectPtr<AActor>, TInlineAllocator<1>>* Actors = ActorsByName.Find(Key))
+		{
+			// Also drop any entries whose actors were garbage collected without a destroy event.
+			Actors->RemoveAll([Actor](const TWeakObjectPtr<AActor>& WeakActor)
+			{
+				return !WeakActor.IsValid() || WeakActor.Get() == Actor;
+			});
+			if (Actors->IsEmpty())
+			{
+				ActorsByName.Remove(Key);
+			}
+		}
+	}
+}
+
+void UTempoActorNameIndex::OnActorSpawned(AActor* Actor)
+{
+	if (bIndexBuilt)
+	{
+		AddActor(Actor);
+	}
+}
+
+void UTempoActorNameIndex::OnActorDestroyed(AActor* Actor)
+{
+	RemoveActor(Actor);
+}
+
+void UTempoActorNameIndex::OnLevelAdded(ULevel* Level, UWorld* World)
+{
+	if (!bIndexBuilt || World != GetWorld() || !Level)
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		AddActor(Actor);
+	}
+}
+
+void UTempoActorNameIndex::OnLevelRemoved(ULevel* Level, UWorld* World)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	if (!Level)
+	{
+		// A null level means every level is being removed.
+		ActorsByName.Reset();
+		ActorKeys.Reset();
+		bIndexBuilt = false;
+		return;
+	}
+
+	for (const AActor* Actor : Level->Actors)
+	{
+		if (Actor)
+		{
+			RemoveActor(Actor);
+		}
+	}
+}
+
+#if WITH_EDITOR
+void UTempoActorNameIndex::OnActorLabelChanged(AActor* Actor)
+{
+	if (bIndexBuilt && Actor && Actor->GetWorld() == GetWorld())
+	{
+		AddActor(Actor);
+	}
+}
+#endif
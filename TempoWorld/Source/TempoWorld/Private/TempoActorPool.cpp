@@ -0,0 +1,277 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoActorPool.h"
+
+#include "TempoActorNameIndex.h"
+#include "TempoPoolableActorInterface.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/MovementComponent.h"
+#include "UObject/UObjectGlobals.h"
+
+bool UTempoActorPool::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const EWorldType::Type WorldType = Outer->GetWorld()->WorldType;
+	const bool bIsValidWorld = (WorldType == EWorldType::PIE || WorldType == EWorldType::Game);
+
+	return bIsValidWorld && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UTempoActorPool::Deinitialize()
+{
+	// The pooled actors go down with the world.
+	Pools.Empty();
+	PooledActors.Empty();
+
+	Super::Deinitialize();
+}
+
+void UTempoActorPool::SetMaxSize(UClass* Class, int32 MaxSize)
+{
+	FClassPool& Pool = Pools.FindOrAdd(Class);
+	Pool.MaxSize = FMath::Max(MaxSize, 0);
+	while (Pool.Actors.Num() > Pool.MaxSize)
+	{
+		const TWeakObjectPtr<AActor> Evicted = Pool.Actors.Pop();
+		if (AActor* Actor = Evicted.Get())
+		{
+			PooledActors.Remove(Actor);
+			Actor->Destroy();
+		}
+	}
+}
+
+int32 UTempoActorPool::Prewarm(UClass* Class, int32 NumActors)
+{
+	FClassPool* Pool = Pools.Find(Class);
+	if (!Pool)
+	{
+		return 0;
+	}
+
+	const int32 Target = FMath::Min(NumActors, Pool->MaxSize);
+	int32 NumAdded = 0;
+	while (Pool->Actors.Num() < Target)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AActor* Actor = GetWorld()->SpawnActor(Class, &FTransform::Identity, SpawnParameters);
+		if (!Actor)
+		{
+			break;
+		}
+		if (!Release(Actor))
+		{
+			Actor->Destroy();
+			break;
+		}
+		// Prewarming is not churn.
+		--Pool->Releases;
+		++NumAdded;
+	}
+	return NumAdded;
+}
+
+bool UTempoActorPool::IsPoolingEnabled(const UClass* Class) const
+{
+	const FClassPool* Pool = Pools.Find(Class);
+	return Pool && Pool->MaxSize > 0;
+}
+
+AActor* UTempoActorPool::Acquire(UClass* Class, const FTransform& Transform)
+{
+	FClassPool* Pool = Pools.Find(Class);
+	if (!Pool || Pool->MaxSize == 0)
+	{
+		return nullptr;
+	}
+
+	while (!Pool->Actors.IsEmpty())
+	{
+		AActor* Actor = Pool->Actors.Pop().Get();
+		if (!IsValid(Actor))
+		{
+			// Destroyed while pooled, e.g. by a level unload.
+			continue;
+		}
+		PooledActors.Remove(Actor);
+		++Pool->Hits;
+		Reactivate(Actor, Transform);
+		return Actor;
+	}
+
+	++Pool->Misses;
+	return nullptr;
+}
+
+bool UTempoActorPool::Release(AActor* Actor)
+{
+	if (!IsValid(Actor) || PooledActors.Contains(Actor))
+	{
+		return false;
+	}
+
+	FClassPool* Pool = Pools.Find(Actor->GetClass());
+	if (!Pool || Pool->MaxSize == 0)
+	{
+		return false;
+	}
+	if (Pool->Actors.Num() >= Pool->MaxSize)
+	{
+		++Pool->Refusals;
+		return false;
+	}
+
+	Deactivate(Actor);
+	Pool->Actors.Add(Actor);
+	PooledActors.Add(Actor);
+	++Pool->Releases;
+	return true;
+}
+
+bool UTempoActorPool::Reclaim(AActor* Actor, const FTransform& Transform, FName Name)
+{
+	if (!IsValid(Actor) || !PooledActors.Contains(Actor))
+	{
+		return false;
+	}
+
+	if (FClassPool* Pool = Pools.Find(Actor->GetClass()))
+	{
+		Pool->Actors.Remove(Actor);
+	}
+	PooledActors.Remove(Actor);
+	Reactivate(Actor, Transform, Name);
+	return true;
+}
+
+void UTempoActorPool::Deactivate(AActor* Actor)
+{
+	if (UTempoActorNameIndex* ActorNameIndex = GetWorld()->GetSubsystem<UTempoActorNameIndex>())
+	{
+		ActorNameIndex->RemoveActor(Actor);
+	}
+	RenameActor(Actor, *FString::Printf(TEXT("Pooled_%s"), *Actor->GetClass()->GetName()));
+
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+	Actor->ForEachComponent(false, [](UActorComponent* Component)
+	{
+		if (UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Component))
+		{
+			if (Primitive->IsSimulatingPhysics())
+			{
+				Primitive->SetSimulatePhysics(false);
+			}
+		}
+		if (Component->IsActive())
+		{
+			Component->Deactivate();
+		}
+	});
+
+	if (ITempoPoolableActorInterface* Poolable = Cast<ITempoPoolableActorInterface>(Actor))
+	{
+		Poolable->OnReleasedToPool();
+	}
+}
+
+void UTempoActorPool::Reactivate(AActor* Actor, const FTransform& Transform, FName Name)
+{
+	if (!Name.IsNone() && !StaticFindObjectFast(nullptr, Actor->GetLevel(), Name))
+	{
+		RenameActor(Actor, Name, true);
+	}
+	else
+	{
+		RenameActor(Actor, Actor->GetClass()->GetFName());
+	}
+
+	Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+
+	const AActor* Defaults = Actor->GetClass()->GetDefaultObject<AActor>();
+	Actor->SetActorHiddenInGame(Defaults->IsHidden());
+	Actor->SetActorEnableCollision(Defaults->GetActorEnableCollision());
+	Actor->SetActorTickEnabled(Defaults->PrimaryActorTick.bStartWithTickEnabled);
+	Actor->ForEachComponent(false, [](UActorComponent* Component)
+	{
+		if (UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Component))
+		{
+			// As the component was created (its template), not as it was when released.
+			const UPrimitiveComponent* Archetype = Cast<UPrimitiveComponent>(Primitive->GetArchetype());
+			if (Archetype && Archetype->BodyInstance.bSimulatePhysics)
+			{
+				Primitive->SetSimulatePhysics(true);
+			}
+		}
+		if (UMovementComponent* MovementComponent = Cast<UMovementComponent>(Component))
+		{
+			MovementComponent->StopMovementImmediately();
+		}
+		if (Component->bAutoActivate)
+		{
+			Component->Activate(true);
+		}
+	});
+
+	if (UTempoActorNameIndex* ActorNameIndex = GetWorld()->GetSubsystem<UTempoActorNameIndex>())
+	{
+		ActorNameIndex->AddActor(Actor);
+	}
+
+	if (ITempoPoolableActorInterface* Poolable = Cast<ITempoPoolableActorInterface>(Actor))
+	{
+		Poolable->ResetForReuse();
+	}
+}
+
+void UTempoActorPool::RenameActor(AActor* Actor, FName BaseName, bool bExact)
+{
+	const FName NewName = bExact ? BaseName : MakeUniqueObjectName(Actor->GetLevel(), Actor->GetClass(), BaseName);
+	Actor->Rename(*NewName.ToString(), nullptr, REN_DontCreateRedirectors | REN_NonTransactional | REN_DoNotDirty);
+#if WITH_EDITOR
+	Actor->SetActorLabel(NewName.ToString(), false);
+#endif
+}
+
+int64 UTempoActorPool::EstimateMemory(AActor* Actor)
+{
+	int64 Bytes = Actor->GetClass()->GetStructureSize() + Actor->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+	Actor->ForEachComponent(false, [&Bytes](UActorComponent* Component)
+	{
+		Bytes += Component->GetClass()->GetStructureSize() + Component->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+	});
+	return Bytes;
+}
+
+TArray<TPair<UClass*, FTempoActorPoolStats>> UTempoActorPool::GetStats() const
+{
+	TArray<TPair<UClass*, FTempoActorPoolStats>> Stats;
+	for (const TPair<TObjectKey<UClass>, FClassPool>& Pool : Pools)
+	{
+		UClass* Class = Pool.Key.ResolveObjectPtr();
+		if (!Class)
+		{
+			continue;
+		}
+
+		FTempoActorPoolStats& ClassStats = Stats.Emplace_GetRef(Class, FTempoActorPoolStats()).Value;
+		ClassStats.MaxSize = Pool.Value.MaxSize;
+		ClassStats.Hits = Pool.Value.Hits;
+		ClassStats.Misses = Pool.Value.Misses;
+		ClassStats.Releases = Pool.Value.Releases;
+		ClassStats.Refusals = Pool.Value.Refusals;
+		for (const TWeakObjectPtr<AActor>& WeakActor : Pool.Value.Actors)
+		{
+			if (AActor* Actor = WeakActor.Get())
+			{
+				++ClassStats.NumPooled;
+				ClassStats.EstimatedMemoryBytes += EstimateMemory(Actor);
+			}
+		}
+	}
+	return Stats;
+}
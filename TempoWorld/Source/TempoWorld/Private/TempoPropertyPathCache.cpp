@@ -0,0 +1,233 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoPropertyPathCache.h"
+
+#include "UObject/UnrealType.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	TUniquePtr<FTempoPropertyPathCache> PropertyPathCache;
+}
+
+FTempoPropertyPathCache& FTempoPropertyPathCache::Get()
+{
+	if (!PropertyPathCache)
+	{
+		Startup();
+	}
+	return *PropertyPathCache;
+}
+
+void FTempoPropertyPathCache::Startup()
+{
+	if (PropertyPathCache)
+	{
+		return;
+	}
+
+	PropertyPathCache = MakeUnique<FTempoPropertyPathCache>();
+	FTempoPropertyPathCache* Cache = PropertyPathCache.Get();
+	Cache->PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(Cache, &FTempoPropertyPathCache::OnPostGarbageCollect);
+	// Hot reload and live coding recreate the reloaded types' properties.
+	Cache->ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([Cache](EReloadCompleteReason)
+	{
+		Cache->Reset();
+	});
+#if WITH_EDITOR
+	// As does recompiling a Blueprint or user-defined struct, which reinstances everything using it.
+	Cache->ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([Cache](const TMap<UObject*, UObject*>&)
+	{
+		Cache->Reset();
+	});
+#endif
+}
+
+void FTempoPropertyPathCache::Shutdown()
+{
+	if (!PropertyPathCache)
+	{
+		return;
+	}
+
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PropertyPathCache->PostGarbageCollectHandle);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(PropertyPathCache->ReloadCompleteHandle);
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectsReplaced.Remove(PropertyPathCache->ObjectsReplacedHandle);
+#endif
+	PropertyPathCache.Reset();
+}
+
+FString FTempoPropertyPathCache::SplitPropertyName(FString& PropertyName)
+{
+	// If a ']' appears before any '[', we are inside a bracket scope (e.g. parsing the contents
+	// of MyMap[...]) and only ']' should terminate the segment - '.' inside the brackets is part
+	// of the key (relevant for map keys containing dots, like FString or FName keys).
+	int32 OpenBracketIdx = INDEX_NONE;
+	int32 CloseBracketIdx = INDEX_NONE;
+	PropertyName.FindChar('[', OpenBracketIdx);
+	PropertyName.FindChar(']', CloseBracketIdx);
+	const bool bInBracket = CloseBracketIdx != INDEX_NONE && (OpenBracketIdx == INDEX_NONE || CloseBracketIdx < OpenBracketIdx);
+
+	for (int32 CharIdx = 0; CharIdx < PropertyName.Len(); ++CharIdx)
+	{
+		if (!bInBracket && (PropertyName[CharIdx] == '.' || PropertyName[CharIdx] == '['))
+		{
+			// Chop everything before
+			const FString FirstPropertyName = PropertyName.LeftChop(PropertyName.Len() - CharIdx);
+			// Chop everything after
+			PropertyName.RightChopInline(CharIdx + 1);
+			return FirstPropertyName;
+		}
+		if (PropertyName[CharIdx] == ']')
+		{
+			// Chop everything before
+			const FString FirstPropertyName = PropertyName.LeftChop(PropertyName.Len() - CharIdx);
+			// Chop everything after (also chopping the '.' after the ']', if it's there)
+			PropertyName.RightChopInline(CharIdx + (CharIdx + 1 < PropertyName.Len() && PropertyName[CharIdx + 1] == '.' ? 2 : 1));
+			return FirstPropertyName;
+		}
+	}
+
+	const FString FirstPropertyName = PropertyName;
+	PropertyName.Empty(); // Nothing left
+	return FirstPropertyName;
+}
+
+bool FTempoPropertyPathCache::Resolve(const UClass* Class, const FString& Path, FTempoResolvedPropertyPath& OutResolved)
+{
+	TMap<FString, FTempoResolvedPropertyPath>& ClassPaths = Paths.FindOrAdd(Class);
+	if (const FTempoResolvedPropertyPath* Cached = ClassPaths.Find(Path))
+	{
+		++NumHits;
+		OutResolved = *Cached;
+		return true;
+	}
+	++NumMisses;
+
+	FString InnerPath = Path;
+	const FString FirstPropertyName = SplitPropertyName(InnerPath);
+	FProperty* Property = Class->FindPropertyByName(FName(FirstPropertyName));
+	if (!Property)
+	{
+		return false;
+	}
+
+	FTempoResolvedPropertyPath Resolved;
+	Resolved.Property = Property;
+	// The rest of the path is the same length in any later request it matches, whatever its case.
+	Resolved.InnerStart = Path.Len() - InnerPath.Len();
+
+	// Follow struct members as far as they go. Array indices and map keys depend on the container's
+	// contents, so paths through them are walked on every set.
+	FProperty* Current = Property;
+	int32 Offset = Property->GetOffset_ForInternal();
+	while (Current && !InnerPath.IsEmpty())
+	{
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Current);
+		if (!StructProperty)
+		{
+			Current = nullptr;
+			break;
+		}
+		Current = FindStructMember(StructProperty->Struct, SplitPropertyName(InnerPath));
+		Offset += Current ? Current->GetOffset_ForInternal() : 0;
+	}
+
+	if (Current && !CastField<FStructProperty>(Current) && !CastField<FArrayProperty>(Current) && !CastField<FMapProperty>(Current))
+	{
+		Resolved.Leaf = Current;
+		Resolved.LeafOffset = Offset;
+	}
+
+	ClassPaths.Add(Path, Resolved);
+	OutResolved = Resolved;
+	return true;
+}
+
+FTempoPropertyPathCache::FStructInfo& FTempoPropertyPathCache::GetStructInfo(const UStruct* Struct)
+{
+	TUniquePtr<FStructInfo>& Info = Structs.FindOrAdd(Struct);
+	if (!Info)
+	{
+		Info = MakeUnique<FStructInfo>();
+		for (FProperty* Member = Struct->PropertyLink; Member != nullptr; Member = Member->PropertyLinkNext)
+		{
+			const FString AuthoredName = Member->GetAuthoredName();
+			Info->Members.Add({ Member, AuthoredName });
+			// First declared wins, as with a linear search.
+			if (!Info->MembersByName.Contains(AuthoredName))
+			{
+				Info->MembersByName.Add(AuthoredName, Member);
+			}
+		}
+	}
+	return *Info;
+}
+
+FProperty* FTempoPropertyPathCache::FindStructMember(const UStruct* Struct, const FString& Name)
+{
+	return GetStructInfo(Struct).MembersByName.FindRef(Name);
+}
+
+const TArray<FTempoStructMember>& FTempoPropertyPathCache::GetStructMembers(const UStruct* Struct)
+{
+	return GetStructInfo(Struct).Members;
+}
+
+const TArray<FTempoClassProperty>& FTempoPropertyPathCache::GetClassProperties(const UClass* Class)
+{
+	TUniquePtr<TArray<FTempoClassProperty>>& Properties = ClassProperties.FindOrAdd(Class);
+	if (!Properties)
+	{
+		Properties = MakeUnique<TArray<FTempoClassProperty>>();
+		for (TFieldIterator<FProperty> PropertyIt(Class); PropertyIt; ++PropertyIt)
+		{
+			Properties->Add({ *PropertyIt, TCHAR_TO_UTF8(*PropertyIt->GetName()) });
+		}
+	}
+	return *Properties;
+}
+
+void FTempoPropertyPathCache::Reset()
+{
+	Paths.Reset();
+	Structs.Reset();
+	ClassProperties.Reset();
+	++Generation;
+}
+
+int32 FTempoPropertyPathCache::NumCachedPaths() const
+{
+	int32 NumPaths = 0;
+	for (const TPair<TObjectKey<UClass>, TMap<FString, FTempoResolvedPropertyPath>>& ClassPaths : Paths)
+	{
+		NumPaths += ClassPaths.Value.Num();
+	}
+	return NumPaths;
+}
+
+void FTempoPropertyPathCache::OnPostGarbageCollect()
+{
+	for (auto It = Paths.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	for (auto It = Structs.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	for (auto It = ClassProperties.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -2,6 +2,8 @@
 
 #include "TempoWorld.h"
 
+#include "TempoPropertyPathCache.h"
+
 #define LOCTEXT_NAMESPACE "FTempoWorldModule"
 
 DEFINE_LOG_CATEGORY(LogTempoWorld);
@@ -18,12 +20,12 @@ FAutoConsoleVariableRef CVarDebugTempoWorld(
 
 void FTempoWorldModule::StartupModule()
 {
-
+	FTempoPropertyPathCache::Startup();
 }
 
 void FTempoWorldModule::ShutdownModule()
 {
-
+	FTempoPropertyPathCache::Shutdown();
 }
 
 #undef LOCTEXT_NAMESPACE
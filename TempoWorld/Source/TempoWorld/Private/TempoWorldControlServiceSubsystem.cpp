@@ -4,8 +4,11 @@
 
 #include "TempoWorld/WorldControl.grpc.pb.h"
 
+#include "TempoActorNameIndex.h"
+#include "TempoActorPool.h"
 #include "TempoConversion.h"
 #include "TempoCoreUtils.h"
+#include "TempoPropertyPathCache.h"
 #include "TempoWorldUtils.h"
 
 #include "EngineUtils.h"
@@ -20,6 +23,13 @@ using SpawnActorResponse = TempoWorld::SpawnActorResponse;
 using FinishSpawningActorRequest = TempoWorld::FinishSpawningActorRequest;
 using FinishSpawningActorResponse = TempoWorld::FinishSpawningActorResponse;
 using DestroyActorRequest = TempoWorld::DestroyActorRequest;
+using SpawnActorsEntry = TempoWorld::SpawnActorsEntry;
+using SpawnActorsRequest = TempoWorld::SpawnActorsRequest;
+using SpawnActorsResult = TempoWorld::SpawnActorsResult;
+using SpawnActorsResponse = TempoWorld::SpawnActorsResponse;
+using DestroyActorsRequest = TempoWorld::DestroyActorsRequest;
+using DestroyActorsFailure = TempoWorld::DestroyActorsFailure;
+using DestroyActorsResponse = TempoWorld::DestroyActorsResponse;
 using AddComponentRequest = TempoWorld::AddComponentRequest;
 using AddComponentResponse = TempoWorld::AddComponentResponse;
 using DestroyComponentRequest = TempoWorld::DestroyComponentRequest;
@@ -76,6 +86,27 @@ using SetPropertyOp = TempoWorld::SetPropertyOp;
 using SetPropertyResult = TempoWorld::SetPropertyResult;
 using SetPropertiesRequest = TempoWorld::SetPropertiesRequest;
 using SetPropertiesResponse = TempoWorld::SetPropertiesResponse;
+using PropertyPath = TempoWorld::PropertyPath;
+using PreparePropertyHandlesRequest = TempoWorld::PreparePropertyHandlesRequest;
+using PreparePropertyHandlesResponse = TempoWorld::PreparePropertyHandlesResponse;
+using SetPropertyByHandleOp = TempoWorld::SetPropertyByHandleOp;
+using SetPropertiesByHandleRequest = TempoWorld::SetPropertiesByHandleRequest;
+using ReleasePropertyHandlesRequest = TempoWorld::ReleasePropertyHandlesRequest;
+using PrepareFunctionRequest = TempoWorld::PrepareFunctionRequest;
+using PrepareFunctionResponse = TempoWorld::PrepareFunctionResponse;
+using FunctionParameter = TempoWorld::FunctionParameter;
+using FunctionTarget = TempoWorld::FunctionTarget;
+using CallFunctionsRequest = TempoWorld::CallFunctionsRequest;
+using CallFunctionsResponse = TempoWorld::CallFunctionsResponse;
+using ReleaseFunctionHandlesRequest = TempoWorld::ReleaseFunctionHandlesRequest;
+using SaveWorldSnapshotRequest = TempoWorld::SaveWorldSnapshotRequest;
+using SaveWorldSnapshotResponse = TempoWorld::SaveWorldSnapshotResponse;
+using RestoreWorldSnapshotRequest = TempoWorld::RestoreWorldSnapshotRequest;
+using RestoreWorldSnapshotResponse = TempoWorld::RestoreWorldSnapshotResponse;
+using DeleteWorldSnapshotRequest = TempoWorld::DeleteWorldSnapshotRequest;
+using ConfigureActorPoolRequest = TempoWorld::ConfigureActorPoolRequest;
+using ActorPoolStats = TempoWorld::ActorPoolStats;
+using GetActorPoolStatsResponse = TempoWorld::GetActorPoolStatsResponse;
 
 FTempoWorldControlServiceActivated UTempoWorldControlServiceSubsystem::TempoWorldControlServiceActivated;
 FTempoWorldControlServiceDeactivated UTempoWorldControlServiceSubsystem::TempoWorldControlServiceDeactivated;
@@ -107,12 +138,34 @@ TempoCore::Transform FromUnrealTransform(const FTransform& Transform)
 	return OutTransform;
 }
 
+namespace
+{
+	// An actor of Class from its actor pool, moved to Transform, or null if Class isn't pooled or the pool is empty.
+	AActor* AcquirePooledActor(UWorld* World, UClass* Class, const FTransform& Transform)
+	{
+		UTempoActorPool* ActorPool = World->GetSubsystem<UTempoActorPool>();
+		return ActorPool ? ActorPool->Acquire(Class, Transform) : nullptr;
+	}
+
+	// Returns Actor to its class's actor pool if it has one with room, and destroys it otherwise.
+	void DestroyOrPoolActor(AActor* Actor)
+	{
+		UTempoActorPool* ActorPool = Actor->GetWorld()->GetSubsystem<UTempoActorPool>();
+		if (!ActorPool || !ActorPool->Release(Actor))
+		{
+			Actor->Destroy();
+		}
+	}
+}
+
 void UTempoWorldControlServiceSubsystem::RegisterServices(FTempoServer& Server)
 {
 	Server.RegisterService<WorldControlService>(
 		SimpleRequestHandler(&WorldControlAsyncService::RequestSpawnActor, &UTempoWorldControlServiceSubsystem::SpawnActor),
 		SimpleRequestHandler(&WorldControlAsyncService::RequestFinishSpawningActor, &UTempoWorldControlServiceSubsystem::FinishSpawningActor),
 		SimpleRequestHandler(&WorldControlAsyncService::RequestDestroyActor, &UTempoWorldControlServiceSubsystem::DestroyActor),
+		SimpleRequestHandler(&WorldControlAsyncService::RequestSpawnActors, &UTempoWorldControlServiceSubsystem::SpawnActors),
+		SimpleRequestHandler(&WorldControlAsyncService::RequestDestroyActors, &UTempoWorldControlServiceSubsystem::DestroyActors),
 		SimpleRequestHandler(&WorldControlAsyncService::RequestAddComponent, &UTempoWorldControlServiceSubsystem::AddComponent),
 		SimpleRequestHandler(&WorldControlAsyncService::RequestDestroyComponent, &UTempoWorldControlServiceSubsystem::DestroyComponent),
 		SimpleRequestHandler(&WorldControlAsyncService::RequestSetActorTransform, &UTempoWorldControlServiceSubsystem::SetActorTransform),
@@ -162,7 +215,18 @@ void UTempoWorldControlServiceSubsystem::RegisterServices(FTempoServer& Server)
 		SimpleRequestHandler(&WorldControlAsyncService::RequestSetActorSetProperty, &UTempoWorldControlServiceSubsystem::SetProperty<SetActorSetPropertyRequest>),
 		SimpleRequestHandler(&WorldControlAsyncService::RequestSetComponentSetProperty, &UTempoWorldControlServiceSubsystem::SetProperty<SetComponentSetPropertyRequest>),
 		SimpleRequestHandler(&WorldControlAsyncService::RequestSetProperties, &UTempoWorldControlServiceSubsystem::SetProperties),
-		SimpleRequestHandler(&WorldControlAsyncService::RequestCallFunction, &UTempoWorldControlServiceSubsystem::CallObjectFunction)
+		SimpleRequestHandler(&WorldControlAsyncService::RequestPreparePropertyHandles, &UTempoWorldControlServiceSubsystem::PreparePropertyHandles),
+		SimpleRequestHandler(&WorldControlAsyncService::RequestSetPropertiesByHandle, &UTempoWorldControlServiceSubsystem::SetPropertiesByHandle),
+		SimpleRequestHandler(&WorldControlAsyncService::RequestReleasePropertyHandles, &UTempoWorldControlServiceSubsystem::ReleasePropertyHandles),
+		SimpleRequestHandler(&WorldControlAsyncService::RequestCallFunction, &UTempoWorldControlServiceSubsystem::CallObjectFunction),
+		SimpleRequestHandler(&WorldControlAsyncService::RequestPrepareFunction, &UTempoWorldControlServiceSubsystem::PrepareFunction),
+		SimpleRequestHandler(&WorldControlAsyncService::RequestCallFunctions, &UTempoWorldControlServiceSubsystem::CallFunctions),
+		SimpleRequestHandler(&WorldControlAsyncService::RequestReleaseFunctionHandles, &UTempoWorldControlServiceSubsystem::ReleaseFunctionHandles),
+		SimpleRequestHandler(&WorldControlAsyncService::RequestSaveWorldSnapshot, &UTempoWorldControlServiceSubsystem::SaveWorldSnapshot),
+		SimpleRequestHandler(&WorldControlAsyncService::RequestRestoreWorldSnapshot, &UTempoWorldControlServiceSubsystem::RestoreWorldSnapshot),
+		SimpleRequestHandler(&WorldControlAsyncService::RequestDeleteWorldSnapshot, &UTempoWorldControlServiceSubsystem::DeleteWorldSnapshot),
+		SimpleRequestHandler(&WorldControlAsyncService::RequestConfigureActorPool, &UTempoWorldControlServiceSubsystem::ConfigureActorPool),
+		SimpleRequestHandler(&WorldControlAsyncService::RequestGetActorPoolStats, &UTempoWorldControlServiceSubsystem::GetActorPoolStats)
 	);
 }
 
@@ -249,11 +313,16 @@ void UTempoWorldControlServiceSubsystem::SpawnActor(const SpawnActorRequest& Req
 		SpawnRotation = SpawnTransform.GetRotation().Rotator();
 	}
 
-	FActorSpawnParameters SpawnParameters;
-	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-	const AActor* SpawnedActor = Request.deferred()
-		? World->SpawnActorDeferred<AActor>(Class, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn)
-		: World->SpawnActor(Class, &SpawnLocation, &SpawnRotation, SpawnParameters);
+	// Deferred spawns must run construction, so they never come from the pool.
+	AActor* SpawnedActor = Request.deferred() ? nullptr : AcquirePooledActor(World, Class, SpawnTransform);
+	if (!SpawnedActor)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		SpawnedActor = Request.deferred()
+			? World->SpawnActorDeferred<AActor>(Class, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn)
+			: World->SpawnActor(Class, &SpawnLocation, &SpawnRotation, SpawnParameters);
+	}
 
 	if (!SpawnedActor)
 	{
@@ -265,6 +334,11 @@ void UTempoWorldControlServiceSubsystem::SpawnActor(const SpawnActorRequest& Req
 	if (Request.deferred())
 	{
 		DeferredSpawnTransforms.Add(SpawnedActor, SpawnTransform);
+		// Unfinished spawns raise no spawn event, so index this one for the FinishSpawningActor lookup.
+		if (UTempoActorNameIndex* ActorNameIndex = World->GetSubsystem<UTempoActorNameIndex>())
+		{
+			ActorNameIndex->AddActor(SpawnedActor);
+		}
 	}
 
 	SpawnActorResponse Response;
@@ -324,7 +398,7 @@ void UTempoWorldControlServiceSubsystem::DestroyActor(const TempoWorld::DestroyA
 		ResponseContinuation.ExecuteIfBound(TempoCore::Empty(), grpc::Status(grpc::NOT_FOUND, std::string(TCHAR_TO_UTF8(*ErrorMsg))));
 		return;
 	}
-	Actor->Destroy();
+	DestroyOrPoolActor(Actor);
 
 	ResponseContinuation.ExecuteIfBound(TempoCore::Empty(), grpc::Status_OK);
 }
@@ -654,24 +728,25 @@ void UTempoWorldControlServiceSubsystem::DeactivateComponent(const DeactivateCom
 	ResponseContinuation.ExecuteIfBound(TempoCore::Empty(), grpc::Status_OK);
 }
 
-template <typename RequestType>
-grpc::Status GetObjectForRequest(const UWorld* World, const RequestType& Request, UObject*& Object)
+namespace
 {
-	const FString ActorName(UTF8_TO_TCHAR(Request.actor().c_str()));
-	const FString ComponentName = FString(UTF8_TO_TCHAR(Request.component().c_str()));
-
-	if (ActorName.IsEmpty())
+	// What a set-property op applies to in place of the names in the op itself. Empty, the op's names are used.
+	struct FSetPropertyTarget
 	{
-		return grpc::Status(grpc::FAILED_PRECONDITION, "actor must be specified");
-	}
+		// The op's actor, already in hand. The op's component, if any, is still found on it by name.
+		AActor* Actor = nullptr;
 
-	AActor* Actor = GetActorWithName(World, ActorName);
-	if (!Actor)
-	{
-		const FString ErrorMsg = FString::Printf(TEXT("Failed to find actor '%s'"), *ActorName);
-		return grpc::Status(grpc::NOT_FOUND, std::string(TCHAR_TO_UTF8(*ErrorMsg)));
-	}
+		// The object and property a handle was prepared for, used in place of all of the op's names.
+		UObject* Object = nullptr;
+		const FString* PropertyName = nullptr;
+		FTempoResolvedPropertyPath Path;
+	};
+}
 
+template <typename RequestType>
+grpc::Status GetObjectOnActorForRequest(AActor* Actor, const FString& ActorName, const RequestType& Request, UObject*& Object)
+{
+	const FString ComponentName(UTF8_TO_TCHAR(Request.component().c_str()));
 	if (ComponentName.IsEmpty())
 	{
 		Object = Actor;
@@ -692,24 +767,53 @@ grpc::Status GetObjectForRequest(const UWorld* World, const RequestType& Request
 	return grpc::Status_OK;
 }
 
-void MarkRenderStateDirty(UObject* Object)
+template <typename RequestType>
+grpc::Status GetObjectForRequest(const UWorld* World, const RequestType& Request, UObject*& Object)
 {
-	if (AActor* Actor = Cast<AActor>(Object))
+	const FString ActorName(UTF8_TO_TCHAR(Request.actor().c_str()));
+	if (ActorName.IsEmpty())
 	{
-		Actor->MarkComponentsRenderStateDirty();
+		return grpc::Status(grpc::FAILED_PRECONDITION, "actor must be specified");
 	}
-	else if (USceneComponent* SceneComponent = Cast<USceneComponent>(Object))
+
+	AActor* Actor = GetActorWithName(World, ActorName);
+	if (!Actor)
 	{
-		SceneComponent->MarkRenderStateDirty();
+		const FString ErrorMsg = FString::Printf(TEXT("Failed to find actor '%s'"), *ActorName);
+		return grpc::Status(grpc::NOT_FOUND, std::string(TCHAR_TO_UTF8(*ErrorMsg)));
+	}
+
+	return GetObjectOnActorForRequest(Actor, ActorName, Request, Object);
+}
+
+template <typename RequestType>
+grpc::Status GetObjectForRequest(const UWorld* World, const FSetPropertyTarget& Target, const RequestType& Request, UObject*& Object)
+{
+	if (Target.Object)
+	{
+		Object = Target.Object;
+		return grpc::Status_OK;
+	}
+
+	if (Target.Actor)
+	{
+		return GetObjectOnActorForRequest(Target.Actor, UTempoCoreUtils::GetActorIdentifier(Target.Actor), Request, Object);
 	}
+
+	return GetObjectForRequest(World, Request, Object);
 }
 
 void UTempoWorldControlServiceSubsystem::GetAllActors(const TempoCore::Empty& Request, const TResponseDelegate<GetAllActorsResponse>& ResponseContinuation) const
 {
 	GetAllActorsResponse Response;
 
+	const UTempoActorPool* ActorPool = GetWorld()->GetSubsystem<UTempoActorPool>();
 	for (const AActor* Actor : TActorRange<AActor>(GetWorld()))
 	{
+		if (ActorPool && ActorPool->IsPooled(Actor))
+		{
+			continue;
+		}
 		TempoWorld::ActorDescriptor* ActorDescriptor = Response.add_actors();
 		ActorDescriptor->set_name(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(Actor)));
 		ActorDescriptor->set_actor_type(TCHAR_TO_UTF8(*Actor->GetClass()->GetName()));
@@ -1040,13 +1144,12 @@ void GetObjectProperties(const UObject* Object, GetPropertiesResponse& Response)
 				{
 					*Value = TEXT("{");
 					void const* InnerPtr = StructProperty->ContainerPtrToValuePtr<void>(Container);
-					for (const FProperty* InnerProperty = StructProperty->Struct->PropertyLink; InnerProperty != nullptr; InnerProperty = InnerProperty->PropertyLinkNext)
+					for (const FTempoStructMember& Member : FTempoPropertyPathCache::Get().GetStructMembers(StructProperty->Struct))
 					{
-						const FString InnerName = InnerProperty->GetAuthoredName();
 						FString InnerType;
 						FString InnerValue;
-						GetPropertyTypeAndValue(InnerPtr, InnerProperty, InnerType, &InnerValue);
-						Value->Appendf(TEXT("%s:%s, "), *InnerName, *InnerValue);
+						GetPropertyTypeAndValue(InnerPtr, Member.Property, InnerType, &InnerValue);
+						Value->Appendf(TEXT("%s:%s, "), *Member.AuthoredName, *InnerValue);
 					}
 					Value->RemoveFromEnd(TEXT(", "));
 					Value->Append(TEXT("}"));
@@ -1146,19 +1249,20 @@ void GetObjectProperties(const UObject* Object, GetPropertiesResponse& Response)
 		}
 	};
 
-	for(TFieldIterator<FProperty> PropertyIt(Class); PropertyIt; ++PropertyIt)
+	const std::string ActorName(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(Actor)));
+	const std::string ComponentName(Component ? TCHAR_TO_UTF8(*Component->GetName()) : "");
+	for (const FTempoClassProperty& ClassProperty : FTempoPropertyPathCache::Get().GetClassProperties(Class))
 	{
-		const FProperty* Property = *PropertyIt;
 		FString Type;
 		FString Value;
-		GetPropertyTypeAndValue(Object, Property, Type, &Value);
+		GetPropertyTypeAndValue(Object, ClassProperty.Property, Type, &Value);
 		TempoWorld::PropertyDescriptor* PropertyDescriptor = Response.add_properties();
-		PropertyDescriptor->set_actor(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(Actor)));
+		PropertyDescriptor->set_actor(ActorName);
 		if (Component)
 		{
-			PropertyDescriptor->set_component(TCHAR_TO_UTF8(*Component->GetName()));
+			PropertyDescriptor->set_component(ComponentName);
 		}
-		PropertyDescriptor->set_name(TCHAR_TO_UTF8(*Property->GetName()));
+		PropertyDescriptor->set_name(ClassProperty.Name);
 		PropertyDescriptor->set_property_type(TCHAR_TO_UTF8(*Type));
 		PropertyDescriptor->set_value(TCHAR_TO_UTF8(*Value));
 	}
@@ -1235,66 +1339,34 @@ void UTempoWorldControlServiceSubsystem::GetComponentProperties(const GetCompone
 	ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
 }
 
-FString SplitPropertyName(FString& PropertyName)
+// Resolves PropertyName on Object, or, if PreparedPath is given, takes that as its resolution.
+grpc::Status ResolveProperty(const UObject* Object, const FString& PropertyName, const FTempoResolvedPropertyPath* PreparedPath, FTempoResolvedPropertyPath& Resolved, FString& InnerPropertyName)
 {
-	// If a ']' appears before any '[', we are inside a bracket scope (e.g. parsing the contents
-	// of MyMap[...]) and only ']' should terminate the segment - '.' inside the brackets is part
-	// of the key (relevant for map keys containing dots, like FString or FName keys).
-	int32 OpenBracketIdx = INDEX_NONE;
-	int32 CloseBracketIdx = INDEX_NONE;
-	PropertyName.FindChar('[', OpenBracketIdx);
-	PropertyName.FindChar(']', CloseBracketIdx);
-	const bool bInBracket = CloseBracketIdx != INDEX_NONE && (OpenBracketIdx == INDEX_NONE || CloseBracketIdx < OpenBracketIdx);
-
-	for (int32 CharIdx = 0; CharIdx < PropertyName.Len(); ++CharIdx)
-	{
-		if (!bInBracket && (PropertyName[CharIdx] == '.' || PropertyName[CharIdx] == '['))
-		{
-			// Chop everything before
-			const FString FirstPropertyName = PropertyName.LeftChop(PropertyName.Len() - CharIdx);
-			// Chop everything after
-			PropertyName.RightChopInline(CharIdx + 1);
-			return FirstPropertyName;
-		}
-		if (PropertyName[CharIdx] == ']')
-		{
-			// Chop everything before
-			const FString FirstPropertyName = PropertyName.LeftChop(PropertyName.Len() - CharIdx);
-			// Chop everything after (also chopping the '.' after the ']', if it's there)
-			PropertyName.RightChopInline(CharIdx + (CharIdx + 1 < PropertyName.Len() && PropertyName[CharIdx + 1] == '.' ? 2 : 1));
-			return FirstPropertyName;
-		}
-	}
-
-	const FString FirstPropertyName = PropertyName;
-	PropertyName.Empty(); // Nothing left
-	return FirstPropertyName;
-}
-
-template <typename RequestType>
-grpc::Status GetPropertyForRequest(const UObject* Object, const RequestType& Request, FProperty*& Property, FString& InnerPropertyName)
-{
-	FString PropertyName(UTF8_TO_TCHAR(Request.property().c_str()));
-
 	if (PropertyName.IsEmpty())
 	{
 		return grpc::Status(grpc::FAILED_PRECONDITION, "property must be specified");
 	}
 
-	const FString FirstPropertyName = SplitPropertyName(PropertyName);
-	InnerPropertyName = PropertyName;
-
 	const UClass* Class = Object->GetClass();
-	Property = Class->FindPropertyByName(FName(FirstPropertyName));
-
-	if (!Property)
+	if (PreparedPath)
 	{
+		Resolved = *PreparedPath;
+	}
+	else if (!FTempoPropertyPathCache::Get().Resolve(Class, PropertyName, Resolved))
+	{
+		FString Unused = PropertyName;
+		const FString FirstPropertyName = FTempoPropertyPathCache::SplitPropertyName(Unused);
 		const FString ErrorMsg = FString::Printf(TEXT("Property '%s' not found on object '%s' (class '%s')"), *FirstPropertyName, *Object->GetName(), *Class->GetName());
 		return grpc::Status(grpc::NOT_FOUND, std::string(TCHAR_TO_UTF8(*ErrorMsg)));
 	}
 
+	InnerPropertyName = PropertyName.RightChop(Resolved.InnerStart);
+
+	const FProperty* Property = Resolved.Property;
 	if (!InnerPropertyName.IsEmpty() && !(CastField<FStructProperty>(Property) || CastField<FArrayProperty>(Property) || CastField<FMapProperty>(Property)))
 	{
+		FString Unused = PropertyName;
+		const FString FirstPropertyName = FTempoPropertyPathCache::SplitPropertyName(Unused);
 		const FString ErrorMsg = FString::Printf(TEXT("Inner property '%s' was specified on property '%s' (type '%s'), but inner properties can only be specified on structs, arrays, and maps."), *InnerPropertyName, *FirstPropertyName, *Property->GetCPPType());
 		return grpc::Status(grpc::FAILED_PRECONDITION, std::string(TCHAR_TO_UTF8(*ErrorMsg)));
 	}
@@ -1302,6 +1374,32 @@ grpc::Status GetPropertyForRequest(const UObject* Object, const RequestType& Req
 	return grpc::Status_OK;
 }
 
+template <typename RequestType>
+grpc::Status ResolvePropertyForRequest(const UObject* Object, const RequestType& Request, FTempoResolvedPropertyPath& Resolved, FString& InnerPropertyName)
+{
+	return ResolveProperty(Object, UTF8_TO_TCHAR(Request.property().c_str()), nullptr, Resolved, InnerPropertyName);
+}
+
+template <typename RequestType>
+grpc::Status ResolvePropertyForRequest(const UObject* Object, const FSetPropertyTarget& Target, const RequestType& Request, FTempoResolvedPropertyPath& Resolved, FString& InnerPropertyName)
+{
+	if (Target.PropertyName)
+	{
+		return ResolveProperty(Object, *Target.PropertyName, &Target.Path, Resolved, InnerPropertyName);
+	}
+
+	return ResolvePropertyForRequest(Object, Request, Resolved, InnerPropertyName);
+}
+
+template <typename RequestType>
+grpc::Status GetPropertyForRequest(const UObject* Object, const FSetPropertyTarget& Target, const RequestType& Request, FProperty*& Property, FString& InnerPropertyName)
+{
+	FTempoResolvedPropertyPath Resolved;
+	const grpc::Status Status = ResolvePropertyForRequest(Object, Target, Request, Resolved, InnerPropertyName);
+	Property = Resolved.Property;
+	return Status;
+}
+
 template <typename PropertyType, typename ValueType>
 grpc::Status SetSinglePropertyValue(void* ValuePtr, PropertyType* Property, const ValueType& Value)
 {
@@ -1449,7 +1547,7 @@ grpc::Status SetSinglePropertyInContainer(void* Container, FProperty* Property,
 	void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Container);
 
 	FString CurrentPropertyName = PropertyName;
-	const FString FirstPropertyName = SplitPropertyName(CurrentPropertyName);
+	const FString FirstPropertyName = FTempoPropertyPathCache::SplitPropertyName(CurrentPropertyName);
 	FString InnerPropertyName = CurrentPropertyName;
 
 	if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
@@ -1460,12 +1558,9 @@ grpc::Status SetSinglePropertyInContainer(void* Container, FProperty* Property,
 			return grpc::Status(grpc::FAILED_PRECONDITION, std::string(TCHAR_TO_UTF8(*ErrorMsg)));
 		}
 
-		for (FProperty* InnerProperty = StructProperty->Struct->PropertyLink; InnerProperty != nullptr; InnerProperty = InnerProperty->PropertyLinkNext)
+		if (FProperty* InnerProperty = FTempoPropertyPathCache::Get().FindStructMember(StructProperty->Struct, FirstPropertyName))
 		{
-			if (InnerProperty->GetAuthoredName() == FirstPropertyName)
-			{
-				return SetSinglePropertyInContainer<PropertyType>(ValuePtr, InnerProperty, InnerPropertyName, Value);
-			}
+			return SetSinglePropertyInContainer<PropertyType>(ValuePtr, InnerProperty, InnerPropertyName, Value);
 		}
 		const FString ErrorMsg = FString::Printf(TEXT("No matching inner property '%s' found on struct property '%s' (type '%s')"), *FirstPropertyName, *Property->GetName(), *StructProperty->Struct->GetStructCPPName());
 		return grpc::Status(grpc::NOT_FOUND, std::string(TCHAR_TO_UTF8(*ErrorMsg)));
@@ -1555,28 +1650,36 @@ grpc::Status SetSinglePropertyInContainer(void* Container, FProperty* Property,
 }
 
 template <typename PropertyType, typename RequestType, typename ValueType>
-grpc::Status SetSinglePropertyImpl(const UWorld* World, const RequestType& Request, const ValueType& Value)
+grpc::Status SetSinglePropertyImpl(const UWorld* World, const FSetPropertyTarget& Target, const RequestType& Request, const ValueType& Value)
 {
 	UObject* Object = nullptr;
-	const grpc::Status GetObjectStatus = GetObjectForRequest(World, Request, Object);
+	const grpc::Status GetObjectStatus = GetObjectForRequest(World, Target, Request, Object);
 	if (!GetObjectStatus.ok())
 	{
 		return GetObjectStatus;
 	}
 
-	const FString PropertyName(UTF8_TO_TCHAR(Request.property().c_str()));
-	if (PropertyName.IsEmpty())
+	if (!Target.PropertyName && Request.property().empty())
 	{
 		return grpc::Status(grpc::FAILED_PRECONDITION, "property must be specified in SetProperty request");
 	}
 
 	FString InnerPropertyName;
-	FProperty* Property = nullptr;
-	const grpc::Status GetPropertyStatus = GetPropertyForRequest(Object, Request, Property, InnerPropertyName);
+	FTempoResolvedPropertyPath Resolved;
+	const grpc::Status GetPropertyStatus = ResolvePropertyForRequest(Object, Target, Request, Resolved, InnerPropertyName);
 	if (!GetPropertyStatus.ok())
 	{
 		return GetPropertyStatus;
 	}
+	FProperty* Property = Resolved.Property;
+
+	// When the path resolved straight to a value we can check its type up front and write it in place.
+	PropertyType* TypedLeaf = Resolved.Leaf ? CastField<PropertyType>(Resolved.Leaf) : nullptr;
+	if (Resolved.Leaf && !TypedLeaf)
+	{
+		const FString ErrorMsg = FString::Printf(TEXT("Property '%s' has type '%s' which does not match the requested type"), *Resolved.Leaf->GetName(), *Resolved.Leaf->GetCPPType());
+		return grpc::Status(grpc::FAILED_PRECONDITION, std::string(TCHAR_TO_UTF8(*ErrorMsg)));
+	}
 
 #if WITH_EDITOR
 	if (World->WorldType == EWorldType::Editor)
@@ -1584,7 +1687,9 @@ grpc::Status SetSinglePropertyImpl(const UWorld* World, const RequestType& Reque
 		Object->PreEditChange(Property);
 	}
 #endif
-	const grpc::Status SetStatus = SetSinglePropertyInContainer<PropertyType>(Object, Property, InnerPropertyName, Value);
+	const grpc::Status SetStatus = TypedLeaf
+		? SetSinglePropertyValue(reinterpret_cast<uint8*>(Object) + Resolved.LeafOffset, TypedLeaf, Value)
+		: SetSinglePropertyInContainer<PropertyType>(Object, Property, InnerPropertyName, Value);
 #if WITH_EDITOR
 	if (World->WorldType == EWorldType::Editor)
 	{
@@ -1603,10 +1708,10 @@ grpc::Status SetSinglePropertyImpl(const UWorld* World, const RequestType& Reque
 }
 
 template <typename PropertyType, typename RequestType, typename ValueType>
-grpc::Status SetArrayPropertyImpl(const UWorld* World, const RequestType& Request, const TArray<ValueType>& Values)
+grpc::Status SetArrayPropertyImpl(const UWorld* World, const FSetPropertyTarget& Target, const RequestType& Request, const TArray<ValueType>& Values)
 {
 	UObject* Object = nullptr;
-	const grpc::Status GetObjectStatus = GetObjectForRequest(World, Request, Object);
+	const grpc::Status GetObjectStatus = GetObjectForRequest(World, Target, Request, Object);
 	if (!GetObjectStatus.ok())
 	{
 		return GetObjectStatus;
@@ -1614,7 +1719,7 @@ grpc::Status SetArrayPropertyImpl(const UWorld* World, const RequestType& Reques
 
 	FString InnerPropertyName;
 	FProperty* Property = nullptr;
-	const grpc::Status GetPropertyStatus = GetPropertyForRequest(Object, Request, Property, InnerPropertyName);
+	const grpc::Status GetPropertyStatus = GetPropertyForRequest(Object, Target, Request, Property, InnerPropertyName);
 	if (!GetPropertyStatus.ok())
 	{
 		return GetPropertyStatus;
@@ -1662,10 +1767,10 @@ grpc::Status SetArrayPropertyImpl(const UWorld* World, const RequestType& Reques
 }
 
 template <typename PropertyType, typename RequestType, typename ValueType>
-grpc::Status SetSetPropertyImpl(const UWorld* World, const RequestType& Request, const TArray<ValueType>& Values)
+grpc::Status SetSetPropertyImpl(const UWorld* World, const FSetPropertyTarget& Target, const RequestType& Request, const TArray<ValueType>& Values)
 {
 	UObject* Object = nullptr;
-	const grpc::Status GetObjectStatus = GetObjectForRequest(World, Request, Object);
+	const grpc::Status GetObjectStatus = GetObjectForRequest(World, Target, Request, Object);
 	if (!GetObjectStatus.ok())
 	{
 		return GetObjectStatus;
@@ -1673,7 +1778,7 @@ grpc::Status SetSetPropertyImpl(const UWorld* World, const RequestType& Request,
 
 	FString InnerPropertyName;
 	FProperty* Property = nullptr;
-	const grpc::Status GetPropertyStatus = GetPropertyForRequest(Object, Request, Property, InnerPropertyName);
+	const grpc::Status GetPropertyStatus = GetPropertyForRequest(Object, Target, Request, Property, InnerPropertyName);
 	if (!GetPropertyStatus.ok())
 	{
 		return GetPropertyStatus;
@@ -1745,10 +1850,10 @@ grpc::Status SetSetPropertyImpl(const UWorld* World, const RequestType& Request,
 }
 
 template<typename RequestType, typename ValueType>
-grpc::Status SetStructPropertyImpl(const UWorld* World, const RequestType& Request, const ValueType& Value, const FString& ExpectedStructCPPName)
+grpc::Status SetStructPropertyImpl(const UWorld* World, const FSetPropertyTarget& Target, const RequestType& Request, const ValueType& Value, const FString& ExpectedStructCPPName)
 {
 	UObject* Object = nullptr;
-	const grpc::Status GetObjectStatus = GetObjectForRequest(World, Request, Object);
+	const grpc::Status GetObjectStatus = GetObjectForRequest(World, Target, Request, Object);
 	if (!GetObjectStatus.ok())
 	{
 		return GetObjectStatus;
@@ -1756,7 +1861,7 @@ grpc::Status SetStructPropertyImpl(const UWorld* World, const RequestType& Reque
 
 	FString InnerPropertyName;
 	FProperty* Property = nullptr;
-	const grpc::Status GetPropertyStatus = GetPropertyForRequest(Object, Request, Property, InnerPropertyName);
+	const grpc::Status GetPropertyStatus = GetPropertyForRequest(Object, Target, Request, Property, InnerPropertyName);
 	if (!GetPropertyStatus.ok())
 	{
 		return GetPropertyStatus;
@@ -1809,31 +1914,31 @@ template <class...>
 struct False : std::bool_constant<false> { };
 
 template <typename RequestType>
-grpc::Status SetPropertyImpl(const UWorld* World, const RequestType& Request)
+grpc::Status SetPropertyImpl(const UWorld* World, const FSetPropertyTarget& Target, const RequestType& Request)
 {
 	static_assert(False<RequestType>{}, "No template specialization for this property type");
 	return grpc::Status(grpc::UNIMPLEMENTED, "");
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetBoolPropertyRequest>(const UWorld* World, const SetBoolPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetBoolPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetBoolPropertyRequest& Request)
 {
-	return SetSinglePropertyImpl<FBoolProperty>(World, Request, Request.value());
+	return SetSinglePropertyImpl<FBoolProperty>(World, Target, Request, Request.value());
 }
 
 // Try a sequence of property types and return the first non-FAILED_PRECONDITION outcome.
 // FAILED_PRECONDITION from SetSinglePropertyImpl signals "type didn't match"; any other status
 // means we found the right type but had an unrelated problem (range, missing inner, etc.).
 template <typename RequestType, typename ValueType>
-grpc::Status TryPropertyTypes(const UWorld*, const RequestType&, const ValueType&)
+grpc::Status TryPropertyTypes(const UWorld*, const FSetPropertyTarget&, const RequestType&, const ValueType&)
 {
 	return grpc::Status(grpc::FAILED_PRECONDITION, "No matching property type");
 }
 
 template <typename FirstPropertyType, typename... RestPropertyTypes, typename RequestType, typename ValueType>
-grpc::Status TryPropertyTypes(const UWorld* World, const RequestType& Request, const ValueType& Value)
+grpc::Status TryPropertyTypes(const UWorld* World, const FSetPropertyTarget& Target, const RequestType& Request, const ValueType& Value)
 {
-	const grpc::Status Status = SetSinglePropertyImpl<FirstPropertyType>(World, Request, Value);
+	const grpc::Status Status = SetSinglePropertyImpl<FirstPropertyType>(World, Target, Request, Value);
 	if (Status.ok() || Status.error_code() != grpc::FAILED_PRECONDITION)
 	{
 		return Status;
@@ -1844,157 +1949,157 @@ grpc::Status TryPropertyTypes(const UWorld* World, const RequestType& Request, c
 	}
 	else
 	{
-		return TryPropertyTypes<RestPropertyTypes...>(World, Request, Value);
+		return TryPropertyTypes<RestPropertyTypes...>(World, Target, Request, Value);
 	}
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetIntPropertyRequest>(const UWorld* World, const SetIntPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetIntPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetIntPropertyRequest& Request)
 {
-	return TryPropertyTypes<FIntProperty, FByteProperty, FInt16Property, FInt8Property, FUInt16Property>(World, Request, Request.value());
+	return TryPropertyTypes<FIntProperty, FByteProperty, FInt16Property, FInt8Property, FUInt16Property>(World, Target, Request, Request.value());
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetInt64PropertyRequest>(const UWorld* World, const SetInt64PropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetInt64PropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetInt64PropertyRequest& Request)
 {
-	return TryPropertyTypes<FInt64Property, FUInt32Property, FUInt64Property>(World, Request, Request.value());
+	return TryPropertyTypes<FInt64Property, FUInt32Property, FUInt64Property>(World, Target, Request, Request.value());
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetFloatPropertyRequest>(const UWorld* World, const SetFloatPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetFloatPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetFloatPropertyRequest& Request)
 {
 	// First try to set it as a double, then fall back on float
-	const grpc::Status FloatStatus = SetSinglePropertyImpl<FDoubleProperty>(World, Request, Request.value());
+	const grpc::Status FloatStatus = SetSinglePropertyImpl<FDoubleProperty>(World, Target, Request, Request.value());
 	// If we got an error other than FAILED_PRECONDITION that means the type was right, but something else was wrong.
 	if (FloatStatus.ok() || FloatStatus.error_code() != grpc::FAILED_PRECONDITION)
 	{
 		return FloatStatus;
 	}
-	return SetSinglePropertyImpl<FFloatProperty>(World, Request, Request.value());
+	return SetSinglePropertyImpl<FFloatProperty>(World, Target, Request, Request.value());
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetStringPropertyRequest>(const UWorld* World, const SetStringPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetStringPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetStringPropertyRequest& Request)
 {
 	// Try FString, then FName, then FText.
 	const FString ValueStr(UTF8_TO_TCHAR(Request.value().c_str()));
-	const grpc::Status StrStatus = SetSinglePropertyImpl<FStrProperty>(World, Request, ValueStr);
+	const grpc::Status StrStatus = SetSinglePropertyImpl<FStrProperty>(World, Target, Request, ValueStr);
 	if (StrStatus.ok() || StrStatus.error_code() != grpc::FAILED_PRECONDITION)
 	{
 		return StrStatus;
 	}
 	const FName ValueName(UTF8_TO_TCHAR(Request.value().c_str()));
-	const grpc::Status NameStatus = SetSinglePropertyImpl<FNameProperty>(World, Request, ValueName);
+	const grpc::Status NameStatus = SetSinglePropertyImpl<FNameProperty>(World, Target, Request, ValueName);
 	if (NameStatus.ok() || NameStatus.error_code() != grpc::FAILED_PRECONDITION)
 	{
 		return NameStatus;
 	}
-	return SetSinglePropertyImpl<FTextProperty>(World, Request, ValueStr);
+	return SetSinglePropertyImpl<FTextProperty>(World, Target, Request, ValueStr);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetEnumPropertyRequest>(const UWorld* World, const SetEnumPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetEnumPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetEnumPropertyRequest& Request)
 {
 	// First try to set it as an FEnumProperty, then fall back on FByteProperty
 	const FString Value(UTF8_TO_TCHAR(Request.value().c_str()));
-	const grpc::Status EnumStatus = SetSinglePropertyImpl<FEnumProperty>(World, Request, Value);
+	const grpc::Status EnumStatus = SetSinglePropertyImpl<FEnumProperty>(World, Target, Request, Value);
 	// If we got an error other than FAILED_PRECONDITION that means the type was right, but something else was wrong.
 	if (EnumStatus.ok() || EnumStatus.error_code() != grpc::FAILED_PRECONDITION)
 	{
 		return EnumStatus;
 	}
-	return SetSinglePropertyImpl<FByteProperty>(World, Request, Value);
+	return SetSinglePropertyImpl<FByteProperty>(World, Target, Request, Value);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetVectorPropertyRequest>(const UWorld* World, const SetVectorPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetVectorPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetVectorPropertyRequest& Request)
 {
 	FVector Vector;
 	Vector.X = Request.x();
 	Vector.Y = Request.y();
 	Vector.Z = Request.z();
 
-	return SetStructPropertyImpl(World, Request, Vector, TEXT("FVector"));
+	return SetStructPropertyImpl(World, Target, Request, Vector, TEXT("FVector"));
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetRotatorPropertyRequest>(const UWorld* World, const SetRotatorPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetRotatorPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetRotatorPropertyRequest& Request)
 {
 	FRotator Rotator;
 	Rotator.Roll = Request.r();
 	Rotator.Pitch = Request.p();
 	Rotator.Yaw = Request.y();
 
-	return SetStructPropertyImpl(World, Request, QuantityConverter<Rad2Deg,R2L>::Convert(Rotator), TEXT("FRotator"));
+	return SetStructPropertyImpl(World, Target, Request, QuantityConverter<Rad2Deg,R2L>::Convert(Rotator), TEXT("FRotator"));
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetColorPropertyRequest>(const UWorld* World, const SetColorPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetColorPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetColorPropertyRequest& Request)
 {
 	FColor Color;
 	Color.R = Request.r();
 	Color.G = Request.g();
 	Color.B = Request.b();
 
-	grpc::Status ColorStatus = SetStructPropertyImpl(World, Request, Color, TEXT("FColor"));
+	grpc::Status ColorStatus = SetStructPropertyImpl(World, Target, Request, Color, TEXT("FColor"));
 	if (ColorStatus.ok())
 	{
 		return ColorStatus;
 	}
 
-	return SetStructPropertyImpl(World, Request, FLinearColor(Color), TEXT("FLinearColor"));
+	return SetStructPropertyImpl(World, Target, Request, FLinearColor(Color), TEXT("FLinearColor"));
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetVector2DPropertyRequest>(const UWorld* World, const SetVector2DPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetVector2DPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetVector2DPropertyRequest& Request)
 {
 	const FVector2D Vector(Request.x(), Request.y());
-	return SetStructPropertyImpl(World, Request, Vector, TEXT("FVector2D"));
+	return SetStructPropertyImpl(World, Target, Request, Vector, TEXT("FVector2D"));
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetIntVectorPropertyRequest>(const UWorld* World, const SetIntVectorPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetIntVectorPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetIntVectorPropertyRequest& Request)
 {
 	const FIntVector Vector(Request.x(), Request.y(), Request.z());
-	return SetStructPropertyImpl(World, Request, Vector, TEXT("FIntVector"));
+	return SetStructPropertyImpl(World, Target, Request, Vector, TEXT("FIntVector"));
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetIntPointPropertyRequest>(const UWorld* World, const SetIntPointPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetIntPointPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetIntPointPropertyRequest& Request)
 {
 	const FIntPoint Point(Request.x(), Request.y());
-	return SetStructPropertyImpl(World, Request, Point, TEXT("FIntPoint"));
+	return SetStructPropertyImpl(World, Target, Request, Point, TEXT("FIntPoint"));
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetQuatPropertyRequest>(const UWorld* World, const SetQuatPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetQuatPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetQuatPropertyRequest& Request)
 {
 	// Convert from right-handed (API convention) to Unreal's left-handed FQuat.
 	const FQuat Quat = QuantityConverter<UC_NONE, R2L>::Convert(FQuat(Request.x(), Request.y(), Request.z(), Request.w()));
-	return SetStructPropertyImpl(World, Request, Quat, TEXT("FQuat"));
+	return SetStructPropertyImpl(World, Target, Request, Quat, TEXT("FQuat"));
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetTransformPropertyRequest>(const UWorld* World, const SetTransformPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetTransformPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetTransformPropertyRequest& Request)
 {
 	// Same conventions as SpawnActor/SetActorTransform: m -> cm for location, rad/right-handed -> deg/left-handed for rotation.
 	const FTransform Transform = ToUnrealTransform(Request.value());
-	return SetStructPropertyImpl(World, Request, Transform, TEXT("FTransform"));
+	return SetStructPropertyImpl(World, Target, Request, Transform, TEXT("FTransform"));
 }
 
 template <typename RequestType>
-grpc::Status SetObjectProperty(const UWorld* World, const RequestType& Request, UObject* Object)
+grpc::Status SetObjectProperty(const UWorld* World, const FSetPropertyTarget& Target, const RequestType& Request, UObject* Object)
 {
 	// FObjectProperty also catches FClassProperty (it derives from FObjectProperty); FSoftObjectProperty
 	// also catches FSoftClassProperty (which derives from FSoftObjectProperty).
-	return TryPropertyTypes<FObjectProperty, FSoftObjectProperty>(World, Request, Object);
+	return TryPropertyTypes<FObjectProperty, FSoftObjectProperty>(World, Target, Request, Object);
 }
 
 template <typename RequestType>
-grpc::Status SetObjectArrayProperty(const UWorld* World, const RequestType& Request, const TArray<UObject*>& Objects)
+grpc::Status SetObjectArrayProperty(const UWorld* World, const FSetPropertyTarget& Target, const RequestType& Request, const TArray<UObject*>& Objects)
 {
 	// First try to set it as an FObjectProperty array, then fall back on an FSoftObjectProperty array.
-	grpc::Status ObjectStatus = SetArrayPropertyImpl<FObjectProperty>(World, Request, Objects);
+	grpc::Status ObjectStatus = SetArrayPropertyImpl<FObjectProperty>(World, Target, Request, Objects);
 
 	// If we got an error other than FAILED_PRECONDITION that means the type was right, but something else was wrong.
 	if (ObjectStatus.ok() || ObjectStatus.error_code() != grpc::FAILED_PRECONDITION)
@@ -2002,29 +2107,29 @@ grpc::Status SetObjectArrayProperty(const UWorld* World, const RequestType& Requ
 		return ObjectStatus;
 	}
 
-	return SetArrayPropertyImpl<FSoftObjectProperty>(World, Request, Objects);
+	return SetArrayPropertyImpl<FSoftObjectProperty>(World, Target, Request, Objects);
 }
 
 template <typename RequestType>
-grpc::Status SetObjectSetProperty(const UWorld* World, const RequestType& Request, const TArray<UObject*>& Objects)
+grpc::Status SetObjectSetProperty(const UWorld* World, const FSetPropertyTarget& Target, const RequestType& Request, const TArray<UObject*>& Objects)
 {
 	// First try to set it as an FObjectProperty set, then fall back on an FSoftObjectProperty set.
-	grpc::Status ObjectStatus = SetSetPropertyImpl<FObjectProperty>(World, Request, Objects);
+	grpc::Status ObjectStatus = SetSetPropertyImpl<FObjectProperty>(World, Target, Request, Objects);
 	if (ObjectStatus.ok() || ObjectStatus.error_code() != grpc::FAILED_PRECONDITION)
 	{
 		return ObjectStatus;
 	}
-	return SetSetPropertyImpl<FSoftObjectProperty>(World, Request, Objects);
+	return SetSetPropertyImpl<FSoftObjectProperty>(World, Target, Request, Objects);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetClassPropertyRequest>(const UWorld* World, const SetClassPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetClassPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetClassPropertyRequest& Request)
 {
 	const FString ClassName(UTF8_TO_TCHAR(Request.value().c_str()));
 
 	if (ClassName.IsEmpty())
 	{
-		return SetSinglePropertyImpl<FObjectProperty>(World, Request, nullptr);
+		return SetSinglePropertyImpl<FObjectProperty>(World, Target, Request, nullptr);
 	}
 
 	UClass* Class = GetSubClassWithName<UObject>(ClassName);
@@ -2032,17 +2137,17 @@ grpc::Status SetPropertyImpl<SetClassPropertyRequest>(const UWorld* World, const
 	{
 		return grpc::Status(grpc::NOT_FOUND, "Did not find class with name " + std::string(TCHAR_TO_UTF8(*ClassName)));
 	}
-	return SetObjectProperty(World, Request, Class);
+	return SetObjectProperty(World, Target, Request, Class);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetAssetPropertyRequest>(const UWorld* World, const SetAssetPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetAssetPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetAssetPropertyRequest& Request)
 {
 	const FString AssetPath(UTF8_TO_TCHAR(Request.value().c_str()));
 
 	if (AssetPath.IsEmpty())
 	{
-		return SetSinglePropertyImpl<FObjectProperty>(World, Request, nullptr);
+		return SetSinglePropertyImpl<FObjectProperty>(World, Target, Request, nullptr);
 	}
 
 	UObject* Asset = GetAssetByPath(AssetPath);
@@ -2050,17 +2155,17 @@ grpc::Status SetPropertyImpl<SetAssetPropertyRequest>(const UWorld* World, const
 	{
 		return grpc::Status(grpc::NOT_FOUND, "Did not find asset with path " + std::string(TCHAR_TO_UTF8(*AssetPath)));
 	}
-	return SetSinglePropertyImpl<FObjectProperty>(World, Request, Asset);
+	return SetSinglePropertyImpl<FObjectProperty>(World, Target, Request, Asset);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetActorPropertyRequest>(const UWorld* World, const SetActorPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetActorPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetActorPropertyRequest& Request)
 {
 	const FString ActorName(UTF8_TO_TCHAR(Request.value().c_str()));
 
 	if (ActorName.IsEmpty())
 	{
-		return SetSinglePropertyImpl<FObjectProperty>(World, Request, nullptr);
+		return SetSinglePropertyImpl<FObjectProperty>(World, Target, Request, nullptr);
 	}
 
 	AActor* Actor = GetActorWithName(World, ActorName);
@@ -2068,17 +2173,17 @@ grpc::Status SetPropertyImpl<SetActorPropertyRequest>(const UWorld* World, const
 	{
 		return grpc::Status(grpc::NOT_FOUND, "Did not find actor with name " + std::string(TCHAR_TO_UTF8(*ActorName)));
 	}
-	return SetObjectProperty(World, Request, Actor);
+	return SetObjectProperty(World, Target, Request, Actor);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetComponentPropertyRequest>(const UWorld* World, const SetComponentPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetComponentPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetComponentPropertyRequest& Request)
 {
 	const FString FullName(UTF8_TO_TCHAR(Request.value().c_str()));
 
 	if (FullName.IsEmpty())
 	{
-		return SetSinglePropertyImpl<FObjectProperty>(World, Request, nullptr);
+		return SetSinglePropertyImpl<FObjectProperty>(World, Target, Request, nullptr);
 	}
 
 	FString ActorName;
@@ -2101,19 +2206,19 @@ grpc::Status SetPropertyImpl<SetComponentPropertyRequest>(const UWorld* World, c
 		const FString ErrorMsg = FString::Printf(TEXT("Failed to find component '%s' on actor '%s' for component property value '%s'"), *ComponentName, *ActorName, *FullName);
 		return grpc::Status(grpc::NOT_FOUND, std::string(TCHAR_TO_UTF8(*ErrorMsg)));
 	}
-	return SetObjectProperty(World, Request, Component);
+	return SetObjectProperty(World, Target, Request, Component);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetBoolArrayPropertyRequest>(const UWorld* World, const SetBoolArrayPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetBoolArrayPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetBoolArrayPropertyRequest& Request)
 {
 	TArray<bool> Array;
 	Array.Append(Request.values().data(), Request.values_size());
-	return SetArrayPropertyImpl<FBoolProperty>(World, Request, Array);
+	return SetArrayPropertyImpl<FBoolProperty>(World, Target, Request, Array);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetStringArrayPropertyRequest>(const UWorld* World, const SetStringArrayPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetStringArrayPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetStringArrayPropertyRequest& Request)
 {
 	// First try to set it as an FString array, then fall back on FName array
 	TArray<FString> StrArray;
@@ -2122,7 +2227,7 @@ grpc::Status SetPropertyImpl<SetStringArrayPropertyRequest>(const UWorld* World,
 	{
 		StrArray.Add(UTF8_TO_TCHAR(String.c_str()));
 	}
-	grpc::Status StatusStr = SetArrayPropertyImpl<FStrProperty>(World, Request, StrArray);
+	grpc::Status StatusStr = SetArrayPropertyImpl<FStrProperty>(World, Target, Request, StrArray);
 	// If we got an error other than FAILED_PRECONDITION that means the type was right, but something else was wrong.
 	if (StatusStr.ok() || StatusStr.error_code() != grpc::FAILED_PRECONDITION)
 	{
@@ -2134,11 +2239,11 @@ grpc::Status SetPropertyImpl<SetStringArrayPropertyRequest>(const UWorld* World,
 	{
 		NameArray.Add(UTF8_TO_TCHAR(String.c_str()));
 	}
-	return SetArrayPropertyImpl<FNameProperty>(World, Request, NameArray);
+	return SetArrayPropertyImpl<FNameProperty>(World, Target, Request, NameArray);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetEnumArrayPropertyRequest>(const UWorld* World, const SetEnumArrayPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetEnumArrayPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetEnumArrayPropertyRequest& Request)
 {
 	// First try to set it as an FEnumProperty array, then fall back on FByteProperty array
 	TArray<FString> StrArray;
@@ -2147,25 +2252,25 @@ grpc::Status SetPropertyImpl<SetEnumArrayPropertyRequest>(const UWorld* World, c
 	{
 		StrArray.Add(UTF8_TO_TCHAR(String.c_str()));
 	}
-	grpc::Status EnumStatus = SetArrayPropertyImpl<FEnumProperty>(World, Request, StrArray);
+	grpc::Status EnumStatus = SetArrayPropertyImpl<FEnumProperty>(World, Target, Request, StrArray);
 	// If we got an error other than FAILED_PRECONDITION that means the type was right, but something else was wrong.
 	if (EnumStatus.ok() || EnumStatus.error_code() != grpc::FAILED_PRECONDITION)
 	{
 		return EnumStatus;
 	}
-	return SetArrayPropertyImpl<FByteProperty>(World, Request, StrArray);
+	return SetArrayPropertyImpl<FByteProperty>(World, Target, Request, StrArray);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetIntArrayPropertyRequest>(const UWorld* World, const SetIntArrayPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetIntArrayPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetIntArrayPropertyRequest& Request)
 {
 	TArray<int32> Array;
 	Array.Append(Request.values().data(), Request.values_size());
-	return SetArrayPropertyImpl<FIntProperty>(World, Request, Array);
+	return SetArrayPropertyImpl<FIntProperty>(World, Target, Request, Array);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetInt64ArrayPropertyRequest>(const UWorld* World, const SetInt64ArrayPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetInt64ArrayPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetInt64ArrayPropertyRequest& Request)
 {
 	// Protobuf's int64 is `long` on Linux but Unreal's int64 is `long long`; same width, different
 	// C++ types, so the pointer overload of TArray::Append can't match. Copy element-by-element instead.
@@ -2175,26 +2280,26 @@ grpc::Status SetPropertyImpl<SetInt64ArrayPropertyRequest>(const UWorld* World,
 	{
 		Array.Add(V);
 	}
-	return SetArrayPropertyImpl<FInt64Property>(World, Request, Array);
+	return SetArrayPropertyImpl<FInt64Property>(World, Target, Request, Array);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetFloatArrayPropertyRequest>(const UWorld* World, const SetFloatArrayPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetFloatArrayPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetFloatArrayPropertyRequest& Request)
 {
 	// First try to set it as a double array, then fall back on float array
 	TArray<float> FloatArray;
 	FloatArray.Append(Request.values().data(), Request.values_size());
-	grpc::Status StatusFloat = SetArrayPropertyImpl<FDoubleProperty>(World, Request, FloatArray);
+	grpc::Status StatusFloat = SetArrayPropertyImpl<FDoubleProperty>(World, Target, Request, FloatArray);
 	// If we got an error other than FAILED_PRECONDITION that means the type was right, but something else was wrong.
 	if (StatusFloat.ok() || StatusFloat.error_code() != grpc::FAILED_PRECONDITION)
 	{
 		return StatusFloat;
 	}
-	return SetArrayPropertyImpl<FFloatProperty>(World, Request, FloatArray);
+	return SetArrayPropertyImpl<FFloatProperty>(World, Target, Request, FloatArray);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetClassArrayPropertyRequest>(const UWorld* World, const SetClassArrayPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetClassArrayPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetClassArrayPropertyRequest& Request)
 {
 	TArray<UObject*> ClassArray;
 	for (const std::string& Value : Request.values())
@@ -2207,11 +2312,11 @@ grpc::Status SetPropertyImpl<SetClassArrayPropertyRequest>(const UWorld* World,
 		}
 		ClassArray.Add(Class);
 	}
-	return SetObjectArrayProperty(World, Request, ClassArray);
+	return SetObjectArrayProperty(World, Target, Request, ClassArray);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetAssetArrayPropertyRequest>(const UWorld* World, const SetAssetArrayPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetAssetArrayPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetAssetArrayPropertyRequest& Request)
 {
 	TArray<UObject*> AssetArray;
 	for (const std::string& Value : Request.values())
@@ -2224,11 +2329,11 @@ grpc::Status SetPropertyImpl<SetAssetArrayPropertyRequest>(const UWorld* World,
 		}
 		AssetArray.Add(Asset);
 	}
-	return SetArrayPropertyImpl<FObjectProperty>(World, Request, AssetArray);
+	return SetArrayPropertyImpl<FObjectProperty>(World, Target, Request, AssetArray);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetActorArrayPropertyRequest>(const UWorld* World, const SetActorArrayPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetActorArrayPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetActorArrayPropertyRequest& Request)
 {
 	TArray<UObject*> ActorArray;
 	for (const std::string& Value : Request.values())
@@ -2241,11 +2346,11 @@ grpc::Status SetPropertyImpl<SetActorArrayPropertyRequest>(const UWorld* World,
 		}
 		ActorArray.Add(Actor);
 	}
-	return SetObjectArrayProperty(World, Request, ActorArray);
+	return SetObjectArrayProperty(World, Target, Request, ActorArray);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetComponentArrayPropertyRequest>(const UWorld* World, const SetComponentArrayPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetComponentArrayPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetComponentArrayPropertyRequest& Request)
 {
 	TArray<UObject*> ComponentArray;
 	for (const std::string& Value : Request.values())
@@ -2273,19 +2378,19 @@ grpc::Status SetPropertyImpl<SetComponentArrayPropertyRequest>(const UWorld* Wor
 		}
 		ComponentArray.Add(Component);
 	}
-	return SetObjectArrayProperty(World, Request, ComponentArray);
+	return SetObjectArrayProperty(World, Target, Request, ComponentArray);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetBoolSetPropertyRequest>(const UWorld* World, const SetBoolSetPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetBoolSetPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetBoolSetPropertyRequest& Request)
 {
 	TArray<bool> Array;
 	Array.Append(Request.values().data(), Request.values_size());
-	return SetSetPropertyImpl<FBoolProperty>(World, Request, Array);
+	return SetSetPropertyImpl<FBoolProperty>(World, Target, Request, Array);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetStringSetPropertyRequest>(const UWorld* World, const SetStringSetPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetStringSetPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetStringSetPropertyRequest& Request)
 {
 	TArray<FString> StrArray;
 	StrArray.Reserve(Request.values_size());
@@ -2293,7 +2398,7 @@ grpc::Status SetPropertyImpl<SetStringSetPropertyRequest>(const UWorld* World, c
 	{
 		StrArray.Add(UTF8_TO_TCHAR(String.c_str()));
 	}
-	const grpc::Status StatusStr = SetSetPropertyImpl<FStrProperty>(World, Request, StrArray);
+	const grpc::Status StatusStr = SetSetPropertyImpl<FStrProperty>(World, Target, Request, StrArray);
 	if (StatusStr.ok() || StatusStr.error_code() != grpc::FAILED_PRECONDITION)
 	{
 		return StatusStr;
@@ -2304,11 +2409,11 @@ grpc::Status SetPropertyImpl<SetStringSetPropertyRequest>(const UWorld* World, c
 	{
 		NameArray.Add(UTF8_TO_TCHAR(String.c_str()));
 	}
-	return SetSetPropertyImpl<FNameProperty>(World, Request, NameArray);
+	return SetSetPropertyImpl<FNameProperty>(World, Target, Request, NameArray);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetEnumSetPropertyRequest>(const UWorld* World, const SetEnumSetPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetEnumSetPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetEnumSetPropertyRequest& Request)
 {
 	TArray<FString> StrArray;
 	StrArray.Reserve(Request.values_size());
@@ -2316,24 +2421,24 @@ grpc::Status SetPropertyImpl<SetEnumSetPropertyRequest>(const UWorld* World, con
 	{
 		StrArray.Add(UTF8_TO_TCHAR(String.c_str()));
 	}
-	const grpc::Status EnumStatus = SetSetPropertyImpl<FEnumProperty>(World, Request, StrArray);
+	const grpc::Status EnumStatus = SetSetPropertyImpl<FEnumProperty>(World, Target, Request, StrArray);
 	if (EnumStatus.ok() || EnumStatus.error_code() != grpc::FAILED_PRECONDITION)
 	{
 		return EnumStatus;
 	}
-	return SetSetPropertyImpl<FByteProperty>(World, Request, StrArray);
+	return SetSetPropertyImpl<FByteProperty>(World, Target, Request, StrArray);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetIntSetPropertyRequest>(const UWorld* World, const SetIntSetPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetIntSetPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetIntSetPropertyRequest& Request)
 {
 	TArray<int32> Array;
 	Array.Append(Request.values().data(), Request.values_size());
-	return SetSetPropertyImpl<FIntProperty>(World, Request, Array);
+	return SetSetPropertyImpl<FIntProperty>(World, Target, Request, Array);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetInt64SetPropertyRequest>(const UWorld* World, const SetInt64SetPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetInt64SetPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetInt64SetPropertyRequest& Request)
 {
 	// Protobuf's int64 is `long` on Linux but Unreal's int64 is `long long`; same width, different
 	// C++ types, so the pointer overload of TArray::Append can't match. Copy element-by-element instead.
@@ -2343,24 +2448,24 @@ grpc::Status SetPropertyImpl<SetInt64SetPropertyRequest>(const UWorld* World, co
 	{
 		Array.Add(V);
 	}
-	return SetSetPropertyImpl<FInt64Property>(World, Request, Array);
+	return SetSetPropertyImpl<FInt64Property>(World, Target, Request, Array);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetFloatSetPropertyRequest>(const UWorld* World, const SetFloatSetPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetFloatSetPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetFloatSetPropertyRequest& Request)
 {
 	TArray<float> FloatArray;
 	FloatArray.Append(Request.values().data(), Request.values_size());
-	const grpc::Status StatusFloat = SetSetPropertyImpl<FDoubleProperty>(World, Request, FloatArray);
+	const grpc::Status StatusFloat = SetSetPropertyImpl<FDoubleProperty>(World, Target, Request, FloatArray);
 	if (StatusFloat.ok() || StatusFloat.error_code() != grpc::FAILED_PRECONDITION)
 	{
 		return StatusFloat;
 	}
-	return SetSetPropertyImpl<FFloatProperty>(World, Request, FloatArray);
+	return SetSetPropertyImpl<FFloatProperty>(World, Target, Request, FloatArray);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetClassSetPropertyRequest>(const UWorld* World, const SetClassSetPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetClassSetPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetClassSetPropertyRequest& Request)
 {
 	TArray<UObject*> ClassArray;
 	for (const std::string& Value : Request.values())
@@ -2373,11 +2478,11 @@ grpc::Status SetPropertyImpl<SetClassSetPropertyRequest>(const UWorld* World, co
 		}
 		ClassArray.Add(Class);
 	}
-	return SetObjectSetProperty(World, Request, ClassArray);
+	return SetObjectSetProperty(World, Target, Request, ClassArray);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetAssetSetPropertyRequest>(const UWorld* World, const SetAssetSetPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetAssetSetPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetAssetSetPropertyRequest& Request)
 {
 	TArray<UObject*> AssetArray;
 	for (const std::string& Value : Request.values())
@@ -2390,11 +2495,11 @@ grpc::Status SetPropertyImpl<SetAssetSetPropertyRequest>(const UWorld* World, co
 		}
 		AssetArray.Add(Asset);
 	}
-	return SetObjectSetProperty(World, Request, AssetArray);
+	return SetObjectSetProperty(World, Target, Request, AssetArray);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetActorSetPropertyRequest>(const UWorld* World, const SetActorSetPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetActorSetPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetActorSetPropertyRequest& Request)
 {
 	TArray<UObject*> ActorArray;
 	for (const std::string& Value : Request.values())
@@ -2407,11 +2512,11 @@ grpc::Status SetPropertyImpl<SetActorSetPropertyRequest>(const UWorld* World, co
 		}
 		ActorArray.Add(Actor);
 	}
-	return SetObjectSetProperty(World, Request, ActorArray);
+	return SetObjectSetProperty(World, Target, Request, ActorArray);
 }
 
 template<>
-grpc::Status SetPropertyImpl<SetComponentSetPropertyRequest>(const UWorld* World, const SetComponentSetPropertyRequest& Request)
+grpc::Status SetPropertyImpl<SetComponentSetPropertyRequest>(const UWorld* World, const FSetPropertyTarget& Target, const SetComponentSetPropertyRequest& Request)
 {
 	TArray<UObject*> ComponentArray;
 	for (const std::string& Value : Request.values())
@@ -2439,61 +2544,61 @@ grpc::Status SetPropertyImpl<SetComponentSetPropertyRequest>(const UWorld* World
 		}
 		ComponentArray.Add(Component);
 	}
-	return SetObjectSetProperty(World, Request, ComponentArray);
+	return SetObjectSetProperty(World, Target, Request, ComponentArray);
 }
 
 template <typename RequestType>
 void UTempoWorldControlServiceSubsystem::SetProperty(const RequestType& Request, const TResponseDelegate<TempoCore::Empty>& ResponseContinuation) const
 {
-	ResponseContinuation.ExecuteIfBound(TempoCore::Empty(), SetPropertyImpl(GetWorld(), Request));
+	ResponseContinuation.ExecuteIfBound(TempoCore::Empty(), SetPropertyImpl(GetWorld(), FSetPropertyTarget(), Request));
 }
 
 namespace
 {
 	// Run one element of a SetProperties batch by dispatching on the oneof tag.
 	// Returns the per-op grpc::Status; the caller decides whether to surface it.
-	grpc::Status DispatchSetPropertyOp(const UWorld* World, const SetPropertyOp& Op)
+	grpc::Status DispatchSetPropertyOp(const UWorld* World, const SetPropertyOp& Op, const FSetPropertyTarget& Target = FSetPropertyTarget())
 	{
 		switch (Op.op_case())
 		{
-		case SetPropertyOp::kBoolOp:            return SetPropertyImpl(World, Op.bool_op());
-		case SetPropertyOp::kIntOp:             return SetPropertyImpl(World, Op.int_op());
-		case SetPropertyOp::kInt64Op:           return SetPropertyImpl(World, Op.int64_op());
-		case SetPropertyOp::kFloatOp:           return SetPropertyImpl(World, Op.float_op());
-		case SetPropertyOp::kStringOp:          return SetPropertyImpl(World, Op.string_op());
-		case SetPropertyOp::kEnumOp:            return SetPropertyImpl(World, Op.enum_op());
-		case SetPropertyOp::kVectorOp:          return SetPropertyImpl(World, Op.vector_op());
-		case SetPropertyOp::kVector2DOp:        return SetPropertyImpl(World, Op.vector2d_op());
-		case SetPropertyOp::kIntVectorOp:       return SetPropertyImpl(World, Op.int_vector_op());
-		case SetPropertyOp::kIntPointOp:        return SetPropertyImpl(World, Op.int_point_op());
-		case SetPropertyOp::kRotatorOp:         return SetPropertyImpl(World, Op.rotator_op());
-		case SetPropertyOp::kQuatOp:            return SetPropertyImpl(World, Op.quat_op());
-		case SetPropertyOp::kTransformOp:       return SetPropertyImpl(World, Op.transform_op());
-		case SetPropertyOp::kColorOp:           return SetPropertyImpl(World, Op.color_op());
-		case SetPropertyOp::kClassOp:           return SetPropertyImpl(World, Op.class_op());
-		case SetPropertyOp::kAssetOp:           return SetPropertyImpl(World, Op.asset_op());
-		case SetPropertyOp::kActorOp:           return SetPropertyImpl(World, Op.actor_op());
-		case SetPropertyOp::kComponentOp:       return SetPropertyImpl(World, Op.component_op());
-		case SetPropertyOp::kBoolArrayOp:       return SetPropertyImpl(World, Op.bool_array_op());
-		case SetPropertyOp::kStringArrayOp:     return SetPropertyImpl(World, Op.string_array_op());
-		case SetPropertyOp::kEnumArrayOp:       return SetPropertyImpl(World, Op.enum_array_op());
-		case SetPropertyOp::kIntArrayOp:        return SetPropertyImpl(World, Op.int_array_op());
-		case SetPropertyOp::kInt64ArrayOp:      return SetPropertyImpl(World, Op.int64_array_op());
-		case SetPropertyOp::kFloatArrayOp:      return SetPropertyImpl(World, Op.float_array_op());
-		case SetPropertyOp::kClassArrayOp:      return SetPropertyImpl(World, Op.class_array_op());
-		case SetPropertyOp::kAssetArrayOp:      return SetPropertyImpl(World, Op.asset_array_op());
-		case SetPropertyOp::kActorArrayOp:      return SetPropertyImpl(World, Op.actor_array_op());
-		case SetPropertyOp::kComponentArrayOp:  return SetPropertyImpl(World, Op.component_array_op());
-		case SetPropertyOp::kBoolSetOp:         return SetPropertyImpl(World, Op.bool_set_op());
-		case SetPropertyOp::kStringSetOp:       return SetPropertyImpl(World, Op.string_set_op());
-		case SetPropertyOp::kEnumSetOp:         return SetPropertyImpl(World, Op.enum_set_op());
-		case SetPropertyOp::kIntSetOp:          return SetPropertyImpl(World, Op.int_set_op());
-		case SetPropertyOp::kInt64SetOp:        return SetPropertyImpl(World, Op.int64_set_op());
-		case SetPropertyOp::kFloatSetOp:        return SetPropertyImpl(World, Op.float_set_op());
-		case SetPropertyOp::kClassSetOp:        return SetPropertyImpl(World, Op.class_set_op());
-		case SetPropertyOp::kAssetSetOp:        return SetPropertyImpl(World, Op.asset_set_op());
-		case SetPropertyOp::kActorSetOp:        return SetPropertyImpl(World, Op.actor_set_op());
-		case SetPropertyOp::kComponentSetOp:    return SetPropertyImpl(World, Op.component_set_op());
+		case SetPropertyOp::kBoolOp:            return SetPropertyImpl(World, Target, Op.bool_op());
+		case SetPropertyOp::kIntOp:             return SetPropertyImpl(World, Target, Op.int_op());
+		case SetPropertyOp::kInt64Op:           return SetPropertyImpl(World, Target, Op.int64_op());
+		case SetPropertyOp::kFloatOp:           return SetPropertyImpl(World, Target, Op.float_op());
+		case SetPropertyOp::kStringOp:          return SetPropertyImpl(World, Target, Op.string_op());
+		case SetPropertyOp::kEnumOp:            return SetPropertyImpl(World, Target, Op.enum_op());
+		case SetPropertyOp::kVectorOp:          return SetPropertyImpl(World, Target, Op.vector_op());
+		case SetPropertyOp::kVector2DOp:        return SetPropertyImpl(World, Target, Op.vector2d_op());
+		case SetPropertyOp::kIntVectorOp:       return SetPropertyImpl(World, Target, Op.int_vector_op());
+		case SetPropertyOp::kIntPointOp:        return SetPropertyImpl(World, Target, Op.int_point_op());
+		case SetPropertyOp::kRotatorOp:         return SetPropertyImpl(World, Target, Op.rotator_op());
+		case SetPropertyOp::kQuatOp:            return SetPropertyImpl(World, Target, Op.quat_op());
+		case SetPropertyOp::kTransformOp:       return SetPropertyImpl(World, Target, Op.transform_op());
+		case SetPropertyOp::kColorOp:           return SetPropertyImpl(World, Target, Op.color_op());
+		case SetPropertyOp::kClassOp:           return SetPropertyImpl(World, Target, Op.class_op());
+		case SetPropertyOp::kAssetOp:           return SetPropertyImpl(World, Target, Op.asset_op());
+		case SetPropertyOp::kActorOp:           return SetPropertyImpl(World, Target, Op.actor_op());
+		case SetPropertyOp::kComponentOp:       return SetPropertyImpl(World, Target, Op.component_op());
+		case SetPropertyOp::kBoolArrayOp:       return SetPropertyImpl(World, Target, Op.bool_array_op());
+		case SetPropertyOp::kStringArrayOp:     return SetPropertyImpl(World, Target, Op.string_array_op());
+		case SetPropertyOp::kEnumArrayOp:       return SetPropertyImpl(World, Target, Op.enum_array_op());
+		case SetPropertyOp::kIntArrayOp:        return SetPropertyImpl(World, Target, Op.int_array_op());
+		case SetPropertyOp::kInt64ArrayOp:      return SetPropertyImpl(World, Target, Op.int64_array_op());
+		case SetPropertyOp::kFloatArrayOp:      return SetPropertyImpl(World, Target, Op.float_array_op());
+		case SetPropertyOp::kClassArrayOp:      return SetPropertyImpl(World, Target, Op.class_array_op());
+		case SetPropertyOp::kAssetArrayOp:      return SetPropertyImpl(World, Target, Op.asset_array_op());
+		case SetPropertyOp::kActorArrayOp:      return SetPropertyImpl(World, Target, Op.actor_array_op());
+		case SetPropertyOp::kComponentArrayOp:  return SetPropertyImpl(World, Target, Op.component_array_op());
+		case SetPropertyOp::kBoolSetOp:         return SetPropertyImpl(World, Target, Op.bool_set_op());
+		case SetPropertyOp::kStringSetOp:       return SetPropertyImpl(World, Target, Op.string_set_op());
+		case SetPropertyOp::kEnumSetOp:         return SetPropertyImpl(World, Target, Op.enum_set_op());
+		case SetPropertyOp::kIntSetOp:          return SetPropertyImpl(World, Target, Op.int_set_op());
+		case SetPropertyOp::kInt64SetOp:        return SetPropertyImpl(World, Target, Op.int64_set_op());
+		case SetPropertyOp::kFloatSetOp:        return SetPropertyImpl(World, Target, Op.float_set_op());
+		case SetPropertyOp::kClassSetOp:        return SetPropertyImpl(World, Target, Op.class_set_op());
+		case SetPropertyOp::kAssetSetOp:        return SetPropertyImpl(World, Target, Op.asset_set_op());
+		case SetPropertyOp::kActorSetOp:        return SetPropertyImpl(World, Target, Op.actor_set_op());
+		case SetPropertyOp::kComponentSetOp:    return SetPropertyImpl(World, Target, Op.component_set_op());
 		case SetPropertyOp::OP_NOT_SET:
 		default:
 			return grpc::Status(grpc::FAILED_PRECONDITION, "SetPropertyOp has no op set");
@@ -2519,6 +2624,263 @@ void UTempoWorldControlServiceSubsystem::SetProperties(const SetPropertiesReques
 	ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
 }
 
+void UTempoWorldControlServiceSubsystem::PreparePropertyHandles(const PreparePropertyHandlesRequest& Request, const TResponseDelegate<PreparePropertyHandlesResponse>& ResponseContinuation)
+{
+	const UWorld* World = GetWorld();
+	PreparePropertyHandlesResponse Response;
+	for (int32 I = 0; I < Request.properties_size(); ++I)
+	{
+		const PropertyPath& Path = Request.properties(I);
+
+		UObject* Object = nullptr;
+		FTempoResolvedPropertyPath Resolved;
+		FString InnerPropertyName;
+		grpc::Status Status = GetObjectForRequest(World, Path, Object);
+		if (Status.ok())
+		{
+			Status = ResolvePropertyForRequest(Object, Path, Resolved, InnerPropertyName);
+		}
+
+		if (!Status.ok())
+		{
+			Response.add_handles(0);
+			SetPropertyResult* Failure = Response.add_failures();
+			Failure->set_op_index(static_cast<uint32>(I));
+			Failure->set_code(static_cast<int32>(Status.error_code()));
+			Failure->set_error(Status.error_message());
+			continue;
+		}
+
+		const uint64 Handle = NextPropertyHandle++;
+		FPreparedProperty& Prepared = PreparedProperties.Add(Handle);
+		Prepared.Object = Object;
+		Prepared.PropertyName = UTF8_TO_TCHAR(Path.property().c_str());
+		Prepared.Path = Resolved;
+		Prepared.CacheGeneration = FTempoPropertyPathCache::Get().GetGeneration();
+		Response.add_handles(Handle);
+	}
+
+	ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
+}
+
+void UTempoWorldControlServiceSubsystem::SetPropertiesByHandle(const SetPropertiesByHandleRequest& Request, const TResponseDelegate<SetPropertiesResponse>& ResponseContinuation)
+{
+	const UWorld* World = GetWorld();
+	FTempoPropertyPathCache& PropertyPathCache = FTempoPropertyPathCache::Get();
+	SetPropertiesResponse Response;
+	for (int32 I = 0; I < Request.ops_size(); ++I)
+	{
+		const SetPropertyByHandleOp& Op = Request.ops(I);
+
+		grpc::Status Status = grpc::Status_OK;
+		FPreparedProperty* Prepared = PreparedProperties.Find(Op.handle());
+		UObject* Object = Prepared ? Prepared->Object.Get() : nullptr;
+		if (!Prepared)
+		{
+			const FString ErrorMsg = FString::Printf(TEXT("Unknown property handle %llu"), static_cast<uint64>(Op.handle()));
+			Status = grpc::Status(grpc::NOT_FOUND, std::string(TCHAR_TO_UTF8(*ErrorMsg)));
+		}
+		else if (!IsValid(Object))
+		{
+			const FString ErrorMsg = FString::Printf(TEXT("The object property handle %llu was prepared for no longer exists"), static_cast<uint64>(Op.handle()));
+			Status = grpc::Status(grpc::NOT_FOUND, std::string(TCHAR_TO_UTF8(*ErrorMsg)));
+		}
+		else if (Prepared->CacheGeneration != PropertyPathCache.GetGeneration())
+		{
+			// Types were reloaded since the handle was prepared, so its FProperties may be gone.
+			if (PropertyPathCache.Resolve(Object->GetClass(), Prepared->PropertyName, Prepared->Path))
+			{
+				Prepared->CacheGeneration = PropertyPathCache.GetGeneration();
+			}
+			else
+			{
+				const FString ErrorMsg = FString::Printf(TEXT("Property '%s' no longer exists on object '%s'"), *Prepared->PropertyName, *Object->GetName());
+				Status = grpc::Status(grpc::NOT_FOUND, std::string(TCHAR_TO_UTF8(*ErrorMsg)));
+			}
+		}
+
+		if (Status.ok())
+		{
+			FSetPropertyTarget Target;
+			Target.Object = Object;
+			Target.PropertyName = &Prepared->PropertyName;
+			Target.Path = Prepared->Path;
+			Status = DispatchSetPropertyOp(World, Op.op(), Target);
+		}
+
+		if (!Status.ok())
+		{
+			SetPropertyResult* Failure = Response.add_failures();
+			Failure->set_op_index(static_cast<uint32>(I));
+			Failure->set_code(static_cast<int32>(Status.error_code()));
+			Failure->set_error(Status.error_message());
+		}
+	}
+
+	ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
+}
+
+void UTempoWorldControlServiceSubsystem::ReleasePropertyHandles(const ReleasePropertyHandlesRequest& Request, const TResponseDelegate<TempoCore::Empty>& ResponseContinuation)
+{
+	if (Request.all())
+	{
+		PreparedProperties.Empty();
+	}
+	for (const uint64 Handle : Request.handles())
+	{
+		PreparedProperties.Remove(Handle);
+	}
+
+	ResponseContinuation.ExecuteIfBound(TempoCore::Empty(), grpc::Status_OK);
+}
+
+void UTempoWorldControlServiceSubsystem::SpawnActors(const SpawnActorsRequest& Request, const TResponseDelegate<SpawnActorsResponse>& ResponseContinuation)
+{
+	UWorld* World = GetWorld();
+	check(World);
+
+	UTempoActorNameIndex* ActorNameIndex = World->GetSubsystem<UTempoActorNameIndex>();
+
+	// Resolving a class may scan the asset registry, so do it once per distinct class name (FString map
+	// keys ignore case, as class lookup does). Failed lookups are cached too.
+	TMap<FString, UClass*> Classes;
+
+	SpawnActorsResponse Response;
+	Response.mutable_results()->Reserve(Request.actors_size());
+	for (const SpawnActorsEntry& Entry : Request.actors())
+	{
+		SpawnActorsResult* Result = Response.add_results();
+		auto Fail = [Result](grpc::StatusCode Code, const FString& ErrorMsg)
+		{
+			Result->set_code(static_cast<int32>(Code));
+			Result->set_error(TCHAR_TO_UTF8(*ErrorMsg));
+		};
+
+		if (Entry.actor_type().empty())
+		{
+			Fail(grpc::FAILED_PRECONDITION, TEXT("actor_type must be specified in SpawnActors entry"));
+			continue;
+		}
+
+		const FString ActorTypeName(UTF8_TO_TCHAR(Entry.actor_type().c_str()));
+		UClass* const* CachedClass = Classes.Find(ActorTypeName);
+		UClass* Class = CachedClass ? *CachedClass : Classes.Add(ActorTypeName, GetSubClassWithName<AActor>(ActorTypeName));
+		if (!Class)
+		{
+			Fail(grpc::NOT_FOUND, FString::Printf(TEXT("No actor class with name '%s' found (must be a subclass of AActor)"), *ActorTypeName));
+			continue;
+		}
+
+		FTransform SpawnTransform = ToUnrealTransform(Entry.transform());
+		if (!Entry.relative_to_actor().empty())
+		{
+			const FString RelativeToActorName(UTF8_TO_TCHAR(Entry.relative_to_actor().c_str()));
+			const AActor* RelativeToActor = GetActorWithName(World, RelativeToActorName);
+			if (!RelativeToActor)
+			{
+				Fail(grpc::FAILED_PRECONDITION, FString::Printf(TEXT("Failed to find relative_to_actor '%s' for SpawnActors entry"), *RelativeToActorName));
+				continue;
+			}
+			SpawnTransform = SpawnTransform * RelativeToActor->GetActorTransform();
+		}
+
+		// Deferred properties need the spawn held open until they are set.
+		const bool bSpawnDeferred = Entry.deferred() || Entry.deferred_properties_size() > 0;
+		AActor* SpawnedActor;
+		if (bSpawnDeferred)
+		{
+			SpawnedActor = World->SpawnActorDeferred<AActor>(Class, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+		}
+		else
+		{
+			SpawnedActor = AcquirePooledActor(World, Class, SpawnTransform);
+			if (!SpawnedActor)
+			{
+				const FVector SpawnLocation = SpawnTransform.GetLocation();
+				const FRotator SpawnRotation = SpawnTransform.GetRotation().Rotator();
+				FActorSpawnParameters SpawnParameters;
+				SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+				SpawnedActor = World->SpawnActor(Class, &SpawnLocation, &SpawnRotation, SpawnParameters);
+			}
+		}
+
+		if (!SpawnedActor)
+		{
+			const FVector SpawnLocation = SpawnTransform.GetLocation();
+			Fail(grpc::ABORTED, FString::Printf(TEXT("Failed to spawn actor of type '%s' at location (%f, %f, %f)"), *ActorTypeName, SpawnLocation.X, SpawnLocation.Y, SpawnLocation.Z));
+			continue;
+		}
+
+		const std::string SpawnedName(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(SpawnedActor)));
+		if (bSpawnDeferred && ActorNameIndex)
+		{
+			// Unfinished spawns raise no spawn event, so index this one for any later FinishSpawningActor.
+			ActorNameIndex->AddActor(SpawnedActor);
+		}
+
+		FSetPropertyTarget DeferredPropertyTarget;
+		DeferredPropertyTarget.Actor = SpawnedActor;
+		for (int32 I = 0; I < Entry.deferred_properties_size(); ++I)
+		{
+			const grpc::Status Status = DispatchSetPropertyOp(World, Entry.deferred_properties(I), DeferredPropertyTarget);
+			if (!Status.ok())
+			{
+				SetPropertyResult* Failure = Result->add_property_failures();
+				Failure->set_op_index(static_cast<uint32>(I));
+				Failure->set_code(static_cast<int32>(Status.error_code()));
+				Failure->set_error(Status.error_message());
+			}
+		}
+
+		if (Entry.deferred())
+		{
+			DeferredSpawnTransforms.Add(SpawnedActor, SpawnTransform);
+		}
+		else if (bSpawnDeferred)
+		{
+			SpawnedActor->FinishSpawning(SpawnTransform);
+		}
+
+		Result->set_name(SpawnedName);
+		*Result->mutable_transform() = FromUnrealTransform(SpawnedActor->GetActorTransform());
+	}
+
+	ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
+}
+
+void UTempoWorldControlServiceSubsystem::DestroyActors(const DestroyActorsRequest& Request, const TResponseDelegate<DestroyActorsResponse>& ResponseContinuation) const
+{
+	const UWorld* World = GetWorld();
+	DestroyActorsResponse Response;
+	for (int32 I = 0; I < Request.actors_size(); ++I)
+	{
+		auto Fail = [&Response, I](grpc::StatusCode Code, const FString& ErrorMsg)
+		{
+			DestroyActorsFailure* Failure = Response.add_failures();
+			Failure->set_index(static_cast<uint32>(I));
+			Failure->set_code(static_cast<int32>(Code));
+			Failure->set_error(TCHAR_TO_UTF8(*ErrorMsg));
+		};
+
+		if (Request.actors(I).empty())
+		{
+			Fail(grpc::FAILED_PRECONDITION, TEXT("actor must be specified in DestroyActors entry"));
+			continue;
+		}
+
+		const FString ActorName(UTF8_TO_TCHAR(Request.actors(I).c_str()));
+		AActor* Actor = GetActorWithName(World, ActorName);
+		if (!Actor)
+		{
+			Fail(grpc::NOT_FOUND, FString::Printf(TEXT("Failed to find actor '%s' for DestroyActors request"), *ActorName));
+			continue;
+		}
+		DestroyOrPoolActor(Actor);
+	}
+
+	ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
+}
+
 void UTempoWorldControlServiceSubsystem::CallObjectFunction(const CallFunctionRequest& Request, const TResponseDelegate<TempoCore::Empty>& ResponseContinuation) const
 {
 	UObject* Object = nullptr;
@@ -2555,3 +2917,481 @@ void UTempoWorldControlServiceSubsystem::CallObjectFunction(const CallFunctionRe
 
 	ResponseContinuation.ExecuteIfBound(TempoCore::Empty(), grpc::Status_OK);
 }
+
+namespace
+{
+	// A packed FTransform: location, rotation (as an FRotator) and scale, three doubles each.
+	constexpr int32 PackedTransformSize = 9 * sizeof(double);
+
+	bool IsStructProperty(const FProperty* Property, const UScriptStruct* Struct)
+	{
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		return StructProperty && StructProperty->Struct == Struct;
+	}
+
+	// Bytes Property takes in CallFunctions' packed layout, or 0 if it can't be packed.
+	int32 GetPackedSize(const FProperty* Property)
+	{
+		if (Property->ArrayDim != 1)
+		{
+			return 0;
+		}
+		if (Property->IsA<FBoolProperty>())
+		{
+			return 1;
+		}
+		if (Property->IsA<FNumericProperty>() || Property->IsA<FEnumProperty>())
+		{
+			return Property->GetSize();
+		}
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			const UScriptStruct* Struct = StructProperty->Struct;
+			if (Struct == TBaseStructure<FVector>::Get() || Struct == TBaseStructure<FVector2D>::Get() || Struct == TBaseStructure<FRotator>::Get())
+			{
+				return Property->GetSize();
+			}
+			if (Struct == TBaseStructure<FTransform>::Get())
+			{
+				return PackedTransformSize;
+			}
+		}
+		return 0;
+	}
+
+	// Copies a packed value into Property's value in Frame, and back. Bools go through FBoolProperty in
+	// case they are bitfields. As the property RPCs do, rotators and transforms are converted from and to
+	// radians, meters and the right-handed frame, while vectors, which may as well be directions or scales
+	// as locations, are passed as they are.
+	void UnpackParameter(const FProperty* Property, void* Frame, const uint8*& Cursor)
+	{
+		void* Value = Property->ContainerPtrToValuePtr<void>(Frame);
+		if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+		{
+			BoolProperty->SetPropertyValue(Value, *Cursor != 0);
+			Cursor += 1;
+			return;
+		}
+		if (IsStructProperty(Property, TBaseStructure<FRotator>::Get()))
+		{
+			FRotator Rotator;
+			FMemory::Memcpy(&Rotator, Cursor, sizeof(FRotator));
+			*static_cast<FRotator*>(Value) = QuantityConverter<Rad2Deg,R2L>::Convert(Rotator);
+			Cursor += sizeof(FRotator);
+			return;
+		}
+		if (IsStructProperty(Property, TBaseStructure<FTransform>::Get()))
+		{
+			double Packed[9];
+			FMemory::Memcpy(Packed, Cursor, PackedTransformSize);
+			const FVector Location = QuantityConverter<M2CM,R2L>::Convert(FVector(Packed[0], Packed[1], Packed[2]));
+			const FRotator Rotation = QuantityConverter<Rad2Deg,R2L>::Convert(FRotator(Packed[3], Packed[4], Packed[5]));
+			*static_cast<FTransform*>(Value) = FTransform(Rotation, Location, FVector(Packed[6], Packed[7], Packed[8]));
+			Cursor += PackedTransformSize;
+			return;
+		}
+		FMemory::Memcpy(Value, Cursor, Property->GetSize());
+		Cursor += Property->GetSize();
+	}
+
+	void PackParameter(const FProperty* Property, const void* Frame, uint8*& Cursor)
+	{
+		const void* Value = Property->ContainerPtrToValuePtr<void>(Frame);
+		if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+		{
+			*Cursor = BoolProperty->GetPropertyValue(Value) ? 1 : 0;
+			Cursor += 1;
+			return;
+		}
+		if (IsStructProperty(Property, TBaseStructure<FRotator>::Get()))
+		{
+			const FRotator Rotator = QuantityConverter<Deg2Rad,L2R>::Convert(*static_cast<const FRotator*>(Value));
+			FMemory::Memcpy(Cursor, &Rotator, sizeof(FRotator));
+			Cursor += sizeof(FRotator);
+			return;
+		}
+		if (IsStructProperty(Property, TBaseStructure<FTransform>::Get()))
+		{
+			const FTransform& Transform = *static_cast<const FTransform*>(Value);
+			const FVector Location = QuantityConverter<CM2M,L2R>::Convert(Transform.GetLocation());
+			const FRotator Rotation = QuantityConverter<Deg2Rad,L2R>::Convert(Transform.Rotator());
+			const FVector Scale = Transform.GetScale3D();
+			const double Packed[9] = { Location.X, Location.Y, Location.Z, Rotation.Pitch, Rotation.Yaw, Rotation.Roll, Scale.X, Scale.Y, Scale.Z };
+			FMemory::Memcpy(Cursor, Packed, PackedTransformSize);
+			Cursor += PackedTransformSize;
+			return;
+		}
+		FMemory::Memcpy(Cursor, Value, Property->GetSize());
+		Cursor += Property->GetSize();
+	}
+
+	void AddFunctionParameters(google::protobuf::RepeatedPtrField<FunctionParameter>& OutParameters, const TArray<FProperty*>& Properties)
+	{
+		for (const FProperty* Property : Properties)
+		{
+			FunctionParameter* Parameter = OutParameters.Add();
+			Parameter->set_name(TCHAR_TO_UTF8(*Property->GetName()));
+			Parameter->set_type(TCHAR_TO_UTF8(*Property->GetCPPType()));
+			Parameter->set_size(GetPackedSize(Property));
+		}
+	}
+}
+
+bool UTempoWorldControlServiceSubsystem::ResolveFunction(UClass* Class, FName FunctionName, FPreparedFunction& OutPrepared, FString& OutError)
+{
+	UFunction* Function = Class->FindFunctionByName(FunctionName);
+	if (!Function)
+	{
+		OutError = FString::Printf(TEXT("Function '%s' not found on class '%s'"), *FunctionName.ToString(), *Class->GetName());
+		return false;
+	}
+
+	OutPrepared.Class = Class;
+	OutPrepared.FunctionName = FunctionName;
+	OutPrepared.Function = Function;
+	OutPrepared.Inputs.Reset();
+	OutPrepared.Outputs.Reset();
+	OutPrepared.ArgumentsSize = 0;
+	OutPrepared.OutputsSize = 0;
+	OutPrepared.InputLayout.Reset();
+	OutPrepared.OutputLayout.Reset();
+	OutPrepared.CacheGeneration = FTempoPropertyPathCache::Get().GetGeneration();
+
+	for (TFieldIterator<FProperty> ParamIt(Function); ParamIt && ParamIt->HasAnyPropertyFlags(CPF_Parm); ++ParamIt)
+	{
+		FProperty* Param = *ParamIt;
+		const int32 PackedSize = GetPackedSize(Param);
+		if (PackedSize == 0)
+		{
+			OutError = FString::Printf(TEXT("Parameter '%s' of function '%s' has type '%s', which can't be packed (bool, numeric, enum, FVector, FVector2D, FRotator and FTransform parameters are supported)"),
+				*Param->GetName(), *FunctionName.ToString(), *Param->GetCPPType());
+			return false;
+		}
+
+		// Reference parameters are both read and written, unless they are const.
+		const bool bIsReturn = Param->HasAnyPropertyFlags(CPF_ReturnParm);
+		const bool bIsOut = Param->HasAnyPropertyFlags(CPF_OutParm);
+		const bool bIsReference = Param->HasAnyPropertyFlags(CPF_ReferenceParm);
+		if (!bIsReturn && (!bIsOut || bIsReference))
+		{
+			OutPrepared.Inputs.Add(Param);
+			OutPrepared.InputLayout.Add({ Param->GetCPPType(), OutPrepared.ArgumentsSize });
+			OutPrepared.ArgumentsSize += PackedSize;
+		}
+		if (bIsReturn || (bIsOut && !Param->HasAnyPropertyFlags(CPF_ConstParm)))
+		{
+			OutPrepared.Outputs.Add(Param);
+			OutPrepared.OutputLayout.Add({ Param->GetCPPType(), OutPrepared.OutputsSize });
+			OutPrepared.OutputsSize += PackedSize;
+		}
+	}
+
+	return true;
+}
+
+void UTempoWorldControlServiceSubsystem::PrepareFunction(const PrepareFunctionRequest& Request, const TResponseDelegate<PrepareFunctionResponse>& ResponseContinuation)
+{
+	if (Request.object_class().empty() || Request.function().empty())
+	{
+		ResponseContinuation.ExecuteIfBound(PrepareFunctionResponse(), grpc::Status(grpc::FAILED_PRECONDITION, "object_class and function must be specified in PrepareFunction request"));
+		return;
+	}
+
+	const FString ClassName(UTF8_TO_TCHAR(Request.object_class().c_str()));
+	UClass* Class = GetSubClassWithName<UObject>(ClassName);
+	if (!Class)
+	{
+		const FString ErrorMsg = FString::Printf(TEXT("Failed to find class '%s'"), *ClassName);
+		ResponseContinuation.ExecuteIfBound(PrepareFunctionResponse(), grpc::Status(grpc::NOT_FOUND, std::string(TCHAR_TO_UTF8(*ErrorMsg))));
+		return;
+	}
+
+	FPreparedFunction Prepared;
+	FString ErrorMsg;
+	if (!ResolveFunction(Class, FName(UTF8_TO_TCHAR(Request.function().c_str())), Prepared, ErrorMsg))
+	{
+		const grpc::StatusCode Code = Prepared.Function.IsValid() ? grpc::FAILED_PRECONDITION : grpc::NOT_FOUND;
+		ResponseContinuation.ExecuteIfBound(PrepareFunctionResponse(), grpc::Status(Code, std::string(TCHAR_TO_UTF8(*ErrorMsg))));
+		return;
+	}
+
+	PrepareFunctionResponse Response;
+	const uint64 Handle = NextFunctionHandle++;
+	Response.set_handle(Handle);
+	AddFunctionParameters(*Response.mutable_inputs(), Prepared.Inputs);
+	AddFunctionParameters(*Response.mutable_outputs(), Prepared.Outputs);
+	Response.set_arguments_size(Prepared.ArgumentsSize);
+	Response.set_outputs_size(Prepared.OutputsSize);
+	PreparedFunctions.Add(Handle, MoveTemp(Prepared));
+
+	ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
+}
+
+void UTempoWorldControlServiceSubsystem::CallFunctions(const CallFunctionsRequest& Request, const TResponseDelegate<CallFunctionsResponse>& ResponseContinuation)
+{
+	FPreparedFunction* Prepared = PreparedFunctions.Find(Request.handle());
+	if (!Prepared)
+	{
+		const FString ErrorMsg = FString::Printf(TEXT("Unknown function handle %llu"), static_cast<uint64>(Request.handle()));
+		ResponseContinuation.ExecuteIfBound(CallFunctionsResponse(), grpc::Status(grpc::NOT_FOUND, std::string(TCHAR_TO_UTF8(*ErrorMsg))));
+		return;
+	}
+
+	UClass* Class = Prepared->Class.Get();
+	if (!Class)
+	{
+		const FString ErrorMsg = FString::Printf(TEXT("The class function handle %llu was prepared for no longer exists"), static_cast<uint64>(Request.handle()));
+		ResponseContinuation.ExecuteIfBound(CallFunctionsResponse(), grpc::Status(grpc::NOT_FOUND, std::string(TCHAR_TO_UTF8(*ErrorMsg))));
+		return;
+	}
+	if (Prepared->CacheGeneration != FTempoPropertyPathCache::Get().GetGeneration() || !Prepared->Function.IsValid())
+	{
+		// Types were reloaded since the handle was prepared, so its UFunction and FProperties may be gone.
+		// Clients packed their arguments for the old layout, so no parameter's type or offset may have changed.
+		FPreparedFunction Reresolved;
+		FString ErrorMsg;
+		if (!ResolveFunction(Class, Prepared->FunctionName, Reresolved, ErrorMsg) ||
+			Reresolved.ArgumentsSize != Prepared->ArgumentsSize || Reresolved.OutputsSize != Prepared->OutputsSize ||
+			Reresolved.InputLayout != Prepared->InputLayout || Reresolved.OutputLayout != Prepared->OutputLayout)
+		{
+			ErrorMsg = FString::Printf(TEXT("Function '%s' changed since function handle %llu was prepared. Prepare it again."), *Prepared->FunctionName.ToString(), static_cast<uint64>(Request.handle()));
+			ResponseContinuation.ExecuteIfBound(CallFunctionsResponse(), grpc::Status(grpc::FAILED_PRECONDITION, std::string(TCHAR_TO_UTF8(*ErrorMsg))));
+			return;
+		}
+		*Prepared = MoveTemp(Reresolved);
+	}
+
+	const int32 NumTargets = Request.targets_size();
+	const std::string& Arguments = Request.arguments();
+	const int64 ArgumentsSize = Prepared->ArgumentsSize;
+	const bool bSharedArguments = static_cast<int64>(Arguments.size()) == ArgumentsSize;
+	if (!bSharedArguments && static_cast<int64>(Arguments.size()) != ArgumentsSize * NumTargets)
+	{
+		const FString ErrorMsg = FString::Printf(TEXT("arguments has %llu bytes, but function '%s' takes %lld per call, and there are %d targets"),
+			static_cast<uint64>(Arguments.size()), *Prepared->FunctionName.ToString(), ArgumentsSize, NumTargets);
+		ResponseContinuation.ExecuteIfBound(CallFunctionsResponse(), grpc::Status(grpc::INVALID_ARGUMENT, std::string(TCHAR_TO_UTF8(*ErrorMsg))));
+		return;
+	}
+
+	UFunction* Function = Prepared->Function.Get();
+	const UWorld* World = GetWorld();
+	CallFunctionsResponse Response;
+	std::string& Outputs = *Response.mutable_outputs();
+	Outputs.assign(static_cast<size_t>(Prepared->OutputsSize) * NumTargets, '\0');
+
+	// One parameter frame for the whole batch, initialized afresh for each call.
+	uint8* Frame = Function->ParmsSize > 0 ? static_cast<uint8*>(FMemory_Alloca_Aligned(Function->ParmsSize, Function->GetMinAlignment())) : nullptr;
+
+	for (int32 I = 0; I < NumTargets; ++I)
+	{
+		const FunctionTarget& Target = Request.targets(I);
+
+		UObject* Object = nullptr;
+		grpc::Status Status = GetObjectForRequest(World, Target, Object);
+		if (Status.ok() && !Object->IsA(Class))
+		{
+			const FString ErrorMsg = FString::Printf(TEXT("Object '%s' is a '%s', not a '%s'"), *Object->GetName(), *Object->GetClass()->GetName(), *Class->GetName());
+			Status = grpc::Status(grpc::FAILED_PRECONDITION, std::string(TCHAR_TO_UTF8(*ErrorMsg)));
+		}
+		if (!Status.ok())
+		{
+			SetPropertyResult* Failure = Response.add_failures();
+			Failure->set_op_index(static_cast<uint32>(I));
+			Failure->set_code(static_cast<int32>(Status.error_code()));
+			Failure->set_error(Status.error_message());
+			continue;
+		}
+
+		if (Frame)
+		{
+			Function->InitializeStruct(Frame);
+		}
+		const uint8* ArgumentsCursor = reinterpret_cast<const uint8*>(Arguments.data()) + (bSharedArguments ? 0 : ArgumentsSize * I);
+		for (const FProperty* Input : Prepared->Inputs)
+		{
+			UnpackParameter(Input, Frame, ArgumentsCursor);
+		}
+
+		Object->ProcessEvent(Function, Frame);
+
+		uint8* OutputsCursor = reinterpret_cast<uint8*>(Outputs.data()) + static_cast<int64>(Prepared->OutputsSize) * I;
+		for (const FProperty* Output : Prepared->Outputs)
+		{
+			PackParameter(Output, Frame, OutputsCursor);
+		}
+		if (Frame)
+		{
+			Function->DestroyStruct(Frame);
+		}
+	}
+
+	ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
+}
+
+void UTempoWorldControlServiceSubsystem::ReleaseFunctionHandles(const ReleaseFunctionHandlesRequest& Request, const TResponseDelegate<TempoCore::Empty>& ResponseContinuation)
+{
+	if (Request.all())
+	{
+		PreparedFunctions.Empty();
+	}
+	for (const uint64 Handle : Request.handles())
+	{
+		PreparedFunctions.Remove(Handle);
+	}
+
+	ResponseContinuation.ExecuteIfBound(TempoCore::Empty(), grpc::Status_OK);
+}
+
+void UTempoWorldControlServiceSubsystem::SaveWorldSnapshot(const SaveWorldSnapshotRequest& Request, const TResponseDelegate<SaveWorldSnapshotResponse>& ResponseContinuation)
+{
+	if (Request.name().empty())
+	{
+		ResponseContinuation.ExecuteIfBound(SaveWorldSnapshotResponse(), grpc::Status(grpc::FAILED_PRECONDITION, "name must be specified in SaveWorldSnapshot request"));
+		return;
+	}
+
+	TArray<FTempoWorldSnapshotProperty> Properties;
+	Properties.Reserve(Request.properties_size());
+	for (const PropertyPath& Path : Request.properties())
+	{
+		Properties.Add({ UTF8_TO_TCHAR(Path.actor().c_str()), UTF8_TO_TCHAR(Path.component().c_str()), UTF8_TO_TCHAR(Path.property().c_str()) });
+	}
+
+	FString ErrorMsg;
+	TUniquePtr<FTempoWorldSnapshot> Snapshot = FTempoWorldSnapshot::Capture(GetWorld(), Properties, ErrorMsg);
+	if (!Snapshot)
+	{
+		ResponseContinuation.ExecuteIfBound(SaveWorldSnapshotResponse(), grpc::Status(grpc::NOT_FOUND, std::string(TCHAR_TO_UTF8(*ErrorMsg))));
+		return;
+	}
+
+	SaveWorldSnapshotResponse Response;
+	Response.set_num_actors(Snapshot->NumActors());
+	Response.set_num_properties(Snapshot->NumProperties());
+	Response.set_num_traffic_entities(Snapshot->NumTrafficEntities());
+	Response.set_sim_time(Snapshot->GetSimTime());
+
+	WorldSnapshots.Add(UTF8_TO_TCHAR(Request.name().c_str()), MoveTemp(Snapshot));
+
+	ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
+}
+
+void UTempoWorldControlServiceSubsystem::RestoreWorldSnapshot(const RestoreWorldSnapshotRequest& Request, const TResponseDelegate<RestoreWorldSnapshotResponse>& ResponseContinuation)
+{
+	const FString Name(UTF8_TO_TCHAR(Request.name().c_str()));
+	TUniquePtr<FTempoWorldSnapshot>* Snapshot = WorldSnapshots.Find(Name);
+	if (!Snapshot)
+	{
+		const FString ErrorMsg = FString::Printf(TEXT("No world snapshot named '%s' (was it saved with SaveWorldSnapshot?)"), *Name);
+		ResponseContinuation.ExecuteIfBound(RestoreWorldSnapshotResponse(), grpc::Status(grpc::NOT_FOUND, std::string(TCHAR_TO_UTF8(*ErrorMsg))));
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	FTempoWorldSnapshotRestoreStats Stats;
+	FString ErrorMsg;
+	if (!(*Snapshot)->Restore(GetWorld(), Stats, ErrorMsg))
+	{
+		ResponseContinuation.ExecuteIfBound(RestoreWorldSnapshotResponse(), grpc::Status(grpc::FAILED_PRECONDITION, std::string(TCHAR_TO_UTF8(*ErrorMsg))));
+		return;
+	}
+
+	RestoreWorldSnapshotResponse Response;
+	Response.set_num_restored_actors(Stats.NumRestoredActors);
+	Response.set_num_respawned_actors(Stats.NumRespawnedActors);
+	Response.set_num_destroyed_actors(Stats.NumDestroyedActors);
+	Response.set_num_restored_properties(Stats.NumRestoredProperties);
+	Response.set_num_restored_traffic_entities(Stats.NumRestoredTrafficEntities);
+	Response.set_restore_duration(FPlatformTime::Seconds() - StartTime);
+
+	ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
+}
+
+void UTempoWorldControlServiceSubsystem::DeleteWorldSnapshot(const DeleteWorldSnapshotRequest& Request, const TResponseDelegate<TempoCore::Empty>& ResponseContinuation)
+{
+	if (Request.all())
+	{
+		WorldSnapshots.Empty();
+	}
+	else if (Request.name().empty())
+	{
+		ResponseContinuation.ExecuteIfBound(TempoCore::Empty(), grpc::Status(grpc::FAILED_PRECONDITION, "name (or all) must be specified in DeleteWorldSnapshot request"));
+		return;
+	}
+	else
+	{
+		WorldSnapshots.Remove(UTF8_TO_TCHAR(Request.name().c_str()));
+	}
+
+	ResponseContinuation.ExecuteIfBound(TempoCore::Empty(), grpc::Status_OK);
+}
+
+namespace
+{
+	void FillActorPoolStats(const UClass* Class, const FTempoActorPoolStats& Stats, ActorPoolStats& OutStats)
+	{
+		OutStats.set_actor_type(TCHAR_TO_UTF8(*Class->GetName()));
+		OutStats.set_max_size(Stats.MaxSize);
+		OutStats.set_num_pooled(Stats.NumPooled);
+		OutStats.set_hits(Stats.Hits);
+		OutStats.set_misses(Stats.Misses);
+		OutStats.set_releases(Stats.Releases);
+		OutStats.set_refusals(Stats.Refusals);
+		const uint64 NumAcquires = Stats.Hits + Stats.Misses;
+		OutStats.set_hit_rate(NumAcquires > 0 ? static_cast<double>(Stats.Hits) / NumAcquires : 0.0);
+		OutStats.set_estimated_memory_bytes(Stats.EstimatedMemoryBytes);
+	}
+}
+
+void UTempoWorldControlServiceSubsystem::ConfigureActorPool(const ConfigureActorPoolRequest& Request, const TResponseDelegate<ActorPoolStats>& ResponseContinuation)
+{
+	UTempoActorPool* ActorPool = GetWorld()->GetSubsystem<UTempoActorPool>();
+	if (!ActorPool)
+	{
+		ResponseContinuation.ExecuteIfBound(ActorPoolStats(), grpc::Status(grpc::FAILED_PRECONDITION, "Actor pools are only available while playing"));
+		return;
+	}
+
+	if (Request.actor_type().empty())
+	{
+		ResponseContinuation.ExecuteIfBound(ActorPoolStats(), grpc::Status(grpc::FAILED_PRECONDITION, "actor_type must be specified in ConfigureActorPool request"));
+		return;
+	}
+
+	const FString ActorTypeName(UTF8_TO_TCHAR(Request.actor_type().c_str()));
+	UClass* Class = GetSubClassWithName<AActor>(ActorTypeName);
+	if (!Class)
+	{
+		const FString ErrorMsg = FString::Printf(TEXT("No actor class with name '%s' found (must be a subclass of AActor)"), *ActorTypeName);
+		ResponseContinuation.ExecuteIfBound(ActorPoolStats(), grpc::Status(grpc::NOT_FOUND, std::string(TCHAR_TO_UTF8(*ErrorMsg))));
+		return;
+	}
+
+	ActorPool->SetMaxSize(Class, static_cast<int32>(FMath::Min<uint32>(Request.max_size(), MAX_int32)));
+	ActorPool->Prewarm(Class, static_cast<int32>(FMath::Min<uint32>(Request.prewarm(), MAX_int32)));
+
+	ActorPoolStats Response;
+	for (const TPair<UClass*, FTempoActorPoolStats>& Stats : ActorPool->GetStats())
+	{
+		if (Stats.Key == Class)
+		{
+			FillActorPoolStats(Class, Stats.Value, Response);
+		}
+	}
+
+	ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
+}
+
+void UTempoWorldControlServiceSubsystem::GetActorPoolStats(const TempoCore::Empty& Request, const TResponseDelegate<GetActorPoolStatsResponse>& ResponseContinuation) const
+{
+	GetActorPoolStatsResponse Response;
+	if (const UTempoActorPool* ActorPool = GetWorld()->GetSubsystem<UTempoActorPool>())
+	{
+		for (const TPair<UClass*, FTempoActorPoolStats>& Stats : ActorPool->GetStats())
+		{
+			FillActorPoolStats(Stats.Key, Stats.Value, *Response.add_pools());
+		}
+	}
+
+	ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
+}
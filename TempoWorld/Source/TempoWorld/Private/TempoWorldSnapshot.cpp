@@ -0,0 +1,591 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoWorldSnapshot.h"
+
+#include "TempoActorPool.h"
+#include "TempoPropertyPathCache.h"
+#include "TempoWorld.h"
+#include "TempoWorldSettings.h"
+#include "TempoWorldUtils.h"
+
+#include "Camera/PlayerCameraManager.h"
+#include "Components/PrimitiveComponent.h"
+#include "EngineUtils.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Info.h"
+#include "GameFramework/MovementComponent.h"
+#include "MassAgentComponent.h"
+#include "MassCommonFragments.h"
+#include "MassEntitySubsystem.h"
+#include "MassEntityView.h"
+#include "MassExecutionContext.h"
+#include "MassMovementFragments.h"
+#include "MassTrafficFragments.h"
+#include "MassZoneGraphNavigationFragments.h"
+
+namespace
+{
+	// Entities with one of these are captured, with whichever of the TrafficStateFragments they have.
+	TArray<const UScriptStruct*> TrafficAnchorFragments()
+	{
+		return {
+			FMassTrafficVehicleControlFragment::StaticStruct(),
+			FMassTrafficLightIntersectionFragment::StaticStruct(),
+			FMassTrafficSignIntersectionFragment::StaticStruct(),
+		};
+	}
+
+	// The per-entity state the traffic processors evolve. Config and shared fragments, and fragments
+	// holding only debug or visualization state, are left alone.
+	TArray<const UScriptStruct*> TrafficStateFragments()
+	{
+		return {
+			FTransformFragment::StaticStruct(),
+			FMassVelocityFragment::StaticStruct(),
+			FMassZoneGraphLaneLocationFragment::StaticStruct(),
+			FMassTrafficVehicleControlFragment::StaticStruct(),
+			FMassTrafficVehicleLaneChangeFragment::StaticStruct(),
+			FMassTrafficNextVehicleFragment::StaticStruct(),
+			FMassTrafficInterpolationFragment::StaticStruct(),
+			FMassTrafficPIDVehicleControlFragment::StaticStruct(),
+			FMassTrafficPIDControlInterpolationFragment::StaticStruct(),
+			FMassTrafficAngularVelocityFragment::StaticStruct(),
+			FMassTrafficObstacleAvoidanceFragment::StaticStruct(),
+			FMassTrafficVehicleLightsFragment::StaticStruct(),
+			FMassTrafficRandomFractionFragment::StaticStruct(),
+			FMassTrafficLaneOffsetFragment::StaticStruct(),
+			FMassTrafficLightIntersectionFragment::StaticStruct(),
+			FMassTrafficSignIntersectionFragment::StaticStruct(),
+		};
+	}
+
+	// The entities that have one of the TrafficAnchorFragments.
+	TSet<FMassEntityHandle> FindTrafficEntities(FMassEntityManager& EntityManager)
+	{
+		TSet<FMassEntityHandle> Entities;
+		for (const UScriptStruct* AnchorFragment : TrafficAnchorFragments())
+		{
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 6
+			FMassEntityQuery Query;
+#else
+			FMassEntityQuery Query(EntityManager.AsShared());
+#endif
+			Query.AddRequirement(AnchorFragment, EMassFragmentAccess::ReadOnly);
+			FMassExecutionContext Context(EntityManager);
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 6
+			Query.ForEachEntityChunk(EntityManager, Context, [&Entities](FMassExecutionContext& Context)
+#else
+			Query.ForEachEntityChunk(Context, [&Entities](FMassExecutionContext& Context)
+#endif
+			{
+				for (const FMassEntityHandle Entity : Context.GetEntities())
+				{
+					Entities.Add(Entity);
+				}
+			});
+		}
+		return Entities;
+	}
+
+	void ApplyVelocities(AActor* Actor, bool bSimulatingPhysics, const FVector& LinearVelocity, const FVector& AngularVelocityDeg, const FVector& MovementVelocity)
+	{
+		if (bSimulatingPhysics)
+		{
+			if (UPrimitiveComponent* RootPrimitive = Cast<UPrimitiveComponent>(Actor->GetRootComponent()))
+			{
+				RootPrimitive->SetPhysicsLinearVelocity(LinearVelocity);
+				RootPrimitive->SetPhysicsAngularVelocityInDegrees(AngularVelocityDeg);
+			}
+		}
+		if (UMovementComponent* MovementComponent = Actor->FindComponentByClass<UMovementComponent>())
+		{
+			MovementComponent->Velocity = MovementVelocity;
+			MovementComponent->UpdateComponentVelocity();
+		}
+	}
+
+	// A destroyed actor keeps its name until it is garbage collected. Move it aside so a restored actor can
+	// have the name back.
+	void FreeActorName(ULevel* Level, FName Name)
+	{
+		if (UObject* NameHolder = StaticFindObjectFast(nullptr, Level, Name))
+		{
+			if (!IsValid(NameHolder))
+			{
+				NameHolder->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_NonTransactional | REN_DoNotDirty);
+			}
+		}
+	}
+}
+
+FTempoWorldSnapshot::FPropertyValue::FPropertyValue(FProperty* InProperty, const void* Source, const UObject* Owner)
+	: Property(InProperty), PropertyOwner(InProperty->GetOwnerStruct()), CacheGeneration(FTempoPropertyPathCache::Get().GetGeneration())
+{
+	TArray<const FStructProperty*> EncounteredStructProps;
+	if (Property->ContainsObjectReference(EncounteredStructProps))
+	{
+		Property->ExportTextItem_Direct(Text, Source, nullptr, const_cast<UObject*>(Owner), PPF_None);
+	}
+	else
+	{
+		Value = FMemory::Malloc(Property->GetSize(), Property->GetMinAlignment());
+		Property->InitializeValue(Value);
+		Property->CopyCompleteValue(Value, Source);
+	}
+}
+
+FTempoWorldSnapshot::FPropertyValue::~FPropertyValue()
+{
+	if (Value)
+	{
+		Property->DestroyValue(Value);
+		FMemory::Free(Value);
+	}
+}
+
+FTempoWorldSnapshot::FPropertyValue::FPropertyValue(FPropertyValue&& Other)
+	: Property(Other.Property), PropertyOwner(MoveTemp(Other.PropertyOwner)), CacheGeneration(Other.CacheGeneration), Value(Other.Value), Text(MoveTemp(Other.Text))
+{
+	Other.Value = nullptr;
+}
+
+FProperty* FTempoWorldSnapshot::FPropertyValue::Resolve(const UObject* Object) const
+{
+	FTempoPropertyPathCache& PropertyPathCache = FTempoPropertyPathCache::Get();
+	if (CacheGeneration == PropertyPathCache.GetGeneration() && Object->GetClass()->IsChildOf(PropertyOwner.Get()))
+	{
+		return Property;
+	}
+
+	FTempoResolvedPropertyPath Path;
+	if (PropertyPathCache.Resolve(Object->GetClass(), Property->GetFName().ToString(), Path) && Path.Property->SameType(Property))
+	{
+		return Path.Property;
+	}
+	return nullptr;
+}
+
+void FTempoWorldSnapshot::FPropertyValue::CopyTo(const FProperty* DestProperty, void* Dest, UObject* Owner) const
+{
+	if (Value && DestProperty == Property)
+	{
+		Property->CopyCompleteValue(Dest, Value);
+		return;
+	}
+
+	// A value resolved onto a reinstanced type goes through text, since the types' layouts may differ.
+	FString ValueText;
+	if (Value)
+	{
+		Property->ExportTextItem_Direct(ValueText, Value, nullptr, Owner, PPF_None);
+	}
+	DestProperty->ImportText_Direct(Value ? *ValueText : *Text, Dest, Owner, PPF_None);
+}
+
+bool FTempoWorldSnapshot::IsDynamicActor(const AActor* Actor)
+{
+	if (!IsValid(Actor) || Actor->IsA<AController>() || Actor->IsA<APlayerCameraManager>() || Actor->IsA<AInfo>() || Actor->IsChildActor())
+	{
+		return false;
+	}
+
+	const USceneComponent* RootComponent = Actor->GetRootComponent();
+	if (!RootComponent || RootComponent->Mobility != EComponentMobility::Movable)
+	{
+		return false;
+	}
+
+	// Pooled actors are destroyed, as far as clients can tell.
+	const UTempoActorPool* ActorPool = Actor->GetWorld()->GetSubsystem<UTempoActorPool>();
+	if (ActorPool && ActorPool->IsPooled(Actor))
+	{
+		return false;
+	}
+
+	// Mass owns the existence and transform of the actors representing its agents.
+	return Actor->FindComponentByClass<UMassAgentComponent>() == nullptr;
+}
+
+TUniquePtr<FTempoWorldSnapshot> FTempoWorldSnapshot::Capture(UWorld* World, const TArray<FTempoWorldSnapshotProperty>& Properties, FString& OutError)
+{
+	check(World);
+
+	TUniquePtr<FTempoWorldSnapshot> Snapshot = MakeUnique<FTempoWorldSnapshot>();
+	Snapshot->SimTime = World->GetTimeSeconds();
+
+	TMap<TObjectKey<AActor>, int32> RecordIndices;
+	for (TActorIterator<AActor> ActorIt(World); ActorIt; ++ActorIt)
+	{
+		AActor* Actor = *ActorIt;
+		if (!IsDynamicActor(Actor))
+		{
+			continue;
+		}
+
+		FActorRecord& Record = Snapshot->Actors.AddDefaulted_GetRef();
+		Record.Actor = Actor;
+		Record.Class = Actor->GetClass();
+		Record.Level = Actor->GetLevel();
+		Record.Name = Actor->GetFName();
+#if WITH_EDITOR
+		Record.Label = Actor->GetActorLabel(false);
+#endif
+		Record.Transform = Actor->GetActorTransform();
+		if (const UPrimitiveComponent* RootPrimitive = Cast<UPrimitiveComponent>(Actor->GetRootComponent()))
+		{
+			Record.bSimulatingPhysics = RootPrimitive->IsSimulatingPhysics();
+			if (Record.bSimulatingPhysics)
+			{
+				Record.PhysicsLinearVelocity = RootPrimitive->GetPhysicsLinearVelocity();
+				Record.PhysicsAngularVelocityDeg = RootPrimitive->GetPhysicsAngularVelocityInDegrees();
+			}
+		}
+		if (const UMovementComponent* MovementComponent = Actor->FindComponentByClass<UMovementComponent>())
+		{
+			Record.MovementVelocity = MovementComponent->Velocity;
+		}
+		RecordIndices.Add(Actor, Snapshot->Actors.Num() - 1);
+	}
+
+	for (const FTempoWorldSnapshotProperty& Selector : Properties)
+	{
+		if (!Selector.Actor.IsEmpty())
+		{
+			AActor* Actor = GetActorWithName(World, Selector.Actor);
+			if (!Actor)
+			{
+				OutError = FString::Printf(TEXT("Failed to find actor '%s' for SaveWorldSnapshot request"), *Selector.Actor);
+				return nullptr;
+			}
+			const int32* RecordIndex = RecordIndices.Find(Actor);
+			if (!RecordIndex)
+			{
+				FActorRecord& Record = Snapshot->Actors.AddDefaulted_GetRef();
+				Record.Actor = Actor;
+				Record.bDynamic = false;
+				RecordIndex = &RecordIndices.Add(Actor, Snapshot->Actors.Num() - 1);
+			}
+			if (!CaptureProperty(Snapshot->Actors[*RecordIndex], Selector, OutError))
+			{
+				return nullptr;
+			}
+			continue;
+		}
+
+		int32 NumMatches = 0;
+		FString Unused;
+		for (FActorRecord& Record : Snapshot->Actors)
+		{
+			if (Record.bDynamic && CaptureProperty(Record, Selector, Unused))
+			{
+				++NumMatches;
+			}
+		}
+		if (NumMatches == 0)
+		{
+			OutError = FString::Printf(TEXT("No dynamic actor has property '%s'%s"), *Selector.Property,
+				Selector.Component.IsEmpty() ? TEXT("") : *FString::Printf(TEXT(" on a component named '%s'"), *Selector.Component));
+			return nullptr;
+		}
+	}
+
+	Snapshot->CaptureTraffic(World);
+
+	return Snapshot;
+}
+
+bool FTempoWorldSnapshot::CaptureProperty(FActorRecord& Record, const FTempoWorldSnapshotProperty& Selector, FString& OutError)
+{
+	AActor* Actor = Record.Actor.Get();
+	UObject* Object = Actor;
+	if (!Selector.Component.IsEmpty())
+	{
+		Object = GetComponentWithName(Actor, Selector.Component);
+		if (!Object)
+		{
+			OutError = FString::Printf(TEXT("Failed to find component '%s' on actor '%s'"), *Selector.Component, *Actor->GetName());
+			return false;
+		}
+	}
+
+	// The whole top-level property is captured, whatever the rest of the path names.
+	FTempoResolvedPropertyPath Path;
+	if (!FTempoPropertyPathCache::Get().Resolve(Object->GetClass(), Selector.Property, Path))
+	{
+		OutError = FString::Printf(TEXT("No property named '%s' found on '%s'"), *Selector.Property, *Object->GetName());
+		return false;
+	}
+
+	const FName ComponentName = Selector.Component.IsEmpty() ? NAME_None : Object->GetFName();
+	Record.Properties.RemoveAll([&Path, &ComponentName](const FCapturedProperty& Captured)
+	{
+		return Captured.Component == ComponentName && Captured.Value.Property == Path.Property;
+	});
+	Record.Properties.Add({ ComponentName, FPropertyValue(Path.Property, Path.Property->ContainerPtrToValuePtr<void>(Object), Object) });
+	return true;
+}
+
+void FTempoWorldSnapshot::CaptureTraffic(UWorld* World)
+{
+	UMassEntitySubsystem* EntitySubsystem = World->GetSubsystem<UMassEntitySubsystem>();
+	if (!EntitySubsystem)
+	{
+		return;
+	}
+	FMassEntityManager& EntityManager = EntitySubsystem->GetMutableEntityManager();
+
+	const TArray<const UScriptStruct*> StateFragments = TrafficStateFragments();
+	for (const FMassEntityHandle Entity : FindTrafficEntities(EntityManager))
+	{
+		TrafficEntities.Add(Entity.AsNumber());
+		const FMassEntityView EntityView(EntityManager, Entity);
+		for (const UScriptStruct* StateFragment : StateFragments)
+		{
+			const FStructView Fragment = EntityView.GetFragmentDataStruct(StateFragment);
+			if (Fragment.IsValid())
+			{
+				TrafficFragments.Add({ Entity.AsNumber(), FInstancedStruct(Fragment) });
+			}
+		}
+	}
+}
+
+bool FTempoWorldSnapshot::CanRestoreTraffic(UWorld* World, FString& OutError) const
+{
+	UMassEntitySubsystem* EntitySubsystem = World->GetSubsystem<UMassEntitySubsystem>();
+	const TSet<FMassEntityHandle> Entities = EntitySubsystem ? FindTrafficEntities(EntitySubsystem->GetMutableEntityManager()) : TSet<FMassEntityHandle>();
+
+	int32 NumDespawned = TrafficEntities.Num();
+	int32 NumSpawned = 0;
+	for (const FMassEntityHandle Entity : Entities)
+	{
+		if (TrafficEntities.Contains(Entity.AsNumber()))
+		{
+			--NumDespawned;
+		}
+		else
+		{
+			++NumSpawned;
+		}
+	}
+	if (NumSpawned > 0 || NumDespawned > 0)
+	{
+		OutError = FString::Printf(TEXT("%d traffic entities were spawned and %d despawned since the snapshot was saved. Snapshots don't create or destroy Mass entities, so it can't be restored."),
+			NumSpawned, NumDespawned);
+		return false;
+	}
+	return true;
+}
+
+int32 FTempoWorldSnapshot::RestoreTraffic(UWorld* World) const
+{
+	UMassEntitySubsystem* EntitySubsystem = World->GetSubsystem<UMassEntitySubsystem>();
+	if (!EntitySubsystem || TrafficFragments.IsEmpty())
+	{
+		return 0;
+	}
+	FMassEntityManager& EntityManager = EntitySubsystem->GetMutableEntityManager();
+
+	for (const FTrafficFragment& Saved : TrafficFragments)
+	{
+		const FMassEntityHandle Entity = FMassEntityHandle::FromNumber(Saved.Entity);
+		const FMassEntityView EntityView(EntityManager, Entity);
+		const UScriptStruct* FragmentType = Saved.Fragment.GetScriptStruct();
+		const FStructView Fragment = EntityView.GetFragmentDataStruct(FragmentType);
+		if (Fragment.IsValid())
+		{
+			FragmentType->CopyScriptStruct(Fragment.GetMemory(), Saved.Fragment.GetMemory());
+		}
+	}
+	return TrafficEntities.Num();
+}
+
+AActor* FTempoWorldSnapshot::Respawn(UWorld* World, FActorRecord& Record) const
+{
+	UClass* Class = Record.Class.Get();
+	if (!Class)
+	{
+		return nullptr;
+	}
+
+	ULevel* Level = Record.Level.IsValid() ? Record.Level.Get() : World->PersistentLevel.Get();
+	FreeActorName(Level, Record.Name);
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.Name = Record.Name;
+	SpawnParameters.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+	SpawnParameters.OverrideLevel = Level;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AActor* Actor = World->SpawnActor(Class, &Record.Transform, SpawnParameters);
+	if (!Actor)
+	{
+		UE_LOG(LogTempoWorld, Warning, TEXT("Failed to respawn actor '%s' of class '%s' while restoring world snapshot"), *Record.Name.ToString(), *Class->GetName());
+		return nullptr;
+	}
+
+#if WITH_EDITOR
+	if (!Record.Label.IsEmpty())
+	{
+		Actor->SetActorLabel(Record.Label, false);
+	}
+#endif
+
+	Record.Actor = Actor;
+	return Actor;
+}
+
+bool FTempoWorldSnapshot::Restore(UWorld* World, FTempoWorldSnapshotRestoreStats& OutStats, FString& OutError)
+{
+	check(World);
+
+	if (!CanRestoreTraffic(World, OutError))
+	{
+		return false;
+	}
+
+	OutStats = FTempoWorldSnapshotRestoreStats();
+
+	if (ATempoWorldSettings* WorldSettings = Cast<ATempoWorldSettings>(World->GetWorldSettings()))
+	{
+		WorldSettings->SetSimTime(SimTime);
+	}
+	else
+	{
+		World->TimeSeconds = SimTime;
+		World->UnpausedTimeSeconds = SimTime;
+	}
+
+	UTempoActorPool* ActorPool = World->GetSubsystem<UTempoActorPool>();
+
+	TSet<TObjectKey<AActor>> CapturedActors;
+	CapturedActors.Reserve(Actors.Num());
+	for (const FActorRecord& Record : Actors)
+	{
+		if (Record.bDynamic && Record.Actor.IsValid())
+		{
+			CapturedActors.Add(Record.Actor.Get());
+		}
+	}
+
+	TArray<AActor*> SpawnedSinceCapture;
+	for (TActorIterator<AActor> ActorIt(World); ActorIt; ++ActorIt)
+	{
+		if (IsDynamicActor(*ActorIt) && !CapturedActors.Contains(*ActorIt))
+		{
+			SpawnedSinceCapture.Add(*ActorIt);
+		}
+	}
+	for (AActor* Actor : SpawnedSinceCapture)
+	{
+		if (Actor->Destroy())
+		{
+			++OutStats.NumDestroyedActors;
+		}
+	}
+
+	for (FActorRecord& Record : Actors)
+	{
+		AActor* Actor = Record.Actor.Get();
+		if (Record.bDynamic)
+		{
+			if (!IsValid(Actor))
+			{
+				Actor = Respawn(World, Record);
+				if (!Actor)
+				{
+					continue;
+				}
+				++OutStats.NumRespawnedActors;
+			}
+			else if (ActorPool && ActorPool->IsPooled(Actor))
+			{
+				// Released to its pool since the capture, which clients saw as a destroy.
+				FreeActorName(Actor->GetLevel(), Record.Name);
+				ActorPool->Reclaim(Actor, Record.Transform, Record.Name);
+#if WITH_EDITOR
+				if (!Record.Label.IsEmpty())
+				{
+					Actor->SetActorLabel(Record.Label, false);
+				}
+#endif
+				++OutStats.NumRespawnedActors;
+			}
+			else
+			{
+				Actor->SetActorTransform(Record.Transform, false, nullptr, ETeleportType::ResetPhysics);
+			}
+			ApplyVelocities(Actor, Record.bSimulatingPhysics, Record.PhysicsLinearVelocity, Record.PhysicsAngularVelocityDeg, Record.MovementVelocity);
+			++OutStats.NumRestoredActors;
+		}
+		else if (!IsValid(Actor))
+		{
+			continue;
+		}
+
+		// As the Set*Property requests do: editor objects hear about the change, and everything is redrawn.
+		TArray<UObject*, TInlineAllocator<4>> RestoredObjects;
+		for (const FCapturedProperty& Captured : Record.Properties)
+		{
+			UObject* Object = Actor;
+			if (!Captured.Component.IsNone())
+			{
+				Object = GetComponentWithName(Actor, Captured.Component.ToString());
+			}
+			if (!Object)
+			{
+				continue;
+			}
+
+			FProperty* Property = Captured.Value.Resolve(Object);
+			if (!Property)
+			{
+				UE_LOG(LogTempoWorld, Warning, TEXT("'%s' no longer has property '%s' to restore from world snapshot"), *Object->GetName(), *Captured.Value.Property->GetName());
+				continue;
+			}
+#if WITH_EDITOR
+			if (World->WorldType == EWorldType::Editor)
+			{
+				Object->PreEditChange(Property);
+			}
+#endif
+			Captured.Value.CopyTo(Property, Property->ContainerPtrToValuePtr<void>(Object), Object);
+#if WITH_EDITOR
+			if (World->WorldType == EWorldType::Editor)
+			{
+				FPropertyChangedEvent Event(Property);
+				Object->PostEditChangeProperty(Event);
+			}
+#endif
+			RestoredObjects.AddUnique(Object);
+			++OutStats.NumRestoredProperties;
+		}
+		for (UObject* Object : RestoredObjects)
+		{
+			MarkRenderStateDirty(Object);
+		}
+	}
+
+	OutStats.NumRestoredTrafficEntities = RestoreTraffic(World);
+
+	return true;
+}
+
+int32 FTempoWorldSnapshot::NumActors() const
+{
+	int32 NumDynamic = 0;
+	for (const FActorRecord& Record : Actors)
+	{
+		NumDynamic += Record.bDynamic ? 1 : 0;
+	}
+	return NumDynamic;
+}
+
+int32 FTempoWorldSnapshot::NumProperties() const
+{
+	int32 NumCaptured = 0;
+	for (const FActorRecord& Record : Actors)
+	{
+		NumCaptured += Record.Properties.Num();
+	}
+	return NumCaptured;
+}
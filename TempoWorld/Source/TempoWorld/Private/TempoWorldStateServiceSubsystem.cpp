@@ -4,6 +4,7 @@
 
 #include "TempoWorld/WorldState.grpc.pb.h"
 
+#include "TempoActorPool.h"
 #include "TempoAngularVelocityInterface.h"
 #include "TempoConversion.h"
 #include "TempoCoreUtils.h"
@@ -16,6 +17,7 @@
 #include "MassTrafficVehicleComponent.h"
 #include "GameFramework/GameMode.h"
 #include "GameFramework/MovementComponent.h"
+#include "Async/ParallelFor.h"
 #include "Kismet/GameplayStatics.h"
 
 using WorldStateService = TempoWorld::WorldStateService;
@@ -25,10 +27,17 @@ using ActorStates = TempoWorld::ActorStates;
 using ActorStateRequest = TempoWorld::ActorStateRequest;
 using ActorStatesNearRequest = TempoWorld::ActorStatesNearRequest;
 using ActorStatesNearPositionRequest = TempoWorld::ActorStatesNearPositionRequest;
+using ActorStateDeltaOptions = TempoWorld::ActorStateDeltaOptions;
+using WorldStateSnapshotRequest = TempoWorld::WorldStateSnapshotRequest;
+using WorldStateSnapshot = TempoWorld::WorldStateSnapshot;
 using OverlapEventRequest = TempoWorld::OverlapEventRequest;
 using OverlapEventResponse = TempoWorld::OverlapEventResponse;
+using OverlapBatchRequest = TempoWorld::OverlapBatchRequest;
+using OverlapEventBatch = TempoWorld::OverlapEventBatch;
 using RaycastRequest = TempoWorld::RaycastRequest;
 using RaycastResponse = TempoWorld::RaycastResponse;
+using SceneQueriesRequest = TempoWorld::SceneQueriesRequest;
+using SceneQueriesResponse = TempoWorld::SceneQueriesResponse;
 
 namespace
 {
@@ -43,15 +52,22 @@ namespace
 		}
 	}
 
-	// Convert an Unreal-frame FBox (cm, left-handed) to a Tempo proto Box (m, right-handed).
+	// Convert an Unreal-frame FBox (cm, left-handed) to a Tempo-frame one (m, right-handed).
 	// The L2R handedness flip negates Y, which would otherwise swap that axis's min/max, so we
 	// convert both corners and take a component-wise min/max to keep a proper axis-aligned box.
-	void SetProtoBox(TempoCore::Box& OutBox, const FBox& Box)
+	FBox ToTempoBox(const FBox& Box)
 	{
 		const FVector CornerA = QuantityConverter<CM2M, L2R>::Convert(Box.Min);
 		const FVector CornerB = QuantityConverter<CM2M, L2R>::Convert(Box.Max);
-		const FVector BoxMin = CornerA.ComponentMin(CornerB);
-		const FVector BoxMax = CornerA.ComponentMax(CornerB);
+		return FBox(CornerA.ComponentMin(CornerB), CornerA.ComponentMax(CornerB));
+	}
+
+	// Convert an Unreal-frame FBox to a Tempo proto Box.
+	void SetProtoBox(TempoCore::Box& OutBox, const FBox& Box)
+	{
+		const FBox TempoBox = ToTempoBox(Box);
+		const FVector& BoxMin = TempoBox.Min;
+		const FVector& BoxMax = TempoBox.Max;
 		OutBox.mutable_min()->set_x(BoxMin.X);
 		OutBox.mutable_min()->set_y(BoxMin.Y);
 		OutBox.mutable_min()->set_z(BoxMin.Z);
@@ -59,18 +75,214 @@ namespace
 		OutBox.mutable_max()->set_y(BoxMax.Y);
 		OutBox.mutable_max()->set_z(BoxMax.Z);
 	}
+
+	// A scene query converted to the Unreal frame, ready to run off the game thread.
+	struct FPreparedSceneQuery
+	{
+		FVector Start;
+		FVector End;
+		FQuat Rotation = FQuat::Identity;
+		// A line shape (the default) for line traces.
+		FCollisionShape Shape;
+		ECollisionChannel Channel = ECC_WorldStatic;
+		FCollisionQueryParams Params;
+		bool bMulti = false;
+		int32 MaxHits = 0;
+	};
+
+	// Batches smaller than this don't gain from being split across threads.
+	constexpr int32 SceneQueryMinBatchSize = 8;
+
+	FCollisionShape ToUnrealShape(const TempoWorld::SweepShape& Shape)
+	{
+		switch (Shape.shape_case())
+		{
+		case TempoWorld::SweepShape::kSphereRadiusM:
+			return FCollisionShape::MakeSphere(Shape.sphere_radius_m() * 100.0f);
+		case TempoWorld::SweepShape::kBoxHalfExtentM:
+			return FCollisionShape::MakeBox(FVector(Shape.box_half_extent_m().x(), Shape.box_half_extent_m().y(), Shape.box_half_extent_m().z()).GetAbs() * 100.0);
+		case TempoWorld::SweepShape::kCapsule:
+			return FCollisionShape::MakeCapsule(Shape.capsule().radius_m() * 100.0f, Shape.capsule().half_height_m() * 100.0f);
+		default:
+			return FCollisionShape();
+		}
+	}
+
+	void SetProtoVector(TempoCore::Vector& OutVector, const FVector& Vector)
+	{
+		OutVector.set_x(Vector.X);
+		OutVector.set_y(Vector.Y);
+		OutVector.set_z(Vector.Z);
+	}
+
+	// Actors that can't move on their own.
+	bool IsStaticActor(const AActor* Actor)
+	{
+		const bool bHasMovementComponent = Actor->GetComponentByClass<UMovementComponent>() != nullptr;
+		const bool bHasMassTrafficVehicleComponent = Actor->GetComponentByClass<UMassTrafficVehicleComponent>() != nullptr;
+		const bool bHasMassAgentComponent = Actor->GetComponentByClass<UMassAgentComponent>() != nullptr;
+		return !(bHasMovementComponent || bHasMassTrafficVehicleComponent || bHasMassAgentComponent);
+	}
+
+	// The Actor's angular velocity in the Tempo frame (rad/s, right-handed).
+	FVector GetActorAngularVelocity(const AActor* Actor)
+	{
+		FVector ActorAngularVelocity;
+		const TArray<UActorComponent*> AngularVelocityComponents = Actor->GetComponentsByInterface(UTempoAngularVelocityInterface::StaticClass());
+		if (AngularVelocityComponents.Num() == 1)
+		{
+			ActorAngularVelocity = QuantityConverter<Deg2Rad, L2R>::Convert(Cast<ITempoAngularVelocityInterface>(AngularVelocityComponents[0])->GetAngularVelocity());
+		}
+		else if (const UPrimitiveComponent* PrimitiveComponent = Cast<UPrimitiveComponent>(Actor->GetRootComponent()))
+		{
+			ActorAngularVelocity = QuantityConverter<UC_NONE, L2R>::Convert(PrimitiveComponent->GetPhysicsAngularVelocityInRadians());
+		}
+
+		// The L2R conversion above handles the fact that the Y-axis is flipped, but not the handedness of the rotations themselves.
+		return -ActorAngularVelocity;
+	}
+
+	// The Actor's world-axis-aligned bounds, and its local bounds with its scale baked in, in the Unreal frame.
+	void GetActorBounds(const AActor* Actor, bool bIncludeHiddenComponents, FBox& OutWorldBounds, FBox& OutScaledLocalBounds)
+	{
+		const FBox ActorLocalBounds = UTempoCoreUtils::GetActorLocalBounds(Actor, bIncludeHiddenComponents);
+		// The proto Box is axis-aligned in world space, so transform all 8 corners of the local box
+		// (TransformBy) rather than just Min/Max, which would be wrong whenever the Actor is rotated.
+		OutWorldBounds = ActorLocalBounds.TransformBy(Actor->GetTransform());
+
+		// Local bounds with the Actor's scale baked in (the transmitted transform carries location and
+		// rotation only). A client recovers the tight oriented box from local_bounds plus the transform.
+		const FVector ActorScale = Actor->GetTransform().GetScale3D();
+		OutScaledLocalBounds = FBox(ActorLocalBounds.Min * ActorScale, ActorLocalBounds.Max * ActorScale);
+	}
+
+	// Appends a vector's components to a packed float32 column.
+	void PackVector(uint8*& Cursor, const FVector& Vector)
+	{
+		const float Values[3] = { static_cast<float>(Vector.X), static_cast<float>(Vector.Y), static_cast<float>(Vector.Z) };
+		FMemory::Memcpy(Cursor, Values, sizeof(Values));
+		Cursor += sizeof(Values);
+	}
+
+	// Sizes a bytes field for NumRows rows of 6 floats and returns where to write them.
+	uint8* ResizeColumn(std::string& Column, int32 NumRows)
+	{
+		Column.resize(NumRows * 6 * sizeof(float));
+		return reinterpret_cast<uint8*>(Column.data());
+	}
+
+	void AddSnapshotActor(WorldStateSnapshot& Snapshot, uint32 Id, const AActor* Actor)
+	{
+		TempoWorld::SnapshotActor* Entry = Snapshot.add_added_actors();
+		Entry->set_id(Id);
+		Entry->set_name(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(Actor)));
+		Entry->set_actor_class(TCHAR_TO_UTF8(*Actor->GetClass()->GetName()));
+	}
+
+	// Whether Class is, or derives from, a class with one of these names.
+	bool IsClassOrSubclassOf(const UClass* Class, const TArray<FName>& ClassNames)
+	{
+		for (; Class; Class = Class->GetSuperClass())
+		{
+			if (ClassNames.Contains(Class->GetFName()))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool HasAnyTag(const AActor* Actor, const TArray<FName>& Tags)
+	{
+		return Tags.ContainsByPredicate([Actor](const FName& Tag) { return Actor->ActorHasTag(Tag); });
+	}
+
+	// Unlike the snapshot filters, these names are kept for the life of a stream, so they are added to the
+	// name table if they aren't in it yet (a class may load after the stream starts).
+	TArray<FName> ToNames(const google::protobuf::RepeatedPtrField<std::string>& Strings)
+	{
+		TArray<FName> Names;
+		Names.Reserve(Strings.size());
+		for (const std::string& String : Strings)
+		{
+			Names.Add(FName(UTF8_TO_TCHAR(String.c_str())));
+		}
+		return Names;
+	}
+
+	// Whether an overlap stream watches Actor because of its class or tags.
+	bool IsSelectedByClassOrTag(const FTempoOverlapSubscriber& Subscriber, const AActor* Actor)
+	{
+		return IsClassOrSubclassOf(Actor->GetClass(), Subscriber.ActorClasses) || HasAnyTag(Actor, Subscriber.ActorTags);
+	}
+
+	bool PassesOverlapFilters(const FTempoOverlapSubscriber& Subscriber, const AActor* OtherActor)
+	{
+		return (Subscriber.OverlappingActorClasses.IsEmpty() || IsClassOrSubclassOf(OtherActor->GetClass(), Subscriber.OverlappingActorClasses)) &&
+			(Subscriber.OverlappingActorTags.IsEmpty() || HasAnyTag(OtherActor, Subscriber.OverlappingActorTags));
+	}
+
+	constexpr double DefaultKeyframeIntervalS = 5.0;
+
+	// A delta-mode or snapshot stream that hasn't asked for a message in this long has gone away.
+	constexpr double StreamSubscriberTimeoutS = 10.0;
+
+	constexpr double StreamPruneIntervalS = 1.0;
+
+	FTempoActorStateDeltaKey MakeDeltaKey(const ActorStateDeltaOptions& Options, bool bIncludeHiddenComponents)
+	{
+		FTempoActorStateDeltaKey Key;
+		Key.PositionToleranceM = FMath::Max(Options.position_tolerance_m(), 0.0f);
+		Key.RotationToleranceDeg = FMath::Max(Options.rotation_tolerance_deg(), 0.0f);
+		Key.bIncludeHiddenComponents = bIncludeHiddenComponents;
+		return Key;
+	}
+
+	bool VectorsDiffer(const TempoCore::Vector& Left, const TempoCore::Vector& Right, double Tolerance)
+	{
+		return FVector::DistSquared(FVector(Left.x(), Left.y(), Left.z()), FVector(Right.x(), Right.y(), Right.z())) > FMath::Square(Tolerance);
+	}
+
+	bool BoxesDiffer(const TempoCore::Box& Left, const TempoCore::Box& Right, double Tolerance)
+	{
+		return VectorsDiffer(Left.min(), Right.min(), Tolerance) || VectorsDiffer(Left.max(), Right.max(), Tolerance);
+	}
+
+	bool RotationsDiffer(const TempoCore::Rotation& Left, const TempoCore::Rotation& Right, double Tolerance)
+	{
+		return FMath::Abs(FMath::FindDeltaAngleRadians(Left.r(), Right.r())) > Tolerance ||
+			FMath::Abs(FMath::FindDeltaAngleRadians(Left.p(), Right.p())) > Tolerance ||
+				FMath::Abs(FMath::FindDeltaAngleRadians(Left.y(), Right.y())) > Tolerance;
+	}
+
+	// Whether Sample has moved beyond Key's tolerances from Reference. ActorStates are in meters and radians.
+	bool ActorStateChanged(const TempoWorld::ActorState& Reference, const TempoWorld::ActorState& Sample, const FTempoActorStateDeltaKey& Key)
+	{
+		const double PositionTolerance = Key.PositionToleranceM;
+		const double RotationTolerance = FMath::DegreesToRadians(Key.RotationToleranceDeg);
+		return VectorsDiffer(Reference.transform().location(), Sample.transform().location(), PositionTolerance) ||
+			RotationsDiffer(Reference.transform().rotation(), Sample.transform().rotation(), RotationTolerance) ||
+			BoxesDiffer(Reference.bounds(), Sample.bounds(), PositionTolerance) ||
+			BoxesDiffer(Reference.local_bounds(), Sample.local_bounds(), PositionTolerance) ||
+			VectorsDiffer(Reference.velocity().linear(), Sample.velocity().linear(), PositionTolerance) ||
+			VectorsDiffer(Reference.velocity().angular(), Sample.velocity().angular(), RotationTolerance);
+	}
 }
 
 void UTempoWorldStateServiceSubsystem::RegisterServices(FTempoServer& Server)
 {
 	Server.RegisterService<WorldStateService>(
 		StreamingRequestHandler(&WorldStateAsyncService::RequestStreamOverlapEvents, &UTempoWorldStateServiceSubsystem::StreamOverlapEvents),
+		StreamingRequestHandler(&WorldStateAsyncService::RequestStreamOverlapEventBatches, &UTempoWorldStateServiceSubsystem::StreamOverlapEventBatches),
 		SimpleRequestHandler(&WorldStateAsyncService::RequestGetCurrentActorState, &UTempoWorldStateServiceSubsystem::GetCurrentActorState),
 		StreamingRequestHandler(&WorldStateAsyncService::RequestStreamActorState, &UTempoWorldStateServiceSubsystem::StreamActorState),
 		SimpleRequestHandler(&WorldStateAsyncService::RequestGetCurrentActorStatesNear, &UTempoWorldStateServiceSubsystem::GetCurrentActorStatesNear),
 		SimpleRequestHandler(&WorldStateAsyncService::RequestGetCurrentActorStatesNearPosition, &UTempoWorldStateServiceSubsystem::GetCurrentActorStatesNearPosition),
 		StreamingRequestHandler(&WorldStateAsyncService::RequestStreamActorStatesNear, &UTempoWorldStateServiceSubsystem::StreamActorStatesNear),
-		SimpleRequestHandler(&WorldStateAsyncService::RequestRaycast, &UTempoWorldStateServiceSubsystem::Raycast)
+		SimpleRequestHandler(&WorldStateAsyncService::RequestGetWorldStateSnapshot, &UTempoWorldStateServiceSubsystem::GetWorldStateSnapshot),
+		StreamingRequestHandler(&WorldStateAsyncService::RequestStreamWorldStateSnapshots, &UTempoWorldStateServiceSubsystem::StreamWorldStateSnapshots),
+		SimpleRequestHandler(&WorldStateAsyncService::RequestRaycast, &UTempoWorldStateServiceSubsystem::Raycast),
+		SimpleRequestHandler(&WorldStateAsyncService::RequestSceneQueries, &UTempoWorldStateServiceSubsystem::SceneQueries)
 	);
 }
 
@@ -83,6 +295,12 @@ void UTempoWorldStateServiceSubsystem::Initialize(FSubsystemCollectionBase& Coll
 
 void UTempoWorldStateServiceSubsystem::Deinitialize()
 {
+	if (ActorSpawnedHandle.IsValid())
+	{
+		GetWorld()->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		ActorSpawnedHandle.Reset();
+	}
+
 	Super::Deinitialize();
 
 	FTempoServer::Get().DeactivateService<WorldStateService>();
@@ -110,6 +328,7 @@ TArray<AActor*> GetMatchingActors(const UWorld* World, const ActorStatesNearRequ
 		const FString NearActorName(UTF8_TO_TCHAR(Request.near_actor().c_str()));
 		if (const AActor* NearActor = GetActorWithName(World, NearActorName))
 		{
+			const UTempoActorPool* ActorPool = World->GetSubsystem<UTempoActorPool>();
 			for (TActorIterator<AActor> ActorIt(World); ActorIt; ++ActorIt)
 			{
 				// Skip hidden Actors (unless told to include them).
@@ -117,12 +336,13 @@ TArray<AActor*> GetMatchingActors(const UWorld* World, const ActorStatesNearRequ
 				{
 					continue;
 				}
+				// Pooled actors are destroyed, as far as clients can tell.
+				if (ActorPool && ActorPool->IsPooled(*ActorIt))
+				{
+					continue;
+				}
 				// Skip static actors (unless told to include them).
-				const bool bHasMovementComponent = ActorIt->GetComponentByClass<UMovementComponent>() != nullptr;
-				const bool bHasMassTrafficVehicleComponent = ActorIt->GetComponentByClass<UMassTrafficVehicleComponent>() != nullptr;
-				const bool bHasMassAgentComponent = ActorIt->GetComponentByClass<UMassAgentComponent>() != nullptr;
-				const bool bIsStatic = !(bHasMovementComponent || bHasMassTrafficVehicleComponent || bHasMassAgentComponent);
-				if (!Request.include_static() && bIsStatic)
+				if (!Request.include_static() && IsStaticActor(*ActorIt))
 				{
 					continue;
 				}
@@ -151,6 +371,7 @@ TArray<AActor*> GetMatchingActors(const UWorld* World, const ActorStatesNearPosi
 		FVector(Request.position().x(), Request.position().y(), Request.position().z()));
 	const float SearchRadius = QuantityConverter<M2CM>::Convert(Request.search_radius_m());
 
+	const UTempoActorPool* ActorPool = World->GetSubsystem<UTempoActorPool>();
 	for (TActorIterator<AActor> ActorIt(World); ActorIt; ++ActorIt)
 	{
 		// Skip hidden Actors (unless told to include them).
@@ -158,12 +379,13 @@ TArray<AActor*> GetMatchingActors(const UWorld* World, const ActorStatesNearPosi
 		{
 			continue;
 		}
+		// Pooled actors are destroyed, as far as clients can tell.
+		if (ActorPool && ActorPool->IsPooled(*ActorIt))
+		{
+			continue;
+		}
 		// Skip static actors (unless told to include them).
-		const bool bHasMovementComponent = ActorIt->GetComponentByClass<UMovementComponent>() != nullptr;
-		const bool bHasMassTrafficVehicleComponent = ActorIt->GetComponentByClass<UMassTrafficVehicleComponent>() != nullptr;
-		const bool bHasMassAgentComponent = ActorIt->GetComponentByClass<UMassAgentComponent>() != nullptr;
-		const bool bIsStatic = !(bHasMovementComponent || bHasMassTrafficVehicleComponent || bHasMassAgentComponent);
-		if (!Request.include_static() && bIsStatic)
+		if (!Request.include_static() && IsStaticActor(*ActorIt))
 		{
 			continue;
 		}
@@ -207,41 +429,22 @@ TempoWorld::ActorState GetActorState(const AActor* Actor, const UWorld* World, b
 	ActorStateLinearVel->set_y(ActorLinearVelocity.Y);
 	ActorStateLinearVel->set_z(ActorLinearVelocity.Z);
 
-	FVector ActorAngularVelocity;
-	const TArray<UActorComponent*> AngularVelocityComponents = Actor->GetComponentsByInterface(UTempoAngularVelocityInterface::StaticClass());
-	if (AngularVelocityComponents.Num() == 1)
-	{
-		ActorAngularVelocity = QuantityConverter<Deg2Rad, L2R>::Convert(Cast<ITempoAngularVelocityInterface>(AngularVelocityComponents[0])->GetAngularVelocity());
-	}
-	else if (const UPrimitiveComponent* PrimitiveComponent = Cast<UPrimitiveComponent>(Actor->GetRootComponent()))
-	{
-		ActorAngularVelocity = QuantityConverter<UC_NONE, L2R>::Convert(PrimitiveComponent->GetPhysicsAngularVelocityInRadians());
-	}
-
-	// The L2R conversion above handles the fact that the Y-axis is flipped, but not the handedness of the rotations themselves.
-	ActorAngularVelocity = -ActorAngularVelocity;
-
+	const FVector ActorAngularVelocity = GetActorAngularVelocity(Actor);
 	TempoCore::Vector* ActorStateAngularVel = ActorStateVelocity->mutable_angular();
 	ActorStateAngularVel->set_x(ActorAngularVelocity.X);
 	ActorStateAngularVel->set_y(ActorAngularVelocity.Y);
 	ActorStateAngularVel->set_z(ActorAngularVelocity.Z);
 
-	const FBox ActorLocalBounds = UTempoCoreUtils::GetActorLocalBounds(Actor, bIncludeHiddenComponents);
-	// The proto Box is axis-aligned in world space, so transform all 8 corners of the local box
-	// (TransformBy) rather than just Min/Max, which would be wrong whenever the Actor is rotated.
-	const FBox ActorWorldBounds = ActorLocalBounds.TransformBy(Actor->GetTransform());
-
-	// Local bounds with the Actor's scale baked in (the transmitted transform carries location and
-	// rotation only). A client recovers the tight oriented box from local_bounds plus the transform.
-	const FVector ActorScale = Actor->GetTransform().GetScale3D();
-	const FBox ActorScaledLocalBounds(ActorLocalBounds.Min * ActorScale, ActorLocalBounds.Max * ActorScale);
+	FBox ActorWorldBounds;
+	FBox ActorScaledLocalBounds;
+	GetActorBounds(Actor, bIncludeHiddenComponents, ActorWorldBounds, ActorScaledLocalBounds);
 
 	if (GDebugTempoWorld)
 	{
 		// Draw the tight oriented box: the local box's center transformed into world, with the
 		// Actor's rotation and scaled local half-extents.
-		const FVector OrientedCenter = Actor->GetTransform().TransformPosition(ActorLocalBounds.GetCenter());
-		const FVector ScaledLocalExtent = ActorScale * ActorLocalBounds.GetExtent();
+		const FVector OrientedCenter = Actor->GetActorTransform().TransformPositionNoScale(ActorScaledLocalBounds.GetCenter());
+		const FVector ScaledLocalExtent = ActorScaledLocalBounds.GetExtent();
 		DrawDebugBox(World, OrientedCenter, ScaledLocalExtent, Actor->GetActorRotation().Quaternion(),
 			FColor::Red, false, -1, 0, 3.0);
 	}
@@ -322,6 +525,184 @@ void UTempoWorldStateServiceSubsystem::StreamActorStatesNear(const TempoWorld::A
 	PendingActorStatesNearRequests.FindOrAdd(Request).Add(ResponseContinuation);
 }
 
+void UTempoWorldStateServiceSubsystem::GetWorldStateSnapshot(const WorldStateSnapshotRequest& Request, const TResponseDelegate<WorldStateSnapshot>& ResponseContinuation)
+{
+	WorldStateSnapshot Response;
+
+	const TArray<const AActor*> Actors = BuildWorldStateSnapshot(Request, Response);
+	for (int32 Row = 0; Row < Actors.Num(); ++Row)
+	{
+		AddSnapshotActor(Response, Response.actor_ids(Row), Actors[Row]);
+	}
+
+	ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
+}
+
+void UTempoWorldStateServiceSubsystem::StreamWorldStateSnapshots(const WorldStateSnapshotRequest& Request, const TResponseDelegate<WorldStateSnapshot>& ResponseContinuation)
+{
+	PendingWorldStateSnapshotRequests.FindOrAdd(Request).Add(ResponseContinuation);
+}
+
+uint32 UTempoWorldStateServiceSubsystem::GetSnapshotActorId(const AActor* Actor)
+{
+	if (const uint32* Id = SnapshotActorIds.Find(Actor))
+	{
+		return *Id;
+	}
+	return SnapshotActorIds.Add(Actor, NextSnapshotActorId++);
+}
+
+TArray<const AActor*> UTempoWorldStateServiceSubsystem::BuildWorldStateSnapshot(const WorldStateSnapshotRequest& Request, WorldStateSnapshot& Snapshot)
+{
+	const UWorld* World = GetWorld();
+
+	// FNAME_Find never adds to the name table. A name that isn't in it can't be any class's or tag's.
+	TArray<FName> ClassNames;
+	for (const std::string& ClassName : Request.actor_classes())
+	{
+		const FName Name(UTF8_TO_TCHAR(ClassName.c_str()), FNAME_Find);
+		if (!Name.IsNone())
+		{
+			ClassNames.Add(Name);
+		}
+	}
+	TArray<FName> Tags;
+	for (const std::string& Tag : Request.tags())
+	{
+		const FName Name(UTF8_TO_TCHAR(Tag.c_str()), FNAME_Find);
+		if (!Name.IsNone())
+		{
+			Tags.Add(Name);
+		}
+	}
+
+	// Whether each class seen so far is, or derives from, one of the requested ones.
+	TMap<const UClass*, bool> ClassMatches;
+
+	const UTempoActorPool* ActorPool = World->GetSubsystem<UTempoActorPool>();
+	TArray<const AActor*> Actors;
+	for (TActorIterator<AActor> ActorIt(World); ActorIt; ++ActorIt)
+	{
+		const AActor* Actor = *ActorIt;
+		// Skip hidden Actors (unless told to include them).
+		if (!Request.include_hidden_actors() && Actor->IsHidden())
+		{
+			continue;
+		}
+		// Pooled actors are destroyed, as far as clients can tell.
+		if (ActorPool && ActorPool->IsPooled(Actor))
+		{
+			continue;
+		}
+		if (Request.actor_classes_size() > 0)
+		{
+			const UClass* ActorClass = Actor->GetClass();
+			const bool* bClassMatches = ClassMatches.Find(ActorClass);
+			if (!bClassMatches)
+			{
+				bClassMatches = &ClassMatches.Add(ActorClass, IsClassOrSubclassOf(ActorClass, ClassNames));
+			}
+			if (!*bClassMatches)
+			{
+				continue;
+			}
+		}
+		if (Request.tags_size() > 0 && !HasAnyTag(Actor, Tags))
+		{
+			continue;
+		}
+		// Skip static actors (unless told to include them).
+		if (!Request.include_static() && IsStaticActor(Actor))
+		{
+			continue;
+		}
+		Actors.Add(Actor);
+	}
+
+	Snapshot.set_timestamp_s(World->GetTimeSeconds());
+
+	const int32 NumRows = Actors.Num();
+	Snapshot.mutable_actor_ids()->Reserve(NumRows);
+	uint8* Transforms = ResizeColumn(*Snapshot.mutable_transforms(), NumRows);
+	uint8* Velocities = ResizeColumn(*Snapshot.mutable_velocities(), NumRows);
+	uint8* Bounds = Request.include_bounds() ? ResizeColumn(*Snapshot.mutable_bounds(), NumRows) : nullptr;
+	uint8* LocalBounds = Request.include_bounds() ? ResizeColumn(*Snapshot.mutable_local_bounds(), NumRows) : nullptr;
+
+	for (const AActor* Actor : Actors)
+	{
+		Snapshot.add_actor_ids(GetSnapshotActorId(Actor));
+
+		const FRotator ActorRotation = QuantityConverter<Deg2Rad, L2R>::Convert(Actor->GetActorRotation());
+		PackVector(Transforms, QuantityConverter<CM2M, L2R>::Convert(Actor->GetActorLocation()));
+		PackVector(Transforms, FVector(ActorRotation.Roll, ActorRotation.Pitch, ActorRotation.Yaw));
+
+		PackVector(Velocities, QuantityConverter<CM2M, L2R>::Convert(Actor->GetVelocity()));
+		PackVector(Velocities, GetActorAngularVelocity(Actor));
+
+		if (Request.include_bounds())
+		{
+			FBox ActorWorldBounds;
+			FBox ActorScaledLocalBounds;
+			GetActorBounds(Actor, Request.include_hidden_components(), ActorWorldBounds, ActorScaledLocalBounds);
+			const FBox TempoWorldBounds = ToTempoBox(ActorWorldBounds);
+			const FBox TempoLocalBounds = ToTempoBox(ActorScaledLocalBounds);
+			PackVector(Bounds, TempoWorldBounds.Min);
+			PackVector(Bounds, TempoWorldBounds.Max);
+			PackVector(LocalBounds, TempoLocalBounds.Min);
+			PackVector(LocalBounds, TempoLocalBounds.Max);
+		}
+	}
+
+	return Actors;
+}
+
+void UTempoWorldStateServiceSubsystem::SendWorldStateSnapshots(const WorldStateSnapshotRequest& Request, const TArray<TResponseDelegate<WorldStateSnapshot>>& ResponseContinuations)
+{
+	// The rows are shared by every continuation; only the ID table changes each is sent differ.
+	WorldStateSnapshot Rows;
+	const TArray<const AActor*> Actors = BuildWorldStateSnapshot(Request, Rows);
+	TSet<uint32> RowIds;
+	RowIds.Reserve(Actors.Num());
+	for (const uint32 Id : Rows.actor_ids())
+	{
+		RowIds.Add(Id);
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	for (const auto& ResponseContinuation : ResponseContinuations)
+	{
+		if (!ResponseContinuation.IsBound())
+		{
+			continue;
+		}
+
+		FTempoSnapshotSubscriber& Subscriber = SnapshotSubscribers.FindOrAdd(ResponseContinuation.GetHandle());
+		Subscriber.LastSeenTime = Now;
+
+		WorldStateSnapshot Response = Rows;
+		for (int32 Row = 0; Row < Actors.Num(); ++Row)
+		{
+			bool bAlreadyKnown = false;
+			Subscriber.KnownActorIds.Add(Rows.actor_ids(Row), &bAlreadyKnown);
+			if (!bAlreadyKnown)
+			{
+				AddSnapshotActor(Response, Rows.actor_ids(Row), Actors[Row]);
+			}
+		}
+		for (auto KnownIt = Subscriber.KnownActorIds.CreateIterator(); KnownIt; ++KnownIt)
+		{
+			if (!RowIds.Contains(*KnownIt))
+			{
+				Response.add_removed_actor_ids(*KnownIt);
+				KnownIt.RemoveCurrent();
+			}
+		}
+
+		ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
+	}
+}
+
 void UTempoWorldStateServiceSubsystem::StreamOverlapEvents(const OverlapEventRequest& Request, const TResponseDelegate<OverlapEventResponse>& ResponseContinuation)
 {
 	const FString ActorName(UTF8_TO_TCHAR(Request.actor().c_str()));
@@ -363,18 +744,449 @@ void UTempoWorldStateServiceSubsystem::OnActorOverlap(AActor* OverlappedActor, A
 			ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
 		}
 		PendingOverlapRequests.Remove(UTempoCoreUtils::GetActorIdentifier(OverlappedActor));
-		OverlappedActor->OnActorBeginOverlap.RemoveAll(this);
+		// Only this binding: the actor may also be watched by overlap batch streams.
+		OverlappedActor->OnActorBeginOverlap.RemoveDynamic(this, &UTempoWorldStateServiceSubsystem::OnActorOverlap);
+	}
+}
+
+void UTempoWorldStateServiceSubsystem::StreamOverlapEventBatches(const OverlapBatchRequest& Request, const TResponseDelegate<OverlapEventBatch>& ResponseContinuation)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// After the first message, a stream only asks for the next batch.
+	if (FTempoOverlapSubscriber* Subscriber = OverlapSubscribers.Find(ResponseContinuation.GetHandle()))
+	{
+		Subscriber->Continuation = ResponseContinuation;
+		Subscriber->LastSeenTime = Now;
+		return;
+	}
+
+	if (Request.actors_size() == 0 && Request.actor_classes_size() == 0 && Request.actor_tags_size() == 0)
+	{
+		ResponseContinuation.ExecuteIfBound(OverlapEventBatch(), grpc::Status(grpc::StatusCode::FAILED_PRECONDITION, "actors, actor_classes or actor_tags must be specified in StreamOverlapEventBatches request"));
+		return;
+	}
+
+	TArray<AActor*> NamedActors;
+	for (const std::string& Name : Request.actors())
+	{
+		const FString ActorName(UTF8_TO_TCHAR(Name.c_str()));
+		AActor* Actor = GetActorWithName(GetWorld(), ActorName);
+		if (!Actor)
+		{
+			const FString ErrorMsg = FString::Printf(TEXT("No actor with name '%s' found for StreamOverlapEventBatches request"), *ActorName);
+			ResponseContinuation.ExecuteIfBound(OverlapEventBatch(), grpc::Status(grpc::StatusCode::NOT_FOUND, std::string(TCHAR_TO_UTF8(*ErrorMsg))));
+			return;
+		}
+		NamedActors.Add(Actor);
+	}
+
+	FTempoOverlapSubscriber& Subscriber = OverlapSubscribers.Add(ResponseContinuation.GetHandle());
+	Subscriber.ActorClasses = ToNames(Request.actor_classes());
+	Subscriber.ActorTags = ToNames(Request.actor_tags());
+	Subscriber.OverlappingActorClasses = ToNames(Request.overlapping_actor_classes());
+	Subscriber.OverlappingActorTags = ToNames(Request.overlapping_actor_tags());
+	Subscriber.Continuation = ResponseContinuation;
+	Subscriber.LastSeenTime = Now;
+
+	for (AActor* Actor : NamedActors)
+	{
+		WatchActor(Subscriber, Actor);
+	}
+
+	if (Subscriber.ActorClasses.IsEmpty() && Subscriber.ActorTags.IsEmpty())
+	{
+		return;
+	}
+	for (TActorIterator<AActor> ActorIt(GetWorld()); ActorIt; ++ActorIt)
+	{
+		if (IsSelectedByClassOrTag(Subscriber, *ActorIt))
+		{
+			WatchActor(Subscriber, *ActorIt);
+		}
+	}
+	if (!ActorSpawnedHandle.IsValid())
+	{
+		ActorSpawnedHandle = GetWorld()->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UTempoWorldStateServiceSubsystem::OnActorSpawned));
+	}
+}
+
+void UTempoWorldStateServiceSubsystem::WatchActor(FTempoOverlapSubscriber& Subscriber, AActor* Actor)
+{
+	Subscriber.WatchedActors.Add(Actor);
+	Actor->OnActorBeginOverlap.AddUniqueDynamic(this, &UTempoWorldStateServiceSubsystem::OnWatchedActorBeginOverlap);
+	Actor->OnActorEndOverlap.AddUniqueDynamic(this, &UTempoWorldStateServiceSubsystem::OnWatchedActorEndOverlap);
+}
+
+void UTempoWorldStateServiceSubsystem::OnActorSpawned(AActor* Actor)
+{
+	for (TPair<FDelegateHandle, FTempoOverlapSubscriber>& Subscriber : OverlapSubscribers)
+	{
+		if (IsSelectedByClassOrTag(Subscriber.Value, Actor))
+		{
+			WatchActor(Subscriber.Value, Actor);
+		}
+	}
+}
+
+void UTempoWorldStateServiceSubsystem::OnWatchedActorBeginOverlap(AActor* OverlappedActor, AActor* OtherActor)
+{
+	AddOverlapEvent(OverlappedActor, OtherActor, true);
+}
+
+void UTempoWorldStateServiceSubsystem::OnWatchedActorEndOverlap(AActor* OverlappedActor, AActor* OtherActor)
+{
+	AddOverlapEvent(OverlappedActor, OtherActor, false);
+}
+
+void UTempoWorldStateServiceSubsystem::AddOverlapEvent(const AActor* OverlappedActor, const AActor* OtherActor, bool bBegin)
+{
+	if (!OverlappedActor || !OtherActor)
+	{
+		return;
+	}
+
+	for (TPair<FDelegateHandle, FTempoOverlapSubscriber>& SubscriberPair : OverlapSubscribers)
+	{
+		FTempoOverlapSubscriber& Subscriber = SubscriberPair.Value;
+		if (!Subscriber.WatchedActors.Contains(OverlappedActor) || !PassesOverlapFilters(Subscriber, OtherActor))
+		{
+			continue;
+		}
+
+		// Actors are interned now, rather than when the batch is sent, in case they are destroyed meanwhile
+		// (end events fire as actors are destroyed).
+		const auto Intern = [this, &Subscriber](const AActor* Actor)
+		{
+			const uint32 Id = GetSnapshotActorId(Actor);
+			bool bAlreadyKnown = false;
+			Subscriber.KnownActorIds.Add(Id, &bAlreadyKnown);
+			if (!bAlreadyKnown)
+			{
+				AddSnapshotActor(Subscriber.Pending, Id, Actor);
+			}
+			return Id;
+		};
+
+		TempoWorld::OverlapEvent* Event = Subscriber.Pending.add_events();
+		Event->set_overlapped_actor_id(Intern(OverlappedActor));
+		Event->set_overlapping_actor_id(Intern(OtherActor));
+		Event->set_begin(bBegin);
+	}
+}
+
+void UTempoWorldStateServiceSubsystem::SendOverlapEventBatches()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	for (TPair<FDelegateHandle, FTempoOverlapSubscriber>& SubscriberPair : OverlapSubscribers)
+	{
+		FTempoOverlapSubscriber& Subscriber = SubscriberPair.Value;
+		if (!Subscriber.Continuation.IsBound())
+		{
+			continue;
+		}
+		// A stream waiting for its next batch is still there, however long the batch takes to fill.
+		Subscriber.LastSeenTime = Now;
+		if (Subscriber.Pending.events_size() == 0)
+		{
+			continue;
+		}
+
+		OverlapEventBatch Batch = MoveTemp(Subscriber.Pending);
+		Subscriber.Pending.Clear();
+		Batch.set_timestamp_s(Now);
+
+		const TResponseDelegate<OverlapEventBatch> Continuation = Subscriber.Continuation;
+		Subscriber.Continuation.Unbind();
+		Continuation.ExecuteIfBound(Batch, grpc::Status_OK);
+	}
+}
+
+const FTempoTrackedActorState& UTempoWorldStateServiceSubsystem::SampleActorState(const AActor* Actor, const FTempoActorStateDeltaKey& Key)
+{
+	TMap<TObjectKey<AActor>, FTempoTrackedActorState>& Tracked = TrackedActorStates.FindOrAdd(Key);
+	FTempoTrackedActorState* TrackedState = Tracked.Find(Actor);
+	if (TrackedState && TrackedState->SampledTick == StreamTick)
+	{
+		return *TrackedState;
+	}
+
+	TempoWorld::ActorState Sample = GetActorState(Actor, GetWorld(), Key.bIncludeHiddenComponents);
+	if (!TrackedState)
+	{
+		TrackedState = &Tracked.Add(Actor);
+		TrackedState->Reference = Sample;
+		TrackedState->ChangedTick = StreamTick;
+	}
+	else if (ActorStateChanged(TrackedState->Reference, Sample, Key))
+	{
+		TrackedState->Reference = Sample;
+		TrackedState->ChangedTick = StreamTick;
+	}
+	TrackedState->Latest = MoveTemp(Sample);
+	TrackedState->SampledTick = StreamTick;
+
+	return *TrackedState;
+}
+
+bool UTempoWorldStateServiceSubsystem::NeedsKeyframe(const FTempoActorStateSubscriber& Subscriber, const ActorStateDeltaOptions& Options, double Now)
+{
+	const double KeyframeInterval = Options.keyframe_interval_s() > 0.0f ? Options.keyframe_interval_s() : DefaultKeyframeIntervalS;
+	return !Subscriber.bSentKeyframe || Now - Subscriber.LastKeyframeTime >= KeyframeInterval;
+}
+
+FTempoActorStateSubscriber& UTempoWorldStateServiceSubsystem::FindOrAddSubscriber(const FDelegateHandle& Handle, double Now)
+{
+	FTempoActorStateSubscriber& Subscriber = DeltaSubscribers.FindOrAdd(Handle);
+	Subscriber.LastSeenTime = Now;
+	return Subscriber;
+}
+
+void UTempoWorldStateServiceSubsystem::StreamActorStateDelta(const ActorStateRequest& Request, TArray<TResponseDelegate<ActorState>>& ResponseContinuations)
+{
+	const FString ActorName(UTF8_TO_TCHAR(Request.actor().c_str()));
+	const AActor* Actor = ActorName.IsEmpty() ? nullptr : GetActorWithName(GetWorld(), ActorName);
+	if (!Actor)
+	{
+		// Let the regular handler report the error, which ends the streams.
+		for (const auto& ResponseContinuation : ResponseContinuations)
+		{
+			GetCurrentActorState(Request, ResponseContinuation);
+		}
+		ResponseContinuations.Empty();
+		return;
+	}
+
+	const FTempoTrackedActorState& TrackedState = SampleActorState(Actor, MakeDeltaKey(Request.delta(), Request.include_hidden_components()));
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	ResponseContinuations.RemoveAll([this, &Request, &TrackedState, Now](const TResponseDelegate<ActorState>& ResponseContinuation)
+	{
+		if (!ResponseContinuation.IsBound())
+		{
+			return true;
+		}
+
+		FTempoActorStateSubscriber& Subscriber = FindOrAddSubscriber(ResponseContinuation.GetHandle(), Now);
+		const ActorState* Response = nullptr;
+		if (NeedsKeyframe(Subscriber, Request.delta(), Now))
+		{
+			Subscriber.bSentKeyframe = true;
+			Subscriber.LastKeyframeTime = Now;
+			Response = &TrackedState.Latest;
+		}
+		else if (TrackedState.ChangedTick > Subscriber.LastSentTick)
+		{
+			Response = &TrackedState.Reference;
+		}
+		else
+		{
+			// Nothing new. Hold the continuation until there is.
+			return false;
+		}
+
+		Subscriber.LastSentTick = StreamTick;
+		ResponseContinuation.ExecuteIfBound(*Response, grpc::Status_OK);
+		return true;
+	});
+}
+
+void UTempoWorldStateServiceSubsystem::StreamActorStatesNearDelta(const ActorStatesNearRequest& Request, TArray<TResponseDelegate<ActorStates>>& ResponseContinuations)
+{
+	// The query and the samples are shared by every continuation; only what each has been sent differs.
+	const TArray<AActor*> Actors = GetMatchingActors(GetWorld(), Request);
+	const FTempoActorStateDeltaKey Key = MakeDeltaKey(Request.delta(), Request.include_hidden_components());
+	for (const AActor* Actor : Actors)
+	{
+		SampleActorState(Actor, Key);
+	}
+
+	// Looked up after sampling, which may have grown the map.
+	const TMap<TObjectKey<AActor>, FTempoTrackedActorState>& Tracked = TrackedActorStates.FindChecked(Key);
+	TArray<TPair<TObjectKey<AActor>, const FTempoTrackedActorState*>> InRange;
+	InRange.Reserve(Actors.Num());
+	for (const AActor* Actor : Actors)
+	{
+		InRange.Emplace(Actor, &Tracked.FindChecked(Actor));
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	ResponseContinuations.RemoveAll([this, &Request, &InRange, Now](const TResponseDelegate<ActorStates>& ResponseContinuation)
+	{
+		if (!ResponseContinuation.IsBound())
+		{
+			return true;
+		}
+
+		FTempoActorStateSubscriber& Subscriber = FindOrAddSubscriber(ResponseContinuation.GetHandle(), Now);
+		const bool bKeyframe = NeedsKeyframe(Subscriber, Request.delta(), Now);
+
+		ActorStates Response;
+		Response.set_keyframe(bKeyframe);
+		TMap<TObjectKey<AActor>, FString> NowInRange;
+		NowInRange.Reserve(InRange.Num());
+		for (const TPair<TObjectKey<AActor>, const FTempoTrackedActorState*>& Entry : InRange)
+		{
+			const FTempoTrackedActorState& TrackedState = *Entry.Value;
+			const bool bEntered = Subscriber.InRange.Remove(Entry.Key) == 0;
+			if (bEntered)
+			{
+				Response.add_entered_actors(TrackedState.Latest.name());
+			}
+			if (bKeyframe)
+			{
+				*Response.add_actor_states() = TrackedState.Latest;
+			}
+			else if (bEntered || TrackedState.ChangedTick > Subscriber.LastSentTick)
+			{
+				*Response.add_actor_states() = TrackedState.Reference;
+			}
+			NowInRange.Add(Entry.Key, UTF8_TO_TCHAR(TrackedState.Latest.name().c_str()));
+		}
+		// Whatever is left was in range before and isn't now.
+		for (const TPair<TObjectKey<AActor>, FString>& Left : Subscriber.InRange)
+		{
+			Response.add_left_actors(TCHAR_TO_UTF8(*Left.Value));
+		}
+
+		Subscriber.InRange = MoveTemp(NowInRange);
+		if (!bKeyframe && Response.actor_states_size() == 0 && Response.left_actors_size() == 0)
+		{
+			// Nothing new. Hold the continuation until there is.
+			return false;
+		}
+
+		if (bKeyframe)
+		{
+			Subscriber.bSentKeyframe = true;
+			Subscriber.LastKeyframeTime = Now;
+		}
+		Subscriber.LastSentTick = StreamTick;
+		ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
+		return true;
+	});
+}
+
+void UTempoWorldStateServiceSubsystem::PruneStreamState(double Now)
+{
+	if (Now - LastStreamPruneTime < StreamPruneIntervalS)
+	{
+		return;
+	}
+
+	for (auto SubscriberIt = DeltaSubscribers.CreateIterator(); SubscriberIt; ++SubscriberIt)
+	{
+		if (Now - SubscriberIt->Value.LastSeenTime > StreamSubscriberTimeoutS)
+		{
+			SubscriberIt.RemoveCurrent();
+		}
+	}
+
+	// Samples not taken since the last prune belong to actors no stream is watching (or that no longer exist).
+	for (auto TrackedIt = TrackedActorStates.CreateIterator(); TrackedIt; ++TrackedIt)
+	{
+		for (auto ActorIt = TrackedIt->Value.CreateIterator(); ActorIt; ++ActorIt)
+		{
+			if (ActorIt->Value.SampledTick <= LastStreamPruneTick)
+			{
+				ActorIt.RemoveCurrent();
+			}
+		}
+		if (TrackedIt->Value.IsEmpty())
+		{
+			TrackedIt.RemoveCurrent();
+		}
+	}
+
+	for (auto SubscriberIt = SnapshotSubscribers.CreateIterator(); SubscriberIt; ++SubscriberIt)
+	{
+		if (Now - SubscriberIt->Value.LastSeenTime > StreamSubscriberTimeoutS)
+		{
+			SubscriberIt.RemoveCurrent();
+		}
+	}
+
+	TSet<TObjectKey<AActor>> UnwatchedActors;
+	for (auto SubscriberIt = OverlapSubscribers.CreateIterator(); SubscriberIt; ++SubscriberIt)
+	{
+		if (Now - SubscriberIt->Value.LastSeenTime > StreamSubscriberTimeoutS)
+		{
+			UnwatchedActors.Append(SubscriberIt->Value.WatchedActors);
+			SubscriberIt.RemoveCurrent();
+			continue;
+		}
+		for (auto WatchedIt = SubscriberIt->Value.WatchedActors.CreateIterator(); WatchedIt; ++WatchedIt)
+		{
+			if (!WatchedIt->ResolveObjectPtr())
+			{
+				WatchedIt.RemoveCurrent();
+			}
+		}
+	}
+	bool bAnyClassOrTagSubscribers = false;
+	for (const TPair<FDelegateHandle, FTempoOverlapSubscriber>& Subscriber : OverlapSubscribers)
+	{
+		UnwatchedActors = UnwatchedActors.Difference(Subscriber.Value.WatchedActors);
+		bAnyClassOrTagSubscribers |= !Subscriber.Value.ActorClasses.IsEmpty() || !Subscriber.Value.ActorTags.IsEmpty();
+	}
+	for (const TObjectKey<AActor>& Unwatched : UnwatchedActors)
+	{
+		if (AActor* Actor = Unwatched.ResolveObjectPtr())
+		{
+			Actor->OnActorBeginOverlap.RemoveDynamic(this, &UTempoWorldStateServiceSubsystem::OnWatchedActorBeginOverlap);
+			Actor->OnActorEndOverlap.RemoveDynamic(this, &UTempoWorldStateServiceSubsystem::OnWatchedActorEndOverlap);
+		}
+	}
+	if (!bAnyClassOrTagSubscribers && ActorSpawnedHandle.IsValid())
+	{
+		GetWorld()->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		ActorSpawnedHandle.Reset();
+	}
+
+	for (auto IdIt = SnapshotActorIds.CreateIterator(); IdIt; ++IdIt)
+	{
+		if (!IdIt->Key.ResolveObjectPtr())
+		{
+			IdIt.RemoveCurrent();
+		}
+	}
+
+	LastStreamPruneTime = Now;
+	LastStreamPruneTick = StreamTick;
+}
+
+int32 UTempoWorldStateServiceSubsystem::NumTrackedActorStates() const
+{
+	int32 NumTracked = 0;
+	for (const TPair<FTempoActorStateDeltaKey, TMap<TObjectKey<AActor>, FTempoTrackedActorState>>& Tracked : TrackedActorStates)
+	{
+		NumTracked += Tracked.Value.Num();
 	}
+	return NumTracked;
 }
 
 void UTempoWorldStateServiceSubsystem::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	++StreamTick;
+
 	for (auto ActorStatesRequestsIt = PendingActorStateRequests.CreateIterator(); ActorStatesRequestsIt; ++ActorStatesRequestsIt)
 	{
 		const ActorStateRequest Request = ActorStatesRequestsIt->Key;
-		const TArray<TResponseDelegate<TempoWorld::ActorState>>& ResponseContinuations = ActorStatesRequestsIt->Value;
+		TArray<TResponseDelegate<TempoWorld::ActorState>>& ResponseContinuations = ActorStatesRequestsIt->Value;
+
+		if (Request.has_delta())
+		{
+			StreamActorStateDelta(Request, ResponseContinuations);
+			if (ResponseContinuations.IsEmpty())
+			{
+				ActorStatesRequestsIt.RemoveCurrent();
+			}
+			continue;
+		}
 
 		for (const auto& ResponseContinuation : ResponseContinuations)
 		{
@@ -386,7 +1198,17 @@ void UTempoWorldStateServiceSubsystem::Tick(float DeltaTime)
 	for (auto ActorStatesNearRequestsIt = PendingActorStatesNearRequests.CreateIterator(); ActorStatesNearRequestsIt; ++ActorStatesNearRequestsIt)
 	{
 		const ActorStatesNearRequest Request = ActorStatesNearRequestsIt->Key;
-		const TArray<TResponseDelegate<TempoWorld::ActorStates>>& ResponseContinuations = ActorStatesNearRequestsIt->Value;
+		TArray<TResponseDelegate<TempoWorld::ActorStates>>& ResponseContinuations = ActorStatesNearRequestsIt->Value;
+
+		if (Request.has_delta())
+		{
+			StreamActorStatesNearDelta(Request, ResponseContinuations);
+			if (ResponseContinuations.IsEmpty())
+			{
+				ActorStatesNearRequestsIt.RemoveCurrent();
+			}
+			continue;
+		}
 
 		for (const auto& ResponseContinuation : ResponseContinuations)
 		{
@@ -394,6 +1216,17 @@ void UTempoWorldStateServiceSubsystem::Tick(float DeltaTime)
 		}
 		ActorStatesNearRequestsIt.RemoveCurrent();
 	}
+
+	// Every snapshot stream is answered each tick.
+	const TMap<WorldStateSnapshotRequest, TArray<TResponseDelegate<WorldStateSnapshot>>> SnapshotRequests = MoveTemp(PendingWorldStateSnapshotRequests);
+	for (const auto& SnapshotRequest : SnapshotRequests)
+	{
+		SendWorldStateSnapshots(SnapshotRequest.Key, SnapshotRequest.Value);
+	}
+
+	SendOverlapEventBatches();
+
+	PruneStreamState(GetWorld()->GetTimeSeconds());
 }
 
 void UTempoWorldStateServiceSubsystem::Raycast(
@@ -451,6 +1284,115 @@ void UTempoWorldStateServiceSubsystem::Raycast(
 	ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
 }
 
+void UTempoWorldStateServiceSubsystem::SceneQueries(
+	const SceneQueriesRequest& Request,
+	const TResponseDelegate<SceneQueriesResponse>& ResponseContinuation) const
+{
+	const UWorld* World = GetWorld();
+
+	// Name lookups and conversions happen here, on the game thread.
+	TArray<FPreparedSceneQuery> Queries;
+	Queries.Reserve(Request.queries_size());
+	for (const TempoWorld::SceneQuery& Query : Request.queries())
+	{
+		FPreparedSceneQuery& Prepared = Queries.Emplace_GetRef();
+		Prepared.Start = QuantityConverter<M2CM, R2L>::Convert(FVector(Query.start().x(), Query.start().y(), Query.start().z()));
+		Prepared.End = QuantityConverter<M2CM, R2L>::Convert(FVector(Query.end().x(), Query.end().y(), Query.end().z()));
+		if (Query.has_shape())
+		{
+			Prepared.Shape = ToUnrealShape(Query.shape());
+			const TempoCore::Rotation& Rotation = Query.shape().rotation();
+			Prepared.Rotation = QuantityConverter<Rad2Deg, R2L>::Convert(FRotator(Rotation.p(), Rotation.y(), Rotation.r())).Quaternion();
+		}
+		Prepared.Channel = ToUnrealChannel(Query.collision_channel());
+		Prepared.Params = FCollisionQueryParams(TEXT("WorldStateSceneQueries"));
+		for (const auto& ActorName : Query.ignored_actors())
+		{
+			if (const AActor* Actor = GetActorWithName(World, UTF8_TO_TCHAR(ActorName.c_str())))
+			{
+				Prepared.Params.AddIgnoredActor(Actor);
+			}
+		}
+		Prepared.bMulti = Query.multi();
+		Prepared.MaxHits = static_cast<int32>(FMath::Min<uint32>(Query.max_hits(), MAX_int32));
+	}
+
+	// Scene queries only read the physics scene (under its read lock), so they can run on worker threads
+	// while the game thread waits here. Sweeps with a line shape are line traces.
+	TArray<TArray<FHitResult>> Hits;
+	Hits.SetNum(Queries.Num());
+	ParallelFor(TEXT("WorldStateSceneQueries"), Queries.Num(), SceneQueryMinBatchSize, [World, &Queries, &Hits](int32 Index)
+	{
+		const FPreparedSceneQuery& Query = Queries[Index];
+		TArray<FHitResult>& QueryHits = Hits[Index];
+		if (Query.bMulti)
+		{
+			World->SweepMultiByChannel(QueryHits, Query.Start, Query.End, Query.Rotation, Query.Channel, Query.Shape, Query.Params);
+			if (Query.MaxHits > 0 && QueryHits.Num() > Query.MaxHits)
+			{
+				QueryHits.SetNum(Query.MaxHits);
+			}
+		}
+		else
+		{
+			FHitResult Hit;
+			if (World->SweepSingleByChannel(Hit, Query.Start, Query.End, Query.Rotation, Query.Channel, Query.Shape, Query.Params))
+			{
+				QueryHits.Add(MoveTemp(Hit));
+			}
+		}
+	});
+
+	SceneQueriesResponse Response;
+	Response.mutable_results()->Reserve(Hits.Num());
+	TMap<const AActor*, int32> ActorIndices;
+	TMap<const UPrimitiveComponent*, int32> ComponentIndices;
+	for (const TArray<FHitResult>& QueryHits : Hits)
+	{
+		TempoWorld::SceneQueryResult* Result = Response.add_results();
+		for (const FHitResult& Hit : QueryHits)
+		{
+			TempoWorld::SceneQueryHit* ResultHit = Result->add_hits();
+			SetProtoVector(*ResultHit->mutable_location(), QuantityConverter<CM2M, L2R>::Convert(Hit.ImpactPoint));
+			SetProtoVector(*ResultHit->mutable_normal(), QuantityConverter<UC_NONE, L2R>::Convert(Hit.ImpactNormal));
+			ResultHit->set_distance_m(Hit.Distance / 100.0f); // cm to m
+			ResultHit->set_blocking(Hit.bBlockingHit);
+
+			int32 ActorIndex = -1;
+			if (const AActor* Actor = Hit.GetActor())
+			{
+				if (const int32* Found = ActorIndices.Find(Actor))
+				{
+					ActorIndex = *Found;
+				}
+				else
+				{
+					ActorIndex = ActorIndices.Add(Actor, Response.actors_size());
+					Response.add_actors(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(Actor)));
+				}
+			}
+			ResultHit->set_actor_index(ActorIndex);
+
+			int32 ComponentIndex = -1;
+			if (const UPrimitiveComponent* Component = Hit.GetComponent())
+			{
+				if (const int32* Found = ComponentIndices.Find(Component))
+				{
+					ComponentIndex = *Found;
+				}
+				else
+				{
+					ComponentIndex = ComponentIndices.Add(Component, Response.components_size());
+					Response.add_components(TCHAR_TO_UTF8(*Component->GetName()));
+				}
+			}
+			ResultHit->set_component_index(ComponentIndex);
+		}
+	}
+
+	ResponseContinuation.ExecuteIfBound(Response, grpc::Status_OK);
+}
+
 TStatId UTempoWorldStateServiceSubsystem::GetStatId() const
 {
 	RETURN_QUICK_DECLARE_CYCLE_STAT(UTempoMapQueryServiceSubsystem, STATGROUP_Tickables);
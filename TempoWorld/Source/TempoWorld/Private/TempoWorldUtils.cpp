@@ -2,12 +2,24 @@
 
 #include "TempoWorldUtils.h"
 
+#include "TempoActorNameIndex.h"
 #include "TempoCoreUtils.h"
 
 #include "EngineUtils.h"
 
 AActor* GetActorWithName(const UWorld* World, const FString& Name)
 {
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	if (UTempoActorNameIndex* ActorNameIndex = World->GetSubsystem<UTempoActorNameIndex>())
+	{
+		return ActorNameIndex->FindActor(Name);
+	}
+
+	// Worlds without an index (e.g. editor previews) fall back to a scan.
 	for (TActorIterator<AActor> ActorIt(World); ActorIt; ++ActorIt)
 	{
 		if (UTempoCoreUtils::GetActorIdentifier(*ActorIt).Equals(Name, ESearchCase::IgnoreCase))
@@ -41,3 +53,15 @@ UObject* GetAssetByPath(const FString& AssetPath)
 
 	return nullptr;
 }
+
+void MarkRenderStateDirty(UObject* Object)
+{
+	if (AActor* Actor = Cast<AActor>(Object))
+	{
+		Actor->MarkComponentsRenderStateDirty();
+	}
+	else if (USceneComponent* SceneComponent = Cast<USceneComponent>(Object))
+	{
+		SceneComponent->MarkRenderStateDirty();
+	}
+}
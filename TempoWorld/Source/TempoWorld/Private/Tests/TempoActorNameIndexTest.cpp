@@ -0,0 +1,171 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoActorNameIndex.h"
+#include "TempoWorldControlServiceSubsystem.h"
+#include "TempoWorldUtils.h"
+
+#include "TempoWorld/WorldControl.grpc.pb.h"
+
+#include "TempoCoreUtils.h"
+#include "TempoTestWorld.h"
+
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+
+// Tests for UTempoActorNameIndex, the name->actor index behind GetActorWithName, plus a benchmark of
+// SetActorTransform latency against actor count with the old linear scan as a baseline. Run with
+//   Automation RunTests Tempo.World.ActorNameIndex
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoActorNameIndexTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	struct FActorNameIndexTestFixture : FTempoTestWorld
+	{
+		AActor* SpawnNamed(const FName& Name) const
+		{
+			FActorSpawnParameters SpawnParameters;
+			SpawnParameters.Name = Name;
+			return World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+		}
+	};
+
+	// GetActorWithName as it was before the index, for comparison.
+	AActor* ScanForActorWithName(const UWorld* World, const FString& Name)
+	{
+		for (TActorIterator<AActor> ActorIt(World); ActorIt; ++ActorIt)
+		{
+			if (UTempoCoreUtils::GetActorIdentifier(*ActorIt).Equals(Name, ESearchCase::IgnoreCase))
+			{
+				return *ActorIt;
+			}
+		}
+		return nullptr;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoActorNameIndexLookupTest,
+	"Tempo.World.ActorNameIndex.Lookup", TempoActorNameIndexTestFlags)
+bool FTempoActorNameIndexLookupTest::RunTest(const FString& Parameters)
+{
+	const FActorNameIndexTestFixture Fixture;
+	UTempoActorNameIndex* Index = Fixture.World->GetSubsystem<UTempoActorNameIndex>();
+	if (!TestNotNull(TEXT("Game worlds have an actor name index"), Index))
+	{
+		return false;
+	}
+
+	AActor* Alpha = Fixture.SpawnNamed(TEXT("IndexTestAlpha"));
+	TestEqual(TEXT("Finds an actor spawned before the index was built"), GetActorWithName(Fixture.World, TEXT("IndexTestAlpha")), Alpha);
+	TestEqual(TEXT("Lookup ignores case"), GetActorWithName(Fixture.World, TEXT("indextestALPHA")), Alpha);
+	TestNull(TEXT("Unknown names are not found"), GetActorWithName(Fixture.World, TEXT("IndexTestNoSuchActor")));
+
+	const int32 NumIndexedBefore = Index->NumIndexedActors();
+	AActor* Beta = Fixture.SpawnNamed(TEXT("IndexTestBeta"));
+	TestEqual(TEXT("Spawned actors are indexed"), Index->NumIndexedActors(), NumIndexedBefore + 1);
+	TestEqual(TEXT("Finds a newly spawned actor"), GetActorWithName(Fixture.World, TEXT("IndexTestBeta")), Beta);
+	TestEqual(TEXT("Finds an actor by its identifier"), GetActorWithName(Fixture.World, UTempoCoreUtils::GetActorIdentifier(Beta)), Beta);
+
+	Beta->Destroy();
+	TestEqual(TEXT("Destroyed actors are removed"), Index->NumIndexedActors(), NumIndexedBefore);
+	TestNull(TEXT("Destroyed actors are not found"), GetActorWithName(Fixture.World, TEXT("IndexTestBeta")));
+
+	// A deferred spawn reports nothing until it finishes, but is still found.
+	AActor* Deferred = Fixture.World->SpawnActorDeferred<AActor>(AActor::StaticClass(), FTransform::Identity);
+	TestEqual(TEXT("Finds an unfinished deferred spawn"), GetActorWithName(Fixture.World, Deferred->GetName()), Deferred);
+	Deferred->FinishSpawning(FTransform::Identity);
+	TestEqual(TEXT("Finds a finished deferred spawn"), GetActorWithName(Fixture.World, Deferred->GetName()), Deferred);
+
+#if WITH_EDITOR
+	Alpha->SetActorLabel(TEXT("IndexTestRelabeled"));
+	TestEqual(TEXT("Finds an actor by its new label"), GetActorWithName(Fixture.World, TEXT("IndexTestRelabeled")), Alpha);
+	TestEqual(TEXT("Still finds the actor by its FName"), GetActorWithName(Fixture.World, TEXT("IndexTestAlpha")), Alpha);
+
+	// An actor's identifier wins over another actor's FName, whichever was indexed first.
+	AActor* Gamma = Fixture.SpawnNamed(TEXT("IndexTestGamma"));
+	AActor* Delta = Fixture.SpawnNamed(TEXT("IndexTestDelta"));
+	Delta->SetActorLabel(TEXT("IndexTestGamma"));
+	TestEqual(TEXT("An identifier match shadows an FName match"), GetActorWithName(Fixture.World, TEXT("IndexTestGamma")), Delta);
+	Delta->SetActorLabel(TEXT("IndexTestRelabeledDelta"));
+	TestEqual(TEXT("The FName matches once no identifier does"), GetActorWithName(Fixture.World, TEXT("IndexTestGamma")), Gamma);
+#endif
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoActorNameIndexBenchmarkTest,
+	"Tempo.World.ActorNameIndex.SetActorTransformLatency", TempoActorNameIndexTestFlags)
+bool FTempoActorNameIndexBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumCalls = 500;
+	const int32 ActorCounts[] = { 100, 1000, 10000 };
+
+	for (const int32 NumActors : ActorCounts)
+	{
+		const FActorNameIndexTestFixture Fixture;
+		const UTempoWorldControlServiceSubsystem* WorldControl = Fixture.World->GetSubsystem<UTempoWorldControlServiceSubsystem>();
+		if (!TestNotNull(TEXT("Game worlds have a world control service"), WorldControl))
+		{
+			return false;
+		}
+
+		TArray<std::string> Names;
+		for (int32 I = 0; I < NumActors; ++I)
+		{
+			const AActor* Actor = Fixture.SpawnNamed(FName(TEXT("BenchActor"), I + 1));
+			Names.Add(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(Actor)));
+		}
+
+		// Touch actors spread across the world, as a client updating a subset would.
+		TArray<int32> Targets;
+		FRandomStream Random(NumActors);
+		for (int32 I = 0; I < NumCalls; ++I)
+		{
+			Targets.Add(Random.RandRange(0, NumActors - 1));
+		}
+
+		int32 NumFailed = 0;
+		const TResponseDelegate<TempoCore::Empty> Continuation = TResponseDelegate<TempoCore::Empty>::CreateLambda(
+			[&NumFailed](const TempoCore::Empty&, grpc::Status Status)
+			{
+				NumFailed += !Status.ok();
+			});
+
+		TempoWorld::SetActorTransformRequest Request;
+		Request.mutable_transform()->mutable_location()->set_x(1.0);
+
+		// Warm up (builds the index).
+		Request.set_actor(Names[0]);
+		WorldControl->SetActorTransform(Request, Continuation);
+
+		double Start = FPlatformTime::Seconds();
+		for (const int32 Target : Targets)
+		{
+			Request.set_actor(Names[Target]);
+			WorldControl->SetActorTransform(Request, Continuation);
+		}
+		const double IndexedSeconds = FPlatformTime::Seconds() - Start;
+
+		int32 NumScanMisses = 0;
+		Start = FPlatformTime::Seconds();
+		for (const int32 Target : Targets)
+		{
+			NumScanMisses += ScanForActorWithName(Fixture.World, UTF8_TO_TCHAR(Names[Target].c_str())) == nullptr;
+		}
+		const double ScanSeconds = FPlatformTime::Seconds() - Start;
+
+		TestEqual(*FString::Printf(TEXT("All SetActorTransform calls succeed with %d actors"), NumActors), NumFailed, 0);
+		TestEqual(TEXT("The baseline scan finds every actor"), NumScanMisses, 0);
+		AddInfo(FString::Printf(TEXT("%5d actors: SetActorTransform %.2f us/call; linear-scan lookup alone %.2f us/call"),
+			NumActors, IndexedSeconds * 1e6 / NumCalls, ScanSeconds * 1e6 / NumCalls));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,245 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoActorPool.h"
+#include "TempoWorldControlServiceSubsystem.h"
+#include "TempoWorldUtils.h"
+#include "TempoTestWorld.h"
+
+#include "TempoWorld/WorldControl.grpc.pb.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+
+// Tests for actor pooling in SpawnActor and DestroyActor: recycling, renaming, caps and stats, snapshot restores,
+// and the time per spawn/destroy cycle with and without a pool. Run with
+//   Automation RunTests Tempo.World.ActorPool
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoActorPoolTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	struct FActorPoolTestFixture : FTempoTestWorld
+	{
+		UTempoWorldControlServiceSubsystem* WorldControl = nullptr;
+
+		FActorPoolTestFixture()
+		{
+			WorldControl = World->GetSubsystem<UTempoWorldControlServiceSubsystem>();
+		}
+
+		TempoWorld::ActorPoolStats Configure(const char* ActorType, uint32 MaxSize, uint32 Prewarm = 0) const
+		{
+			TempoWorld::ConfigureActorPoolRequest Request;
+			Request.set_actor_type(ActorType);
+			Request.set_max_size(MaxSize);
+			Request.set_prewarm(Prewarm);
+			TempoWorld::ActorPoolStats Stats;
+			WorldControl->ConfigureActorPool(Request, TResponseDelegate<TempoWorld::ActorPoolStats>::CreateLambda(
+				[&Stats](const TempoWorld::ActorPoolStats& Response, grpc::Status)
+				{
+					Stats = Response;
+				}));
+			return Stats;
+		}
+
+		// Returns the new actor's name, or an empty string if the spawn failed.
+		FString Spawn(const char* ActorType, double X) const
+		{
+			TempoWorld::SpawnActorRequest Request;
+			Request.set_actor_type(ActorType);
+			Request.mutable_transform()->mutable_location()->set_x(X);
+			FString Name;
+			WorldControl->SpawnActor(Request, TResponseDelegate<TempoWorld::SpawnActorResponse>::CreateLambda(
+				[&Name](const TempoWorld::SpawnActorResponse& Response, grpc::Status Status)
+				{
+					if (Status.ok())
+					{
+						Name = UTF8_TO_TCHAR(Response.name().c_str());
+					}
+				}));
+			return Name;
+		}
+
+		void Destroy(const FString& Name) const
+		{
+			TempoWorld::DestroyActorRequest Request;
+			Request.set_actor(TCHAR_TO_UTF8(*Name));
+			WorldControl->DestroyActor(Request, TResponseDelegate<TempoCore::Empty>());
+		}
+
+		bool IsListed(const FString& Name) const
+		{
+			bool bListed = false;
+			WorldControl->GetAllActors(TempoCore::Empty(), TResponseDelegate<TempoWorld::GetAllActorsResponse>::CreateLambda(
+				[&bListed, &Name](const TempoWorld::GetAllActorsResponse& Response, grpc::Status)
+				{
+					for (const TempoWorld::ActorDescriptor& Actor : Response.actors())
+					{
+						bListed |= Name.Equals(UTF8_TO_TCHAR(Actor.name().c_str()), ESearchCase::IgnoreCase);
+					}
+				}));
+			return bListed;
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoActorPoolRecycleTest,
+	"Tempo.World.ActorPool.Recycle", TempoActorPoolTestFlags)
+bool FTempoActorPoolRecycleTest::RunTest(const FString& Parameters)
+{
+	const FActorPoolTestFixture Fixture;
+	if (!TestNotNull(TEXT("Game worlds have a world control service"), Fixture.WorldControl) ||
+		!TestNotNull(TEXT("Game worlds have an actor pool"), Fixture.World->GetSubsystem<UTempoActorPool>()))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("Configuring reports the pool's cap"), Fixture.Configure("DefaultPawn", 2).max_size(), 2u);
+
+	const FString FirstName = Fixture.Spawn("DefaultPawn", 0.0);
+	AActor* First = GetActorWithName(Fixture.World, FirstName);
+	if (!TestNotNull(TEXT("The first spawn succeeds"), First))
+	{
+		return false;
+	}
+
+	Fixture.Destroy(FirstName);
+	TestTrue(TEXT("A pooled actor stays alive"), IsValid(First));
+	TestTrue(TEXT("A pooled actor is hidden"), First->IsHidden());
+	TestFalse(TEXT("A pooled actor has no collision"), First->GetActorEnableCollision());
+	TestNull(TEXT("A pooled actor can't be found by its old name"), GetActorWithName(Fixture.World, FirstName));
+	TestFalse(TEXT("A pooled actor isn't listed"), Fixture.IsListed(First->GetName()));
+
+	const FString SecondName = Fixture.Spawn("DefaultPawn", 10.0);
+	TestTrue(TEXT("The next spawn recycles the pooled actor"), GetActorWithName(Fixture.World, SecondName) == First);
+	TestFalse(TEXT("A recycled actor gets a new name"), SecondName.Equals(FirstName, ESearchCase::IgnoreCase));
+	TestFalse(TEXT("A recycled actor is visible again"), First->IsHidden());
+	TestTrue(TEXT("A recycled actor has collision again"), First->GetActorEnableCollision());
+	TestEqual(TEXT("A recycled actor is moved to its spawn location"), First->GetActorLocation().X, 1000.0);
+	TestTrue(TEXT("A recycled actor is listed"), Fixture.IsListed(SecondName));
+
+	// Fill the pool past its cap.
+	TArray<FString> Names = { SecondName, Fixture.Spawn("DefaultPawn", 0.0), Fixture.Spawn("DefaultPawn", 0.0) };
+	TArray<AActor*> Actors;
+	for (const FString& Name : Names)
+	{
+		Actors.Add(GetActorWithName(Fixture.World, Name));
+		Fixture.Destroy(Name);
+	}
+	TestTrue(TEXT("Actors beyond the cap are destroyed"), !IsValid(Actors[2]) || Actors[2]->IsActorBeingDestroyed());
+
+	const TempoWorld::ActorPoolStats Stats = Fixture.Configure("DefaultPawn", 2);
+	TestEqual(TEXT("The pool is full"), Stats.num_pooled(), 2u);
+	TestEqual(TEXT("One spawn was a hit"), static_cast<uint64>(Stats.hits()), static_cast<uint64>(1));
+	TestEqual(TEXT("Three spawns were misses"), static_cast<uint64>(Stats.misses()), static_cast<uint64>(3));
+	TestEqual(TEXT("Three destroys were pooled"), static_cast<uint64>(Stats.releases()), static_cast<uint64>(3));
+	TestEqual(TEXT("One destroy found the pool full"), static_cast<uint64>(Stats.refusals()), static_cast<uint64>(1));
+	TestEqual(TEXT("The hit rate is hits over spawns"), Stats.hit_rate(), 0.25);
+	TestTrue(TEXT("Pooled actors' memory is estimated"), Stats.estimated_memory_bytes() > 0);
+
+	TestEqual(TEXT("Disabling a pool empties it"), Fixture.Configure("DefaultPawn", 0).num_pooled(), 0u);
+	const FString Unpooled = Fixture.Spawn("DefaultPawn", 0.0);
+	AActor* UnpooledActor = GetActorWithName(Fixture.World, Unpooled);
+	Fixture.Destroy(Unpooled);
+	TestTrue(TEXT("Disabled pools don't keep actors"), !IsValid(UnpooledActor) || UnpooledActor->IsActorBeingDestroyed());
+
+	const TempoWorld::ActorPoolStats Prewarmed = Fixture.Configure("DefaultPawn", 8, 5);
+	TestEqual(TEXT("Prewarming fills the pool"), Prewarmed.num_pooled(), 5u);
+	TestEqual(TEXT("Prewarming is not counted as releases"), static_cast<uint64>(Prewarmed.releases()), static_cast<uint64>(3));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoActorPoolSnapshotTest,
+	"Tempo.World.ActorPool.SnapshotRestore", TempoActorPoolTestFlags)
+bool FTempoActorPoolSnapshotTest::RunTest(const FString& Parameters)
+{
+	const FActorPoolTestFixture Fixture;
+	const UTempoActorPool* ActorPool = Fixture.World->GetSubsystem<UTempoActorPool>();
+	if (!TestNotNull(TEXT("Game worlds have a world control service"), Fixture.WorldControl) ||
+		!TestNotNull(TEXT("Game worlds have an actor pool"), ActorPool))
+	{
+		return false;
+	}
+
+	Fixture.Configure("DefaultPawn", 2);
+	const FString Name = Fixture.Spawn("DefaultPawn", 5.0);
+	AActor* Actor = GetActorWithName(Fixture.World, Name);
+	if (!TestNotNull(TEXT("The spawn succeeds"), Actor))
+	{
+		return false;
+	}
+
+	TempoWorld::SaveWorldSnapshotRequest SaveRequest;
+	SaveRequest.set_name("BeforePooling");
+	Fixture.WorldControl->SaveWorldSnapshot(SaveRequest, TResponseDelegate<TempoWorld::SaveWorldSnapshotResponse>());
+	Fixture.Destroy(Name);
+	if (!TestTrue(TEXT("The destroyed actor is pooled"), ActorPool->IsPooled(Actor)))
+	{
+		return false;
+	}
+
+	TempoWorld::RestoreWorldSnapshotRequest RestoreRequest;
+	RestoreRequest.set_name("BeforePooling");
+	Fixture.WorldControl->RestoreWorldSnapshot(RestoreRequest, TResponseDelegate<TempoWorld::RestoreWorldSnapshotResponse>());
+	TestFalse(TEXT("A restore takes the actor back out of its pool"), ActorPool->IsPooled(Actor));
+	TestFalse(TEXT("A restored actor is visible"), Actor->IsHidden());
+	TestTrue(TEXT("A restored actor has collision"), Actor->GetActorEnableCollision());
+	TestTrue(TEXT("A restored actor is found by its saved name"), GetActorWithName(Fixture.World, Name) == Actor);
+	TestTrue(TEXT("A restored actor is listed"), Fixture.IsListed(Name));
+	TestEqual(TEXT("A restored actor is at its saved location"), Actor->GetActorLocation().X, 500.0);
+	TestEqual(TEXT("A restored actor no longer counts as pooled"), Fixture.Configure("DefaultPawn", 2).num_pooled(), 0u);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoActorPoolChurnTest,
+	"Tempo.World.ActorPool.Churn", TempoActorPoolTestFlags)
+bool FTempoActorPoolChurnTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumActors = 50;
+	constexpr int32 NumRounds = 20;
+
+	const auto TimeChurn = [](const FActorPoolTestFixture& Fixture)
+	{
+		TArray<FString> Names;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Round = 0; Round < NumRounds; ++Round)
+		{
+			for (int32 ActorIndex = 0; ActorIndex < NumActors; ++ActorIndex)
+			{
+				Names.Add(Fixture.Spawn("DefaultPawn", ActorIndex * 10.0));
+			}
+			for (const FString& Name : Names)
+			{
+				Fixture.Destroy(Name);
+			}
+			Names.Reset();
+		}
+		return (FPlatformTime::Seconds() - StartTime) / (NumRounds * NumActors);
+	};
+
+	double UnpooledSeconds;
+	{
+		const FActorPoolTestFixture Fixture;
+		UnpooledSeconds = TimeChurn(Fixture);
+	}
+
+	const FActorPoolTestFixture Fixture;
+	Fixture.Configure("DefaultPawn", NumActors, NumActors);
+	const double PooledSeconds = TimeChurn(Fixture);
+	const TempoWorld::ActorPoolStats Stats = Fixture.Configure("DefaultPawn", NumActors);
+
+	TestEqual(TEXT("Every spawn after prewarming is a hit"), Stats.hit_rate(), 1.0);
+	AddInfo(FString::Printf(TEXT("Spawn/destroy cycle of DefaultPawn: %.1f us unpooled, %.1f us pooled (%.1fx), %.1f KB per pooled actor"),
+		UnpooledSeconds * 1e6, PooledSeconds * 1e6, UnpooledSeconds / FMath::Max(PooledSeconds, 1e-9),
+		Stats.estimated_memory_bytes() / 1024.0 / FMath::Max(Stats.num_pooled(), 1u)));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
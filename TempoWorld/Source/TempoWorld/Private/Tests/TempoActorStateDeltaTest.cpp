@@ -0,0 +1,333 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoWorldStateServiceSubsystem.h"
+
+#include "TempoCoreUtils.h"
+#include "TempoTestWorld.h"
+
+#include "TempoWorld/WorldState.grpc.pb.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+// Tests for delta-mode StreamActorState and StreamActorStatesNear: tolerances, enter and leave events,
+// keyframes, shared samples, and the bytes saved on a mostly parked scene. Run with
+//   Automation RunTests Tempo.World.ActorStateDelta
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoActorStateDeltaTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	struct FActorStateDeltaTestFixture : FTempoTestWorld
+	{
+		// A movable actor at X meters along the X axis.
+		AActor* SpawnMovableActor(double X) const
+		{
+			AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(FVector(X * 100.0, 0.0, 0.0), FRotator::ZeroRotator);
+			Actor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+			return Actor;
+		}
+	};
+
+	// Stands in for one client stream: the messages it received, and whether its continuation is parked.
+	template <typename ResponseType>
+	struct TTestStream
+	{
+		TArray<ResponseType> Received;
+		bool bPending = false;
+		TResponseDelegate<ResponseType> Continuation;
+
+		TTestStream()
+		{
+			Continuation = TResponseDelegate<ResponseType>::CreateLambda([this](const ResponseType& Response, grpc::Status)
+			{
+				Received.Add(Response);
+				bPending = false;
+			});
+		}
+
+		TTestStream(const TTestStream&) = delete;
+		TTestStream& operator=(const TTestStream&) = delete;
+	};
+
+	using FActorStatesStream = TTestStream<TempoWorld::ActorStates>;
+	using FActorStateStream = TTestStream<TempoWorld::ActorState>;
+
+	// Ticks the subsystem, then re-subscribes every stream that was answered. Returns how many were.
+	int32 Pump(UTempoWorldStateServiceSubsystem* WorldState, const TempoWorld::ActorStatesNearRequest& Request, const TArray<FActorStatesStream*>& Streams)
+	{
+		for (FActorStatesStream* Stream : Streams)
+		{
+			if (!Stream->bPending)
+			{
+				Stream->bPending = true;
+				WorldState->StreamActorStatesNear(Request, Stream->Continuation);
+			}
+		}
+		WorldState->Tick(0.1f);
+		int32 NumAnswered = 0;
+		for (const FActorStatesStream* Stream : Streams)
+		{
+			NumAnswered += !Stream->bPending;
+		}
+		return NumAnswered;
+	}
+
+	TSet<FString> StateNames(const TempoWorld::ActorStates& States)
+	{
+		TSet<FString> Names;
+		for (const TempoWorld::ActorState& State : States.actor_states())
+		{
+			Names.Add(UTF8_TO_TCHAR(State.name().c_str()));
+		}
+		return Names;
+	}
+
+	TSet<FString> NameSet(const google::protobuf::RepeatedPtrField<std::string>& Field)
+	{
+		TSet<FString> Names;
+		for (const std::string& Name : Field)
+		{
+			Names.Add(UTF8_TO_TCHAR(Name.c_str()));
+		}
+		return Names;
+	}
+
+	bool SameNames(const TSet<FString>& Actual, const TSet<FString>& Expected)
+	{
+		return Actual.Num() == Expected.Num() && Actual.Includes(Expected);
+	}
+
+	TempoWorld::ActorStatesNearRequest MakeNearRequest(const AActor* NearActor, float RadiusM, bool bDelta)
+	{
+		TempoWorld::ActorStatesNearRequest Request;
+		Request.set_near_actor(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(NearActor)));
+		Request.set_search_radius_m(RadiusM);
+		Request.set_include_static(true);
+		if (bDelta)
+		{
+			Request.mutable_delta()->set_position_tolerance_m(0.1f);
+			Request.mutable_delta()->set_rotation_tolerance_deg(1.0f);
+		}
+		return Request;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoActorStateDeltaNearTest,
+	"Tempo.World.ActorStateDelta.Near", TempoActorStateDeltaTestFlags)
+bool FTempoActorStateDeltaNearTest::RunTest(const FString& Parameters)
+{
+	const FActorStateDeltaTestFixture Fixture;
+	UTempoWorldStateServiceSubsystem* WorldState = Fixture.World->GetSubsystem<UTempoWorldStateServiceSubsystem>();
+	if (!TestNotNull(TEXT("Game worlds have a world state service"), WorldState))
+	{
+		return false;
+	}
+
+	AActor* Center = Fixture.SpawnMovableActor(0.0);
+	AActor* Near = Fixture.SpawnMovableActor(10.0);
+	AActor* Far = Fixture.SpawnMovableActor(100.0);
+	const FString CenterName = UTempoCoreUtils::GetActorIdentifier(Center);
+	const FString NearName = UTempoCoreUtils::GetActorIdentifier(Near);
+	const FString FarName = UTempoCoreUtils::GetActorIdentifier(Far);
+
+	const TempoWorld::ActorStatesNearRequest Request = MakeNearRequest(Center, 50.0f, true);
+	FActorStatesStream First;
+	TArray<FActorStatesStream*> Streams = { &First };
+
+	TestEqual(TEXT("New stream is answered"), Pump(WorldState, Request, Streams), 1);
+	const TempoWorld::ActorStates& Keyframe = First.Received.Last();
+	TestTrue(TEXT("First message is a keyframe"), Keyframe.keyframe());
+	TestEqual(TEXT("Keyframe holds every actor in range"), StateNames(Keyframe).Num(), 2);
+	TestTrue(TEXT("Keyframe reports the actors in range as entered"), SameNames(NameSet(Keyframe.entered_actors()), { CenterName, NearName }));
+
+	TestEqual(TEXT("Nothing is sent while nothing changes"), Pump(WorldState, Request, Streams), 0);
+
+	Near->SetActorLocation(FVector(1001.0, 0.0, 0.0));
+	TestEqual(TEXT("Moves within tolerance are not sent"), Pump(WorldState, Request, Streams), 0);
+
+	Near->SetActorLocation(FVector(1100.0, 0.0, 0.0));
+	Center->SetActorRotation(FRotator(0.0, 0.5, 0.0));
+	if (TestEqual(TEXT("Moves beyond tolerance are sent"), Pump(WorldState, Request, Streams), 1))
+	{
+		const TempoWorld::ActorStates& Delta = First.Received.Last();
+		TestFalse(TEXT("Delta is not a keyframe"), Delta.keyframe());
+		TestTrue(TEXT("Delta holds only the changed actor"), SameNames(StateNames(Delta), { NearName }));
+		TestEqual(TEXT("Delta carries the new location"), Delta.actor_states(0).transform().location().x(), 11.0, 1e-4);
+	}
+
+	// Rotations accumulate against what was last sent, not the previous tick.
+	Center->SetActorRotation(FRotator(0.0, 1.5, 0.0));
+	if (TestEqual(TEXT("Rotation beyond tolerance is sent"), Pump(WorldState, Request, Streams), 1))
+	{
+		TestTrue(TEXT("Rotation delta holds only the rotated actor"), SameNames(StateNames(First.Received.Last()), { CenterName }));
+	}
+
+	Far->SetActorLocation(FVector(2000.0, 0.0, 0.0));
+	if (TestEqual(TEXT("Actor coming into range is sent"), Pump(WorldState, Request, Streams), 1))
+	{
+		const TempoWorld::ActorStates& Entered = First.Received.Last();
+		TestTrue(TEXT("Enter event names the actor"), SameNames(NameSet(Entered.entered_actors()), { FarName }));
+		TestTrue(TEXT("Entered actor's state is sent"), SameNames(StateNames(Entered), { FarName }));
+	}
+
+	// A late subscriber starts from a keyframe while the first stream carries on with deltas, from the
+	// same samples.
+	FActorStatesStream Second;
+	Streams.Add(&Second);
+	const int32 NumTrackedBefore = WorldState->NumTrackedActorStates();
+	Near->Destroy();
+	TestEqual(TEXT("Both streams are answered"), Pump(WorldState, Request, Streams), 2);
+	TestEqual(TEXT("Streams with the same tolerances share samples"), WorldState->NumTrackedActorStates(), NumTrackedBefore);
+	const TempoWorld::ActorStates& Left = First.Received.Last();
+	TestFalse(TEXT("Existing stream gets a delta"), Left.keyframe());
+	TestTrue(TEXT("Leave event names the destroyed actor"), SameNames(NameSet(Left.left_actors()), { NearName }));
+	TestEqual(TEXT("Leave alone carries no states"), Left.actor_states_size(), 0);
+	TestTrue(TEXT("New stream gets a keyframe"), Second.Received.Last().keyframe());
+	TestTrue(TEXT("New stream's keyframe holds every actor in range"), SameNames(StateNames(Second.Received.Last()), { CenterName, FarName }));
+
+	Fixture.World->TimeSeconds += 6.0;
+	TestEqual(TEXT("Keyframes recur"), Pump(WorldState, Request, Streams), 2);
+	TestTrue(TEXT("Periodic message is a keyframe"), First.Received.Last().keyframe());
+	TestTrue(TEXT("Periodic keyframe holds every actor in range"), SameNames(StateNames(First.Received.Last()), { CenterName, FarName }));
+	TestEqual(TEXT("Unchanged membership raises no events"), First.Received.Last().entered_actors_size() + First.Received.Last().left_actors_size(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoActorStateDeltaSingleActorTest,
+	"Tempo.World.ActorStateDelta.SingleActor", TempoActorStateDeltaTestFlags)
+bool FTempoActorStateDeltaSingleActorTest::RunTest(const FString& Parameters)
+{
+	const FActorStateDeltaTestFixture Fixture;
+	UTempoWorldStateServiceSubsystem* WorldState = Fixture.World->GetSubsystem<UTempoWorldStateServiceSubsystem>();
+	if (!TestNotNull(TEXT("Game worlds have a world state service"), WorldState))
+	{
+		return false;
+	}
+
+	AActor* Actor = Fixture.SpawnMovableActor(0.0);
+	TempoWorld::ActorStateRequest Request;
+	Request.set_actor(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(Actor)));
+	Request.mutable_delta()->set_rotation_tolerance_deg(5.0f);
+
+	FActorStateStream Stream;
+	auto PumpSingle = [WorldState, &Request, &Stream]()
+	{
+		const int32 NumBefore = Stream.Received.Num();
+		if (!Stream.bPending)
+		{
+			Stream.bPending = true;
+			WorldState->StreamActorState(Request, Stream.Continuation);
+		}
+		WorldState->Tick(0.1f);
+		return Stream.Received.Num() - NumBefore;
+	};
+
+	TestEqual(TEXT("First tick sends the state"), PumpSingle(), 1);
+	TestEqual(TEXT("Unchanged actor sends nothing"), PumpSingle(), 0);
+	Actor->SetActorRotation(FRotator(0.0, 3.0, 0.0));
+	TestEqual(TEXT("Rotation within tolerance sends nothing"), PumpSingle(), 0);
+	Actor->SetActorRotation(FRotator(0.0, 10.0, 0.0));
+	if (TestEqual(TEXT("Rotation beyond tolerance is sent"), PumpSingle(), 1))
+	{
+		TestEqual(TEXT("Sent state carries the new yaw"), FMath::Abs(Stream.Received.Last().transform().rotation().y()), FMath::DegreesToRadians(10.0), 1e-4);
+	}
+
+	// A plain stream of the same actor is unaffected by the delta stream beside it.
+	TempoWorld::ActorStateRequest PlainRequest;
+	PlainRequest.set_actor(Request.actor());
+	int32 NumPlain = 0;
+	for (int32 I = 0; I < 3; ++I)
+	{
+		WorldState->StreamActorState(PlainRequest, TResponseDelegate<TempoWorld::ActorState>::CreateLambda(
+			[&NumPlain](const TempoWorld::ActorState&, grpc::Status)
+			{
+				++NumPlain;
+			}));
+		PumpSingle();
+	}
+	TestEqual(TEXT("Plain streams are sent every tick"), NumPlain, 3);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoActorStateDeltaBytesTest,
+	"Tempo.World.ActorStateDelta.Bytes", TempoActorStateDeltaTestFlags)
+bool FTempoActorStateDeltaBytesTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumParked = 200;
+	constexpr int32 NumMoving = 10;
+	constexpr int32 NumTicks = 100;
+
+	const FActorStateDeltaTestFixture Fixture;
+	UTempoWorldStateServiceSubsystem* WorldState = Fixture.World->GetSubsystem<UTempoWorldStateServiceSubsystem>();
+	if (!TestNotNull(TEXT("Game worlds have a world state service"), WorldState))
+	{
+		return false;
+	}
+
+	AActor* Center = Fixture.SpawnMovableActor(0.0);
+	for (int32 I = 0; I < NumParked; ++I)
+	{
+		Fixture.SpawnMovableActor(1.0 + I * 0.1);
+	}
+	TArray<AActor*> Moving;
+	for (int32 I = 0; I < NumMoving; ++I)
+	{
+		Moving.Add(Fixture.SpawnMovableActor(-1.0 - I));
+	}
+
+	const TempoWorld::ActorStatesNearRequest FullRequest = MakeNearRequest(Center, 100.0f, false);
+	const TempoWorld::ActorStatesNearRequest DeltaRequest = MakeNearRequest(Center, 100.0f, true);
+	FActorStatesStream FullStream;
+	FActorStatesStream DeltaStream;
+	const TArray<FActorStatesStream*> FullStreams = { &FullStream };
+	const TArray<FActorStatesStream*> DeltaStreams = { &DeltaStream };
+
+	for (int32 TickIndex = 0; TickIndex < NumTicks; ++TickIndex)
+	{
+		// The moving actors drive at 5 m/s along Y, staying in range.
+		for (AActor* Actor : Moving)
+		{
+			Actor->AddActorWorldOffset(FVector(0.0, 50.0, 0.0));
+		}
+		// Both streams see the same world state each tick.
+		if (!FullStream.bPending)
+		{
+			FullStream.bPending = true;
+			WorldState->StreamActorStatesNear(FullRequest, FullStream.Continuation);
+		}
+		Pump(WorldState, DeltaRequest, DeltaStreams);
+	}
+
+	uint64 FullBytes = 0;
+	for (const TempoWorld::ActorStates& States : FullStream.Received)
+	{
+		FullBytes += States.ByteSizeLong();
+	}
+	uint64 DeltaBytes = 0;
+	int32 NumDeltaStates = 0;
+	for (const TempoWorld::ActorStates& States : DeltaStream.Received)
+	{
+		DeltaBytes += States.ByteSizeLong();
+		NumDeltaStates += States.actor_states_size();
+	}
+
+	TestEqual(TEXT("Full stream is answered every tick"), FullStream.Received.Num(), NumTicks);
+	TestEqual(TEXT("Delta stream sends the keyframe, then only the moving actors"), NumDeltaStates, 1 + NumParked + NumMoving + (NumTicks - 1) * NumMoving);
+	TestTrue(TEXT("Delta stream sends fewer bytes"), DeltaBytes < FullBytes);
+
+	AddInfo(FString::Printf(TEXT("%d parked + %d moving actors over %d ticks: full %llu bytes, delta %llu bytes (%.1fx smaller)"),
+		NumParked, NumMoving, NumTicks, static_cast<uint64>(FullBytes), static_cast<uint64>(DeltaBytes),
+		DeltaBytes > 0 ? static_cast<double>(FullBytes) / DeltaBytes : 0.0));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,308 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoWorldControlServiceSubsystem.h"
+
+#include "TempoCoreUtils.h"
+#include "TempoTestWorld.h"
+
+#include "TempoWorld/WorldControl.grpc.pb.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+// Tests for PrepareFunction and CallFunctions: parameter layouts, packed arguments and outputs, component
+// targets, per-target failures, and the time per call against one CallFunction request per actor. Run with
+//   Automation RunTests Tempo.World.CallFunctions
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoCallFunctionsTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	struct FCallFunctionsTestFixture : FTempoTestWorld
+	{
+		UTempoWorldControlServiceSubsystem* WorldControl = nullptr;
+
+		FCallFunctionsTestFixture()
+		{
+			WorldControl = World->GetSubsystem<UTempoWorldControlServiceSubsystem>();
+		}
+
+		TArray<AStaticMeshActor*> SpawnActors(int32 NumActors) const
+		{
+			TArray<AStaticMeshActor*> Actors;
+			for (int32 Index = 0; Index < NumActors; ++Index)
+			{
+				Actors.Add(World->SpawnActor<AStaticMeshActor>());
+			}
+			return Actors;
+		}
+
+		TempoWorld::PrepareFunctionResponse Prepare(const char* ObjectClass, const char* Function, grpc::StatusCode* OutCode = nullptr) const
+		{
+			TempoWorld::PrepareFunctionRequest Request;
+			Request.set_object_class(ObjectClass);
+			Request.set_function(Function);
+			TempoWorld::PrepareFunctionResponse Result;
+			WorldControl->PrepareFunction(Request, TResponseDelegate<TempoWorld::PrepareFunctionResponse>::CreateLambda(
+				[&Result, OutCode](const TempoWorld::PrepareFunctionResponse& Response, grpc::Status Status)
+				{
+					Result = Response;
+					if (OutCode)
+					{
+						*OutCode = Status.error_code();
+					}
+				}));
+			return Result;
+		}
+
+		TempoWorld::CallFunctionsResponse Call(const TempoWorld::CallFunctionsRequest& Request, grpc::StatusCode* OutCode = nullptr) const
+		{
+			TempoWorld::CallFunctionsResponse Result;
+			WorldControl->CallFunctions(Request, TResponseDelegate<TempoWorld::CallFunctionsResponse>::CreateLambda(
+				[&Result, OutCode](const TempoWorld::CallFunctionsResponse& Response, grpc::Status Status)
+				{
+					Result = Response;
+					if (OutCode)
+					{
+						*OutCode = Status.error_code();
+					}
+				}));
+			return Result;
+		}
+	};
+
+	void AddTarget(TempoWorld::CallFunctionsRequest& Request, const AActor* Actor, const FString& Component = FString())
+	{
+		TempoWorld::FunctionTarget* Target = Request.add_targets();
+		Target->set_actor(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(Actor)));
+		Target->set_component(TCHAR_TO_UTF8(*Component));
+	}
+
+	template <typename T>
+	void AppendPacked(std::string& Packed, const T& Value)
+	{
+		Packed.append(reinterpret_cast<const char*>(&Value), sizeof(T));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoCallFunctionsPackingTest,
+	"Tempo.World.CallFunctions.Packing", TempoCallFunctionsTestFlags)
+bool FTempoCallFunctionsPackingTest::RunTest(const FString& Parameters)
+{
+	const FCallFunctionsTestFixture Fixture;
+	if (!TestNotNull(TEXT("Game worlds have a world control service"), Fixture.WorldControl))
+	{
+		return false;
+	}
+	const TArray<AStaticMeshActor*> Actors = Fixture.SpawnActors(3);
+
+	// Per-target arguments.
+	const TempoWorld::PrepareFunctionResponse SetScale = Fixture.Prepare("StaticMeshActor", "SetActorScale3D");
+	TestTrue(TEXT("Handles are never 0"), SetScale.handle() != 0);
+	TestEqual(TEXT("An FVector parameter is three doubles"), SetScale.arguments_size(), static_cast<uint32>(sizeof(FVector)));
+	TestEqual(TEXT("A void function has no outputs"), SetScale.outputs_size(), 0u);
+	if (TestEqual(TEXT("The input is listed"), SetScale.inputs_size(), 1))
+	{
+		TestEqual(TEXT("Inputs are listed with their C++ type"), FString(UTF8_TO_TCHAR(SetScale.inputs(0).type().c_str())), FString(TEXT("FVector")));
+	}
+
+	TempoWorld::CallFunctionsRequest SetScaleRequest;
+	SetScaleRequest.set_handle(SetScale.handle());
+	for (int32 Index = 0; Index < Actors.Num(); ++Index)
+	{
+		AddTarget(SetScaleRequest, Actors[Index]);
+		AppendPacked(*SetScaleRequest.mutable_arguments(), FVector(Index + 1.0));
+	}
+	TestEqual(TEXT("A batch that succeeds reports no failures"), Fixture.Call(SetScaleRequest).failures_size(), 0);
+	for (int32 Index = 0; Index < Actors.Num(); ++Index)
+	{
+		TestEqual(FString::Printf(TEXT("Target %d gets its own arguments"), Index), Actors[Index]->GetActorScale3D(), FVector(Index + 1.0));
+	}
+
+	// Outputs, and a target that doesn't exist.
+	const TempoWorld::PrepareFunctionResponse GetScale = Fixture.Prepare("Actor", "GetActorScale3D");
+	TempoWorld::CallFunctionsRequest GetScaleRequest;
+	GetScaleRequest.set_handle(GetScale.handle());
+	for (const AActor* Actor : Actors)
+	{
+		AddTarget(GetScaleRequest, Actor);
+	}
+	GetScaleRequest.add_targets()->set_actor("NoSuchActor");
+	const TempoWorld::CallFunctionsResponse Scales = Fixture.Call(GetScaleRequest);
+	if (TestEqual(TEXT("Outputs are packed per target"), static_cast<uint64>(Scales.outputs().size()), static_cast<uint64>(4 * sizeof(FVector))))
+	{
+		for (int32 Index = 0; Index < Actors.Num(); ++Index)
+		{
+			FVector Scale;
+			FMemory::Memcpy(&Scale, Scales.outputs().data() + Index * sizeof(FVector), sizeof(FVector));
+			TestEqual(FString::Printf(TEXT("Target %d's return value is packed"), Index), Scale, FVector(Index + 1.0));
+		}
+	}
+	if (TestEqual(TEXT("Missing targets fail on their own"), Scales.failures_size(), 1))
+	{
+		TestEqual(TEXT("Failures index the targets"), Scales.failures(0).op_index(), 3u);
+		TestEqual(TEXT("Missing targets are not found"), Scales.failures(0).code(), static_cast<int32>(grpc::NOT_FOUND));
+	}
+
+	// Rotators and transforms are converted from and to radians, meters and the right-handed frame.
+	const TempoWorld::PrepareFunctionResponse SetRotation = Fixture.Prepare("Actor", "K2_SetActorRotation");
+	TempoWorld::CallFunctionsRequest SetRotationRequest;
+	SetRotationRequest.set_handle(SetRotation.handle());
+	AddTarget(SetRotationRequest, Actors[0]);
+	AppendPacked(*SetRotationRequest.mutable_arguments(), FRotator(0.0, UE_HALF_PI, 0.0));
+	AppendPacked(*SetRotationRequest.mutable_arguments(), static_cast<uint8>(0));
+	Fixture.Call(SetRotationRequest);
+	TestEqual(TEXT("Rotator arguments are converted"), Actors[0]->GetActorRotation().Yaw, -90.0, 1e-6);
+
+	Actors[0]->SetActorLocation(FVector(100.0, 200.0, 300.0));
+	const TempoWorld::PrepareFunctionResponse GetTransform = Fixture.Prepare("Actor", "GetTransform");
+	TestEqual(TEXT("An FTransform is nine doubles"), GetTransform.outputs_size(), static_cast<uint32>(9 * sizeof(double)));
+	TempoWorld::CallFunctionsRequest GetTransformRequest;
+	GetTransformRequest.set_handle(GetTransform.handle());
+	AddTarget(GetTransformRequest, Actors[0]);
+	const TempoWorld::CallFunctionsResponse Transform = Fixture.Call(GetTransformRequest);
+	if (TestEqual(TEXT("The transform is packed"), static_cast<uint64>(Transform.outputs().size()), static_cast<uint64>(9 * sizeof(double))))
+	{
+		double Packed[9];
+		FMemory::Memcpy(Packed, Transform.outputs().data(), sizeof(Packed));
+		TestEqual(TEXT("Transform outputs are in meters, right-handed"), FVector(Packed[0], Packed[1], Packed[2]), FVector(1.0, -2.0, 3.0));
+		TestEqual(TEXT("Transform outputs' rotations are in radians, right-handed"), Packed[4], UE_HALF_PI, 1e-6);
+		TestEqual(TEXT("Transform outputs' scales are not converted"), FVector(Packed[6], Packed[7], Packed[8]), Actors[0]->GetActorScale3D());
+	}
+
+	// Out parameters are outputs, not inputs.
+	const TempoWorld::PrepareFunctionResponse GetBounds = Fixture.Prepare("Actor", "GetActorBounds");
+	TestEqual(TEXT("Out parameters aren't inputs"), GetBounds.inputs_size(), 2);
+	TestEqual(TEXT("Out parameters are outputs"), GetBounds.outputs_size(), 2);
+	TestEqual(TEXT("Two bools take two bytes"), GetBounds.arguments_size(), 2u);
+
+	// Shared arguments, on components.
+	const TempoWorld::PrepareFunctionResponse SetVisibility = Fixture.Prepare("SceneComponent", "SetVisibility");
+	TempoWorld::CallFunctionsRequest SetVisibilityRequest;
+	SetVisibilityRequest.set_handle(SetVisibility.handle());
+	for (const AStaticMeshActor* Actor : Actors)
+	{
+		AddTarget(SetVisibilityRequest, Actor, Actor->GetStaticMeshComponent()->GetName());
+	}
+	AddTarget(SetVisibilityRequest, Actors[0]);
+	AppendPacked(*SetVisibilityRequest.mutable_arguments(), static_cast<uint8>(0));
+	AppendPacked(*SetVisibilityRequest.mutable_arguments(), static_cast<uint8>(0));
+	const TempoWorld::CallFunctionsResponse Hidden = Fixture.Call(SetVisibilityRequest);
+	for (const AStaticMeshActor* Actor : Actors)
+	{
+		TestFalse(TEXT("One set of arguments is passed to every target"), Actor->GetStaticMeshComponent()->IsVisible());
+	}
+	if (TestEqual(TEXT("Targets of the wrong class fail on their own"), Hidden.failures_size(), 1))
+	{
+		TestEqual(TEXT("Targets of the wrong class fail the precondition"), Hidden.failures(0).code(), static_cast<int32>(grpc::FAILED_PRECONDITION));
+	}
+
+	// Errors.
+	grpc::StatusCode Code = grpc::OK;
+	Fixture.Prepare("Actor", "K2_SetActorLocation", &Code);
+	TestEqual(TEXT("Functions with unpackable parameters can't be prepared"), static_cast<int32>(Code), static_cast<int32>(grpc::FAILED_PRECONDITION));
+	Fixture.Prepare("Actor", "NoSuchFunction", &Code);
+	TestEqual(TEXT("Unknown functions are not found"), static_cast<int32>(Code), static_cast<int32>(grpc::NOT_FOUND));
+	Fixture.Prepare("NoSuchClass", "SetActorScale3D", &Code);
+	TestEqual(TEXT("Unknown classes are not found"), static_cast<int32>(Code), static_cast<int32>(grpc::NOT_FOUND));
+
+	SetScaleRequest.mutable_arguments()->pop_back();
+	Fixture.Call(SetScaleRequest, &Code);
+	TestEqual(TEXT("Arguments of the wrong size are rejected"), static_cast<int32>(Code), static_cast<int32>(grpc::INVALID_ARGUMENT));
+
+	TempoWorld::ReleaseFunctionHandlesRequest ReleaseRequest;
+	ReleaseRequest.add_handles(SetScale.handle());
+	Fixture.WorldControl->ReleaseFunctionHandles(ReleaseRequest, TResponseDelegate<TempoCore::Empty>());
+	Fixture.Call(SetScaleRequest, &Code);
+	TestEqual(TEXT("Released handles are not found"), static_cast<int32>(Code), static_cast<int32>(grpc::NOT_FOUND));
+	Fixture.Call(GetScaleRequest, &Code);
+	TestEqual(TEXT("Other handles survive a release"), static_cast<int32>(Code), static_cast<int32>(grpc::OK));
+
+	Fixture.WorldControl->ReleaseFunctionHandles(TempoWorld::ReleaseFunctionHandlesRequest(), TResponseDelegate<TempoCore::Empty>());
+	Fixture.Call(GetScaleRequest, &Code);
+	TestEqual(TEXT("An empty release releases nothing"), static_cast<int32>(Code), static_cast<int32>(grpc::OK));
+	TempoWorld::ReleaseFunctionHandlesRequest ReleaseAllRequest;
+	ReleaseAllRequest.set_all(true);
+	Fixture.WorldControl->ReleaseFunctionHandles(ReleaseAllRequest, TResponseDelegate<TempoCore::Empty>());
+	Fixture.Call(GetScaleRequest, &Code);
+	TestEqual(TEXT("Releasing all releases every handle"), static_cast<int32>(Code), static_cast<int32>(grpc::NOT_FOUND));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoCallFunctionsBenchmarkTest,
+	"Tempo.World.CallFunctions.Benchmark", TempoCallFunctionsTestFlags)
+bool FTempoCallFunctionsBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumActors = 500;
+	constexpr int32 NumSteps = 20;
+
+	const FCallFunctionsTestFixture Fixture;
+	if (!TestNotNull(TEXT("Game worlds have a world control service"), Fixture.WorldControl))
+	{
+		return false;
+	}
+	const TArray<AStaticMeshActor*> Actors = Fixture.SpawnActors(NumActors);
+
+	// One CallFunction request per actor per step, as scenario scripts do today.
+	const double SingleStartTime = FPlatformTime::Seconds();
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		for (const AActor* Actor : Actors)
+		{
+			TempoWorld::CallFunctionRequest Request;
+			Request.set_actor(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(Actor)));
+			Request.set_function("ForceNetUpdate");
+			Fixture.WorldControl->CallObjectFunction(Request, TResponseDelegate<TempoCore::Empty>());
+		}
+	}
+	const double SingleSeconds = FPlatformTime::Seconds() - SingleStartTime;
+
+	// One CallFunctions request per step.
+	TempoWorld::CallFunctionsRequest Batch;
+	Batch.set_handle(Fixture.Prepare("Actor", "ForceNetUpdate").handle());
+	for (const AActor* Actor : Actors)
+	{
+		AddTarget(Batch, Actor);
+	}
+	int32 NumFailures = 0;
+	const double BatchStartTime = FPlatformTime::Seconds();
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		NumFailures += Fixture.Call(Batch).failures_size();
+	}
+	const double BatchSeconds = FPlatformTime::Seconds() - BatchStartTime;
+
+	// With per-target packed arguments.
+	TempoWorld::CallFunctionsRequest ArgumentsBatch = Batch;
+	ArgumentsBatch.set_handle(Fixture.Prepare("Actor", "SetActorHiddenInGame").handle());
+	const double ArgumentsStartTime = FPlatformTime::Seconds();
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		std::string& Arguments = *ArgumentsBatch.mutable_arguments();
+		Arguments.clear();
+		for (int32 Index = 0; Index < NumActors; ++Index)
+		{
+			AppendPacked(Arguments, static_cast<uint8>((Index + Step) % 2));
+		}
+		NumFailures += Fixture.Call(ArgumentsBatch).failures_size();
+	}
+	const double ArgumentsSeconds = FPlatformTime::Seconds() - ArgumentsStartTime;
+
+	TestEqual(TEXT("Every call succeeds"), NumFailures, 0);
+	TestTrue(TEXT("The last step's arguments were applied"), !Actors[0]->IsHidden() && Actors[1]->IsHidden());
+
+	const int32 NumCalls = NumActors * NumSteps;
+	AddInfo(FString::Printf(TEXT("%d actors x %d steps: CallFunction %.2f us/call; CallFunctions %.2f us/call (%.1fx); CallFunctions with a packed bool %.2f us/call"),
+		NumActors, NumSteps, SingleSeconds * 1e6 / NumCalls, BatchSeconds * 1e6 / NumCalls,
+		SingleSeconds / FMath::Max(BatchSeconds, 1e-9), ArgumentsSeconds * 1e6 / NumCalls));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
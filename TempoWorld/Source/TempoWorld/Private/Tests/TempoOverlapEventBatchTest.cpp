@@ -0,0 +1,326 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoWorldStateServiceSubsystem.h"
+
+#include "TempoCoreUtils.h"
+#include "TempoTestWorld.h"
+
+#include "TempoWorld/WorldState.grpc.pb.h"
+
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+// Tests for StreamOverlapEventBatches: actor selection and filters, coalescing a tick's events into one batch,
+// the actor ID table, and the cost of a burst of overlaps against one StreamOverlapEvents stream per actor. Run with
+//   Automation RunTests Tempo.World.OverlapEventBatch
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoOverlapEventBatchTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	struct FOverlapEventBatchTestFixture : FTempoTestWorld
+	{
+		UTempoWorldStateServiceSubsystem* WorldState = nullptr;
+
+		FOverlapEventBatchTestFixture()
+		{
+			WorldState = World->GetSubsystem<UTempoWorldStateServiceSubsystem>();
+		}
+
+		AActor* SpawnActor(FName Tag = NAME_None) const
+		{
+			AActor* Actor = World->SpawnActor<AActor>();
+			if (!Tag.IsNone())
+			{
+				Actor->Tags.Add(Tag);
+			}
+			return Actor;
+		}
+	};
+
+	// Stands in for one client stream: the messages it received, and whether its continuation is parked.
+	template <typename ResponseType>
+	struct TTestStream
+	{
+		TArray<ResponseType> Received;
+		TArray<grpc::StatusCode> Statuses;
+		bool bPending = false;
+		TResponseDelegate<ResponseType> Continuation;
+
+		TTestStream()
+		{
+			Continuation = TResponseDelegate<ResponseType>::CreateLambda([this](const ResponseType& Response, grpc::Status Status)
+			{
+				Received.Add(Response);
+				Statuses.Add(Status.error_code());
+				bPending = false;
+			});
+		}
+
+		TTestStream(const TTestStream&) = delete;
+		TTestStream& operator=(const TTestStream&) = delete;
+	};
+
+	using FBatchStream = TTestStream<TempoWorld::OverlapEventBatch>;
+	using FLegacyStream = TTestStream<TempoWorld::OverlapEventResponse>;
+
+	void Subscribe(UTempoWorldStateServiceSubsystem* WorldState, const TempoWorld::OverlapBatchRequest& Request, FBatchStream& Stream)
+	{
+		if (!Stream.bPending)
+		{
+			Stream.bPending = true;
+			WorldState->StreamOverlapEventBatches(Request, Stream.Continuation);
+		}
+	}
+
+	// Raises an overlap between two actors, as the engine does: on each of them.
+	void Overlap(AActor* First, AActor* Second, bool bBegin)
+	{
+		if (bBegin)
+		{
+			First->OnActorBeginOverlap.Broadcast(First, Second);
+			Second->OnActorBeginOverlap.Broadcast(Second, First);
+		}
+		else
+		{
+			First->OnActorEndOverlap.Broadcast(First, Second);
+			Second->OnActorEndOverlap.Broadcast(Second, First);
+		}
+	}
+
+	FString AddedActorName(const TempoWorld::OverlapEventBatch& Batch, uint32 Id)
+	{
+		for (const TempoWorld::SnapshotActor& Actor : Batch.added_actors())
+		{
+			if (Actor.id() == Id)
+			{
+				return UTF8_TO_TCHAR(Actor.name().c_str());
+			}
+		}
+		return FString();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoOverlapEventBatchCoalesceTest,
+	"Tempo.World.OverlapEventBatch.Coalesce", TempoOverlapEventBatchTestFlags)
+bool FTempoOverlapEventBatchCoalesceTest::RunTest(const FString& Parameters)
+{
+	const FOverlapEventBatchTestFixture Fixture;
+	UTempoWorldStateServiceSubsystem* WorldState = Fixture.WorldState;
+	if (!TestNotNull(TEXT("Game worlds have a world state service"), WorldState))
+	{
+		return false;
+	}
+
+	AActor* TriggerA = Fixture.SpawnActor();
+	AActor* TriggerB = Fixture.SpawnActor();
+	AActor* Agent1 = Fixture.SpawnActor(TEXT("Agent"));
+	AActor* Agent2 = Fixture.SpawnActor(TEXT("Agent"));
+	AActor* Bystander = Fixture.SpawnActor();
+
+	TempoWorld::OverlapBatchRequest Request;
+	Request.add_actors(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(TriggerA)));
+	Request.add_actors(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(TriggerB)));
+	Request.add_overlapping_actor_tags("Agent");
+	FBatchStream Stream;
+	Subscribe(WorldState, Request, Stream);
+
+	Overlap(TriggerA, Agent1, true);
+	Overlap(TriggerA, Bystander, true);
+	Overlap(TriggerB, Agent2, true);
+	Overlap(TriggerA, Agent1, false);
+	WorldState->Tick(0.1f);
+
+	if (!TestEqual(TEXT("A tick's events are sent in one batch"), Stream.Received.Num(), 1))
+	{
+		return false;
+	}
+	const TempoWorld::OverlapEventBatch& First = Stream.Received[0];
+	if (!TestEqual(TEXT("Overlaps by filtered-out actors are dropped"), First.events_size(), 3))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Each actor in the batch is added to the ID table once"), First.added_actors_size(), 4);
+	TestEqual(TEXT("Events name the watched actor"), AddedActorName(First, First.events(0).overlapped_actor_id()), UTempoCoreUtils::GetActorIdentifier(TriggerA));
+	TestEqual(TEXT("Events name the overlapping actor"), AddedActorName(First, First.events(0).overlapping_actor_id()), UTempoCoreUtils::GetActorIdentifier(Agent1));
+	TestTrue(TEXT("Begin events are marked"), First.events(0).begin() && First.events(1).begin());
+	TestEqual(TEXT("Events are in the order they happened"), AddedActorName(First, First.events(1).overlapping_actor_id()), UTempoCoreUtils::GetActorIdentifier(Agent2));
+	TestFalse(TEXT("End events are marked"), First.events(2).begin());
+	TestEqual(TEXT("End events use the IDs already sent"), First.events(2).overlapping_actor_id(), First.events(0).overlapping_actor_id());
+
+	Subscribe(WorldState, Request, Stream);
+	WorldState->Tick(0.1f);
+	TestEqual(TEXT("Ticks without events send nothing"), Stream.Received.Num(), 1);
+
+	Overlap(TriggerB, Agent1, true);
+	WorldState->Tick(0.1f);
+	if (TestEqual(TEXT("Events after a quiet tick are sent"), Stream.Received.Num(), 2))
+	{
+		TestEqual(TEXT("Known actors aren't added to the ID table again"), Stream.Received[1].added_actors_size(), 0);
+	}
+
+	// A stream waiting out a quiet spell longer than the stream timeout is still there.
+	Subscribe(WorldState, Request, Stream);
+	Fixture.World->TimeSeconds += 60.0;
+	WorldState->Tick(0.1f);
+	Overlap(TriggerB, Agent2, false);
+	WorldState->Tick(0.1f);
+	TestEqual(TEXT("Waiting streams outlive the timeout"), Stream.Received.Num(), 3);
+
+	// A stream that selects by tag also watches actors spawned after it starts.
+	TempoWorld::OverlapBatchRequest TagRequest;
+	TagRequest.add_actor_tags("Trigger");
+	FBatchStream TagStream;
+	Subscribe(WorldState, TagRequest, TagStream);
+	AActor* LateTrigger = Fixture.SpawnActor(TEXT("Trigger"));
+	Overlap(LateTrigger, Bystander, true);
+	WorldState->Tick(0.1f);
+	if (TestEqual(TEXT("Actors spawned with a selected tag are watched"), TagStream.Received.Num(), 1))
+	{
+		TestEqual(TEXT("Only the watched actor's side of the overlap is reported"), TagStream.Received[0].events_size(), 1);
+	}
+
+	// The single-actor stream unbinds itself after one event, which mustn't stop the batch stream.
+	Subscribe(WorldState, Request, Stream);
+	FLegacyStream LegacyStream;
+	TempoWorld::OverlapEventRequest LegacyRequest;
+	LegacyRequest.set_actor(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(TriggerA)));
+	WorldState->StreamOverlapEvents(LegacyRequest, LegacyStream.Continuation);
+	Overlap(TriggerA, Agent2, true);
+	TestEqual(TEXT("The single-actor stream gets its event"), LegacyStream.Received.Num(), 1);
+	Overlap(TriggerA, Agent2, false);
+	WorldState->Tick(0.1f);
+	if (TestEqual(TEXT("The batch stream gets events after the single-actor stream unbinds"), Stream.Received.Num(), 4))
+	{
+		TestEqual(TEXT("Both events are in the batch"), Stream.Received[3].events_size(), 2);
+	}
+
+	FBatchStream EmptyStream;
+	Subscribe(WorldState, TempoWorld::OverlapBatchRequest(), EmptyStream);
+	TestTrue(TEXT("A request selecting no actors is rejected"), EmptyStream.Statuses.Num() == 1 && EmptyStream.Statuses[0] == grpc::FAILED_PRECONDITION);
+
+	TempoWorld::OverlapBatchRequest UnknownRequest;
+	UnknownRequest.add_actors("NoSuchActor");
+	FBatchStream UnknownStream;
+	Subscribe(WorldState, UnknownRequest, UnknownStream);
+	TestTrue(TEXT("A request naming an unknown actor is rejected"), UnknownStream.Statuses.Num() == 1 && UnknownStream.Statuses[0] == grpc::NOT_FOUND);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoOverlapEventBatchBurstTest,
+	"Tempo.World.OverlapEventBatch.Burst", TempoOverlapEventBatchTestFlags)
+bool FTempoOverlapEventBatchBurstTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumAgents = 300;
+	constexpr int32 NumBystanders = 300;
+	constexpr int32 NumTriggers = 30;
+	constexpr int32 NumTicks = 20;
+
+	const FOverlapEventBatchTestFixture Fixture;
+	UTempoWorldStateServiceSubsystem* WorldState = Fixture.WorldState;
+	if (!TestNotNull(TEXT("Game worlds have a world state service"), WorldState))
+	{
+		return false;
+	}
+
+	TArray<AActor*> Agents;
+	TArray<AActor*> Bystanders;
+	TArray<AActor*> Triggers;
+	for (int32 Index = 0; Index < NumAgents; ++Index)
+	{
+		Agents.Add(Fixture.SpawnActor(TEXT("Agent")));
+	}
+	for (int32 Index = 0; Index < NumBystanders; ++Index)
+	{
+		Bystanders.Add(Fixture.SpawnActor());
+	}
+	for (int32 Index = 0; Index < NumTriggers; ++Index)
+	{
+		Triggers.Add(Fixture.SpawnActor(TEXT("Trigger")));
+	}
+
+	// Every tick, every agent and bystander enters one trigger and leaves the one it was in.
+	const auto RunBurst = [&](const TFunction<void()>& BeforeTick)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+		{
+			BeforeTick();
+			for (int32 Index = 0; Index < NumAgents; ++Index)
+			{
+				if (Tick > 0)
+				{
+					Overlap(Triggers[(Index + Tick - 1) % NumTriggers], Agents[Index], false);
+					Overlap(Triggers[(Index + Tick - 1) % NumTriggers], Bystanders[Index], false);
+				}
+				Overlap(Triggers[(Index + Tick) % NumTriggers], Agents[Index], true);
+				Overlap(Triggers[(Index + Tick) % NumTriggers], Bystanders[Index], true);
+			}
+			WorldState->Tick(0.1f);
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	};
+
+	// One stream per agent, which reports begin events only, and can't filter out the bystanders.
+	TArray<TUniquePtr<FLegacyStream>> LegacyStreams;
+	for (int32 Index = 0; Index < NumAgents; ++Index)
+	{
+		LegacyStreams.Add(MakeUnique<FLegacyStream>());
+	}
+	const double LegacySeconds = RunBurst([&]()
+	{
+		for (int32 Index = 0; Index < NumAgents; ++Index)
+		{
+			if (!LegacyStreams[Index]->bPending)
+			{
+				LegacyStreams[Index]->bPending = true;
+				TempoWorld::OverlapEventRequest Request;
+				Request.set_actor(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(Agents[Index])));
+				WorldState->StreamOverlapEvents(Request, LegacyStreams[Index]->Continuation);
+			}
+		}
+	});
+	int32 LegacyMessages = 0;
+	uint64 LegacyBytes = 0;
+	for (const TUniquePtr<FLegacyStream>& Stream : LegacyStreams)
+	{
+		LegacyMessages += Stream->Received.Num();
+		for (const TempoWorld::OverlapEventResponse& Response : Stream->Received)
+		{
+			LegacyBytes += Response.ByteSizeLong();
+		}
+	}
+
+	// One stream for the triggers, which reports begin and end events of agents only.
+	TempoWorld::OverlapBatchRequest Request;
+	Request.add_actor_tags("Trigger");
+	Request.add_overlapping_actor_tags("Agent");
+	FBatchStream Stream;
+	const double BatchSeconds = RunBurst([&]()
+	{
+		Subscribe(WorldState, Request, Stream);
+	});
+	int32 NumEvents = 0;
+	uint64 BatchBytes = 0;
+	for (const TempoWorld::OverlapEventBatch& Batch : Stream.Received)
+	{
+		NumEvents += Batch.events_size();
+		BatchBytes += Batch.ByteSizeLong();
+	}
+
+	TestEqual(TEXT("One batch is sent per tick"), Stream.Received.Num(), NumTicks);
+	TestEqual(TEXT("Every agent's begin and end events are reported"), NumEvents, NumAgents * (2 * NumTicks - 1));
+
+	AddInfo(FString::Printf(TEXT("%d agents and %d bystanders through %d triggers for %d ticks: %d single-actor streams sent %d messages (%llu bytes, %.2f ms); one batch stream sent %d messages (%llu bytes, %.2f ms) with %d events, including end events"),
+		NumAgents, NumBystanders, NumTriggers, NumTicks, NumAgents, LegacyMessages, LegacyBytes, LegacySeconds * 1e3,
+		Stream.Received.Num(), BatchBytes, BatchSeconds * 1e3, NumEvents));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,363 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoPropertyPathCache.h"
+#include "TempoWorldControlServiceSubsystem.h"
+
+#include "TempoWorld/WorldControl.grpc.pb.h"
+
+#include "TempoCoreUtils.h"
+#include "TempoTestWorld.h"
+
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+
+// Tests for FTempoPropertyPathCache and the prepared property handle RPCs, plus a benchmark of SetProperties
+// and SetPropertiesByHandle on many actors with uncached reflection lookup as a baseline. Run with
+//   Automation RunTests Tempo.World.PropertyPathCache
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoPropertyPathCacheTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	struct FPropertyPathCacheTestFixture : FTempoTestWorld
+	{
+		// An actor with a scene component named "Root".
+		AActor* SpawnWithRoot() const
+		{
+			AActor* Actor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity);
+			USceneComponent* Root = NewObject<USceneComponent>(Actor, TEXT("Root"));
+			Actor->SetRootComponent(Root);
+			Root->RegisterComponent();
+			return Actor;
+		}
+	};
+
+	TempoWorld::SetPropertiesResponse RunSetProperties(const UTempoWorldControlServiceSubsystem* WorldControl, const TempoWorld::SetPropertiesRequest& Request)
+	{
+		TempoWorld::SetPropertiesResponse Result;
+		WorldControl->SetProperties(Request, TResponseDelegate<TempoWorld::SetPropertiesResponse>::CreateLambda(
+			[&Result](const TempoWorld::SetPropertiesResponse& Response, grpc::Status)
+			{
+				Result = Response;
+			}));
+		return Result;
+	}
+
+	TempoWorld::SetPropertiesResponse RunSetPropertiesByHandle(UTempoWorldControlServiceSubsystem* WorldControl, const TempoWorld::SetPropertiesByHandleRequest& Request)
+	{
+		TempoWorld::SetPropertiesResponse Result;
+		WorldControl->SetPropertiesByHandle(Request, TResponseDelegate<TempoWorld::SetPropertiesResponse>::CreateLambda(
+			[&Result](const TempoWorld::SetPropertiesResponse& Response, grpc::Status)
+			{
+				Result = Response;
+			}));
+		return Result;
+	}
+
+	TempoWorld::PreparePropertyHandlesResponse RunPreparePropertyHandles(UTempoWorldControlServiceSubsystem* WorldControl, const TempoWorld::PreparePropertyHandlesRequest& Request)
+	{
+		TempoWorld::PreparePropertyHandlesResponse Result;
+		WorldControl->PreparePropertyHandles(Request, TResponseDelegate<TempoWorld::PreparePropertyHandlesResponse>::CreateLambda(
+			[&Result](const TempoWorld::PreparePropertyHandlesResponse& Response, grpc::Status)
+			{
+				Result = Response;
+			}));
+		return Result;
+	}
+
+	void AddFloatOp(TempoWorld::SetPropertiesRequest& Request, const std::string& Actor, const char* Component, const char* Property, float Value)
+	{
+		TempoWorld::SetFloatPropertyRequest* Op = Request.add_ops()->mutable_float_op();
+		Op->set_actor(Actor);
+		Op->set_component(Component);
+		Op->set_property(Property);
+		Op->set_value(Value);
+	}
+
+	// How the property RPCs looked properties up before the cache.
+	const FProperty* UncachedLookup(const UClass* Class, const FString& Path)
+	{
+		FString InnerPath = Path;
+		const FString FirstPropertyName = FTempoPropertyPathCache::SplitPropertyName(InnerPath);
+		const FProperty* Property = Class->FindPropertyByName(FName(FirstPropertyName));
+		while (Property && !InnerPath.IsEmpty())
+		{
+			const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+			const FString MemberName = FTempoPropertyPathCache::SplitPropertyName(InnerPath);
+			Property = nullptr;
+			for (const FProperty* Member = StructProperty ? StructProperty->Struct->PropertyLink : nullptr; Member; Member = Member->PropertyLinkNext)
+			{
+				if (Member->GetAuthoredName() == MemberName)
+				{
+					Property = Member;
+					break;
+				}
+			}
+		}
+		return Property;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoPropertyPathCacheResolveTest,
+	"Tempo.World.PropertyPathCache.Resolve", TempoPropertyPathCacheTestFlags)
+bool FTempoPropertyPathCacheResolveTest::RunTest(const FString& Parameters)
+{
+	FTempoPropertyPathCache& Cache = FTempoPropertyPathCache::Get();
+	Cache.Reset();
+	const uint64 HitsBefore = Cache.GetNumHits();
+	const uint64 MissesBefore = Cache.GetNumMisses();
+
+	FTempoResolvedPropertyPath Resolved;
+	TestTrue(TEXT("Resolves a struct member path"), Cache.Resolve(USceneComponent::StaticClass(), TEXT("RelativeLocation.Y"), Resolved));
+	TestEqual(TEXT("Top-level property"), Resolved.Property ? Resolved.Property->GetName() : FString(), FString(TEXT("RelativeLocation")));
+	TestEqual(TEXT("Leaf property"), Resolved.Leaf ? Resolved.Leaf->GetName() : FString(), FString(TEXT("Y")));
+	TestEqual(TEXT("Leaf offset"), Resolved.LeafOffset,
+		Resolved.Property->GetOffset_ForInternal() + static_cast<int32>(STRUCT_OFFSET(FVector, Y)));
+	TestEqual(TEXT("Inner path start"), Resolved.InnerStart, 17);
+	TestEqual(TEXT("First resolution misses"), Cache.GetNumMisses() - MissesBefore, static_cast<uint64>(1));
+
+	TestTrue(TEXT("Resolves again"), Cache.Resolve(USceneComponent::StaticClass(), TEXT("relativelocation.y"), Resolved));
+	TestEqual(TEXT("Repeat resolution ignoring case hits"), Cache.GetNumHits() - HitsBefore, static_cast<uint64>(1));
+
+	TestTrue(TEXT("Resolves a path through an array"), Cache.Resolve(UActorComponent::StaticClass(), TEXT("ComponentTags[0]"), Resolved));
+	TestNull(TEXT("Paths through arrays have no leaf"), Resolved.Leaf);
+	TestEqual(TEXT("Array path inner start"), Resolved.InnerStart, 14);
+
+	TestFalse(TEXT("Unknown properties don't resolve"), Cache.Resolve(USceneComponent::StaticClass(), TEXT("NoSuchProperty"), Resolved));
+	TestEqual(TEXT("Two paths cached"), Cache.NumCachedPaths(), 2);
+
+	TestNotNull(TEXT("Finds struct members by authored name"), Cache.FindStructMember(TBaseStructure<FVector>::Get(), TEXT("z")));
+
+	const uint32 Generation = Cache.GetGeneration();
+	Cache.Reset();
+	TestNotEqual(TEXT("Reset starts a new generation"), Cache.GetGeneration(), Generation);
+	TestEqual(TEXT("Reset empties the cache"), Cache.NumCachedPaths(), 0);
+
+	// Through the RPCs.
+	const FPropertyPathCacheTestFixture Fixture;
+	const UTempoWorldControlServiceSubsystem* WorldControl = Fixture.World->GetSubsystem<UTempoWorldControlServiceSubsystem>();
+	if (!TestNotNull(TEXT("Game worlds have a world control service"), WorldControl))
+	{
+		return false;
+	}
+	const AActor* Actor = Fixture.SpawnWithRoot();
+	const std::string ActorName(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(Actor)));
+
+	TempoWorld::SetPropertiesRequest Request;
+	AddFloatOp(Request, ActorName, "Root", "RelativeLocation.Y", 7.0f);
+	AddFloatOp(Request, ActorName, "", "InitialLifeSpan", 3.0f);
+	Request.add_ops()->mutable_int_op()->set_actor(ActorName);
+	Request.mutable_ops(2)->mutable_int_op()->set_component("Root");
+	Request.mutable_ops(2)->mutable_int_op()->set_property("RelativeLocation.X");
+	AddFloatOp(Request, ActorName, "Root", "RelativeLocation.W", 1.0f);
+	const TempoWorld::SetPropertiesResponse Response = RunSetProperties(WorldControl, Request);
+
+	TestEqual(TEXT("Sets a struct member through the cache"), Actor->GetRootComponent()->GetRelativeLocation().Y, 7.0);
+	TestEqual(TEXT("Sets a top-level property through the cache"), Actor->InitialLifeSpan, 3.0f);
+	if (TestEqual(TEXT("Two failures"), Response.failures_size(), 2))
+	{
+		TestEqual(TEXT("Type mismatch fails"), Response.failures(0).op_index(), 2u);
+		TestEqual(TEXT("Type mismatch code"), Response.failures(0).code(), static_cast<int32>(grpc::FAILED_PRECONDITION));
+		TestEqual(TEXT("Unknown struct member fails"), Response.failures(1).op_index(), 3u);
+		TestEqual(TEXT("Unknown struct member code"), Response.failures(1).code(), static_cast<int32>(grpc::NOT_FOUND));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoPropertyPathCacheHandlesTest,
+	"Tempo.World.PropertyPathCache.Handles", TempoPropertyPathCacheTestFlags)
+bool FTempoPropertyPathCacheHandlesTest::RunTest(const FString& Parameters)
+{
+	const FPropertyPathCacheTestFixture Fixture;
+	UTempoWorldControlServiceSubsystem* WorldControl = Fixture.World->GetSubsystem<UTempoWorldControlServiceSubsystem>();
+	if (!TestNotNull(TEXT("Game worlds have a world control service"), WorldControl))
+	{
+		return false;
+	}
+	AActor* Actor = Fixture.SpawnWithRoot();
+	const std::string ActorName(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(Actor)));
+
+	TempoWorld::PreparePropertyHandlesRequest PrepareRequest;
+	TempoWorld::PropertyPath* Location = PrepareRequest.add_properties();
+	Location->set_actor(ActorName);
+	Location->set_component("Root");
+	Location->set_property("RelativeLocation.Z");
+	TempoWorld::PropertyPath* LifeSpan = PrepareRequest.add_properties();
+	LifeSpan->set_actor(ActorName);
+	LifeSpan->set_property("InitialLifeSpan");
+	TempoWorld::PropertyPath* Missing = PrepareRequest.add_properties();
+	Missing->set_actor(ActorName);
+	Missing->set_property("NoSuchProperty");
+
+	const TempoWorld::PreparePropertyHandlesResponse PrepareResponse = RunPreparePropertyHandles(WorldControl, PrepareRequest);
+	if (!TestEqual(TEXT("One handle per property"), PrepareResponse.handles_size(), 3))
+	{
+		return false;
+	}
+	TestTrue(TEXT("Valid properties get handles"), PrepareResponse.handles(0) != 0 && PrepareResponse.handles(1) != 0);
+	TestEqual(TEXT("Invalid properties get no handle"), static_cast<uint64>(PrepareResponse.handles(2)), static_cast<uint64>(0));
+	if (TestEqual(TEXT("One prepare failure"), PrepareResponse.failures_size(), 1))
+	{
+		TestEqual(TEXT("Prepare failure index"), PrepareResponse.failures(0).op_index(), 2u);
+	}
+
+	TempoWorld::SetPropertiesByHandleRequest SetRequest;
+	TempoWorld::SetPropertyByHandleOp* SetLocation = SetRequest.add_ops();
+	SetLocation->set_handle(PrepareResponse.handles(0));
+	SetLocation->mutable_op()->mutable_float_op()->set_actor("IgnoredActorName");
+	SetLocation->mutable_op()->mutable_float_op()->set_value(11.0f);
+	TempoWorld::SetPropertyByHandleOp* SetLifeSpan = SetRequest.add_ops();
+	SetLifeSpan->set_handle(PrepareResponse.handles(1));
+	SetLifeSpan->mutable_op()->mutable_float_op()->set_value(5.0f);
+	TempoWorld::SetPropertyByHandleOp* WrongType = SetRequest.add_ops();
+	WrongType->set_handle(PrepareResponse.handles(1));
+	WrongType->mutable_op()->mutable_bool_op()->set_value(true);
+	SetRequest.add_ops()->set_handle(12345678);
+
+	TempoWorld::SetPropertiesResponse SetResponse = RunSetPropertiesByHandle(WorldControl, SetRequest);
+	TestEqual(TEXT("Sets a struct member by handle"), Actor->GetRootComponent()->GetRelativeLocation().Z, 11.0);
+	TestEqual(TEXT("Sets a top-level property by handle"), Actor->InitialLifeSpan, 5.0f);
+	if (TestEqual(TEXT("Two set failures"), SetResponse.failures_size(), 2))
+	{
+		TestEqual(TEXT("Type mismatch by handle"), SetResponse.failures(0).code(), static_cast<int32>(grpc::FAILED_PRECONDITION));
+		TestEqual(TEXT("Unknown handle"), SetResponse.failures(1).code(), static_cast<int32>(grpc::NOT_FOUND));
+	}
+
+	// Handles survive the cache being dropped (as when types are reinstanced).
+	FTempoPropertyPathCache::Get().Reset();
+	SetRequest.mutable_ops()->DeleteSubrange(2, 2);
+	SetRequest.mutable_ops(1)->mutable_op()->mutable_float_op()->set_value(6.0f);
+	SetResponse = RunSetPropertiesByHandle(WorldControl, SetRequest);
+	TestEqual(TEXT("Handles re-resolve after a reset"), SetResponse.failures_size(), 0);
+	TestEqual(TEXT("Set after a reset"), Actor->InitialLifeSpan, 6.0f);
+
+	Actor->Destroy();
+	SetResponse = RunSetPropertiesByHandle(WorldControl, SetRequest);
+	TestEqual(TEXT("Handles to destroyed objects fail"), SetResponse.failures_size(), 2);
+
+	TempoWorld::ReleasePropertyHandlesRequest ReleaseRequest;
+	ReleaseRequest.add_handles(PrepareResponse.handles(0));
+	WorldControl->ReleasePropertyHandles(ReleaseRequest, TResponseDelegate<TempoCore::Empty>());
+	SetResponse = RunSetPropertiesByHandle(WorldControl, SetRequest);
+	if (TestEqual(TEXT("Still two failures"), SetResponse.failures_size(), 2))
+	{
+		TestTrue(TEXT("Released handles are unknown"), FString(UTF8_TO_TCHAR(SetResponse.failures(0).error().c_str())).StartsWith(TEXT("Unknown property handle")));
+	}
+
+	WorldControl->ReleasePropertyHandles(TempoWorld::ReleasePropertyHandlesRequest(), TResponseDelegate<TempoCore::Empty>());
+	SetResponse = RunSetPropertiesByHandle(WorldControl, SetRequest);
+	if (TestEqual(TEXT("Still two failures after an empty release"), SetResponse.failures_size(), 2))
+	{
+		TestFalse(TEXT("An empty release releases nothing"), FString(UTF8_TO_TCHAR(SetResponse.failures(1).error().c_str())).StartsWith(TEXT("Unknown property handle")));
+	}
+
+	TempoWorld::ReleasePropertyHandlesRequest ReleaseAllRequest;
+	ReleaseAllRequest.set_all(true);
+	WorldControl->ReleasePropertyHandles(ReleaseAllRequest, TResponseDelegate<TempoCore::Empty>());
+	SetResponse = RunSetPropertiesByHandle(WorldControl, SetRequest);
+	if (TestEqual(TEXT("Still two failures after releasing all"), SetResponse.failures_size(), 2))
+	{
+		TestTrue(TEXT("Releasing all releases every handle"), FString(UTF8_TO_TCHAR(SetResponse.failures(1).error().c_str())).StartsWith(TEXT("Unknown property handle")));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoPropertyPathCacheBenchmarkTest,
+	"Tempo.World.PropertyPathCache.SetPropertiesThroughput", TempoPropertyPathCacheTestFlags)
+bool FTempoPropertyPathCacheBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumActors = 300;
+	constexpr int32 NumEpisodes = 10;
+	const TPair<const char*, const char*> Properties[] = {
+		{ "Root", "RelativeLocation.X" }, { "Root", "RelativeLocation.Y" }, { "Root", "RelativeLocation.Z" },
+		{ "Root", "RelativeRotation.Pitch" }, { "Root", "RelativeRotation.Yaw" }, { "Root", "RelativeRotation.Roll" },
+		{ "Root", "RelativeScale3D.X" }, { "Root", "RelativeScale3D.Y" }, { "Root", "RelativeScale3D.Z" },
+		{ "", "InitialLifeSpan" }, { "", "CustomTimeDilation" },
+	};
+	const int32 NumOps = NumActors * UE_ARRAY_COUNT(Properties);
+
+	const FPropertyPathCacheTestFixture Fixture;
+	UTempoWorldControlServiceSubsystem* WorldControl = Fixture.World->GetSubsystem<UTempoWorldControlServiceSubsystem>();
+	if (!TestNotNull(TEXT("Game worlds have a world control service"), WorldControl))
+	{
+		return false;
+	}
+
+	TempoWorld::SetPropertiesRequest SetRequest;
+	TempoWorld::PreparePropertyHandlesRequest PrepareRequest;
+	for (int32 I = 0; I < NumActors; ++I)
+	{
+		const std::string ActorName(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(Fixture.SpawnWithRoot())));
+		for (const TPair<const char*, const char*>& Property : Properties)
+		{
+			AddFloatOp(SetRequest, ActorName, Property.Key, Property.Value, 1.0f + I);
+			TempoWorld::PropertyPath* Path = PrepareRequest.add_properties();
+			Path->set_actor(ActorName);
+			Path->set_component(Property.Key);
+			Path->set_property(Property.Value);
+		}
+	}
+
+	FTempoPropertyPathCache& Cache = FTempoPropertyPathCache::Get();
+	Cache.Reset();
+	const uint64 MissesBefore = Cache.GetNumMisses();
+
+	double Start = FPlatformTime::Seconds();
+	int32 NumFailed = RunSetProperties(WorldControl, SetRequest).failures_size();
+	const double ColdSeconds = FPlatformTime::Seconds() - Start;
+
+	Start = FPlatformTime::Seconds();
+	for (int32 Episode = 0; Episode < NumEpisodes; ++Episode)
+	{
+		NumFailed += RunSetProperties(WorldControl, SetRequest).failures_size();
+	}
+	const double WarmSeconds = (FPlatformTime::Seconds() - Start) / NumEpisodes;
+	TestEqual(TEXT("Each distinct class and path misses once"), Cache.GetNumMisses() - MissesBefore, static_cast<uint64>(UE_ARRAY_COUNT(Properties)));
+
+	const TempoWorld::PreparePropertyHandlesResponse PrepareResponse = RunPreparePropertyHandles(WorldControl, PrepareRequest);
+	TestEqual(TEXT("Every property is prepared"), PrepareResponse.failures_size(), 0);
+	TempoWorld::SetPropertiesByHandleRequest HandleRequest;
+	for (int32 I = 0; I < PrepareResponse.handles_size(); ++I)
+	{
+		TempoWorld::SetPropertyByHandleOp* Op = HandleRequest.add_ops();
+		Op->set_handle(PrepareResponse.handles(I));
+		Op->mutable_op()->mutable_float_op()->set_value(2.0f);
+	}
+
+	Start = FPlatformTime::Seconds();
+	for (int32 Episode = 0; Episode < NumEpisodes; ++Episode)
+	{
+		NumFailed += RunSetPropertiesByHandle(WorldControl, HandleRequest).failures_size();
+	}
+	const double HandleSeconds = (FPlatformTime::Seconds() - Start) / NumEpisodes;
+	TestEqual(TEXT("Every set succeeds"), NumFailed, 0);
+
+	// The lookups alone, as they were done before the cache.
+	const UClass* Classes[] = { USceneComponent::StaticClass(), AActor::StaticClass() };
+	int32 NumUnresolved = 0;
+	Start = FPlatformTime::Seconds();
+	for (int32 I = 0; I < NumActors; ++I)
+	{
+		for (const TPair<const char*, const char*>& Property : Properties)
+		{
+			NumUnresolved += UncachedLookup(Classes[*Property.Key ? 0 : 1], UTF8_TO_TCHAR(Property.Value)) == nullptr;
+		}
+	}
+	const double UncachedLookupSeconds = FPlatformTime::Seconds() - Start;
+	TestEqual(TEXT("The baseline lookup resolves every property"), NumUnresolved, 0);
+
+	AddInfo(FString::Printf(TEXT("%d actors x %d properties: SetProperties %.3f us/op cold, %.3f us/op warm; SetPropertiesByHandle %.3f us/op; uncached lookup alone %.3f us/op"),
+		NumActors, static_cast<int32>(UE_ARRAY_COUNT(Properties)), ColdSeconds * 1e6 / NumOps, WarmSeconds * 1e6 / NumOps,
+		HandleSeconds * 1e6 / NumOps, UncachedLookupSeconds * 1e6 / NumOps));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,272 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoWorldStateServiceSubsystem.h"
+
+#include "TempoCoreUtils.h"
+#include "TempoTestWorld.h"
+
+#include "TempoWorld/WorldState.grpc.pb.h"
+
+#include "Components/BoxComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+// Tests for SceneQueries: single and multi-hit traces, shape sweeps, ignored actors, and the time to run a mixed
+// batch against the same queries sent one per request. Run with
+//   Automation RunTests Tempo.World.SceneQueries
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoSceneQueriesTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	struct FSceneQueriesTestFixture : FTempoTestWorld
+	{
+		UTempoWorldStateServiceSubsystem* WorldState = nullptr;
+
+		FSceneQueriesTestFixture()
+		{
+			WorldState = World->GetSubsystem<UTempoWorldStateServiceSubsystem>();
+		}
+
+		// A box collider centered at Center with HalfExtent, in meters. It blocks every channel, or overlaps
+		// every channel if !bBlocking.
+		AActor* AddBox(const FVector& Center, const FVector& HalfExtent, bool bBlocking = true) const
+		{
+			AActor* Actor = World->SpawnActor<AActor>();
+			UBoxComponent* Box = NewObject<UBoxComponent>(Actor, TEXT("Box"));
+			Box->SetBoxExtent(HalfExtent * 100.0, false);
+			Box->SetCollisionProfileName(bBlocking ? UCollisionProfile::BlockAll_ProfileName : TEXT("OverlapAll"));
+			Actor->SetRootComponent(Box);
+			Box->RegisterComponent();
+			Actor->SetActorLocation(Center * 100.0);
+			return Actor;
+		}
+
+		// Lets the physics scene take in the colliders added so far.
+		void Tick() const
+		{
+			World->Tick(LEVELTICK_All, 1.0f / 60.0f);
+		}
+
+		TempoWorld::SceneQueriesResponse Run(const TempoWorld::SceneQueriesRequest& Request) const
+		{
+			TempoWorld::SceneQueriesResponse Result;
+			WorldState->SceneQueries(Request, TResponseDelegate<TempoWorld::SceneQueriesResponse>::CreateLambda(
+				[&Result](const TempoWorld::SceneQueriesResponse& Response, grpc::Status)
+				{
+					Result = Response;
+				}));
+			return Result;
+		}
+	};
+
+	// A query from Start to End, in meters. Tempo's frame only flips Y, and the test scenes are symmetric in Y.
+	TempoWorld::SceneQuery* AddQuery(TempoWorld::SceneQueriesRequest& Request, const FVector& Start, const FVector& End)
+	{
+		TempoWorld::SceneQuery* Query = Request.add_queries();
+		Query->mutable_start()->set_x(Start.X);
+		Query->mutable_start()->set_y(Start.Y);
+		Query->mutable_start()->set_z(Start.Z);
+		Query->mutable_end()->set_x(End.X);
+		Query->mutable_end()->set_y(End.Y);
+		Query->mutable_end()->set_z(End.Z);
+		return Query;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoSceneQueriesHitsTest,
+	"Tempo.World.SceneQueries.Hits", TempoSceneQueriesTestFlags)
+bool FTempoSceneQueriesHitsTest::RunTest(const FString& Parameters)
+{
+	const FSceneQueriesTestFixture Fixture;
+	if (!TestNotNull(TEXT("Game worlds have a world state service"), Fixture.WorldState))
+	{
+		return false;
+	}
+
+	// A wall whose near face is at x = 9.5 m, behind a box that only overlaps, whose near face is at x = 4.5 m.
+	const AActor* Wall = Fixture.AddBox(FVector(10.0, 0.0, 0.0), FVector(0.5, 0.5, 0.5));
+	Fixture.AddBox(FVector(5.0, 0.0, 0.0), FVector(0.5, 0.5, 0.5), /*bBlocking=*/false);
+	Fixture.Tick();
+
+	const FVector Start(0.0, 0.0, 0.0);
+	const FVector End(20.0, 0.0, 0.0);
+	TempoWorld::SceneQueriesRequest Request;
+	AddQuery(Request, Start, End);
+	AddQuery(Request, Start, End)->set_multi(true);
+	TempoWorld::SceneQuery* Nearest = AddQuery(Request, Start, End);
+	Nearest->set_multi(true);
+	Nearest->set_max_hits(1);
+	AddQuery(Request, Start, End)->mutable_shape()->set_sphere_radius_m(0.5f);
+	TempoWorld::SweepShape* Bar = AddQuery(Request, Start, End)->mutable_shape();
+	Bar->mutable_box_half_extent_m()->set_x(2.0);
+	Bar->mutable_box_half_extent_m()->set_y(0.1);
+	Bar->mutable_box_half_extent_m()->set_z(0.1);
+	TempoWorld::SweepShape* TurnedBar = AddQuery(Request, Start, End)->mutable_shape();
+	*TurnedBar = *Bar;
+	TurnedBar->mutable_rotation()->set_y(UE_HALF_PI);
+	// Passes beside the wall, so only a wide enough shape hits it.
+	AddQuery(Request, FVector(0.0, 1.0, 0.0), FVector(20.0, 1.0, 0.0));
+	TempoWorld::CapsuleShape* Capsule = AddQuery(Request, FVector(0.0, 1.0, 0.0), FVector(20.0, 1.0, 0.0))->mutable_shape()->mutable_capsule();
+	Capsule->set_radius_m(0.75f);
+	Capsule->set_half_height_m(1.0f);
+	AddQuery(Request, Start, End)->add_ignored_actors(TCHAR_TO_UTF8(*UTempoCoreUtils::GetActorIdentifier(Wall)));
+
+	const TempoWorld::SceneQueriesResponse Response = Fixture.Run(Request);
+	if (!TestEqual(TEXT("There is one result per query"), Response.results_size(), Request.queries_size()))
+	{
+		return false;
+	}
+
+	const auto ExpectHits = [this, &Response](int32 QueryIndex, const TArray<double>& Distances, const TCHAR* What)
+	{
+		const TempoWorld::SceneQueryResult& Result = Response.results(QueryIndex);
+		if (!TestEqual(FString::Printf(TEXT("%s: number of hits"), What), Result.hits_size(), Distances.Num()))
+		{
+			return;
+		}
+		for (int32 HitIndex = 0; HitIndex < Distances.Num(); ++HitIndex)
+		{
+			TestEqual(FString::Printf(TEXT("%s: distance of hit %d"), What, HitIndex), static_cast<double>(Result.hits(HitIndex).distance_m()), Distances[HitIndex], 0.01);
+		}
+	};
+	ExpectHits(0, { 9.5 }, TEXT("A single line trace stops at the wall"));
+	ExpectHits(1, { 4.5, 9.5 }, TEXT("A multi line trace reports the overlap, then the wall"));
+	ExpectHits(2, { 4.5 }, TEXT("max_hits keeps the nearest hits"));
+	ExpectHits(3, { 9.0 }, TEXT("A sphere sweep stops a radius short of the wall"));
+	ExpectHits(4, { 7.5 }, TEXT("A box sweep stops a half extent short of the wall"));
+	ExpectHits(5, { 9.4 }, TEXT("A rotated box sweep uses its rotated extent"));
+	ExpectHits(6, { }, TEXT("A line beside the wall misses it"));
+	ExpectHits(7, { 9.5 - FMath::Sqrt(FMath::Square(0.75) - FMath::Square(0.5)) }, TEXT("A capsule beside the wall hits it"));
+	ExpectHits(8, { }, TEXT("Ignored actors aren't hit"));
+
+	if (Response.results(0).hits_size() != 1 || Response.results(1).hits_size() != 2)
+	{
+		return false;
+	}
+	const TempoWorld::SceneQueryHit& WallHit = Response.results(0).hits(0);
+	TestTrue(TEXT("Single hits are blocking"), WallHit.blocking());
+	TestFalse(TEXT("Overlaps are not blocking"), Response.results(1).hits(0).blocking());
+	TestTrue(TEXT("The hit that ends a multi query is blocking"), Response.results(1).hits(1).blocking());
+	TestEqual(TEXT("The hit location is on the wall's face"), WallHit.location().x(), 9.5, 0.01);
+	TestEqual(TEXT("The hit normal faces the query"), WallHit.normal().x(), -1.0, 0.01);
+	if (TestTrue(TEXT("Hits reference the actor table"), WallHit.actor_index() >= 0 && WallHit.actor_index() < Response.actors_size()))
+	{
+		TestEqual(TEXT("Hits name the actor they hit"), FString(UTF8_TO_TCHAR(Response.actors(WallHit.actor_index()).c_str())), UTempoCoreUtils::GetActorIdentifier(Wall));
+	}
+	TestEqual(TEXT("Each actor is listed once"), Response.actors_size(), 2);
+	TestEqual(TEXT("Each component is listed once"), Response.components_size(), 2);
+
+	TestEqual(TEXT("An empty batch has no results"), Fixture.Run(TempoWorld::SceneQueriesRequest()).results_size(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoSceneQueriesBenchmarkTest,
+	"Tempo.World.SceneQueries.Benchmark", TempoSceneQueriesTestFlags)
+bool FTempoSceneQueriesBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 GridSize = 40;
+	constexpr double GridSpacingM = 5.0;
+	constexpr int32 NumQueries = 4000;
+	constexpr int32 NumRepeats = 5;
+
+	const FSceneQueriesTestFixture Fixture;
+	if (!TestNotNull(TEXT("Game worlds have a world state service"), Fixture.WorldState))
+	{
+		return false;
+	}
+
+	// A grid of boxes of random sizes, one in five of which only overlap.
+	FRandomStream Random(38);
+	for (int32 X = 0; X < GridSize; ++X)
+	{
+		for (int32 Y = 0; Y < GridSize; ++Y)
+		{
+			const FVector HalfExtent(Random.FRandRange(0.5, 2.0), Random.FRandRange(0.5, 2.0), Random.FRandRange(0.5, 4.0));
+			Fixture.AddBox(FVector(X * GridSpacingM, Y * GridSpacingM, HalfExtent.Z), HalfExtent, Random.RandRange(0, 4) != 0);
+		}
+	}
+	Fixture.Tick();
+
+	// Queries 10 to 40 m long across the grid, cycling through the kinds of query.
+	TempoWorld::SceneQueriesRequest Batch;
+	const double GridExtent = (GridSize - 1) * GridSpacingM;
+	for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+	{
+		const FVector Start(Random.FRandRange(0.0, GridExtent), Random.FRandRange(0.0, GridExtent), Random.FRandRange(0.5, 3.0));
+		const FVector End = Start + Random.GetUnitVector().GetSafeNormal2D() * Random.FRandRange(10.0, 40.0);
+		TempoWorld::SceneQuery* Query = AddQuery(Batch, Start, End);
+		switch (QueryIndex % 5)
+		{
+		case 1:
+			Query->set_multi(true);
+			break;
+		case 2:
+			Query->mutable_shape()->set_sphere_radius_m(0.5f);
+			break;
+		case 3:
+			Query->mutable_shape()->mutable_box_half_extent_m()->set_x(2.25);
+			Query->mutable_shape()->mutable_box_half_extent_m()->set_y(0.9);
+			Query->mutable_shape()->mutable_box_half_extent_m()->set_z(0.75);
+			Query->mutable_shape()->mutable_rotation()->set_y(FMath::Atan2(End.Y - Start.Y, End.X - Start.X));
+			break;
+		case 4:
+			Query->mutable_shape()->mutable_capsule()->set_radius_m(0.3f);
+			Query->mutable_shape()->mutable_capsule()->set_half_height_m(0.9f);
+			Query->set_multi(true);
+			break;
+		default:
+			break;
+		}
+	}
+
+	TempoWorld::SceneQueriesResponse BatchResponse;
+	double BatchSeconds = TNumericLimits<double>::Max();
+	for (int32 Repeat = 0; Repeat < NumRepeats; ++Repeat)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		BatchResponse = Fixture.Run(Batch);
+		BatchSeconds = FMath::Min(BatchSeconds, FPlatformTime::Seconds() - StartTime);
+	}
+
+	// The same queries, one per request, as a client without batching would send them.
+	TArray<int32> SingleNumHits;
+	SingleNumHits.Reserve(NumQueries);
+	const double SingleStartTime = FPlatformTime::Seconds();
+	for (const TempoWorld::SceneQuery& Query : Batch.queries())
+	{
+		TempoWorld::SceneQueriesRequest Single;
+		*Single.add_queries() = Query;
+		SingleNumHits.Add(Fixture.Run(Single).results(0).hits_size());
+	}
+	const double SingleSeconds = FPlatformTime::Seconds() - SingleStartTime;
+
+	if (!TestEqual(TEXT("There is one result per query"), BatchResponse.results_size(), NumQueries))
+	{
+		return false;
+	}
+	int32 NumMismatches = 0;
+	int32 NumHits = 0;
+	for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+	{
+		NumHits += BatchResponse.results(QueryIndex).hits_size();
+		NumMismatches += BatchResponse.results(QueryIndex).hits_size() != SingleNumHits[QueryIndex];
+	}
+	TestEqual(TEXT("Batched and single queries find the same hits"), NumMismatches, 0);
+	TestTrue(TEXT("The queries hit the scene"), NumHits > 0);
+
+	AddInfo(FString::Printf(TEXT("%d mixed queries on %d boxes: batched %.2f ms (%.2f us/query), one per request %.2f ms (%.1fx), %d hits on %d actors"),
+		NumQueries, GridSize * GridSize, BatchSeconds * 1e3, BatchSeconds * 1e6 / NumQueries, SingleSeconds * 1e3,
+		SingleSeconds / FMath::Max(BatchSeconds, 1e-9), NumHits, BatchResponse.actors_size()));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
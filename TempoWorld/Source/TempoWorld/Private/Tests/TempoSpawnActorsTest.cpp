@@ -0,0 +1,221 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoWorldControlServiceSubsystem.h"
+#include "TempoWorldUtils.h"
+#include "TempoTestWorld.h"
+
+#include "TempoWorld/WorldControl.grpc.pb.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+
+// Tests for the batched SpawnActors and DestroyActors RPCs: per-entry status, deferred properties, and
+// throughput against one SpawnActor/DestroyActor call per actor. Run with
+//   Automation RunTests Tempo.World.SpawnActors
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoSpawnActorsTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	TempoWorld::SpawnActorsEntry* AddEntry(TempoWorld::SpawnActorsRequest& Request, const char* ActorType, double Y)
+	{
+		TempoWorld::SpawnActorsEntry* Entry = Request.add_actors();
+		Entry->set_actor_type(ActorType);
+		Entry->mutable_transform()->mutable_location()->set_y(Y);
+		return Entry;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoSpawnActorsStatusTest,
+	"Tempo.World.SpawnActors.Status", TempoSpawnActorsTestFlags)
+bool FTempoSpawnActorsStatusTest::RunTest(const FString& Parameters)
+{
+	const FTempoTestWorld Fixture;
+	UTempoWorldControlServiceSubsystem* WorldControl = Fixture.World->GetSubsystem<UTempoWorldControlServiceSubsystem>();
+	if (!TestNotNull(TEXT("Game worlds have a world control service"), WorldControl))
+	{
+		return false;
+	}
+
+	TempoWorld::SpawnActorsRequest SpawnRequest;
+	AddEntry(SpawnRequest, "Actor", 0.0);
+	AddEntry(SpawnRequest, "NoSuchActorClass", 100.0);
+	TempoWorld::SpawnActorsEntry* WithProperties = AddEntry(SpawnRequest, "Actor", 200.0);
+	TempoWorld::SetFloatPropertyRequest* LifeSpan = WithProperties->add_deferred_properties()->mutable_float_op();
+	LifeSpan->set_actor("IgnoredActorName");
+	LifeSpan->set_property("InitialLifeSpan");
+	LifeSpan->set_value(123.0);
+	TempoWorld::SetFloatPropertyRequest* BadProperty = WithProperties->add_deferred_properties()->mutable_float_op();
+	BadProperty->set_property("NoSuchProperty");
+	BadProperty->set_value(1.0);
+	AddEntry(SpawnRequest, "Actor", 300.0)->set_deferred(true);
+
+	TempoWorld::SpawnActorsResponse SpawnResponse;
+	WorldControl->SpawnActors(SpawnRequest, TResponseDelegate<TempoWorld::SpawnActorsResponse>::CreateLambda(
+		[this, &SpawnResponse](const TempoWorld::SpawnActorsResponse& Response, grpc::Status Status)
+		{
+			TestTrue(TEXT("SpawnActors succeeds as a whole"), Status.ok());
+			SpawnResponse = Response;
+		}));
+
+	if (!TestEqual(TEXT("One result per entry"), SpawnResponse.results_size(), SpawnRequest.actors_size()))
+	{
+		return false;
+	}
+
+	const TempoWorld::SpawnActorsResult& Plain = SpawnResponse.results(0);
+	TestEqual(TEXT("Plain spawn succeeds"), Plain.code(), static_cast<int32>(grpc::OK));
+	TestNotNull(TEXT("Plain spawn is findable by name"), GetActorWithName(Fixture.World, UTF8_TO_TCHAR(Plain.name().c_str())));
+
+	const TempoWorld::SpawnActorsResult& BadClass = SpawnResponse.results(1);
+	TestEqual(TEXT("Unknown class fails its entry only"), BadClass.code(), static_cast<int32>(grpc::NOT_FOUND));
+	TestTrue(TEXT("Failed entry has no name"), BadClass.name().empty());
+
+	const TempoWorld::SpawnActorsResult& Configured = SpawnResponse.results(2);
+	TestEqual(TEXT("Spawn with deferred properties succeeds"), Configured.code(), static_cast<int32>(grpc::OK));
+	const AActor* ConfiguredActor = GetActorWithName(Fixture.World, UTF8_TO_TCHAR(Configured.name().c_str()));
+	if (TestNotNull(TEXT("Spawn with deferred properties is findable"), ConfiguredActor))
+	{
+		TestEqual(TEXT("Deferred property targets the new actor"), ConfiguredActor->InitialLifeSpan, 123.0f);
+		TestTrue(TEXT("Spawn with deferred properties is finished"), ConfiguredActor->IsActorInitialized());
+	}
+	if (TestEqual(TEXT("One property failure"), Configured.property_failures_size(), 1))
+	{
+		TestEqual(TEXT("Property failure is reported by op index"), Configured.property_failures(0).op_index(), 1u);
+	}
+
+	const TempoWorld::SpawnActorsResult& Deferred = SpawnResponse.results(3);
+	TestEqual(TEXT("Deferred spawn succeeds"), Deferred.code(), static_cast<int32>(grpc::OK));
+	int32 FinishStatus = -1;
+	TempoWorld::FinishSpawningActorRequest FinishRequest;
+	FinishRequest.set_actor(Deferred.name());
+	WorldControl->FinishSpawningActor(FinishRequest, TResponseDelegate<TempoWorld::FinishSpawningActorResponse>::CreateLambda(
+		[&FinishStatus](const TempoWorld::FinishSpawningActorResponse&, grpc::Status Status)
+		{
+			FinishStatus = Status.error_code();
+		}));
+	TestEqual(TEXT("Deferred spawn can be finished"), FinishStatus, static_cast<int32>(grpc::OK));
+
+	TempoWorld::DestroyActorsRequest DestroyRequest;
+	DestroyRequest.add_actors(Plain.name());
+	DestroyRequest.add_actors("NoSuchActor");
+	DestroyRequest.add_actors(Configured.name());
+	TempoWorld::DestroyActorsResponse DestroyResponse;
+	WorldControl->DestroyActors(DestroyRequest, TResponseDelegate<TempoWorld::DestroyActorsResponse>::CreateLambda(
+		[&DestroyResponse](const TempoWorld::DestroyActorsResponse& Response, grpc::Status)
+		{
+			DestroyResponse = Response;
+		}));
+	if (TestEqual(TEXT("One destroy failure"), DestroyResponse.failures_size(), 1))
+	{
+		TestEqual(TEXT("Destroy failure is reported by index"), DestroyResponse.failures(0).index(), 1u);
+		TestEqual(TEXT("Destroy failure code"), DestroyResponse.failures(0).code(), static_cast<int32>(grpc::NOT_FOUND));
+	}
+	TestNull(TEXT("Destroyed actors are gone"), GetActorWithName(Fixture.World, UTF8_TO_TCHAR(Plain.name().c_str())));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoSpawnActorsThroughputTest,
+	"Tempo.World.SpawnActors.Throughput", TempoSpawnActorsTestFlags)
+bool FTempoSpawnActorsThroughputTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumActors = 2000;
+
+	double BatchSpawnSeconds = 0.0;
+	double BatchDestroySeconds = 0.0;
+	{
+		const FTempoTestWorld Fixture;
+		UTempoWorldControlServiceSubsystem* WorldControl = Fixture.World->GetSubsystem<UTempoWorldControlServiceSubsystem>();
+		if (!TestNotNull(TEXT("Game worlds have a world control service"), WorldControl))
+		{
+			return false;
+		}
+
+		TempoWorld::SpawnActorsRequest SpawnRequest;
+		for (int32 I = 0; I < NumActors; ++I)
+		{
+			AddEntry(SpawnRequest, "Actor", I * 10.0);
+		}
+
+		TempoWorld::DestroyActorsRequest DestroyRequest;
+		int32 NumSpawned = 0;
+		double Start = FPlatformTime::Seconds();
+		WorldControl->SpawnActors(SpawnRequest, TResponseDelegate<TempoWorld::SpawnActorsResponse>::CreateLambda(
+			[&DestroyRequest, &NumSpawned](const TempoWorld::SpawnActorsResponse& Response, grpc::Status)
+			{
+				for (const TempoWorld::SpawnActorsResult& Result : Response.results())
+				{
+					NumSpawned += Result.code() == grpc::OK;
+					DestroyRequest.add_actors(Result.name());
+				}
+			}));
+		BatchSpawnSeconds = FPlatformTime::Seconds() - Start;
+		TestEqual(TEXT("SpawnActors spawns every entry"), NumSpawned, NumActors);
+
+		int32 NumDestroyFailures = -1;
+		Start = FPlatformTime::Seconds();
+		WorldControl->DestroyActors(DestroyRequest, TResponseDelegate<TempoWorld::DestroyActorsResponse>::CreateLambda(
+			[&NumDestroyFailures](const TempoWorld::DestroyActorsResponse& Response, grpc::Status)
+			{
+				NumDestroyFailures = Response.failures_size();
+			}));
+		BatchDestroySeconds = FPlatformTime::Seconds() - Start;
+		TestEqual(TEXT("DestroyActors destroys every actor"), NumDestroyFailures, 0);
+	}
+
+	double SingleSpawnSeconds = 0.0;
+	double SingleDestroySeconds = 0.0;
+	{
+		const FTempoTestWorld Fixture;
+		UTempoWorldControlServiceSubsystem* WorldControl = Fixture.World->GetSubsystem<UTempoWorldControlServiceSubsystem>();
+
+		TArray<std::string> Names;
+		TempoWorld::SpawnActorRequest SpawnRequest;
+		SpawnRequest.set_actor_type("Actor");
+		const TResponseDelegate<TempoWorld::SpawnActorResponse> SpawnContinuation = TResponseDelegate<TempoWorld::SpawnActorResponse>::CreateLambda(
+			[&Names](const TempoWorld::SpawnActorResponse& Response, grpc::Status Status)
+			{
+				if (Status.ok())
+				{
+					Names.Add(Response.name());
+				}
+			});
+
+		double Start = FPlatformTime::Seconds();
+		for (int32 I = 0; I < NumActors; ++I)
+		{
+			SpawnRequest.mutable_transform()->mutable_location()->set_y(I * 10.0);
+			WorldControl->SpawnActor(SpawnRequest, SpawnContinuation);
+		}
+		SingleSpawnSeconds = FPlatformTime::Seconds() - Start;
+		TestEqual(TEXT("SpawnActor spawns every actor"), Names.Num(), NumActors);
+
+		int32 NumDestroyFailures = 0;
+		const TResponseDelegate<TempoCore::Empty> DestroyContinuation = TResponseDelegate<TempoCore::Empty>::CreateLambda(
+			[&NumDestroyFailures](const TempoCore::Empty&, grpc::Status Status)
+			{
+				NumDestroyFailures += !Status.ok();
+			});
+		TempoWorld::DestroyActorRequest DestroyRequest;
+		Start = FPlatformTime::Seconds();
+		for (const std::string& Name : Names)
+		{
+			DestroyRequest.set_actor(Name);
+			WorldControl->DestroyActor(DestroyRequest, DestroyContinuation);
+		}
+		SingleDestroySeconds = FPlatformTime::Seconds() - Start;
+		TestEqual(TEXT("DestroyActor destroys every actor"), NumDestroyFailures, 0);
+	}
+
+	AddInfo(FString::Printf(TEXT("%d actors: SpawnActors %.0f actors/s vs SpawnActor %.0f actors/s; DestroyActors %.0f actors/s vs DestroyActor %.0f actors/s"),
+		NumActors, NumActors / BatchSpawnSeconds, NumActors / SingleSpawnSeconds, NumActors / BatchDestroySeconds, NumActors / SingleDestroySeconds));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
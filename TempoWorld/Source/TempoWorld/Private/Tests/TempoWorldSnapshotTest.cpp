@@ -0,0 +1,279 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoWorldControlServiceSubsystem.h"
+#include "TempoWorldSnapshot.h"
+#include "TempoTestWorld.h"
+
+#include "TempoWorld/WorldControl.grpc.pb.h"
+
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/DefaultPawn.h"
+#include "GameFramework/PawnMovementComponent.h"
+#include "Misc/AutomationTest.h"
+
+// Tests for SaveWorldSnapshot and RestoreWorldSnapshot: after each of 100 episodes that change the world, a
+// restore must put back exactly the saved state. Reports the slowest restore. Run with
+//   Automation RunTests Tempo.World.WorldSnapshot
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoWorldSnapshotTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	constexpr int32 NumPawns = 200;
+	constexpr int32 NumEpisodes = 100;
+
+	struct FWorldSnapshotTestFixture : FTempoTestWorld
+	{
+		// Default pawns have a movable root and a movement component.
+		ADefaultPawn* SpawnPawn(const FVector& Location) const
+		{
+			return World->SpawnActor<ADefaultPawn>(Location, FRotator::ZeroRotator);
+		}
+	};
+
+	// What the test checks a restore puts back, keyed by actor name.
+	struct FObservedState
+	{
+		double SimTime = 0.0;
+		TMap<FString, FTransform> Transforms;
+		TMap<FString, FVector> Velocities;
+		TMap<FString, float> TimeDilations;
+		TMap<FString, TArray<FName>> Tags;
+	};
+
+	FObservedState Observe(UWorld* World)
+	{
+		FObservedState State;
+		State.SimTime = World->GetTimeSeconds();
+		for (TActorIterator<ADefaultPawn> PawnIt(World); PawnIt; ++PawnIt)
+		{
+			const FString Name = PawnIt->GetName();
+			State.Transforms.Add(Name, PawnIt->GetActorTransform());
+			State.Velocities.Add(Name, PawnIt->GetMovementComponent()->Velocity);
+			State.TimeDilations.Add(Name, PawnIt->CustomTimeDilation);
+			State.Tags.Add(Name, PawnIt->Tags);
+		}
+		return State;
+	}
+
+	// Returns the first difference between Expected and Actual, or an empty string.
+	FString Difference(const FObservedState& Expected, const FObservedState& Actual)
+	{
+		if (Expected.SimTime != Actual.SimTime)
+		{
+			return FString::Printf(TEXT("sim time %f != %f"), Actual.SimTime, Expected.SimTime);
+		}
+		if (Expected.Transforms.Num() != Actual.Transforms.Num())
+		{
+			return FString::Printf(TEXT("%d actors != %d"), Actual.Transforms.Num(), Expected.Transforms.Num());
+		}
+		for (const TPair<FString, FTransform>& Saved : Expected.Transforms)
+		{
+			const FTransform* Transform = Actual.Transforms.Find(Saved.Key);
+			if (!Transform)
+			{
+				return FString::Printf(TEXT("'%s' is missing"), *Saved.Key);
+			}
+			if (!Transform->Equals(Saved.Value, 1e-4))
+			{
+				return FString::Printf(TEXT("'%s' is at %s, not %s"), *Saved.Key, *Transform->ToString(), *Saved.Value.ToString());
+			}
+			if (!Actual.Velocities[Saved.Key].Equals(Expected.Velocities[Saved.Key]))
+			{
+				return FString::Printf(TEXT("'%s' has velocity %s"), *Saved.Key, *Actual.Velocities[Saved.Key].ToString());
+			}
+			if (Actual.TimeDilations[Saved.Key] != Expected.TimeDilations[Saved.Key])
+			{
+				return FString::Printf(TEXT("'%s' has time dilation %f"), *Saved.Key, Actual.TimeDilations[Saved.Key]);
+			}
+			if (Actual.Tags[Saved.Key] != Expected.Tags[Saved.Key])
+			{
+				return FString::Printf(TEXT("'%s' has %d tags"), *Saved.Key, Actual.Tags[Saved.Key].Num());
+			}
+		}
+		return FString();
+	}
+
+	TempoWorld::PropertyPath* AddProperty(TempoWorld::SaveWorldSnapshotRequest& Request, const char* Property)
+	{
+		TempoWorld::PropertyPath* Path = Request.add_properties();
+		Path->set_property(Property);
+		return Path;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoWorldSnapshotRoundTripTest,
+	"Tempo.World.WorldSnapshot.RoundTrip", TempoWorldSnapshotTestFlags)
+bool FTempoWorldSnapshotRoundTripTest::RunTest(const FString& Parameters)
+{
+	const FWorldSnapshotTestFixture Fixture;
+	UTempoWorldControlServiceSubsystem* WorldControl = Fixture.World->GetSubsystem<UTempoWorldControlServiceSubsystem>();
+	if (!TestNotNull(TEXT("Game worlds have a world control service"), WorldControl))
+	{
+		return false;
+	}
+
+	FRandomStream Random(36);
+	for (int32 PawnIndex = 0; PawnIndex < NumPawns; ++PawnIndex)
+	{
+		ADefaultPawn* Pawn = Fixture.SpawnPawn(FVector(PawnIndex * 500.0, 0.0, 100.0));
+		Pawn->GetMovementComponent()->Velocity = FVector(Random.FRandRange(-500.0, 500.0), 0.0, 0.0);
+		Pawn->CustomTimeDilation = Random.FRandRange(0.5, 2.0);
+	}
+	Fixture.World->TimeSeconds = 12.5;
+
+	TempoWorld::SaveWorldSnapshotRequest SaveRequest;
+	SaveRequest.set_name("Start");
+	AddProperty(SaveRequest, "CustomTimeDilation");
+	AddProperty(SaveRequest, "Tags");
+
+	bool bSaved = false;
+	WorldControl->SaveWorldSnapshot(SaveRequest, TResponseDelegate<TempoWorld::SaveWorldSnapshotResponse>::CreateLambda(
+		[this, &bSaved](const TempoWorld::SaveWorldSnapshotResponse& Response, grpc::Status Status)
+		{
+			bSaved = Status.ok();
+			TestEqual(TEXT("Every pawn is captured"), static_cast<int32>(Response.num_actors()), NumPawns);
+			TestEqual(TEXT("Both properties are captured on every pawn"), static_cast<int32>(Response.num_properties()), 2 * NumPawns);
+			TestEqual(TEXT("The sim time is captured"), Response.sim_time(), 12.5);
+		}));
+	if (!TestTrue(TEXT("SaveWorldSnapshot succeeds"), bSaved))
+	{
+		return false;
+	}
+	const FObservedState Saved = Observe(Fixture.World);
+
+	TempoWorld::RestoreWorldSnapshotRequest RestoreRequest;
+	RestoreRequest.set_name("Start");
+
+	double SlowestRestore = 0.0;
+	int32 TotalRespawned = 0;
+	int32 TotalDestroyed = 0;
+	for (int32 Episode = 0; Episode < NumEpisodes; ++Episode)
+	{
+		TArray<ADefaultPawn*> Pawns;
+		for (TActorIterator<ADefaultPawn> PawnIt(Fixture.World); PawnIt; ++PawnIt)
+		{
+			Pawns.Add(*PawnIt);
+		}
+		for (ADefaultPawn* Pawn : Pawns)
+		{
+			Pawn->SetActorLocationAndRotation(Pawn->GetActorLocation() + Random.VRand() * 1000.0, FRotator(0.0, Random.FRandRange(-180.0, 180.0), 0.0));
+			Pawn->GetMovementComponent()->Velocity = Random.VRand() * 300.0;
+			Pawn->CustomTimeDilation = Random.FRandRange(0.5, 2.0);
+		}
+		Pawns[Random.RandHelper(Pawns.Num())]->Tags.Add(TEXT("Touched"));
+		const int32 NumToDestroy = 1 + Random.RandHelper(3);
+		for (int32 DestroyIndex = 0; DestroyIndex < NumToDestroy; ++DestroyIndex)
+		{
+			Pawns[(Episode * 7 + DestroyIndex * 13) % Pawns.Num()]->Destroy();
+		}
+		Fixture.SpawnPawn(FVector(0.0, 1000.0, 100.0));
+		Fixture.World->TimeSeconds += 30.0;
+
+		grpc::Status RestoreStatus;
+		WorldControl->RestoreWorldSnapshot(RestoreRequest, TResponseDelegate<TempoWorld::RestoreWorldSnapshotResponse>::CreateLambda(
+			[&](const TempoWorld::RestoreWorldSnapshotResponse& Response, grpc::Status Status)
+			{
+				RestoreStatus = Status;
+				SlowestRestore = FMath::Max(SlowestRestore, Response.restore_duration());
+				TotalRespawned += Response.num_respawned_actors();
+				TotalDestroyed += Response.num_destroyed_actors();
+			}));
+		if (!TestTrue(TEXT("RestoreWorldSnapshot succeeds"), RestoreStatus.ok()))
+		{
+			return false;
+		}
+
+		const FString Mismatch = Difference(Saved, Observe(Fixture.World));
+		if (!Mismatch.IsEmpty())
+		{
+			AddError(FString::Printf(TEXT("After episode %d: %s"), Episode, *Mismatch));
+			return false;
+		}
+	}
+
+	TestTrue(TEXT("Destroyed pawns were respawned"), TotalRespawned >= NumEpisodes);
+	TestEqual(TEXT("Each episode's new pawn was destroyed"), TotalDestroyed, NumEpisodes);
+	AddInfo(FString::Printf(TEXT("%d save/restore cycles of %d pawns: slowest restore %.2f ms"), NumEpisodes, NumPawns, SlowestRestore * 1000.0));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoWorldSnapshotErrorsTest,
+	"Tempo.World.WorldSnapshot.Errors", TempoWorldSnapshotTestFlags)
+bool FTempoWorldSnapshotErrorsTest::RunTest(const FString& Parameters)
+{
+	const FWorldSnapshotTestFixture Fixture;
+	UTempoWorldControlServiceSubsystem* WorldControl = Fixture.World->GetSubsystem<UTempoWorldControlServiceSubsystem>();
+	if (!TestNotNull(TEXT("Game worlds have a world control service"), WorldControl))
+	{
+		return false;
+	}
+	Fixture.SpawnPawn(FVector::ZeroVector);
+
+	const auto SaveStatus = [WorldControl](const TempoWorld::SaveWorldSnapshotRequest& Request)
+	{
+		int32 Result = -1;
+		WorldControl->SaveWorldSnapshot(Request, TResponseDelegate<TempoWorld::SaveWorldSnapshotResponse>::CreateLambda(
+			[&Result](const TempoWorld::SaveWorldSnapshotResponse&, grpc::Status Status)
+			{
+				Result = Status.error_code();
+			}));
+		return Result;
+	};
+
+	TempoWorld::SaveWorldSnapshotRequest Unnamed;
+	TestEqual(TEXT("A snapshot needs a name"), SaveStatus(Unnamed), static_cast<int32>(grpc::FAILED_PRECONDITION));
+
+	TempoWorld::SaveWorldSnapshotRequest NoSuchProperty;
+	NoSuchProperty.set_name("Bad");
+	AddProperty(NoSuchProperty, "NoSuchProperty");
+	TestEqual(TEXT("Unknown properties are rejected"), SaveStatus(NoSuchProperty), static_cast<int32>(grpc::NOT_FOUND));
+
+	TempoWorld::SaveWorldSnapshotRequest NoSuchActor;
+	NoSuchActor.set_name("Bad");
+	AddProperty(NoSuchActor, "Tags")->set_actor("NoSuchActor");
+	TestEqual(TEXT("Unknown actors are rejected"), SaveStatus(NoSuchActor), static_cast<int32>(grpc::NOT_FOUND));
+
+	const auto RestoreStatus = [WorldControl](const char* Name)
+	{
+		TempoWorld::RestoreWorldSnapshotRequest Request;
+		Request.set_name(Name);
+		int32 Result = -1;
+		WorldControl->RestoreWorldSnapshot(Request, TResponseDelegate<TempoWorld::RestoreWorldSnapshotResponse>::CreateLambda(
+			[&Result](const TempoWorld::RestoreWorldSnapshotResponse&, grpc::Status Status)
+			{
+				Result = Status.error_code();
+			}));
+		return Result;
+	};
+	TestEqual(TEXT("Failed saves leave no snapshot to restore"), RestoreStatus("Bad"), static_cast<int32>(grpc::NOT_FOUND));
+
+	const auto DeleteStatus = [WorldControl](const TempoWorld::DeleteWorldSnapshotRequest& Request)
+	{
+		int32 Result = -1;
+		WorldControl->DeleteWorldSnapshot(Request, TResponseDelegate<TempoCore::Empty>::CreateLambda(
+			[&Result](const TempoCore::Empty&, grpc::Status Status)
+			{
+				Result = Status.error_code();
+			}));
+		return Result;
+	};
+	TempoWorld::SaveWorldSnapshotRequest Good;
+	Good.set_name("Good");
+	TestEqual(TEXT("A snapshot of known properties saves"), SaveStatus(Good), static_cast<int32>(grpc::OK));
+	TestEqual(TEXT("A delete needs a name or all"), DeleteStatus(TempoWorld::DeleteWorldSnapshotRequest()), static_cast<int32>(grpc::FAILED_PRECONDITION));
+	TestEqual(TEXT("An unnamed delete deletes nothing"), RestoreStatus("Good"), static_cast<int32>(grpc::OK));
+	TempoWorld::DeleteWorldSnapshotRequest DeleteAll;
+	DeleteAll.set_all(true);
+	TestEqual(TEXT("Deleting all succeeds"), DeleteStatus(DeleteAll), static_cast<int32>(grpc::OK));
+	TestEqual(TEXT("Deleting all deletes every snapshot"), RestoreStatus("Good"), static_cast<int32>(grpc::NOT_FOUND));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,283 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#include "TempoWorldStateServiceSubsystem.h"
+
+#include "TempoCoreUtils.h"
+#include "TempoTestWorld.h"
+
+#include "TempoWorld/WorldState.grpc.pb.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+// Tests for GetWorldStateSnapshot and StreamWorldStateSnapshots: filters, packed columns, the actor ID table,
+// and build-plus-parse time against GetCurrentActorStatesNearPosition. Run with
+//   Automation RunTests Tempo.World.WorldStateSnapshot
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr EAutomationTestFlags TempoWorldStateSnapshotTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	struct FWorldStateSnapshotTestFixture : FTempoTestWorld
+	{
+		// A movable actor at Location meters, with an optional tag.
+		AActor* SpawnMovableActor(const FVector& Location, FName Tag = NAME_None) const
+		{
+			AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(Location * 100.0, FRotator::ZeroRotator);
+			Actor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+			if (!Tag.IsNone())
+			{
+				Actor->Tags.Add(Tag);
+			}
+			return Actor;
+		}
+	};
+
+	// Row Row's 3-vector starting at float Offset in a 6-float-per-row column.
+	FVector ReadColumn(const std::string& Column, int32 Row, int32 Offset)
+	{
+		float Values[3];
+		FMemory::Memcpy(Values, Column.data() + (Row * 6 + Offset) * sizeof(float), sizeof(Values));
+		return FVector(Values[0], Values[1], Values[2]);
+	}
+
+	TempoWorld::WorldStateSnapshot GetSnapshot(UTempoWorldStateServiceSubsystem* WorldState, const TempoWorld::WorldStateSnapshotRequest& Request)
+	{
+		TempoWorld::WorldStateSnapshot Snapshot;
+		WorldState->GetWorldStateSnapshot(Request, TResponseDelegate<TempoWorld::WorldStateSnapshot>::CreateLambda(
+			[&Snapshot](const TempoWorld::WorldStateSnapshot& Response, grpc::Status)
+			{
+				Snapshot = Response;
+			}));
+		return Snapshot;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoWorldStateSnapshotColumnsTest,
+	"Tempo.World.WorldStateSnapshot.Columns", TempoWorldStateSnapshotTestFlags)
+bool FTempoWorldStateSnapshotColumnsTest::RunTest(const FString& Parameters)
+{
+	const FWorldStateSnapshotTestFixture Fixture;
+	UTempoWorldStateServiceSubsystem* WorldState = Fixture.World->GetSubsystem<UTempoWorldStateServiceSubsystem>();
+	if (!TestNotNull(TEXT("Game worlds have a world state service"), WorldState))
+	{
+		return false;
+	}
+
+	const AActor* Car = Fixture.SpawnMovableActor(FVector(1.0, 2.0, 3.0), TEXT("Car"));
+	Fixture.SpawnMovableActor(FVector(4.0, 5.0, 6.0), TEXT("Pedestrian"));
+	Fixture.World->SpawnActor<AActor>();
+
+	TempoWorld::WorldStateSnapshotRequest Request;
+	Request.add_actor_classes("StaticMeshActor");
+	Request.set_include_static(true);
+	TestEqual(TEXT("Class filter matches the class"), GetSnapshot(WorldState, Request).actor_ids_size(), 2);
+
+	Request.clear_actor_classes();
+	Request.add_actor_classes("Actor");
+	TestTrue(TEXT("Class filter matches subclasses"), GetSnapshot(WorldState, Request).actor_ids_size() >= 3);
+
+	Request.clear_actor_classes();
+	Request.add_actor_classes("NoSuchClass");
+	TestEqual(TEXT("Unknown class matches nothing"), GetSnapshot(WorldState, Request).actor_ids_size(), 0);
+
+	Request.clear_actor_classes();
+	Request.add_tags("car");
+	Request.set_include_bounds(true);
+	const TempoWorld::WorldStateSnapshot Snapshot = GetSnapshot(WorldState, Request);
+	if (!TestEqual(TEXT("Tag filter matches the tagged actor"), Snapshot.actor_ids_size(), 1))
+	{
+		return false;
+	}
+
+	if (TestEqual(TEXT("Every row's actor is in the table"), Snapshot.added_actors_size(), 1))
+	{
+		TestEqual(TEXT("Table entry has the row's ID"), Snapshot.added_actors(0).id(), Snapshot.actor_ids(0));
+		TestEqual(TEXT("Table entry has the actor's name"), FString(UTF8_TO_TCHAR(Snapshot.added_actors(0).name().c_str())), UTempoCoreUtils::GetActorIdentifier(Car));
+		TestEqual(TEXT("Table entry has the actor's class"), FString(UTF8_TO_TCHAR(Snapshot.added_actors(0).actor_class().c_str())), FString(TEXT("StaticMeshActor")));
+	}
+
+	const uint64 ColumnBytes = 6 * sizeof(float);
+	TestEqual(TEXT("Transforms column has one row"), static_cast<uint64>(Snapshot.transforms().size()), ColumnBytes);
+	TestEqual(TEXT("Velocities column has one row"), static_cast<uint64>(Snapshot.velocities().size()), ColumnBytes);
+	TestEqual(TEXT("Bounds column has one row"), static_cast<uint64>(Snapshot.bounds().size()), ColumnBytes);
+	TestEqual(TEXT("Local bounds column has one row"), static_cast<uint64>(Snapshot.local_bounds().size()), ColumnBytes);
+	// Right-handed: Y flips.
+	TestTrue(TEXT("Location is in meters, right-handed"), ReadColumn(Snapshot.transforms(), 0, 0).Equals(FVector(1.0, -2.0, 3.0), 1e-4));
+
+	// Agrees with the nested form.
+	TempoWorld::ActorStateRequest StateRequest;
+	StateRequest.set_actor(Snapshot.added_actors(0).name());
+	TempoWorld::ActorState State;
+	WorldState->GetCurrentActorState(StateRequest, TResponseDelegate<TempoWorld::ActorState>::CreateLambda(
+		[&State](const TempoWorld::ActorState& Response, grpc::Status)
+		{
+			State = Response;
+		}));
+	const FVector BoundsMin = ReadColumn(Snapshot.bounds(), 0, 0);
+	const FVector BoundsMax = ReadColumn(Snapshot.bounds(), 0, 3);
+	TestTrue(TEXT("Bounds match GetCurrentActorState"),
+		BoundsMin.Equals(FVector(State.bounds().min().x(), State.bounds().min().y(), State.bounds().min().z()), 1e-4) &&
+		BoundsMax.Equals(FVector(State.bounds().max().x(), State.bounds().max().y(), State.bounds().max().z()), 1e-4));
+
+	Request.set_include_bounds(false);
+	TestTrue(TEXT("Bounds are only filled when asked for"), GetSnapshot(WorldState, Request).bounds().empty());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoWorldStateSnapshotStreamTest,
+	"Tempo.World.WorldStateSnapshot.Stream", TempoWorldStateSnapshotTestFlags)
+bool FTempoWorldStateSnapshotStreamTest::RunTest(const FString& Parameters)
+{
+	const FWorldStateSnapshotTestFixture Fixture;
+	UTempoWorldStateServiceSubsystem* WorldState = Fixture.World->GetSubsystem<UTempoWorldStateServiceSubsystem>();
+	if (!TestNotNull(TEXT("Game worlds have a world state service"), WorldState))
+	{
+		return false;
+	}
+
+	Fixture.SpawnMovableActor(FVector(0.0, 0.0, 0.0), TEXT("Tracked"));
+	AActor* Leaving = Fixture.SpawnMovableActor(FVector(10.0, 0.0, 0.0), TEXT("Tracked"));
+
+	TempoWorld::WorldStateSnapshotRequest Request;
+	Request.add_tags("Tracked");
+	Request.set_include_static(true);
+
+	// Re-subscribes after each message, as the server does when a write completes.
+	TArray<TempoWorld::WorldStateSnapshot> Received;
+	const TResponseDelegate<TempoWorld::WorldStateSnapshot> Continuation = TResponseDelegate<TempoWorld::WorldStateSnapshot>::CreateLambda(
+		[&Received](const TempoWorld::WorldStateSnapshot& Response, grpc::Status)
+		{
+			Received.Add(Response);
+		});
+	auto Pump = [WorldState, &Request, &Continuation, &Received]() -> const TempoWorld::WorldStateSnapshot*
+	{
+		const int32 NumBefore = Received.Num();
+		WorldState->StreamWorldStateSnapshots(Request, Continuation);
+		WorldState->Tick(0.1f);
+		return Received.Num() == NumBefore + 1 ? &Received.Last() : nullptr;
+	};
+
+	const TempoWorld::WorldStateSnapshot* First = Pump();
+	if (!TestNotNull(TEXT("First tick sends a snapshot"), First))
+	{
+		return false;
+	}
+	TestEqual(TEXT("First snapshot has every row"), First->actor_ids_size(), 2);
+	TestEqual(TEXT("First snapshot sends the whole table"), First->added_actors_size(), 2);
+	uint32 LeavingId = 0;
+	for (const TempoWorld::SnapshotActor& Entry : First->added_actors())
+	{
+		if (UTempoCoreUtils::GetActorIdentifier(Leaving) == UTF8_TO_TCHAR(Entry.name().c_str()))
+		{
+			LeavingId = Entry.id();
+		}
+	}
+
+	const TempoWorld::WorldStateSnapshot* Second = Pump();
+	if (!TestNotNull(TEXT("Every tick sends a snapshot"), Second))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Later snapshots still have every row"), Second->actor_ids_size(), 2);
+	TestEqual(TEXT("Unchanged table is not resent"), Second->added_actors_size() + Second->removed_actor_ids_size(), 0);
+
+	Leaving->Destroy();
+	const AActor* Arriving = Fixture.SpawnMovableActor(FVector(20.0, 0.0, 0.0), TEXT("Tracked"));
+	const TempoWorld::WorldStateSnapshot* Changed = Pump();
+	if (!TestNotNull(TEXT("Snapshot after the change is sent"), Changed))
+	{
+		return false;
+	}
+	if (TestEqual(TEXT("Only the new actor is added"), Changed->added_actors_size(), 1))
+	{
+		TestEqual(TEXT("New actor is named"), FString(UTF8_TO_TCHAR(Changed->added_actors(0).name().c_str())), UTempoCoreUtils::GetActorIdentifier(Arriving));
+		TestNotEqual(TEXT("IDs are not reused"), static_cast<int64>(Changed->added_actors(0).id()), static_cast<int64>(LeavingId));
+	}
+	if (TestEqual(TEXT("Only the destroyed actor is removed"), Changed->removed_actor_ids_size(), 1))
+	{
+		TestEqual(TEXT("Removed ID is the destroyed actor's"), Changed->removed_actor_ids(0), LeavingId);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTempoWorldStateSnapshotThroughputTest,
+	"Tempo.World.WorldStateSnapshot.Throughput", TempoWorldStateSnapshotTestFlags)
+bool FTempoWorldStateSnapshotThroughputTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumActors = 10000;
+	constexpr int32 NumRounds = 5;
+
+	const FWorldStateSnapshotTestFixture Fixture;
+	UTempoWorldStateServiceSubsystem* WorldState = Fixture.World->GetSubsystem<UTempoWorldStateServiceSubsystem>();
+	if (!TestNotNull(TEXT("Game worlds have a world state service"), WorldState))
+	{
+		return false;
+	}
+
+	for (int32 I = 0; I < NumActors; ++I)
+	{
+		Fixture.SpawnMovableActor(FVector(I % 100, I / 100, 0.0));
+	}
+
+	TempoWorld::ActorStatesNearPositionRequest NearRequest;
+	NearRequest.set_search_radius_m(1.0e6f);
+	NearRequest.set_include_static(true);
+
+	TempoWorld::WorldStateSnapshotRequest SnapshotRequest;
+	SnapshotRequest.set_include_static(true);
+	SnapshotRequest.set_include_bounds(true);
+
+	double NestedSeconds = 0.0;
+	size_t NestedBytes = 0;
+	int32 NumNested = 0;
+	double SnapshotSeconds = 0.0;
+	size_t SnapshotBytes = 0;
+	int32 NumSnapshot = 0;
+	for (int32 Round = 0; Round < NumRounds; ++Round)
+	{
+		// Build, serialize and parse, as client and server would.
+		double Start = FPlatformTime::Seconds();
+		WorldState->GetCurrentActorStatesNearPosition(NearRequest, TResponseDelegate<TempoWorld::ActorStates>::CreateLambda(
+			[&NestedBytes, &NumNested](const TempoWorld::ActorStates& Response, grpc::Status)
+			{
+				const std::string Wire = Response.SerializeAsString();
+				TempoWorld::ActorStates Parsed;
+				Parsed.ParseFromString(Wire);
+				NestedBytes = Wire.size();
+				NumNested = Parsed.actor_states_size();
+			}));
+		NestedSeconds += FPlatformTime::Seconds() - Start;
+
+		Start = FPlatformTime::Seconds();
+		WorldState->GetWorldStateSnapshot(SnapshotRequest, TResponseDelegate<TempoWorld::WorldStateSnapshot>::CreateLambda(
+			[&SnapshotBytes, &NumSnapshot](const TempoWorld::WorldStateSnapshot& Response, grpc::Status)
+			{
+				const std::string Wire = Response.SerializeAsString();
+				TempoWorld::WorldStateSnapshot Parsed;
+				Parsed.ParseFromString(Wire);
+				SnapshotBytes = Wire.size();
+				NumSnapshot = Parsed.actor_ids_size();
+			}));
+		SnapshotSeconds += FPlatformTime::Seconds() - Start;
+	}
+
+	TestEqual(TEXT("Nested response has every actor"), NumNested, NumActors);
+	TestEqual(TEXT("Snapshot has every actor"), NumSnapshot, NumActors);
+	TestTrue(TEXT("Snapshot is smaller on the wire"), SnapshotBytes < NestedBytes);
+
+	AddInfo(FString::Printf(TEXT("%d actors: nested %.2f ms / %llu bytes, snapshot %.2f ms / %llu bytes (whole table; a stream sends it once)"),
+		NumActors, NestedSeconds * 1000.0 / NumRounds, static_cast<uint64>(NestedBytes),
+		SnapshotSeconds * 1000.0 / NumRounds, static_cast<uint64>(SnapshotBytes)));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,78 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#pragma once
+
+#include "TempoSubsystems.h"
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+#include "TempoActorNameIndex.generated.h"
+
+// Maps actor names to actors so GetActorWithName doesn't scan the world. Each actor is indexed under both
+// its FName and its identifier (see UTempoCoreUtils::GetActorIdentifier), case-insensitively. Kept current
+// from spawn, destroy, level streaming and (in the editor) label change events. A lookup that misses falls
+// back to one scan, which re-indexes every actor it finds unindexed or filed under stale names. That covers
+// the cases no event reports: actors spawned deferred and not yet finished, and actors renamed at runtime.
+UCLASS()
+class TEMPOWORLD_API UTempoActorNameIndex : public UTempoWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	// Returns the actor whose identifier matches Name (ignoring case), or failing that the one whose FName does, or
+	// nullptr.
+	AActor* FindActor(const FString& Name);
+
+	int32 NumIndexedActors() const { return ActorKeys.Num(); }
+
+	// (Re)indexes an actor under its current names. For actors that raise no spawn event yet, such as
+	// deferred spawns that haven't finished.
+	void AddActor(AActor* Actor);
+
+	// Drops an actor from the index, for actors that stay in the world but should no longer be found, such
+	// as pooled ones.
+	void RemoveActor(const AActor* Actor);
+
+protected:
+	void BuildIndex();
+
+	void OnActorSpawned(AActor* Actor);
+
+	void OnActorDestroyed(AActor* Actor);
+
+	void OnLevelAdded(ULevel* Level, UWorld* World);
+
+	void OnLevelRemoved(ULevel* Level, UWorld* World);
+
+#if WITH_EDITOR
+	void OnActorLabelChanged(AActor* Actor);
+#endif
+
+	static bool IdentifierMatches(const AActor* Actor, const FString& Name);
+
+	static bool FNameMatches(const AActor* Actor, const FString& Name);
+
+	// Built on the first lookup, then maintained by the event handlers.
+	bool bIndexBuilt = false;
+
+	// Actors sharing a name are kept in the order they were indexed; lookups return the first live one.
+	TMap<FName, TArray<TWeakObjectPtr<AActor>, TInlineAllocator<1>>> ActorsByName;
+
+	// The names each indexed actor is filed under, so it can be removed when it is renamed.
+	TMap<TObjectKey<AActor>, TArray<FName, TInlineAllocator<2>>> ActorKeys;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+#if WITH_EDITOR
+	FDelegateHandle ActorLabelChangedHandle;
+#endif
+};
@@ -0,0 +1,104 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#pragma once
+
+#include "TempoSubsystems.h"
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+#include "TempoActorPool.generated.h"
+
+struct FTempoActorPoolStats
+{
+	int32 MaxSize = 0;
+	int32 NumPooled = 0;
+	// Spawns served from the pool, and spawns that found it empty.
+	uint64 Hits = 0;
+	uint64 Misses = 0;
+	// Destroys that returned an actor to the pool, and those it refused because it was full (which destroyed
+	// the actor as usual).
+	uint64 Releases = 0;
+	uint64 Refusals = 0;
+	// Estimated memory held by the pooled actors and their components.
+	int64 EstimatedMemoryBytes = 0;
+};
+
+// Opt-in, per-class pools of destroyed actors, so spawn/destroy churn can recycle actors instead of paying
+// for construction, component registration and (for sensors) render target allocation every time. A pooled
+// actor stays in the world, hidden, with collision, ticking and its components deactivated, and renamed so
+// lookups by its old name fail as they would after a destroy. Actors implementing
+// ITempoPoolableActorInterface are told when they are released and reused.
+//
+// Reuse is not a respawn: neither the construction script nor BeginPlay runs again. Reactivate only
+// restores visibility, collision and ticking to the class defaults, physics simulation and auto-activation
+// to the component templates, and stops movement components. Any other state an actor picked up while
+// alive (variables, timers, attachments, dynamic materials) carries over into its next use unless it
+// implements ITempoPoolableActorInterface and resets it in ResetForReuse, so only pool other classes if
+// that state doesn't matter.
+//
+// Pools hold actors of exactly one class. Recycled actors are teleported to their spawn transform without
+// the collision adjustment a spawn would do.
+UCLASS()
+class TEMPOWORLD_API UTempoActorPool : public UTempoWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Deinitialize() override;
+
+	// Enables pooling for Class, keeping up to MaxSize released actors. A MaxSize of 0 disables it and
+	// destroys the actors pooled so far.
+	void SetMaxSize(UClass* Class, int32 MaxSize);
+
+	// Spawns actors into Class's pool until it holds NumActors (or is full). Returns how many were added.
+	int32 Prewarm(UClass* Class, int32 NumActors);
+
+	bool IsPoolingEnabled(const UClass* Class) const;
+
+	// Takes an actor of Class from its pool, renamed, moved to Transform and reactivated. Returns null if
+	// Class isn't pooled or its pool is empty.
+	AActor* Acquire(UClass* Class, const FTransform& Transform);
+
+	// Returns Actor to its class's pool. Returns false, leaving the actor alone, if the class isn't pooled
+	// or its pool is full, in which case the caller should destroy it.
+	bool Release(AActor* Actor);
+
+	// Takes Actor back out of its pool, reactivated and moved to Transform as by Acquire, but named Name if
+	// nothing else is (e.g. to put back an actor pooled after a world snapshot was saved). Returns false if
+	// Actor isn't pooled.
+	bool Reclaim(AActor* Actor, const FTransform& Transform, FName Name);
+
+	bool IsPooled(const AActor* Actor) const { return PooledActors.Contains(Actor); }
+
+	// Stats for each class that has (or had) pooling enabled.
+	TArray<TPair<UClass*, FTempoActorPoolStats>> GetStats() const;
+
+protected:
+	struct FClassPool
+	{
+		int32 MaxSize = 0;
+		TArray<TWeakObjectPtr<AActor>> Actors;
+		uint64 Hits = 0;
+		uint64 Misses = 0;
+		uint64 Releases = 0;
+		uint64 Refusals = 0;
+	};
+
+	void Deactivate(AActor* Actor);
+
+	// Gives Actor Name if it is free in its level, or else a fresh one.
+	void Reactivate(AActor* Actor, const FTransform& Transform, FName Name = NAME_None);
+
+	// Gives Actor a fresh, unique name in its level (or, if bExact, BaseName itself) and, in the editor, a
+	// matching label.
+	static void RenameActor(AActor* Actor, FName BaseName, bool bExact = false);
+
+	static int64 EstimateMemory(AActor* Actor);
+
+	TMap<TObjectKey<UClass>, FClassPool> Pools;
+
+	TSet<TObjectKey<AActor>> PooledActors;
+};
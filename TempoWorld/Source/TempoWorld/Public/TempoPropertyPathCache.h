@@ -0,0 +1,106 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+#include <string>
+
+// A property path ("Prop", "Struct.Member", "Array[2].Member", "Map[Key]") resolved against a class.
+struct FTempoResolvedPropertyPath
+{
+	// The top-level property the path starts at.
+	FProperty* Property = nullptr;
+
+	// Where the rest of the path (struct members, array indices, map keys) starts in the path string.
+	int32 InnerStart = 0;
+
+	// If the rest of the path names only struct members and ends at a plain value, the property it ends
+	// at and that value's offset from the object, so setters can skip the walk. Otherwise null.
+	FProperty* Leaf = nullptr;
+	int32 LeafOffset = 0;
+};
+
+// A top-level property of a class, as GetObjectProperties reports it.
+struct FTempoClassProperty
+{
+	const FProperty* Property = nullptr;
+	std::string Name;
+};
+
+// A member of a struct, under the name clients use for it.
+struct FTempoStructMember
+{
+	FProperty* Property = nullptr;
+	FString AuthoredName;
+};
+
+// Caches reflection lookups for the property RPCs: resolved property paths per class, struct members by
+// authored name, and the property lists GetObjectProperties walks. Everything is keyed on the class or
+// struct, so it is shared across worlds. Entries for garbage-collected types are pruned after GC, and the
+// whole cache is dropped when types are reloaded or reinstanced, since their FProperties are recreated.
+// Game thread only.
+class TEMPOWORLD_API FTempoPropertyPathCache
+{
+public:
+	static FTempoPropertyPathCache& Get();
+
+	// Called by the module.
+	static void Startup();
+	static void Shutdown();
+
+	// Resolves Path against Class. Returns false if Class has no top-level property by that name; the
+	// rest of the path is not validated here.
+	bool Resolve(const UClass* Class, const FString& Path, FTempoResolvedPropertyPath& OutResolved);
+
+	// The member of Struct whose authored name is Name (ignoring case), or null.
+	FProperty* FindStructMember(const UStruct* Struct, const FString& Name);
+
+	// Struct's members in declaration order.
+	const TArray<FTempoStructMember>& GetStructMembers(const UStruct* Struct);
+
+	// Class's properties, in TFieldIterator order.
+	const TArray<FTempoClassProperty>& GetClassProperties(const UClass* Class);
+
+	// Splits the first segment off PropertyName and returns it, leaving the rest in PropertyName.
+	// Segments are separated by '.' or enclosed in '[' ']' (map keys may themselves contain '.').
+	static FString SplitPropertyName(FString& PropertyName);
+
+	// Drops everything. Resolved paths held elsewhere are stale once the generation changes.
+	void Reset();
+
+	uint32 GetGeneration() const { return Generation; }
+
+	int32 NumCachedPaths() const;
+	uint64 GetNumHits() const { return NumHits; }
+	uint64 GetNumMisses() const { return NumMisses; }
+
+private:
+	struct FStructInfo
+	{
+		TArray<FTempoStructMember> Members;
+		TMap<FString, FProperty*> MembersByName;
+	};
+
+	FStructInfo& GetStructInfo(const UStruct* Struct);
+
+	void OnPostGarbageCollect();
+
+	// FString keys compare case-insensitively, as FName property lookup does.
+	TMap<TObjectKey<UClass>, TMap<FString, FTempoResolvedPropertyPath>> Paths;
+
+	// Held by pointer so references handed out survive later insertions.
+	TMap<TObjectKey<UStruct>, TUniquePtr<FStructInfo>> Structs;
+	TMap<TObjectKey<UClass>, TUniquePtr<TArray<FTempoClassProperty>>> ClassProperties;
+
+	uint32 Generation = 0;
+	uint64 NumHits = 0;
+	uint64 NumMisses = 0;
+
+	FDelegateHandle PostGarbageCollectHandle;
+	FDelegateHandle ReloadCompleteHandle;
+#if WITH_EDITOR
+	FDelegateHandle ObjectsReplacedHandle;
+#endif
+};
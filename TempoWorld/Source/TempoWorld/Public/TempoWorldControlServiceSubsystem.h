@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "TempoPropertyPathCache.h"
+#include "TempoWorldSnapshot.h"
 #include "TempoServiceProvider.h"
 #include "TempoServer.h"
 #include "TempoSubsystems.h"
@@ -25,6 +27,10 @@ namespace TempoWorld
 	class FinishSpawningActorRequest;
 	class FinishSpawningActorResponse;
 	class DestroyActorRequest;
+	class SpawnActorsRequest;
+	class SpawnActorsResponse;
+	class DestroyActorsRequest;
+	class DestroyActorsResponse;
 	class SetActorTransformRequest;
 	class SetComponentTransformRequest;
 	class GetAllActorsResponse;
@@ -38,6 +44,23 @@ namespace TempoWorld
 	class CallFunctionRequest;
 	class SetPropertiesRequest;
 	class SetPropertiesResponse;
+	class PreparePropertyHandlesRequest;
+	class PreparePropertyHandlesResponse;
+	class SetPropertiesByHandleRequest;
+	class ReleasePropertyHandlesRequest;
+	class PrepareFunctionRequest;
+	class PrepareFunctionResponse;
+	class CallFunctionsRequest;
+	class CallFunctionsResponse;
+	class ReleaseFunctionHandlesRequest;
+	class SaveWorldSnapshotRequest;
+	class SaveWorldSnapshotResponse;
+	class RestoreWorldSnapshotRequest;
+	class RestoreWorldSnapshotResponse;
+	class DeleteWorldSnapshotRequest;
+	class ConfigureActorPoolRequest;
+	class ActorPoolStats;
+	class GetActorPoolStatsResponse;
 }
 
 DECLARE_MULTICAST_DELEGATE(FTempoWorldControlServiceActivated);
@@ -63,6 +86,11 @@ public:
 
 	void DestroyActor(const TempoWorld::DestroyActorRequest& Request, const TResponseDelegate<TempoCore::Empty>& ResponseContinuation) const;
 
+	// Spawns many actors in one game-thread pass, resolving each distinct class once.
+	void SpawnActors(const TempoWorld::SpawnActorsRequest& Request, const TResponseDelegate<TempoWorld::SpawnActorsResponse>& ResponseContinuation);
+
+	void DestroyActors(const TempoWorld::DestroyActorsRequest& Request, const TResponseDelegate<TempoWorld::DestroyActorsResponse>& ResponseContinuation) const;
+
 	void AddComponent(const TempoWorld::AddComponentRequest& Request, const TResponseDelegate<TempoWorld::AddComponentResponse>& ResponseContinuation) const;
 
 	void DestroyComponent(const TempoWorld::DestroyComponentRequest& Request, const TResponseDelegate<TempoCore::Empty>& ResponseContinuation) const;
@@ -87,6 +115,34 @@ public:
 
 	void SetProperties(const TempoWorld::SetPropertiesRequest& Request, const TResponseDelegate<TempoWorld::SetPropertiesResponse>& ResponseContinuation) const;
 
+	// Resolves properties once and returns handles to them, so SetPropertiesByHandle can skip the name lookups.
+	void PreparePropertyHandles(const TempoWorld::PreparePropertyHandlesRequest& Request, const TResponseDelegate<TempoWorld::PreparePropertyHandlesResponse>& ResponseContinuation);
+
+	void SetPropertiesByHandle(const TempoWorld::SetPropertiesByHandleRequest& Request, const TResponseDelegate<TempoWorld::SetPropertiesResponse>& ResponseContinuation);
+
+	void ReleasePropertyHandles(const TempoWorld::ReleasePropertyHandlesRequest& Request, const TResponseDelegate<TempoCore::Empty>& ResponseContinuation);
+
+	// Resolves a function and its parameter layout once and returns a handle to it, so CallFunctions can skip
+	// the lookups and call it on many objects with packed arguments.
+	void PrepareFunction(const TempoWorld::PrepareFunctionRequest& Request, const TResponseDelegate<TempoWorld::PrepareFunctionResponse>& ResponseContinuation);
+
+	void CallFunctions(const TempoWorld::CallFunctionsRequest& Request, const TResponseDelegate<TempoWorld::CallFunctionsResponse>& ResponseContinuation);
+
+	void ReleaseFunctionHandles(const TempoWorld::ReleaseFunctionHandlesRequest& Request, const TResponseDelegate<TempoCore::Empty>& ResponseContinuation);
+
+	// Captures the world's dynamic actors, selected properties, traffic state and sim time in memory, for
+	// RestoreWorldSnapshot to put back in place (e.g. to reset an episode without reloading the level).
+	void SaveWorldSnapshot(const TempoWorld::SaveWorldSnapshotRequest& Request, const TResponseDelegate<TempoWorld::SaveWorldSnapshotResponse>& ResponseContinuation);
+
+	void RestoreWorldSnapshot(const TempoWorld::RestoreWorldSnapshotRequest& Request, const TResponseDelegate<TempoWorld::RestoreWorldSnapshotResponse>& ResponseContinuation);
+
+	void DeleteWorldSnapshot(const TempoWorld::DeleteWorldSnapshotRequest& Request, const TResponseDelegate<TempoCore::Empty>& ResponseContinuation);
+
+	// Enables recycling of destroyed actors of one class by later spawns of it (see UTempoActorPool).
+	void ConfigureActorPool(const TempoWorld::ConfigureActorPoolRequest& Request, const TResponseDelegate<TempoWorld::ActorPoolStats>& ResponseContinuation);
+
+	void GetActorPoolStats(const TempoCore::Empty& Request, const TResponseDelegate<TempoWorld::GetActorPoolStatsResponse>& ResponseContinuation) const;
+
 	void OnTempoWorldControlServiceActivated();
 
 	void OnTempoWorldControlServiceDeactivated();
@@ -96,6 +152,56 @@ protected:
 	TMap<const AActor*, FTransform> DeferredSpawnTransforms;
 
 private:
+	struct FPreparedProperty
+	{
+		TWeakObjectPtr<UObject> Object;
+		FString PropertyName;
+		FTempoResolvedPropertyPath Path;
+		// The property path cache generation Path was resolved in.
+		uint32 CacheGeneration = 0;
+	};
+
+	TMap<uint64, FPreparedProperty> PreparedProperties;
+
+	// 0 is never a handle.
+	uint64 NextPropertyHandle = 1;
+
+	struct FPreparedFunction
+	{
+		TWeakObjectPtr<UClass> Class;
+		FName FunctionName;
+		TWeakObjectPtr<UFunction> Function;
+		// The parameters in the packed argument and output layouts, in order.
+		TArray<FProperty*> Inputs;
+		TArray<FProperty*> Outputs;
+		int32 ArgumentsSize = 0;
+		int32 OutputsSize = 0;
+		// Each parameter's type and offset in the packed layouts, as clients were told them, for checking the
+		// function against after types are reloaded.
+		struct FPackedParameter
+		{
+			FString Type;
+			int32 Offset = 0;
+
+			bool operator==(const FPackedParameter& Other) const { return Type == Other.Type && Offset == Other.Offset; }
+		};
+		TArray<FPackedParameter> InputLayout;
+		TArray<FPackedParameter> OutputLayout;
+		// The property path cache generation the parameters were resolved in.
+		uint32 CacheGeneration = 0;
+	};
+
+	// Finds FunctionName on Class and lays out its parameters. Returns false, with the reason in OutError, if
+	// there is no such function or it has a parameter that can't be packed.
+	static bool ResolveFunction(UClass* Class, FName FunctionName, FPreparedFunction& OutPrepared, FString& OutError);
+
+	TMap<uint64, FPreparedFunction> PreparedFunctions;
+
+	// 0 is never a handle.
+	uint64 NextFunctionHandle = 1;
+
+	TMap<FString, TUniquePtr<FTempoWorldSnapshot>> WorldSnapshots;
+
 	template <typename RequestType>
 	void SetProperty(const RequestType& Request, const TResponseDelegate<TempoCore::Empty>& ResponseContinuation) const;
 
@@ -0,0 +1,142 @@
+// Copyright Tempo Simulation, LLC. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/StrongObjectPtr.h"
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 5
+#include "InstancedStruct.h"
+#else
+#include "StructUtils/InstancedStruct.h"
+#endif
+
+// A property to capture in a world snapshot, named as in the Set*Property requests. An empty Actor selects
+// every actor the snapshot captures that has the property (on the named component, if there is one).
+struct FTempoWorldSnapshotProperty
+{
+	FString Actor;
+	FString Component;
+	FString Property;
+};
+
+struct FTempoWorldSnapshotRestoreStats
+{
+	int32 NumRestoredActors = 0;
+	int32 NumRespawnedActors = 0;
+	int32 NumDestroyedActors = 0;
+	int32 NumRestoredProperties = 0;
+	int32 NumRestoredTrafficEntities = 0;
+};
+
+// An in-memory copy of the world state an episode changes: which dynamic actors exist, their transforms and
+// velocities, selected properties, Mass traffic vehicle and intersection state, and the sim time. Restoring
+// puts that state back in place without reloading the level: dynamic actors spawned since the capture are
+// destroyed, ones destroyed since are respawned under their old names, and the rest are teleported.
+//
+// Respawned actors get their class defaults plus the captured properties; components added at runtime and
+// attachments are not restored. Mass entities are never created or destroyed, so a snapshot can only be
+// restored while the world has exactly the traffic entities it captured. Game thread only.
+class TEMPOWORLD_API FTempoWorldSnapshot
+{
+public:
+	// Captures World's state, plus the selected properties. Returns null, with the reason in OutError, if a
+	// selected property can't be found.
+	static TUniquePtr<FTempoWorldSnapshot> Capture(UWorld* World, const TArray<FTempoWorldSnapshotProperty>& Properties, FString& OutError);
+
+	// Puts World back in the captured state. May be called any number of times. Returns false, changing nothing,
+	// with the reason in OutError, if traffic entities were spawned or despawned since the capture.
+	bool Restore(UWorld* World, FTempoWorldSnapshotRestoreStats& OutStats, FString& OutError);
+
+	// Whether a snapshot tracks Actor's existence and transform: it has a movable root and is not a
+	// controller, camera manager, info actor, child actor, pooled actor, or Mass-driven representation.
+	static bool IsDynamicActor(const AActor* Actor);
+
+	double GetSimTime() const { return SimTime; }
+	int32 NumActors() const;
+	int32 NumProperties() const;
+	int32 NumTrafficEntities() const { return TrafficEntities.Num(); }
+
+private:
+	// A property value. Values that reference no objects are copied; the others are held as exported text,
+	// which names referenced objects by path, so the value stays valid if they are destroyed and respawned.
+	// The struct that owns Property is kept alive with the value, so Property outlives it even when its type
+	// is reloaded or reinstanced. The property is then stale for objects of the new type, which have their
+	// own, so restores resolve it again by name and copy the value over as text.
+	struct FPropertyValue
+	{
+		FPropertyValue(FProperty* InProperty, const void* Source, const UObject* Owner);
+		~FPropertyValue();
+		FPropertyValue(FPropertyValue&& Other);
+		FPropertyValue(const FPropertyValue&) = delete;
+		FPropertyValue& operator=(const FPropertyValue&) = delete;
+		FPropertyValue& operator=(FPropertyValue&&) = delete;
+
+		// The property to restore onto Object: Property itself, if the property path cache's generation is
+		// unchanged since the capture and Object has it, or else Object's property of the same name and type.
+		// Null if Object has none.
+		FProperty* Resolve(const UObject* Object) const;
+
+		// Copies the value into Dest, which DestProperty (from Resolve) describes.
+		void CopyTo(const FProperty* DestProperty, void* Dest, UObject* Owner) const;
+
+		FProperty* Property = nullptr;
+		TStrongObjectPtr<UStruct> PropertyOwner;
+		uint32 CacheGeneration = 0;
+		void* Value = nullptr;
+		FString Text;
+	};
+
+	struct FCapturedProperty
+	{
+		// None for a property on the actor itself.
+		FName Component;
+		FPropertyValue Value;
+	};
+
+	struct FActorRecord
+	{
+		TWeakObjectPtr<AActor> Actor;
+		// False for actors captured only for their properties.
+		bool bDynamic = true;
+		TWeakObjectPtr<UClass> Class;
+		TWeakObjectPtr<ULevel> Level;
+		FName Name;
+		FString Label;
+		FTransform Transform;
+		bool bSimulatingPhysics = false;
+		FVector PhysicsLinearVelocity = FVector::ZeroVector;
+		FVector PhysicsAngularVelocityDeg = FVector::ZeroVector;
+		// Of the actor's first movement component, if it has one.
+		FVector MovementVelocity = FVector::ZeroVector;
+		TArray<FCapturedProperty> Properties;
+	};
+
+	struct FTrafficFragment
+	{
+		// FMassEntityHandle::AsNumber.
+		uint64 Entity = 0;
+		FInstancedStruct Fragment;
+	};
+
+	static bool CaptureProperty(FActorRecord& Record, const FTempoWorldSnapshotProperty& Selector, FString& OutError);
+
+	void CaptureTraffic(UWorld* World);
+
+	// Whether World has exactly the captured traffic entities, so RestoreTraffic can put them all back.
+	bool CanRestoreTraffic(UWorld* World, FString& OutError) const;
+
+	int32 RestoreTraffic(UWorld* World) const;
+
+	AActor* Respawn(UWorld* World, FActorRecord& Record) const;
+
+	double SimTime = 0.0;
+
+	TArray<FActorRecord> Actors;
+
+	// FMassEntityHandle::AsNumber of each captured entity.
+	TSet<uint64> TrafficEntities;
+
+	// Grouped by entity.
+	TArray<FTrafficFragment> TrafficFragments;
+};
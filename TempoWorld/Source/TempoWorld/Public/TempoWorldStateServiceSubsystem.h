@@ -7,10 +7,13 @@
 #include "TempoSubsystems.h"
 
 #include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
 #include "TempoWorld/WorldState.pb.h"
 
 #include "TempoWorldStateServiceSubsystem.generated.h"
 
+class AActor;
+
 namespace TempoCore
 {
 	class Empty;
@@ -20,38 +23,148 @@ namespace TempoWorld
 {
 	class RaycastRequest;
 	class RaycastResponse;
+	class SceneQueriesRequest;
+	class SceneQueriesResponse;
 	class ActorStatesNearPositionRequest;
 }
 
 namespace TempoWorld
 {
+	FORCEINLINE bool DeltaOptionsEqual(bool bLeftHasDelta, const ActorStateDeltaOptions& Left, bool bRightHasDelta, const ActorStateDeltaOptions& Right)
+	{
+		return bLeftHasDelta == bRightHasDelta &&
+			Left.position_tolerance_m() == Right.position_tolerance_m() &&
+				Left.rotation_tolerance_deg() == Right.rotation_tolerance_deg() &&
+					Left.keyframe_interval_s() == Right.keyframe_interval_s();
+	}
+
 	FORCEINLINE uint32 GetTypeHash(const ActorStateRequest& Request)
 	{
-		return GetTypeHash(FString::Printf(TEXT("%s"),
-			UTF8_TO_TCHAR(Request.actor().c_str())));
+		return GetTypeHash(FString::Printf(TEXT("%s/%d"),
+			UTF8_TO_TCHAR(Request.actor().c_str()),
+			Request.has_delta()));
 	}
 
 	FORCEINLINE bool operator==(const ActorStateRequest& Left, const ActorStateRequest& Right)
 	{
-		return Left.actor() == Right.actor();
+		return Left.actor() == Right.actor() &&
+			DeltaOptionsEqual(Left.has_delta(), Left.delta(), Right.has_delta(), Right.delta());
 	}
 
 	FORCEINLINE uint32 GetTypeHash(const ActorStatesNearRequest& Request)
 	{
-		return GetTypeHash(FString::Printf(TEXT("%s/%f/%d"),
+		return GetTypeHash(FString::Printf(TEXT("%s/%f/%d/%d"),
 			UTF8_TO_TCHAR(Request.near_actor().c_str()),
 			Request.search_radius_m(),
-			Request.include_static()));
+			Request.include_static(),
+			Request.has_delta()));
 	}
 
 	FORCEINLINE bool operator==(const ActorStatesNearRequest& Left, const ActorStatesNearRequest& Right)
 	{
 		return Left.near_actor() == Right.near_actor() &&
 				Left.search_radius_m() == Right.search_radius_m() &&
-					Left.include_static() == Right.include_static();
+					Left.include_static() == Right.include_static() &&
+						DeltaOptionsEqual(Left.has_delta(), Left.delta(), Right.has_delta(), Right.delta());
+	}
+
+	// Every field matters (they are all filters or options), and the request has no map fields, so its
+	// serialized form identifies it.
+	FORCEINLINE uint32 GetTypeHash(const WorldStateSnapshotRequest& Request)
+	{
+		const std::string Serialized = Request.SerializeAsString();
+		return FCrc::MemCrc32(Serialized.data(), Serialized.size());
+	}
+
+	FORCEINLINE bool operator==(const WorldStateSnapshotRequest& Left, const WorldStateSnapshotRequest& Right)
+	{
+		return Left.SerializeAsString() == Right.SerializeAsString();
 	}
 }
 
+// The tolerances (and bounds options) delta-mode streams detect changes with. Streams that agree on
+// these share one set of samples and change markers.
+struct FTempoActorStateDeltaKey
+{
+	float PositionToleranceM = 0.0f;
+	float RotationToleranceDeg = 0.0f;
+	bool bIncludeHiddenComponents = false;
+
+	bool operator==(const FTempoActorStateDeltaKey& Other) const
+	{
+		return PositionToleranceM == Other.PositionToleranceM &&
+			RotationToleranceDeg == Other.RotationToleranceDeg &&
+				bIncludeHiddenComponents == Other.bIncludeHiddenComponents;
+	}
+
+	friend uint32 GetTypeHash(const FTempoActorStateDeltaKey& Key)
+	{
+		return HashCombine(HashCombine(GetTypeHash(Key.PositionToleranceM), GetTypeHash(Key.RotationToleranceDeg)), GetTypeHash(Key.bIncludeHiddenComponents));
+	}
+};
+
+// One actor's state as seen by the delta-mode streams with one FTempoActorStateDeltaKey.
+struct FTempoTrackedActorState
+{
+	// The most recent sample that differed from the previous Reference by more than the tolerances.
+	// Changes are sent as this, so a client that has it is always within tolerance of the actor.
+	TempoWorld::ActorState Reference;
+
+	// The latest sample, sent in keyframes.
+	TempoWorld::ActorState Latest;
+
+	// The stream ticks at which Reference last changed and at which the actor was last sampled.
+	uint64 ChangedTick = 0;
+	uint64 SampledTick = 0;
+};
+
+// What one delta-mode stream has been sent so far.
+struct FTempoActorStateSubscriber
+{
+	// The stream tick of the last message sent. Actors whose Reference changed after it are sent next.
+	uint64 LastSentTick = 0;
+
+	bool bSentKeyframe = false;
+	double LastKeyframeTime = 0.0;
+
+	// When the stream last asked for a message, to forget streams that have gone away.
+	double LastSeenTime = 0.0;
+
+	// For near-queries, the actors the stream has been told are in range, with their names for leave events.
+	TMap<TObjectKey<AActor>, FString> InRange;
+};
+
+// What one StreamWorldStateSnapshots stream has been sent of the actor ID table.
+struct FTempoSnapshotSubscriber
+{
+	TSet<uint32> KnownActorIds;
+
+	double LastSeenTime = 0.0;
+};
+
+// What one StreamOverlapEventBatches stream watches, and the batch it is sent next.
+struct FTempoOverlapSubscriber
+{
+	// The request's class and tag names.
+	TArray<FName> ActorClasses;
+	TArray<FName> ActorTags;
+	TArray<FName> OverlappingActorClasses;
+	TArray<FName> OverlappingActorTags;
+
+	TSet<TObjectKey<AActor>> WatchedActors;
+
+	// The events since the last batch was sent, with the ID table entries they need.
+	TempoWorld::OverlapEventBatch Pending;
+
+	TSet<uint32> KnownActorIds;
+
+	// Unbound from when a batch is sent until the stream asks for the next one.
+	TResponseDelegate<TempoWorld::OverlapEventBatch> Continuation;
+
+	// When the stream last asked for, or was waiting for, a batch, to forget streams that have gone away.
+	double LastSeenTime = 0.0;
+};
+
 UCLASS()
 class TEMPOWORLD_API UTempoWorldStateServiceSubsystem : public UTempoTickableGameWorldSubsystem, public ITempoServiceProvider
 {
@@ -66,6 +179,8 @@ public:
 
 	void StreamOverlapEvents(const TempoWorld::OverlapEventRequest& Request, const TResponseDelegate<TempoWorld::OverlapEventResponse>& ResponseContinuation);
 
+	void StreamOverlapEventBatches(const TempoWorld::OverlapBatchRequest& Request, const TResponseDelegate<TempoWorld::OverlapEventBatch>& ResponseContinuation);
+
 	void GetCurrentActorState(const TempoWorld::ActorStateRequest& Request, const TResponseDelegate<TempoWorld::ActorState>& ResponseContinuation) const;
 
 	void StreamActorState(const TempoWorld::ActorStateRequest& Request, const TResponseDelegate<TempoWorld::ActorState>& ResponseContinuation);
@@ -76,19 +191,93 @@ public:
 
 	void StreamActorStatesNear(const TempoWorld::ActorStatesNearRequest& Request, const TResponseDelegate<TempoWorld::ActorStates>& ResponseContinuation);
 
+	void GetWorldStateSnapshot(const TempoWorld::WorldStateSnapshotRequest& Request, const TResponseDelegate<TempoWorld::WorldStateSnapshot>& ResponseContinuation);
+
+	void StreamWorldStateSnapshots(const TempoWorld::WorldStateSnapshotRequest& Request, const TResponseDelegate<TempoWorld::WorldStateSnapshot>& ResponseContinuation);
+
 	void Raycast(const TempoWorld::RaycastRequest& Request, const TResponseDelegate<TempoWorld::RaycastResponse>& ResponseContinuation) const;
 
+	// Runs the queries in parallel on worker threads, blocking the game thread until they are all done.
+	void SceneQueries(const TempoWorld::SceneQueriesRequest& Request, const TResponseDelegate<TempoWorld::SceneQueriesResponse>& ResponseContinuation) const;
+
 	virtual void Tick(float DeltaTime) override;
 
 	virtual TStatId GetStatId() const override;
 
+	// The number of actors the delta-mode streams currently track, across all tolerances.
+	int32 NumTrackedActorStates() const;
+
 protected:
 	UFUNCTION()
 	void OnActorOverlap(AActor* OverlappedActor, AActor* OtherActor);
 
 	TMap<FString, TArray<TResponseDelegate<TempoWorld::OverlapEventResponse>>> PendingOverlapRequests;
 
+	UFUNCTION()
+	void OnWatchedActorBeginOverlap(AActor* OverlappedActor, AActor* OtherActor);
+
+	UFUNCTION()
+	void OnWatchedActorEndOverlap(AActor* OverlappedActor, AActor* OtherActor);
+
+	// Adds the event to the pending batch of every overlap stream that watches OverlappedActor and whose
+	// filters OtherActor passes.
+	void AddOverlapEvent(const AActor* OverlappedActor, const AActor* OtherActor, bool bBegin);
+
+	void WatchActor(FTempoOverlapSubscriber& Subscriber, AActor* Actor);
+
+	// Starts watching newly spawned actors that overlap streams select by class or tag.
+	void OnActorSpawned(AActor* Actor);
+
+	// Sends each overlap stream that is waiting for a batch the events since its last one, if there are any.
+	void SendOverlapEventBatches();
+
+	// Keyed by the handle of each stream's response delegate.
+	TMap<FDelegateHandle, FTempoOverlapSubscriber> OverlapSubscribers;
+
+	FDelegateHandle ActorSpawnedHandle;
+
 	TMap<TempoWorld::ActorStateRequest, TArray<TResponseDelegate<TempoWorld::ActorState>>> PendingActorStateRequests;
 
 	TMap<TempoWorld::ActorStatesNearRequest, TArray<TResponseDelegate<TempoWorld::ActorStates>>> PendingActorStatesNearRequests;
+
+	// Answers the delta-mode continuations that have something to send, leaving the rest pending.
+	void StreamActorStateDelta(const TempoWorld::ActorStateRequest& Request, TArray<TResponseDelegate<TempoWorld::ActorState>>& ResponseContinuations);
+	void StreamActorStatesNearDelta(const TempoWorld::ActorStatesNearRequest& Request, TArray<TResponseDelegate<TempoWorld::ActorStates>>& ResponseContinuations);
+
+	// Samples Actor at most once per tick per key, updating its Reference if it moved beyond the tolerances.
+	const FTempoTrackedActorState& SampleActorState(const AActor* Actor, const FTempoActorStateDeltaKey& Key);
+
+	// Whether a subscriber is due a keyframe, and its record, created on first use.
+	static bool NeedsKeyframe(const FTempoActorStateSubscriber& Subscriber, const TempoWorld::ActorStateDeltaOptions& Options, double Now);
+	FTempoActorStateSubscriber& FindOrAddSubscriber(const FDelegateHandle& Handle, double Now);
+
+	// Fills Snapshot's rows (but not its ID table) with the actors matching Request, which it returns.
+	TArray<const AActor*> BuildWorldStateSnapshot(const TempoWorld::WorldStateSnapshotRequest& Request, TempoWorld::WorldStateSnapshot& Snapshot);
+
+	// Sends each continuation the same rows, with the ID table changes since its previous snapshot.
+	void SendWorldStateSnapshots(const TempoWorld::WorldStateSnapshotRequest& Request, const TArray<TResponseDelegate<TempoWorld::WorldStateSnapshot>>& ResponseContinuations);
+
+	uint32 GetSnapshotActorId(const AActor* Actor);
+
+	// Drops subscribers that stopped asking, samples of actors no stream looked at recently, and the
+	// snapshot IDs of destroyed actors.
+	void PruneStreamState(double Now);
+
+	// Counts calls to Tick, to order samples against what each subscriber was last sent.
+	uint64 StreamTick = 0;
+
+	double LastStreamPruneTime = 0.0;
+	uint64 LastStreamPruneTick = 0;
+
+	TMap<FTempoActorStateDeltaKey, TMap<TObjectKey<AActor>, FTempoTrackedActorState>> TrackedActorStates;
+
+	// Keyed by the handle of each stream's response delegate, which stays the same for the life of the stream.
+	TMap<FDelegateHandle, FTempoActorStateSubscriber> DeltaSubscribers;
+
+	TMap<TempoWorld::WorldStateSnapshotRequest, TArray<TResponseDelegate<TempoWorld::WorldStateSnapshot>>> PendingWorldStateSnapshotRequests;
+
+	TMap<FDelegateHandle, FTempoSnapshotSubscriber> SnapshotSubscribers;
+
+	TMap<TObjectKey<AActor>, uint32> SnapshotActorIds;
+	uint32 NextSnapshotActorId = 0;
 };
@@ -8,20 +8,30 @@ AActor* GetActorWithName(const UWorld* World, const FString& Name);
 
 UObject* GetAssetByPath(const FString& AssetPath);
 
+// Redraws Object (an actor or scene component) after its properties were written directly.
+void MarkRenderStateDirty(UObject* Object);
+
 template <typename T = UActorComponent>
 T* GetComponentWithName(const AActor* Actor, const FString& Name)
 {
-	TArray<T*> Components;
-	Actor->GetComponents<T>(Components);
-	for (T* Component : Components)
+	// FNAME_Find never adds to the name table, and FName comparison ignores case. A name that isn't in
+	// the table can't be any component's.
+	const FName ComponentName(*Name, FNAME_Find);
+	if (ComponentName.IsNone())
+	{
+		return nullptr;
+	}
+
+	T* Found = nullptr;
+	Actor->ForEachComponent<T>(false, [&Found, &ComponentName](T* Component)
 	{
-		if (Component->GetName().Equals(Name, ESearchCase::IgnoreCase))
+		if (!Found && Component->GetFName() == ComponentName)
 		{
-			return Component;
+			Found = Component;
 		}
-	}
+	});
 
-	return nullptr;
+	return Found;
 }
 
 // https://kantandev.com/articles/finding-all-classes-blueprints-with-a-given-base
@@ -25,8 +25,11 @@ public class TempoWorld : TempoModuleRules
 				"CoreUObject",
 				"Engine",
 				"MassActors",
+				"MassCommon",
 				"MassEntity",
+				"MassMovement",
 				"MassTraffic",
+				"MassZoneGraphNavigation",
 			}
 		);
 